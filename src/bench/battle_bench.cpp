@@ -0,0 +1,473 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "battle_bench.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+
+#include "agg.h"
+#include "army.h"
+#include "battle.h"
+#include "battle_simulation.h"
+#include "bench_utils.h"
+#include "h2d.h"
+#include "maps_tiles.h"
+#include "monster.h"
+#include "monster_info.h"
+#include "mp2.h"
+#include "players.h"
+#include "settings.h"
+#include "system.h"
+#include "timing.h"
+#include "tools.h"
+#include "world.h"
+
+namespace
+{
+    constexpr uint32_t defaultSeed = 20260101;
+
+    // The maximum number of troops in an army.
+    constexpr size_t maxTroopCount = 5;
+
+    struct Options
+    {
+        uint32_t battles{ 100 };
+        uint32_t jobs{ 1 };
+        uint32_t seed{ defaultSeed };
+        int32_t mapSize{ 36 };
+
+        std::string armyFileName;
+        std::string outputFileName;
+
+        // These options are set only for the processes simulating a part of the battles.
+        int32_t firstBattle{ -1 };
+        uint32_t battleCount{ 0 };
+        std::string resultFileName;
+    };
+
+    struct SimulationSummary
+    {
+        uint32_t battles{ 0 };
+        uint32_t attackerWins{ 0 };
+        uint32_t defenderWins{ 0 };
+        uint32_t unfinished{ 0 };
+        uint32_t turns{ 0 };
+
+        // Total strength of troops lost by each army in all battles.
+        double attackerLosses{ 0 };
+        double defenderLosses{ 0 };
+
+        double time{ 0 };
+
+        void add( const SimulationSummary & other )
+        {
+            battles += other.battles;
+            attackerWins += other.attackerWins;
+            defenderWins += other.defenderWins;
+            unfinished += other.unfinished;
+            turns += other.turns;
+            attackerLosses += other.attackerLosses;
+            defenderLosses += other.defenderLosses;
+            time += other.time;
+        }
+    };
+
+    int getMonsterIdByName( const std::string & name )
+    {
+        const std::string lowerName = StringLower( name );
+
+        for ( int id = Monster::UNKNOWN + 1; id < Monster::MONSTER_COUNT; ++id ) {
+            const Monster monster( id );
+            if ( !monster.isValid() ) {
+                continue;
+            }
+
+            const fheroes2::MonsterGeneralStats & stats = fheroes2::getMonsterData( id ).generalStats;
+            if ( lowerName == StringLower( stats.untranslatedName ) || lowerName == StringLower( stats.untranslatedPluralName ) ) {
+                return id;
+            }
+        }
+
+        return Monster::UNKNOWN;
+    }
+
+    // Parses troops in the "<count> <monster name>, <count> <monster name>, ..." format.
+    bool parseTroops( const std::string & text, Army & army )
+    {
+        std::istringstream stream( text );
+        std::string item;
+        size_t troopCount = 0;
+
+        while ( std::getline( stream, item, ',' ) ) {
+            item = StringTrim( item );
+
+            const size_t separatorPos = item.find( ' ' );
+            if ( separatorPos == std::string::npos ) {
+                return false;
+            }
+
+            uint32_t count = 0;
+            if ( !BenchUtils::parseNumber( item.substr( 0, separatorPos ), count ) || count == 0 ) {
+                return false;
+            }
+
+            const int monsterId = getMonsterIdByName( StringTrim( item.substr( separatorPos + 1 ) ) );
+            if ( monsterId == Monster::UNKNOWN ) {
+                std::cerr << "Unknown monster: " << item.substr( separatorPos + 1 ) << std::endl;
+                return false;
+            }
+
+            ++troopCount;
+            if ( troopCount > maxTroopCount || !army.JoinTroop( Monster( monsterId ), count, true ) ) {
+                return false;
+            }
+        }
+
+        return troopCount > 0;
+    }
+
+    // Reads the armies from the file where each army is given by the "attacker: <troops>" or "defender: <troops>" line, see parseTroops()
+    // for the format of troops. Empty lines and lines starting with '#' are ignored.
+    bool readArmies( const std::string & fileName, Army & attackingArmy, Army & defendingArmy )
+    {
+        std::ifstream stream( fileName );
+        if ( !stream ) {
+            std::cerr << "Cannot read file " << fileName << std::endl;
+            return false;
+        }
+
+        bool isAttackerRead = false;
+        bool isDefenderRead = false;
+
+        std::string line;
+        while ( std::getline( stream, line ) ) {
+            line = StringTrim( line );
+            if ( line.empty() || line.front() == '#' ) {
+                continue;
+            }
+
+            const size_t separatorPos = line.find( ':' );
+            if ( separatorPos == std::string::npos ) {
+                std::cerr << "Invalid line in file " << fileName << ": " << line << std::endl;
+                return false;
+            }
+
+            const std::string side = StringLower( StringTrim( line.substr( 0, separatorPos ) ) );
+            const std::string troops = line.substr( separatorPos + 1 );
+
+            if ( side == "attacker" && !isAttackerRead ) {
+                isAttackerRead = parseTroops( troops, attackingArmy );
+                if ( !isAttackerRead ) {
+                    std::cerr << "Invalid attacking army in file " << fileName << std::endl;
+                    return false;
+                }
+            }
+            else if ( side == "defender" && !isDefenderRead ) {
+                isDefenderRead = parseTroops( troops, defendingArmy );
+                if ( !isDefenderRead ) {
+                    std::cerr << "Invalid defending army in file " << fileName << std::endl;
+                    return false;
+                }
+            }
+            else {
+                std::cerr << "Invalid line in file " << fileName << ": " << line << std::endl;
+                return false;
+            }
+        }
+
+        if ( !isAttackerRead || !isDefenderRead ) {
+            std::cerr << "Both attacking and defending armies must be given in file " << fileName << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool parseOptions( const std::vector<std::string> & arguments, Options & options )
+    {
+        for ( size_t i = 0; i < arguments.size(); ++i ) {
+            const std::string & arg = arguments[i];
+            if ( i + 1 >= arguments.size() ) {
+                return false;
+            }
+
+            const std::string & value = arguments[++i];
+            uint32_t number = 0;
+
+            if ( arg == "-f" ) {
+                options.armyFileName = value;
+            }
+            else if ( arg == "-o" ) {
+                options.outputFileName = value;
+            }
+            else if ( arg == "-result" ) {
+                options.resultFileName = value;
+            }
+            else if ( !BenchUtils::parseNumber( value, number ) ) {
+                return false;
+            }
+            else if ( arg == "-n" ) {
+                options.battles = number;
+            }
+            else if ( arg == "-j" ) {
+                options.jobs = std::max( number, 1U );
+            }
+            else if ( arg == "-s" ) {
+                options.seed = number;
+            }
+            else if ( arg == "-m" ) {
+                options.mapSize = static_cast<int32_t>( number );
+            }
+            else if ( arg == "-first" ) {
+                options.firstBattle = static_cast<int32_t>( number );
+            }
+            else if ( arg == "-count" ) {
+                options.battleCount = number;
+            }
+            else {
+                return false;
+            }
+        }
+
+        return !options.armyFileName.empty();
+    }
+
+    // Returns the index of the first land tile without any object, or -1 if there is no such tile.
+    int32_t getBattleTileIndex()
+    {
+        for ( int32_t i = 0; i < static_cast<int32_t>( world.getSize() ); ++i ) {
+            const Maps::Tile & tile = world.getTile( i );
+            if ( !tile.isWater() && tile.getMainObjectType() == MP2::OBJ_NONE ) {
+                return i;
+            }
+        }
+
+        return -1;
+    }
+
+    bool simulateBattles( const Options & options, SimulationSummary & summary )
+    {
+        Army attackingArmy;
+        Army defendingArmy;
+        if ( !readArmies( options.armyFileName, attackingArmy, defendingArmy ) ) {
+            return false;
+        }
+
+        // All processes use the same world, so the battles do not depend on the way they are split between the processes.
+        const std::string mapFilePath = BenchUtils::getTemporaryFilePath( "fheroes2_battles_" + std::to_string( options.firstBattle ) + ".fh2m" );
+        if ( !BenchUtils::prepareWorld( options.seed, options.mapSize, 2, "Battle simulation", mapFilePath, false ) ) {
+            return false;
+        }
+
+        const int32_t battleTileIndex = getBattleTileIndex();
+        if ( battleTileIndex < 0 ) {
+            std::cerr << "There is no land tile for the battle" << std::endl;
+            return false;
+        }
+
+        const Players & players = Settings::Get().GetPlayers();
+        if ( players.empty() ) {
+            return false;
+        }
+
+        // The defending army stays neutral.
+        attackingArmy.SetColor( players.front()->GetColor() );
+
+        const fheroes2::Time timer;
+
+        for ( uint32_t i = 0; i < options.battleCount; ++i ) {
+            const uint32_t seed = options.seed + static_cast<uint32_t>( options.firstBattle ) + i;
+            const Battle::SimulationResult result = Battle::Simulate( attackingArmy, defendingArmy, battleTileIndex, seed );
+
+            ++summary.battles;
+            summary.turns += result.numberOfTurns;
+
+            if ( !result.isFinished ) {
+                ++summary.unfinished;
+            }
+            else if ( result.result.isAttackerWin() ) {
+                ++summary.attackerWins;
+            }
+            else if ( result.result.isDefenderWin() ) {
+                ++summary.defenderWins;
+            }
+
+            summary.attackerLosses += result.attackerLosses.GetStrength();
+            summary.defenderLosses += result.defenderLosses.GetStrength();
+        }
+
+        summary.time = timer.getS();
+
+        return true;
+    }
+
+    int runBattles( const Options & options )
+    {
+        std::unique_ptr<AGG::AGGInitializer> aggInitializer;
+        std::unique_ptr<fheroes2::h2d::H2DInitializer> h2dInitializer;
+
+        try {
+            aggInitializer = std::make_unique<AGG::AGGInitializer>();
+            h2dInitializer = std::make_unique<fheroes2::h2d::H2DInitializer>();
+        }
+        catch ( const std::exception & ex ) {
+            std::cerr << "Game data is not available: " << ex.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        SimulationSummary summary;
+        if ( !simulateBattles( options, summary ) ) {
+            return EXIT_FAILURE;
+        }
+
+        std::ofstream stream( options.resultFileName, std::ios_base::trunc );
+        stream << summary.battles << ' ' << summary.attackerWins << ' ' << summary.defenderWins << ' ' << summary.unfinished << ' ' << summary.turns << ' '
+               << summary.attackerLosses << ' ' << summary.defenderLosses << ' ' << summary.time << std::endl;
+
+        return stream ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    std::string getBattlesCommand( const Options & options, const std::string & programPath, const uint32_t firstBattle, const uint32_t battleCount,
+                                   const std::string & resultFileName )
+    {
+        std::ostringstream command;
+        command << '"' << programPath << "\" battles -f \"" << options.armyFileName << "\" -first " << firstBattle << " -count " << battleCount
+                << " -result \"" << resultFileName << "\" -s " << options.seed << " -m " << options.mapSize;
+
+        return command.str();
+    }
+
+    void writeSummary( std::ostream & stream, const Options & options, const SimulationSummary & summary, const uint32_t failedBattles )
+    {
+        const double battles = summary.battles == 0 ? 1.0 : static_cast<double>( summary.battles );
+
+        stream << std::fixed << std::setprecision( 3 );
+
+        stream << "{" << std::endl;
+        stream << "  \"version\": \"" << Settings::GetVersion() << "\"," << std::endl;
+        stream << "  \"seed\": " << options.seed << "," << std::endl;
+        stream << "  \"map_size\": " << options.mapSize << "," << std::endl;
+        stream << "  \"battles\": " << summary.battles << "," << std::endl;
+        stream << "  \"failed_battles\": " << failedBattles << "," << std::endl;
+        stream << "  \"attacker_wins\": " << summary.attackerWins << "," << std::endl;
+        stream << "  \"defender_wins\": " << summary.defenderWins << "," << std::endl;
+        stream << "  \"unfinished\": " << summary.unfinished << "," << std::endl;
+        stream << "  \"attacker_win_rate\": " << summary.attackerWins / battles << "," << std::endl;
+        stream << "  \"average_turns\": " << summary.turns / battles << "," << std::endl;
+        stream << "  \"average_attacker_losses\": " << summary.attackerLosses / battles << "," << std::endl;
+        stream << "  \"average_defender_losses\": " << summary.defenderLosses / battles << "," << std::endl;
+        stream << "  \"mean_battle_ms\": " << summary.time * 1000.0 / battles << std::endl;
+        stream << "}" << std::endl;
+    }
+
+    int runAllBattles( const Options & options, const std::string & programPath )
+    {
+        // Every process simulates a continuous range of battles.
+        const uint32_t processCount = std::min( options.jobs, options.battles );
+
+        std::vector<std::string> resultFileNames;
+        for ( uint32_t i = 0; i < processCount; ++i ) {
+            resultFileNames.push_back( BenchUtils::getTemporaryFilePath( "fheroes2_battles_" + std::to_string( i ) + ".txt" ) );
+        }
+
+        const auto getFirstBattle = [&options, processCount]( const uint32_t processIndex ) {
+            return static_cast<uint32_t>( static_cast<uint64_t>( options.battles ) * processIndex / processCount );
+        };
+
+        BenchUtils::runProcesses( processCount, processCount, [&options, &programPath, &resultFileNames, &getFirstBattle]( const uint32_t processIndex ) {
+            const uint32_t firstBattle = getFirstBattle( processIndex );
+            return getBattlesCommand( options, programPath, firstBattle, getFirstBattle( processIndex + 1 ) - firstBattle, resultFileNames[processIndex] );
+        } );
+
+        SimulationSummary summary;
+        uint32_t failedBattles = 0;
+
+        for ( uint32_t i = 0; i < processCount; ++i ) {
+            std::ifstream stream( resultFileNames[i] );
+
+            SimulationSummary result;
+            if ( stream >> result.battles >> result.attackerWins >> result.defenderWins >> result.unfinished >> result.turns >> result.attackerLosses
+                 >> result.defenderLosses >> result.time ) {
+                summary.add( result );
+            }
+            else {
+                failedBattles += getFirstBattle( i + 1 ) - getFirstBattle( i );
+            }
+
+            stream.close();
+            System::Unlink( resultFileNames[i] );
+        }
+
+        if ( options.outputFileName.empty() ) {
+            writeSummary( std::cout, options, summary, failedBattles );
+            return EXIT_SUCCESS;
+        }
+
+        std::ofstream outputStream( options.outputFileName, std::ios_base::trunc );
+        writeSummary( outputStream, options, summary, failedBattles );
+
+        if ( !outputStream ) {
+            std::cerr << "Cannot write file " << options.outputFileName << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        return EXIT_SUCCESS;
+    }
+}
+
+namespace BattleBench
+{
+    int run( const std::vector<std::string> & arguments, const std::string & programPath )
+    {
+        Options options;
+        if ( !parseOptions( arguments, options ) ) {
+            const std::string toolName = System::GetFileName( programPath );
+
+            std::cerr << toolName << " battles simulates battles between two armies controlled by AI and writes win rates and losses in JSON format."
+                      << std::endl
+                      << "Armies are read from a text file with the \"attacker: <troops>\" and \"defender: <troops>\" lines, where troops are"
+                      << " a comma-separated list of \"<count> <monster name>\" items, for example: attacker: 40 Swordsman, 30 Archer" << std::endl
+                      << "Syntax: " << toolName << " battles -f army_file [-n battles] [-j parallel_processes] [-s seed] [-m map_size] [-o output_file.json]"
+                      << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        try {
+            if ( options.firstBattle >= 0 ) {
+                return runBattles( options );
+            }
+
+            return runAllBattles( options, programPath );
+        }
+        catch ( const std::exception & ex ) {
+            std::cerr << "Battle simulation failed: " << ex.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+}
@@ -0,0 +1,143 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "bench_utils.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "game.h"
+#include "logging.h"
+#include "map_format_helper.h"
+#include "map_format_info.h"
+#include "map_random_generator.h"
+#include "maps_fileinfo.h"
+#include "players.h"
+#include "settings.h"
+#include "system.h"
+#include "world.h"
+
+namespace BenchUtils
+{
+    std::string getTemporaryFilePath( const std::string & fileName )
+    {
+        std::error_code errorCode;
+        const std::filesystem::path tempDirectory = std::filesystem::temp_directory_path( errorCode );
+        if ( errorCode ) {
+            return fileName;
+        }
+
+        return System::fsPathToString( tempDirectory / fileName );
+    }
+
+    bool parseNumber( const std::string & text, uint32_t & value )
+    {
+        char * valueEnd = nullptr;
+        const unsigned long result = std::strtoul( text.c_str(), &valueEnd, 10 );
+        if ( text.empty() || *valueEnd != '\0' ) {
+            return false;
+        }
+
+        value = static_cast<uint32_t>( result );
+        return true;
+    }
+
+    bool prepareWorld( const uint32_t seed, const int32_t mapSize, const int32_t playerCount, const std::string & mapName, const std::string & mapFilePath,
+                       const bool isAIOnly )
+    {
+        Maps::Random_Generator::Configuration config;
+        config.playerCount = playerCount;
+        config.seed = static_cast<int32_t>( seed % 999999 );
+
+        Maps::Map_Format::MapFormat map;
+        if ( !Maps::Random_Generator::generateMap( map, config, mapSize, mapSize ) || !Maps::updateMapPlayers( map ) ) {
+            ERROR_LOG( "Failed to generate a random map with seed " << config.seed )
+            return false;
+        }
+
+        map.name = mapName;
+
+        if ( !Maps::Map_Format::saveMap( mapFilePath, map ) ) {
+            ERROR_LOG( "Failed to save the map to " << mapFilePath )
+            return false;
+        }
+
+        Maps::FileInfo mapInfo;
+        if ( !mapInfo.loadResurrectionMap( map, mapFilePath ) ) {
+            System::Unlink( mapFilePath );
+            return false;
+        }
+
+        Settings & conf = Settings::Get();
+        conf.SetGameType( Game::TYPE_STANDARD );
+        conf.setCurrentMapInfo( std::move( mapInfo ) );
+
+        Players & players = conf.GetPlayers();
+
+        if ( isAIOnly ) {
+            // AI turns are not shown.
+            conf.SetAIMoveSpeed( 0 );
+
+            for ( Player * player : players ) {
+                player->SetControl( CONTROL_AI );
+            }
+        }
+
+        players.SetStartGame();
+
+        const bool isLoaded = world.loadResurrectionMap( mapFilePath );
+        System::Unlink( mapFilePath );
+
+        return isLoaded;
+    }
+
+    uint32_t runProcesses( const uint32_t count, const uint32_t jobs, const std::function<std::string( const uint32_t )> & getCommand )
+    {
+        // Every piece of work is done by a child process, threads only wait for them.
+        std::atomic<uint32_t> nextIndex{ 0 };
+        std::atomic<uint32_t> failedProcesses{ 0 };
+        std::vector<std::thread> threads;
+
+        for ( uint32_t i = 0; i < std::min( std::max( jobs, 1U ), count ); ++i ) {
+            threads.emplace_back( [count, &getCommand, &nextIndex, &failedProcesses]() {
+                for ( uint32_t index = nextIndex++; index < count; index = nextIndex++ ) {
+                    const std::string command = getCommand( index );
+                    if ( std::system( command.c_str() ) != 0 ) {
+                        std::cerr << "Process " << index << " failed" << std::endl;
+                        ++failedProcesses;
+                    }
+                }
+            } );
+        }
+
+        for ( std::thread & thread : threads ) {
+            thread.join();
+        }
+
+        return failedProcesses;
+    }
+}
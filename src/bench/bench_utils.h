@@ -0,0 +1,44 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+// Helpers shared by the subcommands of the benchmark tool. The game world is a global object, so subcommands which need several worlds
+// at once run every piece of work in a separate child process of the tool.
+namespace BenchUtils
+{
+    // Returns the path of a file with the given name in the temporary directory, or the name itself if there is no temporary directory.
+    std::string getTemporaryFilePath( const std::string & fileName );
+
+    bool parseNumber( const std::string & text, uint32_t & value );
+
+    // Generates a random map with the given seed and loads it into the world as a new standard game. If 'isAIOnly' is true all players
+    // are controlled by AI and AI turns are not shown. The map is saved into the given file which is removed once the map is loaded.
+    bool prepareWorld( const uint32_t seed, const int32_t mapSize, const int32_t playerCount, const std::string & mapName, const std::string & mapFilePath,
+                       const bool isAIOnly );
+
+    // Runs the given number of child processes, at most 'jobs' of them at the same time. The command of every process is returned by
+    // 'getCommand' for its index, it can be called from different threads concurrently. Returns the number of processes which have failed.
+    uint32_t runProcesses( const uint32_t count, const uint32_t jobs, const std::function<std::string( const uint32_t )> & getCommand );
+}
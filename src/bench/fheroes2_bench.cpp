@@ -0,0 +1,556 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+// Reproducible microbenchmarks of the engine and game hot paths. The results are written in JSON format to track performance regressions
+// between builds. The benchmarks which require game data are run only if the original game resources are found.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "agg.h"
+#include "agg_file.h"
+#include "army.h"
+#include "battle_bench.h"
+#include "battle_simulation.h"
+#include "castle.h"
+#include "color.h"
+#include "game.h"
+#include "game_io.h"
+#include "game_mode.h"
+#include "h2d.h"
+#include "icn.h"
+#include "image.h"
+#include "image_tool.h"
+#include "kingdom.h"
+#include "logging.h"
+#include "map_bench.h"
+#include "map_format_helper.h"
+#include "map_format_info.h"
+#include "map_random_generator.h"
+#include "maps_fileinfo.h"
+#include "maps_tiles.h"
+#include "monster.h"
+#include "mp2.h"
+#include "players.h"
+#include "rand.h"
+#include "selfplay.h"
+#include "serialize.h"
+#include "settings.h"
+#include "skill.h"
+#include "system.h"
+#include "timing.h"
+#include "world.h"
+#include "world_pathfinding.h"
+#include "zzlib.h"
+
+namespace
+{
+    // Fixed seed for all generated data to make the runs reproducible.
+    constexpr uint32_t benchmarkSeed = 20260101;
+
+    // Results of the benchmarked calls are accumulated here to prevent the compiler from optimizing the calls away.
+    volatile uint64_t resultSink = 0;
+
+    struct BenchmarkResult
+    {
+        std::string name;
+        uint32_t iterations{ 0 };
+        double minUs{ 0 };
+        double medianUs{ 0 };
+        double meanUs{ 0 };
+    };
+
+    class BenchmarkRunner
+    {
+    public:
+        explicit BenchmarkRunner( std::string filter )
+            : _filter( std::move( filter ) )
+        {}
+
+        bool isEnabled( const std::string_view name ) const
+        {
+            return _filter.empty() || name.find( _filter ) != std::string_view::npos;
+        }
+
+        // Runs the given function once to warm up the caches and then the given number of times measuring every run.
+        void run( std::string name, const uint32_t iterations, const std::function<void()> & func )
+        {
+            if ( iterations == 0 || !isEnabled( name ) ) {
+                return;
+            }
+
+            func();
+
+            std::vector<double> times;
+            times.reserve( iterations );
+
+            for ( uint32_t i = 0; i < iterations; ++i ) {
+                const fheroes2::Time timer;
+                func();
+                times.push_back( timer.getS() * 1000000.0 );
+            }
+
+            std::sort( times.begin(), times.end() );
+
+            BenchmarkResult result;
+            result.name = std::move( name );
+            result.iterations = iterations;
+            result.minUs = times.front();
+            result.medianUs = times[times.size() / 2];
+
+            for ( const double time : times ) {
+                result.meanUs += time;
+            }
+            result.meanUs /= static_cast<double>( times.size() );
+
+            std::cerr << result.name << ": " << result.medianUs << " us" << std::endl;
+
+            _results.emplace_back( std::move( result ) );
+        }
+
+        void skip( const std::string_view name, const std::string_view reason )
+        {
+            if ( isEnabled( name ) ) {
+                _skipped.emplace_back( name, reason );
+            }
+        }
+
+        void writeJSON( std::ostream & stream, const bool isGameDataAvailable ) const
+        {
+            stream << std::fixed << std::setprecision( 3 );
+
+            stream << "{" << std::endl;
+            stream << "  \"version\": \"" << Settings::GetVersion() << "\"," << std::endl;
+#if defined( WITH_DEBUG )
+            stream << "  \"build\": \"debug\"," << std::endl;
+#else
+            stream << "  \"build\": \"release\"," << std::endl;
+#endif
+            stream << "  \"seed\": " << benchmarkSeed << "," << std::endl;
+            stream << "  \"game_data\": " << ( isGameDataAvailable ? "true" : "false" ) << "," << std::endl;
+
+            stream << "  \"benchmarks\": [";
+            for ( size_t i = 0; i < _results.size(); ++i ) {
+                const BenchmarkResult & result = _results[i];
+
+                stream << ( i == 0 ? "" : "," ) << std::endl;
+                stream << "    { \"name\": \"" << result.name << "\", \"iterations\": " << result.iterations << ", \"min_us\": " << result.minUs
+                       << ", \"median_us\": " << result.medianUs << ", \"mean_us\": " << result.meanUs << " }";
+            }
+            stream << std::endl << "  ]," << std::endl;
+
+            stream << "  \"skipped\": [";
+            for ( size_t i = 0; i < _skipped.size(); ++i ) {
+                stream << ( i == 0 ? "" : "," ) << std::endl;
+                stream << "    { \"name\": \"" << _skipped[i].first << "\", \"reason\": \"" << _skipped[i].second << "\" }";
+            }
+            stream << std::endl << "  ]" << std::endl;
+
+            stream << "}" << std::endl;
+        }
+
+    private:
+        std::string _filter;
+        std::vector<BenchmarkResult> _results;
+        std::vector<std::pair<std::string, std::string>> _skipped;
+    };
+
+    fheroes2::Sprite makeRandomSprite( const int32_t width, const int32_t height, Rand::PCG32 & randomGenerator )
+    {
+        fheroes2::Sprite sprite( width, height );
+
+        uint8_t * image = sprite.image();
+        uint8_t * transform = sprite.transform();
+        const size_t size = static_cast<size_t>( width ) * height;
+
+        for ( size_t i = 0; i < size; ++i ) {
+            const uint32_t value = randomGenerator();
+            image[i] = static_cast<uint8_t>( value );
+            // Roughly a quarter of the pixels is transparent and some of them are shadows, like in the real sprites.
+            const uint8_t transformValue = static_cast<uint8_t>( ( value >> 8 ) % 8 );
+            transform[i] = ( transformValue < 2 ) ? 1 : ( transformValue == 2 ? 3 : 0 );
+        }
+
+        return sprite;
+    }
+
+    void runImageBenchmarks( BenchmarkRunner & runner )
+    {
+        Rand::PCG32 randomGenerator( benchmarkSeed );
+
+        const fheroes2::Sprite sprite = makeRandomSprite( 64, 64, randomGenerator );
+        const fheroes2::Sprite screen = makeRandomSprite( 640, 480, randomGenerator );
+
+        fheroes2::Image output( 640, 480 );
+        output.fill( 0 );
+
+        runner.run( "image/blit_64x64_x100", 200, [&sprite, &output]() {
+            for ( int32_t i = 0; i < 100; ++i ) {
+                fheroes2::Blit( sprite, output, ( i * 37 ) % 576, ( i * 53 ) % 416 );
+            }
+            resultSink = resultSink + output.image()[0];
+        } );
+
+        runner.run( "image/alpha_blit_64x64_x100", 200, [&sprite, &output]() {
+            for ( int32_t i = 0; i < 100; ++i ) {
+                fheroes2::AlphaBlit( sprite, output, ( i * 37 ) % 576, ( i * 53 ) % 416, 128 );
+            }
+            resultSink = resultSink + output.image()[0];
+        } );
+
+        fheroes2::Image resized( 1280, 960 );
+
+        runner.run( "image/resize_640x480_to_1280x960", 50, [&screen, &resized]() {
+            fheroes2::Resize( screen, resized );
+            resultSink = resultSink + resized.image()[0];
+        } );
+
+        runner.run( "image/copy_640x480", 200, [&screen, &output]() {
+            fheroes2::Copy( screen, output );
+            resultSink = resultSink + output.image()[0];
+        } );
+    }
+
+    void runCompressionBenchmarks( BenchmarkRunner & runner )
+    {
+        Rand::PCG32 randomGenerator( benchmarkSeed );
+
+        // Save files and ICN data mostly consist of short runs of repeated values, so generate data with the similar compression ratio.
+        std::vector<uint8_t> data;
+        data.reserve( 1024 * 1024 );
+
+        while ( data.size() < 1024 * 1024 ) {
+            const uint32_t value = randomGenerator();
+            data.insert( data.end(), 1 + ( value >> 8 ) % 16, static_cast<uint8_t>( value % 32 ) );
+        }
+
+        const std::vector<uint8_t> compressed = Compression::zipData( data.data(), data.size() );
+
+        runner.run( "compression/zip_1mb", 20, [&data]() {
+            const std::vector<uint8_t> output = Compression::zipData( data.data(), data.size() );
+            resultSink = resultSink + output.size();
+        } );
+
+        runner.run( "compression/unzip_1mb", 50, [&compressed, &data]() {
+            const std::vector<uint8_t> output = Compression::unzipData( compressed.data(), compressed.size(), data.size() );
+            resultSink = resultSink + output.size();
+        } );
+    }
+
+    void runICNBenchmarks( BenchmarkRunner & runner )
+    {
+        // Battle sprites of a single monster: a typical amount of work for loading one ICN.
+        const std::vector<uint8_t> body = AGG::getDataFromAggFile( ICN::getIcnFileName( ICN::PEASANT ), false );
+        if ( body.size() < 6 ) {
+            runner.skip( "icn/decode_peasant", "no ICN data" );
+            return;
+        }
+
+        constexpr size_t headerSize = 6;
+
+        ROStreamBuf imageStream( body );
+
+        const uint32_t count = imageStream.getLE16();
+        const uint32_t blockSize = imageStream.getLE32();
+
+        std::vector<fheroes2::ICNHeader> headers( count );
+        for ( fheroes2::ICNHeader & header : headers ) {
+            imageStream >> header;
+        }
+
+        runner.run( "icn/decode_peasant", 200, [&body, &headers, blockSize]() {
+            for ( size_t i = 0; i < headers.size(); ++i ) {
+                const uint32_t dataEndOffset = ( i + 1 < headers.size() ) ? headers[i + 1].offsetData : blockSize;
+
+                const uint8_t * data = body.data() + headerSize + headers[i].offsetData;
+                const uint8_t * dataEnd = body.data() + std::min( body.size(), headerSize + dataEndOffset );
+
+                const fheroes2::Sprite sprite = fheroes2::decodeICNSprite( data, dataEnd, headers[i] );
+                resultSink = resultSink + static_cast<uint64_t>( sprite.width() );
+            }
+        } );
+    }
+
+    // Generates a random map and loads it into the world as a new game. Returns false if the map could not be generated or loaded.
+    bool prepareWorld( BenchmarkRunner & runner, const std::string & mapFilePath )
+    {
+        Maps::Random_Generator::Configuration config;
+        config.playerCount = 4;
+        config.seed = static_cast<int32_t>( benchmarkSeed % 999999 );
+
+        Maps::Map_Format::MapFormat map;
+
+        runner.run( "maps/generate_random_72x72", 5, [&map, &config]() {
+            if ( !Maps::Random_Generator::generateMap( map, config, 72, 72 ) ) {
+                ERROR_LOG( "Failed to generate a random map" )
+            }
+        } );
+
+        if ( !Maps::Random_Generator::generateMap( map, config, 72, 72 ) || !Maps::updateMapPlayers( map ) ) {
+            ERROR_LOG( "Failed to generate a random map" )
+            return false;
+        }
+
+        map.name = "Benchmark";
+
+        if ( !Maps::Map_Format::saveMap( mapFilePath, map ) ) {
+            ERROR_LOG( "Failed to save the map to " << mapFilePath )
+            return false;
+        }
+
+        Maps::FileInfo mapInfo;
+        if ( !mapInfo.loadResurrectionMap( map, mapFilePath ) ) {
+            return false;
+        }
+
+        Settings & conf = Settings::Get();
+        conf.SetGameType( Game::TYPE_STANDARD );
+        conf.setCurrentMapInfo( std::move( mapInfo ) );
+        conf.GetPlayers().SetStartGame();
+
+        return world.loadResurrectionMap( mapFilePath );
+    }
+
+    void runWorldBenchmarks( BenchmarkRunner & runner, const std::string & saveFilePath )
+    {
+        const Players & players = Settings::Get().GetPlayers();
+        if ( players.empty() ) {
+            return;
+        }
+
+        const PlayerColor color = players.front()->GetColor();
+
+        const VecCastles & castles = world.GetKingdom( color ).GetCastles();
+        const int32_t startIndex = castles.empty() ? 0 : castles.front()->GetIndex();
+
+        AIWorldPathfinder pathfinder;
+
+        runner.run( "world/ai_pathfinder_full_map", 50, [&pathfinder, startIndex, color]() {
+            pathfinder.reset();
+            pathfinder.reEvaluateIfNeeded( startIndex, color, 1000.0, Skill::Level::EXPERT );
+            resultSink = resultSink + pathfinder.getDistance( 0 );
+        } );
+
+        // The battle is fought on the first empty land tile, without any castle.
+        int32_t battleTileIndex = -1;
+        for ( int32_t i = 0; i < static_cast<int32_t>( world.getSize() ); ++i ) {
+            const Maps::Tile & tile = world.getTile( i );
+            if ( !tile.isWater() && tile.getMainObjectType() == MP2::OBJ_NONE ) {
+                battleTileIndex = i;
+                break;
+            }
+        }
+
+        if ( battleTileIndex < 0 ) {
+            runner.skip( "battle/ai_simulate", "no land tile" );
+        }
+        else {
+            Army attackingArmy;
+            attackingArmy.SetColor( color );
+            attackingArmy.JoinTroop( Monster( Monster::SWORDSMAN ), 40, false );
+            attackingArmy.JoinTroop( Monster( Monster::ARCHER ), 30, false );
+            attackingArmy.JoinTroop( Monster( Monster::GRIFFIN ), 12, false );
+            attackingArmy.JoinTroop( Monster( Monster::PIKEMAN ), 40, false );
+
+            Army defendingArmy;
+            defendingArmy.JoinTroop( Monster( Monster::GOBLIN ), 120, false );
+            defendingArmy.JoinTroop( Monster( Monster::ORC ), 50, false );
+            defendingArmy.JoinTroop( Monster( Monster::WOLF ), 25, false );
+            defendingArmy.JoinTroop( Monster( Monster::OGRE ), 15, false );
+
+            // The whole battle is played by the AI, so this mostly measures AI::BattlePlanner::BattleTurn() and the battle pathfinder.
+            runner.run( "battle/ai_simulate", 10, [&attackingArmy, &defendingArmy, battleTileIndex]() {
+                const Battle::SimulationResult result = Battle::Simulate( attackingArmy, defendingArmy, battleTileIndex, benchmarkSeed );
+                resultSink = resultSink + result.numberOfTurns;
+            } );
+        }
+
+        runner.run( "game/save", 10, [&saveFilePath]() {
+            if ( !Game::Save( saveFilePath ) ) {
+                ERROR_LOG( "Failed to save the game to " << saveFilePath )
+            }
+        } );
+
+        if ( !System::IsFile( saveFilePath ) ) {
+            runner.skip( "game/load", "no save file" );
+            return;
+        }
+
+        runner.run( "game/load", 10, [&saveFilePath]() {
+            if ( Game::Load( saveFilePath ) == fheroes2::GameMode::CANCEL ) {
+                ERROR_LOG( "Failed to load the game from " << saveFilePath )
+            }
+        } );
+    }
+
+    void runGameBenchmarks( BenchmarkRunner & runner )
+    {
+        std::error_code errorCode;
+        const std::filesystem::path tempDirectory = std::filesystem::temp_directory_path( errorCode );
+        if ( errorCode ) {
+            std::cerr << "Cannot find the temporary directory: " << errorCode.message() << std::endl;
+            return;
+        }
+
+        const std::string mapFilePath = System::fsPathToString( tempDirectory / "fheroes2_bench.fh2m" );
+        const std::string saveFilePath = System::fsPathToString( tempDirectory / "fheroes2_bench.sav" );
+
+        if ( prepareWorld( runner, mapFilePath ) ) {
+            runWorldBenchmarks( runner, saveFilePath );
+        }
+        else {
+            runner.skip( "world", "failed to prepare the world" );
+        }
+
+        System::Unlink( mapFilePath );
+        System::Unlink( saveFilePath );
+    }
+}
+
+int main( int argc, char ** argv )
+{
+    if ( argc > 1 && std::string_view( argv[1] ) == "selfplay" ) {
+        Logging::InitLog();
+
+        Settings::Get().SetProgramPath( argv[0] );
+
+        return SelfPlay::run( std::vector<std::string>( argv + 2, argv + argc ), argv[0] );
+    }
+
+    if ( argc > 1 && std::string_view( argv[1] ) == "battles" ) {
+        Logging::InitLog();
+
+        Settings::Get().SetProgramPath( argv[0] );
+
+        return BattleBench::run( std::vector<std::string>( argv + 2, argv + argc ), argv[0] );
+    }
+
+    if ( argc > 1 && std::string_view( argv[1] ) == "maps" ) {
+        Logging::InitLog();
+
+        Settings::Get().SetProgramPath( argv[0] );
+
+        return MapBench::run( std::vector<std::string>( argv + 2, argv + argc ), argv[0] );
+    }
+
+    if ( argc > 1 && std::string_view( argv[1] ) == "ai" ) {
+        Logging::InitLog();
+
+        Settings::Get().SetProgramPath( argv[0] );
+
+        return SelfPlay::runAIBenchmark( std::vector<std::string>( argv + 2, argv + argc ), argv[0] );
+    }
+
+    std::string outputFileName;
+    std::string filter;
+
+    for ( int i = 1; i < argc; ++i ) {
+        const std::string_view arg( argv[i] );
+
+        if ( arg == "-o" && i + 1 < argc ) {
+            outputFileName = argv[++i];
+        }
+        else if ( arg == "-f" && i + 1 < argc ) {
+            filter = argv[++i];
+        }
+        else {
+            const std::string toolName = System::GetFileName( argv[0] );
+
+            std::cerr << toolName << " runs reproducible benchmarks of the engine and the game and writes the results in JSON format." << std::endl
+                      << "Benchmarks which require the game data are run only if the original game resources are found." << std::endl
+                      << "Syntax: " << toolName << " [-o output_file.json] [-f name_filter]" << std::endl
+                      << "Run " << toolName << " selfplay -h to see the options of AI self-play games." << std::endl
+                      << "Run " << toolName << " battles -h to see the options of battle simulation." << std::endl
+                      << "Run " << toolName << " maps -h to see the options of random map generation." << std::endl
+                      << "Run " << toolName << " ai -h to see the options of the AI benchmark." << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    try {
+        Logging::InitLog();
+
+        Settings::Get().SetProgramPath( argv[0] );
+
+        BenchmarkRunner runner( filter );
+
+        runImageBenchmarks( runner );
+        runCompressionBenchmarks( runner );
+
+        bool isGameDataAvailable = false;
+
+        std::unique_ptr<AGG::AGGInitializer> aggInitializer;
+        std::unique_ptr<fheroes2::h2d::H2DInitializer> h2dInitializer;
+
+        try {
+            aggInitializer = std::make_unique<AGG::AGGInitializer>();
+            h2dInitializer = std::make_unique<fheroes2::h2d::H2DInitializer>();
+
+            isGameDataAvailable = true;
+        }
+        catch ( const std::exception & ex ) {
+            std::cerr << "Game data is not available, the game benchmarks are skipped: " << ex.what() << std::endl;
+        }
+
+        if ( isGameDataAvailable ) {
+            runICNBenchmarks( runner );
+            runGameBenchmarks( runner );
+        }
+        else {
+            runner.skip( "icn", "no game data" );
+            runner.skip( "maps", "no game data" );
+            runner.skip( "world", "no game data" );
+            runner.skip( "battle", "no game data" );
+            runner.skip( "game", "no game data" );
+        }
+
+        if ( outputFileName.empty() ) {
+            runner.writeJSON( std::cout, isGameDataAvailable );
+        }
+        else {
+            std::ofstream outputStream( outputFileName, std::ios_base::trunc );
+            runner.writeJSON( outputStream, isGameDataAvailable );
+
+            if ( !outputStream ) {
+                std::cerr << "Cannot write file " << outputFileName << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+    }
+    catch ( const std::exception & ex ) {
+        std::cerr << "Benchmark failed: " << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,370 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "map_bench.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <utility>
+
+#include "agg.h"
+#include "bench_utils.h"
+#include "h2d.h"
+#include "map_format_helper.h"
+#include "map_format_info.h"
+#include "map_object_info.h"
+#include "map_random_generator.h"
+#include "math_base.h"
+#include "settings.h"
+#include "system.h"
+#include "timing.h"
+
+namespace
+{
+    constexpr uint32_t defaultSeed = 1;
+
+    struct Options
+    {
+        uint32_t maps{ 10 };
+        uint32_t jobs{ 1 };
+        uint32_t seed{ defaultSeed };
+        int32_t mapSize{ 72 };
+        int32_t playerCount{ 4 };
+
+        std::string directory{ "random_maps" };
+        std::string outputFileName;
+
+        // These options are set only for the processes generating a single map.
+        int32_t mapIndex{ -1 };
+        std::string resultFileName;
+    };
+
+    struct MapMetrics
+    {
+        bool isGenerated{ false };
+        double generationTime{ 0 };
+
+        int32_t townCount{ 0 };
+        int32_t mineCount{ 0 };
+        int32_t treasureCount{ 0 };
+        int32_t monsterCount{ 0 };
+
+        // Distances between towns are measured in tiles and do not account for obstacles.
+        int32_t minTownDistance{ 0 };
+        int32_t maxTownDistance{ 0 };
+    };
+
+    bool parseOptions( const std::vector<std::string> & arguments, Options & options )
+    {
+        for ( size_t i = 0; i < arguments.size(); ++i ) {
+            const std::string & arg = arguments[i];
+            if ( i + 1 >= arguments.size() ) {
+                return false;
+            }
+
+            const std::string & value = arguments[++i];
+            uint32_t number = 0;
+
+            if ( arg == "-d" ) {
+                options.directory = value;
+            }
+            else if ( arg == "-o" ) {
+                options.outputFileName = value;
+            }
+            else if ( arg == "-result" ) {
+                options.resultFileName = value;
+            }
+            else if ( !BenchUtils::parseNumber( value, number ) ) {
+                return false;
+            }
+            else if ( arg == "-n" ) {
+                options.maps = number;
+            }
+            else if ( arg == "-j" ) {
+                options.jobs = std::max( number, 1U );
+            }
+            else if ( arg == "-s" ) {
+                options.seed = number;
+            }
+            else if ( arg == "-m" ) {
+                options.mapSize = static_cast<int32_t>( number );
+            }
+            else if ( arg == "-p" ) {
+                options.playerCount = static_cast<int32_t>( number );
+            }
+            else if ( arg == "-map" ) {
+                options.mapIndex = static_cast<int32_t>( number );
+            }
+            else {
+                return false;
+            }
+        }
+
+        return !options.directory.empty();
+    }
+
+    std::string getMapName( const Options & options, const uint32_t seed )
+    {
+        return "random_" + std::to_string( options.mapSize ) + "_" + std::to_string( options.playerCount ) + "p_" + std::to_string( seed );
+    }
+
+    void calculateMapMetrics( const Maps::Map_Format::MapFormat & map, MapMetrics & metrics )
+    {
+        std::vector<fheroes2::Point> townPositions;
+
+        for ( size_t tileIndex = 0; tileIndex < map.tiles.size(); ++tileIndex ) {
+            for ( const auto & object : map.tiles[tileIndex].objects ) {
+                switch ( object.group ) {
+                case Maps::ObjectGroup::KINGDOM_TOWNS:
+                    townPositions.emplace_back( static_cast<int32_t>( tileIndex ) % map.width, static_cast<int32_t>( tileIndex ) / map.width );
+                    break;
+                case Maps::ObjectGroup::ADVENTURE_MINES:
+                    ++metrics.mineCount;
+                    break;
+                case Maps::ObjectGroup::ADVENTURE_ARTIFACTS:
+                case Maps::ObjectGroup::ADVENTURE_TREASURES:
+                    ++metrics.treasureCount;
+                    break;
+                case Maps::ObjectGroup::MONSTERS:
+                    ++metrics.monsterCount;
+                    break;
+                default:
+                    break;
+                }
+            }
+        }
+
+        metrics.townCount = static_cast<int32_t>( townPositions.size() );
+
+        for ( size_t first = 0; first < townPositions.size(); ++first ) {
+            for ( size_t second = first + 1; second < townPositions.size(); ++second ) {
+                const int32_t distance
+                    = std::max( std::abs( townPositions[first].x - townPositions[second].x ), std::abs( townPositions[first].y - townPositions[second].y ) );
+
+                metrics.minTownDistance = ( first == 0 && second == 1 ) ? distance : std::min( metrics.minTownDistance, distance );
+                metrics.maxTownDistance = std::max( metrics.maxTownDistance, distance );
+            }
+        }
+    }
+
+    bool generateMap( const Options & options, const uint32_t seed, MapMetrics & metrics )
+    {
+        Maps::Random_Generator::Configuration config;
+        config.playerCount = options.playerCount;
+        config.seed = static_cast<int32_t>( seed % 999999 );
+
+        Maps::Map_Format::MapFormat map;
+
+        const fheroes2::Time timer;
+
+        if ( !Maps::Random_Generator::generateMap( map, config, options.mapSize, options.mapSize ) || !Maps::updateMapPlayers( map ) ) {
+            // The generator is allowed to fail for some seeds, this is a part of the statistics.
+            return true;
+        }
+
+        metrics.isGenerated = true;
+        metrics.generationTime = timer.getS();
+
+        const std::string mapName = getMapName( options, seed );
+        map.name = mapName;
+
+        const std::string mapFilePath = System::concatPath( options.directory, mapName + ".fh2m" );
+        if ( !Maps::Map_Format::saveMap( mapFilePath, map ) ) {
+            std::cerr << "Cannot write file " << mapFilePath << std::endl;
+            return false;
+        }
+
+        calculateMapMetrics( map, metrics );
+
+        return true;
+    }
+
+    int runMap( const Options & options )
+    {
+        std::unique_ptr<AGG::AGGInitializer> aggInitializer;
+        std::unique_ptr<fheroes2::h2d::H2DInitializer> h2dInitializer;
+
+        try {
+            aggInitializer = std::make_unique<AGG::AGGInitializer>();
+            h2dInitializer = std::make_unique<fheroes2::h2d::H2DInitializer>();
+        }
+        catch ( const std::exception & ex ) {
+            std::cerr << "Game data is not available: " << ex.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        MapMetrics metrics;
+        if ( !generateMap( options, options.seed + static_cast<uint32_t>( options.mapIndex ), metrics ) ) {
+            return EXIT_FAILURE;
+        }
+
+        std::ofstream stream( options.resultFileName, std::ios_base::trunc );
+        stream << metrics.isGenerated << ' ' << metrics.generationTime << ' ' << metrics.townCount << ' ' << metrics.mineCount << ' ' << metrics.treasureCount
+               << ' ' << metrics.monsterCount << ' ' << metrics.minTownDistance << ' ' << metrics.maxTownDistance << std::endl;
+
+        return stream ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    std::string getMapCommand( const Options & options, const std::string & programPath, const uint32_t mapIndex, const std::string & resultFileName )
+    {
+        std::ostringstream command;
+        command << '"' << programPath << "\" maps -map " << mapIndex << " -result \"" << resultFileName << "\" -s " << options.seed << " -m " << options.mapSize
+                << " -p " << options.playerCount << " -d \"" << options.directory << '"';
+
+        return command.str();
+    }
+
+    void writeSummary( std::ostream & stream, const Options & options, const std::vector<std::pair<uint32_t, MapMetrics>> & results, const uint32_t failedMaps )
+    {
+        uint32_t generatedMaps = 0;
+        double generationTime = 0;
+        double maxGenerationTime = 0;
+
+        for ( const auto & [seed, metrics] : results ) {
+            if ( metrics.isGenerated ) {
+                ++generatedMaps;
+                generationTime += metrics.generationTime;
+                maxGenerationTime = std::max( maxGenerationTime, metrics.generationTime );
+            }
+        }
+
+        stream << std::fixed << std::setprecision( 3 );
+
+        stream << "{" << std::endl;
+        stream << "  \"version\": \"" << Settings::GetVersion() << "\"," << std::endl;
+        stream << "  \"seed\": " << options.seed << "," << std::endl;
+        stream << "  \"map_size\": " << options.mapSize << "," << std::endl;
+        stream << "  \"players\": " << options.playerCount << "," << std::endl;
+        stream << "  \"generated_maps\": " << generatedMaps << "," << std::endl;
+        stream << "  \"not_generated_maps\": " << results.size() - generatedMaps << "," << std::endl;
+        stream << "  \"failed_maps\": " << failedMaps << "," << std::endl;
+        stream << "  \"mean_generation_ms\": " << ( generatedMaps == 0 ? 0.0 : generationTime * 1000.0 / generatedMaps ) << "," << std::endl;
+        stream << "  \"max_generation_ms\": " << maxGenerationTime * 1000.0 << "," << std::endl;
+
+        stream << "  \"maps\": [";
+        for ( size_t i = 0; i < results.size(); ++i ) {
+            const auto & [seed, metrics] = results[i];
+
+            stream << ( i == 0 ? "" : "," ) << std::endl;
+            stream << "    { \"seed\": " << seed << ", \"generated\": " << ( metrics.isGenerated ? "true" : "false" );
+
+            if ( metrics.isGenerated ) {
+                stream << ", \"name\": \"" << getMapName( options, seed ) << "\", \"generation_ms\": " << metrics.generationTime * 1000.0
+                       << ", \"towns\": " << metrics.townCount << ", \"mines\": " << metrics.mineCount << ", \"treasures\": " << metrics.treasureCount
+                       << ", \"monsters\": " << metrics.monsterCount << ", \"min_town_distance\": " << metrics.minTownDistance
+                       << ", \"max_town_distance\": " << metrics.maxTownDistance;
+            }
+
+            stream << " }";
+        }
+        stream << std::endl << "  ]" << std::endl;
+
+        stream << "}" << std::endl;
+    }
+
+    int runMaps( const Options & options, const std::string & programPath )
+    {
+        if ( !System::IsDirectory( options.directory ) && !System::MakeDirectory( options.directory ) ) {
+            std::cerr << "Cannot create directory " << options.directory << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        std::vector<std::string> resultFileNames;
+        for ( uint32_t i = 0; i < options.maps; ++i ) {
+            resultFileNames.push_back( BenchUtils::getTemporaryFilePath( "fheroes2_maps_" + std::to_string( i ) + ".txt" ) );
+        }
+
+        BenchUtils::runProcesses( options.maps, options.jobs, [&options, &programPath, &resultFileNames]( const uint32_t mapIndex ) {
+            return getMapCommand( options, programPath, mapIndex, resultFileNames[mapIndex] );
+        } );
+
+        std::vector<std::pair<uint32_t, MapMetrics>> results;
+        uint32_t failedMaps = 0;
+
+        for ( uint32_t i = 0; i < options.maps; ++i ) {
+            std::ifstream stream( resultFileNames[i] );
+
+            MapMetrics metrics;
+            if ( stream >> metrics.isGenerated >> metrics.generationTime >> metrics.townCount >> metrics.mineCount >> metrics.treasureCount >> metrics.monsterCount
+                 >> metrics.minTownDistance >> metrics.maxTownDistance ) {
+                results.emplace_back( options.seed + i, metrics );
+            }
+            else {
+                ++failedMaps;
+            }
+
+            stream.close();
+            System::Unlink( resultFileNames[i] );
+        }
+
+        if ( options.outputFileName.empty() ) {
+            writeSummary( std::cout, options, results, failedMaps );
+            return EXIT_SUCCESS;
+        }
+
+        std::ofstream outputStream( options.outputFileName, std::ios_base::trunc );
+        writeSummary( outputStream, options, results, failedMaps );
+
+        if ( !outputStream ) {
+            std::cerr << "Cannot write file " << options.outputFileName << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        return EXIT_SUCCESS;
+    }
+}
+
+namespace MapBench
+{
+    int run( const std::vector<std::string> & arguments, const std::string & programPath )
+    {
+        Options options;
+        if ( !parseOptions( arguments, options ) ) {
+            const std::string toolName = System::GetFileName( programPath );
+
+            std::cerr << toolName << " maps generates random maps for consecutive seeds, saves them into a directory and writes generation times"
+                      << " and basic balance metrics of the maps in JSON format." << std::endl
+                      << "Syntax: " << toolName
+                      << " maps [-s first_seed] [-n maps] [-m map_size] [-p players] [-j parallel_processes] [-d map_directory] [-o output_file.json]"
+                      << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        try {
+            if ( options.mapIndex >= 0 ) {
+                return runMap( options );
+            }
+
+            return runMaps( options, programPath );
+        }
+        catch ( const std::exception & ex ) {
+            std::cerr << "Map generation failed: " << ex.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+}
@@ -0,0 +1,33 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+// Generation of random maps for a range of seeds to evaluate the changes of the random map generator. Every map is saved to disk along
+// with its generation time and basic balance metrics. The generator works with the global world, so every map is generated in a separate
+// process and several maps can be generated in parallel.
+namespace MapBench
+{
+    // Runs the generation with the given command line arguments (excluding the program name) and returns the exit code of the program.
+    int run( const std::vector<std::string> & arguments, const std::string & programPath );
+}
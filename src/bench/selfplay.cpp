@@ -0,0 +1,540 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "selfplay.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <utility>
+
+#include "agg.h"
+#include "ai_personality.h"
+#include "ai_planner.h"
+#include "bench_utils.h"
+#include "color.h"
+#include "game_mode.h"
+#include "h2d.h"
+#include "kingdom.h"
+#include "logging.h"
+#include "players.h"
+#include "rand.h"
+#include "settings.h"
+#include "system.h"
+#include "timing.h"
+#include "world.h"
+
+namespace
+{
+    constexpr uint32_t defaultSeed = 20260101;
+
+    struct Options
+    {
+        uint32_t games{ 10 };
+        uint32_t jobs{ 1 };
+        uint32_t maxDays{ 112 };
+        uint32_t seed{ defaultSeed };
+        int32_t mapSize{ 72 };
+
+        std::array<std::string, 2> parameterSetTexts;
+        std::array<AI::PlannerParameters, 2> parameterSets;
+
+        std::string outputFileName;
+
+        // Whether the summary describes the performance of the AI instead of the results of the parameter sets.
+        bool isBenchmark{ false };
+
+        // These options are set only for the processes playing a single game.
+        int32_t gameIndex{ -1 };
+        std::string resultFileName;
+    };
+
+    struct GameResult
+    {
+        // Index of the winning parameter set or -1 if nobody has won within the day limit.
+        int32_t winner{ -1 };
+        uint32_t days{ 0 };
+        std::array<double, 2> turnTime{ 0, 0 };
+        std::array<uint32_t, 2> turns{ 0, 0 };
+
+        // The time of whole days, including the start of the day for the world.
+        double dayTime{ 0 };
+        double slowestDayTime{ 0 };
+
+        // The peak memory usage of the process playing the game in bytes.
+        uint64_t peakMemory{ 0 };
+
+        uint32_t seed{ 0 };
+    };
+
+    // Parses parameters in the "name=value,name=value" format. Parameters which are not listed keep their default values.
+    bool parseParameters( const std::string & text, AI::PlannerParameters & parameters )
+    {
+        std::istringstream stream( text );
+        std::string item;
+
+        while ( std::getline( stream, item, ',' ) ) {
+            const size_t separatorPos = item.find( '=' );
+            if ( separatorPos == std::string::npos ) {
+                return false;
+            }
+
+            const std::string name = item.substr( 0, separatorPos );
+            const std::string valueText = item.substr( separatorPos + 1 );
+
+            char * valueEnd = nullptr;
+            const double value = std::strtod( valueText.c_str(), &valueEnd );
+            if ( valueText.empty() || *valueEnd != '\0' ) {
+                return false;
+            }
+
+            if ( name == "desperate" ) {
+                parameters.armyAdvantageDesperate = value;
+            }
+            else if ( name == "small" ) {
+                parameters.armyAdvantageSmall = value;
+            }
+            else if ( name == "medium" ) {
+                parameters.armyAdvantageMedium = value;
+            }
+            else if ( name == "large" ) {
+                parameters.armyAdvantageLarge = value;
+            }
+            else if ( name == "sp_large" ) {
+                parameters.spellPointsReserveRatioLarge = value;
+            }
+            else if ( name == "sp_medium" ) {
+                parameters.spellPointsReserveRatioMedium = value;
+            }
+            else {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool parseOptions( const std::vector<std::string> & arguments, Options & options )
+    {
+        for ( size_t i = 0; i < arguments.size(); ++i ) {
+            const std::string & arg = arguments[i];
+            if ( i + 1 >= arguments.size() ) {
+                return false;
+            }
+
+            const std::string & value = arguments[++i];
+            uint32_t number = 0;
+
+            if ( arg == "-a" || arg == "-b" ) {
+                const size_t setIndex = ( arg == "-a" ) ? 0 : 1;
+                options.parameterSetTexts[setIndex] = value;
+                if ( !parseParameters( value, options.parameterSets[setIndex] ) ) {
+                    return false;
+                }
+            }
+            else if ( arg == "-o" ) {
+                options.outputFileName = value;
+            }
+            else if ( arg == "-result" ) {
+                options.resultFileName = value;
+            }
+            else if ( !BenchUtils::parseNumber( value, number ) ) {
+                return false;
+            }
+            else if ( arg == "-n" ) {
+                options.games = number;
+            }
+            else if ( arg == "-j" ) {
+                options.jobs = std::max( number, 1U );
+            }
+            else if ( arg == "-d" ) {
+                options.maxDays = number;
+            }
+            else if ( arg == "-s" ) {
+                options.seed = number;
+            }
+            else if ( arg == "-m" ) {
+                options.mapSize = static_cast<int32_t>( number );
+            }
+            else if ( arg == "-game" ) {
+                options.gameIndex = static_cast<int32_t>( number );
+            }
+            else {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool playGame( const Options & options, const uint32_t gameIndex, GameResult & result )
+    {
+        const uint32_t seed = options.seed + gameIndex;
+        const std::string mapFilePath = BenchUtils::getTemporaryFilePath( "fheroes2_selfplay_" + std::to_string( gameIndex ) + ".fh2m" );
+
+        if ( !BenchUtils::prepareWorld( seed, options.mapSize, 2, "Self-play", mapFilePath, true ) ) {
+            return false;
+        }
+
+        Settings & conf = Settings::Get();
+        const std::vector<Player *> & players = conf.GetPlayers().getVector();
+
+        // The sets of parameters swap their positions in every other game to cancel out the advantage of a starting position.
+        const size_t firstSetIndex = gameIndex % 2;
+
+        std::vector<std::pair<PlayerColor, size_t>> kingdomSets;
+        AI::resetPlannerParameters();
+
+        for ( size_t i = 0; i < players.size(); ++i ) {
+            const PlayerColor color = players[i]->GetColor();
+            const size_t setIndex = ( firstSetIndex + i ) % 2;
+
+            AI::setPlannerParameters( color, options.parameterSets[setIndex] );
+            kingdomSets.emplace_back( color, setIndex );
+        }
+
+        Rand::CurrentThreadRandomDevice() = Rand::PCG32( seed );
+
+        for ( uint32_t day = 0; day < options.maxDays; ++day ) {
+            const fheroes2::Time dayTimer;
+
+            world.NewDay();
+
+            for ( const auto & [color, setIndex] : kingdomSets ) {
+                Kingdom & kingdom = world.GetKingdom( color );
+                if ( !kingdom.isPlay() ) {
+                    continue;
+                }
+
+                conf.SetCurrentColor( color );
+
+                kingdom.ActionNewDayResourceUpdate( nullptr );
+                kingdom.ActionBeforeTurn();
+
+                const fheroes2::Time timer;
+                const fheroes2::GameMode gameMode = AI::Planner::Get().KingdomTurn( kingdom );
+
+                result.turnTime[setIndex] += timer.getS();
+                ++result.turns[setIndex];
+
+                if ( gameMode != fheroes2::GameMode::END_TURN ) {
+                    ERROR_LOG( "Game " << gameIndex << " was interrupted on day " << day + 1 )
+                    return false;
+                }
+            }
+
+            conf.SetCurrentColor( PlayerColor::NONE );
+
+            const double dayTime = dayTimer.getS();
+
+            result.dayTime += dayTime;
+            result.slowestDayTime = std::max( result.slowestDayTime, dayTime );
+            result.days = day + 1;
+
+            std::array<bool, 2> isSetPlaying{ false, false };
+            for ( const auto & [color, setIndex] : kingdomSets ) {
+                if ( world.GetKingdom( color ).isPlay() ) {
+                    isSetPlaying[setIndex] = true;
+                }
+            }
+
+            if ( isSetPlaying[0] != isSetPlaying[1] ) {
+                result.winner = isSetPlaying[0] ? 0 : 1;
+                break;
+            }
+
+            if ( !isSetPlaying[0] ) {
+                break;
+            }
+        }
+
+        return true;
+    }
+
+    int runGame( const Options & options )
+    {
+        std::unique_ptr<AGG::AGGInitializer> aggInitializer;
+        std::unique_ptr<fheroes2::h2d::H2DInitializer> h2dInitializer;
+
+        try {
+            aggInitializer = std::make_unique<AGG::AGGInitializer>();
+            h2dInitializer = std::make_unique<fheroes2::h2d::H2DInitializer>();
+        }
+        catch ( const std::exception & ex ) {
+            std::cerr << "Game data is not available: " << ex.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        GameResult result;
+        if ( !playGame( options, static_cast<uint32_t>( options.gameIndex ), result ) ) {
+            return EXIT_FAILURE;
+        }
+
+        result.peakMemory = System::getPeakMemoryUsage();
+
+        std::ofstream stream( options.resultFileName, std::ios_base::trunc );
+        stream << result.winner << ' ' << result.days << ' ' << result.turnTime[0] << ' ' << result.turnTime[1] << ' ' << result.turns[0] << ' '
+               << result.turns[1] << ' ' << result.dayTime << ' ' << result.slowestDayTime << ' ' << result.peakMemory << std::endl;
+
+        return stream ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    std::string getGameCommand( const Options & options, const std::string & programPath, const uint32_t gameIndex, const std::string & resultFileName )
+    {
+        std::ostringstream command;
+        command << '"' << programPath << "\" selfplay -game " << gameIndex << " -result \"" << resultFileName << "\" -d " << options.maxDays << " -s "
+                << options.seed << " -m " << options.mapSize;
+
+        if ( !options.parameterSetTexts[0].empty() ) {
+            command << " -a \"" << options.parameterSetTexts[0] << '"';
+        }
+        if ( !options.parameterSetTexts[1].empty() ) {
+            command << " -b \"" << options.parameterSetTexts[1] << '"';
+        }
+
+        return command.str();
+    }
+
+    void writeSummary( std::ostream & stream, const Options & options, const std::vector<GameResult> & results, const uint32_t failedGames )
+    {
+        std::array<uint32_t, 2> wins{ 0, 0 };
+        std::array<double, 2> turnTime{ 0, 0 };
+        std::array<uint32_t, 2> turns{ 0, 0 };
+        uint32_t draws = 0;
+        uint32_t days = 0;
+
+        for ( const GameResult & result : results ) {
+            if ( result.winner < 0 ) {
+                ++draws;
+            }
+            else {
+                ++wins[result.winner];
+            }
+
+            days += result.days;
+
+            for ( size_t i = 0; i < 2; ++i ) {
+                turnTime[i] += result.turnTime[i];
+                turns[i] += result.turns[i];
+            }
+        }
+
+        const double playedGames = results.empty() ? 1.0 : static_cast<double>( results.size() );
+
+        stream << std::fixed << std::setprecision( 3 );
+
+        stream << "{" << std::endl;
+        stream << "  \"version\": \"" << Settings::GetVersion() << "\"," << std::endl;
+        stream << "  \"seed\": " << options.seed << "," << std::endl;
+        stream << "  \"map_size\": " << options.mapSize << "," << std::endl;
+        stream << "  \"max_days\": " << options.maxDays << "," << std::endl;
+        stream << "  \"games\": " << results.size() << "," << std::endl;
+        stream << "  \"failed_games\": " << failedGames << "," << std::endl;
+        stream << "  \"draws\": " << draws << "," << std::endl;
+        stream << "  \"average_days\": " << days / playedGames << "," << std::endl;
+
+        stream << "  \"parameter_sets\": [";
+        for ( size_t i = 0; i < 2; ++i ) {
+            stream << ( i == 0 ? "" : "," ) << std::endl;
+            stream << "    { \"parameters\": \"" << options.parameterSetTexts[i] << "\", \"wins\": " << wins[i] << ", \"win_rate\": " << wins[i] / playedGames
+                   << ", \"turns\": " << turns[i] << ", \"mean_turn_ms\": " << ( turns[i] == 0 ? 0.0 : turnTime[i] * 1000.0 / turns[i] ) << " }";
+        }
+        stream << std::endl << "  ]" << std::endl;
+
+        stream << "}" << std::endl;
+    }
+
+    void writeBenchmarkSummary( std::ostream & stream, const Options & options, const std::vector<GameResult> & results, const uint32_t failedGames )
+    {
+        double dayTime = 0;
+        double turnTime = 0;
+        double slowestDayTime = 0;
+        uint32_t days = 0;
+        uint32_t turns = 0;
+        uint64_t peakMemory = 0;
+
+        for ( const GameResult & result : results ) {
+            dayTime += result.dayTime;
+            turnTime += result.turnTime[0] + result.turnTime[1];
+            slowestDayTime = std::max( slowestDayTime, result.slowestDayTime );
+            days += result.days;
+            turns += result.turns[0] + result.turns[1];
+            peakMemory = std::max( peakMemory, result.peakMemory );
+        }
+
+        const auto toMegabytes = []( const uint64_t bytes ) { return static_cast<double>( bytes ) / ( 1024.0 * 1024.0 ); };
+
+        stream << std::fixed << std::setprecision( 3 );
+
+        stream << "{" << std::endl;
+        stream << "  \"version\": \"" << Settings::GetVersion() << "\"," << std::endl;
+#if defined( WITH_DEBUG )
+        stream << "  \"build\": \"debug\"," << std::endl;
+#else
+        stream << "  \"build\": \"release\"," << std::endl;
+#endif
+        stream << "  \"seed\": " << options.seed << "," << std::endl;
+        stream << "  \"map_size\": " << options.mapSize << "," << std::endl;
+        stream << "  \"max_days\": " << options.maxDays << "," << std::endl;
+        stream << "  \"games\": " << results.size() << "," << std::endl;
+        stream << "  \"failed_games\": " << failedGames << "," << std::endl;
+        stream << "  \"days\": " << days << "," << std::endl;
+        stream << "  \"mean_day_ms\": " << ( days == 0 ? 0.0 : dayTime * 1000.0 / days ) << "," << std::endl;
+        stream << "  \"slowest_day_ms\": " << slowestDayTime * 1000.0 << "," << std::endl;
+        stream << "  \"mean_turn_ms\": " << ( turns == 0 ? 0.0 : turnTime * 1000.0 / turns ) << "," << std::endl;
+        stream << "  \"peak_memory_mb\": " << toMegabytes( peakMemory ) << "," << std::endl;
+
+        stream << "  \"game_results\": [";
+        for ( size_t i = 0; i < results.size(); ++i ) {
+            const GameResult & result = results[i];
+
+            stream << ( i == 0 ? "" : "," ) << std::endl;
+            stream << "    { \"seed\": " << result.seed << ", \"days\": " << result.days
+                   << ", \"mean_day_ms\": " << ( result.days == 0 ? 0.0 : result.dayTime * 1000.0 / result.days )
+                   << ", \"slowest_day_ms\": " << result.slowestDayTime * 1000.0 << ", \"peak_memory_mb\": " << toMegabytes( result.peakMemory ) << " }";
+        }
+        stream << std::endl << "  ]" << std::endl;
+
+        stream << "}" << std::endl;
+    }
+
+    int runGames( const Options & options, const std::string & programPath )
+    {
+        std::vector<std::string> resultFileNames;
+        for ( uint32_t i = 0; i < options.games; ++i ) {
+            resultFileNames.push_back( BenchUtils::getTemporaryFilePath( "fheroes2_selfplay_" + std::to_string( i ) + ".txt" ) );
+        }
+
+        BenchUtils::runProcesses( options.games, options.jobs, [&options, &programPath, &resultFileNames]( const uint32_t gameIndex ) {
+            return getGameCommand( options, programPath, gameIndex, resultFileNames[gameIndex] );
+        } );
+
+        std::vector<GameResult> results;
+        uint32_t failedGames = 0;
+
+        for ( uint32_t i = 0; i < options.games; ++i ) {
+            std::ifstream stream( resultFileNames[i] );
+
+            GameResult result;
+            if ( stream >> result.winner >> result.days >> result.turnTime[0] >> result.turnTime[1] >> result.turns[0] >> result.turns[1] >> result.dayTime
+                 >> result.slowestDayTime >> result.peakMemory ) {
+                result.seed = options.seed + i;
+                results.push_back( result );
+            }
+            else {
+                ++failedGames;
+            }
+
+            stream.close();
+            System::Unlink( resultFileNames[i] );
+        }
+
+        const auto writeResults = [&options, &results, failedGames]( std::ostream & stream ) {
+            if ( options.isBenchmark ) {
+                writeBenchmarkSummary( stream, options, results, failedGames );
+            }
+            else {
+                writeSummary( stream, options, results, failedGames );
+            }
+        };
+
+        if ( options.outputFileName.empty() ) {
+            writeResults( std::cout );
+            return EXIT_SUCCESS;
+        }
+
+        std::ofstream outputStream( options.outputFileName, std::ios_base::trunc );
+        writeResults( outputStream );
+
+        if ( !outputStream ) {
+            std::cerr << "Cannot write file " << options.outputFileName << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        return EXIT_SUCCESS;
+    }
+}
+
+namespace SelfPlay
+{
+    int run( const std::vector<std::string> & arguments, const std::string & programPath )
+    {
+        Options options;
+        if ( !parseOptions( arguments, options ) ) {
+            const std::string toolName = System::GetFileName( programPath );
+
+            std::cerr << toolName << " selfplay plays AI-only games between two sets of AI parameters and writes win rates and turn times in JSON format."
+                      << std::endl
+                      << "Parameters are given as a comma-separated list of name=value pairs, where name is one of: desperate, small, medium, large,"
+                      << " sp_large, sp_medium. Parameters which are not listed keep their default values." << std::endl
+                      << "Syntax: " << toolName
+                      << " selfplay [-a parameters] [-b parameters] [-n games] [-j parallel_games] [-d max_days] [-s seed] [-m map_size] [-o output_file.json]"
+                      << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        try {
+            if ( options.gameIndex >= 0 ) {
+                return runGame( options );
+            }
+
+            return runGames( options, programPath );
+        }
+        catch ( const std::exception & ex ) {
+            std::cerr << "Self-play failed: " << ex.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    int runAIBenchmark( const std::vector<std::string> & arguments, const std::string & programPath )
+    {
+        Options options;
+        options.maxDays = 28;
+        options.isBenchmark = true;
+
+        if ( !parseOptions( arguments, options ) || options.gameIndex >= 0 ) {
+            const std::string toolName = System::GetFileName( programPath );
+
+            std::cerr << toolName << " ai plays AI-only games on random maps and writes the time of AI days and turns and the peak memory usage"
+                      << " in JSON format." << std::endl
+                      << "Both sides use the default AI parameters unless they are given in the same way as for the self-play." << std::endl
+                      << "Syntax: " << toolName
+                      << " ai [-a parameters] [-b parameters] [-n games] [-j parallel_games] [-d days] [-s seed] [-m map_size] [-o output_file.json]"
+                      << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        try {
+            return runGames( options, programPath );
+        }
+        catch ( const std::exception & ex ) {
+            std::cerr << "AI benchmark failed: " << ex.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+}
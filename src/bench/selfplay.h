@@ -0,0 +1,36 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+// AI-only games played to tune the parameters of the adventure map AI. Two sets of parameters play against each other on random maps
+// generated from fixed seeds. Every game is played in a separate process since the game world is a global object, so several games
+// can be played in parallel. The same games are used to benchmark the AI: the time of AI days and turns and the memory usage are measured.
+namespace SelfPlay
+{
+    // Runs the self-play with the given command line arguments (excluding the program name) and returns the exit code of the program.
+    int run( const std::vector<std::string> & arguments, const std::string & programPath );
+
+    // Runs the AI benchmark with the given command line arguments (excluding the program name) and returns the exit code of the program.
+    int runAIBenchmark( const std::vector<std::string> & arguments, const std::string & programPath );
+}
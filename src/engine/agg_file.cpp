@@ -24,11 +24,17 @@
 #include <cstdint>
 #include <iterator>
 #include <string>
+#include <utility>
+
+#include "network/state_hash.h"
 
 namespace fheroes2
 {
     bool AGGFile::open( const std::string & fileName )
     {
+        _mappedFile.close();
+        _files.clear();
+
         if ( !_stream.open( fileName, "rb" ) ) {
             return false;
         }
@@ -46,6 +52,8 @@ namespace fheroes2
         _stream.seek( size - nameEntriesSize );
         ROStreamBuf nameEntries = _stream.getStreamBuf( nameEntriesSize );
 
+        _signature = Network::mixHash( size );
+
         for ( size_t i = 0; i < count; ++i ) {
             std::string name = nameEntries.getString( _maxFilenameSize );
 
@@ -58,6 +66,9 @@ namespace fheroes2
 
             const uint32_t fileOffset = fileEntries.getLE32();
             const uint32_t fileSize = fileEntries.getLE32();
+
+            _signature = Network::mixHash( _signature ^ Network::getDigest( reinterpret_cast<const uint8_t *>( name.data() ), name.size() )
+                                           ^ ( static_cast<uint64_t>( fileOffset ) << 32 | fileSize ) );
             _files.try_emplace( std::move( name ), std::make_pair( fileSize, fileOffset ) );
         }
 
@@ -66,11 +77,25 @@ namespace fheroes2
             return false;
         }
 
-        return !_stream.fail();
+        if ( _stream.fail() ) {
+            return false;
+        }
+
+        // All entries must lie inside the mapped file, otherwise fall back to the stream reading.
+        if ( _mappedFile.open( fileName ) && _mappedFile.size() != size ) {
+            _mappedFile.close();
+        }
+
+        return true;
     }
 
     std::vector<uint8_t> AGGFile::read( const std::string & fileName )
     {
+        if ( _mappedFile.isOpen() ) {
+            const auto [data, dataSize] = readView( fileName );
+            return { data, data + dataSize };
+        }
+
         auto it = _files.find( fileName );
         if ( it == _files.end() ) {
             return {};
@@ -85,6 +110,25 @@ namespace fheroes2
         return {};
     }
 
+    std::pair<const uint8_t *, size_t> AGGFile::readView( const std::string & fileName ) const
+    {
+        if ( !_mappedFile.isOpen() ) {
+            return { nullptr, 0 };
+        }
+
+        auto it = _files.find( fileName );
+        if ( it == _files.end() ) {
+            return { nullptr, 0 };
+        }
+
+        const auto [fileSize, fileOffset] = it->second;
+        if ( fileSize == 0 || static_cast<size_t>( fileOffset ) + fileSize > _mappedFile.size() ) {
+            return { nullptr, 0 };
+        }
+
+        return { _mappedFile.data() + fileOffset, fileSize };
+    }
+
     uint32_t calculateAggFilenameHash( const std::string_view str )
     {
         uint32_t hash = 0;
@@ -29,6 +29,7 @@
 #include <utility>
 #include <vector>
 
+#include "mapped_file.h"
 #include "serialize.h"
 
 namespace fheroes2
@@ -36,6 +37,13 @@ namespace fheroes2
     class AGGFile
     {
     public:
+        AGGFile() = default;
+        AGGFile( const AGGFile & ) = delete;
+
+        ~AGGFile() = default;
+
+        AGGFile & operator=( const AGGFile & ) = delete;
+
         bool isGood() const
         {
             return !_stream.fail() && !_files.empty();
@@ -44,11 +52,30 @@ namespace fheroes2
         bool open( const std::string & fileName );
         std::vector<uint8_t> read( const std::string & fileName );
 
+        // Returns a view of the file data in the memory-mapped AGG file. If the AGG file is not memory-mapped (this is not supported
+        // on some platforms) or there is no such file, { nullptr, 0 } is returned and read() should be used instead.
+        std::pair<const uint8_t *, size_t> readView( const std::string & fileName ) const;
+
+        bool isMemoryMapped() const
+        {
+            return _mappedFile.isOpen();
+        }
+
+        // Returns the hash of the file directory: names, sizes and offsets of all files. It is unique for every version of the AGG file.
+        uint64_t getSignature() const
+        {
+            return _signature;
+        }
+
     private:
         static const size_t _maxFilenameSize = 15; // 8.3 ASCIIZ file name + 2-bytes padding
 
         StreamFile _stream;
         std::map<std::string, std::pair<uint32_t, uint32_t>, std::less<>> _files;
+
+        MappedFile _mappedFile;
+
+        uint64_t _signature{ 0 };
     };
 
     struct ICNHeader
@@ -27,6 +27,7 @@
 #include <atomic>
 #include <cassert>
 #include <cmath>
+#include <cstddef>
 #include <list>
 #include <map>
 #include <memory>
@@ -44,6 +45,7 @@
 #pragma GCC diagnostic ignored "-Wswitch-default"
 #endif
 
+#include <SDL.h>
 #include <SDL_audio.h>
 #include <SDL_error.h>
 #include <SDL_mixer.h>
@@ -58,6 +60,7 @@
 #include "core.h"
 #include "dir.h"
 #include "logging.h"
+#include "serialize.h"
 #include "system.h"
 #include "thread.h"
 #include "timing.h"
@@ -96,6 +99,17 @@ namespace
 
     std::atomic<int> mixerChannelCount{ 0 };
 
+    // Priorities and start order of the sounds played in the mixer channels, indexed by the channel ID. They are used to choose
+    // the channel to take over when all channels are busy.
+    struct ChannelVoiceInfo
+    {
+        Mixer::Priority priority{ Mixer::Priority::LOW };
+        uint64_t startId{ 0 };
+    };
+
+    std::vector<ChannelVoiceInfo> channelVoices;
+    uint64_t lastVoiceStartId{ 0 };
+
     bool isMuted{ false };
     int savedMixerVolume{ 0 };
     int savedMusicVolume{ 0 };
@@ -115,29 +129,29 @@ namespace
         ~SoundSampleManager()
         {
             // Make sure that all sound samples have been eventually freed
-            assert( std::all_of( _channelSamples.begin(), _channelSamples.end(), []( const auto & item ) {
-                static const decltype( item.second ) nullQueue{ nullptr, nullptr };
-
-                return item.second == nullQueue;
-            } ) );
+            assert( std::all_of( _channelSamples.begin(), _channelSamples.end(),
+                                 []( const auto & item ) { return item.second.first.chunk == nullptr && item.second.second.chunk == nullptr; } ) );
         }
 
         SoundSampleManager & operator=( const SoundSampleManager & ) = delete;
 
-        void channelStarted( const int channelId, Mix_Chunk * sample )
+        // If the sample doesn't own its audio data, the source sample that owns this data should be specified, it will be kept alive until the sample is freed
+        void channelStarted( const int channelId, Mix_Chunk * sample, std::shared_ptr<Mix_Chunk> sourceSample )
         {
             assert( channelId >= 0 && sample != nullptr );
 
+            ChannelSample channelSample{ sample, std::move( sourceSample ) };
+
             const auto iter = _channelSamples.find( channelId );
 
             if ( iter != _channelSamples.end() ) {
                 auto & sampleQueue = iter->second;
 
-                if ( sampleQueue.first == nullptr ) {
-                    sampleQueue.first = sample;
+                if ( sampleQueue.first.chunk == nullptr ) {
+                    sampleQueue.first = std::move( channelSample );
                 }
-                else if ( sampleQueue.second == nullptr ) {
-                    sampleQueue.second = sample;
+                else if ( sampleQueue.second.chunk == nullptr ) {
+                    sampleQueue.second = std::move( channelSample );
                 }
                 else {
                     // The sample queue is already full, this shouldn't happen
@@ -147,7 +161,7 @@ namespace
                 return;
             }
 
-            const auto res = _channelSamples.try_emplace( channelId, std::make_pair( sample, nullptr ) );
+            const auto res = _channelSamples.try_emplace( channelId, std::move( channelSample ), ChannelSample{} );
             if ( !res.second ) {
                 assert( 0 );
             }
@@ -178,18 +192,24 @@ namespace
                 assert( iter != _channelSamples.end() );
 
                 auto & sampleQueue = iter->second;
-                assert( sampleQueue.first != nullptr );
+                assert( sampleQueue.first.chunk != nullptr );
 
-                Mix_FreeChunk( sampleQueue.first );
+                Mix_FreeChunk( sampleQueue.first.chunk );
 
                 // Shift the sample queue
-                sampleQueue.first = sampleQueue.second;
-                sampleQueue.second = nullptr;
+                sampleQueue.first = std::move( sampleQueue.second );
+                sampleQueue.second = {};
             }
         }
 
     private:
-        std::map<int, std::pair<Mix_Chunk *, Mix_Chunk *>> _channelSamples;
+        struct ChannelSample
+        {
+            Mix_Chunk * chunk{ nullptr };
+            std::shared_ptr<Mix_Chunk> sourceChunk;
+        };
+
+        std::map<int, std::pair<ChannelSample, ChannelSample>> _channelSamples;
 
         std::vector<int> _channelsToCleanup;
         // This mutex protects operations with _channelsToCleanup
@@ -198,6 +218,208 @@ namespace
 
     SoundSampleManager soundSampleManager;
 
+    std::unique_ptr<Mix_Chunk, void ( * )( Mix_Chunk * )> decodeSoundSample( const uint8_t * ptr, const uint32_t size )
+    {
+        std::unique_ptr<Mix_Chunk, void ( * )( Mix_Chunk * )> sample( nullptr, Mix_FreeChunk );
+
+        const std::unique_ptr<SDL_RWops, void ( * )( SDL_RWops * )> rwops( SDL_RWFromConstMem( ptr, static_cast<int>( size ) ), SDL_FreeRW );
+        if ( !rwops ) {
+            ERROR_LOG( "Failed to create an audio chunk from memory. The error: " << SDL_GetError() )
+            return sample;
+        }
+
+        sample.reset( Mix_LoadWAV_RW( rwops.get(), 0 ) );
+        if ( !sample ) {
+            ERROR_LOG( "Failed to create an audio chunk from memory. The error: " << Mix_GetError() )
+        }
+
+        return sample;
+    }
+
+    // Sound samples that are already decoded and converted to the format of the audio device, so that they can be played many times without repeating
+    // these operations. The total size of cached samples is limited, the least recently used samples are removed from the cache first. Samples removed
+    // from the cache while they are still being played are freed only after their playback is finished.
+    class SoundSampleCache
+    {
+    public:
+        SoundSampleCache() = default;
+        SoundSampleCache( const SoundSampleCache & ) = delete;
+
+        ~SoundSampleCache() = default;
+
+        SoundSampleCache & operator=( const SoundSampleCache & ) = delete;
+
+        // Returns the decoded sample of the sound with the given UID. If this sample is not in the cache yet, it is decoded from the given data
+        // and put in the cache. Returns an empty pointer in case of failure.
+        std::shared_ptr<Mix_Chunk> getSample( const uint64_t soundUID, const uint8_t * ptr, const uint32_t size )
+        {
+            const auto iter = _samples.find( soundUID );
+            if ( iter != _samples.end() ) {
+                iter->second.lastUsage = ++_usageCounter;
+
+                return iter->second.sample;
+            }
+
+            std::shared_ptr<Mix_Chunk> sample = decodeSoundSample( ptr, size );
+            if ( !sample ) {
+                return sample;
+            }
+
+            _totalSize += sample->alen;
+
+            _samples.try_emplace( soundUID, SampleInfo{ sample, ++_usageCounter } );
+
+            removeExcessSamples( soundUID );
+
+            return sample;
+        }
+
+        void clear()
+        {
+            _samples.clear();
+            _totalSize = 0;
+        }
+
+        uint64_t getTotalSize() const
+        {
+            return _totalSize;
+        }
+
+    private:
+        struct SampleInfo
+        {
+            std::shared_ptr<Mix_Chunk> sample;
+            uint64_t lastUsage{ 0 };
+        };
+
+        void removeExcessSamples( const uint64_t soundUIDToKeep )
+        {
+            while ( _totalSize > maxTotalSize ) {
+                auto leastRecentlyUsedIter = _samples.end();
+
+                for ( auto iter = _samples.begin(); iter != _samples.end(); ++iter ) {
+                    if ( iter->first == soundUIDToKeep ) {
+                        continue;
+                    }
+
+                    if ( leastRecentlyUsedIter == _samples.end() || iter->second.lastUsage < leastRecentlyUsedIter->second.lastUsage ) {
+                        leastRecentlyUsedIter = iter;
+                    }
+                }
+
+                if ( leastRecentlyUsedIter == _samples.end() ) {
+                    break;
+                }
+
+                assert( _totalSize >= leastRecentlyUsedIter->second.sample->alen );
+
+                _totalSize -= leastRecentlyUsedIter->second.sample->alen;
+                _samples.erase( leastRecentlyUsedIter );
+            }
+        }
+
+        // Sound effects of the game are short, so this is enough to keep all the sounds of a battle or of the adventure map in the cache
+        static constexpr uint64_t maxTotalSize{ 32 * 1024 * 1024 };
+
+        std::map<uint64_t, SampleInfo> _samples;
+        uint64_t _usageCounter{ 0 };
+        uint64_t _totalSize{ 0 };
+    };
+
+    SoundSampleCache soundSampleCache;
+
+    // Returns the channel which sound can be replaced by a new sound with the given priority, or a negative value if there is no such channel.
+    // The audio mutex should be acquired by the caller.
+    int findChannelToReuse( const Mixer::Priority priority )
+    {
+        const size_t channelCount = std::min( channelVoices.size(), static_cast<size_t>( std::max( mixerChannelCount.load(), 0 ) ) );
+
+        int channelToReuse = -1;
+
+        for ( size_t channel = 0; channel < channelCount; ++channel ) {
+            const ChannelVoiceInfo & voice = channelVoices[channel];
+            if ( voice.priority > priority ) {
+                continue;
+            }
+
+            if ( channelToReuse < 0 ) {
+                channelToReuse = static_cast<int>( channel );
+                continue;
+            }
+
+            const ChannelVoiceInfo & bestVoice = channelVoices[channelToReuse];
+            if ( voice.priority < bestVoice.priority || ( voice.priority == bestVoice.priority && voice.startId < bestVoice.startId ) ) {
+                channelToReuse = static_cast<int>( channel );
+            }
+        }
+
+        return channelToReuse;
+    }
+
+    // Starts playback of the given sample. The audio mutex should be acquired by the caller.
+    int playSoundSample( std::unique_ptr<Mix_Chunk, void ( * )( Mix_Chunk * )> sample, std::shared_ptr<Mix_Chunk> sourceSample, const bool loop,
+                         const std::optional<std::pair<int16_t, uint8_t>> & position, const Mixer::Priority priority )
+    {
+        assert( sample );
+
+        // SDL itself maintains all internal channel bookkeeping, so when using the "first free channel"
+        // for playback, it is not known in advance which channel will be used. If additional channel
+        // setup is needed, then, to avoid arbitrary volume fluctuations, we will temporarily mute the
+        // audio chunk itself until we can properly adjust the channel parameters.
+        const int chunkVolume = position ? Mix_VolumeChunk( sample.get(), 0 ) : 0;
+        if ( chunkVolume < 0 ) {
+            ERROR_LOG( "Failed to mute the audio chunk. The error: " << Mix_GetError() )
+            return -1;
+        }
+
+        int channel = Mix_PlayChannel( -1, sample.get(), loop ? -1 : 0 );
+        if ( channel < 0 && Mix_Playing( -1 ) >= mixerChannelCount ) {
+            // All channels are busy. Instead of raising the number of channels (and the cost of mixing) the less important sound is stopped.
+            const int channelToReuse = findChannelToReuse( priority );
+            if ( channelToReuse < 0 ) {
+                DEBUG_LOG( DBG_ENGINE, DBG_TRACE, "All audio channels are busy with more important sounds, the sound is not played." )
+                return -1;
+            }
+
+            Mix_HaltChannel( channelToReuse );
+
+            channel = Mix_PlayChannel( channelToReuse, sample.get(), loop ? -1 : 0 );
+        }
+
+        if ( channel < 0 ) {
+            ERROR_LOG( "Failed to play the audio chunk. The error: " << Mix_GetError() )
+            return channel;
+        }
+
+        if ( static_cast<size_t>( channel ) >= channelVoices.size() ) {
+            channelVoices.resize( static_cast<size_t>( channel ) + 1 );
+        }
+
+        channelVoices[channel] = { priority, ++lastVoiceStartId };
+
+        if ( position ) {
+            // Immediately pause the channel so as not to continue playing while it is being set up
+            Mix_Pause( channel );
+
+            Mixer::setPosition( channel, position->first, position->second );
+
+            // When restoring the volume of an audio chunk, the only correct result of the call is zero,
+            // because this is exactly what the volume of the muted chunk should be
+            if ( Mix_VolumeChunk( sample.get(), chunkVolume ) != 0 ) {
+                ERROR_LOG( "Failed to restore the volume of the audio chunk for channel " << channel << ". The error: " << Mix_GetError() )
+            }
+
+            // Resume the channel as soon as all its parameters are settled
+            Mix_Resume( channel );
+        }
+
+        // There can be a maximum of two items in the sample queue for a channel:
+        // the previous sample (if it hasn't been freed yet) and the current one
+        soundSampleManager.channelStarted( channel, sample.release(), std::move( sourceSample ) );
+
+        return channel;
+    }
+
     // This is the callback function set by Mix_ChannelFinished(). As a rule, it is called from
     // a SDL_Mixer internal thread. Calls of any SDL_Mixer functions are not allowed in callbacks.
     void SDLCALL channelFinished( const int channelId )
@@ -277,6 +499,16 @@ namespace
             _position = pos;
         }
 
+        // Music tracks played from files are not kept in memory.
+        size_t getMemorySize() const
+        {
+            if ( std::holds_alternative<std::vector<uint8_t>>( _source ) ) {
+                return std::get<std::vector<uint8_t>>( _source ).size();
+            }
+
+            return 0;
+        }
+
     private:
         const std::variant<std::vector<uint8_t>, std::string> _source;
         double _position{ 0 };
@@ -296,6 +528,17 @@ namespace
 
         MusicTrackManager & operator=( const MusicTrackManager & ) = delete;
 
+        size_t getMemorySize() const
+        {
+            size_t size = 0;
+
+            for ( const auto & [musicUID, track] : _musicDB ) {
+                size += track->getMemorySize();
+            }
+
+            return size;
+        }
+
         bool isTrackInMusicDB( const uint64_t musicUID ) const
         {
             return ( _musicDB.find( musicUID ) != _musicDB.end() );
@@ -592,6 +835,57 @@ namespace
         Mix_Volume( -1, Mix_Volume( 0, -1 ) );
     }
 
+    // Returns the list of SoundFont files in the format expected by SDL_mixer.
+    std::string getSoundFontPaths( const ListFiles & files )
+    {
+        std::string filePaths;
+
+        for ( const std::string & file : files ) {
+            filePaths.append( file );
+            filePaths.push_back( ';' );
+        }
+
+        // Remove the last semicolon
+        if ( !filePaths.empty() ) {
+            assert( filePaths.back() == ';' );
+
+            filePaths.pop_back();
+        }
+
+        return filePaths;
+    }
+
+    bool writeWavFile( const std::string & filePath, const std::vector<uint8_t> & samples, const int frequency, const int channels, const int bitsPerSample )
+    {
+        StreamFile file;
+        if ( !file.open( filePath, "wb" ) ) {
+            return false;
+        }
+
+        const uint32_t blockAlign = static_cast<uint32_t>( channels * bitsPerSample / 8 );
+        const uint32_t dataSize = static_cast<uint32_t>( samples.size() );
+
+        file.putRaw( "RIFF", 4 );
+        file.putLE32( 36 + dataSize );
+        file.putRaw( "WAVE", 4 );
+
+        file.putRaw( "fmt ", 4 );
+        file.putLE32( 16 );
+        // PCM
+        file.putLE16( 1 );
+        file.putLE16( static_cast<uint16_t>( channels ) );
+        file.putLE32( static_cast<uint32_t>( frequency ) );
+        file.putLE32( static_cast<uint32_t>( frequency ) * blockAlign );
+        file.putLE16( static_cast<uint16_t>( blockAlign ) );
+        file.putLE16( static_cast<uint16_t>( bitsPerSample ) );
+
+        file.putRaw( "data", 4 );
+        file.putLE32( dataSize );
+        file.putRaw( samples.data(), samples.size() );
+
+        return !file.fail();
+    }
+
 #ifndef NDEBUG
     // Checks whether the volume settings of all active mixer channels are synchronized
     bool checkChannelsVolumeSync()
@@ -729,6 +1023,9 @@ void Audio::Quit()
         Mix_HookMusicFinished( nullptr );
 
         soundSampleManager.clearFinishedSamples();
+        soundSampleCache.clear();
+
+        channelVoices.clear();
 
         musicTrackManager.clearFinishedMusic();
         musicTrackManager.clearMusicDB();
@@ -787,6 +1084,13 @@ bool Audio::isValid()
     return isInitialized;
 }
 
+size_t Audio::getMemoryUsage()
+{
+    const std::scoped_lock<std::recursive_mutex> lock( audioMutex );
+
+    return static_cast<size_t>( soundSampleCache.getTotalSize() ) + musicTrackManager.getMemorySize();
+}
+
 void Mixer::SetChannels( const int num )
 {
     if ( num <= 0 ) {
@@ -826,7 +1130,8 @@ int Mixer::getChannelCount()
     return mixerChannelCount;
 }
 
-int Mixer::Play( const uint8_t * ptr, const uint32_t size, const bool loop, const std::optional<std::pair<int16_t, uint8_t>> position /* = {} */ )
+int Mixer::Play( const uint8_t * ptr, const uint32_t size, const bool loop, const std::optional<std::pair<int16_t, uint8_t>> position /* = {} */,
+                 const Priority priority /* = Priority::NORMAL */ )
 {
     if ( ptr == nullptr || size == 0 ) {
         // You are trying to play an empty sound. Check your logic!
@@ -842,55 +1147,60 @@ int Mixer::Play( const uint8_t * ptr, const uint32_t size, const bool loop, cons
 
     soundSampleManager.clearFinishedSamples();
 
-    const std::unique_ptr<SDL_RWops, void ( * )( SDL_RWops * )> rwops( SDL_RWFromConstMem( ptr, static_cast<int>( size ) ), SDL_FreeRW );
-    if ( !rwops ) {
-        ERROR_LOG( "Failed to create an audio chunk from memory. The error: " << SDL_GetError() )
+    std::unique_ptr<Mix_Chunk, void ( * )( Mix_Chunk * )> sample = decodeSoundSample( ptr, size );
+    if ( !sample ) {
         return -1;
     }
 
-    std::unique_ptr<Mix_Chunk, void ( * )( Mix_Chunk * )> sample( Mix_LoadWAV_RW( rwops.get(), 0 ), Mix_FreeChunk );
-    if ( !sample ) {
-        ERROR_LOG( "Failed to create an audio chunk from memory. The error: " << Mix_GetError() )
+    return playSoundSample( std::move( sample ), {}, loop, position, priority );
+}
+
+int Mixer::Play( const uint64_t soundUID, const uint8_t * ptr, const uint32_t size, const bool loop,
+                 const std::optional<std::pair<int16_t, uint8_t>> position /* = {} */, const Priority priority /* = Priority::NORMAL */ )
+{
+    if ( ptr == nullptr || size == 0 ) {
+        // You are trying to play an empty sound. Check your logic!
+        assert( 0 );
         return -1;
     }
 
-    // SDL itself maintains all internal channel bookkeeping, so when using the "first free channel"
-    // for playback, it is not known in advance which channel will be used. If additional channel
-    // setup is needed, then, to avoid arbitrary volume fluctuations, we will temporarily mute the
-    // audio chunk itself until we can properly adjust the channel parameters.
-    const int chunkVolume = position ? Mix_VolumeChunk( sample.get(), 0 ) : 0;
-    if ( chunkVolume < 0 ) {
-        ERROR_LOG( "Failed to mute the audio chunk. The error: " << Mix_GetError() )
+    const std::scoped_lock<std::recursive_mutex> lock( audioMutex );
+
+    if ( !isInitialized ) {
         return -1;
     }
 
-    const int channel = Mix_PlayChannel( -1, sample.get(), loop ? -1 : 0 );
-    if ( channel < 0 ) {
-        ERROR_LOG( "Failed to play the audio chunk. The error: " << Mix_GetError() )
-        return channel;
-    }
+    soundSampleManager.clearFinishedSamples();
 
-    if ( position ) {
-        // Immediately pause the channel so as not to continue playing while it is being set up
-        Mix_Pause( channel );
+    std::shared_ptr<Mix_Chunk> sourceSample = soundSampleCache.getSample( soundUID, ptr, size );
+    if ( !sourceSample ) {
+        return -1;
+    }
 
-        setPosition( channel, position->first, position->second );
+    // Every playback uses its own chunk that refers to the audio data of the cached sample without copying it, so that the volume of each chunk
+    // can be changed independently. Such a chunk doesn't own its audio data, so freeing it doesn't affect the cached sample.
+    std::unique_ptr<Mix_Chunk, void ( * )( Mix_Chunk * )> sample( Mix_QuickLoad_RAW( sourceSample->abuf, sourceSample->alen ), Mix_FreeChunk );
+    if ( !sample ) {
+        ERROR_LOG( "Failed to create an audio chunk from the cached sample. The error: " << Mix_GetError() )
+        return -1;
+    }
 
-        // When restoring the volume of an audio chunk, the only correct result of the call is zero,
-        // because this is exactly what the volume of the muted chunk should be
-        if ( Mix_VolumeChunk( sample.get(), chunkVolume ) != 0 ) {
-            ERROR_LOG( "Failed to restore the volume of the audio chunk for channel " << channel << ". The error: " << Mix_GetError() )
-        }
+    return playSoundSample( std::move( sample ), std::move( sourceSample ), loop, position, priority );
+}
 
-        // Resume the channel as soon as all its parameters are settled
-        Mix_Resume( channel );
+void Mixer::preload( const uint64_t soundUID, const uint8_t * ptr, const uint32_t size )
+{
+    if ( ptr == nullptr || size == 0 ) {
+        return;
     }
 
-    // There can be a maximum of two items in the sample queue for a channel:
-    // the previous sample (if it hasn't been freed yet) and the current one
-    soundSampleManager.channelStarted( channel, sample.release() );
+    const std::scoped_lock<std::recursive_mutex> lock( audioMutex );
 
-    return channel;
+    if ( !isInitialized ) {
+        return;
+    }
+
+    soundSampleCache.getSample( soundUID, ptr, size );
 }
 
 void Mixer::setPosition( const int channelId, const int16_t angle, const uint8_t distance )
@@ -1089,19 +1399,7 @@ void Music::setMidiSoundFonts( const ListFiles & files )
         return;
     }
 
-    std::string filePaths;
-
-    for ( const std::string & file : files ) {
-        filePaths.append( file );
-        filePaths.push_back( ';' );
-    }
-
-    // Remove the last semicolon
-    if ( !filePaths.empty() ) {
-        assert( filePaths.back() == ';' );
-
-        filePaths.pop_back();
-    }
+    const std::string filePaths = getSoundFontPaths( files );
 
     if ( Mix_SetSoundFonts( System::encLocalToUTF8( filePaths ).c_str() ) == 0 ) {
         ERROR_LOG( "Failed to set MIDI SoundFonts using paths " << filePaths << ". The error: " << Mix_GetError() )
@@ -1124,3 +1422,127 @@ void Music::setMidiTimidityCfg( const std::string & path )
     ERROR_LOG( "Failed to set the path to the timidity.cfg file to " << path << ". The error: operation not supported" )
 #endif
 }
+
+bool Music::renderMidiToWav( const std::vector<uint8_t> & midi, const std::string & wavFilePath, const ListFiles & soundFonts, const std::string & timidityCfgPath )
+{
+    {
+        const std::scoped_lock<std::recursive_mutex> lock( audioMutex );
+
+        if ( isInitialized ) {
+            // The rendering takes over the audio device, it cannot be done while the audio subsystem is in use.
+            assert( 0 );
+            return false;
+        }
+    }
+
+    if ( midi.empty() ) {
+        return false;
+    }
+
+    const std::string rawFilePath = wavFilePath + ".raw";
+
+    // The disk audio driver writes the output of the mixer into a file. Without a delay between audio chunks
+    // it works as fast as the MIDI synthesizer is able to produce them.
+    SDL_setenv( "SDL_AUDIODRIVER", "disk", 1 );
+    SDL_setenv( "SDL_DISKAUDIOFILE", System::encLocalToUTF8( rawFilePath ).c_str(), 1 );
+    SDL_setenv( "SDL_DISKAUDIODELAY", "0", 1 );
+
+    if ( SDL_InitSubSystem( SDL_INIT_AUDIO ) != 0 ) {
+        ERROR_LOG( "Failed to initialize the audio subsystem. The error: " << SDL_GetError() )
+        return false;
+    }
+
+    Mix_Init( MIX_INIT_MID );
+
+    const AudioSpec audioSpec;
+
+    // WAV files store samples in little-endian byte order.
+    if ( Mix_OpenAudio( audioSpec.frequency, AUDIO_S16LSB, audioSpec.channels, audioSpec.chunkSize ) != 0 ) {
+        ERROR_LOG( "Failed to initialize an audio device. The error: " << Mix_GetError() )
+
+        Mix_Quit();
+        SDL_QuitSubSystem( SDL_INIT_AUDIO );
+        return false;
+    }
+
+    int frequency = 0;
+    uint16_t format = 0;
+    int channels = 0;
+
+    Mix_QuerySpec( &frequency, &format, &channels );
+
+    if ( !soundFonts.empty() && Mix_SetSoundFonts( System::encLocalToUTF8( getSoundFontPaths( soundFonts ) ).c_str() ) == 0 ) {
+        ERROR_LOG( "Failed to set MIDI SoundFonts. The error: " << Mix_GetError() )
+    }
+
+#if SDL_MIXER_VERSION_ATLEAST( 2, 6, 0 )
+    if ( !timidityCfgPath.empty() && Mix_SetTimidityCfg( System::encLocalToUTF8( timidityCfgPath ).c_str() ) == 0 ) {
+        ERROR_LOG( "Failed to set the path to the timidity.cfg file to " << timidityCfgPath << ". The error: " << Mix_GetError() )
+    }
+#else
+    (void)timidityCfgPath;
+#endif
+
+    bool isRendered = false;
+
+    Mix_Music * music = Mix_LoadMUS_RW( SDL_RWFromConstMem( midi.data(), static_cast<int>( midi.size() ) ), 1 );
+    if ( music == nullptr ) {
+        ERROR_LOG( "Failed to load a MIDI track. The error: " << Mix_GetError() )
+    }
+    else {
+        Mix_VolumeMusic( MIX_MAX_VOLUME );
+
+        if ( Mix_PlayMusic( music, 0 ) != 0 ) {
+            ERROR_LOG( "Failed to render a MIDI track. The error: " << Mix_GetError() )
+        }
+        else {
+            while ( Mix_PlayingMusic() ) {
+                SDL_Delay( 10 );
+            }
+
+            isRendered = true;
+        }
+
+        Mix_FreeMusic( music );
+    }
+
+    Mix_CloseAudio();
+    Mix_Quit();
+    SDL_QuitSubSystem( SDL_INIT_AUDIO );
+
+    std::vector<uint8_t> samples;
+
+    if ( isRendered ) {
+        StreamFile rawFile;
+        if ( rawFile.open( rawFilePath, "rb" ) ) {
+            samples = rawFile.getRaw( 0 );
+        }
+    }
+
+    System::Unlink( rawFilePath );
+
+    // The audio device keeps writing silence after the end of the track until it is closed.
+    const int bitsPerSample = SDL_AUDIO_BITSIZE( format );
+    const size_t frameSize = static_cast<size_t>( channels * bitsPerSample / 8 );
+    if ( frameSize == 0 ) {
+        return false;
+    }
+
+    size_t dataSize = samples.size() - samples.size() % frameSize;
+    while ( dataSize > 0 ) {
+        const auto frameEnd = samples.begin() + static_cast<ptrdiff_t>( dataSize );
+        if ( std::any_of( frameEnd - static_cast<ptrdiff_t>( frameSize ), frameEnd, []( const uint8_t value ) { return value != 0; } ) ) {
+            break;
+        }
+
+        dataSize -= frameSize;
+    }
+
+    if ( dataSize == 0 ) {
+        return false;
+    }
+
+    samples.resize( dataSize );
+
+    return writeWavFile( wavFilePath, samples, frequency, channels, bitsPerSample );
+}
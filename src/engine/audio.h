@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 #include <string>
@@ -42,10 +43,23 @@ namespace Audio
     void Unmute();
 
     bool isValid();
+
+    // Returns the size of the decoded sound samples and of the music tracks kept in memory.
+    size_t getMemoryUsage();
 }
 
 namespace Mixer
 {
+    // Priority of a sound when all mixer channels are busy. In this case a new sound takes over the channel of the oldest sound with the lowest
+    // priority which is not higher than the priority of the new sound. If there is no such channel then the new sound is not played.
+    enum class Priority : uint8_t
+    {
+        LOW,
+        NORMAL,
+        HIGH
+    };
+
+    // The number of channels is the maximum number of simultaneously played sounds, so it also limits the cost of sound mixing.
     void SetChannels( const int num );
 
     int getChannelCount();
@@ -53,7 +67,16 @@ namespace Mixer
     // Starts playback of the given sound with the ability of looping it, as well as (optionally)
     // the ability to specify the position of the sound source relative to the listener (the angle
     // of direction to the sound source in degrees and the distance to the sound source).
-    int Play( const uint8_t * ptr, const uint32_t size, const bool loop, const std::optional<std::pair<int16_t, uint8_t>> position = {} );
+    int Play( const uint8_t * ptr, const uint32_t size, const bool loop, const std::optional<std::pair<int16_t, uint8_t>> position = {},
+              const Priority priority = Priority::NORMAL );
+
+    // Same as above, but the sound is decoded only once and then is played from the cache of decoded sound samples. The given UID should uniquely
+    // identify the sound data.
+    int Play( const uint64_t soundUID, const uint8_t * ptr, const uint32_t size, const bool loop, const std::optional<std::pair<int16_t, uint8_t>> position = {},
+              const Priority priority = Priority::NORMAL );
+
+    // Decodes the given sound and puts it in the cache of decoded sound samples in advance, so that its first playback doesn't have to do it.
+    void preload( const uint64_t soundUID, const uint8_t * ptr, const uint32_t size );
 
     void setVolume( const int volumePercentage );
 
@@ -108,5 +131,9 @@ namespace Music
     void setMidiSoundFonts( const ListFiles & files );
     void setMidiTimidityCfg( const std::string & path );
 
+    // Renders the MIDI track to a WAV file using the same synthesizer that is used for the playback. The audio subsystem
+    // must not be initialized because the rendering takes over the audio device. Returns true on success.
+    bool renderMidiToWav( const std::vector<uint8_t> & midi, const std::string & wavFilePath, const ListFiles & soundFonts, const std::string & timidityCfgPath );
+
     std::vector<uint8_t> Xmi2Mid( const std::vector<uint8_t> & buf );
 }
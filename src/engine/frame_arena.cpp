@@ -0,0 +1,165 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "frame_arena.h"
+
+#include <cassert>
+#include <new>
+
+namespace
+{
+    // The size of the first block. It is enough for the most of frames.
+    constexpr size_t initialBlockSize{ 64 * 1024 };
+
+    // Only the thread which resets the arena after rendering frames is allowed to use it.
+    thread_local bool isRenderingThread{ false };
+}
+
+namespace fheroes2
+{
+    FrameArena & FrameArena::instance()
+    {
+        static FrameArena arena;
+        return arena;
+    }
+
+    void * FrameArena::allocate( const size_t size, const size_t alignment )
+    {
+        assert( alignment > 0 && ( alignment & ( alignment - 1 ) ) == 0 && alignment <= alignof( std::max_align_t ) );
+
+        if ( !isRenderingThread ) {
+            return ::operator new( size );
+        }
+
+        while ( true ) {
+            if ( _blockId < _blocks.size() ) {
+                Block & block = _blocks[_blockId];
+
+                const uintptr_t address = reinterpret_cast<uintptr_t>( block.data.get() ) + _offset;
+                const size_t padding = ( alignment - address % alignment ) % alignment;
+
+                if ( _offset + padding + size <= block.size ) {
+                    void * ptr = block.data.get() + _offset + padding;
+                    _offset += padding + size;
+
+                    ++_liveAllocationCount;
+                    ++_statistics.allocationCount;
+                    _statistics.allocatedBytes += size;
+
+                    return ptr;
+                }
+
+                if ( _blockId + 1 < _blocks.size() ) {
+                    ++_blockId;
+                    _offset = 0;
+                    continue;
+                }
+            }
+
+            _addBlock( size + alignment );
+        }
+    }
+
+    void FrameArena::deallocate( void * ptr, const size_t size ) noexcept
+    {
+        if ( ptr == nullptr ) {
+            return;
+        }
+
+        if ( !isRenderingThread ) {
+            ::operator delete( ptr );
+            return;
+        }
+
+        uint8_t * data = static_cast<uint8_t *>( ptr );
+
+        for ( size_t i = 0; i <= _blockId && i < _blocks.size(); ++i ) {
+            const Block & block = _blocks[i];
+            if ( data < block.data.get() || data >= block.data.get() + block.size ) {
+                continue;
+            }
+
+            assert( _liveAllocationCount > 0 );
+            --_liveAllocationCount;
+
+            // Memory of the latest allocation is given back immediately, which is the usual case when a container grows.
+            if ( i == _blockId && data + size == block.data.get() + _offset ) {
+                _offset -= size;
+            }
+
+            return;
+        }
+
+        // This memory was allocated on the rendering thread before it started to use the arena.
+        ::operator delete( ptr );
+    }
+
+    void FrameArena::reset()
+    {
+        isRenderingThread = true;
+
+        _lastFrameStatistics = _statistics;
+        _statistics = {};
+
+        if ( _liveAllocationCount > 0 ) {
+            // Some objects allocated in the arena are still in use (the frame has been rendered in the middle of their lifetime).
+            // Their memory is released along with the memory of the next frame.
+            return;
+        }
+
+        if ( _blocks.size() > 1 ) {
+            // The frame did not fit into a single block. Merge all of them so the next frames will not need any allocations.
+            const size_t totalSize = capacity();
+
+            _blocks.clear();
+            _addBlock( totalSize );
+        }
+
+        _blockId = 0;
+        _offset = 0;
+    }
+
+    size_t FrameArena::capacity() const
+    {
+        size_t size = 0;
+        for ( const Block & block : _blocks ) {
+            size += block.size;
+        }
+
+        return size;
+    }
+
+    void FrameArena::_addBlock( const size_t minimumSize )
+    {
+        size_t size = _blocks.empty() ? initialBlockSize : _blocks.back().size * 2;
+        while ( size < minimumSize ) {
+            size *= 2;
+        }
+
+        Block & block = _blocks.emplace_back();
+        block.data.reset( new uint8_t[size] );
+        block.size = size;
+
+        ++_statistics.heapAllocationCount;
+
+        _blockId = _blocks.size() - 1;
+        _offset = 0;
+    }
+}
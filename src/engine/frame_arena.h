@@ -0,0 +1,139 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fheroes2
+{
+    // Memory for temporary objects created while drawing a frame: sprite lists, text layout information and so on. Memory is taken from
+    // a few big blocks by moving a pointer forward and is given back all at once after the frame is rendered (see Display::render()), so
+    // in the steady state drawing does not touch the heap at all. If the blocks are not enough for a frame, a bigger one is allocated
+    // for the next frames.
+    //
+    // Only the rendering (main) thread uses the arena. Allocations made by any other thread, or on the main thread before the first frame
+    // is rendered, are forwarded to the heap. Objects allocated in the arena must not outlive the rendering of the current frame. To stay
+    // safe the arena is not reset while any of its allocations is still alive.
+    class FrameArena
+    {
+    public:
+        struct Statistics
+        {
+            // The number of allocations served by the arena.
+            uint32_t allocationCount{ 0 };
+            // The number of allocations the arena had to make from the heap. It must be 0 in the steady state.
+            uint32_t heapAllocationCount{ 0 };
+            // The number of bytes taken from the arena.
+            size_t allocatedBytes{ 0 };
+        };
+
+        FrameArena( const FrameArena & ) = delete;
+
+        ~FrameArena() = default;
+
+        FrameArena & operator=( const FrameArena & ) = delete;
+
+        static FrameArena & instance();
+
+        void * allocate( const size_t size, const size_t alignment );
+
+        void deallocate( void * ptr, const size_t size ) noexcept;
+
+        // Releases all the memory taken during the current frame. It must be called from the rendering thread only.
+        void reset();
+
+        // Returns the statistics of the latest completed frame.
+        const Statistics & getLastFrameStatistics() const
+        {
+            return _lastFrameStatistics;
+        }
+
+        size_t capacity() const;
+
+    private:
+        struct Block
+        {
+            std::unique_ptr<uint8_t[]> data;
+            size_t size{ 0 };
+        };
+
+        FrameArena() = default;
+
+        void _addBlock( const size_t minimumSize );
+
+        std::vector<Block> _blocks;
+        // The block memory is currently taken from and the number of bytes already taken from it.
+        size_t _blockId{ 0 };
+        size_t _offset{ 0 };
+
+        size_t _liveAllocationCount{ 0 };
+
+        Statistics _statistics;
+        Statistics _lastFrameStatistics;
+    };
+
+    // Standard library allocator taking memory from the frame arena.
+    template <typename T>
+    class FrameAllocator
+    {
+    public:
+        using value_type = T;
+
+        FrameAllocator() = default;
+
+        template <typename U>
+        explicit FrameAllocator( const FrameAllocator<U> & /* unused */ ) noexcept
+        {
+            // Do nothing.
+        }
+
+        T * allocate( const size_t count )
+        {
+            return static_cast<T *>( FrameArena::instance().allocate( count * sizeof( T ), alignof( T ) ) );
+        }
+
+        void deallocate( T * ptr, const size_t count ) noexcept
+        {
+            FrameArena::instance().deallocate( ptr, count * sizeof( T ) );
+        }
+
+        template <typename U>
+        bool operator==( const FrameAllocator<U> & /* unused */ ) const noexcept
+        {
+            return true;
+        }
+
+        template <typename U>
+        bool operator!=( const FrameAllocator<U> & /* unused */ ) const noexcept
+        {
+            return false;
+        }
+    };
+
+    template <typename T>
+    using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+    using FrameString = std::basic_string<char, std::char_traits<char>, FrameAllocator<char>>;
+}
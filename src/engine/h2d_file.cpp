@@ -46,6 +46,7 @@ namespace fheroes2
     {
         _fileNameAndOffset.clear();
         _fileStream.close();
+        _mappedFile.close();
 
         if ( !_fileStream.open( path, "rb" ) ) {
             return false;
@@ -67,6 +68,8 @@ namespace fheroes2
             return false;
         }
 
+        _fileNameAndOffset.reserve( fileCount );
+
         for ( uint32_t i = 0; i < fileCount; ++i ) {
             const uint32_t offset = _fileStream.getLE32();
             const uint32_t size = _fileStream.getLE32();
@@ -79,11 +82,21 @@ namespace fheroes2
             _fileNameAndOffset.try_emplace( std::move( name ), std::make_pair( offset, size ) );
         }
 
+        // All entries have been checked against the file size, so the mapping must have exactly the same size.
+        if ( _mappedFile.open( path ) && _mappedFile.size() != fileSize ) {
+            _mappedFile.close();
+        }
+
         return true;
     }
 
     std::vector<uint8_t> H2DReader::getFile( const std::string & fileName )
     {
+        if ( _mappedFile.isOpen() ) {
+            const auto [data, size] = getFileView( fileName );
+            return { data, data + size };
+        }
+
         const auto it = _fileNameAndOffset.find( fileName );
         if ( it == _fileNameAndOffset.end() ) {
             return std::vector<uint8_t>();
@@ -93,6 +106,21 @@ namespace fheroes2
         return _fileStream.getRaw( it->second.second );
     }
 
+    std::pair<const uint8_t *, size_t> H2DReader::getFileView( const std::string & fileName ) const
+    {
+        if ( !_mappedFile.isOpen() ) {
+            return { nullptr, 0 };
+        }
+
+        const auto it = _fileNameAndOffset.find( fileName );
+        if ( it == _fileNameAndOffset.end() ) {
+            return { nullptr, 0 };
+        }
+
+        const auto [offset, size] = it->second;
+        return { _mappedFile.data() + offset, size };
+    }
+
     std::set<std::string, std::less<>> H2DReader::getAllFileNames() const
     {
         std::set<std::string, std::less<>> names;
@@ -171,33 +199,43 @@ namespace fheroes2
     {
         const size_t imageInfoLength{ 4 + 4 + 4 + 4 + 1 };
 
-        const std::vector<uint8_t> & data = reader.getFile( name );
-        if ( data.size() < imageInfoLength + 1 ) {
+        // Image data is copied directly from the memory-mapped file if possible.
+        std::vector<uint8_t> fileData;
+
+        auto [data, dataSize] = reader.getFileView( name );
+        if ( data == nullptr ) {
+            fileData = reader.getFile( name );
+
+            data = fileData.data();
+            dataSize = fileData.size();
+        }
+
+        if ( dataSize < imageInfoLength + 1 ) {
             // Empty or invalid image.
             return false;
         }
 
-        ROStreamBuf stream( data );
-        const int32_t width = static_cast<int32_t>( stream.getLE32() );
-        const int32_t height = static_cast<int32_t>( stream.getLE32() );
-        const int32_t x = static_cast<int32_t>( stream.getLE32() );
-        const int32_t y = static_cast<int32_t>( stream.getLE32() );
-        const bool isSingleLayer = ( stream.get() != 0 );
+        const char * header = reinterpret_cast<const char *>( data );
+        const int32_t width = getLEValue<int32_t>( header, 0 );
+        const int32_t height = getLEValue<int32_t>( header, 4 );
+        const int32_t x = getLEValue<int32_t>( header, 8 );
+        const int32_t y = getLEValue<int32_t>( header, 12 );
+        const bool isSingleLayer = ( data[16] != 0 );
 
-        if ( ( static_cast<size_t>( width ) * height * ( isSingleLayer ? 1 : 2 ) + imageInfoLength ) != data.size() ) {
+        if ( width <= 0 || height <= 0 || ( static_cast<size_t>( width ) * height * ( isSingleLayer ? 1 : 2 ) + imageInfoLength ) != dataSize ) {
             return false;
         }
 
-        const size_t size = static_cast<size_t>( width * height );
+        const size_t size = static_cast<size_t>( width ) * height;
         if ( isSingleLayer ) {
             image._disableTransformLayer();
         }
 
         image.resize( width, height );
-        memcpy( image.image(), data.data() + imageInfoLength, size );
+        memcpy( image.image(), data + imageInfoLength, size );
 
         if ( !isSingleLayer ) {
-            memcpy( image.transform(), data.data() + imageInfoLength + size, size );
+            memcpy( image.transform(), data + imageInfoLength + size, size );
         }
 
         image.setPosition( x, y );
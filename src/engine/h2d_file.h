@@ -20,14 +20,17 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "mapped_file.h"
 #include "serialize.h"
 
 namespace fheroes2
@@ -44,14 +47,20 @@ namespace fheroes2
         // Returns non-empty vector if requested file exists.
         std::vector<uint8_t> getFile( const std::string & fileName );
 
+        // Returns a view of the file data in the memory-mapped H2D file without copying it. If the H2D file is not memory-mapped
+        // (this is not supported on some platforms) or there is no such file, { nullptr, 0 } is returned and getFile() should be used instead.
+        std::pair<const uint8_t *, size_t> getFileView( const std::string & fileName ) const;
+
         std::set<std::string, std::less<>> getAllFileNames() const;
 
     private:
-        // Relationship between file name in non-capital letters and its offset from the start of the archive.
-        std::map<std::string, std::pair<uint32_t, uint32_t>, std::less<>> _fileNameAndOffset;
+        // Relationship between file name in non-capital letters and its offset and size.
+        std::unordered_map<std::string, std::pair<uint32_t, uint32_t>> _fileNameAndOffset;
 
         // Stream for reading h2d file.
         StreamFile _fileStream;
+
+        MappedFile _mappedFile;
     };
 
     // This class is not designed to be performance optimized as it will be used very rarely and out of game running session.
@@ -21,12 +21,25 @@
 #include "image.h"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// SSE2 is a part of x86-64 baseline so no runtime CPU feature detection is needed.
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#define FHEROES2_USE_SSE2
+#include <emmintrin.h>
+#endif
 
 #include "image_palette.h"
+#include "thread.h"
 
 namespace
 {
@@ -342,6 +355,250 @@ namespace
         return Verify( inX, inY, outX, outY, width, height, in.width(), in.height(), out.width(), out.height() );
     }
 
+    // Blitting functions process transform layer by blocks of this size. Sprites mostly consist of long runs of fully transparent or fully opaque pixels
+    // so such blocks can be skipped or copied at once instead of checking every pixel.
+    const int32_t transformBlockSize = 16;
+
+    enum class TransformBlockType : uint8_t
+    {
+        Opaque,
+        Transparent,
+        Mixed
+    };
+
+    TransformBlockType getTransformBlockType( const uint8_t * transform )
+    {
+#if defined( FHEROES2_USE_SSE2 )
+        const __m128i block = _mm_loadu_si128( reinterpret_cast<const __m128i *>( transform ) );
+
+        if ( _mm_movemask_epi8( _mm_cmpeq_epi8( block, _mm_setzero_si128() ) ) == 0xFFFF ) {
+            return TransformBlockType::Opaque;
+        }
+
+        if ( _mm_movemask_epi8( _mm_cmpeq_epi8( block, _mm_set1_epi8( 1 ) ) ) == 0xFFFF ) {
+            return TransformBlockType::Transparent;
+        }
+#else
+        // Two 64-bit words are compared at once. Compilers turn this into a couple of vector instructions on ARM.
+        static_assert( transformBlockSize == 2 * sizeof( uint64_t ) );
+
+        uint64_t first;
+        uint64_t second;
+        memcpy( &first, transform, sizeof( uint64_t ) );
+        memcpy( &second, transform + sizeof( uint64_t ), sizeof( uint64_t ) );
+
+        if ( ( first | second ) == 0 ) {
+            return TransformBlockType::Opaque;
+        }
+
+        const uint64_t transparentWord = 0x0101010101010101ULL;
+        if ( first == transparentWord && second == transparentWord ) {
+            return TransformBlockType::Transparent;
+        }
+#endif
+
+        return TransformBlockType::Mixed;
+    }
+
+    // Blits a row of a double-layer image into a single-layer image from left to right.
+    void blitRow( const uint8_t * imageIn, const uint8_t * transformIn, uint8_t * imageOut, const int32_t width )
+    {
+        int32_t x = 0;
+
+        while ( x < width ) {
+            int32_t blockEnd = width;
+
+            if ( width - x >= transformBlockSize ) {
+                blockEnd = x + transformBlockSize;
+
+                const TransformBlockType blockType = getTransformBlockType( transformIn + x );
+                if ( blockType == TransformBlockType::Transparent ) {
+                    x = blockEnd;
+                    continue;
+                }
+
+                if ( blockType == TransformBlockType::Opaque ) {
+                    memcpy( imageOut + x, imageIn + x, static_cast<size_t>( transformBlockSize ) );
+                    x = blockEnd;
+                    continue;
+                }
+            }
+
+            for ( ; x < blockEnd; ++x ) {
+                const uint8_t transformValue = transformIn[x];
+                if ( transformValue > 0 ) { // apply a transformation
+                    if ( transformValue != 1 ) { // skip pixel
+                        imageOut[x] = *( transformTable + transformValue * 256 + imageOut[x] );
+                    }
+                }
+                else { // copy a pixel
+                    imageOut[x] = imageIn[x];
+                }
+            }
+        }
+    }
+
+    // Blits a row of a double-layer image into a double-layer image from left to right.
+    void blitRow( const uint8_t * imageIn, const uint8_t * transformIn, uint8_t * imageOut, uint8_t * transformOut, const int32_t width )
+    {
+        int32_t x = 0;
+
+        while ( x < width ) {
+            int32_t blockEnd = width;
+
+            if ( width - x >= transformBlockSize ) {
+                blockEnd = x + transformBlockSize;
+
+                const TransformBlockType blockType = getTransformBlockType( transformIn + x );
+                if ( blockType == TransformBlockType::Transparent ) {
+                    x = blockEnd;
+                    continue;
+                }
+
+                if ( blockType == TransformBlockType::Opaque ) {
+                    memcpy( imageOut + x, imageIn + x, static_cast<size_t>( transformBlockSize ) );
+                    memset( transformOut + x, static_cast<uint8_t>( 0 ), static_cast<size_t>( transformBlockSize ) );
+                    x = blockEnd;
+                    continue;
+                }
+            }
+
+            for ( ; x < blockEnd; ++x ) {
+                const uint8_t transformValue = transformIn[x];
+                if ( transformValue == 1 ) { // skip pixel
+                    continue;
+                }
+
+                if ( transformValue > 0 && transformOut[x] == 0 ) { // apply a transformation
+                    imageOut[x] = *( transformTable + transformValue * 256 + imageOut[x] );
+                }
+                else { // copy a pixel
+                    transformOut[x] = transformValue;
+                    imageOut[x] = imageIn[x];
+                }
+            }
+        }
+    }
+
+    // Blits a row of a double-layer image into a single-layer image from right to left.
+    // The input pointers point to the rightmost pixel of the input row.
+    void blitFlippedRow( const uint8_t * imageIn, const uint8_t * transformIn, uint8_t * imageOut, const int32_t width )
+    {
+        int32_t x = 0;
+
+        while ( x < width ) {
+            int32_t blockEnd = width;
+
+            if ( width - x >= transformBlockSize ) {
+                blockEnd = x + transformBlockSize;
+
+                // The input pixels of this block are stored in the reverse order before the current input pixel.
+                const TransformBlockType blockType = getTransformBlockType( transformIn - x - ( transformBlockSize - 1 ) );
+                if ( blockType == TransformBlockType::Transparent ) {
+                    x = blockEnd;
+                    continue;
+                }
+
+                if ( blockType == TransformBlockType::Opaque ) {
+                    for ( ; x < blockEnd; ++x ) {
+                        imageOut[x] = *( imageIn - x );
+                    }
+                    continue;
+                }
+            }
+
+            for ( ; x < blockEnd; ++x ) {
+                const uint8_t transformValue = *( transformIn - x );
+                if ( transformValue > 0 ) { // apply a transformation
+                    if ( transformValue != 1 ) { // skip pixel
+                        imageOut[x] = *( transformTable + transformValue * 256 + imageOut[x] );
+                    }
+                }
+                else { // copy a pixel
+                    imageOut[x] = *( imageIn - x );
+                }
+            }
+        }
+    }
+
+    // Blits a row of a double-layer image into a double-layer image from right to left.
+    // The input pointers point to the rightmost pixel of the input row.
+    void blitFlippedRow( const uint8_t * imageIn, const uint8_t * transformIn, uint8_t * imageOut, uint8_t * transformOut, const int32_t width )
+    {
+        int32_t x = 0;
+
+        while ( x < width ) {
+            int32_t blockEnd = width;
+
+            if ( width - x >= transformBlockSize ) {
+                blockEnd = x + transformBlockSize;
+
+                // The input pixels of this block are stored in the reverse order before the current input pixel.
+                const TransformBlockType blockType = getTransformBlockType( transformIn - x - ( transformBlockSize - 1 ) );
+                if ( blockType == TransformBlockType::Transparent ) {
+                    x = blockEnd;
+                    continue;
+                }
+
+                if ( blockType == TransformBlockType::Opaque ) {
+                    memset( transformOut + x, static_cast<uint8_t>( 0 ), static_cast<size_t>( transformBlockSize ) );
+                    for ( ; x < blockEnd; ++x ) {
+                        imageOut[x] = *( imageIn - x );
+                    }
+                    continue;
+                }
+            }
+
+            for ( ; x < blockEnd; ++x ) {
+                const uint8_t transformValue = *( transformIn - x );
+                if ( transformValue == 1 ) { // skip pixel
+                    continue;
+                }
+
+                if ( transformValue > 0 && transformOut[x] == 0 ) { // apply a transformation
+                    imageOut[x] = *( transformTable + transformValue * 256 + imageOut[x] );
+                }
+                else { // copy a pixel
+                    transformOut[x] = transformValue;
+                    imageOut[x] = *( imageIn - x );
+                }
+            }
+        }
+    }
+
+    // Applies the transformation to the non-transparent pixels of a row of a double-layer image.
+    void applyTransformToRow( uint8_t * image, const uint8_t * transform, const uint8_t * transformLookup, const int32_t width )
+    {
+        int32_t x = 0;
+
+        while ( x < width ) {
+            int32_t blockEnd = width;
+
+            if ( width - x >= transformBlockSize ) {
+                blockEnd = x + transformBlockSize;
+
+                const TransformBlockType blockType = getTransformBlockType( transform + x );
+                if ( blockType == TransformBlockType::Transparent ) {
+                    x = blockEnd;
+                    continue;
+                }
+
+                if ( blockType == TransformBlockType::Opaque ) {
+                    for ( ; x < blockEnd; ++x ) {
+                        image[x] = transformLookup[image[x]];
+                    }
+                    continue;
+                }
+            }
+
+            for ( ; x < blockEnd; ++x ) {
+                if ( transform[x] == 0 ) {
+                    image[x] = transformLookup[image[x]];
+                }
+            }
+        }
+    }
+
     uint8_t GetPALColorId( const uint8_t red, const uint8_t green, const uint8_t blue )
     {
         static uint8_t rgbToId[64 * 64 * 64];
@@ -429,14 +686,138 @@ namespace
                 uint8_t * imageOutX = imageOutY;
                 const uint8_t * imageInXEnd = imageInX + width;
 
-                for ( ; imageInX != imageInXEnd; ++imageInX, ++imageOutX, ++transformInX ) {
-                    if ( *transformInX == 0 ) { // only modify pixels with data
-                        *imageOutX = palette[*imageInX];
+                while ( imageInX != imageInXEnd ) {
+                    const uint8_t * blockEnd = imageInXEnd;
+
+                    if ( imageInXEnd - imageInX >= transformBlockSize ) {
+                        blockEnd = imageInX + transformBlockSize;
+
+                        const TransformBlockType blockType = getTransformBlockType( transformInX );
+                        if ( blockType == TransformBlockType::Opaque ) {
+                            for ( ; imageInX != blockEnd; ++imageInX, ++imageOutX ) {
+                                *imageOutX = palette[*imageInX];
+                            }
+
+                            transformInX += transformBlockSize;
+                            continue;
+                        }
+
+                        if ( blockType == TransformBlockType::Transparent ) {
+                            imageInX = blockEnd;
+                            imageOutX += transformBlockSize;
+                            transformInX += transformBlockSize;
+                            continue;
+                        }
+                    }
+
+                    for ( ; imageInX != blockEnd; ++imageInX, ++imageOutX, ++transformInX ) {
+                        if ( *transformInX == 0 ) { // only modify pixels with data
+                            *imageOutX = palette[*imageInX];
+                        }
                     }
                 }
             }
         }
     }
+
+    // Fills the output row with the input row pixels at the given positions.
+    void resizeRow( const uint8_t * in, uint8_t * out, const std::vector<int32_t> & positionX, [[maybe_unused]] const bool isDoubleWidth )
+    {
+        const int32_t width = static_cast<int32_t>( positionX.size() );
+        int32_t x = 0;
+
+#if defined( FHEROES2_USE_SSE2 )
+        if ( isDoubleWidth ) {
+            // Every input pixel is repeated twice.
+            for ( ; x + 16 <= width; x += 16 ) {
+                const __m128i pixels = _mm_loadl_epi64( reinterpret_cast<const __m128i *>( in + x / 2 ) );
+                _mm_storeu_si128( reinterpret_cast<__m128i *>( out + x ), _mm_unpacklo_epi8( pixels, pixels ) );
+            }
+        }
+#endif
+
+        for ( ; x < width; ++x ) {
+            out[x] = in[positionX[x]];
+        }
+    }
+
+    // Buffers of image restorers. Windows and popups are opened and closed all the time, so their backgrounds are kept in buffers
+    // of a few size classes (powers of 2) which are reused instead of being allocated every time.
+    class RestorerBufferPool
+    {
+    public:
+        static RestorerBufferPool & instance()
+        {
+            static RestorerBufferPool pool;
+            return pool;
+        }
+
+        std::unique_ptr<uint8_t[]> acquire( const size_t size, size_t & capacity )
+        {
+            const size_t sizeClass = getSizeClass( size );
+            capacity = minimumBufferSize << sizeClass;
+
+            if ( sizeClass < _freeBuffers.size() ) {
+                const std::scoped_lock<std::mutex> lock( _mutex );
+
+                std::vector<std::unique_ptr<uint8_t[]>> & buffers = _freeBuffers[sizeClass];
+                if ( !buffers.empty() ) {
+                    std::unique_ptr<uint8_t[]> buffer = std::move( buffers.back() );
+                    buffers.pop_back();
+
+                    return buffer;
+                }
+            }
+            else {
+                // Such a huge buffer is not going to be pooled.
+                capacity = size;
+            }
+
+            return std::unique_ptr<uint8_t[]>( new uint8_t[capacity] );
+        }
+
+        void release( std::unique_ptr<uint8_t[]> buffer, const size_t capacity )
+        {
+            if ( !buffer ) {
+                return;
+            }
+
+            const size_t sizeClass = getSizeClass( capacity );
+            if ( sizeClass >= _freeBuffers.size() || ( minimumBufferSize << sizeClass ) != capacity ) {
+                return;
+            }
+
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
+            std::vector<std::unique_ptr<uint8_t[]>> & buffers = _freeBuffers[sizeClass];
+            if ( buffers.size() < maxFreeBuffersPerClass ) {
+                buffers.emplace_back( std::move( buffer ) );
+            }
+        }
+
+    private:
+        RestorerBufferPool() = default;
+
+        static size_t getSizeClass( const size_t size )
+        {
+            size_t sizeClass = 0;
+            while ( ( minimumBufferSize << sizeClass ) < size ) {
+                ++sizeClass;
+            }
+
+            return sizeClass;
+        }
+
+        static constexpr size_t minimumBufferSize{ 4096 };
+
+        // Nested windows rarely go deeper than this.
+        static constexpr size_t maxFreeBuffersPerClass{ 4 };
+
+        // The biggest class holds 16 MB which is enough for both layers of a 4K screen.
+        std::array<std::vector<std::unique_ptr<uint8_t[]>>, 13> _freeBuffers;
+
+        std::mutex _mutex;
+    };
 }
 
 namespace fheroes2
@@ -476,6 +857,8 @@ namespace fheroes2
 
     uint8_t * Image::image()
     {
+        _detach();
+
         return _data.get();
     }
 
@@ -496,6 +879,11 @@ namespace fheroes2
     {
         if ( !empty() ) {
             const size_t totalSize = static_cast<size_t>( _width ) * _height;
+
+            if ( isShared() ) {
+                // The whole content is going to be overwritten, so there is no need to copy it.
+                _data.reset( new uint8_t[_singleLayer ? totalSize : totalSize * 2] );
+            }
             memset( image(), value, totalSize );
 
             if ( !_singleLayer ) {
@@ -529,10 +917,26 @@ namespace fheroes2
         _height = height_;
     }
 
+    void Image::_makeUnique()
+    {
+        assert( _data );
+
+        const size_t size = static_cast<size_t>( _width ) * _height * ( _singleLayer ? 1 : 2 );
+
+        std::shared_ptr<uint8_t[]> data( new uint8_t[size] );
+        memcpy( data.get(), _data.get(), size );
+
+        _data = std::move( data );
+    }
+
     void Image::reset()
     {
         if ( !empty() ) {
             const size_t totalSize = static_cast<size_t>( _width ) * _height;
+
+            if ( isShared() ) {
+                _data.reset( new uint8_t[_singleLayer ? totalSize : totalSize * 2] );
+            }
             memset( image(), static_cast<uint8_t>( 0 ), totalSize );
 
             if ( !_singleLayer ) {
@@ -550,6 +954,16 @@ namespace fheroes2
             return;
         }
 
+        if ( !_singleLayer && !image._singleLayer ) {
+            // Share the pixels. They are going to be copied only if one of the images is modified.
+            _data = image._data;
+            _width = image._width;
+            _height = image._height;
+
+            return;
+        }
+
+        // Single-layer images are used for rendering on screen, so their buffers are always kept separate.
         const size_t imageSize = static_cast<size_t>( image._width ) * image._height;
 
         _singleLayer = image._singleLayer;
@@ -626,15 +1040,7 @@ namespace fheroes2
         , _height( image.height() )
     {
         _updateRoi();
-
-        if ( _image.singleLayer() ) {
-            // The restorer is used to restore the image without the transform layer so we make a single-layer copy.
-            _copy._disableTransformLayer();
-        }
-
-        _copy.resize( _width, _height );
-
-        Copy( _image, 0, 0, _copy, 0, 0, _width, _height );
+        _save();
     }
 
     ImageRestorer::ImageRestorer( Image & image, const int32_t x_, const int32_t y_, const int32_t width, const int32_t height )
@@ -645,15 +1051,16 @@ namespace fheroes2
         , _height( height )
     {
         _updateRoi();
+        _save();
+    }
 
-        if ( _image.singleLayer() ) {
-            // The restorer is used to restore the image without the transform layer so we make a single-layer copy.
-            _copy._disableTransformLayer();
+    ImageRestorer::~ImageRestorer()
+    {
+        if ( !_isRestored ) {
+            restore();
         }
 
-        _copy.resize( _width, _height );
-
-        Copy( _image, _x, _y, _copy, 0, 0, _width, _height );
+        RestorerBufferPool::instance().release( std::move( _buffer ), _bufferCapacity );
     }
 
     void ImageRestorer::update( const int32_t x_, const int32_t y_, const int32_t width, const int32_t height )
@@ -664,15 +1071,78 @@ namespace fheroes2
         _width = width;
         _height = height;
         _updateRoi();
-
-        _copy.resize( _width, _height );
-        Copy( _image, _x, _y, _copy, 0, 0, _width, _height );
+        _save();
     }
 
     void ImageRestorer::restore()
     {
         _isRestored = true;
-        Copy( _copy, 0, 0, _image, _x, _y, _width, _height );
+
+        if ( _width == 0 || _height == 0 ) {
+            return;
+        }
+
+        const size_t rowSize = static_cast<size_t>( _width );
+        const size_t areaSize = rowSize * _height;
+        const int32_t imageWidth = _image.width();
+        const ptrdiff_t offset = static_cast<ptrdiff_t>( _y ) * imageWidth + _x;
+
+        const uint8_t * imageIn = _buffer.get();
+        uint8_t * imageOut = _image.image() + offset;
+        for ( int32_t y = 0; y < _height; ++y, imageIn += rowSize, imageOut += imageWidth ) {
+            memcpy( imageOut, imageIn, rowSize );
+        }
+
+        if ( _image.singleLayer() ) {
+            return;
+        }
+
+        const uint8_t * transformIn = _buffer.get() + areaSize;
+        uint8_t * transformOut = _image.transform() + offset;
+        for ( int32_t y = 0; y < _height; ++y, transformIn += rowSize, transformOut += imageWidth ) {
+            memcpy( transformOut, transformIn, rowSize );
+        }
+    }
+
+    void ImageRestorer::_save()
+    {
+        if ( _width == 0 || _height == 0 ) {
+            return;
+        }
+
+        // The restorer is used to restore the image without the transform layer if the image does not have it.
+        const bool isSingleLayer = _image.singleLayer();
+
+        const size_t rowSize = static_cast<size_t>( _width );
+        const size_t areaSize = rowSize * _height;
+        const size_t requiredSize = isSingleLayer ? areaSize : areaSize * 2;
+
+        if ( requiredSize > _bufferCapacity ) {
+            RestorerBufferPool & pool = RestorerBufferPool::instance();
+            pool.release( std::move( _buffer ), _bufferCapacity );
+            _buffer = pool.acquire( requiredSize, _bufferCapacity );
+        }
+
+        // Read access must not cause the pixels of the image to be unshared.
+        const Image & image = _image;
+        const int32_t imageWidth = image.width();
+        const ptrdiff_t offset = static_cast<ptrdiff_t>( _y ) * imageWidth + _x;
+
+        const uint8_t * imageIn = image.image() + offset;
+        uint8_t * imageOut = _buffer.get();
+        for ( int32_t y = 0; y < _height; ++y, imageIn += imageWidth, imageOut += rowSize ) {
+            memcpy( imageOut, imageIn, rowSize );
+        }
+
+        if ( isSingleLayer ) {
+            return;
+        }
+
+        const uint8_t * transformIn = image.transform() + offset;
+        uint8_t * transformOut = _buffer.get() + areaSize;
+        for ( int32_t y = 0; y < _height; ++y, transformIn += imageWidth, transformOut += rowSize ) {
+            memcpy( transformOut, transformIn, rowSize );
+        }
     }
 
     void ImageRestorer::_updateRoi()
@@ -1127,13 +1597,15 @@ namespace fheroes2
         uint8_t * imageY = image.image() + y * imageWidth + x;
         const uint8_t * imageYEnd = imageY + height * imageWidth;
 
+        const uint8_t * transformLookup = transformTable + transformId * 256;
+
         if ( image.singleLayer() ) {
             for ( ; imageY != imageYEnd; imageY += imageWidth ) {
                 uint8_t * imageX = imageY;
                 const uint8_t * imageXEnd = imageX + width;
 
                 for ( ; imageX != imageXEnd; ++imageX ) {
-                    *imageX = *( transformTable + transformId * 256 + *imageX );
+                    *imageX = transformLookup[*imageX];
                 }
             }
         }
@@ -1141,15 +1613,7 @@ namespace fheroes2
             const uint8_t * transformY = image.transform() + y * imageWidth + x;
 
             for ( ; imageY != imageYEnd; imageY += imageWidth, transformY += imageWidth ) {
-                uint8_t * imageX = imageY;
-                const uint8_t * transformX = transformY;
-                const uint8_t * imageXEnd = imageX + width;
-
-                for ( ; imageX != imageXEnd; ++imageX, ++transformX ) {
-                    if ( *transformX == 0 ) {
-                        *imageX = *( transformTable + transformId * 256 + *imageX );
-                    }
-                }
+                applyTransformToRow( imageY, transformY, transformLookup, width );
             }
         }
     }
@@ -1200,46 +1664,14 @@ namespace fheroes2
             if ( out.singleLayer() ) {
                 assert( !in.singleLayer() );
                 for ( ; imageOutY != imageOutYEnd; imageInY += widthIn, transformInY += widthIn, imageOutY += widthOut ) {
-                    const uint8_t * imageInX = imageInY;
-                    const uint8_t * transformInX = transformInY;
-                    uint8_t * imageOutX = imageOutY;
-                    const uint8_t * imageOutXEnd = imageOutX + width;
-
-                    for ( ; imageOutX != imageOutXEnd; --imageInX, --transformInX, ++imageOutX ) {
-                        if ( *transformInX > 0 ) { // apply a transformation
-                            if ( *transformInX != 1 ) { // skip pixel
-                                *imageOutX = *( transformTable + ( *transformInX ) * 256 + *imageOutX );
-                            }
-                        }
-                        else { // copy a pixel
-                            *imageOutX = *imageInX;
-                        }
-                    }
+                    blitFlippedRow( imageInY, transformInY, imageOutY, width );
                 }
             }
             else {
                 uint8_t * transformOutY = out.transform() + offsetOutY;
 
                 for ( ; imageOutY != imageOutYEnd; imageInY += widthIn, transformInY += widthIn, imageOutY += widthOut, transformOutY += widthOut ) {
-                    const uint8_t * imageInX = imageInY;
-                    const uint8_t * transformInX = transformInY;
-                    uint8_t * imageOutX = imageOutY;
-                    uint8_t * transformOutX = transformOutY;
-                    const uint8_t * imageOutXEnd = imageOutX + width;
-
-                    for ( ; imageOutX != imageOutXEnd; --imageInX, --transformInX, ++imageOutX, ++transformOutX ) {
-                        if ( *transformInX == 1 ) { // skip pixel
-                            continue;
-                        }
-
-                        if ( *transformInX > 0 && *transformOutX == 0 ) { // apply a transformation
-                            *imageOutX = *( transformTable + ( *transformInX ) * 256 + *imageOutX );
-                        }
-                        else { // copy a pixel
-                            *transformOutX = *transformInX;
-                            *imageOutX = *imageInX;
-                        }
-                    }
+                    blitFlippedRow( imageInY, transformInY, imageOutY, transformOutY, width );
                 }
             }
         }
@@ -1255,46 +1687,14 @@ namespace fheroes2
             if ( out.singleLayer() ) {
                 assert( !in.singleLayer() );
                 for ( ; imageInY != imageInYEnd; imageInY += widthIn, transformInY += widthIn, imageOutY += widthOut ) {
-                    const uint8_t * imageInX = imageInY;
-                    const uint8_t * transformInX = transformInY;
-                    uint8_t * imageOutX = imageOutY;
-                    const uint8_t * imageInXEnd = imageInX + width;
-
-                    for ( ; imageInX != imageInXEnd; ++imageInX, ++transformInX, ++imageOutX ) {
-                        if ( *transformInX > 0 ) { // apply a transformation
-                            if ( *transformInX != 1 ) { // skip pixel
-                                *imageOutX = *( transformTable + ( *transformInX ) * 256 + *imageOutX );
-                            }
-                        }
-                        else { // copy a pixel
-                            *imageOutX = *imageInX;
-                        }
-                    }
+                    blitRow( imageInY, transformInY, imageOutY, width );
                 }
             }
             else {
                 uint8_t * transformOutY = out.transform() + offsetOutY;
 
                 for ( ; imageInY != imageInYEnd; imageInY += widthIn, transformInY += widthIn, imageOutY += widthOut, transformOutY += widthOut ) {
-                    const uint8_t * imageInX = imageInY;
-                    const uint8_t * transformInX = transformInY;
-                    uint8_t * imageOutX = imageOutY;
-                    uint8_t * transformOutX = transformOutY;
-                    const uint8_t * imageInXEnd = imageInX + width;
-
-                    for ( ; imageInX != imageInXEnd; ++imageInX, ++transformInX, ++imageOutX, ++transformOutX ) {
-                        if ( *transformInX == 1 ) { // skip pixel
-                            continue;
-                        }
-
-                        if ( *transformInX > 0 && *transformOutX == 0 ) { // apply a transformation
-                            *imageOutX = *( transformTable + ( *transformInX ) * 256 + *imageOutX );
-                        }
-                        else { // copy a pixel
-                            *transformOutX = *transformInX;
-                            *imageOutX = *imageInX;
-                        }
-                    }
+                    blitRow( imageInY, transformInY, imageOutY, transformOutY, width );
                 }
             }
         }
@@ -2604,6 +3004,57 @@ namespace fheroes2
         return area;
     }
 
+    Rect GetDifferenceROI( const Image & first, int32_t firstX, int32_t firstY, const Image & second, int32_t secondX, int32_t secondY, int32_t width,
+                           int32_t height )
+    {
+        if ( !Verify( first, firstX, firstY, second, secondX, secondY, width, height ) ) {
+            return {};
+        }
+
+        const int32_t widthFirst = first.width();
+        const int32_t widthSecond = second.width();
+
+        const uint8_t * firstRow = first.image() + firstY * widthFirst + firstX;
+        const uint8_t * secondRow = second.image() + secondY * widthSecond + secondX;
+
+        int32_t minX = width;
+        int32_t maxX = -1;
+        int32_t minY = -1;
+        int32_t maxY = -1;
+
+        for ( int32_t y = 0; y < height; ++y, firstRow += widthFirst, secondRow += widthSecond ) {
+            if ( memcmp( firstRow, secondRow, static_cast<size_t>( width ) ) == 0 ) {
+                continue;
+            }
+
+            if ( minY < 0 ) {
+                minY = y;
+            }
+            maxY = y;
+
+            // Only the parts of the row outside of the already known horizontal range need to be checked.
+            for ( int32_t x = 0; x < minX; ++x ) {
+                if ( firstRow[x] != secondRow[x] ) {
+                    minX = x;
+                    break;
+                }
+            }
+
+            for ( int32_t x = width - 1; x > maxX; --x ) {
+                if ( firstRow[x] != secondRow[x] ) {
+                    maxX = x;
+                    break;
+                }
+            }
+        }
+
+        if ( minY < 0 ) {
+            return {};
+        }
+
+        return { secondX + minX, secondY + minY, maxX - minX + 1, maxY - minY + 1 };
+    }
+
     uint8_t GetColorId( const uint8_t red, const uint8_t green, const uint8_t blue )
     {
         return GetPALColorId( red / 4, green / 4, blue / 4 );
@@ -2652,6 +3103,22 @@ namespace fheroes2
         return out;
     }
 
+    void processRowsInParallel( const int32_t width, const int32_t height, const std::function<void( const int32_t, const int32_t )> & processRows,
+                                const int32_t minPixelsPerJob /* = 32 * 1024 */ )
+    {
+        const int32_t rowsPerJob = std::max( minPixelsPerJob / std::max( width, 1 ), 1 );
+        const int32_t jobCount = ( height + rowsPerJob - 1 ) / rowsPerJob;
+        if ( jobCount <= 1 ) {
+            processRows( 0, height );
+            return;
+        }
+
+        MultiThreading::JobSystem::Get().parallelFor( 0, static_cast<size_t>( jobCount ), [&processRows, rowsPerJob, height]( const size_t jobId ) {
+            const int32_t beginY = static_cast<int32_t>( jobId ) * rowsPerJob;
+            processRows( beginY, std::min( beginY + rowsPerJob, height ) );
+        } );
+    }
+
     void ReplaceColorId( Image & image, const uint8_t oldColorId, const uint8_t newColorId )
     {
         if ( image.empty() ) {
@@ -2736,15 +3203,16 @@ namespace fheroes2
         const uint8_t * imageInY = in.image() + offsetInY;
         uint8_t * imageOutY = out.image() + offsetOutY;
 
-        const uint8_t * imageOutYEnd = imageOutY + static_cast<ptrdiff_t>( widthOut ) * heightRoiOut;
-        int32_t idY = 0;
-
         // Pre-calculation of X position
         std::vector<int32_t> positionX( widthRoiOut );
         for ( int32_t x = 0; x < widthRoiOut; ++x ) {
             positionX[x] = ( x * widthRoiIn ) / widthRoiOut;
         }
 
+        const bool isDoubleWidth = ( widthRoiOut == 2 * widthRoiIn );
+
+        const auto getOffsetIn = [widthIn, heightRoiIn, heightRoiOut]( const int32_t y ) { return ( ( y * heightRoiIn ) / heightRoiOut ) * widthIn; };
+
         if ( in.singleLayer() ) {
             if ( !out.singleLayer() ) {
                 // In this case we make the output image fully non-transparent in the given output area.
@@ -2757,64 +3225,71 @@ namespace fheroes2
                 }
             }
 
-            for ( ; imageOutY != imageOutYEnd; imageOutY += widthOut, ++idY ) {
-                uint8_t * imageOutX = imageOutY;
+            processRowsInParallel( widthRoiOut, heightRoiOut, [&]( const int32_t beginY, const int32_t endY ) {
+                for ( int32_t y = beginY; y < endY; ++y ) {
+                    uint8_t * imageOutX = imageOutY + static_cast<ptrdiff_t>( y ) * widthOut;
 
-                const int32_t offset = ( ( idY * heightRoiIn ) / heightRoiOut ) * widthIn;
-                const uint8_t * imageInX = imageInY + offset;
+                    const int32_t offset = getOffsetIn( y );
+                    if ( y > beginY && offset == getOffsetIn( y - 1 ) ) {
+                        // This row is the same as the previous one.
+                        memcpy( imageOutX, imageOutX - widthOut, static_cast<size_t>( widthRoiOut ) );
+                        continue;
+                    }
 
-                for ( const int32_t posX : positionX ) {
-                    *imageOutX = *( imageInX + posX );
-                    ++imageOutX;
+                    resizeRow( imageInY + offset, imageOutX, positionX, isDoubleWidth );
                 }
-            }
+            } );
         }
         else if ( out.singleLayer() ) {
             const uint8_t * transformInY = in.transform() + offsetInY;
 
-            for ( ; imageOutY != imageOutYEnd; imageOutY += widthOut, ++idY ) {
-                uint8_t * imageOutX = imageOutY;
+            processRowsInParallel( widthRoiOut, heightRoiOut, [&]( const int32_t beginY, const int32_t endY ) {
+                for ( int32_t y = beginY; y < endY; ++y ) {
+                    uint8_t * imageOutX = imageOutY + static_cast<ptrdiff_t>( y ) * widthOut;
 
-                const int32_t offset = ( ( idY * heightRoiIn ) / heightRoiOut ) * widthIn;
-                const uint8_t * imageInX = imageInY + offset;
-                const uint8_t * transformInX = transformInY + offset;
+                    const int32_t offset = getOffsetIn( y );
+                    const uint8_t * imageInX = imageInY + offset;
+                    const uint8_t * transformInX = transformInY + offset;
 
-                for ( const int32_t posX : positionX ) {
-                    const uint8_t * transformIn = transformInX + posX;
-                    if ( *transformIn > 0 ) {
-                        if ( *transformIn != 1 ) {
-                            // Apply a transformation.
-                            *imageOutX = *( transformTable + static_cast<ptrdiff_t>( *transformIn ) * 256 + *imageOutX );
+                    for ( const int32_t posX : positionX ) {
+                        const uint8_t * transformIn = transformInX + posX;
+                        if ( *transformIn > 0 ) {
+                            if ( *transformIn != 1 ) {
+                                // Apply a transformation.
+                                *imageOutX = *( transformTable + static_cast<ptrdiff_t>( *transformIn ) * 256 + *imageOutX );
+                            }
+                        }
+                        else {
+                            *imageOutX = *( imageInX + posX );
                         }
-                    }
-                    else {
-                        *imageOutX = *( imageInX + posX );
-                    }
 
-                    ++imageOutX;
+                        ++imageOutX;
+                    }
                 }
-            }
+            } );
         }
         else {
             // Both 'in' and 'out' are double-layer.
             const uint8_t * transformInY = in.transform() + offsetInY;
             uint8_t * transformOutY = out.transform() + offsetOutY;
 
-            for ( ; imageOutY != imageOutYEnd; imageOutY += widthOut, transformOutY += widthOut, ++idY ) {
-                uint8_t * imageOutX = imageOutY;
-                uint8_t * transformOutX = transformOutY;
+            processRowsInParallel( widthRoiOut, heightRoiOut, [&]( const int32_t beginY, const int32_t endY ) {
+                for ( int32_t y = beginY; y < endY; ++y ) {
+                    uint8_t * imageOutX = imageOutY + static_cast<ptrdiff_t>( y ) * widthOut;
+                    uint8_t * transformOutX = transformOutY + static_cast<ptrdiff_t>( y ) * widthOut;
 
-                const int32_t offset = ( ( idY * heightRoiIn ) / heightRoiOut ) * widthIn;
-                const uint8_t * imageInX = imageInY + offset;
-                const uint8_t * transformInX = transformInY + offset;
+                    const int32_t offset = getOffsetIn( y );
+                    if ( y > beginY && offset == getOffsetIn( y - 1 ) ) {
+                        // This row is the same as the previous one.
+                        memcpy( imageOutX, imageOutX - widthOut, static_cast<size_t>( widthRoiOut ) );
+                        memcpy( transformOutX, transformOutX - widthOut, static_cast<size_t>( widthRoiOut ) );
+                        continue;
+                    }
 
-                for ( const int32_t posX : positionX ) {
-                    *imageOutX = *( imageInX + posX );
-                    *transformOutX = *( transformInX + posX );
-                    ++imageOutX;
-                    ++transformOutX;
+                    resizeRow( imageInY + offset, imageOutX, positionX, isDoubleWidth );
+                    resizeRow( transformInY + offset, transformOutX, positionX, isDoubleWidth );
                 }
-            }
+            } );
         }
     }
 
@@ -2960,13 +3435,28 @@ namespace fheroes2
         const uint8_t * imageInY = in.image() + offsetInY;
         uint8_t * imageOutY = out.image() + offsetOutY;
 
-        std::vector<double> positionX( widthRoiOut );
+        // Pre-calculation of input positions and interpolation weights for every column.
+        struct ColumnInfo
+        {
+            int32_t startX{ 0 };
+            double coeffX{ 0 };
+            bool isInterpolated{ false };
+        };
+
+        std::vector<ColumnInfo> columns( widthRoiOut );
         for ( int32_t x = 0; x < widthRoiOut; ++x ) {
-            positionX[x] = static_cast<double>( x * widthRoiIn ) / widthRoiOut;
+            const double posX = static_cast<double>( x * widthRoiIn ) / widthRoiOut;
+
+            columns[x].startX = static_cast<int32_t>( posX );
+            columns[x].coeffX = posX - columns[x].startX;
+            columns[x].isInterpolated = posX < widthRoiIn - 1;
         }
 
         const uint8_t * gamePalette = getGamePalette();
 
+        // The color lookup table is lazily initialized, this must not be done by multiple threads.
+        GetPALColorId( 0, 0, 0 );
+
         if ( in.singleLayer() ) {
             if ( !out.singleLayer() ) {
                 // In this case we make the output image fully non-transparent in the given output area.
@@ -2979,69 +3469,23 @@ namespace fheroes2
                 }
             }
 
-            for ( int32_t y = 0; y < heightRoiOut; ++y, imageOutY += widthOut ) {
-                const double posY = static_cast<double>( y * heightRoiIn ) / heightRoiOut;
-                const int32_t startY = static_cast<int32_t>( posY ) * widthIn;
-                const double coeffY = posY - static_cast<int32_t>( posY );
-
-                uint8_t * imageOutX = imageOutY;
+            processRowsInParallel( widthRoiOut, heightRoiOut, [&]( const int32_t beginY, const int32_t endY ) {
+                for ( int32_t y = beginY; y < endY; ++y ) {
+                    const double posY = static_cast<double>( y * heightRoiIn ) / heightRoiOut;
+                    const int32_t startY = static_cast<int32_t>( posY ) * widthIn;
+                    const double coeffY = posY - static_cast<int32_t>( posY );
 
-                for ( int32_t x = 0; x < widthRoiOut; ++x, ++imageOutX ) {
-                    const double posX = positionX[x];
-                    const int32_t startX = static_cast<int32_t>( posX );
-                    const int32_t offsetIn = startY + startX;
+                    uint8_t * imageOutX = imageOutY + static_cast<ptrdiff_t>( y ) * widthOut;
 
-                    const uint8_t * imageInX = imageInY + offsetIn;
+                    for ( int32_t x = 0; x < widthRoiOut; ++x, ++imageOutX ) {
+                        const ColumnInfo & column = columns[x];
+                        const int32_t startX = column.startX;
+                        const int32_t offsetIn = startY + startX;
 
-                    if ( posX < widthRoiIn - 1 && posY < heightRoiIn - 1 ) {
-                        const double coeffX = posX - startX;
-                        const double coeff1 = ( 1 - coeffX ) * ( 1 - coeffY );
-                        const double coeff2 = coeffX * ( 1 - coeffY );
-                        const double coeff3 = ( 1 - coeffX ) * coeffY;
-                        const double coeff4 = coeffX * coeffY;
+                        const uint8_t * imageInX = imageInY + offsetIn;
 
-                        const uint8_t * id1 = gamePalette + static_cast<size_t>( *imageInX ) * 3;
-                        const uint8_t * id2 = gamePalette + static_cast<size_t>( *( imageInX + 1 ) ) * 3;
-                        const uint8_t * id3 = gamePalette + static_cast<size_t>( *( imageInX + widthIn ) ) * 3;
-                        const uint8_t * id4 = gamePalette + static_cast<size_t>( *( imageInX + widthIn + 1 ) ) * 3;
-
-                        const double red = *id1 * coeff1 + *id2 * coeff2 + *id3 * coeff3 + *id4 * coeff4 + 0.5;
-                        const double green = *( id1 + 1 ) * coeff1 + *( id2 + 1 ) * coeff2 + *( id3 + 1 ) * coeff3 + *( id4 + 1 ) * coeff4 + 0.5;
-                        const double blue = *( id1 + 2 ) * coeff1 + *( id2 + 2 ) * coeff2 + *( id3 + 2 ) * coeff3 + *( id4 + 2 ) * coeff4 + 0.5;
-
-                        *imageOutX = GetPALColorId( static_cast<uint8_t>( red ), static_cast<uint8_t>( green ), static_cast<uint8_t>( blue ) );
-                    }
-                    else {
-                        *imageOutX = *imageInX;
-                    }
-                }
-            }
-        }
-        else {
-            const uint8_t * transformInY = in.transform() + offsetInY;
-            const bool isOutNotSingleLayer = !out.singleLayer();
-            uint8_t * transformOutY = isOutNotSingleLayer ? ( out.transform() + offsetOutY ) : nullptr;
-
-            for ( int32_t y = 0; y < heightRoiOut; ++y, imageOutY += widthOut ) {
-                const double posY = static_cast<double>( y * heightRoiIn ) / heightRoiOut;
-                const int32_t startY = static_cast<int32_t>( posY ) * widthIn;
-                const double coeffY = posY - static_cast<int32_t>( posY );
-
-                uint8_t * imageOutX = imageOutY;
-                uint8_t * transformOutX = transformOutY;
-
-                for ( int32_t x = 0; x < widthRoiOut; ++x, ++imageOutX ) {
-                    const double posX = positionX[x];
-                    const int32_t startX = static_cast<int32_t>( posX );
-                    const int32_t offsetIn = startY + startX;
-
-                    const uint8_t * imageInX = imageInY + offsetIn;
-                    const uint8_t * transformInX = transformInY + offsetIn;
-
-                    if ( posX < widthRoiIn - 1 && posY < heightRoiIn - 1 && *transformInX == 0
-                         && ( *( transformInX + 1 ) == 0 || *( transformInX + widthRoiIn ) == 0 ) ) {
-                        if ( *( transformInX + 1 ) == 0 && *( transformInX + widthRoiIn ) == 0 && *( transformInX + widthRoiIn + 1 ) == 0 ) {
-                            const double coeffX = posX - startX;
+                        if ( column.isInterpolated && posY < heightRoiIn - 1 ) {
+                            const double coeffX = column.coeffX;
                             const double coeff1 = ( 1 - coeffX ) * ( 1 - coeffY );
                             const double coeff2 = coeffX * ( 1 - coeffY );
                             const double coeff3 = ( 1 - coeffX ) * coeffY;
@@ -3058,76 +3502,122 @@ namespace fheroes2
 
                             *imageOutX = GetPALColorId( static_cast<uint8_t>( red ), static_cast<uint8_t>( green ), static_cast<uint8_t>( blue ) );
                         }
-                        else if ( *( transformInX + 1 ) != 0 && *( transformInX + widthRoiIn ) == 0 ) {
-                            // The pixel to the right is transparent, do only vertical interpolation.
-                            const double coeff1 = 1 - coeffY;
-
-                            const uint8_t * id1 = gamePalette + static_cast<size_t>( *imageInX ) * 3;
-                            const uint8_t * id3 = gamePalette + static_cast<size_t>( *( imageInX + widthIn ) ) * 3;
-
-                            const double red = *id1 * coeff1 + *id3 * coeffY + 0.5;
-                            const double green = *( id1 + 1 ) * coeff1 + *( id3 + 1 ) * coeffY + 0.5;
-                            const double blue = *( id1 + 2 ) * coeff1 + *( id3 + 2 ) * coeffY + 0.5;
-
-                            *imageOutX = GetPALColorId( static_cast<uint8_t>( red ), static_cast<uint8_t>( green ), static_cast<uint8_t>( blue ) );
+                        else {
+                            *imageOutX = *imageInX;
                         }
-                        else if ( *( transformInX + 1 ) == 0 && *( transformInX + widthRoiIn ) != 0 ) {
-                            // The pixel to the bottom is transparent, do only horizontal interpolation.
-                            const double coeff2 = posX - startX;
-                            const double coeff1 = 1 - coeff2;
+                    }
+                }
+            } );
+        }
+        else {
+            const uint8_t * transformInY = in.transform() + offsetInY;
+            const bool isOutNotSingleLayer = !out.singleLayer();
+            uint8_t * transformOutY = isOutNotSingleLayer ? ( out.transform() + offsetOutY ) : nullptr;
 
-                            const uint8_t * id1 = gamePalette + static_cast<size_t>( *imageInX ) * 3;
-                            const uint8_t * id2 = gamePalette + static_cast<size_t>( *( imageInX + 1 ) ) * 3;
+            processRowsInParallel( widthRoiOut, heightRoiOut, [&]( const int32_t beginY, const int32_t endY ) {
+                for ( int32_t y = beginY; y < endY; ++y ) {
+                    const double posY = static_cast<double>( y * heightRoiIn ) / heightRoiOut;
+                    const int32_t startY = static_cast<int32_t>( posY ) * widthIn;
+                    const double coeffY = posY - static_cast<int32_t>( posY );
+
+                    uint8_t * imageOutX = imageOutY + static_cast<ptrdiff_t>( y ) * widthOut;
+                    uint8_t * transformOutX = isOutNotSingleLayer ? ( transformOutY + static_cast<ptrdiff_t>( y ) * widthOut ) : nullptr;
+
+                    for ( int32_t x = 0; x < widthRoiOut; ++x, ++imageOutX ) {
+                        const ColumnInfo & column = columns[x];
+                        const int32_t startX = column.startX;
+                        const int32_t offsetIn = startY + startX;
+
+                        const uint8_t * imageInX = imageInY + offsetIn;
+                        const uint8_t * transformInX = transformInY + offsetIn;
+
+                        if ( column.isInterpolated && posY < heightRoiIn - 1 && *transformInX == 0
+                             && ( *( transformInX + 1 ) == 0 || *( transformInX + widthRoiIn ) == 0 ) ) {
+                            if ( *( transformInX + 1 ) == 0 && *( transformInX + widthRoiIn ) == 0 && *( transformInX + widthRoiIn + 1 ) == 0 ) {
+                                const double coeffX = column.coeffX;
+                                const double coeff1 = ( 1 - coeffX ) * ( 1 - coeffY );
+                                const double coeff2 = coeffX * ( 1 - coeffY );
+                                const double coeff3 = ( 1 - coeffX ) * coeffY;
+                                const double coeff4 = coeffX * coeffY;
+
+                                const uint8_t * id1 = gamePalette + static_cast<size_t>( *imageInX ) * 3;
+                                const uint8_t * id2 = gamePalette + static_cast<size_t>( *( imageInX + 1 ) ) * 3;
+                                const uint8_t * id3 = gamePalette + static_cast<size_t>( *( imageInX + widthIn ) ) * 3;
+                                const uint8_t * id4 = gamePalette + static_cast<size_t>( *( imageInX + widthIn + 1 ) ) * 3;
+
+                                const double red = *id1 * coeff1 + *id2 * coeff2 + *id3 * coeff3 + *id4 * coeff4 + 0.5;
+                                const double green = *( id1 + 1 ) * coeff1 + *( id2 + 1 ) * coeff2 + *( id3 + 1 ) * coeff3 + *( id4 + 1 ) * coeff4 + 0.5;
+                                const double blue = *( id1 + 2 ) * coeff1 + *( id2 + 2 ) * coeff2 + *( id3 + 2 ) * coeff3 + *( id4 + 2 ) * coeff4 + 0.5;
+
+                                *imageOutX = GetPALColorId( static_cast<uint8_t>( red ), static_cast<uint8_t>( green ), static_cast<uint8_t>( blue ) );
+                            }
+                            else if ( *( transformInX + 1 ) != 0 && *( transformInX + widthRoiIn ) == 0 ) {
+                                // The pixel to the right is transparent, do only vertical interpolation.
+                                const double coeff1 = 1 - coeffY;
 
-                            const double red = *id1 * coeff1 + *id2 * coeff2 + 0.5;
-                            const double green = *( id1 + 1 ) * coeff1 + *( id2 + 1 ) * coeff2 + 0.5;
-                            const double blue = *( id1 + 2 ) * coeff1 + *( id2 + 2 ) * coeff2 + 0.5;
+                                const uint8_t * id1 = gamePalette + static_cast<size_t>( *imageInX ) * 3;
+                                const uint8_t * id3 = gamePalette + static_cast<size_t>( *( imageInX + widthIn ) ) * 3;
 
-                            *imageOutX = GetPALColorId( static_cast<uint8_t>( red ), static_cast<uint8_t>( green ), static_cast<uint8_t>( blue ) );
-                        }
-                        else if ( *( transformInX + 1 ) == 0 && *( transformInX + widthRoiIn ) == 0 && *( transformInX + widthRoiIn + 1 ) != 0 ) {
-                            // Interpolation by three pixels: current, the right one and the bottom one.
-                            const double coeffX = posX - startX;
-                            double coeff1 = ( 1 - coeffX ) * ( 1 - coeffY );
-                            double coeff2 = coeffX * ( 1 - coeffY );
-                            double coeff3 = ( 1 - coeffX ) * coeffY;
-                            const double coeffSumm = coeff1 + coeff2 + coeff3;
-                            coeff1 /= coeffSumm;
-                            coeff2 /= coeffSumm;
-                            coeff3 /= coeffSumm;
+                                const double red = *id1 * coeff1 + *id3 * coeffY + 0.5;
+                                const double green = *( id1 + 1 ) * coeff1 + *( id3 + 1 ) * coeffY + 0.5;
+                                const double blue = *( id1 + 2 ) * coeff1 + *( id3 + 2 ) * coeffY + 0.5;
 
-                            const uint8_t * id1 = gamePalette + static_cast<size_t>( *imageInX ) * 3;
-                            const uint8_t * id2 = gamePalette + static_cast<size_t>( *( imageInX + 1 ) ) * 3;
-                            const uint8_t * id3 = gamePalette + static_cast<size_t>( *( imageInX + widthIn ) ) * 3;
+                                *imageOutX = GetPALColorId( static_cast<uint8_t>( red ), static_cast<uint8_t>( green ), static_cast<uint8_t>( blue ) );
+                            }
+                            else if ( *( transformInX + 1 ) == 0 && *( transformInX + widthRoiIn ) != 0 ) {
+                                // The pixel to the bottom is transparent, do only horizontal interpolation.
+                                const double coeff2 = column.coeffX;
+                                const double coeff1 = 1 - coeff2;
 
-                            const double red = *id1 * coeff1 + *id2 * coeff2 + *id3 * coeff3 + 0.5;
-                            const double green = *( id1 + 1 ) * coeff1 + *( id2 + 1 ) * coeff2 + *( id3 + 1 ) * coeff3 + 0.5;
-                            const double blue = *( id1 + 2 ) * coeff1 + *( id2 + 2 ) * coeff2 + *( id3 + 2 ) * coeff3 + 0.5;
+                                const uint8_t * id1 = gamePalette + static_cast<size_t>( *imageInX ) * 3;
+                                const uint8_t * id2 = gamePalette + static_cast<size_t>( *( imageInX + 1 ) ) * 3;
 
-                            *imageOutX = GetPALColorId( static_cast<uint8_t>( red ), static_cast<uint8_t>( green ), static_cast<uint8_t>( blue ) );
-                        }
-                    }
-                    else {
-                        if ( isOutNotSingleLayer || *transformInX == 0 ) {
-                            // Output image is double-layer or single-layer with non-transparent current pixel.
-                            *imageOutX = *imageInX;
+                                const double red = *id1 * coeff1 + *id2 * coeff2 + 0.5;
+                                const double green = *( id1 + 1 ) * coeff1 + *( id2 + 1 ) * coeff2 + 0.5;
+                                const double blue = *( id1 + 2 ) * coeff1 + *( id2 + 2 ) * coeff2 + 0.5;
+
+                                *imageOutX = GetPALColorId( static_cast<uint8_t>( red ), static_cast<uint8_t>( green ), static_cast<uint8_t>( blue ) );
+                            }
+                            else if ( *( transformInX + 1 ) == 0 && *( transformInX + widthRoiIn ) == 0 && *( transformInX + widthRoiIn + 1 ) != 0 ) {
+                                // Interpolation by three pixels: current, the right one and the bottom one.
+                                const double coeffX = column.coeffX;
+                                double coeff1 = ( 1 - coeffX ) * ( 1 - coeffY );
+                                double coeff2 = coeffX * ( 1 - coeffY );
+                                double coeff3 = ( 1 - coeffX ) * coeffY;
+                                const double coeffSumm = coeff1 + coeff2 + coeff3;
+                                coeff1 /= coeffSumm;
+                                coeff2 /= coeffSumm;
+                                coeff3 /= coeffSumm;
+
+                                const uint8_t * id1 = gamePalette + static_cast<size_t>( *imageInX ) * 3;
+                                const uint8_t * id2 = gamePalette + static_cast<size_t>( *( imageInX + 1 ) ) * 3;
+                                const uint8_t * id3 = gamePalette + static_cast<size_t>( *( imageInX + widthIn ) ) * 3;
+
+                                const double red = *id1 * coeff1 + *id2 * coeff2 + *id3 * coeff3 + 0.5;
+                                const double green = *( id1 + 1 ) * coeff1 + *( id2 + 1 ) * coeff2 + *( id3 + 1 ) * coeff3 + 0.5;
+                                const double blue = *( id1 + 2 ) * coeff1 + *( id2 + 2 ) * coeff2 + *( id3 + 2 ) * coeff3 + 0.5;
+
+                                *imageOutX = GetPALColorId( static_cast<uint8_t>( red ), static_cast<uint8_t>( green ), static_cast<uint8_t>( blue ) );
+                            }
                         }
-                        else if ( *transformInX != 1 ) {
-                            // Apply a transformation.
-                            *imageOutX = *( transformTable + static_cast<ptrdiff_t>( *transformInX ) * 256 + *imageOutX );
+                        else {
+                            if ( isOutNotSingleLayer || *transformInX == 0 ) {
+                                // Output image is double-layer or single-layer with non-transparent current pixel.
+                                *imageOutX = *imageInX;
+                            }
+                            else if ( *transformInX != 1 ) {
+                                // Apply a transformation.
+                                *imageOutX = *( transformTable + static_cast<ptrdiff_t>( *transformInX ) * 256 + *imageOutX );
+                            }
                         }
-                    }
 
-                    if ( isOutNotSingleLayer ) {
-                        *transformOutX = *transformInX;
-                        ++transformOutX;
+                        if ( isOutNotSingleLayer ) {
+                            *transformOutX = *transformInX;
+                            ++transformOutX;
+                        }
                     }
                 }
-
-                if ( isOutNotSingleLayer ) {
-                    transformOutY += widthOut;
-                }
-            }
+            } );
         }
     }
 
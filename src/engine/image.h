@@ -21,7 +21,9 @@
 #pragma once
 
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -77,7 +79,13 @@ namespace fheroes2
             // Why do you want to get transform layer from the single-layer image?
             assert( !_singleLayer );
 
-            return _singleLayer ? nullptr : _data.get() + width() * height();
+            if ( _singleLayer ) {
+                return nullptr;
+            }
+
+            _detach();
+
+            return _data.get() + width() * height();
         }
 
         const uint8_t * transform() const
@@ -114,12 +122,32 @@ namespace fheroes2
             _singleLayer = true;
         }
 
+        // Returns true if the pixels of this image are shared with other images. Used for diagnostics only.
+        bool isShared() const
+        {
+            return _data && _data.use_count() > 1;
+        }
+
     private:
         void copy( const Image & image );
 
+        // Makes sure that the pixels are not shared with other images before they are modified.
+        void _detach()
+        {
+            if ( isShared() ) {
+                _makeUnique();
+            }
+        }
+
+        void _makeUnique();
+
         int32_t _width{ 0 };
         int32_t _height{ 0 };
-        std::unique_ptr<uint8_t[]> _data; // holds 2 image layers
+
+        // Holds 2 image layers. Copies of an image share the same pixels until one of them requests non-const access to them
+        // (image(), transform() and the methods modifying the image), so passing sprites by value and caching them is cheap.
+        // IMPORTANT: a pointer returned by a non-const accessor must not be used to modify the image after the image was copied.
+        std::shared_ptr<uint8_t[]> _data;
 
         // Only for images which are not used for any other operations except displaying on screen.
         bool _singleLayer{ false };
@@ -191,12 +219,7 @@ namespace fheroes2
         ImageRestorer & operator=( const ImageRestorer & ) = delete;
 
         // Restores the original image if necessary, see the implementation for details
-        ~ImageRestorer()
-        {
-            if ( !_isRestored ) {
-                restore();
-            }
-        }
+        ~ImageRestorer();
 
         void update( const int32_t x_, const int32_t y_, const int32_t width, const int32_t height );
 
@@ -234,7 +257,11 @@ namespace fheroes2
 
     private:
         Image & _image;
-        Image _copy;
+
+        // Saved pixels of the area: the image layer followed by the transform layer if the image has it. The buffer is taken from a pool
+        // and might be bigger than the area.
+        std::unique_ptr<uint8_t[]> _buffer;
+        size_t _bufferCapacity{ 0 };
 
         int32_t _x{ 0 };
         int32_t _y{ 0 };
@@ -243,6 +270,9 @@ namespace fheroes2
 
         void _updateRoi();
 
+        // Saves the current area of the image.
+        void _save();
+
         bool _isRestored{ false };
     };
 
@@ -329,11 +359,21 @@ namespace fheroes2
     // Return ROI with pixels which are not skipped and not used for shadow creation. 1 is to skip, 2 - 5 types of shadows
     Rect GetActiveROI( const Image & image, const uint8_t minTransformValue = 6 );
 
+    // Return ROI (in the second image coordinates) covering all image layer pixels which differ between both images in the given area.
+    // An empty ROI is returned if the areas are identical.
+    Rect GetDifferenceROI( const Image & first, int32_t firstX, int32_t firstY, const Image & second, int32_t secondX, int32_t secondY, int32_t width,
+                           int32_t height );
+
     // Returns a closest color ID from the original game's palette
     uint8_t GetColorId( const uint8_t red, const uint8_t green, const uint8_t blue );
 
     Sprite makeShadow( const Sprite & in, const Point & shadowOffset, const uint8_t transformId );
 
+    // Calls 'processRows( beginY, endY )' for consecutive ranges of rows covering [0, height). The ranges of big images are processed in parallel.
+    // Every range has at least 'minPixelsPerJob' pixels since scheduling a job which processes fewer pixels costs more than the processing itself.
+    void processRowsInParallel( const int32_t width, const int32_t height, const std::function<void( const int32_t, const int32_t )> & processRows,
+                                const int32_t minPixelsPerJob = 32 * 1024 );
+
     // This function does NOT check transform layer. If you intent to replace few colors at the same image please use ApplyPalette to be more efficient.
     void ReplaceColorId( Image & image, const uint8_t oldColorId, const uint8_t newColorId );
 
@@ -0,0 +1,182 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2025                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "image_compact.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include "image.h"
+
+namespace
+{
+    // Every run starts with a 2-byte header: the transform layer value and the length of the run minus 1.
+    // The image layer data follows the header for runs of non-transparent pixels. For runs of other transform values
+    // the data follows only if the image layer is not zero, this is marked by the highest bit of the transform value.
+    const uint8_t withImageDataFlag{ 0x80 };
+    const int32_t maxRunLength{ 256 };
+}
+
+namespace fheroes2
+{
+    CompactSprite::CompactSprite( const Sprite & sprite )
+        : _width( sprite.width() )
+        , _height( sprite.height() )
+        , _x( sprite.x() )
+        , _y( sprite.y() )
+        , _isSingleLayer( sprite.singleLayer() )
+    {
+        if ( sprite.empty() ) {
+            return;
+        }
+
+        const size_t pixelCount = static_cast<size_t>( _width ) * static_cast<size_t>( _height );
+
+        const auto storeRaw = [this, &sprite, pixelCount]() {
+            _isRaw = true;
+
+            _data.resize( _isSingleLayer ? pixelCount : pixelCount * 2 );
+            memcpy( _data.data(), sprite.image(), pixelCount );
+
+            if ( !_isSingleLayer ) {
+                memcpy( _data.data() + pixelCount, sprite.transform(), pixelCount );
+            }
+        };
+
+        if ( _isSingleLayer ) {
+            storeRaw();
+            return;
+        }
+
+        const uint8_t * image = sprite.image();
+        const uint8_t * transform = sprite.transform();
+
+        for ( int32_t y = 0; y < _height; ++y ) {
+            int32_t x = 0;
+
+            while ( x < _width ) {
+                const uint8_t transformValue = transform[x];
+                if ( transformValue & withImageDataFlag ) {
+                    // Such transform values are never used.
+                    assert( 0 );
+
+                    _data.clear();
+                    storeRaw();
+                    return;
+                }
+
+                int32_t runEnd = x + 1;
+                const int32_t maxRunEnd = std::min( x + maxRunLength, _width );
+                while ( runEnd < maxRunEnd && transform[runEnd] == transformValue ) {
+                    ++runEnd;
+                }
+
+                const size_t runLength = static_cast<size_t>( runEnd - x );
+                const bool hasImageData = ( transformValue == 0 ) || std::any_of( image + x, image + runEnd, []( const uint8_t value ) { return value != 0; } );
+
+                _data.push_back( hasImageData ? static_cast<uint8_t>( transformValue | withImageDataFlag ) : transformValue );
+                _data.push_back( static_cast<uint8_t>( runLength - 1 ) );
+
+                if ( hasImageData ) {
+                    _data.insert( _data.end(), image + x, image + runEnd );
+                }
+
+                x = runEnd;
+            }
+
+            image += _width;
+            transform += _width;
+        }
+
+        // Sprites with many short runs take less memory as is.
+        if ( _data.size() >= pixelCount * 2 ) {
+            _data.clear();
+            storeRaw();
+            return;
+        }
+
+        _data.shrink_to_fit();
+    }
+
+    Sprite CompactSprite::decompress() const
+    {
+        Sprite sprite;
+        if ( _isSingleLayer ) {
+            sprite._disableTransformLayer();
+        }
+
+        sprite.resize( _width, _height );
+        sprite.setPosition( _x, _y );
+
+        if ( sprite.empty() ) {
+            return sprite;
+        }
+
+        const size_t pixelCount = static_cast<size_t>( _width ) * static_cast<size_t>( _height );
+
+        if ( _isRaw ) {
+            memcpy( sprite.image(), _data.data(), pixelCount );
+
+            if ( !_isSingleLayer ) {
+                memcpy( sprite.transform(), _data.data() + pixelCount, pixelCount );
+            }
+
+            return sprite;
+        }
+
+        uint8_t * image = sprite.image();
+        uint8_t * transform = sprite.transform();
+        const uint8_t * imageEnd = image + pixelCount;
+
+        const uint8_t * data = _data.data();
+        const uint8_t * dataEnd = data + _data.size();
+
+        while ( data != dataEnd ) {
+            assert( dataEnd - data >= 2 );
+
+            const uint8_t transformValue = static_cast<uint8_t>( data[0] & ~withImageDataFlag );
+            const bool hasImageData = ( data[0] & withImageDataFlag ) != 0;
+            const size_t runLength = static_cast<size_t>( data[1] ) + 1;
+            data += 2;
+
+            assert( static_cast<size_t>( imageEnd - image ) >= runLength );
+
+            if ( hasImageData ) {
+                assert( static_cast<size_t>( dataEnd - data ) >= runLength );
+
+                memcpy( image, data, runLength );
+                data += runLength;
+            }
+            else {
+                memset( image, 0, runLength );
+            }
+
+            memset( transform, transformValue, runLength );
+
+            image += runLength;
+            transform += runLength;
+        }
+
+        assert( image == imageEnd );
+
+        return sprite;
+    }
+}
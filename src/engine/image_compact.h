@@ -0,0 +1,59 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2025                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fheroes2
+{
+    class Sprite;
+
+    // A sprite stored as runs of pixels with the same transform layer value. Mostly transparent sprites (like monsters or heroes)
+    // take several times less memory in this form, but the sprite has to be decompressed to access its pixels.
+    class CompactSprite
+    {
+    public:
+        CompactSprite() = default;
+        explicit CompactSprite( const Sprite & sprite );
+
+        Sprite decompress() const;
+
+        // Returns the amount of memory in bytes used by the pixel data of the sprite.
+        size_t getMemorySize() const
+        {
+            return _data.size();
+        }
+
+    private:
+        // Runs of pixels if '_isRaw' is false, otherwise the data of the image and the transform (for double-layer sprites) layers as is.
+        std::vector<uint8_t> _data;
+
+        int32_t _width{ 0 };
+        int32_t _height{ 0 };
+        int32_t _x{ 0 };
+        int32_t _y{ 0 };
+
+        bool _isSingleLayer{ false };
+        bool _isRaw{ false };
+    };
+}
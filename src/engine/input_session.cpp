@@ -0,0 +1,118 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "input_session.h"
+
+#include <cstdint>
+#include <fstream>
+#include <ios>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include "localevent.h"
+#include "logging.h"
+#include "profiler.h"
+
+namespace
+{
+    const char * const sessionFileHeader{ "fheroes2 input session 1" };
+
+    std::ofstream recordingFile;
+}
+
+namespace fheroes2
+{
+    bool startInputRecording( const std::string & filePath )
+    {
+        recordingFile.open( filePath, std::ios_base::trunc );
+        if ( !recordingFile ) {
+            ERROR_LOG( "Failed to open file " << filePath << " to record the input session." )
+            return false;
+        }
+
+        recordingFile << sessionFileHeader << '\n';
+
+        LocalEvent::Get().setGlobalInputEventHook( []( const InputEvent & event ) {
+            recordingFile << event.iteration << ' ' << event.timeMs << ' ' << static_cast<int>( event.type ) << ' ' << event.position.x << ' ' << event.position.y
+                          << ' ' << event.value << ' ' << event.keyModifier << '\n';
+
+            // Mouse motion events are the most frequent ones, so the file is flushed only on other events to not lose the meaningful input if the game crashes.
+            if ( event.type != InputEvent::Type::MOUSE_MOTION ) {
+                recordingFile.flush();
+            }
+        } );
+
+        DEBUG_LOG( DBG_ENGINE, DBG_INFO, "Recording the input session into " << filePath )
+
+        return true;
+    }
+
+    bool startInputReplay( const std::string & filePath, const std::string & profilerCsvFilePath )
+    {
+        std::ifstream file( filePath );
+        if ( !file ) {
+            ERROR_LOG( "Failed to open the input session file " << filePath )
+            return false;
+        }
+
+        std::string line;
+        if ( !std::getline( file, line ) || line != sessionFileHeader ) {
+            ERROR_LOG( "File " << filePath << " is not an input session file." )
+            return false;
+        }
+
+        std::vector<InputEvent> events;
+
+        while ( std::getline( file, line ) ) {
+            if ( line.empty() ) {
+                continue;
+            }
+
+            std::istringstream lineStream( line );
+
+            InputEvent event;
+            int type = 0;
+
+            lineStream >> event.iteration >> event.timeMs >> type >> event.position.x >> event.position.y >> event.value >> event.keyModifier;
+
+            if ( !lineStream || type < static_cast<int>( InputEvent::Type::MOUSE_MOTION ) || type > static_cast<int>( InputEvent::Type::KEY_UP )
+                 || ( !events.empty() && event.iteration < events.back().iteration ) ) {
+                ERROR_LOG( "Invalid input event in file " << filePath << ": " << line )
+                return false;
+            }
+
+            event.type = static_cast<InputEvent::Type>( type );
+
+            events.push_back( event );
+        }
+
+        DEBUG_LOG( DBG_ENGINE, DBG_INFO, "Replaying " << events.size() << " input events from " << filePath )
+
+        LocalEvent::Get().startInputReplay( std::move( events ) );
+
+        // Profiler statistics are not displayed on the screen to not affect the measured rendering time.
+        if ( !profilerCsvFilePath.empty() ) {
+            Profiler::instance().enable( profilerCsvFilePath );
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,34 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <string>
+
+namespace fheroes2
+{
+    // Records all keyboard and mouse input processed by LocalEvent into the given text file, one event per line.
+    bool startInputRecording( const std::string & filePath );
+
+    // Replays the input session recorded by startInputRecording() instead of the real input. The session must start from the same state
+    // of the game (the same configuration and saved games) as it was recorded with. If the profiler CSV file path is not empty then the
+    // profiler is enabled and the time of every rendered frame is written into this file, so rendering of identical sessions can be compared.
+    bool startInputReplay( const std::string & filePath, const std::string & profilerCsvFilePath );
+}
@@ -23,9 +23,12 @@
 
 #include "localevent.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
+#include <initializer_list>
 #include <map>
 #include <ostream>
 #include <set>
@@ -62,6 +65,8 @@
 #include "audio.h"
 #include "image.h"
 #include "logging.h"
+#include "memory_usage.h"
+#include "profiler.h"
 #include "render_processor.h"
 #include "screen.h"
 
@@ -69,6 +74,11 @@ namespace
 {
     const uint32_t globalLoopSleepTime{ 1 };
 
+    // The maximum time to wait for input events when the caller has reported that nothing is going to happen for a while. There might be
+    // things that are checked by the caller on every event processing call but are not covered by the reported time (like the end of
+    // music or sound playback), so the wait time should not be too long.
+    const uint64_t maxIdleWaitTime{ 16 };
+
     // If such or more ms has passed after pressing the mouse button, then this is a long press.
     const uint32_t mouseButtonLongPressTimeout{ 850 };
 
@@ -426,6 +436,12 @@ namespace EventProcessing
             SDL_Delay( milliseconds );
         }
 
+        // Waits until there is an input event in the queue or until the given time passes. The event is not removed from the queue.
+        static void waitForEvent( const uint32_t milliseconds )
+        {
+            SDL_WaitEventTimeout( nullptr, static_cast<int>( milliseconds ) );
+        }
+
         bool handleEvents( LocalEvent & eventHandler, const bool allowExit, bool & updateDisplay )
         {
             updateDisplay = false;
@@ -531,6 +547,7 @@ namespace EventProcessing
                     // We need to deallocate some memory but we need to be careful not to deallocate images that are in use at the moment.
                     // As of now we have no logic for this so we at least log this event.
                     DEBUG_LOG( DBG_ENGINE, DBG_WARN, "OS indicates low memory. Release some resources." )
+                    fheroes2::logMemoryUsage();
                     break;
                 default:
                     // If this assertion blows up then we included an event type but we didn't add logic for it.
@@ -1255,12 +1272,29 @@ bool LocalEvent::HandleEvents( const bool sleepAfterEventProcessing /* = true */
 
     bool isDisplayRefreshRequired = false;
 
-    if ( !_engine->handleEvents( *this, allowExit, isDisplayRefreshRequired ) ) {
-        return false;
-    }
+    ++_eventProcessingIteration;
+
+    {
+        // Rendering and sleeping are not a part of event handling time.
+        const fheroes2::ProfilerScopedTimer eventTimer( fheroes2::ProfilerSection::EVENT_HANDLING );
 
-    if ( _engine->isControllerValid() ) {
-        ProcessControllerAxisMotion();
+        _isMouseCursorMovePending = false;
+
+        if ( !_engine->handleEvents( *this, allowExit, isDisplayRefreshRequired ) ) {
+            return false;
+        }
+
+        if ( isInputReplayInProgress() ) {
+            _replayInputEvents();
+        }
+
+        if ( _isMouseCursorMovePending && _globalMouseMotionEventHook ) {
+            _mouseCursorRenderArea = _globalMouseMotionEventHook( _mouseCursorPos.x, _mouseCursorPos.y );
+        }
+
+        if ( _engine->isControllerValid() ) {
+            ProcessControllerAxisMotion();
+        }
     }
 
     // We can have more than one event which requires rendering. We must render only once and only when sleeping is expected.
@@ -1278,14 +1312,28 @@ bool LocalEvent::HandleEvents( const bool sleepAfterEventProcessing /* = true */
 
     static_assert( globalLoopSleepTime == 1, "Since you have changed the sleep time, make sure that the sleep does not last too long." );
 
+    [[maybe_unused]] const uint64_t idleTimeMs = _idleTimeMs;
+    _idleTimeMs = UINT64_MAX;
+
     if ( sleepAfterEventProcessing ) {
         if ( renderRoi != fheroes2::Rect() ) {
             display.render( renderRoi );
         }
 
 #ifndef __EMSCRIPTEN__
+        // The emulation of the mouse cursor and the detection of long presses require frequent event processing.
+        // Replayed input events do not interrupt the waiting so it is not used during the replay.
+        if ( idleTimeMs != UINT64_MAX && !_engine->isControllerValid() && !( _actionStates & MOUSE_PRESSED ) && !isInputReplayInProgress() ) {
+            // Nothing is going to happen until the nearest of the reported time and the next color cycling update, unless there is an input event.
+            const uint64_t waitTimeMs = std::min( { idleTimeMs, fheroes2::RenderProcessor::instance().getTimeUntilCyclingUpdate(), maxIdleWaitTime } );
+            const uint64_t processingTimeMs = eventProcessingTimer.getMs();
+
+            if ( processingTimeMs < waitTimeMs ) {
+                EventProcessing::EventEngine::waitForEvent( static_cast<uint32_t>( waitTimeMs - processingTimeMs ) );
+            }
+        }
         // Make sure not to delay any further if the processing time within this function was more than the expected waiting time.
-        if ( eventProcessingTimer.getMs() < globalLoopSleepTime ) {
+        else if ( eventProcessingTimer.getMs() < globalLoopSleepTime ) {
             EventProcessing::EventEngine::sleep( globalLoopSleepTime );
         }
 #endif
@@ -1308,6 +1356,94 @@ bool LocalEvent::HandleEvents( const bool sleepAfterEventProcessing /* = true */
     return true;
 }
 
+void LocalEvent::setGlobalInputEventHook( std::function<void( const fheroes2::InputEvent & )> hook )
+{
+    _globalInputEventHook = std::move( hook );
+
+    _eventProcessingIteration = 0;
+    _inputSessionTimer.reset();
+}
+
+void LocalEvent::startInputReplay( std::vector<fheroes2::InputEvent> events )
+{
+    assert( std::is_sorted( events.begin(), events.end(),
+                            []( const fheroes2::InputEvent & left, const fheroes2::InputEvent & right ) { return left.iteration < right.iteration; } ) );
+
+    _inputReplayEvents = std::move( events );
+    _inputReplayEventId = 0;
+
+    _eventProcessingIteration = 0;
+    _inputSessionTimer.reset();
+}
+
+bool LocalEvent::_onInputEvent( const fheroes2::InputEvent::Type type, const fheroes2::Point & position, const int32_t value, const int32_t keyModifier )
+{
+    if ( _isReplayedEventProcessing ) {
+        return true;
+    }
+
+    if ( isInputReplayInProgress() ) {
+        // The real input must not interfere with the session being replayed.
+        return false;
+    }
+
+    if ( _globalInputEventHook ) {
+        fheroes2::InputEvent event;
+        event.iteration = _eventProcessingIteration;
+        event.timeMs = _inputSessionTimer.getMs();
+        event.type = type;
+        event.position = position;
+        event.value = value;
+        event.keyModifier = keyModifier;
+
+        _globalInputEventHook( event );
+    }
+
+    return true;
+}
+
+void LocalEvent::_replayInputEvents()
+{
+    _isReplayedEventProcessing = true;
+
+    while ( _inputReplayEventId < _inputReplayEvents.size() && _inputReplayEvents[_inputReplayEventId].iteration <= _eventProcessingIteration ) {
+        const fheroes2::InputEvent & event = _inputReplayEvents[_inputReplayEventId];
+        ++_inputReplayEventId;
+
+        switch ( event.type ) {
+        case fheroes2::InputEvent::Type::MOUSE_MOTION:
+            onMouseMotionEvent( event.position );
+            break;
+        case fheroes2::InputEvent::Type::MOUSE_BUTTON_DOWN:
+        case fheroes2::InputEvent::Type::MOUSE_BUTTON_UP: {
+            const MouseButtonType buttonType = static_cast<MouseButtonType>( event.value );
+            if ( buttonType != MouseButtonType::MOUSE_BUTTON_LEFT && buttonType != MouseButtonType::MOUSE_BUTTON_MIDDLE
+                 && buttonType != MouseButtonType::MOUSE_BUTTON_RIGHT ) {
+                ERROR_LOG( "Invalid mouse button in the replayed input event: " << event.value )
+                break;
+            }
+
+            onMouseButtonEvent( event.type == fheroes2::InputEvent::Type::MOUSE_BUTTON_DOWN, buttonType, event.position );
+            break;
+        }
+        case fheroes2::InputEvent::Type::MOUSE_WHEEL:
+            onMouseWheelEvent( event.position );
+            break;
+        case fheroes2::InputEvent::Type::KEY_DOWN:
+            onKeyboardEvent( static_cast<fheroes2::Key>( event.value ), event.keyModifier, KeyboardEventState::KEY_DOWN );
+            break;
+        case fheroes2::InputEvent::Type::KEY_UP:
+            onKeyboardEvent( static_cast<fheroes2::Key>( event.value ), event.keyModifier, KeyboardEventState::KEY_UP );
+            break;
+        default:
+            ERROR_LOG( "Invalid type of the replayed input event: " << static_cast<int>( event.type ) )
+            break;
+        }
+    }
+
+    _isReplayedEventProcessing = false;
+}
+
 void LocalEvent::StopSounds()
 {
     Audio::Mute();
@@ -1320,6 +1456,10 @@ void LocalEvent::ResumeSounds()
 
 void LocalEvent::onMouseWheelEvent( fheroes2::Point position )
 {
+    if ( !_onInputEvent( fheroes2::InputEvent::Type::MOUSE_WHEEL, position, 0, fheroes2::KeyModifier::KEY_MODIFIER_NONE ) ) {
+        return;
+    }
+
     setStates( MOUSE_WHEEL );
     _mouseReleaseMiddlePos = _mouseCursorPos;
     _mouseWheelMovementOffset = position;
@@ -1383,9 +1523,7 @@ void LocalEvent::onTouchFingerEvent( const TouchFingerEventType eventType, const
         setStates( MOUSE_MOTION );
         setStates( MOUSE_TOUCH );
 
-        if ( _globalMouseMotionEventHook ) {
-            _mouseCursorRenderArea = _globalMouseMotionEventHook( _mouseCursorPos.x, _mouseCursorPos.y );
-        }
+        _isMouseCursorMovePending = true;
 
         // If there is a two-finger gesture in progress, the first finger is only used to move the cursor.
         // The operation of the left mouse button is not simulated.
@@ -1650,6 +1788,11 @@ void LocalEvent::onRenderDeviceResetEvent()
 
 void LocalEvent::onKeyboardEvent( const fheroes2::Key key, const int32_t keyModifier, const KeyboardEventState keyState )
 {
+    if ( !_onInputEvent( keyState == KeyboardEventState::KEY_DOWN ? fheroes2::InputEvent::Type::KEY_DOWN : fheroes2::InputEvent::Type::KEY_UP, {},
+                         static_cast<int32_t>( key ), keyModifier ) ) {
+        return;
+    }
+
     if ( keyState == KeyboardEventState::KEY_DOWN ) {
         setStates( KEY_PRESSED );
         setStates( KEY_HOLD );
@@ -1668,18 +1811,26 @@ void LocalEvent::onKeyboardEvent( const fheroes2::Key key, const int32_t keyModi
 
 void LocalEvent::onMouseMotionEvent( fheroes2::Point position )
 {
+    if ( !_onInputEvent( fheroes2::InputEvent::Type::MOUSE_MOTION, position, 0, fheroes2::KeyModifier::KEY_MODIFIER_NONE ) ) {
+        return;
+    }
+
     setStates( MOUSE_MOTION );
     _mouseCursorPos = position;
     _emulatedPointerPos.x = _mouseCursorPos.x;
     _emulatedPointerPos.y = _mouseCursorPos.y;
 
-    if ( _globalMouseMotionEventHook ) {
-        _mouseCursorRenderArea = _globalMouseMotionEventHook( position.x, position.y );
-    }
+    // There can be many mouse motion events in the queue, the mouse cursor is moved only once to the latest position after all of them are processed.
+    _isMouseCursorMovePending = true;
 }
 
 void LocalEvent::onMouseButtonEvent( const bool isPressed, const MouseButtonType buttonType, fheroes2::Point position )
 {
+    if ( !_onInputEvent( isPressed ? fheroes2::InputEvent::Type::MOUSE_BUTTON_DOWN : fheroes2::InputEvent::Type::MOUSE_BUTTON_UP, position,
+                         static_cast<int32_t>( buttonType ), fheroes2::KeyModifier::KEY_MODIFIER_NONE ) ) {
+        return;
+    }
+
     if ( isPressed ) {
         _mouseButtonLongPressDelay.reset();
 
@@ -24,6 +24,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
@@ -31,6 +32,7 @@
 #include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "math_base.h"
 #include "timing.h"
@@ -181,6 +183,36 @@ namespace fheroes2
     const char * KeySymGetName( const Key key );
 
     size_t InsertKeySym( std::string & res, size_t pos, const Key key, const int32_t mod );
+
+    // Input event as it is processed by LocalEvent. It is used to record and replay input sessions.
+    struct InputEvent
+    {
+        enum class Type : uint8_t
+        {
+            MOUSE_MOTION,
+            MOUSE_BUTTON_DOWN,
+            MOUSE_BUTTON_UP,
+            MOUSE_WHEEL,
+            KEY_DOWN,
+            KEY_UP
+        };
+
+        // Index of the event processing iteration (the call of LocalEvent::HandleEvents()) during which the event has been processed.
+        uint64_t iteration{ 0 };
+
+        // Time in milliseconds since the start of the recording. It is informational only, the replay relies on iterations.
+        uint64_t timeMs{ 0 };
+
+        Type type{ Type::MOUSE_MOTION };
+
+        // Mouse cursor position or mouse wheel offset.
+        Point position;
+
+        // Mouse button type or key value, depending on the event type.
+        int32_t value{ 0 };
+
+        int32_t keyModifier{ KEY_MODIFIER_NONE };
+    };
 }
 
 class LocalEvent
@@ -214,9 +246,29 @@ public:
         _globalKeyDownEventHook = std::move( hook );
     }
 
+    // The hook is called for every keyboard and mouse event received from the input devices. It is used to record input sessions.
+    void setGlobalInputEventHook( std::function<void( const fheroes2::InputEvent & )> hook );
+
+    // Replays the given events instead of the real keyboard and mouse input: every event is processed during the same event processing
+    // iteration as it has been recorded. The real input is ignored until all the events are replayed.
+    void startInputReplay( std::vector<fheroes2::InputEvent> events );
+
+    bool isInputReplayInProgress() const
+    {
+        return _inputReplayEventId < _inputReplayEvents.size();
+    }
+
     // Return false when event handling should be stopped, true otherwise.
     bool HandleEvents( const bool sleepAfterEventProcessing = true, const bool allowExit = false );
 
+    // Informs the next call of HandleEvents() that nothing is going to happen during the given time unless there is an input event, so
+    // instead of sleeping for a fixed short time it can wait for the input events until this time passes. Can be called multiple times
+    // before calling HandleEvents(), in this case the shortest time is used.
+    void setIdleTimeBeforeNextEvent( const uint64_t idleTimeMs )
+    {
+        _idleTimeMs = std::min( _idleTimeMs, idleTimeMs );
+    }
+
     bool hasMouseMoved() const
     {
         return ( _actionStates & MOUSE_MOTION ) == MOUSE_MOTION;
@@ -486,9 +538,25 @@ private:
 
     std::function<fheroes2::Rect( const int32_t, const int32_t )> _globalMouseMotionEventHook;
     std::function<void( const fheroes2::Key, const int32_t )> _globalKeyDownEventHook;
+    std::function<void( const fheroes2::InputEvent & )> _globalInputEventHook;
+
+    // Events being replayed instead of the real input and the ID of the next event to process.
+    std::vector<fheroes2::InputEvent> _inputReplayEvents;
+    size_t _inputReplayEventId{ 0 };
+    bool _isReplayedEventProcessing{ false };
+
+    // The number of calls of HandleEvents() since the start of the input recording or replay.
+    uint64_t _eventProcessingIteration{ 0 };
+    fheroes2::Time _inputSessionTimer;
 
     fheroes2::Rect _mouseCursorRenderArea;
 
+    // Whether the mouse cursor has to be moved to the latest mouse position after all the queued events are processed.
+    bool _isMouseCursorMovePending{ false };
+
+    // The time reported by setIdleTimeBeforeNextEvent(), it is reset after every event processing.
+    uint64_t _idleTimeMs{ UINT64_MAX };
+
     // used to convert user-friendly pointer speed values into more usable ones
     const double _controllerSpeedModifier{ 2000000.0 };
     double _controllerPointerSpeed{ 10.0 / _controllerSpeedModifier };
@@ -527,6 +595,11 @@ private:
 
     void ProcessControllerAxisMotion();
 
+    // Returns true if the input event has to be processed. Reports the event to the global input event hook if there is any.
+    bool _onInputEvent( const fheroes2::InputEvent::Type type, const fheroes2::Point & position, const int32_t value, const int32_t keyModifier );
+
+    void _replayInputEvents();
+
     void setStates( const uint32_t states )
     {
         _actionStates |= states;
@@ -18,9 +18,22 @@
  *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
  ***************************************************************************/
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
 #include <ctime>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #if defined( _WIN32 )
 #define WIN32_LEAN_AND_MEAN
@@ -33,6 +46,7 @@
 
 #include "logging.h"
 #include "system.h"
+#include "thread.h"
 
 namespace
 {
@@ -69,6 +83,243 @@ namespace
 
     const ConsoleCPSwitcher consoleCPSwitcher;
 #endif
+
+    std::string formatTime( const std::time_t time )
+    {
+        const tm tmi = System::GetTM( time );
+
+        std::array<char, 256> buf;
+
+        const size_t writtenBytes = std::strftime( buf.data(), buf.size(), "%d.%m.%Y %H:%M:%S", &tmi );
+        if ( writtenBytes == 0 ) {
+            assert( 0 );
+            return "<TIMESTAMP ERROR>";
+        }
+
+        return std::string( buf.data() );
+    }
+
+    // A debug log record. The header of the record (time, debug option name and function name) is formatted only when the record is written.
+    struct DebugLogRecord
+    {
+        uint64_t sequenceId{ 0 };
+        std::time_t time{ 0 };
+        int name{ 0 };
+        const char * function{ nullptr };
+        std::string message;
+    };
+
+    // Writes debug log records with a background thread. Every thread producing records has its own lock-free queue, so producers
+    // never wait for each other or for the writer. Records from all the queues are written in the order they were produced.
+    class AsyncLogWriter
+    {
+    public:
+        AsyncLogWriter() = default;
+        AsyncLogWriter( const AsyncLogWriter & ) = delete;
+
+        ~AsyncLogWriter() = default;
+
+        AsyncLogWriter & operator=( const AsyncLogWriter & ) = delete;
+
+        void push( const int name, const char * function, std::string message )
+        {
+            DebugLogRecord record{ _sequenceId.fetch_add( 1, std::memory_order_relaxed ), std::time( nullptr ), name, function, std::move( message ) };
+
+            if ( !_isRunning.load( std::memory_order_acquire ) ) {
+                const std::scoped_lock<std::mutex> lock( _mutex );
+
+                _writeQueuedRecords();
+                _write( record );
+                return;
+            }
+
+            thread_local std::shared_ptr<RecordQueue> threadQueue = _registerQueue();
+
+            if ( !threadQueue->push( std::move( record ) ) ) {
+                // The writer does not keep up with this thread. Write everything right away instead of losing the record.
+                const std::scoped_lock<std::mutex> lock( _mutex );
+
+                _writeQueuedRecords();
+                _write( record );
+            }
+        }
+
+        void flush()
+        {
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
+            _writeQueuedRecords();
+        }
+
+        // Writes all queued records when the application is about to crash. Nothing is written if another thread holds the lock at the moment,
+        // as it might be this very thread crashing while writing the log.
+        void emergencyFlush()
+        {
+            const std::unique_lock<std::mutex> lock( _mutex, std::try_to_lock );
+            if ( lock.owns_lock() ) {
+                _writeQueuedRecords();
+            }
+        }
+
+        void start()
+        {
+#if !defined( __EMSCRIPTEN__ ) || defined( __EMSCRIPTEN_PTHREADS__ )
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
+            if ( _worker.joinable() ) {
+                return;
+            }
+
+            _exitFlag = false;
+            _worker = std::thread( &AsyncLogWriter::_workerThread, this );
+            _isRunning.store( true, std::memory_order_release );
+#endif
+        }
+
+        // Stop the writer thread and write all queued records. Records produced after this call are written immediately.
+        void stop()
+        {
+            {
+                const std::scoped_lock<std::mutex> lock( _mutex );
+
+                if ( !_worker.joinable() ) {
+                    return;
+                }
+
+                _isRunning.store( false, std::memory_order_release );
+                _exitFlag = true;
+            }
+
+            _workerNotification.notify_one();
+            _worker.join();
+
+            flush();
+        }
+
+    private:
+        using RecordQueue = MultiThreading::SpscQueue<DebugLogRecord>;
+
+        // This mutex protects the list of queues, consumption of records from the queues and the members below.
+        std::mutex _mutex;
+
+        std::vector<std::shared_ptr<RecordQueue>> _queues;
+        std::vector<DebugLogRecord> _records;
+
+        std::time_t _lastTime{ -1 };
+        std::string _lastTimeString;
+
+        std::thread _worker;
+        std::condition_variable _workerNotification;
+        bool _exitFlag{ false };
+
+        std::atomic<uint64_t> _sequenceId{ 0 };
+        std::atomic<bool> _isRunning{ false };
+
+        // The maximum number of queued records per thread.
+        static constexpr size_t _queueCapacity{ 1024 };
+
+        // The writer wakes up periodically instead of being notified about every new record to keep producers free of any system calls.
+        static constexpr std::chrono::milliseconds _writeInterval{ 10 };
+
+        std::shared_ptr<RecordQueue> _registerQueue()
+        {
+            auto queue = std::make_shared<RecordQueue>( _queueCapacity );
+
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
+            _queues.push_back( queue );
+
+            return queue;
+        }
+
+        // The _mutex must be acquired while calling this method.
+        void _writeQueuedRecords()
+        {
+            for ( const std::shared_ptr<RecordQueue> & queue : _queues ) {
+                while ( std::optional<DebugLogRecord> record = queue->pop() ) {
+                    _records.emplace_back( std::move( *record ) );
+                }
+            }
+
+            // The queue is owned only by this writer once its thread exited and all the records of this queue have just been consumed.
+            _queues.erase( std::remove_if( _queues.begin(), _queues.end(),
+                                           []( const std::shared_ptr<RecordQueue> & queue ) { return queue.use_count() == 1 && queue->empty(); } ),
+                           _queues.end() );
+
+            if ( _records.empty() ) {
+                return;
+            }
+
+            std::sort( _records.begin(), _records.end(),
+                       []( const DebugLogRecord & first, const DebugLogRecord & second ) { return first.sequenceId < second.sequenceId; } );
+
+            for ( const DebugLogRecord & record : _records ) {
+                _write( record );
+            }
+
+            _records.clear();
+        }
+
+        void _write( const DebugLogRecord & record )
+        {
+            // Consecutive records very often have the same time so the formatted time is reused.
+            if ( record.time != _lastTime ) {
+                _lastTime = record.time;
+                _lastTimeString = formatTime( record.time );
+            }
+
+            COUT( _lastTimeString << ": [" << Logging::GetDebugOptionName( record.name ) << "]\t" << record.function << ":  " << record.message )
+        }
+
+        void _workerThread()
+        {
+            std::unique_lock<std::mutex> lock( _mutex );
+
+            while ( !_exitFlag ) {
+                _workerNotification.wait_for( lock, _writeInterval, [this] { return _exitFlag; } );
+
+                _writeQueuedRecords();
+            }
+        }
+    };
+
+    AsyncLogWriter & getAsyncLogWriter()
+    {
+        // The writer is never destroyed because records can be produced by any thread until the very end of the application's lifetime.
+        static AsyncLogWriter * writer = new AsyncLogWriter();
+
+        return *writer;
+    }
+
+    std::terminate_handler previousTerminateHandler{ nullptr };
+
+    // Queued records are the most valuable when the application crashes, so they are written before std::terminate() ends the application.
+    // This is not done for std::abort() as nothing but the simplest system calls can be safely made from a signal handler.
+    void flushDebugLogOnTerminate()
+    {
+        getAsyncLogWriter().emergencyFlush();
+
+        if ( previousTerminateHandler != nullptr ) {
+            previousTerminateHandler();
+        }
+
+        std::abort();
+    }
+
+    // Stops the writer thread when the application exits so that no queued records are lost.
+    class AsyncLogWriterStopper
+    {
+    public:
+        AsyncLogWriterStopper() = default;
+        AsyncLogWriterStopper( const AsyncLogWriterStopper & ) = delete;
+
+        ~AsyncLogWriterStopper()
+        {
+            getAsyncLogWriter().stop();
+        }
+
+        AsyncLogWriterStopper & operator=( const AsyncLogWriterStopper & ) = delete;
+    };
 }
 
 namespace Logging
@@ -78,6 +329,16 @@ namespace Logging
     // This mutex protects operations with logFile
     std::mutex logMutex;
 #endif
+}
+
+namespace
+{
+    // It must be defined after the log file to be destroyed before it.
+    const AsyncLogWriterStopper asyncLogWriterStopper;
+}
+
+namespace Logging
+{
 
     const char * GetDebugOptionName( const int name )
     {
@@ -101,17 +362,17 @@ namespace Logging
 
     std::string GetTimeString()
     {
-        const tm tmi = System::GetTM( std::time( nullptr ) );
-
-        std::array<char, 256> buf;
+        return formatTime( std::time( nullptr ) );
+    }
 
-        const size_t writtenBytes = std::strftime( buf.data(), buf.size(), "%d.%m.%Y %H:%M:%S", &tmi );
-        if ( writtenBytes == 0 ) {
-            assert( 0 );
-            return "<TIMESTAMP ERROR>";
-        }
+    void writeDebugLog( const int name, const char * function, std::string message )
+    {
+        getAsyncLogWriter().push( name, function, std::move( message ) );
+    }
 
-        return std::string( buf.data() );
+    void flushDebugLog()
+    {
+        getAsyncLogWriter().flush();
     }
 
     void InitLog()
@@ -133,6 +394,12 @@ namespace Logging
 
         setlogmask( LOG_UPTO( LOG_WARNING ) );
 #endif
+
+        getAsyncLogWriter().start();
+
+        if ( const std::terminate_handler handler = std::set_terminate( flushDebugLogOnTerminate ); handler != flushDebugLogOnTerminate ) {
+            previousTerminateHandler = handler;
+        }
     }
 
     void setDebugLevel( const int level )
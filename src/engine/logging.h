@@ -84,6 +84,14 @@ namespace Logging
 
     std::string GetTimeString();
 
+    // Queue a debug log record to be written by the background log writer thread. Writing to the log sink, including
+    // formatting of the record header, is done by the writer thread. If the queue of the calling thread is full or there is
+    // no thread support, the record (and all the queued records before it) is written immediately by the calling thread.
+    void writeDebugLog( const int name, const char * function, std::string message );
+
+    // Write all queued debug log records right away.
+    void flushDebugLog();
+
     // Initialize logging. Some systems require writing logging information into a file.
     void InitLog();
 
@@ -151,20 +159,25 @@ namespace Logging
     }
 #endif
 
+// Debug log records queued before are written first to preserve the order of log messages.
 #define VERBOSE_LOG( x )                                                                                                                                                 \
     {                                                                                                                                                                    \
+        Logging::flushDebugLog();                                                                                                                                        \
         COUT( Logging::GetTimeString() << ": [VERBOSE]\t" << __FUNCTION__ << ":  " << x );                                                                               \
     }
 
 #define ERROR_LOG( x )                                                                                                                                                   \
     {                                                                                                                                                                    \
+        Logging::flushDebugLog();                                                                                                                                        \
         COUT( Logging::GetTimeString() << ": [ERROR]\t" << __FUNCTION__ << ":  " << x );                                                                                 \
     }
 
 #ifdef WITH_DEBUG
 #define DEBUG_LOG( x, y, z )                                                                                                                                             \
     if ( IS_DEBUG( x, y ) ) {                                                                                                                                            \
-        COUT( Logging::GetTimeString() << ": [" << Logging::GetDebugOptionName( x ) << "]\t" << __FUNCTION__ << ":  " << z );                                            \
+        std::ostringstream _log_strstream; /* The name was chosen on purpose to avoid name collisions with outer code blocks. */                                         \
+        _log_strstream << z;                                                                                                                                             \
+        Logging::writeDebugLog( x, __FUNCTION__, _log_strstream.str() );                                                                                                 \
     }
 #else
 #define DEBUG_LOG( x, y, z )
@@ -0,0 +1,120 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2025                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "mapped_file.h"
+
+#if defined( _WIN32 )
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif ( defined( __linux__ ) && !defined( ANDROID ) ) || defined( __APPLE__ ) || defined( __FreeBSD__ ) || defined( __OpenBSD__ ) || defined( __NetBSD__ )
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define MAPPED_FILE_USE_MMAP
+#endif
+
+namespace fheroes2
+{
+    bool MappedFile::open( const std::string & fileName )
+    {
+        close();
+
+#if defined( _WIN32 )
+        const HANDLE file = CreateFileA( fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+        if ( file == INVALID_HANDLE_VALUE ) {
+            return false;
+        }
+
+        LARGE_INTEGER fileSize;
+        if ( !GetFileSizeEx( file, &fileSize ) || fileSize.QuadPart <= 0 ) {
+            CloseHandle( file );
+            return false;
+        }
+
+        const HANDLE mapping = CreateFileMappingA( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+        // The mapping keeps the file open by itself.
+        CloseHandle( file );
+
+        if ( mapping == nullptr ) {
+            return false;
+        }
+
+        const void * data = MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+        // The view keeps the mapping alive by itself.
+        CloseHandle( mapping );
+
+        if ( data == nullptr ) {
+            return false;
+        }
+
+        _data = static_cast<const uint8_t *>( data );
+        _size = static_cast<size_t>( fileSize.QuadPart );
+
+        return true;
+#elif defined( MAPPED_FILE_USE_MMAP )
+        const int fd = ::open( fileName.c_str(), O_RDONLY );
+        if ( fd < 0 ) {
+            return false;
+        }
+
+        struct stat fileStat;
+        if ( fstat( fd, &fileStat ) != 0 || fileStat.st_size <= 0 ) {
+            ::close( fd );
+            return false;
+        }
+
+        const size_t size = static_cast<size_t>( fileStat.st_size );
+        void * data = mmap( nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0 );
+        // The mapping remains valid after the file descriptor is closed.
+        ::close( fd );
+
+        if ( data == MAP_FAILED ) {
+            return false;
+        }
+
+        _data = static_cast<const uint8_t *>( data );
+        _size = size;
+
+        return true;
+#else
+        (void)fileName;
+
+        return false;
+#endif
+    }
+
+    void MappedFile::close()
+    {
+        if ( _data == nullptr ) {
+            return;
+        }
+
+#if defined( _WIN32 )
+        UnmapViewOfFile( _data );
+#elif defined( MAPPED_FILE_USE_MMAP )
+        munmap( const_cast<uint8_t *>( _data ), _size );
+#endif
+
+        _data = nullptr;
+        _size = 0;
+    }
+}
@@ -0,0 +1,68 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2025                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace fheroes2
+{
+    // Read-only memory mapping of a whole file. Memory mapping is supported only on some platforms, so the caller must be
+    // able to read the file in a usual way if open() fails.
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        MappedFile( const MappedFile & ) = delete;
+
+        ~MappedFile()
+        {
+            close();
+        }
+
+        MappedFile & operator=( const MappedFile & ) = delete;
+
+        // Returns true if the file has been mapped into memory.
+        bool open( const std::string & fileName );
+
+        void close();
+
+        bool isOpen() const
+        {
+            return _data != nullptr;
+        }
+
+        const uint8_t * data() const
+        {
+            return _data;
+        }
+
+        size_t size() const
+        {
+            return _size;
+        }
+
+    private:
+        const uint8_t * _data{ nullptr };
+        size_t _size{ 0 };
+    };
+}
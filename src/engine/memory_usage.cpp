@@ -0,0 +1,94 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "memory_usage.h"
+
+#include <cassert>
+#include <utility>
+
+#include "logging.h"
+
+namespace
+{
+    std::array<std::function<size_t()>, fheroes2::memoryOwnerCount> memoryUsageCounters;
+}
+
+namespace fheroes2
+{
+    const char * getMemoryOwnerName( const MemoryOwner owner )
+    {
+        switch ( owner ) {
+        case MemoryOwner::ICN_SPRITES:
+            return "Sprites";
+        case MemoryOwner::WORLD:
+            return "World";
+        case MemoryOwner::EDITOR_HISTORY:
+            return "Editor history";
+        case MemoryOwner::AUDIO:
+            return "Audio";
+        case MemoryOwner::VIDEO:
+            return "Video";
+        case MemoryOwner::TRANSLATIONS:
+            return "Translations";
+        default:
+            // Did you add a new owner? Add the logic above!
+            assert( 0 );
+            break;
+        }
+
+        return "Unknown";
+    }
+
+    void setMemoryUsageCounter( const MemoryOwner owner, std::function<size_t()> counter )
+    {
+        assert( owner < MemoryOwner::COUNT );
+
+        memoryUsageCounters[static_cast<size_t>( owner )] = std::move( counter );
+    }
+
+    std::array<size_t, memoryOwnerCount> getMemoryUsage()
+    {
+        std::array<size_t, memoryOwnerCount> usage{};
+
+        for ( size_t i = 0; i < memoryOwnerCount; ++i ) {
+            if ( memoryUsageCounters[i] ) {
+                usage[i] = memoryUsageCounters[i]();
+            }
+        }
+
+        return usage;
+    }
+
+    void logMemoryUsage()
+    {
+        const std::array<size_t, memoryOwnerCount> usage = getMemoryUsage();
+
+        size_t totalSize = 0;
+        for ( const size_t size : usage ) {
+            totalSize += size;
+        }
+
+        COUT( "Accounted memory usage: " << totalSize << " bytes." )
+
+        for ( size_t i = 0; i < memoryOwnerCount; ++i ) {
+            COUT( getMemoryOwnerName( static_cast<MemoryOwner>( i ) ) << ": " << usage[i] << " bytes" )
+        }
+    }
+}
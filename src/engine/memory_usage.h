@@ -0,0 +1,57 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace fheroes2
+{
+    // Major owners of memory whose usage is accounted.
+    enum class MemoryOwner : uint8_t
+    {
+        ICN_SPRITES,
+        WORLD,
+        EDITOR_HISTORY,
+        AUDIO,
+        VIDEO,
+        TRANSLATIONS,
+
+        // IMPORTANT!!! This must be the last entry.
+        COUNT
+    };
+
+    constexpr size_t memoryOwnerCount{ static_cast<size_t>( MemoryOwner::COUNT ) };
+
+    const char * getMemoryOwnerName( const MemoryOwner owner );
+
+    // Every owner provides a function returning the number of bytes it currently holds. The function is called only when the usage is
+    // requested, so owners do not pay anything for the accounting otherwise. The returned values are estimates of the owned data without
+    // the overhead of the memory allocator. All functions must be called from the main thread.
+    void setMemoryUsageCounter( const MemoryOwner owner, std::function<size_t()> counter );
+
+    std::array<size_t, memoryOwnerCount> getMemoryUsage();
+
+    // Writes the memory usage of all owners to the log.
+    void logMemoryUsage();
+}
@@ -1,75 +1,89 @@
 #include "lan_lobby.h"
 
 #include <algorithm>
+#include <cassert>
 #include <chrono>
-#include <cstring>
 #include <random>
 
+#include "lobby_frame.h"
+#include "logging.h"
 #include "serialize.h"
+#include "state_hash.h"
 
 namespace
 {
-    constexpr uint32_t lobbyProtocolVersion = 1;
-
     constexpr uint16_t lobbyDiscoveryPort = 26367; // arbitrary; LAN-only
     constexpr uint16_t lobbyDefaultTcpPort = 26368;
 
-    enum class MsgType : uint8_t
-    {
-        // UDP
-        Advertise = 1,
+    constexpr uint64_t lobbyAdvertiseIntervalMs = 1000;
 
-        // TCP
-        Hello = 10,
-        HelloAck = 11,
-        Chat = 20,
-        Kick = 30
-    };
+    // A client whose unsent data grows beyond this limit cannot keep up and is disconnected.
+    constexpr size_t maxClientQueueSize = 16 * 1024 * 1024;
+    // Already sent data at the front of the queue is dropped once it reaches this size.
+    constexpr size_t clientQueueCompactSize = 1024 * 1024;
 
-    std::vector<uint8_t> makePacket( MsgType type, const std::function<void( RWStreamBuf & )> & writeBody )
-    {
-        RWStreamBuf buf;
-        buf << static_cast<uint32_t>( 0x4C4F4242 ); // 'LOBB'
-        buf << lobbyProtocolVersion;
-        buf << static_cast<uint8_t>( type );
-        writeBody( buf );
+    constexpr uint64_t lobbyPingIntervalMs = 1000;
 
-        const auto view = buf.getRawView( buf.size() );
-        return std::vector<uint8_t>( view.first, view.first + view.second );
-    }
+    // Weight of the previous value when smoothing the round-trip time, out of 8, as in the TCP retransmission timer (RFC 6298).
+    constexpr uint64_t rttSmoothingWeight = 7;
+
+    // How long the host may sleep while clients still have data to be sent.
+    constexpr uint32_t flushRetryIntervalMs = 5;
+
+    // File chunks are queued for a client only while less than this amount of data is waiting to be sent, so other
+    // messages are not stuck behind a whole file and all clients receive their chunks in parallel.
+    constexpr size_t fileStreamWindowSize = 256 * 1024;
 
-    bool parseHeader( ROStreamBuf & buf, MsgType & outType )
+    uint64_t nowMs()
     {
-        uint32_t magic = 0;
-        uint32_t version = 0;
-        uint8_t type = 0;
+        const auto now = std::chrono::steady_clock::now().time_since_epoch();
+        return static_cast<uint64_t>( std::chrono::duration_cast<std::chrono::milliseconds>( now ).count() );
+    }
+}
 
-        buf >> magic >> version >> type;
-        if ( buf.fail() ) {
-            return false;
+namespace Network
+{
+    LobbyHostInfo getRelayLobbyInfo( const IpEndpoint & relay, const std::string & lobbyName )
+    {
+        LobbyHostInfo info;
+        info.lobbyName = lobbyName;
+        info.tcpPort = relay.port;
+        info.endpoint = relay;
+
+        // Lobby id 0 is rejected by the relay.
+        info.lobbyId = getDigest( reinterpret_cast<const uint8_t *>( lobbyName.data() ), lobbyName.size() );
+        if ( info.lobbyId == 0 ) {
+            info.lobbyId = 1;
         }
 
-        if ( magic != 0x4C4F4242 ) {
-            return false;
-        }
+        return info;
+    }
 
-        if ( version != lobbyProtocolVersion ) {
-            return false;
+    void LobbyConnectionMeter::addPong( const uint64_t pingTimestampMs, const uint64_t nowMs )
+    {
+        if ( pingTimestampMs > nowMs ) {
+            return;
         }
 
-        outType = static_cast<MsgType>( type );
-        return true;
+        const uint64_t sampleMs = nowMs - pingTimestampMs;
+        const uint64_t rttMs = ( _stats.rttMs == 0 ) ? sampleMs : ( rttSmoothingWeight * _stats.rttMs + sampleMs ) / ( rttSmoothingWeight + 1 );
+
+        _stats.rttMs = static_cast<uint32_t>( std::min<uint64_t>( rttMs, UINT32_MAX ) );
     }
 
-    uint64_t nowMs()
+    void LobbyConnectionMeter::update( const uint64_t nowMs )
     {
-        const auto now = std::chrono::steady_clock::now().time_since_epoch();
-        return static_cast<uint64_t>( std::chrono::duration_cast<std::chrono::milliseconds>( now ).count() );
+        if ( _lastUpdateMs != 0 && nowMs > _lastUpdateMs ) {
+            const uint64_t elapsedMs = nowMs - _lastUpdateMs;
+            _stats.framesInPerSecond = static_cast<uint32_t>( ( _framesIn - _lastFramesIn ) * 1000 / elapsedMs );
+            _stats.framesOutPerSecond = static_cast<uint32_t>( ( _framesOut - _lastFramesOut ) * 1000 / elapsedMs );
+        }
+
+        _lastFramesIn = _framesIn;
+        _lastFramesOut = _framesOut;
+        _lastUpdateMs = nowMs;
     }
-}
 
-namespace Network
-{
     uint64_t LanLobbyHost::_nowMs()
     {
         return ::nowMs();
@@ -144,11 +158,15 @@ namespace Network
         _running = false;
         _clients.clear();
         _chat.clear();
+        _lockstep.clear();
+        _files.clear();
         _udp.close();
         _tcpListen.close();
         _tcpPort = 0;
         _lobbyId = 0;
         _lastAdvertiseMs = 0;
+        _lastPingMs = 0;
+        _connectionStats.reset();
     }
 
     bool LanLobbyHost::isRunning() const
@@ -176,19 +194,60 @@ namespace Network
         return _inviteCode;
     }
 
-    void LanLobbyHost::pump()
+    void LanLobbyHost::pump( const uint32_t timeoutMs /* = 0 */ )
     {
         if ( !_running ) {
             return;
         }
 
         _advertise();
-        _acceptClients();
+        _pingClients();
 
-        for ( auto & c : _clients ) {
-            _pumpClient( c );
+        const bool isStreamingFiles = _streamFiles();
+
+        // Frames queued since the previous call are sent together.
+        const bool hasUnsentData = _flushClients() || isStreamingFiles;
+
+        uint32_t waitMs = timeoutMs;
+        if ( waitMs > 0 ) {
+            const uint64_t now = _nowMs();
+            const uint64_t sinceAdvertiseMs = now - _lastAdvertiseMs;
+            const uint32_t untilAdvertiseMs = sinceAdvertiseMs < lobbyAdvertiseIntervalMs ? static_cast<uint32_t>( lobbyAdvertiseIntervalMs - sinceAdvertiseMs ) : 0;
+            const uint64_t sincePingMs = now - _lastPingMs;
+            const uint32_t untilPingMs = sincePingMs < lobbyPingIntervalMs ? static_cast<uint32_t>( lobbyPingIntervalMs - sincePingMs ) : 0;
+            waitMs = std::min( { waitMs, untilAdvertiseMs, untilPingMs } );
+
+            if ( hasUnsentData ) {
+                // Only readability is polled, so wake up soon to continue sending.
+                waitMs = std::min( waitMs, flushRetryIntervalMs );
+            }
         }
 
+        // Slot 0 is always the listening socket, client slots follow in the order of _clients.
+        _poller.clear();
+        _poller.add( _tcpListen );
+        for ( const Client & c : _clients ) {
+            _poller.add( c.socket );
+        }
+
+        if ( _poller.wait( static_cast<int>( waitMs ) ) <= 0 ) {
+            return;
+        }
+
+        // Clients are serviced before accepting new ones so the slot indices stay valid.
+        for ( size_t i = 0; i < _clients.size(); ++i ) {
+            if ( _poller.isReadable( i + 1 ) ) {
+                _pumpClient( _clients[i] );
+            }
+        }
+
+        if ( _poller.isReadable( 0 ) ) {
+            _acceptClients();
+        }
+
+        // Replies and relayed messages produced while servicing the clients.
+        _flushClients();
+
         // Remove disconnected clients.
         _clients.erase( std::remove_if( _clients.begin(), _clients.end(), []( const Client & c ) { return !c.socket.isValid(); } ), _clients.end() );
     }
@@ -213,24 +272,130 @@ namespace Network
         LobbyChatMessage msg{ _nowMs(), _hostPlayerName.empty() ? "host" : _hostPlayerName, text };
         _chat.push_back( msg );
 
-        auto packet = makePacket( MsgType::Chat, [&]( RWStreamBuf & buf ) {
+        std::vector<uint8_t> frame = buildLobbyFrame( _framePool, LobbyMessageType::Chat, [&]( OStreamBase & buf ) {
             buf << msg.timestampMs;
             buf << std::string_view( msg.from );
             buf << std::string_view( msg.text );
         } );
 
-        _broadcastPacket( packet );
+        _broadcastFrame( frame );
+        _framePool.release( std::move( frame ) );
+    }
+
+    void LanLobbyHost::sendLockstep( const LockstepCommand & cmd )
+    {
+        if ( !_running ) {
+            return;
+        }
+
+        std::vector<uint8_t> frame = buildLobbyFrame( _framePool, LobbyMessageType::Lockstep, [&cmd]( OStreamBase & buf ) { buf << cmd; } );
+        _broadcastFrame( frame );
+        _framePool.release( std::move( frame ) );
+    }
+
+    std::optional<LockstepCommand> LanLobbyHost::popLockstep()
+    {
+        if ( _lockstep.empty() ) {
+            return std::nullopt;
+        }
+
+        LockstepCommand cmd = std::move( _lockstep.front() );
+        _lockstep.pop_front();
+        return cmd;
+    }
+
+    std::optional<std::vector<LobbyConnectionStats>> LanLobbyHost::popConnectionStats()
+    {
+        std::optional<std::vector<LobbyConnectionStats>> stats = std::move( _connectionStats );
+        _connectionStats.reset();
+        return stats;
+    }
+
+    uint32_t LanLobbyHost::offerFile( const std::string & name, std::vector<uint8_t> content )
+    {
+        if ( !_running || !isValidLobbyFileName( name ) || content.empty() || content.size() > maxLobbyFileSize ) {
+            return 0;
+        }
+
+        const uint32_t transferId = _nextTransferId++;
+
+        const LobbyFileSource & source = _files.try_emplace( transferId, transferId, name, std::move( content ) ).first->second;
+
+        for ( Client & c : _clients ) {
+            if ( c.socket.isValid() && c.joined ) {
+                _sendFileOffer( c, source.offer() );
+            }
+        }
+
+        return transferId;
+    }
+
+    void LanLobbyHost::withdrawFile( const uint32_t transferId )
+    {
+        _files.erase( transferId );
+
+        for ( Client & c : _clients ) {
+            c.fileStreams.erase( transferId );
+            c.receivedFiles.erase( transferId );
+        }
+    }
+
+    bool LanLobbyHost::isFileDelivered( const uint32_t transferId ) const
+    {
+        if ( _files.find( transferId ) == _files.end() ) {
+            return false;
+        }
+
+        return std::all_of( _clients.begin(), _clients.end(), [transferId]( const Client & c ) {
+            return !c.socket.isValid() || !c.joined || c.receivedFiles.count( transferId ) > 0;
+        } );
+    }
+
+    void LanLobbyHost::_pingClients()
+    {
+        const uint64_t now = _nowMs();
+        if ( now - _lastPingMs < lobbyPingIntervalMs ) {
+            return;
+        }
+        _lastPingMs = now;
+
+        std::vector<uint8_t> ping = buildLobbyFrame( _framePool, LobbyMessageType::Ping, [now]( OStreamBase & buf ) { buf << now; } );
+
+        std::vector<LobbyConnectionStats> stats;
+
+        for ( Client & c : _clients ) {
+            if ( !c.socket.isValid() || !c.joined ) {
+                continue;
+            }
+
+            _sendFrame( c, ping );
+
+            c.meter.update( now );
+
+            LobbyConnectionStats & clientStats = stats.emplace_back( c.meter.stats() );
+            clientStats.name = c.name;
+            clientStats.queuedBytes = c.tx.size() - c.txOffset;
+
+            DEBUG_LOG( DBG_NETWORK, DBG_TRACE,
+                       c.name << " (" << c.endpoint.address << "): RTT " << clientStats.rttMs << " ms, in " << clientStats.bytesIn << " bytes, "
+                              << clientStats.framesInPerSecond << " frames/s, out " << clientStats.bytesOut << " bytes, " << clientStats.framesOutPerSecond
+                              << " frames/s, queued " << clientStats.queuedBytes << " bytes" )
+        }
+
+        _framePool.release( std::move( ping ) );
+
+        _connectionStats = std::move( stats );
     }
 
     void LanLobbyHost::_advertise()
     {
         const uint64_t now = _nowMs();
-        if ( now - _lastAdvertiseMs < 1000 ) {
+        if ( now - _lastAdvertiseMs < lobbyAdvertiseIntervalMs ) {
             return;
         }
         _lastAdvertiseMs = now;
 
-        auto packet = makePacket( MsgType::Advertise, [&]( RWStreamBuf & buf ) {
+        std::vector<uint8_t> frame = buildLobbyFrame( _framePool, LobbyMessageType::Advertise, [&]( OStreamBase & buf ) {
             buf << _lobbyId;
             buf << _tcpPort;
             buf << static_cast<uint8_t>( _privacy );
@@ -238,8 +403,10 @@ namespace Network
             buf << std::string_view( _hostPlayerName );
         } );
 
+        // Datagrams are not framed.
         IpEndpoint dest{ "255.255.255.255", lobbyDiscoveryPort };
-        _udp.sendTo( packet.data(), packet.size(), dest );
+        _udp.sendTo( frame.data() + frameHeaderSize, frame.size() - frameHeaderSize, dest );
+        _framePool.release( std::move( frame ) );
     }
 
     void LanLobbyHost::_acceptClients()
@@ -261,79 +428,149 @@ namespace Network
 
     void LanLobbyHost::_pumpClient( Client & client )
     {
-        uint8_t buf[4096];
-        const int rc = client.socket.recv( buf, sizeof( buf ) );
-        if ( rc < 0 ) {
-            client.socket.close();
-            return;
+        // The socket was reported as readable: drain everything the OS has buffered for it straight into the frame buffer.
+        bool received = false;
+        while ( true ) {
+            const std::pair<uint8_t *, size_t> region = client.rx.writeRegion();
+            if ( region.second == 0 ) {
+                // The buffer is full of complete frames, process them to make room.
+                if ( !_processClientFrames( client ) ) {
+                    return;
+                }
+                continue;
+            }
+
+            const int rc = client.socket.recv( region.first, region.second );
+            if ( rc < 0 ) {
+                client.socket.close();
+                return;
+            }
+            if ( rc == 0 ) {
+                break;
+            }
+
+            client.rx.commitWrite( static_cast<size_t>( rc ) );
+            client.meter.addReceived( static_cast<size_t>( rc ) );
+            received = true;
         }
-        if ( rc == 0 ) {
+
+        if ( !received ) {
+            // A readable socket without any data means that the peer closed the connection.
+            client.socket.close();
             return;
         }
 
-        client.rx.insert( client.rx.end(), buf, buf + rc );
+        _processClientFrames( client );
+    }
+
+    bool LanLobbyHost::_processClientFrames( Client & client )
+    {
+        std::pair<const uint8_t *, size_t> packet;
+        std::vector<uint8_t> unpacked;
 
-        // Packets are length-prefixed (uint32) for TCP.
         while ( true ) {
-            if ( client.rx.size() < sizeof( uint32_t ) ) {
-                return;
+            const FrameDecoder::Result result = client.rx.nextFrame( packet );
+            if ( result == FrameDecoder::Result::Incomplete ) {
+                return true;
+            }
+            if ( result == FrameDecoder::Result::Invalid ) {
+                client.socket.close();
+                return false;
             }
 
-            uint32_t packetLen = 0;
-            std::memcpy( &packetLen, client.rx.data(), sizeof( uint32_t ) );
-            packetLen = le32toh( packetLen );
+            client.meter.addReceivedFrame();
 
-            if ( packetLen == 0 || packetLen > 1024 * 64 ) {
+            if ( !unwrapLobbyPacket( packet, unpacked ) ) {
                 client.socket.close();
-                return;
+                return false;
             }
 
-            if ( client.rx.size() < sizeof( uint32_t ) + packetLen ) {
-                return;
+            ROStreamBuf s( packet.first, packet.second );
+            LobbyMessageType type{};
+            if ( !parseLobbyHeader( s, type ) ) {
+                continue;
             }
 
-            std::vector<uint8_t> packet( client.rx.begin() + sizeof( uint32_t ), client.rx.begin() + sizeof( uint32_t ) + packetLen );
-            client.rx.erase( client.rx.begin(), client.rx.begin() + sizeof( uint32_t ) + packetLen );
+            if ( type == LobbyMessageType::Ping ) {
+                uint64_t timestampMs = 0;
+                s >> timestampMs;
+                if ( s.fail() ) {
+                    continue;
+                }
+
+                std::vector<uint8_t> pong = buildLobbyFrame( _framePool, LobbyMessageType::Pong, [timestampMs]( OStreamBase & w ) { w << timestampMs; } );
+                _sendFrame( client, pong );
+                _framePool.release( std::move( pong ) );
+                continue;
+            }
 
-            ROStreamBuf s( std::move( packet ) );
-            MsgType type{};
-            if ( !parseHeader( s, type ) ) {
+            if ( type == LobbyMessageType::Pong ) {
+                uint64_t timestampMs = 0;
+                s >> timestampMs;
+                if ( !s.fail() ) {
+                    client.meter.addPong( timestampMs, _nowMs() );
+                }
                 continue;
             }
 
-            if ( type == MsgType::Hello ) {
+            if ( type == LobbyMessageType::Hello ) {
                 uint64_t lobbyId = 0;
                 std::string playerName;
                 std::string invite;
                 s >> lobbyId >> playerName >> invite;
-                if ( s.fail() || lobbyId != _lobbyId ) {
+                if ( s.fail() || lobbyId != _lobbyId || client.joined ) {
                     client.socket.close();
-                    return;
+                    return false;
+                }
+
+                // Older clients do not send their revision.
+                if ( s.size() >= sizeof( uint32_t ) ) {
+                    s >> client.protocolRevision;
                 }
 
                 if ( _privacy == LobbyPrivacy::InviteOnly && invite != _inviteCode ) {
-                    auto kick = makePacket( MsgType::Kick, [&]( RWStreamBuf & w ) { w << std::string_view( "Invalid invite code" ); } );
-                    _sendPacket( client.socket, kick );
+                    std::vector<uint8_t> kick
+                        = buildLobbyFrame( _framePool, LobbyMessageType::Kick, []( OStreamBase & w ) { w << std::string_view( "Invalid invite code" ); } );
+                    _sendFrame( client, kick );
+                    _framePool.release( std::move( kick ) );
+
+                    _flushClient( client );
                     client.socket.close();
-                    return;
+                    return false;
                 }
 
                 client.joined = true;
                 client.name = playerName;
 
-                auto ack = makePacket( MsgType::HelloAck, [&]( RWStreamBuf & w ) {
+                std::vector<uint8_t> ack = buildLobbyFrame( _framePool, LobbyMessageType::HelloAck, [&]( OStreamBase & w ) {
                     w << _lobbyId;
                     w << std::string_view( _lobbyName );
                     w << std::string_view( _hostPlayerName );
                     w << static_cast<uint8_t>( _privacy );
+                    w << lobbyProtocolRevision;
                 } );
-                _sendPacket( client.socket, ack );
+                _sendFrame( client, ack );
+                _framePool.release( std::move( ack ) );
+
+                for ( const auto & [transferId, source] : _files ) {
+                    _sendFileOffer( client, source.offer() );
+                }
 
                 _chat.push_back( LobbyChatMessage{ _nowMs(), "system", client.name + " joined" } );
                 continue;
             }
 
-            if ( type == MsgType::Chat ) {
+            if ( type == LobbyMessageType::FileRequest ) {
+                uint32_t transferId = 0;
+                uint32_t firstChunk = 0;
+                s >> transferId >> firstChunk;
+                if ( !s.fail() && client.joined ) {
+                    _processFileRequest( client, transferId, firstChunk );
+                }
+                continue;
+            }
+
+            if ( type == LobbyMessageType::Chat ) {
                 uint64_t ts = 0;
                 std::string from;
                 std::string text;
@@ -342,36 +579,210 @@ namespace Network
                     continue;
                 }
 
-                _chat.push_back( LobbyChatMessage{ ts, from, text } );
-
-                // Relay to others.
-                auto relay = makePacket( MsgType::Chat, [&]( RWStreamBuf & w ) {
+                // Relay to others; the frame is serialized once for all recipients.
+                std::vector<uint8_t> relay = buildLobbyFrame( _framePool, LobbyMessageType::Chat, [&]( OStreamBase & w ) {
                     w << ts;
                     w << std::string_view( from );
                     w << std::string_view( text );
                 } );
-                _broadcastPacket( relay );
+                _broadcastFrame( relay );
+                _framePool.release( std::move( relay ) );
+
+                _chat.push_back( LobbyChatMessage{ ts, std::move( from ), std::move( text ) } );
+                continue;
+            }
+
+            if ( type == LobbyMessageType::Lockstep ) {
+                LockstepCommand cmd;
+                s >> cmd;
+                if ( s.fail() || !client.joined ) {
+                    continue;
+                }
+
+                std::vector<uint8_t> relay = buildLobbyFrame( _framePool, LobbyMessageType::Lockstep, [&cmd]( OStreamBase & w ) { w << cmd; } );
+                _broadcastFrame( relay, &client );
+                _framePool.release( std::move( relay ) );
+
+                _lockstep.push_back( std::move( cmd ) );
+            }
+        }
+    }
+
+    void LanLobbyHost::_sendFileOffer( Client & client, const LobbyFileOffer & offer )
+    {
+        client.receivedFiles.erase( offer.transferId );
+
+        std::vector<uint8_t> frame = buildLobbyFrame( _framePool, LobbyMessageType::FileOffer, [&offer]( OStreamBase & w ) { w << offer; } );
+        _sendFrame( client, frame );
+        _framePool.release( std::move( frame ) );
+    }
+
+    void LanLobbyHost::_processFileRequest( Client & client, const uint32_t transferId, const uint32_t firstChunk )
+    {
+        const auto file = _files.find( transferId );
+        if ( file == _files.end() || firstChunk > file->second.offer().chunkCount() ) {
+            return;
+        }
+
+        if ( firstChunk == file->second.offer().chunkCount() ) {
+            client.fileStreams.erase( transferId );
+            client.receivedFiles.insert( transferId );
+
+            DEBUG_LOG( DBG_NETWORK, DBG_INFO, client.name << " has received " << file->second.offer().name )
+            return;
+        }
+
+        // A client requesting the first chunk again after a failure restarts the stream.
+        client.fileStreams[transferId] = firstChunk;
+        client.receivedFiles.erase( transferId );
+    }
+
+    bool LanLobbyHost::_streamFiles()
+    {
+        bool hasPendingChunks = false;
+
+        for ( Client & c : _clients ) {
+            if ( c.fileStreams.empty() || !c.socket.isValid() ) {
+                continue;
             }
+
+            // Transfers are served in turns, a chunk of each at a time.
+            while ( !c.fileStreams.empty() && c.tx.size() - c.txOffset < fileStreamWindowSize ) {
+                for ( auto stream = c.fileStreams.begin(); stream != c.fileStreams.end(); ) {
+                    const auto file = _files.find( stream->first );
+                    const std::pair<const uint8_t *, size_t> chunk
+                        = ( file == _files.end() ) ? std::pair<const uint8_t *, size_t>{ nullptr, 0 } : file->second.chunk( stream->second );
+                    if ( chunk.second == 0 ) {
+                        // All chunks have been sent, the client confirms the download with a request past the last chunk.
+                        stream = c.fileStreams.erase( stream );
+                        continue;
+                    }
+
+                    std::vector<uint8_t> frame = buildLobbyFrame( _framePool, LobbyMessageType::FileChunk, [&stream, &chunk]( OStreamBase & w ) {
+                        w << stream->first;
+                        w << stream->second;
+                        // Same layout as a serialized std::vector<uint8_t>.
+                        w.put32( static_cast<uint32_t>( chunk.second ) );
+                        w.putRaw( chunk.first, chunk.second );
+                    } );
+                    _sendFrame( c, frame );
+                    _framePool.release( std::move( frame ) );
+
+                    if ( !c.socket.isValid() ) {
+                        break;
+                    }
+
+                    ++stream->second;
+                    ++stream;
+                }
+
+                if ( !c.socket.isValid() ) {
+                    break;
+                }
+            }
+
+            hasPendingChunks = hasPendingChunks || ( !c.fileStreams.empty() && c.socket.isValid() );
         }
+
+        return hasPendingChunks;
     }
 
-    void LanLobbyHost::_broadcastPacket( const std::vector<uint8_t> & packet )
+    void LanLobbyHost::_broadcastFrame( const std::vector<uint8_t> & frame, const Client * except /* = nullptr */ )
     {
+        // The compressed frame is built only once for all the clients supporting it.
+        std::vector<uint8_t> compressed;
+        bool isCompressionTried = false;
+
         for ( auto & c : _clients ) {
-            if ( c.socket.isValid() && c.joined ) {
-                _sendPacket( c.socket, packet );
+            if ( !c.socket.isValid() || !c.joined || &c == except ) {
+                continue;
+            }
+
+            if ( c.protocolRevision >= lobbyCompressionRevision && frame.size() >= lobbyCompressionThreshold ) {
+                if ( !isCompressionTried ) {
+                    compressed = compressLobbyFrame( _framePool, frame );
+                    isCompressionTried = true;
+                }
+
+                if ( !compressed.empty() ) {
+                    _queueFrame( c, compressed.data(), compressed.size() );
+                    continue;
+                }
+            }
+
+            _queueFrame( c, frame.data(), frame.size() );
+        }
+
+        if ( !compressed.empty() ) {
+            _framePool.release( std::move( compressed ) );
+        }
+    }
+
+    void LanLobbyHost::_sendFrame( Client & client, const std::vector<uint8_t> & frame )
+    {
+        if ( client.protocolRevision >= lobbyCompressionRevision ) {
+            std::vector<uint8_t> compressed = compressLobbyFrame( _framePool, frame );
+            if ( !compressed.empty() ) {
+                _queueFrame( client, compressed.data(), compressed.size() );
+                _framePool.release( std::move( compressed ) );
+                return;
+            }
+        }
+
+        _queueFrame( client, frame.data(), frame.size() );
+    }
+
+    bool LanLobbyHost::_queueFrame( Client & client, const uint8_t * data, const size_t size )
+    {
+        if ( client.tx.size() - client.txOffset + size > maxClientQueueSize ) {
+            client.socket.close();
+            return false;
+        }
+
+        client.tx.insert( client.tx.end(), data, data + size );
+        client.meter.addSentFrame( size );
+
+        return true;
+    }
+
+    bool LanLobbyHost::_flushClients()
+    {
+        bool hasUnsentData = false;
+
+        for ( Client & c : _clients ) {
+            if ( !c.tx.empty() && _flushClient( c ) ) {
+                hasUnsentData = hasUnsentData || !c.tx.empty();
             }
         }
+
+        return hasUnsentData;
     }
 
-    void LanLobbyHost::_sendPacket( Socket & socket, const std::vector<uint8_t> & packet )
+    bool LanLobbyHost::_flushClient( Client & client )
     {
-        // Length-prefix.
-        RWStreamBuf framed;
-        framed.putLE32( static_cast<uint32_t>( packet.size() ) );
-        framed.putRaw( packet.data(), packet.size() );
-        const auto view = framed.getRawView( framed.size() );
-        socket.send( view.first, view.second );
+        while ( client.txOffset < client.tx.size() ) {
+            const int sent = client.socket.send( client.tx.data() + client.txOffset, client.tx.size() - client.txOffset );
+            if ( sent < 0 ) {
+                client.socket.close();
+                return false;
+            }
+            if ( sent == 0 ) {
+                break;
+            }
+
+            client.txOffset += static_cast<size_t>( sent );
+        }
+
+        if ( client.txOffset == client.tx.size() ) {
+            client.tx.clear();
+            client.txOffset = 0;
+        }
+        else if ( client.txOffset >= clientQueueCompactSize ) {
+            client.tx.erase( client.tx.begin(), client.tx.begin() + static_cast<std::ptrdiff_t>( client.txOffset ) );
+            client.txOffset = 0;
+        }
+
+        return true;
     }
 
     LanLobbyClient::LanLobbyClient() = default;
@@ -443,6 +854,8 @@ namespace Network
         IpEndpoint ep = host.endpoint;
         ep.port = host.tcpPort;
 
+        _hostAddress = ep.address + ":" + std::to_string( ep.port );
+
         if ( !_tcp.connect( ep ) ) {
             disconnect();
             return false;
@@ -450,12 +863,17 @@ namespace Network
 
         _connected = true;
 
-        auto hello = makePacket( MsgType::Hello, [&]( RWStreamBuf & buf ) {
+        std::vector<uint8_t> hello = buildLobbyFrame( _framePool, LobbyMessageType::Hello, [&]( OStreamBase & buf ) {
             buf << host.lobbyId;
             buf << std::string_view( _playerName );
             buf << std::string_view( _inviteCode );
+            buf << lobbyProtocolRevision;
         } );
-        _sendPacket( _tcp, hello );
+        _sendFrame( hello );
+        _framePool.release( std::move( hello ) );
+
+        // The connection might not be established yet, in which case the frame stays queued until the next pump.
+        _flush();
 
         return true;
     }
@@ -466,6 +884,15 @@ namespace Network
         _tcp.close();
         _rx.clear();
         _chat.clear();
+        _lockstep.clear();
+        _meter = {};
+        _lastPingMs = 0;
+        _connectionStats.reset();
+        _tx.clear();
+        _txOffset = 0;
+        _hostRevision = 1;
+        _downloads.clear();
+        _receivedFiles.clear();
     }
 
     bool LanLobbyClient::isConnected() const
@@ -479,7 +906,52 @@ namespace Network
             return;
         }
 
+        _pingHost();
+        _flush();
         _pumpTcp();
+        _flush();
+    }
+
+    void LanLobbyClient::pump( const uint32_t timeoutMs /* = 0 */ )
+    {
+        // Even with nothing to service the call waits for the given time, so a pumping loop does not spin.
+        const bool connected = isConnected();
+
+        uint32_t waitMs = timeoutMs;
+
+        if ( connected ) {
+            _pingHost();
+
+            // Frames queued since the previous call are sent together.
+            if ( !_flush() ) {
+                // Only readability is polled, so wake up soon to continue sending.
+                waitMs = std::min( waitMs, flushRetryIntervalMs );
+            }
+        }
+
+        // Sockets which are not in use are replaced by an invalid one which is never reported as readable.
+        static const Socket unused;
+
+        _poller.clear();
+        const size_t udpSlot = _poller.add( _discovering ? _udp : unused );
+        const size_t tcpSlot = _poller.add( connected ? _tcp : unused );
+
+        if ( _poller.wait( static_cast<int>( waitMs ) ) <= 0 ) {
+            return;
+        }
+
+        if ( _poller.isReadable( udpSlot ) ) {
+            _pumpUdp();
+        }
+
+        if ( _poller.isReadable( tcpSlot ) ) {
+            _pumpTcp();
+
+            // Replies produced while processing the received frames.
+            if ( isConnected() ) {
+                _flush();
+            }
+        }
     }
 
     void LanLobbyClient::sendChat( const std::string & text )
@@ -490,12 +962,13 @@ namespace Network
 
         LobbyChatMessage msg{ _nowMs(), _playerName.empty() ? "player" : _playerName, text };
 
-        auto packet = makePacket( MsgType::Chat, [&]( RWStreamBuf & buf ) {
+        std::vector<uint8_t> frame = buildLobbyFrame( _framePool, LobbyMessageType::Chat, [&]( OStreamBase & buf ) {
             buf << msg.timestampMs;
             buf << std::string_view( msg.from );
             buf << std::string_view( msg.text );
         } );
-        _sendPacket( _tcp, packet );
+        _sendFrame( frame );
+        _framePool.release( std::move( frame ) );
 
         _chat.push_back( msg );
     }
@@ -511,6 +984,75 @@ namespace Network
         return msg;
     }
 
+    void LanLobbyClient::sendLockstep( const LockstepCommand & cmd )
+    {
+        if ( !isConnected() ) {
+            return;
+        }
+
+        std::vector<uint8_t> frame = buildLobbyFrame( _framePool, LobbyMessageType::Lockstep, [&cmd]( OStreamBase & buf ) { buf << cmd; } );
+        _sendFrame( frame );
+        _framePool.release( std::move( frame ) );
+    }
+
+    std::optional<LockstepCommand> LanLobbyClient::popLockstep()
+    {
+        if ( _lockstep.empty() ) {
+            return std::nullopt;
+        }
+
+        LockstepCommand cmd = std::move( _lockstep.front() );
+        _lockstep.pop_front();
+        return cmd;
+    }
+
+    std::optional<LobbyConnectionStats> LanLobbyClient::popConnectionStats()
+    {
+        std::optional<LobbyConnectionStats> stats = std::move( _connectionStats );
+        _connectionStats.reset();
+        return stats;
+    }
+
+    void LanLobbyClient::setDownloadDirectory( std::string directory )
+    {
+        _downloadDirectory = std::move( directory );
+    }
+
+    std::optional<LobbyReceivedFile> LanLobbyClient::popReceivedFile()
+    {
+        if ( _receivedFiles.empty() ) {
+            return std::nullopt;
+        }
+
+        LobbyReceivedFile file = std::move( _receivedFiles.front() );
+        _receivedFiles.pop_front();
+        return file;
+    }
+
+    void LanLobbyClient::_pingHost()
+    {
+        const uint64_t now = _nowMs();
+        if ( now - _lastPingMs < lobbyPingIntervalMs ) {
+            return;
+        }
+        _lastPingMs = now;
+
+        std::vector<uint8_t> ping = buildLobbyFrame( _framePool, LobbyMessageType::Ping, [now]( OStreamBase & buf ) { buf << now; } );
+        _sendFrame( ping );
+        _framePool.release( std::move( ping ) );
+
+        _meter.update( now );
+
+        LobbyConnectionStats stats = _meter.stats();
+        stats.name = _hostAddress;
+
+        DEBUG_LOG( DBG_NETWORK, DBG_TRACE,
+                   "Host " << stats.name << ": RTT " << stats.rttMs << " ms, in " << stats.bytesIn << " bytes, " << stats.framesInPerSecond << " frames/s, out "
+                           << stats.bytesOut << " bytes, " << stats.framesOutPerSecond << " frames/s" )
+
+        _connectionStats = std::move( stats );
+    }
+
     void LanLobbyClient::_pumpUdp()
     {
         uint8_t buf[4096];
@@ -522,14 +1064,13 @@ namespace Network
                 return;
             }
 
-            std::vector<uint8_t> packet( buf, buf + rc );
-            ROStreamBuf s( std::move( packet ) );
-            MsgType type{};
-            if ( !parseHeader( s, type ) ) {
+            ROStreamBuf s( buf, static_cast<size_t>( rc ) );
+            LobbyMessageType type{};
+            if ( !parseLobbyHeader( s, type ) ) {
                 continue;
             }
 
-            if ( type != MsgType::Advertise ) {
+            if ( type != LobbyMessageType::Advertise ) {
                 continue;
             }
 
@@ -553,69 +1094,233 @@ namespace Network
 
     void LanLobbyClient::_pumpTcp()
     {
-        uint8_t buf[4096];
-        const int rc = _tcp.recv( buf, sizeof( buf ) );
-        if ( rc < 0 ) {
-            disconnect();
-            return;
-        }
-        if ( rc == 0 ) {
-            return;
-        }
-
-        _rx.insert( _rx.end(), buf, buf + rc );
-
         while ( true ) {
-            if ( _rx.size() < sizeof( uint32_t ) ) {
-                return;
+            const std::pair<uint8_t *, size_t> region = _rx.writeRegion();
+            if ( region.second == 0 ) {
+                // The buffer is full of complete frames, process them to make room.
+                if ( !_processFrames() ) {
+                    return;
+                }
+                continue;
             }
 
-            uint32_t packetLen = 0;
-            std::memcpy( &packetLen, _rx.data(), sizeof( uint32_t ) );
-            packetLen = le32toh( packetLen );
-
-            if ( packetLen == 0 || packetLen > 1024 * 64 ) {
+            const int rc = _tcp.recv( region.first, region.second );
+            if ( rc < 0 ) {
                 disconnect();
                 return;
             }
+            if ( rc == 0 ) {
+                break;
+            }
 
-            if ( _rx.size() < sizeof( uint32_t ) + packetLen ) {
-                return;
+            _rx.commitWrite( static_cast<size_t>( rc ) );
+            _meter.addReceived( static_cast<size_t>( rc ) );
+        }
+
+        _processFrames();
+    }
+
+    bool LanLobbyClient::_processFrames()
+    {
+        std::pair<const uint8_t *, size_t> packet;
+        std::vector<uint8_t> unpacked;
+
+        while ( true ) {
+            const FrameDecoder::Result result = _rx.nextFrame( packet );
+            if ( result == FrameDecoder::Result::Incomplete ) {
+                return true;
+            }
+            if ( result == FrameDecoder::Result::Invalid ) {
+                disconnect();
+                return false;
             }
 
-            std::vector<uint8_t> packet( _rx.begin() + sizeof( uint32_t ), _rx.begin() + sizeof( uint32_t ) + packetLen );
-            _rx.erase( _rx.begin(), _rx.begin() + sizeof( uint32_t ) + packetLen );
+            _meter.addReceivedFrame();
+
+            if ( !unwrapLobbyPacket( packet, unpacked ) ) {
+                disconnect();
+                return false;
+            }
 
-            ROStreamBuf s( std::move( packet ) );
-            MsgType type{};
-            if ( !parseHeader( s, type ) ) {
+            ROStreamBuf s( packet.first, packet.second );
+            LobbyMessageType type{};
+            if ( !parseLobbyHeader( s, type ) ) {
                 continue;
             }
 
-            if ( type == MsgType::Chat ) {
+            if ( type == LobbyMessageType::Ping ) {
+                uint64_t timestampMs = 0;
+                s >> timestampMs;
+                if ( !s.fail() ) {
+                    std::vector<uint8_t> pong = buildLobbyFrame( _framePool, LobbyMessageType::Pong, [timestampMs]( OStreamBase & w ) { w << timestampMs; } );
+                    _sendFrame( pong );
+                    _framePool.release( std::move( pong ) );
+                }
+            }
+            else if ( type == LobbyMessageType::Pong ) {
+                uint64_t timestampMs = 0;
+                s >> timestampMs;
+                if ( !s.fail() ) {
+                    _meter.addPong( timestampMs, _nowMs() );
+                }
+            }
+            else if ( type == LobbyMessageType::HelloAck ) {
+                uint64_t lobbyId = 0;
+                std::string lobbyName;
+                std::string hostPlayerName;
+                uint8_t privacy = 0;
+                s >> lobbyId >> lobbyName >> hostPlayerName >> privacy;
+
+                // Older hosts and the relay server do not send their revision.
+                if ( !s.fail() && s.size() >= sizeof( uint32_t ) ) {
+                    s >> _hostRevision;
+                }
+            }
+            else if ( type == LobbyMessageType::Chat ) {
                 LobbyChatMessage msg;
                 s >> msg.timestampMs >> msg.from >> msg.text;
                 if ( !s.fail() ) {
                     _chat.push_back( std::move( msg ) );
                 }
             }
-            else if ( type == MsgType::Kick ) {
+            else if ( type == LobbyMessageType::Lockstep ) {
+                LockstepCommand cmd;
+                s >> cmd;
+                if ( !s.fail() ) {
+                    _lockstep.push_back( std::move( cmd ) );
+                }
+            }
+            else if ( type == LobbyMessageType::FileOffer ) {
+                LobbyFileOffer offer;
+                s >> offer;
+                if ( !s.fail() ) {
+                    _processFileOffer( std::move( offer ) );
+                }
+            }
+            else if ( type == LobbyMessageType::FileChunk ) {
+                uint32_t transferId = 0;
+                uint32_t index = 0;
+                std::vector<uint8_t> data;
+                s >> transferId >> index >> data;
+                if ( !s.fail() ) {
+                    _processFileChunk( transferId, index, data );
+                }
+            }
+            else if ( type == LobbyMessageType::Kick ) {
                 std::string reason;
                 s >> reason;
-                _chat.push_back( LobbyChatMessage{ _nowMs(), "system", "Kicked: " + reason } );
                 disconnect();
-                return;
+                _chat.push_back( LobbyChatMessage{ _nowMs(), "system", "Kicked: " + reason } );
+                return false;
+            }
+        }
+    }
+
+    void LanLobbyClient::_processFileOffer( LobbyFileOffer offer )
+    {
+        if ( _downloadDirectory.empty() ) {
+            return;
+        }
+
+        const uint32_t transferId = offer.transferId;
+        const std::string name = offer.name;
+
+        LobbyFileSink sink;
+        if ( !sink.open( _downloadDirectory, std::move( offer ) ) ) {
+            _downloads.erase( transferId );
+            _chat.push_back( LobbyChatMessage{ _nowMs(), "system", "Unable to download " + name } );
+            return;
+        }
+
+        _requestFile( transferId, sink.nextChunk() );
+
+        if ( sink.isComplete() ) {
+            _downloads.erase( transferId );
+            _receivedFiles.push_back( LobbyReceivedFile{ name, sink.path() } );
+            return;
+        }
+
+        _downloads[transferId] = std::move( sink );
+    }
+
+    void LanLobbyClient::_processFileChunk( const uint32_t transferId, const uint32_t index, const std::vector<uint8_t> & data )
+    {
+        const auto download = _downloads.find( transferId );
+        if ( download == _downloads.end() ) {
+            return;
+        }
+
+        LobbyFileSink & sink = download->second;
+
+        switch ( sink.write( index, data.data(), data.size() ) ) {
+        case LobbyFileSink::Result::Accepted:
+        case LobbyFileSink::Result::Ignored:
+            break;
+        case LobbyFileSink::Result::Completed:
+            _requestFile( transferId, sink.nextChunk() );
+            _receivedFiles.push_back( LobbyReceivedFile{ sink.offer().name, sink.path() } );
+            _downloads.erase( download );
+            break;
+        case LobbyFileSink::Result::Failed:
+            // The partial file is gone, the download starts over.
+            DEBUG_LOG( DBG_NETWORK, DBG_WARN, "Failed to receive chunk " << index << " of " << sink.offer().name << ", restarting the download" )
+            _processFileOffer( sink.offer() );
+            break;
+        default:
+            assert( 0 );
+            break;
+        }
+    }
+
+    void LanLobbyClient::_requestFile( const uint32_t transferId, const uint32_t firstChunk )
+    {
+        std::vector<uint8_t> frame = buildLobbyFrame( _framePool, LobbyMessageType::FileRequest, [transferId, firstChunk]( OStreamBase & buf ) {
+            buf << transferId;
+            buf << firstChunk;
+        } );
+        _sendFrame( frame );
+        _framePool.release( std::move( frame ) );
+    }
+
+    void LanLobbyClient::_sendFrame( const std::vector<uint8_t> & frame )
+    {
+        const std::vector<uint8_t> * toSend = &frame;
+
+        std::vector<uint8_t> compressed;
+        if ( _hostRevision >= lobbyCompressionRevision ) {
+            compressed = compressLobbyFrame( _framePool, frame );
+            if ( !compressed.empty() ) {
+                toSend = &compressed;
             }
         }
+
+        _tx.insert( _tx.end(), toSend->begin(), toSend->end() );
+        _meter.addSentFrame( toSend->size() );
+
+        if ( !compressed.empty() ) {
+            _framePool.release( std::move( compressed ) );
+        }
     }
 
-    void LanLobbyClient::_sendPacket( Socket & socket, const std::vector<uint8_t> & packet )
+    bool LanLobbyClient::_flush()
     {
-        RWStreamBuf framed;
-        framed.putLE32( static_cast<uint32_t>( packet.size() ) );
-        framed.putRaw( packet.data(), packet.size() );
-        const auto view = framed.getRawView( framed.size() );
-        socket.send( view.first, view.second );
+        while ( _txOffset < _tx.size() ) {
+            const int sent = _tcp.send( _tx.data() + _txOffset, _tx.size() - _txOffset );
+            if ( sent < 0 ) {
+                disconnect();
+                return true;
+            }
+            if ( sent == 0 ) {
+                return false;
+            }
+
+            _txOffset += static_cast<size_t>( sent );
+        }
+
+        _tx.clear();
+        _txOffset = 0;
+
+        return true;
     }
 
     uint64_t LanLobbyClient::_nowMs()
@@ -2,10 +2,15 @@
 
 #include <cstdint>
 #include <deque>
+#include <map>
 #include <optional>
+#include <set>
 #include <string>
 #include <vector>
 
+#include "lobby_file_transfer.h"
+#include "lobby_frame.h"
+#include "lockstep.h"
 #include "socket.h"
 
 namespace Network
@@ -28,6 +33,13 @@ namespace Network
         uint32_t protocolVersion{ 1 };
     };
 
+    // The port a lobby relay server (see LobbyRelayServer) listens on by default.
+    constexpr uint16_t lobbyRelayDefaultPort = 26368;
+
+    // Describes a lobby on a relay server to be passed to LanLobbyClient::connectToHost(). Relay lobbies are identified by their
+    // name: the first player joining a lobby with a given name creates it, the others join it.
+    LobbyHostInfo getRelayLobbyInfo( const IpEndpoint & relay, const std::string & lobbyName );
+
     struct LobbyChatMessage
     {
         uint64_t timestampMs{ 0 };
@@ -35,6 +47,61 @@ namespace Network
         std::string text;
     };
 
+    // Quality of a lobby connection, refreshed once per ping interval.
+    struct LobbyConnectionStats
+    {
+        // Player name on the host side, the host address on the client side.
+        std::string name;
+        // Smoothed round-trip time, 0 until the first ping is answered.
+        uint32_t rttMs{ 0 };
+        uint64_t bytesIn{ 0 };
+        uint64_t bytesOut{ 0 };
+        uint32_t framesInPerSecond{ 0 };
+        uint32_t framesOutPerSecond{ 0 };
+        // Outgoing data not accepted by the socket yet.
+        size_t queuedBytes{ 0 };
+    };
+
+    // Counts the traffic of a connection and measures its round-trip time from ping/pong exchanges.
+    class LobbyConnectionMeter
+    {
+    public:
+        void addReceived( const size_t bytes )
+        {
+            _stats.bytesIn += bytes;
+        }
+
+        void addReceivedFrame()
+        {
+            ++_framesIn;
+        }
+
+        void addSentFrame( const size_t bytes )
+        {
+            _stats.bytesOut += bytes;
+            ++_framesOut;
+        }
+
+        void addPong( const uint64_t pingTimestampMs, const uint64_t nowMs );
+
+        // Recomputes the frame rates over the time passed since the previous call.
+        void update( const uint64_t nowMs );
+
+        const LobbyConnectionStats & stats() const
+        {
+            return _stats;
+        }
+
+    private:
+        LobbyConnectionStats _stats;
+
+        uint64_t _framesIn{ 0 };
+        uint64_t _framesOut{ 0 };
+        uint64_t _lastFramesIn{ 0 };
+        uint64_t _lastFramesOut{ 0 };
+        uint64_t _lastUpdateMs{ 0 };
+    };
+
     // Host-side lobby (LAN only): advertises via UDP broadcast and accepts TCP clients.
     class LanLobbyHost
     {
@@ -50,7 +117,9 @@ namespace Network
         LobbyPrivacy privacy() const;
         const std::string & inviteCode() const;
 
-        void pump(); // call periodically from main loop
+        // Call periodically from the main loop. Only sockets with pending data are serviced. A non-zero timeout
+        // allows to sleep until there is network activity (the wait is cut short when the next advertisement is due).
+        void pump( const uint32_t timeoutMs = 0 );
 
         // Messages to show in host UI (includes host and clients).
         std::optional<LobbyChatMessage> popChat();
@@ -58,6 +127,25 @@ namespace Network
         // Add a message from host; broadcast to all connected clients.
         void sendChatFromHost( const std::string & text );
 
+        // Lockstep commands of the game session. Commands received from a client are relayed to all other clients.
+        void sendLockstep( const LockstepCommand & cmd );
+        std::optional<LockstepCommand> popLockstep();
+
+        // Statistics of all joined clients, available once per ping interval. They are also written to the debug log.
+        std::optional<std::vector<LobbyConnectionStats>> popConnectionStats();
+
+        // Offers a file, like the map or the saved game to be played, to all players including those joining later.
+        // Clients already having the same file skip the download, the others receive it in chunks streamed alongside
+        // the other messages and resume an interrupted download from the first missing chunk. Returns the transfer id,
+        // 0 if the file cannot be offered.
+        uint32_t offerFile( const std::string & name, std::vector<uint8_t> content );
+
+        // Stops streaming the file. Partial downloads are kept by clients for a later offer of the same file.
+        void withdrawFile( const uint32_t transferId );
+
+        // Whether all joined players have the file.
+        bool isFileDelivered( const uint32_t transferId ) const;
+
     private:
         struct Client
         {
@@ -65,7 +153,18 @@ namespace Network
             IpEndpoint endpoint;
             std::string name;
             bool joined{ false };
-            std::vector<uint8_t> rx;
+            uint32_t protocolRevision{ 1 };
+            FrameDecoder rx{ maxLobbyFrameSize };
+            LobbyConnectionMeter meter;
+
+            // Frames queued since the last flush, followed by the data the socket did not accept yet. Frames are not sent
+            // one by one, the queue is flushed once per pump() so small messages share TCP segments.
+            std::vector<uint8_t> tx;
+            size_t txOffset{ 0 };
+
+            // Offered files being streamed to the client: transfer id and the next chunk to send.
+            std::map<uint32_t, uint32_t> fileStreams;
+            std::set<uint32_t> receivedFiles;
         };
 
         bool _running{ false };
@@ -82,15 +181,42 @@ namespace Network
         std::string _hostPlayerName;
 
         uint64_t _lastAdvertiseMs{ 0 };
+        uint64_t _lastPingMs{ 0 };
+        std::optional<std::vector<LobbyConnectionStats>> _connectionStats;
         std::deque<LobbyChatMessage> _chat;
+        std::deque<LockstepCommand> _lockstep;
         std::vector<Client> _clients;
 
+        std::map<uint32_t, LobbyFileSource> _files;
+        uint32_t _nextTransferId{ 1 };
+
+        SocketPoller _poller;
+        FramePool _framePool;
+
         void _advertise();
+        void _pingClients();
         void _acceptClients();
         void _pumpClient( Client & client );
+        // Returns false if the client got disconnected.
+        bool _processClientFrames( Client & client );
+
+        void _sendFileOffer( Client & client, const LobbyFileOffer & offer );
+        void _processFileRequest( Client & client, const uint32_t transferId, const uint32_t firstChunk );
+        // Queues the next chunks of all transfers as long as the client queue is short. Returns true if some chunks
+        // are still to be sent.
+        bool _streamFiles();
+
+        // Frames are compressed for the clients supporting it. The client to skip can be nullptr.
+        void _broadcastFrame( const std::vector<uint8_t> & frame, const Client * except = nullptr );
+        void _sendFrame( Client & client, const std::vector<uint8_t> & frame );
+
+        // Appends the frame as is to the client queue. Returns false if the client got disconnected.
+        static bool _queueFrame( Client & client, const uint8_t * data, const size_t size );
 
-        void _broadcastPacket( const std::vector<uint8_t> & packet );
-        void _sendPacket( Socket & socket, const std::vector<uint8_t> & packet );
+        // Return true if some data could not be sent yet.
+        bool _flushClients();
+        // Returns false if the client got disconnected.
+        static bool _flushClient( Client & client );
 
         static uint64_t _nowMs();
         static uint64_t _randomU64();
@@ -114,9 +240,25 @@ namespace Network
 
         void pumpConnection();
 
+        // Services both discovery and the connection. A non-zero timeout allows to sleep until there is network activity.
+        void pump( const uint32_t timeoutMs = 0 );
+
         void sendChat( const std::string & text );
         std::optional<LobbyChatMessage> popChat();
 
+        void sendLockstep( const LockstepCommand & cmd );
+        std::optional<LockstepCommand> popLockstep();
+
+        // Statistics of the connection to the host, available once per ping interval. They are also written to the debug log.
+        std::optional<LobbyConnectionStats> popConnectionStats();
+
+        // Files offered by the host are downloaded into this directory, see LanLobbyHost::offerFile(). Offers are
+        // ignored until the directory is set.
+        void setDownloadDirectory( std::string directory );
+
+        // Files which are complete, either downloaded or already present.
+        std::optional<LobbyReceivedFile> popReceivedFile();
+
     private:
         SocketSubsystem _subsystem;
 
@@ -126,16 +268,44 @@ namespace Network
 
         Socket _tcp{ Socket::Type::TCP };
         bool _connected{ false };
-        std::vector<uint8_t> _rx;
+        FrameDecoder _rx{ maxLobbyFrameSize };
         std::deque<LobbyChatMessage> _chat;
+        std::deque<LockstepCommand> _lockstep;
+
+        // Frames queued since the last flush, see LanLobbyHost::Client::tx.
+        std::vector<uint8_t> _tx;
+        size_t _txOffset{ 0 };
+        uint32_t _hostRevision{ 1 };
+
+        std::string _hostAddress;
+        LobbyConnectionMeter _meter;
+        uint64_t _lastPingMs{ 0 };
+        std::optional<LobbyConnectionStats> _connectionStats;
+
+        std::string _downloadDirectory;
+        std::map<uint32_t, LobbyFileSink> _downloads;
+        std::deque<LobbyReceivedFile> _receivedFiles;
 
         std::string _playerName;
         std::string _inviteCode;
 
+        SocketPoller _poller;
+        FramePool _framePool;
+
         void _pumpUdp();
         void _pumpTcp();
-
-        void _sendPacket( Socket & socket, const std::vector<uint8_t> & packet );
+        void _pingHost();
+        // Returns false if the connection got closed.
+        bool _processFrames();
+
+        void _processFileOffer( LobbyFileOffer offer );
+        void _processFileChunk( const uint32_t transferId, const uint32_t index, const std::vector<uint8_t> & data );
+        void _requestFile( const uint32_t transferId, const uint32_t firstChunk );
+
+        // Queues the frame, compressed if the host supports it.
+        void _sendFrame( const std::vector<uint8_t> & frame );
+        // Returns false if some data could not be sent yet.
+        bool _flush();
 
         static uint64_t _nowMs();
     };
@@ -0,0 +1,427 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "lan_lobby_worker.h"
+
+#include <cassert>
+#include <mutex>
+#include <utility>
+
+namespace
+{
+    // How long a worker iteration may sleep waiting for network activity. This also bounds the delay of outgoing chat messages.
+    constexpr uint32_t workerWaitMs = 20;
+
+    constexpr size_t incomingChatQueueSize = 256;
+    constexpr size_t outgoingChatQueueSize = 64;
+    constexpr size_t lockstepQueueSize = 256;
+    constexpr size_t discoveredQueueSize = 64;
+    constexpr size_t connectionStatsQueueSize = 4;
+    constexpr size_t receivedFileQueueSize = 16;
+
+#if defined( __EMSCRIPTEN__ ) && !defined( __EMSCRIPTEN_PTHREADS__ )
+    constexpr bool hasWorkerThread = false;
+#else
+    constexpr bool hasWorkerThread = true;
+#endif
+}
+
+namespace Network
+{
+    LanLobbyWorker::LanLobbyWorker()
+        : _incomingChat( incomingChatQueueSize )
+        , _outgoingChat( outgoingChatQueueSize )
+        , _incomingLockstep( lockstepQueueSize )
+        , _outgoingLockstep( lockstepQueueSize )
+        , _connectionStats( connectionStatsQueueSize )
+    {}
+
+    std::optional<LobbyChatMessage> LanLobbyWorker::popChat()
+    {
+        if constexpr ( !hasWorkerThread ) {
+            // Without threads the work is done on the UI thread, one non-blocking iteration per call.
+            if ( _isActive ) {
+                executeTask();
+            }
+        }
+
+        return _incomingChat.pop();
+    }
+
+    bool LanLobbyWorker::sendLockstep( LockstepCommand cmd )
+    {
+        return _outgoingLockstep.push( std::move( cmd ) );
+    }
+
+    std::optional<LockstepCommand> LanLobbyWorker::popLockstep()
+    {
+        return _incomingLockstep.pop();
+    }
+
+    std::optional<std::vector<LobbyConnectionStats>> LanLobbyWorker::popConnectionStats()
+    {
+        // Only the latest statistics are of interest.
+        std::optional<std::vector<LobbyConnectionStats>> latest;
+        while ( std::optional<std::vector<LobbyConnectionStats>> stats = _connectionStats.pop() ) {
+            latest = std::move( stats );
+        }
+        return latest;
+    }
+
+    bool LanLobbyWorker::queueChat( std::string text )
+    {
+        return _outgoingChat.push( std::move( text ) );
+    }
+
+    void LanLobbyWorker::pause()
+    {
+        stopWorker();
+
+        _isActive = false;
+    }
+
+    void LanLobbyWorker::resume()
+    {
+        _isActive = true;
+
+        if constexpr ( hasWorkerThread ) {
+            createWorker();
+
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
+            notifyWorker();
+        }
+    }
+
+    void LanLobbyWorker::resetQueues()
+    {
+        assert( !_isActive );
+
+        while ( _incomingChat.pop() ) {
+            // Do nothing.
+        }
+        while ( _outgoingChat.pop() ) {
+            // Do nothing.
+        }
+        while ( _incomingLockstep.pop() ) {
+            // Do nothing.
+        }
+        while ( _outgoingLockstep.pop() ) {
+            // Do nothing.
+        }
+        while ( _connectionStats.pop() ) {
+            // Do nothing.
+        }
+
+        _pendingChat.clear();
+        _pendingLockstep.clear();
+    }
+
+    void LanLobbyWorker::deliverChat( LobbyChatMessage && msg )
+    {
+        if ( _pendingChat.empty() && _incomingChat.push( std::move( msg ) ) ) {
+            return;
+        }
+
+        _pendingChat.push_back( std::move( msg ) );
+    }
+
+    void LanLobbyWorker::deliverLockstep( LockstepCommand && cmd )
+    {
+        if ( _pendingLockstep.empty() && _incomingLockstep.push( std::move( cmd ) ) ) {
+            return;
+        }
+
+        // Lockstep commands must never be dropped, the game would desync.
+        _pendingLockstep.push_back( std::move( cmd ) );
+    }
+
+    void LanLobbyWorker::deliverConnectionStats( std::vector<LobbyConnectionStats> && stats )
+    {
+        _connectionStats.push( std::move( stats ) );
+    }
+
+    bool LanLobbyWorker::prepareTask()
+    {
+        // The lobby is serviced continuously until the worker is stopped.
+        return true;
+    }
+
+    void LanLobbyWorker::sendQueuedLockstep()
+    {
+        while ( std::optional<LockstepCommand> cmd = _outgoingLockstep.pop() ) {
+            sendLockstepToLobby( *cmd );
+        }
+    }
+
+    void LanLobbyWorker::executeTask()
+    {
+        sendQueuedLockstep();
+        while ( std::optional<std::string> text = _outgoingChat.pop() ) {
+            sendChatToLobby( *text );
+        }
+
+        pumpLobby( hasWorkerThread ? workerWaitMs : 0 );
+
+        _flushPending();
+    }
+
+    void LanLobbyWorker::_flushPending()
+    {
+        while ( !_pendingChat.empty() && _incomingChat.push( std::move( _pendingChat.front() ) ) ) {
+            _pendingChat.pop_front();
+        }
+        while ( !_pendingLockstep.empty() && _incomingLockstep.push( std::move( _pendingLockstep.front() ) ) ) {
+            _pendingLockstep.pop_front();
+        }
+    }
+
+    LanLobbyHostWorker::~LanLobbyHostWorker()
+    {
+        stopWorker();
+    }
+
+    bool LanLobbyHostWorker::start( const std::string & lobbyName, const std::string & hostPlayerName, LobbyPrivacy privacy, const std::string & inviteCode )
+    {
+        pause();
+        resetQueues();
+
+        if ( !_host.start( lobbyName, hostPlayerName, privacy, inviteCode ) ) {
+            return false;
+        }
+
+        resume();
+
+        return true;
+    }
+
+    void LanLobbyHostWorker::stop()
+    {
+        pause();
+
+        _host.stop();
+
+        resetQueues();
+    }
+
+    uint32_t LanLobbyHostWorker::offerFile( const std::string & name, std::vector<uint8_t> content )
+    {
+        pause();
+
+        const uint32_t transferId = _host.offerFile( name, std::move( content ) );
+
+        if ( _host.isRunning() ) {
+            resume();
+        }
+
+        return transferId;
+    }
+
+    void LanLobbyHostWorker::withdrawFile( const uint32_t transferId )
+    {
+        pause();
+
+        _host.withdrawFile( transferId );
+
+        if ( _host.isRunning() ) {
+            resume();
+        }
+    }
+
+    bool LanLobbyHostWorker::isFileDelivered( const uint32_t transferId )
+    {
+        pause();
+
+        const bool isDelivered = _host.isFileDelivered( transferId );
+
+        if ( _host.isRunning() ) {
+            resume();
+        }
+
+        return isDelivered;
+    }
+
+    void LanLobbyHostWorker::pumpLobby( const uint32_t timeoutMs )
+    {
+        _host.pump( timeoutMs );
+
+        while ( std::optional<LobbyChatMessage> msg = _host.popChat() ) {
+            deliverChat( std::move( *msg ) );
+        }
+        while ( std::optional<LockstepCommand> cmd = _host.popLockstep() ) {
+            deliverLockstep( std::move( *cmd ) );
+        }
+
+        if ( std::optional<std::vector<LobbyConnectionStats>> stats = _host.popConnectionStats() ) {
+            deliverConnectionStats( std::move( *stats ) );
+        }
+    }
+
+    void LanLobbyHostWorker::sendChatToLobby( const std::string & text )
+    {
+        _host.sendChatFromHost( text );
+    }
+
+    void LanLobbyHostWorker::sendLockstepToLobby( const LockstepCommand & cmd )
+    {
+        _host.sendLockstep( cmd );
+    }
+
+    LanLobbyClientWorker::LanLobbyClientWorker()
+        : _discovered( discoveredQueueSize )
+        , _receivedFiles( receivedFileQueueSize )
+    {}
+
+    LanLobbyClientWorker::~LanLobbyClientWorker()
+    {
+        stopWorker();
+    }
+
+    void LanLobbyClientWorker::startDiscovery()
+    {
+        pause();
+
+        _client.startDiscovery();
+        _isDiscovering = true;
+
+        _resumeIfNeeded();
+    }
+
+    void LanLobbyClientWorker::stopDiscovery()
+    {
+        pause();
+
+        _client.stopDiscovery();
+        _isDiscovering = false;
+
+        while ( _discovered.pop() ) {
+            // Do nothing.
+        }
+
+        _resumeIfNeeded();
+    }
+
+    std::vector<LobbyHostInfo> LanLobbyClientWorker::drainDiscovered()
+    {
+        std::vector<LobbyHostInfo> out;
+        while ( std::optional<LobbyHostInfo> info = _discovered.pop() ) {
+            out.push_back( std::move( *info ) );
+        }
+        return out;
+    }
+
+    bool LanLobbyClientWorker::connectToHost( const LobbyHostInfo & host, const std::string & playerName, const std::string & inviteCode )
+    {
+        pause();
+        resetQueues();
+        _resetReceivedFiles();
+
+        const bool connected = _client.connectToHost( host, playerName, inviteCode );
+        _isConnected = connected;
+
+        _resumeIfNeeded();
+
+        return connected;
+    }
+
+    void LanLobbyClientWorker::disconnect()
+    {
+        pause();
+
+        _client.disconnect();
+        _isConnected = false;
+
+        resetQueues();
+        _resetReceivedFiles();
+
+        _resumeIfNeeded();
+    }
+
+    void LanLobbyClientWorker::setDownloadDirectory( std::string directory )
+    {
+        pause();
+
+        _client.setDownloadDirectory( std::move( directory ) );
+
+        _resumeIfNeeded();
+    }
+
+    std::optional<LobbyReceivedFile> LanLobbyClientWorker::popReceivedFile()
+    {
+        return _receivedFiles.pop();
+    }
+
+    void LanLobbyClientWorker::pumpLobby( const uint32_t timeoutMs )
+    {
+        _client.pump( timeoutMs );
+
+        for ( LobbyHostInfo & info : _client.drainDiscovered() ) {
+            // Hosts advertise themselves every second so it is fine to drop an announcement if the UI is lagging behind.
+            _discovered.push( std::move( info ) );
+        }
+
+        while ( std::optional<LobbyChatMessage> msg = _client.popChat() ) {
+            deliverChat( std::move( *msg ) );
+        }
+
+        while ( std::optional<LockstepCommand> cmd = _client.popLockstep() ) {
+            deliverLockstep( std::move( *cmd ) );
+        }
+
+        if ( std::optional<LobbyConnectionStats> stats = _client.popConnectionStats() ) {
+            deliverConnectionStats( { std::move( *stats ) } );
+        }
+
+        while ( std::optional<LobbyReceivedFile> file = _client.popReceivedFile() ) {
+            _pendingReceivedFiles.push_back( std::move( *file ) );
+        }
+        while ( !_pendingReceivedFiles.empty() && _receivedFiles.push( std::move( _pendingReceivedFiles.front() ) ) ) {
+            _pendingReceivedFiles.pop_front();
+        }
+
+        _isConnected = _client.isConnected();
+    }
+
+    void LanLobbyClientWorker::sendChatToLobby( const std::string & text )
+    {
+        _client.sendChat( text );
+    }
+
+    void LanLobbyClientWorker::sendLockstepToLobby( const LockstepCommand & cmd )
+    {
+        _client.sendLockstep( cmd );
+    }
+
+    void LanLobbyClientWorker::_resetReceivedFiles()
+    {
+        while ( _receivedFiles.pop() ) {
+            // Do nothing.
+        }
+
+        _pendingReceivedFiles.clear();
+    }
+
+    void LanLobbyClientWorker::_resumeIfNeeded()
+    {
+        if ( _isDiscovering || _isConnected ) {
+            resume();
+        }
+    }
+}
@@ -0,0 +1,191 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "lan_lobby.h"
+#include "thread.h"
+
+namespace Network
+{
+    // Services a LAN lobby on a background thread, so TCP buffers are drained and chat is relayed no matter how
+    // busy the UI thread is. Parsed chat messages are handed over to the UI thread through lock-free queues.
+    //
+    // All public methods must be called from the UI thread. Calls changing the lobby state (start, connect, ...)
+    // pause the worker for their duration, so the lobby object is never accessed by both threads at once.
+    class LanLobbyWorker : public MultiThreading::AsyncManager
+    {
+    public:
+        LanLobbyWorker( const LanLobbyWorker & ) = delete;
+
+        ~LanLobbyWorker() override = default;
+
+        LanLobbyWorker & operator=( const LanLobbyWorker & ) = delete;
+
+        std::optional<LobbyChatMessage> popChat();
+
+        // Lockstep commands of the game session, see LockstepSession. Returns false if the outgoing queue is full.
+        bool sendLockstep( LockstepCommand cmd );
+        std::optional<LockstepCommand> popLockstep();
+
+        // Connection statistics refreshed since the last call, see LanLobbyHost::popConnectionStats().
+        std::optional<std::vector<LobbyConnectionStats>> popConnectionStats();
+
+    protected:
+        LanLobbyWorker();
+
+        // Returns false if the outgoing queue is full.
+        bool queueChat( std::string text );
+
+        void pause();
+        void resume();
+
+        // Drops all messages in flight. The worker must be paused.
+        void resetQueues();
+
+        // Sends the queued outgoing lockstep commands. The worker must be paused.
+        void sendQueuedLockstep();
+
+        // Called on the worker thread (or on the UI thread when threads are not available). Should not block longer than the given timeout.
+        virtual void pumpLobby( const uint32_t timeoutMs ) = 0;
+        virtual void sendChatToLobby( const std::string & text ) = 0;
+        virtual void sendLockstepToLobby( const LockstepCommand & cmd ) = 0;
+
+        // Called from pumpLobby() to pass a message to the UI thread.
+        void deliverChat( LobbyChatMessage && msg );
+        void deliverLockstep( LockstepCommand && cmd );
+        // Statistics are dropped if the UI thread does not keep up, the next refresh replaces them anyway.
+        void deliverConnectionStats( std::vector<LobbyConnectionStats> && stats );
+
+    private:
+        MultiThreading::SpscQueue<LobbyChatMessage> _incomingChat;
+        MultiThreading::SpscQueue<std::string> _outgoingChat;
+
+        MultiThreading::SpscQueue<LockstepCommand> _incomingLockstep;
+        MultiThreading::SpscQueue<LockstepCommand> _outgoingLockstep;
+
+        MultiThreading::SpscQueue<std::vector<LobbyConnectionStats>> _connectionStats;
+
+        // Messages which did not fit into the incoming queues. Accessed only by the worker.
+        std::deque<LobbyChatMessage> _pendingChat;
+        std::deque<LockstepCommand> _pendingLockstep;
+
+        bool _isActive{ false };
+
+        bool prepareTask() override;
+        void executeTask() override;
+
+        void _flushPending();
+    };
+
+    class LanLobbyHostWorker final : public LanLobbyWorker
+    {
+    public:
+        LanLobbyHostWorker() = default;
+
+        ~LanLobbyHostWorker() override;
+
+        bool start( const std::string & lobbyName, const std::string & hostPlayerName, LobbyPrivacy privacy, const std::string & inviteCode );
+        void stop();
+
+        bool isRunning() const
+        {
+            return _host.isRunning();
+        }
+
+        uint16_t tcpPort() const
+        {
+            return _host.tcpPort();
+        }
+
+        void sendChatFromHost( std::string text )
+        {
+            queueChat( std::move( text ) );
+        }
+
+        // See LanLobbyHost::offerFile().
+        uint32_t offerFile( const std::string & name, std::vector<uint8_t> content );
+        void withdrawFile( const uint32_t transferId );
+        bool isFileDelivered( const uint32_t transferId );
+
+    private:
+        LanLobbyHost _host;
+
+        void pumpLobby( const uint32_t timeoutMs ) override;
+        void sendChatToLobby( const std::string & text ) override;
+        void sendLockstepToLobby( const LockstepCommand & cmd ) override;
+    };
+
+    class LanLobbyClientWorker final : public LanLobbyWorker
+    {
+    public:
+        LanLobbyClientWorker();
+
+        ~LanLobbyClientWorker() override;
+
+        void startDiscovery();
+        void stopDiscovery();
+
+        std::vector<LobbyHostInfo> drainDiscovered();
+
+        bool connectToHost( const LobbyHostInfo & host, const std::string & playerName, const std::string & inviteCode );
+        void disconnect();
+
+        bool isConnected() const
+        {
+            return _isConnected;
+        }
+
+        // See LanLobbyClient::setDownloadDirectory().
+        void setDownloadDirectory( std::string directory );
+        std::optional<LobbyReceivedFile> popReceivedFile();
+
+        void sendChat( std::string text )
+        {
+            queueChat( std::move( text ) );
+        }
+
+    private:
+        LanLobbyClient _client;
+
+        MultiThreading::SpscQueue<LobbyHostInfo> _discovered;
+        MultiThreading::SpscQueue<LobbyReceivedFile> _receivedFiles;
+
+        // Received files which did not fit into the queue. Accessed only by the worker.
+        std::deque<LobbyReceivedFile> _pendingReceivedFiles;
+
+        std::atomic<bool> _isConnected{ false };
+        bool _isDiscovering{ false };
+
+        void pumpLobby( const uint32_t timeoutMs ) override;
+        void sendChatToLobby( const std::string & text ) override;
+        void sendLockstepToLobby( const LockstepCommand & cmd ) override;
+
+        void _resumeIfNeeded();
+        void _resetReceivedFiles();
+    };
+}
@@ -0,0 +1,238 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "lobby_file_transfer.h"
+
+#include <algorithm>
+#include <cstdio>
+
+#include "logging.h"
+#include "serialize.h"
+#include "state_hash.h"
+#include "system.h"
+
+namespace
+{
+    const char * partFileExtension = ".part";
+
+    bool readFile( const std::string & path, std::vector<uint8_t> & data )
+    {
+        StreamFile file;
+        if ( !file.open( path, "rb" ) ) {
+            return false;
+        }
+
+        data = file.getRaw( 0 );
+
+        return !file.fail();
+    }
+
+    bool writeFile( const std::string & path, const char * mode, const uint8_t * data, const size_t size )
+    {
+        StreamFile file;
+        if ( !file.open( path, mode ) ) {
+            return false;
+        }
+
+        file.putRaw( data, size );
+
+        return !file.fail();
+    }
+}
+
+namespace Network
+{
+    size_t LobbyFileOffer::chunkSize( const uint32_t index ) const
+    {
+        if ( index >= chunkCount() ) {
+            return 0;
+        }
+
+        const uint64_t offset = static_cast<uint64_t>( index ) * lobbyFileChunkSize;
+        return static_cast<size_t>( std::min<uint64_t>( lobbyFileChunkSize, size - offset ) );
+    }
+
+    OStreamBase & operator<<( OStreamBase & stream, const LobbyFileOffer & offer )
+    {
+        stream << offer.transferId << std::string_view( offer.name ) << offer.size << offer.digest;
+
+        stream.put32( offer.chunkCount() );
+        for ( const uint64_t digest : offer.chunkDigests ) {
+            stream << digest;
+        }
+
+        return stream;
+    }
+
+    IStreamBase & operator>>( IStreamBase & stream, LobbyFileOffer & offer )
+    {
+        stream >> offer.transferId >> offer.name >> offer.size >> offer.digest;
+
+        const uint32_t chunkCount = stream.get32();
+        const uint64_t expectedChunkCount = ( offer.size + lobbyFileChunkSize - 1 ) / lobbyFileChunkSize;
+
+        if ( offer.size > maxLobbyFileSize || chunkCount != expectedChunkCount ) {
+            stream.setFail();
+            return stream;
+        }
+
+        offer.chunkDigests.resize( chunkCount );
+        for ( uint64_t & digest : offer.chunkDigests ) {
+            stream >> digest;
+        }
+
+        return stream;
+    }
+
+    bool isValidLobbyFileName( const std::string & name )
+    {
+        if ( name.empty() || name == "." || name == ".." ) {
+            return false;
+        }
+
+        return std::none_of( name.begin(), name.end(), []( const char c ) { return c == '/' || c == '\\' || c == ':' || static_cast<unsigned char>( c ) < 0x20; } );
+    }
+
+    LobbyFileSource::LobbyFileSource( const uint32_t transferId, std::string name, std::vector<uint8_t> content )
+        : _content( std::move( content ) )
+    {
+        _offer.transferId = transferId;
+        _offer.name = std::move( name );
+        _offer.size = _content.size();
+        _offer.digest = getDigest( _content );
+
+        for ( size_t offset = 0; offset < _content.size(); offset += lobbyFileChunkSize ) {
+            _offer.chunkDigests.push_back( getDigest( _content.data() + offset, std::min( lobbyFileChunkSize, _content.size() - offset ) ) );
+        }
+    }
+
+    std::pair<const uint8_t *, size_t> LobbyFileSource::chunk( const uint32_t index ) const
+    {
+        const size_t size = _offer.chunkSize( index );
+        if ( size == 0 ) {
+            return { nullptr, 0 };
+        }
+
+        return { _content.data() + static_cast<size_t>( index ) * lobbyFileChunkSize, size };
+    }
+
+    bool LobbyFileSink::open( const std::string & directory, LobbyFileOffer offer )
+    {
+        if ( !isValidLobbyFileName( offer.name ) || offer.size == 0 || offer.size > maxLobbyFileSize ) {
+            return false;
+        }
+
+        _offer = std::move( offer );
+        _path = System::concatPath( directory, _offer.name );
+        _partPath = _path + partFileExtension;
+        _nextChunk = 0;
+
+        std::vector<uint8_t> data;
+
+        if ( System::IsFile( _path ) ) {
+            if ( readFile( _path, data ) && data.size() == _offer.size && getDigest( data ) == _offer.digest ) {
+                _nextChunk = _offer.chunkCount();
+                return true;
+            }
+
+            DEBUG_LOG( DBG_NETWORK, DBG_WARN, "A different file " << _path << " already exists, it is not going to be overwritten" )
+            return false;
+        }
+
+        if ( System::IsFile( _partPath ) && readFile( _partPath, data ) ) {
+            _nextChunk = _countValidChunks( data );
+
+            if ( _nextChunk > 0 ) {
+                DEBUG_LOG( DBG_NETWORK, DBG_INFO, "Resuming the download of " << _offer.name << " from chunk " << _nextChunk << " of " << _offer.chunkCount() )
+            }
+        }
+
+        // Anything after the valid chunks is discarded.
+        const size_t validSize = std::min( data.size(), static_cast<size_t>( _nextChunk ) * lobbyFileChunkSize );
+        if ( !writeFile( _partPath, "wb", data.data(), validSize ) ) {
+            return false;
+        }
+
+        if ( isComplete() ) {
+            return _finish();
+        }
+
+        return true;
+    }
+
+    LobbyFileSink::Result LobbyFileSink::write( const uint32_t index, const uint8_t * data, const size_t size )
+    {
+        if ( index != _nextChunk || isComplete() ) {
+            return Result::Ignored;
+        }
+
+        if ( size != _offer.chunkSize( index ) || getDigest( data, size ) != _offer.chunkDigests[index] || !writeFile( _partPath, "ab", data, size ) ) {
+            System::Unlink( _partPath );
+            _nextChunk = 0;
+            return Result::Failed;
+        }
+
+        ++_nextChunk;
+
+        if ( !isComplete() ) {
+            return Result::Accepted;
+        }
+
+        return _finish() ? Result::Completed : Result::Failed;
+    }
+
+    uint32_t LobbyFileSink::_countValidChunks( const std::vector<uint8_t> & data ) const
+    {
+        uint32_t count = 0;
+
+        while ( count < _offer.chunkCount() ) {
+            const size_t offset = static_cast<size_t>( count ) * lobbyFileChunkSize;
+            const size_t size = _offer.chunkSize( count );
+            if ( offset + size > data.size() || getDigest( data.data() + offset, size ) != _offer.chunkDigests[count] ) {
+                break;
+            }
+
+            ++count;
+        }
+
+        return count;
+    }
+
+    bool LobbyFileSink::_finish()
+    {
+        std::vector<uint8_t> data;
+        if ( !readFile( _partPath, data ) || data.size() != _offer.size || getDigest( data ) != _offer.digest ) {
+            DEBUG_LOG( DBG_NETWORK, DBG_WARN, "The downloaded file " << _partPath << " is corrupted" )
+
+            System::Unlink( _partPath );
+            _nextChunk = 0;
+            return false;
+        }
+
+        if ( std::rename( _partPath.c_str(), _path.c_str() ) != 0 ) {
+            ERROR_LOG( "Unable to rename " << _partPath << " to " << _path )
+
+            _nextChunk = 0;
+            return false;
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,139 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+class IStreamBase;
+class OStreamBase;
+
+namespace Network
+{
+    // Files are transferred in chunks, so a transfer never holds up the other lobby messages and can be resumed.
+    constexpr size_t lobbyFileChunkSize = 32 * 1024;
+    constexpr uint64_t maxLobbyFileSize = 64 * 1024 * 1024;
+
+    // Description of a file offered by the lobby host. Every chunk has its own digest, so a partially downloaded file
+    // can be verified and resumed chunk by chunk.
+    struct LobbyFileOffer
+    {
+        uint32_t transferId{ 0 };
+        std::string name;
+        uint64_t size{ 0 };
+        uint64_t digest{ 0 };
+        std::vector<uint64_t> chunkDigests;
+
+        uint32_t chunkCount() const
+        {
+            return static_cast<uint32_t>( chunkDigests.size() );
+        }
+
+        size_t chunkSize( const uint32_t index ) const;
+    };
+
+    OStreamBase & operator<<( OStreamBase & stream, const LobbyFileOffer & offer );
+    IStreamBase & operator>>( IStreamBase & stream, LobbyFileOffer & offer );
+
+    struct LobbyReceivedFile
+    {
+        std::string name;
+        std::string path;
+    };
+
+    // Only plain file names are accepted, a peer must not be able to write outside of the download directory.
+    bool isValidLobbyFileName( const std::string & name );
+
+    // Host side of a transfer: the file is kept in memory for as long as it is offered.
+    class LobbyFileSource
+    {
+    public:
+        LobbyFileSource( const uint32_t transferId, std::string name, std::vector<uint8_t> content );
+
+        const LobbyFileOffer & offer() const
+        {
+            return _offer;
+        }
+
+        std::pair<const uint8_t *, size_t> chunk( const uint32_t index ) const;
+
+    private:
+        LobbyFileOffer _offer;
+        std::vector<uint8_t> _content;
+    };
+
+    // Client side of a transfer. Chunks are appended to a '.part' file next to the destination, so an interrupted
+    // download continues from the first missing chunk on the next offer, even after a restart of the game. A file which
+    // is already present with the same content is not downloaded at all.
+    class LobbyFileSink
+    {
+    public:
+        enum class Result : uint8_t
+        {
+            Accepted,
+            Completed,
+            // Not the chunk expected next, for example one still in flight after the transfer was restarted.
+            Ignored,
+            // The chunk or the assembled file does not match its digest. The partial file is removed.
+            Failed
+        };
+
+        // Returns false if the offer cannot be accepted: an invalid name or size, or a different file with the same name
+        // which is not going to be overwritten.
+        bool open( const std::string & directory, LobbyFileOffer offer );
+
+        const LobbyFileOffer & offer() const
+        {
+            return _offer;
+        }
+
+        const std::string & path() const
+        {
+            return _path;
+        }
+
+        // The first chunk to request. It equals the number of chunks when the file is complete.
+        uint32_t nextChunk() const
+        {
+            return _nextChunk;
+        }
+
+        bool isComplete() const
+        {
+            return _nextChunk == _offer.chunkCount();
+        }
+
+        Result write( const uint32_t index, const uint8_t * data, const size_t size );
+
+    private:
+        LobbyFileOffer _offer;
+        std::string _path;
+        std::string _partPath;
+        uint32_t _nextChunk{ 0 };
+
+        // Returns the number of leading chunks of the data matching the offer.
+        uint32_t _countValidChunks( const std::vector<uint8_t> & data ) const;
+        bool _finish();
+    };
+}
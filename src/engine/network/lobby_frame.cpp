@@ -0,0 +1,304 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "lobby_frame.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#include "zzlib.h"
+
+namespace
+{
+    size_t roundUpToPowerOfTwo( const size_t value )
+    {
+        size_t result = 1;
+        while ( result < value ) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    constexpr size_t maxPooledFrames = 16;
+
+    // Magic number, protocol version, message type and the size of the original packet.
+    constexpr size_t compressedPacketOverhead = 4 + 4 + 1 + 4;
+}
+
+namespace Network
+{
+    FrameDecoder::FrameDecoder( const size_t maxFrameSize )
+        : _maxFrameSize( maxFrameSize )
+    {
+        // Room for the biggest frame guarantees that a full buffer always starts with a complete frame.
+        _buffer.resize( roundUpToPowerOfTwo( maxFrameSize + frameHeaderSize ) );
+    }
+
+    std::pair<uint8_t *, size_t> FrameDecoder::writeRegion()
+    {
+        _releasePending();
+
+        const size_t used = _writePos - _readPos;
+        const size_t offset = _writePos & _mask();
+        const size_t size = std::min( _buffer.size() - used, _buffer.size() - offset );
+
+        return { _buffer.data() + offset, size };
+    }
+
+    void FrameDecoder::commitWrite( const size_t size )
+    {
+        assert( _writePos - _readPos + size <= _buffer.size() );
+
+        _writePos += size;
+    }
+
+    FrameDecoder::Result FrameDecoder::nextFrame( std::pair<const uint8_t *, size_t> & frame )
+    {
+        _releasePending();
+
+        const size_t available = _writePos - _readPos;
+        if ( available < frameHeaderSize ) {
+            return Result::Incomplete;
+        }
+
+        uint8_t header[frameHeaderSize];
+        _copyOut( _readPos, header, frameHeaderSize );
+
+        const size_t frameSize = fheroes2::getLEValue<uint32_t>( reinterpret_cast<const char *>( header ), 0 );
+        if ( frameSize == 0 || frameSize > _maxFrameSize ) {
+            return Result::Invalid;
+        }
+
+        if ( available < frameHeaderSize + frameSize ) {
+            return Result::Incomplete;
+        }
+
+        const size_t bodyPos = _readPos + frameHeaderSize;
+        const size_t bodyOffset = bodyPos & _mask();
+
+        if ( bodyOffset + frameSize <= _buffer.size() ) {
+            frame = { _buffer.data() + bodyOffset, frameSize };
+        }
+        else {
+            _scratch.resize( frameSize );
+            _copyOut( bodyPos, _scratch.data(), frameSize );
+
+            frame = { _scratch.data(), frameSize };
+        }
+
+        _pendingRelease = frameHeaderSize + frameSize;
+
+        return Result::Frame;
+    }
+
+    void FrameDecoder::clear()
+    {
+        _readPos = 0;
+        _writePos = 0;
+        _pendingRelease = 0;
+    }
+
+    void FrameDecoder::_releasePending()
+    {
+        _readPos += _pendingRelease;
+        _pendingRelease = 0;
+
+        if ( _readPos == _writePos ) {
+            // Start over from the beginning to get the biggest contiguous region for the next receive.
+            _readPos = 0;
+            _writePos = 0;
+        }
+    }
+
+    void FrameDecoder::_copyOut( const size_t pos, uint8_t * out, const size_t size ) const
+    {
+        const size_t offset = pos & _mask();
+        const size_t firstPart = std::min( size, _buffer.size() - offset );
+
+        std::memcpy( out, _buffer.data() + offset, firstPart );
+        std::memcpy( out + firstPart, _buffer.data(), size - firstPart );
+    }
+
+    FrameWriter::FrameWriter( std::vector<uint8_t> & out )
+        : _out( out )
+    {
+        // Same byte order as RWStreamBuf so both can be read by ROStreamBuf.
+        setBigendian( IS_BIGENDIAN );
+    }
+
+    void FrameWriter::putBE16( uint16_t v )
+    {
+        put8( v >> 8 );
+        put8( v & 0xFF );
+    }
+
+    void FrameWriter::putLE16( uint16_t v )
+    {
+        put8( v & 0xFF );
+        put8( v >> 8 );
+    }
+
+    void FrameWriter::putBE32( uint32_t v )
+    {
+        put8( v >> 24 );
+        put8( ( v >> 16 ) & 0xFF );
+        put8( ( v >> 8 ) & 0xFF );
+        put8( v & 0xFF );
+    }
+
+    void FrameWriter::putLE32( uint32_t v )
+    {
+        put8( v & 0xFF );
+        put8( ( v >> 8 ) & 0xFF );
+        put8( ( v >> 16 ) & 0xFF );
+        put8( v >> 24 );
+    }
+
+    void FrameWriter::putRaw( const void * ptr, size_t size )
+    {
+        const uint8_t * data = static_cast<const uint8_t *>( ptr );
+
+        _out.insert( _out.end(), data, data + size );
+    }
+
+    void FrameWriter::put8( const uint8_t v )
+    {
+        _out.push_back( v );
+    }
+
+    std::vector<uint8_t> FramePool::acquire()
+    {
+        std::vector<uint8_t> frame;
+        if ( !_free.empty() ) {
+            frame = std::move( _free.back() );
+            _free.pop_back();
+        }
+
+        frame.assign( frameHeaderSize, 0 );
+
+        return frame;
+    }
+
+    void FramePool::finalize( std::vector<uint8_t> & frame )
+    {
+        assert( frame.size() >= frameHeaderSize );
+
+        const uint32_t size = static_cast<uint32_t>( frame.size() - frameHeaderSize );
+
+        frame[0] = static_cast<uint8_t>( size & 0xFF );
+        frame[1] = static_cast<uint8_t>( ( size >> 8 ) & 0xFF );
+        frame[2] = static_cast<uint8_t>( ( size >> 16 ) & 0xFF );
+        frame[3] = static_cast<uint8_t>( size >> 24 );
+    }
+
+    void FramePool::release( std::vector<uint8_t> && frame )
+    {
+        if ( _free.size() < maxPooledFrames ) {
+            _free.push_back( std::move( frame ) );
+        }
+    }
+
+    std::vector<uint8_t> buildLobbyFrame( FramePool & pool, const LobbyMessageType type, const std::function<void( OStreamBase & )> & writeBody )
+    {
+        std::vector<uint8_t> frame = pool.acquire();
+
+        FrameWriter buf( frame );
+        buf << lobbyProtocolMagic;
+        buf << lobbyProtocolVersion;
+        buf << static_cast<uint8_t>( type );
+        writeBody( buf );
+
+        FramePool::finalize( frame );
+
+        return frame;
+    }
+
+    bool parseLobbyHeader( ROStreamBuf & buf, LobbyMessageType & outType )
+    {
+        uint32_t magic = 0;
+        uint32_t version = 0;
+        uint8_t type = 0;
+
+        buf >> magic >> version >> type;
+        if ( buf.fail() ) {
+            return false;
+        }
+
+        if ( magic != lobbyProtocolMagic ) {
+            return false;
+        }
+
+        if ( version != lobbyProtocolVersion ) {
+            return false;
+        }
+
+        outType = static_cast<LobbyMessageType>( type );
+        return true;
+    }
+
+    std::vector<uint8_t> compressLobbyFrame( FramePool & pool, const std::vector<uint8_t> & frame )
+    {
+        assert( frame.size() >= frameHeaderSize );
+
+        const uint8_t * packet = frame.data() + frameHeaderSize;
+        const size_t packetSize = frame.size() - frameHeaderSize;
+
+        if ( packetSize < lobbyCompressionThreshold ) {
+            return {};
+        }
+
+        const std::vector<uint8_t> zipped = Compression::zipData( packet, packetSize );
+        // The Compressed packet adds its own header and the original size.
+        if ( zipped.empty() || zipped.size() + compressedPacketOverhead >= packetSize ) {
+            return {};
+        }
+
+        return buildLobbyFrame( pool, LobbyMessageType::Compressed, [packetSize, &zipped]( OStreamBase & buf ) {
+            buf << static_cast<uint32_t>( packetSize );
+            buf.putRaw( zipped.data(), zipped.size() );
+        } );
+    }
+
+    bool unwrapLobbyPacket( std::pair<const uint8_t *, size_t> & packet, std::vector<uint8_t> & storage )
+    {
+        ROStreamBuf buf( packet.first, packet.second );
+
+        LobbyMessageType type{};
+        if ( !parseLobbyHeader( buf, type ) || type != LobbyMessageType::Compressed ) {
+            return true;
+        }
+
+        uint32_t packetSize = 0;
+        buf >> packetSize;
+        if ( buf.fail() || packetSize == 0 || packetSize > maxLobbyFrameSize ) {
+            return false;
+        }
+
+        storage = Compression::unzipData( buf.data(), buf.size(), packetSize );
+        if ( storage.size() != packetSize ) {
+            return false;
+        }
+
+        packet = { storage.data(), storage.size() };
+
+        return true;
+    }
+}
@@ -0,0 +1,194 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "serialize.h"
+
+namespace Network
+{
+    // Lobby TCP traffic is a sequence of frames, each one is a little-endian uint32 length followed by the packet itself.
+    constexpr size_t frameHeaderSize = sizeof( uint32_t );
+
+    constexpr size_t maxLobbyFrameSize = 64 * 1024;
+
+    // Receive-side ring buffer which splits the incoming byte stream into frames without moving the data around.
+    // Frames are handed out as views into the buffer; only a frame wrapping around the end of the ring is copied
+    // into a scratch buffer to make it contiguous.
+    class FrameDecoder
+    {
+    public:
+        enum class Result : uint8_t
+        {
+            Frame,
+            Incomplete,
+            Invalid
+        };
+
+        explicit FrameDecoder( const size_t maxFrameSize );
+
+        FrameDecoder( const FrameDecoder & ) = delete;
+        FrameDecoder( FrameDecoder && ) noexcept = default;
+
+        ~FrameDecoder() = default;
+
+        FrameDecoder & operator=( const FrameDecoder & ) = delete;
+        FrameDecoder & operator=( FrameDecoder && ) noexcept = default;
+
+        // Returns the contiguous free region to receive data into. The size is 0 when the buffer is full, which
+        // can only happen while complete frames are waiting to be extracted.
+        std::pair<uint8_t *, size_t> writeRegion();
+
+        // Marks 'size' bytes of the region returned by writeRegion() as received.
+        void commitWrite( const size_t size );
+
+        // Extracts the next frame. On success 'frame' points to the packet data, this view is valid until the next
+        // call of any non-const method. Invalid is returned for a frame of zero or too big length, after which the
+        // stream cannot be resynchronized.
+        Result nextFrame( std::pair<const uint8_t *, size_t> & frame );
+
+        void clear();
+
+    private:
+        std::vector<uint8_t> _buffer;
+        std::vector<uint8_t> _scratch;
+
+        size_t _maxFrameSize{ 0 };
+
+        // Monotonic positions, the buffer index is obtained by masking.
+        size_t _readPos{ 0 };
+        size_t _writePos{ 0 };
+
+        // Size of the frame handed out by the last nextFrame() call, it is released on the next access.
+        size_t _pendingRelease{ 0 };
+
+        size_t _mask() const
+        {
+            return _buffer.size() - 1;
+        }
+
+        void _releasePending();
+        void _copyOut( const size_t pos, uint8_t * out, const size_t size ) const;
+    };
+
+    // Output stream appending to an external byte vector, so frames can be serialized into pooled storage.
+    class FrameWriter final : public OStreamBase
+    {
+    public:
+        explicit FrameWriter( std::vector<uint8_t> & out );
+
+        FrameWriter( const FrameWriter & ) = delete;
+
+        ~FrameWriter() override = default;
+
+        FrameWriter & operator=( const FrameWriter & ) = delete;
+
+        void putBE16( uint16_t v ) override;
+        void putLE16( uint16_t v ) override;
+        void putBE32( uint32_t v ) override;
+        void putLE32( uint32_t v ) override;
+
+        void putRaw( const void * ptr, size_t size ) override;
+
+    private:
+        std::vector<uint8_t> & _out;
+
+        void put8( const uint8_t v ) override;
+    };
+
+    // Keeps the storage of already sent frames for reuse. A frame is serialized once, including its length prefix,
+    // and the same bytes are then sent to every recipient.
+    class FramePool
+    {
+    public:
+        FramePool() = default;
+        FramePool( const FramePool & ) = delete;
+
+        ~FramePool() = default;
+
+        FramePool & operator=( const FramePool & ) = delete;
+
+        // Returns an empty buffer with space reserved for the length prefix; fill it through FrameWriter and call
+        // finalize() before sending.
+        std::vector<uint8_t> acquire();
+
+        // Writes the length prefix.
+        static void finalize( std::vector<uint8_t> & frame );
+
+        void release( std::vector<uint8_t> && frame );
+
+    private:
+        std::vector<std::vector<uint8_t>> _free;
+    };
+
+    // Every lobby packet starts with a header made of the magic number, the protocol version and the message type.
+    constexpr uint32_t lobbyProtocolMagic = 0x4C4F4242; // 'LOBB'
+    constexpr uint32_t lobbyProtocolVersion = 1;
+
+    // Optional protocol features are negotiated by the revision appended to Hello and HelloAck, so peers of different
+    // revisions can still talk to each other. A peer not sending it has revision 1.
+    //
+    // Revision 2: packets of at least lobbyCompressionThreshold bytes may be sent as Compressed packets.
+    constexpr uint32_t lobbyProtocolRevision = 2;
+    constexpr uint32_t lobbyCompressionRevision = 2;
+
+    constexpr size_t lobbyCompressionThreshold = 512;
+
+    enum class LobbyMessageType : uint8_t
+    {
+        // UDP
+        Advertise = 1,
+
+        // TCP
+        Hello = 10,
+        HelloAck = 11,
+        Chat = 20,
+        Kick = 30,
+        Lockstep = 40,
+        Ping = 60,
+        Pong = 61,
+        // Another packet, header included, compressed with zlib.
+        Compressed = 70,
+        FileOffer = 80,
+        // Transfer id and the first chunk the client needs. The chunk count tells the host that the client has the file.
+        FileRequest = 81,
+        FileChunk = 82
+    };
+
+    // Serializes a packet into a pooled frame, the length prefix included. The frame can be sent to any number of sockets.
+    std::vector<uint8_t> buildLobbyFrame( FramePool & pool, const LobbyMessageType type, const std::function<void( OStreamBase & )> & writeBody );
+
+    // Reads the packet header. Returns false if the packet does not belong to the lobby protocol of this version.
+    bool parseLobbyHeader( ROStreamBuf & buf, LobbyMessageType & outType );
+
+    // Builds a frame carrying the packet of the given frame in compressed form. Returns an empty vector if the packet is
+    // too small to be worth compressing or does not shrink.
+    std::vector<uint8_t> compressLobbyFrame( FramePool & pool, const std::vector<uint8_t> & frame );
+
+    // If the packet is a Compressed one, decompresses the original packet into 'storage' and makes 'packet' point to it.
+    // Other packets are left as is. Returns false if the packet cannot be decompressed.
+    bool unwrapLobbyPacket( std::pair<const uint8_t *, size_t> & packet, std::vector<uint8_t> & storage );
+}
@@ -0,0 +1,452 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "lobby_relay.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <string_view>
+#include <utility>
+
+#include "lockstep.h"
+#include "logging.h"
+#include "serialize.h"
+
+namespace
+{
+    // The maximum number of players in a game.
+    constexpr size_t maxLobbyMembers = 6;
+
+    // A client whose unsent data grows beyond this limit cannot keep up and is disconnected.
+    constexpr size_t maxClientQueueSize = 16 * 1024 * 1024;
+    // Already sent data at the front of the queue is dropped once it reaches this size.
+    constexpr size_t clientQueueCompactSize = 1024 * 1024;
+
+    // How long the server may sleep while clients still have data to be sent.
+    constexpr uint32_t flushRetryIntervalMs = 5;
+
+    uint64_t nowMs()
+    {
+        const auto now = std::chrono::steady_clock::now().time_since_epoch();
+        return static_cast<uint64_t>( std::chrono::duration_cast<std::chrono::milliseconds>( now ).count() );
+    }
+}
+
+namespace Network
+{
+    bool LobbyRelayServer::start( const uint16_t port, const size_t maxClients )
+    {
+        stop();
+
+        if ( !_subsystem.isReady() ) {
+            return false;
+        }
+
+        _tcpListen = Socket( Socket::Type::TCP );
+        if ( !_tcpListen.isValid() ) {
+            return false;
+        }
+        _tcpListen.setReuseAddr( true );
+        _tcpListen.setNonBlocking( true );
+
+        if ( !_tcpListen.bind( port ) || !_tcpListen.listen( 64 ) ) {
+            _tcpListen.close();
+            return false;
+        }
+
+        _tcpPort = _tcpListen.getLocalPort();
+        _maxClients = maxClients;
+        _isPollerValid = false;
+        _running = true;
+
+        DEBUG_LOG( DBG_NETWORK, DBG_INFO, "Relay server is listening on port " << _tcpPort )
+
+        return true;
+    }
+
+    void LobbyRelayServer::stop()
+    {
+        _running = false;
+        _lobbies.clear();
+        _clients.clear();
+        _tcpListen.close();
+        _tcpPort = 0;
+        _poller.clear();
+        _isPollerValid = false;
+    }
+
+    void LobbyRelayServer::pump( const uint32_t timeoutMs )
+    {
+        if ( !_running ) {
+            return;
+        }
+
+        // Slot 0 is always the listening socket, client slots follow in the order of _clients.
+        if ( !_isPollerValid ) {
+            _poller.clear();
+            _poller.add( _tcpListen );
+            for ( const std::unique_ptr<Client> & client : _clients ) {
+                _poller.add( client->socket );
+            }
+
+            _isPollerValid = true;
+        }
+
+        uint32_t waitMs = timeoutMs;
+        if ( _flushClients() ) {
+            // Only readability is polled, so wake up soon to continue sending.
+            waitMs = std::min( waitMs, flushRetryIntervalMs );
+        }
+
+        if ( _poller.wait( static_cast<int>( waitMs ) ) <= 0 ) {
+            _removeDisconnectedClients();
+            return;
+        }
+
+        // Clients are serviced before accepting new ones so the slot indices stay valid.
+        for ( size_t i = 0; i < _clients.size(); ++i ) {
+            if ( _poller.isReadable( i + 1 ) ) {
+                _pumpClient( *_clients[i] );
+            }
+        }
+
+        if ( _poller.isReadable( 0 ) ) {
+            _acceptClients();
+        }
+
+        // Replies and relayed messages produced while servicing the clients.
+        _flushClients();
+
+        _removeDisconnectedClients();
+    }
+
+    void LobbyRelayServer::_acceptClients()
+    {
+        while ( true ) {
+            IpEndpoint peer;
+            std::optional<Socket> accepted = _tcpListen.accept( &peer );
+            if ( !accepted.has_value() ) {
+                return;
+            }
+
+            if ( _clients.size() >= _maxClients ) {
+                DEBUG_LOG( DBG_NETWORK, DBG_WARN, "Connection from " << peer.address << " is rejected: too many clients" )
+                continue;
+            }
+
+            auto client = std::make_unique<Client>();
+            client->socket = std::move( *accepted );
+            client->socket.setNonBlocking( true );
+            client->endpoint = std::move( peer );
+
+            _clients.push_back( std::move( client ) );
+            _isPollerValid = false;
+        }
+    }
+
+    void LobbyRelayServer::_pumpClient( Client & client )
+    {
+        // The socket was reported as readable: drain everything the OS has buffered for it straight into the frame buffer.
+        bool received = false;
+        while ( client.socket.isValid() ) {
+            const std::pair<uint8_t *, size_t> region = client.rx.writeRegion();
+            if ( region.second == 0 ) {
+                // The buffer is full of complete frames, process them to make room.
+                if ( !_processClientFrames( client ) ) {
+                    return;
+                }
+                continue;
+            }
+
+            const int rc = client.socket.recv( region.first, region.second );
+            if ( rc < 0 ) {
+                client.socket.close();
+                return;
+            }
+            if ( rc == 0 ) {
+                break;
+            }
+
+            client.rx.commitWrite( static_cast<size_t>( rc ) );
+            received = true;
+        }
+
+        if ( !received ) {
+            // A readable socket without any data means that the peer closed the connection.
+            client.socket.close();
+            return;
+        }
+
+        _processClientFrames( client );
+    }
+
+    bool LobbyRelayServer::_processClientFrames( Client & client )
+    {
+        std::pair<const uint8_t *, size_t> packet;
+
+        while ( client.socket.isValid() ) {
+            const FrameDecoder::Result result = client.rx.nextFrame( packet );
+            if ( result == FrameDecoder::Result::Incomplete ) {
+                return true;
+            }
+            if ( result == FrameDecoder::Result::Invalid ) {
+                client.socket.close();
+                return false;
+            }
+
+            ROStreamBuf s( packet.first, packet.second );
+            LobbyMessageType type{};
+            if ( !parseLobbyHeader( s, type ) ) {
+                continue;
+            }
+
+            if ( type == LobbyMessageType::Hello ) {
+                uint64_t lobbyId = 0;
+                std::string playerName;
+                std::string invite;
+                s >> lobbyId >> playerName >> invite;
+                if ( s.fail() || lobbyId == 0 || client.joined ) {
+                    client.socket.close();
+                    return false;
+                }
+
+                _joinLobby( client, lobbyId, std::move( playerName ), invite );
+                continue;
+            }
+
+            if ( type == LobbyMessageType::Ping ) {
+                // Answered by the relay itself, so the clients measure the latency of their own connection.
+                uint64_t timestampMs = 0;
+                s >> timestampMs;
+                if ( !s.fail() ) {
+                    std::vector<uint8_t> pong = buildLobbyFrame( _framePool, LobbyMessageType::Pong, [timestampMs]( OStreamBase & w ) { w << timestampMs; } );
+                    _sendFrame( client, pong );
+                    _framePool.release( std::move( pong ) );
+                }
+                continue;
+            }
+
+            if ( !client.joined ) {
+                continue;
+            }
+
+            const auto lobbyIter = _lobbies.find( client.lobbyId );
+            assert( lobbyIter != _lobbies.end() );
+
+            if ( type == LobbyMessageType::Chat ) {
+                uint64_t ts = 0;
+                std::string from;
+                std::string text;
+                s >> ts >> from >> text;
+                if ( s.fail() ) {
+                    continue;
+                }
+
+                // Relay to everyone in the lobby including the sender, the same way as the LAN host does.
+                std::vector<uint8_t> relay = buildLobbyFrame( _framePool, LobbyMessageType::Chat, [&]( OStreamBase & w ) {
+                    w << ts;
+                    w << std::string_view( from );
+                    w << std::string_view( text );
+                } );
+                _broadcastFrame( lobbyIter->second, relay );
+                _framePool.release( std::move( relay ) );
+                continue;
+            }
+
+            if ( type == LobbyMessageType::Lockstep ) {
+                LockstepCommand cmd;
+                s >> cmd;
+                if ( s.fail() ) {
+                    continue;
+                }
+
+                std::vector<uint8_t> relay = buildLobbyFrame( _framePool, LobbyMessageType::Lockstep, [&cmd]( OStreamBase & w ) { w << cmd; } );
+                _broadcastFrame( lobbyIter->second, relay, &client );
+                _framePool.release( std::move( relay ) );
+            }
+        }
+
+        return false;
+    }
+
+    void LobbyRelayServer::_joinLobby( Client & client, const uint64_t lobbyId, std::string && playerName, const std::string & inviteCode )
+    {
+        auto [lobbyIter, isNewLobby] = _lobbies.try_emplace( lobbyId );
+        Lobby & lobby = lobbyIter->second;
+
+        if ( isNewLobby ) {
+            // The first player creates the lobby, an invite code given by this player makes the lobby private.
+            lobby.name = playerName;
+            lobby.hostPlayerName = playerName;
+            lobby.inviteCode = inviteCode;
+            lobby.privacy = inviteCode.empty() ? LobbyPrivacy::Open : LobbyPrivacy::InviteOnly;
+
+            DEBUG_LOG( DBG_NETWORK, DBG_INFO, "Lobby " << lobbyId << " is created by " << playerName << " from " << client.endpoint.address )
+        }
+        else if ( lobby.privacy == LobbyPrivacy::InviteOnly && inviteCode != lobby.inviteCode ) {
+            _kick( client, "Invalid invite code" );
+            return;
+        }
+        else if ( lobby.members.size() >= maxLobbyMembers ) {
+            _kick( client, "The lobby is full" );
+            return;
+        }
+
+        client.joined = true;
+        client.lobbyId = lobbyId;
+        client.name = std::move( playerName );
+
+        lobby.members.push_back( &client );
+
+        std::vector<uint8_t> ack = buildLobbyFrame( _framePool, LobbyMessageType::HelloAck, [&lobby, lobbyId]( OStreamBase & w ) {
+            w << lobbyId;
+            w << std::string_view( lobby.name );
+            w << std::string_view( lobby.hostPlayerName );
+            w << static_cast<uint8_t>( lobby.privacy );
+        } );
+        _sendFrame( client, ack );
+        _framePool.release( std::move( ack ) );
+
+        _sendSystemMessage( lobby, client.name + " joined" );
+    }
+
+    void LobbyRelayServer::_removeDisconnectedClients()
+    {
+        const auto firstDisconnected
+            = std::stable_partition( _clients.begin(), _clients.end(), []( const std::unique_ptr<Client> & client ) { return client->socket.isValid(); } );
+        if ( firstDisconnected == _clients.end() ) {
+            return;
+        }
+
+        for ( auto clientIter = firstDisconnected; clientIter != _clients.end(); ++clientIter ) {
+            const Client & client = **clientIter;
+            if ( !client.joined ) {
+                continue;
+            }
+
+            const auto lobbyIter = _lobbies.find( client.lobbyId );
+            assert( lobbyIter != _lobbies.end() );
+
+            Lobby & lobby = lobbyIter->second;
+            lobby.members.erase( std::remove( lobby.members.begin(), lobby.members.end(), &client ), lobby.members.end() );
+
+            if ( lobby.members.empty() ) {
+                DEBUG_LOG( DBG_NETWORK, DBG_INFO, "Lobby " << client.lobbyId << " is closed" )
+
+                _lobbies.erase( lobbyIter );
+                continue;
+            }
+
+            if ( client.name == lobby.hostPlayerName ) {
+                // The player who has been in the lobby for the longest time becomes the new host.
+                lobby.hostPlayerName = lobby.members.front()->name;
+            }
+
+            _sendSystemMessage( lobby, client.name + " left" );
+        }
+
+        _clients.erase( firstDisconnected, _clients.end() );
+        _isPollerValid = false;
+    }
+
+    void LobbyRelayServer::_kick( Client & client, const char * reason )
+    {
+        std::vector<uint8_t> kick = buildLobbyFrame( _framePool, LobbyMessageType::Kick, [reason]( OStreamBase & w ) { w << std::string_view( reason ); } );
+        _sendFrame( client, kick );
+        _framePool.release( std::move( kick ) );
+
+        // Make an attempt to deliver the reason before closing the connection.
+        _flushClient( client );
+        client.socket.close();
+    }
+
+    void LobbyRelayServer::_sendSystemMessage( const Lobby & lobby, const std::string & text )
+    {
+        std::vector<uint8_t> frame = buildLobbyFrame( _framePool, LobbyMessageType::Chat, [&text]( OStreamBase & w ) {
+            w << nowMs();
+            w << std::string_view( "system" );
+            w << std::string_view( text );
+        } );
+        _broadcastFrame( lobby, frame );
+        _framePool.release( std::move( frame ) );
+    }
+
+    void LobbyRelayServer::_broadcastFrame( const Lobby & lobby, const std::vector<uint8_t> & frame, const Client * except /* = nullptr */ )
+    {
+        for ( Client * member : lobby.members ) {
+            if ( member->socket.isValid() && member != except ) {
+                _sendFrame( *member, frame );
+            }
+        }
+    }
+
+    void LobbyRelayServer::_sendFrame( Client & client, const std::vector<uint8_t> & frame )
+    {
+        if ( client.tx.size() - client.txOffset + frame.size() > maxClientQueueSize ) {
+            DEBUG_LOG( DBG_NETWORK, DBG_WARN, "Client " << client.endpoint.address << " cannot keep up and is disconnected" )
+
+            client.socket.close();
+            return;
+        }
+
+        client.tx.insert( client.tx.end(), frame.begin(), frame.end() );
+    }
+
+    bool LobbyRelayServer::_flushClients()
+    {
+        bool hasUnsentData = false;
+
+        for ( const std::unique_ptr<Client> & client : _clients ) {
+            if ( client->socket.isValid() && !client->tx.empty() && _flushClient( *client ) ) {
+                hasUnsentData = hasUnsentData || !client->tx.empty();
+            }
+        }
+
+        return hasUnsentData;
+    }
+
+    bool LobbyRelayServer::_flushClient( Client & client )
+    {
+        while ( client.txOffset < client.tx.size() ) {
+            const int sent = client.socket.send( client.tx.data() + client.txOffset, client.tx.size() - client.txOffset );
+            if ( sent < 0 ) {
+                client.socket.close();
+                return false;
+            }
+            if ( sent == 0 ) {
+                break;
+            }
+
+            client.txOffset += static_cast<size_t>( sent );
+        }
+
+        if ( client.txOffset == client.tx.size() ) {
+            client.tx.clear();
+            client.txOffset = 0;
+        }
+        else if ( client.txOffset >= clientQueueCompactSize ) {
+            client.tx.erase( client.tx.begin(), client.tx.begin() + static_cast<std::ptrdiff_t>( client.txOffset ) );
+            client.txOffset = 0;
+        }
+
+        return true;
+    }
+}
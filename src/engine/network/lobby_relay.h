@@ -0,0 +1,138 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "lan_lobby.h"
+#include "lobby_frame.h"
+#include "socket.h"
+
+namespace Network
+{
+    // Dedicated server which relays lobbies of internet games, it does not require any display or audio. Players connect
+    // over TCP using the regular lobby protocol and join a lobby by its id: the player who joins a lobby first creates it
+    // and becomes its host, the lobby is closed when its last player leaves. Chat messages and lockstep commands are relayed
+    // only between the players of the same lobby. Every peer runs its own game simulation (see LockstepSession), the server
+    // just forwards the commands in the order they arrive.
+    class LobbyRelayServer
+    {
+    public:
+        LobbyRelayServer() = default;
+        LobbyRelayServer( const LobbyRelayServer & ) = delete;
+
+        ~LobbyRelayServer() = default;
+
+        LobbyRelayServer & operator=( const LobbyRelayServer & ) = delete;
+
+        bool start( const uint16_t port, const size_t maxClients );
+        void stop();
+
+        bool isRunning() const
+        {
+            return _running;
+        }
+
+        uint16_t tcpPort() const
+        {
+            return _tcpPort;
+        }
+
+        size_t clientCount() const
+        {
+            return _clients.size();
+        }
+
+        size_t lobbyCount() const
+        {
+            return _lobbies.size();
+        }
+
+        // Services the sockets with pending data, waiting up to 'timeoutMs' milliseconds for network activity.
+        void pump( const uint32_t timeoutMs );
+
+    private:
+        struct Client
+        {
+            Socket socket{ Socket::Type::TCP };
+            IpEndpoint endpoint;
+            std::string name;
+            uint64_t lobbyId{ 0 };
+            bool joined{ false };
+            FrameDecoder rx{ maxLobbyFrameSize };
+
+            // Frames queued since the last flush, followed by the data the socket did not accept yet.
+            std::vector<uint8_t> tx;
+            size_t txOffset{ 0 };
+        };
+
+        struct Lobby
+        {
+            std::string name;
+            std::string hostPlayerName;
+            std::string inviteCode;
+            LobbyPrivacy privacy{ LobbyPrivacy::Open };
+            std::vector<Client *> members;
+        };
+
+        bool _running{ false };
+        SocketSubsystem _subsystem;
+
+        Socket _tcpListen{ Socket::Type::TCP };
+        uint16_t _tcpPort{ 0 };
+        size_t _maxClients{ 0 };
+
+        // Clients are allocated separately so that lobbies can refer to them while the container grows.
+        std::vector<std::unique_ptr<Client>> _clients;
+        std::unordered_map<uint64_t, Lobby> _lobbies;
+
+        // The poller is rebuilt only when clients connect or disconnect, not on every pump.
+        SocketPoller _poller;
+        bool _isPollerValid{ false };
+
+        FramePool _framePool;
+
+        void _acceptClients();
+        void _pumpClient( Client & client );
+        // Returns false if the client got disconnected.
+        bool _processClientFrames( Client & client );
+        void _joinLobby( Client & client, const uint64_t lobbyId, std::string && playerName, const std::string & inviteCode );
+        void _removeDisconnectedClients();
+
+        void _kick( Client & client, const char * reason );
+        void _sendSystemMessage( const Lobby & lobby, const std::string & text );
+
+        // The client to skip can be nullptr.
+        void _broadcastFrame( const Lobby & lobby, const std::vector<uint8_t> & frame, const Client * except = nullptr );
+        // Appends the frame to the client queue, a client whose queue grows too large cannot keep up and gets disconnected.
+        static void _sendFrame( Client & client, const std::vector<uint8_t> & frame );
+
+        // Return true if some data could not be sent yet.
+        bool _flushClients();
+        // Returns false if the client got disconnected.
+        static bool _flushClient( Client & client );
+    };
+}
@@ -0,0 +1,158 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "lockstep.h"
+
+#include <cassert>
+#include <utility>
+
+#include "logging.h"
+#include "serialize.h"
+#include "state_hash.h"
+
+namespace Network
+{
+    OStreamBase & operator<<( OStreamBase & stream, const LockstepCommand & cmd )
+    {
+        return stream << cmd.turn << cmd.player << cmd.sequence << cmd.kind << cmd.payload;
+    }
+
+    IStreamBase & operator>>( IStreamBase & stream, LockstepCommand & cmd )
+    {
+        return stream >> cmd.turn >> cmd.player >> cmd.sequence >> cmd.kind >> cmd.payload;
+    }
+
+    void LockstepSession::start( const uint64_t seed, const uint8_t localPlayer )
+    {
+        stop();
+
+        _seed = seed;
+        _localPlayer = localPlayer;
+        _isActive = true;
+    }
+
+    void LockstepSession::stop()
+    {
+        _pending.clear();
+        _seed = 0;
+        _turn = 0;
+        _nextSequence = 0;
+        _localPlayer = 0;
+        _activePlayer = 0;
+        _isActive = false;
+        _isTurnFinished = false;
+    }
+
+    void LockstepSession::beginTurn( const uint32_t turn, const uint8_t activePlayer )
+    {
+        if ( !_pending.empty() ) {
+            DEBUG_LOG( DBG_NETWORK, DBG_WARN, "Dropping " << _pending.size() << " unprocessed commands of turn " << _turn )
+            _pending.clear();
+        }
+
+        _turn = turn;
+        _activePlayer = activePlayer;
+        _nextSequence = 0;
+        _isTurnFinished = false;
+
+        Rand::CurrentThreadRandomDevice() = turnGenerator();
+    }
+
+    LockstepCommand LockstepSession::submit( std::vector<uint8_t> && payload )
+    {
+        assert( isLocalTurn() && !_isTurnFinished );
+
+        LockstepCommand cmd;
+        cmd.turn = _turn;
+        cmd.player = _localPlayer;
+        cmd.sequence = _nextSequence++;
+        cmd.kind = LockstepCommand::Kind::Action;
+        cmd.payload = std::move( payload );
+
+        return cmd;
+    }
+
+    LockstepCommand LockstepSession::submitEndOfTurn()
+    {
+        assert( isLocalTurn() && !_isTurnFinished );
+
+        LockstepCommand cmd;
+        cmd.turn = _turn;
+        cmd.player = _localPlayer;
+        cmd.sequence = _nextSequence++;
+        cmd.kind = LockstepCommand::Kind::EndOfTurn;
+
+        _isTurnFinished = true;
+
+        return cmd;
+    }
+
+    LockstepSession::ReceiveResult LockstepSession::receive( LockstepCommand && cmd )
+    {
+        if ( !_isActive || cmd.turn != _turn || cmd.player != _activePlayer || cmd.player == _localPlayer ) {
+            DEBUG_LOG( DBG_NETWORK, DBG_WARN,
+                       "Rejecting command of player " << static_cast<int>( cmd.player ) << " for turn " << cmd.turn << ", current turn is " << _turn )
+            return ReceiveResult::WrongTurn;
+        }
+
+        if ( cmd.sequence < _nextSequence || _pending.count( cmd.sequence ) > 0 ) {
+            return ReceiveResult::Duplicate;
+        }
+
+        const uint32_t sequence = cmd.sequence;
+        _pending.emplace( sequence, std::move( cmd ) );
+
+        return ReceiveResult::Accepted;
+    }
+
+    std::optional<LockstepCommand> LockstepSession::popRemote()
+    {
+        if ( _isTurnFinished || _pending.empty() ) {
+            return std::nullopt;
+        }
+
+        auto iter = _pending.begin();
+        if ( iter->first != _nextSequence ) {
+            // Waiting for a command which has not arrived yet.
+            return std::nullopt;
+        }
+
+        LockstepCommand cmd = std::move( iter->second );
+        _pending.erase( iter );
+
+        ++_nextSequence;
+
+        if ( cmd.kind == LockstepCommand::Kind::EndOfTurn ) {
+            _isTurnFinished = true;
+        }
+
+        return cmd;
+    }
+
+    Rand::PCG32 LockstepSession::turnGenerator() const
+    {
+        return Rand::PCG32( _turnSeed(), mixHash( _seed ^ 0x5354524541ULL ) );
+    }
+
+    uint64_t LockstepSession::_turnSeed() const
+    {
+        return mixHash( _seed ^ mixHash( ( static_cast<uint64_t>( _turn ) << 8 ) | _activePlayer ) );
+    }
+}
@@ -0,0 +1,143 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <vector>
+
+#include "rand.h"
+
+class IStreamBase;
+class OStreamBase;
+
+namespace Network
+{
+    // A player command as it travels between peers. The payload is game-specific and opaque to the protocol.
+    struct LockstepCommand
+    {
+        enum class Kind : uint8_t
+        {
+            Action = 0,
+            // Sent by the active player when they finish their turn. It carries no payload.
+            EndOfTurn = 1
+        };
+
+        uint32_t turn{ 0 };
+        uint8_t player{ 0 };
+        // Position of the command within the turn, every turn starts from 0.
+        uint32_t sequence{ 0 };
+        Kind kind{ Kind::Action };
+        std::vector<uint8_t> payload;
+    };
+
+    OStreamBase & operator<<( OStreamBase & stream, const LockstepCommand & cmd );
+    IStreamBase & operator>>( IStreamBase & stream, LockstepCommand & cmd );
+
+    // Deterministic lockstep for turn-based play: only player commands are replicated, and every peer feeds them to
+    // its own simulation in exactly the same order. Players act one at a time, so a turn belongs to a single player
+    // who is the only one allowed to issue commands until its end-of-turn command is executed.
+    //
+    // All randomness used by the simulation must come from turnGenerator() (or the thread random device reseeded
+    // through beginTurn()), which is derived from the session seed and the turn, so it is identical on every peer.
+    class LockstepSession
+    {
+    public:
+        enum class ReceiveResult : uint8_t
+        {
+            Accepted,
+            Duplicate,
+            WrongTurn
+        };
+
+        LockstepSession() = default;
+        LockstepSession( const LockstepSession & ) = delete;
+
+        ~LockstepSession() = default;
+
+        LockstepSession & operator=( const LockstepSession & ) = delete;
+
+        // The seed must be the same on all peers, it is chosen by the host and distributed along with the game setup.
+        void start( const uint64_t seed, const uint8_t localPlayer );
+        void stop();
+
+        bool isActive() const
+        {
+            return _isActive;
+        }
+
+        // Called by every peer when the game passes the turn to 'activePlayer'. The random device of the current
+        // thread is reseeded so that the simulation draws the same numbers on all peers.
+        void beginTurn( const uint32_t turn, const uint8_t activePlayer );
+
+        uint32_t currentTurn() const
+        {
+            return _turn;
+        }
+
+        uint8_t activePlayer() const
+        {
+            return _activePlayer;
+        }
+
+        bool isLocalTurn() const
+        {
+            return _isActive && _activePlayer == _localPlayer;
+        }
+
+        // Stamps a command issued by the local player. The returned command must be sent to all other peers and
+        // applied locally right away.
+        LockstepCommand submit( std::vector<uint8_t> && payload );
+        LockstepCommand submitEndOfTurn();
+
+        ReceiveResult receive( LockstepCommand && cmd );
+
+        // Returns the next remote command to apply, in sequence order. Commands arriving ahead of a missing one are
+        // held back until the gap is filled.
+        std::optional<LockstepCommand> popRemote();
+
+        // True once the end-of-turn command of the active player was handed out by popRemote() or submitted locally.
+        bool isTurnFinished() const
+        {
+            return _isTurnFinished;
+        }
+
+        // The generator is recreated from the same seed every time, so callers should keep their own copy for the
+        // duration of the turn.
+        Rand::PCG32 turnGenerator() const;
+
+    private:
+        std::map<uint32_t, LockstepCommand> _pending;
+
+        uint64_t _seed{ 0 };
+        uint32_t _turn{ 0 };
+        uint32_t _nextSequence{ 0 };
+
+        uint8_t _localPlayer{ 0 };
+        uint8_t _activePlayer{ 0 };
+
+        bool _isActive{ false };
+        bool _isTurnFinished{ false };
+
+        uint64_t _turnSeed() const;
+    };
+}
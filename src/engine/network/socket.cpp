@@ -1,8 +1,13 @@
 #include "socket.h"
 
+#include <chrono>
+#include <cstdint>
 #include <cstring>
+#include <thread>
+#include <vector>
 
 #include "logging.h"
+#include "perf_counters.h"
 
 #ifdef _WIN32
     #define NOMINMAX
@@ -34,12 +39,20 @@
         {
             return err == WSAEWOULDBLOCK;
         }
+
+        using PollFd = WSAPOLLFD;
+
+        int pollNative( PollFd * fds, size_t count, int timeoutMs )
+        {
+            return WSAPoll( fds, static_cast<ULONG>( count ), timeoutMs );
+        }
     }
 #else
     #include <arpa/inet.h>
     #include <cerrno>
     #include <fcntl.h>
     #include <netinet/in.h>
+    #include <poll.h>
     #include <sys/socket.h>
     #include <unistd.h>
 
@@ -72,6 +85,13 @@
         {
             ::close( s );
         }
+
+        using PollFd = pollfd;
+
+        int pollNative( PollFd * fds, size_t count, int timeoutMs )
+        {
+            return ::poll( fds, static_cast<nfds_t>( count ), timeoutMs );
+        }
     }
 #endif
 
@@ -341,6 +361,8 @@ namespace Network
             return -1;
         }
 
+        fheroes2::addPerfCounter( fheroes2::PerfCounter::NETWORK_BYTES_SENT, static_cast<uint64_t>( rc ) );
+
         return rc;
     }
 
@@ -359,6 +381,8 @@ namespace Network
             return -1;
         }
 
+        fheroes2::addPerfCounter( fheroes2::PerfCounter::NETWORK_BYTES_RECEIVED, static_cast<uint64_t>( rc ) );
+
         return rc;
     }
 
@@ -378,6 +402,8 @@ namespace Network
             return -1;
         }
 
+        fheroes2::addPerfCounter( fheroes2::PerfCounter::NETWORK_BYTES_SENT, static_cast<uint64_t>( rc ) );
+
         return rc;
     }
 
@@ -402,6 +428,8 @@ namespace Network
             *outPeer = toEndpoint( addr );
         }
 
+        fheroes2::addPerfCounter( fheroes2::PerfCounter::NETWORK_BYTES_RECEIVED, static_cast<uint64_t>( rc ) );
+
         return rc;
     }
 
@@ -432,4 +460,122 @@ namespace Network
 
         return ntohs( addr.sin_port );
     }
+
+    struct SocketPoller::Handles
+    {
+        std::vector<PollFd> fds;
+        size_t active{ 0 };
+    };
+
+    SocketPoller::SocketPoller()
+        : _handles( std::make_unique<Handles>() )
+    {}
+
+    SocketPoller::~SocketPoller() = default;
+
+    void SocketPoller::clear()
+    {
+        _handles->fds.clear();
+        _handles->active = 0;
+    }
+
+    size_t SocketPoller::add( const Socket & socket )
+    {
+        PollFd fd{};
+        // Negative descriptors are ignored by both poll() and WSAPoll().
+        fd.fd = socket.isValid() ? toNative( socket.nativeHandle() ) : invalidSocket;
+        fd.events = POLLIN;
+
+        if ( socket.isValid() ) {
+            ++_handles->active;
+        }
+
+        _handles->fds.push_back( fd );
+
+        return _handles->fds.size() - 1;
+    }
+
+    size_t SocketPoller::size() const
+    {
+        return _handles->fds.size();
+    }
+
+    int SocketPoller::wait( int timeoutMs )
+    {
+        for ( PollFd & fd : _handles->fds ) {
+            fd.revents = 0;
+        }
+
+        if ( _handles->active == 0 ) {
+            // WSAPoll() fails on an empty set so behave like a plain timeout on all platforms.
+            if ( timeoutMs > 0 ) {
+                std::this_thread::sleep_for( std::chrono::milliseconds( timeoutMs ) );
+            }
+            return 0;
+        }
+
+        const int rc = pollNative( _handles->fds.data(), _handles->fds.size(), timeoutMs < 0 ? 0 : timeoutMs );
+        if ( rc < 0 ) {
+            const int err = lastSocketError();
+#ifndef _WIN32
+            if ( err == EINTR ) {
+                return 0;
+            }
+#endif
+            DEBUG_LOG( DBG_NETWORK, DBG_WARN, "poll() failed: " << err )
+            return -1;
+        }
+
+        return rc;
+    }
+
+    bool SocketPoller::isReadable( const size_t slot ) const
+    {
+        if ( slot >= _handles->fds.size() ) {
+            return false;
+        }
+
+        return ( _handles->fds[slot].revents & ( POLLIN | POLLHUP | POLLERR ) ) != 0;
+    }
+
+    std::optional<IpEndpoint> parseIpEndpoint( std::string_view text, const uint16_t defaultPort )
+    {
+        IpEndpoint endpoint{ {}, defaultPort };
+
+        const size_t colonPos = text.find( ':' );
+        if ( colonPos != std::string_view::npos ) {
+            const std::string_view portText = text.substr( colonPos + 1 );
+            if ( portText.empty() || portText.size() > 5 ) {
+                return std::nullopt;
+            }
+
+            uint32_t port = 0;
+            for ( const char ch : portText ) {
+                if ( ch < '0' || ch > '9' ) {
+                    return std::nullopt;
+                }
+                port = port * 10 + static_cast<uint32_t>( ch - '0' );
+            }
+            if ( port == 0 || port > UINT16_MAX ) {
+                return std::nullopt;
+            }
+
+            endpoint.port = static_cast<uint16_t>( port );
+            text = text.substr( 0, colonPos );
+        }
+
+        endpoint.address = std::string( text );
+
+        in_addr addr{};
+#ifdef _WIN32
+        const int rc = InetPtonA( AF_INET, endpoint.address.c_str(), &addr );
+#else
+        const int rc = inet_pton( AF_INET, endpoint.address.c_str(), &addr );
+#endif
+        if ( rc != 1 ) {
+            return std::nullopt;
+        }
+
+        return endpoint;
+    }
 }
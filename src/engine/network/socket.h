@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -13,6 +14,10 @@ namespace Network
         uint16_t port{ 0 };
     };
 
+    // Parses an IPv4 address optionally followed by a port, like "192.168.0.1:26368". The default port is used if the text
+    // has none. Host names are not resolved.
+    std::optional<IpEndpoint> parseIpEndpoint( std::string_view text, const uint16_t defaultPort );
+
     // Minimal cross-platform socket wrapper (IPv4 only for now).
     class Socket
     {
@@ -63,6 +68,39 @@ namespace Network
         Type _type{ Type::UDP };
     };
 
+    // Readiness notification for a set of sockets (poll() on POSIX, WSAPoll() on Windows).
+    // The set is expected to be small (a lobby has a handful of sockets) so it is rebuilt by the owner whenever
+    // sockets come and go. Only read readiness is tracked: hang-ups and errors are reported as readable so that
+    // the following recv() call detects them.
+    class SocketPoller
+    {
+    public:
+        SocketPoller();
+        SocketPoller( const SocketPoller & ) = delete;
+        SocketPoller & operator=( const SocketPoller & ) = delete;
+        ~SocketPoller();
+
+        void clear();
+
+        // Returns the slot of the added socket, which can be passed to isReadable() later. Invalid sockets are
+        // not added (they never become readable) but still get a slot to keep the caller's indexing simple.
+        size_t add( const Socket & socket );
+
+        size_t size() const;
+
+        // Waits up to 'timeoutMs' milliseconds (0 means do not wait) until at least one socket becomes readable.
+        // Returns the number of readable sockets, 0 on timeout or -1 on error.
+        int wait( int timeoutMs );
+
+        // The state is valid until the next call of wait().
+        bool isReadable( const size_t slot ) const;
+
+    private:
+        struct Handles;
+
+        std::unique_ptr<Handles> _handles;
+    };
+
     // Windows requires explicit init/cleanup of Winsock.
     class SocketSubsystem
     {
@@ -0,0 +1,119 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "state_hash.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace
+{
+    uint64_t getSlotTerm( const size_t slot, const uint64_t digest )
+    {
+        return Network::mixHash( digest ^ Network::mixHash( static_cast<uint64_t>( slot ) ) );
+    }
+}
+
+namespace Network
+{
+    uint64_t mixHash( uint64_t value )
+    {
+        value += 0x9E3779B97F4A7C15ULL;
+        value = ( value ^ ( value >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+        value = ( value ^ ( value >> 27 ) ) * 0x94D049BB133111EBULL;
+        return value ^ ( value >> 31 );
+    }
+
+    uint64_t getDigest( const uint8_t * data, const size_t size )
+    {
+        uint64_t hash = 0xCBF29CE484222325ULL;
+
+        for ( size_t i = 0; i < size; ++i ) {
+            hash ^= data[i];
+            hash *= 0x100000001B3ULL;
+        }
+
+        return hash;
+    }
+
+    void DigestTable::reset( const size_t size )
+    {
+        _digests.assign( size, 0 );
+        _isDirty.assign( size, 0 );
+        _dirtySlots.clear();
+        _sweepPosition = 0;
+
+        // All slots hold a zero digest now.
+        _value = 0;
+        for ( size_t slot = 0; slot < size; ++slot ) {
+            _value += getSlotTerm( slot, 0 );
+        }
+
+        markAllDirty();
+    }
+
+    void DigestTable::markDirty( const size_t slot )
+    {
+        assert( slot < _digests.size() );
+
+        if ( _isDirty[slot] == 0 ) {
+            _isDirty[slot] = 1;
+            _dirtySlots.push_back( slot );
+        }
+    }
+
+    void DigestTable::markAllDirty()
+    {
+        for ( size_t slot = 0; slot < _digests.size(); ++slot ) {
+            markDirty( slot );
+        }
+    }
+
+    void DigestTable::sweep( const size_t count )
+    {
+        const size_t size = _digests.size();
+        if ( size == 0 ) {
+            return;
+        }
+
+        for ( size_t i = 0; i < std::min( count, size ); ++i ) {
+            markDirty( _sweepPosition );
+
+            ++_sweepPosition;
+            if ( _sweepPosition == size ) {
+                _sweepPosition = 0;
+            }
+        }
+    }
+
+    void DigestTable::_set( const size_t slot, const uint64_t digest )
+    {
+        uint64_t & current = _digests[slot];
+        if ( current == digest ) {
+            return;
+        }
+
+        // Unsigned arithmetic wraps around, so the term of the old digest can be removed by subtraction.
+        _value -= getSlotTerm( slot, current );
+        _value += getSlotTerm( slot, digest );
+
+        current = digest;
+    }
+}
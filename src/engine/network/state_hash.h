@@ -0,0 +1,99 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Network
+{
+    // SplitMix64 finalizer. Unlike std::hash it gives the same result on every platform.
+    uint64_t mixHash( uint64_t value );
+
+    // 64-bit FNV-1a digest of a memory block.
+    uint64_t getDigest( const uint8_t * data, const size_t size );
+
+    inline uint64_t getDigest( const std::vector<uint8_t> & data )
+    {
+        return getDigest( data.data(), data.size() );
+    }
+
+    // Order-independent hash of a fixed set of records (slots). Each record is represented by its own digest and the
+    // combined value is updated in constant time when a single record changes, so only records marked as dirty have to
+    // be re-hashed. The combined value depends on the slot of every digest, so swapping two records changes it as well.
+    class DigestTable
+    {
+    public:
+        DigestTable() = default;
+        DigestTable( const DigestTable & ) = delete;
+
+        ~DigestTable() = default;
+
+        DigestTable & operator=( const DigestTable & ) = delete;
+
+        // Sets the number of slots. All slots are marked as dirty.
+        void reset( const size_t size );
+
+        size_t size() const
+        {
+            return _digests.size();
+        }
+
+        void markDirty( const size_t slot );
+        void markAllDirty();
+
+        // Marks up to 'count' slots following the last swept one as dirty. This way records which changed without being
+        // explicitly marked are eventually re-hashed, every slot being visited once per size() / count calls.
+        void sweep( const size_t count );
+
+        // Re-hashes all dirty slots by calling 'getSlotDigest( slot )' for each of them. Returns the number of updated slots.
+        template <typename DigestFunction>
+        size_t update( const DigestFunction & getSlotDigest )
+        {
+            const size_t updated = _dirtySlots.size();
+
+            for ( const size_t slot : _dirtySlots ) {
+                _set( slot, getSlotDigest( slot ) );
+                _isDirty[slot] = 0;
+            }
+
+            _dirtySlots.clear();
+
+            return updated;
+        }
+
+        uint64_t value() const
+        {
+            return _value;
+        }
+
+    private:
+        void _set( const size_t slot, const uint64_t digest );
+
+        std::vector<uint64_t> _digests;
+        std::vector<uint8_t> _isDirty;
+        std::vector<size_t> _dirtySlots;
+
+        size_t _sweepPosition{ 0 };
+        uint64_t _value{ 0 };
+    };
+}
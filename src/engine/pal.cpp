@@ -166,35 +166,85 @@ namespace
         uint8_t length;
         bool forward;
     };
-}
 
-std::vector<uint8_t> PAL::GetCyclingPalette( const uint32_t stepId )
-{
-    std::vector<uint8_t> palette = GetPalette( PaletteType::STANDARD );
+    const std::array<CyclingColorSet, 4> cycleSet{ CyclingColorSet{ 214, 4, false }, CyclingColorSet{ 218, 4, false }, CyclingColorSet{ 231, 5, true },
+                                                   CyclingColorSet{ 238, 4, false } };
 
-    static const std::array<CyclingColorSet, 4> cycleSet{ CyclingColorSet{ 214, 4, false }, CyclingColorSet{ 218, 4, false }, CyclingColorSet{ 231, 5, true },
-                                                          CyclingColorSet{ 238, 4, false } };
+    // All cycling palettes repeat after this number of steps, which is the least common multiple of the lengths of all color sets.
+    const uint32_t cyclingPaletteCount = 20;
 
-    for ( const CyclingColorSet & colorSet : cycleSet ) {
-        if ( colorSet.forward ) {
-            for ( uint32_t id = 0; id < colorSet.length; ++id ) {
-                const uint32_t newColorID = colorSet.start + ( ( id + stepId ) % colorSet.length );
-                palette[colorSet.start + id] = static_cast<uint8_t>( newColorID );
+    std::vector<uint8_t> generateCyclingPalette( const uint32_t stepId )
+    {
+        std::vector<uint8_t> palette = PAL::GetPalette( PAL::PaletteType::STANDARD );
+
+        for ( const CyclingColorSet & colorSet : cycleSet ) {
+            assert( cyclingPaletteCount % colorSet.length == 0 );
+
+            if ( colorSet.forward ) {
+                for ( uint32_t id = 0; id < colorSet.length; ++id ) {
+                    const uint32_t newColorID = colorSet.start + ( ( id + stepId ) % colorSet.length );
+                    palette[colorSet.start + id] = static_cast<uint8_t>( newColorID );
+                }
+            }
+            else {
+                const uint32_t lastColorID = colorSet.length - 1;
+                const uint32_t lastColor = colorSet.start + lastColorID;
+                const uint32_t colorOffset = stepId + lastColorID;
+
+                for ( uint32_t id = 0; id < colorSet.length; ++id ) {
+                    const uint32_t newColorID = lastColor - ( ( colorOffset - id ) % colorSet.length );
+                    palette[colorSet.start + id] = static_cast<uint8_t>( newColorID );
+                }
             }
         }
-        else {
-            const uint32_t lastColorID = colorSet.length - 1;
-            const uint32_t lastColor = colorSet.start + lastColorID;
-            const uint32_t colorOffset = stepId + lastColorID;
 
+        return palette;
+    }
+
+    std::array<bool, paletteSize> generateCyclingColorFlags()
+    {
+        std::array<bool, paletteSize> flags{};
+
+        for ( const CyclingColorSet & colorSet : cycleSet ) {
             for ( uint32_t id = 0; id < colorSet.length; ++id ) {
-                const uint32_t newColorID = lastColor - ( ( colorOffset - id ) % colorSet.length );
-                palette[colorSet.start + id] = static_cast<uint8_t>( newColorID );
+                flags[colorSet.start + id] = true;
             }
         }
+
+        return flags;
+    }
+}
+
+const std::vector<uint8_t> & PAL::GetCyclingPalette( const uint32_t stepId )
+{
+    static const std::vector<std::vector<uint8_t>> palettes = []() {
+        std::vector<std::vector<uint8_t>> result;
+        result.reserve( cyclingPaletteCount );
+
+        for ( uint32_t step = 0; step < cyclingPaletteCount; ++step ) {
+            result.emplace_back( generateCyclingPalette( step ) );
+        }
+
+        return result;
+    }();
+
+    return palettes[stepId % cyclingPaletteCount];
+}
+
+bool PAL::ContainsCyclingColors( const uint8_t * data, const size_t size )
+{
+    assert( data != nullptr || size == 0 );
+
+    static const std::array<bool, paletteSize> isCyclingColor = generateCyclingColorFlags();
+
+    const uint8_t * dataEnd = data + size;
+    for ( ; data != dataEnd; ++data ) {
+        if ( isCyclingColor[*data] ) {
+            return true;
+        }
     }
 
-    return palette;
+    return false;
 }
 
 const std::vector<uint8_t> & PAL::GetPalette( const PaletteType type )
@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -44,7 +45,11 @@ namespace PAL
         CUSTOM
     };
 
-    std::vector<uint8_t> GetCyclingPalette( const uint32_t stepId );
+    const std::vector<uint8_t> & GetCyclingPalette( const uint32_t stepId );
+
+    // Returns true if any of the given color indexes is changed by color cycling.
+    bool ContainsCyclingColors( const uint8_t * data, const size_t size );
+
     const std::vector<uint8_t> & GetPalette( const PaletteType type );
     std::vector<uint8_t> CombinePalettes( const std::vector<uint8_t> & first, const std::vector<uint8_t> & second );
 }
@@ -0,0 +1,213 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "perf_counters.h"
+
+#include <algorithm>
+#include <cassert>
+#include <fstream>
+#include <ios>
+
+#include "logging.h"
+
+namespace
+{
+    size_t getBucketId( uint64_t value )
+    {
+        size_t bucketId = 0;
+        while ( value > 0 && bucketId + 1 < fheroes2::PerfCounters::bucketCount ) {
+            value >>= 1;
+            ++bucketId;
+        }
+
+        return bucketId;
+    }
+}
+
+namespace fheroes2
+{
+    const char * getPerfCounterName( const PerfCounter counter )
+    {
+        switch ( counter ) {
+        case PerfCounter::FRAMES:
+            return "Frames";
+        case PerfCounter::FRAME_ARENA_HEAP_ALLOCATIONS:
+            return "Frame arena heap allocations";
+        case PerfCounter::PATHFINDER_RUNS:
+            return "Pathfinder runs";
+        case PerfCounter::PATHFINDER_EXPANDED_NODES:
+            return "Pathfinder expanded nodes";
+        case PerfCounter::NETWORK_BYTES_SENT:
+            return "Network bytes sent";
+        case PerfCounter::NETWORK_BYTES_RECEIVED:
+            return "Network bytes received";
+        default:
+            // Did you add a new counter? Add the logic above!
+            assert( 0 );
+            break;
+        }
+
+        return "Unknown";
+    }
+
+    const char * getPerfHistogramName( const PerfHistogram histogram )
+    {
+        switch ( histogram ) {
+        case PerfHistogram::FRAME_TIME_US:
+            return "Frame time (us)";
+        case PerfHistogram::PATHFINDER_EXPANDED_NODES:
+            return "Pathfinder expanded nodes per run";
+        case PerfHistogram::AI_TURN_TIME_MS:
+            return "AI turn time (ms)";
+        default:
+            // Did you add a new histogram? Add the logic above!
+            assert( 0 );
+            break;
+        }
+
+        return "Unknown";
+    }
+
+    uint64_t PerfCounters::HistogramStatistics::getPercentile( const double fraction ) const
+    {
+        if ( sampleCount == 0 ) {
+            return 0;
+        }
+
+        const uint64_t sampleLimit = static_cast<uint64_t>( std::clamp( fraction, 0.0, 1.0 ) * static_cast<double>( sampleCount ) );
+
+        uint64_t accountedSamples = 0;
+        for ( size_t i = 0; i < bucketCount - 1; ++i ) {
+            accountedSamples += buckets[i];
+            if ( accountedSamples >= sampleLimit && accountedSamples > 0 ) {
+                // The upper bound of the bucket.
+                const uint64_t bucketLimit = ( i == 0 ) ? 0 : ( ( static_cast<uint64_t>( 1 ) << i ) - 1 );
+                return std::min( bucketLimit, max );
+            }
+        }
+
+        return max;
+    }
+
+    PerfCounters & PerfCounters::instance()
+    {
+        static PerfCounters counters;
+        return counters;
+    }
+
+    void PerfCounters::enable()
+    {
+        if ( isEnabled() ) {
+            return;
+        }
+
+        _collectionTimer.reset();
+        _frameTimer.reset();
+
+        _isEnabled.store( true, std::memory_order_relaxed );
+    }
+
+    void PerfCounters::addSample( const PerfHistogram histogram, const uint64_t value )
+    {
+        Histogram & data = _histograms[static_cast<size_t>( histogram )];
+
+        data.sampleCount.fetch_add( 1, std::memory_order_relaxed );
+        data.sum.fetch_add( value, std::memory_order_relaxed );
+        data.buckets[getBucketId( value )].fetch_add( 1, std::memory_order_relaxed );
+
+        uint64_t currentMax = data.max.load( std::memory_order_relaxed );
+        while ( currentMax < value && !data.max.compare_exchange_weak( currentMax, value, std::memory_order_relaxed ) ) {
+            // Another thread has updated the value, try again.
+        }
+    }
+
+    PerfCounters::HistogramStatistics PerfCounters::getHistogram( const PerfHistogram histogram ) const
+    {
+        const Histogram & data = _histograms[static_cast<size_t>( histogram )];
+
+        HistogramStatistics statistics;
+        statistics.sampleCount = data.sampleCount.load( std::memory_order_relaxed );
+        statistics.sum = data.sum.load( std::memory_order_relaxed );
+        statistics.max = data.max.load( std::memory_order_relaxed );
+
+        for ( size_t i = 0; i < bucketCount; ++i ) {
+            statistics.buckets[i] = data.buckets[i].load( std::memory_order_relaxed );
+        }
+
+        return statistics;
+    }
+
+    void PerfCounters::finishFrame()
+    {
+        if ( !isEnabled() ) {
+            return;
+        }
+
+        const auto frameTimeUs = static_cast<uint64_t>( _frameTimer.getS() * 1000000 );
+        _frameTimer.reset();
+
+        add( PerfCounter::FRAMES, 1 );
+        addSample( PerfHistogram::FRAME_TIME_US, frameTimeUs );
+    }
+
+    bool PerfCounters::writeReport( const std::string & filePath ) const
+    {
+        std::ofstream file( filePath, std::ios_base::trunc );
+        if ( !file ) {
+            ERROR_LOG( "Failed to open file " << filePath << " to write the performance report." )
+            return false;
+        }
+
+        file << "Collection time (s): " << getCollectionTimeS() << '\n';
+
+        file << "\nCounters\n";
+        for ( size_t i = 0; i < counterCount; ++i ) {
+            const PerfCounter counter = static_cast<PerfCounter>( i );
+            file << getPerfCounterName( counter ) << ": " << getCounter( counter ) << '\n';
+        }
+
+        file << "\nHistograms: samples, average, 50%, 90%, 99%, max\n";
+        for ( size_t i = 0; i < histogramCount; ++i ) {
+            const PerfHistogram histogram = static_cast<PerfHistogram>( i );
+            const HistogramStatistics statistics = getHistogram( histogram );
+
+            file << getPerfHistogramName( histogram ) << ": " << statistics.sampleCount << ", "
+                 << ( statistics.sampleCount > 0 ? statistics.sum / statistics.sampleCount : 0 ) << ", " << statistics.getPercentile( 0.5 ) << ", "
+                 << statistics.getPercentile( 0.9 ) << ", " << statistics.getPercentile( 0.99 ) << ", " << statistics.max << '\n';
+
+            // Buckets are written with their lower bounds, empty buckets are skipped.
+            for ( size_t bucketId = 0; bucketId < bucketCount; ++bucketId ) {
+                if ( statistics.buckets[bucketId] == 0 ) {
+                    continue;
+                }
+
+                const uint64_t lowerBound = ( bucketId == 0 ) ? 0 : ( static_cast<uint64_t>( 1 ) << ( bucketId - 1 ) );
+                file << "    >= " << lowerBound << ": " << statistics.buckets[bucketId] << '\n';
+            }
+        }
+
+        if ( !file ) {
+            ERROR_LOG( "Failed to write the performance report to file " << filePath )
+            return false;
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,161 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "timing.h"
+
+namespace fheroes2
+{
+    // Events which are counted for the whole session.
+    enum class PerfCounter : uint8_t
+    {
+        FRAMES,
+        FRAME_ARENA_HEAP_ALLOCATIONS,
+        PATHFINDER_RUNS,
+        PATHFINDER_EXPANDED_NODES,
+        NETWORK_BYTES_SENT,
+        NETWORK_BYTES_RECEIVED,
+
+        // IMPORTANT!!! This must be the last entry.
+        COUNT
+    };
+
+    // Values which distribution is collected for the whole session.
+    enum class PerfHistogram : uint8_t
+    {
+        FRAME_TIME_US,
+        PATHFINDER_EXPANDED_NODES,
+        AI_TURN_TIME_MS,
+
+        // IMPORTANT!!! This must be the last entry.
+        COUNT
+    };
+
+    const char * getPerfCounterName( const PerfCounter counter );
+
+    const char * getPerfHistogramName( const PerfHistogram histogram );
+
+    // Registry of performance counters and histograms shared by all parts of the application. Nothing is collected until the registry
+    // is enabled, so a disabled registry costs a single check of a flag per update. Updates can be done from any thread.
+    class PerfCounters
+    {
+    public:
+        static constexpr size_t counterCount{ static_cast<size_t>( PerfCounter::COUNT ) };
+        static constexpr size_t histogramCount{ static_cast<size_t>( PerfHistogram::COUNT ) };
+
+        // Bucket 0 contains zero values, bucket N contains values from 2^(N-1) to 2^N - 1. The last bucket contains all bigger values as well.
+        static constexpr size_t bucketCount{ 32 };
+
+        struct HistogramStatistics
+        {
+            uint64_t sampleCount{ 0 };
+            uint64_t sum{ 0 };
+            uint64_t max{ 0 };
+            std::array<uint64_t, bucketCount> buckets{};
+
+            // Returns an estimate of the value which is not exceeded by the given fraction of samples. It is precise up to a power of 2.
+            uint64_t getPercentile( const double fraction ) const;
+        };
+
+        PerfCounters( const PerfCounters & ) = delete;
+
+        ~PerfCounters() = default;
+
+        PerfCounters & operator=( const PerfCounters & ) = delete;
+
+        static PerfCounters & instance();
+
+        bool isEnabled() const
+        {
+            return _isEnabled.load( std::memory_order_relaxed );
+        }
+
+        // Once enabled, the statistics are collected till the end of the application.
+        void enable();
+
+        void add( const PerfCounter counter, const uint64_t value )
+        {
+            _counters[static_cast<size_t>( counter )].fetch_add( value, std::memory_order_relaxed );
+        }
+
+        void addSample( const PerfHistogram histogram, const uint64_t value );
+
+        uint64_t getCounter( const PerfCounter counter ) const
+        {
+            return _counters[static_cast<size_t>( counter )].load( std::memory_order_relaxed );
+        }
+
+        HistogramStatistics getHistogram( const PerfHistogram histogram ) const;
+
+        // Accounts a rendered frame and the time passed since the previous one. It must be called from the rendering thread only.
+        void finishFrame();
+
+        // Returns the time in seconds since the registry has been enabled.
+        double getCollectionTimeS() const
+        {
+            return _collectionTimer.getS();
+        }
+
+        // Writes all collected statistics into a human-readable text file.
+        bool writeReport( const std::string & filePath ) const;
+
+    private:
+        struct Histogram
+        {
+            std::atomic<uint64_t> sampleCount;
+            std::atomic<uint64_t> sum;
+            std::atomic<uint64_t> max;
+            std::array<std::atomic<uint64_t>, bucketCount> buckets;
+        };
+
+        PerfCounters() = default;
+
+        std::array<std::atomic<uint64_t>, counterCount> _counters{};
+        std::array<Histogram, histogramCount> _histograms{};
+
+        fheroes2::Time _collectionTimer;
+        fheroes2::Time _frameTimer;
+
+        std::atomic<bool> _isEnabled{ false };
+    };
+
+    inline void addPerfCounter( const PerfCounter counter, const uint64_t value = 1 )
+    {
+        PerfCounters & counters = PerfCounters::instance();
+        if ( counters.isEnabled() ) {
+            counters.add( counter, value );
+        }
+    }
+
+    inline void addPerfSample( const PerfHistogram histogram, const uint64_t value )
+    {
+        PerfCounters & counters = PerfCounters::instance();
+        if ( counters.isEnabled() ) {
+            counters.addSample( histogram, value );
+        }
+    }
+}
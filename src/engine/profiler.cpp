@@ -0,0 +1,148 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "profiler.h"
+
+#include <algorithm>
+#include <cassert>
+#include <ios>
+
+#include "logging.h"
+
+namespace
+{
+    // Statistics to display are updated once per this period.
+    const double averagingPeriodS{ 1.0 };
+}
+
+namespace fheroes2
+{
+    const char * getProfilerSectionName( const ProfilerSection section )
+    {
+        switch ( section ) {
+        case ProfilerSection::EVENT_HANDLING:
+            return "Events";
+        case ProfilerSection::ADVENTURE_MAP_AREA:
+            return "Map area";
+        case ProfilerSection::RADAR:
+            return "Radar";
+        case ProfilerSection::CASTLE_SCREEN:
+            return "Castle";
+        case ProfilerSection::BATTLEFIELD:
+            return "Battlefield";
+        case ProfilerSection::DISPLAY_RENDER:
+            return "Render";
+        default:
+            // Did you add a new section? Add the logic above!
+            assert( 0 );
+            break;
+        }
+
+        return "Unknown";
+    }
+
+    Profiler & Profiler::instance()
+    {
+        static Profiler profiler;
+        return profiler;
+    }
+
+    void Profiler::enable( const std::string & csvFilePath )
+    {
+        disable();
+
+        _currentFrameTime.fill( 0 );
+        _periodTime.fill( 0 );
+        _averageSectionTimeMs.fill( 0 );
+        _averageFrameTimeMs = 0;
+        _frameId = 0;
+        _periodFrameCount = 0;
+
+        if ( !csvFilePath.empty() ) {
+            _csvFile.open( csvFilePath, std::ios_base::trunc );
+            if ( _csvFile ) {
+                _csvFile << "frame,frame time (ms)";
+                for ( size_t i = 0; i < sectionCount; ++i ) {
+                    _csvFile << ',' << getProfilerSectionName( static_cast<ProfilerSection>( i ) ) << " (ms)";
+                }
+                _csvFile << '\n';
+            }
+            else {
+                ERROR_LOG( "Failed to open file " << csvFilePath << " to write profiler data." )
+            }
+        }
+
+        _frameTimer.reset();
+        _periodTimer.reset();
+
+        _isEnabled = true;
+    }
+
+    void Profiler::disable()
+    {
+        _isEnabled = false;
+
+        if ( _csvFile.is_open() ) {
+            _csvFile.close();
+        }
+    }
+
+    void Profiler::finishFrame()
+    {
+        if ( !_isEnabled ) {
+            return;
+        }
+
+        const double frameTimeS = _frameTimer.getS();
+        _frameTimer.reset();
+
+        if ( _csvFile.is_open() ) {
+            _csvFile << _frameId << ',' << frameTimeS * 1000;
+            for ( const double timeS : _currentFrameTime ) {
+                _csvFile << ',' << timeS * 1000;
+            }
+            _csvFile << '\n';
+        }
+
+        ++_frameId;
+        ++_periodFrameCount;
+
+        for ( size_t i = 0; i < sectionCount; ++i ) {
+            _periodTime[i] += _currentFrameTime[i];
+        }
+
+        _currentFrameTime.fill( 0 );
+
+        const double periodTimeS = _periodTimer.getS();
+        if ( periodTimeS < averagingPeriodS ) {
+            return;
+        }
+
+        _periodTimer.reset();
+
+        _averageFrameTimeMs = periodTimeS * 1000 / _periodFrameCount;
+
+        std::transform( _periodTime.begin(), _periodTime.end(), _averageSectionTimeMs.begin(),
+                        [frameCount = _periodFrameCount]( const double timeS ) { return timeS * 1000 / frameCount; } );
+
+        _periodTime.fill( 0 );
+        _periodFrameCount = 0;
+    }
+}
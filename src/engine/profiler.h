@@ -0,0 +1,138 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#include "timing.h"
+
+namespace fheroes2
+{
+    // Parts of a frame which time is measured by the profiler. The time of sections might overlap if one of them is called from another one.
+    enum class ProfilerSection : uint8_t
+    {
+        EVENT_HANDLING,
+        ADVENTURE_MAP_AREA,
+        RADAR,
+        CASTLE_SCREEN,
+        BATTLEFIELD,
+        DISPLAY_RENDER,
+
+        // IMPORTANT!!! This must be the last entry.
+        COUNT
+    };
+
+    const char * getProfilerSectionName( const ProfilerSection section );
+
+    class Profiler
+    {
+    public:
+        static constexpr size_t sectionCount{ static_cast<size_t>( ProfilerSection::COUNT ) };
+
+        Profiler( const Profiler & ) = delete;
+
+        ~Profiler() = default;
+
+        Profiler & operator=( const Profiler & ) = delete;
+
+        static Profiler & instance();
+
+        bool isEnabled() const
+        {
+            return _isEnabled;
+        }
+
+        // Enabling the profiler resets all collected statistics. If the CSV file path is not empty then the time of every frame is written into this file.
+        void enable( const std::string & csvFilePath );
+
+        void disable();
+
+        void addSectionTime( const ProfilerSection section, const double timeS )
+        {
+            _currentFrameTime[static_cast<size_t>( section )] += timeS;
+        }
+
+        // Completes the current frame. It is called once the frame is rendered on the screen.
+        void finishFrame();
+
+        // Returns average times in milliseconds of the whole frame and of every section for the latest completed period of one second.
+        double getAverageFrameTimeMs() const
+        {
+            return _averageFrameTimeMs;
+        }
+
+        const std::array<double, sectionCount> & getAverageSectionTimeMs() const
+        {
+            return _averageSectionTimeMs;
+        }
+
+    private:
+        Profiler() = default;
+
+        std::array<double, sectionCount> _currentFrameTime{};
+        std::array<double, sectionCount> _periodTime{};
+        std::array<double, sectionCount> _averageSectionTimeMs{};
+
+        std::ofstream _csvFile;
+
+        fheroes2::Time _frameTimer;
+        fheroes2::Time _periodTimer;
+
+        uint64_t _frameId{ 0 };
+        uint32_t _periodFrameCount{ 0 };
+
+        double _averageFrameTimeMs{ 0 };
+
+        bool _isEnabled{ false };
+    };
+
+    // Measures the time of the section till the end of the scope. It does nothing if the profiler is disabled.
+    class ProfilerScopedTimer
+    {
+    public:
+        explicit ProfilerScopedTimer( const ProfilerSection section )
+            : _section( section )
+            , _isActive( Profiler::instance().isEnabled() )
+        {
+            // Do nothing.
+        }
+
+        ProfilerScopedTimer( const ProfilerScopedTimer & ) = delete;
+
+        ~ProfilerScopedTimer()
+        {
+            if ( _isActive ) {
+                Profiler::instance().addSectionTime( _section, _timer.getS() );
+            }
+        }
+
+        ProfilerScopedTimer & operator=( const ProfilerScopedTimer & ) = delete;
+
+    private:
+        fheroes2::Time _timer;
+        const ProfilerSection _section;
+        const bool _isActive;
+    };
+}
@@ -28,58 +28,53 @@
 
 namespace
 {
-    // Implementation of Fast Random Integer Generation in an Interval (https://arxiv.org/abs/1805.10941)
-    // NOTE: we can't use std::uniform_int_distribution here because it behaves differently on different platforms
-    uint32_t uniformIntInInterval( const uint32_t range, Rand::PCG32 & gen )
+    // This is the same as (2**32 - range) % range in the two's complement representation
+    uint32_t getDiscardBound( const uint32_t range )
     {
-        assert( range > 0 );
-
-        // Our implementation assumes our RNG can use the entire range of uint32_t
-        static_assert( Rand::PCG32::min() == 0 && Rand::PCG32::max() == std::numeric_limits<uint32_t>::max() );
-
-        uint32_t generated = gen();
-        uint64_t mult = ( static_cast<uint64_t>( generated ) * range );
-        uint32_t lowerPart = static_cast<uint32_t>( mult );
-
-        if ( lowerPart >= range ) {
-            const uint32_t upperPart = static_cast<uint32_t>( mult >> 32 );
-            assert( upperPart <= range );
-
-            return upperPart;
-        }
+        return static_cast<uint32_t>( ~( range - 1 ) ) % range;
+    }
+}
 
-        // This is the same as (2**32 - range) % range in the two's complement representation
-        const uint32_t discardBound = static_cast<uint32_t>( ~( range - 1 ) ) % range;
+uint32_t Rand::uniformIntInIntervalRetry( const uint32_t range, uint64_t mult, PCG32 & gen )
+{
+    const uint32_t discardBound = getDiscardBound( range );
 
-        while ( lowerPart < discardBound ) {
-            generated = gen();
-            mult = ( static_cast<uint64_t>( generated ) * range );
-            lowerPart = static_cast<uint32_t>( mult );
-        }
+    while ( static_cast<uint32_t>( mult ) < discardBound ) {
+        mult = static_cast<uint64_t>( gen() ) * range;
+    }
 
-        const uint32_t upperPart = static_cast<uint32_t>( mult >> 32 );
-        assert( upperPart <= range );
+    const uint32_t upperPart = static_cast<uint32_t>( mult >> 32 );
+    assert( upperPart < range );
 
-        return upperPart;
-    }
+    return upperPart;
 }
 
-uint32_t Rand::uniformIntDistribution( const uint32_t from, const uint32_t to, PCG32 & gen )
+void Rand::uniformIntDistribution( const uint32_t from, const uint32_t to, PCG32 & gen, uint32_t * result, const size_t count )
 {
     if ( from == to ) {
-        return from;
+        std::fill( result, result + count, from );
+        return;
     }
 
     assert( from < to );
     const uint32_t rangeExclusive = to - from;
-    // If the range is the entire uint32_t (from 0 to 2**32-1), we can just return a random number
     if ( rangeExclusive == std::numeric_limits<uint32_t>::max() ) {
-        static_assert( PCG32::min() == 0 && PCG32::max() == std::numeric_limits<uint32_t>::max() );
-
-        return gen();
+        gen.fill( result, count );
+        return;
     }
 
-    return from + uniformIntInInterval( rangeExclusive + 1, gen );
+    const uint32_t range = rangeExclusive + 1;
+    const uint32_t discardBound = getDiscardBound( range );
+
+    for ( size_t i = 0; i < count; ++i ) {
+        uint64_t mult = static_cast<uint64_t>( gen() ) * range;
+
+        while ( static_cast<uint32_t>( mult ) < discardBound ) {
+            mult = static_cast<uint64_t>( gen() ) * range;
+        }
+
+        result[i] = from + static_cast<uint32_t>( mult >> 32 );
+    }
 }
 
 Rand::PCG32 & Rand::CurrentThreadRandomDevice()
@@ -109,15 +104,6 @@ uint32_t Rand::GetWithSeed( uint32_t from, uint32_t to, uint32_t seed )
     return uniformIntDistribution( from, to, seededGen );
 }
 
-uint32_t Rand::GetWithGen( uint32_t from, uint32_t to, PCG32 & gen )
-{
-    if ( from > to ) {
-        std::swap( from, to );
-    }
-
-    return uniformIntDistribution( from, to, gen );
-}
-
 int32_t Rand::Queue::Get( const std::function<uint32_t( uint32_t )> & randomFunc ) const
 {
     if ( empty() ) {
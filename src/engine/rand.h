@@ -25,6 +25,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 // IWYU issue workaround. When <exception> is included IWYU will remove it and require <string>.
@@ -86,6 +87,54 @@ namespace Rand
             _increment = stream;
         }
 
+        // Moves the generator 'delta' steps forward (the same as calling operator() 'delta' times) in O(log(delta)) time.
+        // See "Random Number Generation with Arbitrary Strides" by F. B. Brown for details.
+        constexpr void advance( uint64_t delta )
+        {
+            uint64_t accumulatedMultiplier = 1;
+            uint64_t accumulatedIncrement = 0;
+            uint64_t currentMultiplier = multiplier;
+            uint64_t currentIncrement = _increment | 1;
+
+            while ( delta > 0 ) {
+                if ( delta & 1 ) {
+                    accumulatedMultiplier *= currentMultiplier;
+                    accumulatedIncrement = accumulatedIncrement * currentMultiplier + currentIncrement;
+                }
+
+                currentIncrement = ( currentMultiplier + 1 ) * currentIncrement;
+                currentMultiplier *= currentMultiplier;
+                delta >>= 1;
+            }
+
+            _state = accumulatedMultiplier * _state + accumulatedIncrement;
+        }
+
+        // Returns a new generator for the given stream without changing the state of this generator. The result depends only on
+        // the current state of this generator and 'streamId', so it can be used to seed per-worker generators reproducibly.
+        constexpr PCG32 fork( const uint64_t streamId ) const
+        {
+            // The lowest bit of the increment is always set, so stream identifiers are shifted to keep all streams different.
+            return PCG32( mixBits( _state ^ mixBits( streamId ) ), ( streamId << 1 ) | 1 );
+        }
+
+        // Returns a new independent generator seeded by this generator. The state of this generator is changed.
+        PCG32 split()
+        {
+            const uint64_t seed = generateUInt64( *this );
+            const uint64_t stream = generateUInt64( *this );
+
+            return PCG32( seed, stream );
+        }
+
+        // Fills the given buffer with random values, the same as calling operator() 'count' times.
+        constexpr void fill( uint32_t * data, const size_t count )
+        {
+            for ( size_t i = 0; i < count; ++i ) {
+                data[i] = operator()();
+            }
+        }
+
     private:
         static constexpr uint64_t multiplier = 6364136223846793005ULL;
         static constexpr uint64_t defaultStream = 54ULL;
@@ -96,6 +145,14 @@ namespace Rand
             return ( value >> rotations ) | ( value << ( ( ~( rotations - 1 ) ) & 31 ) );
         }
 
+        // SplitMix64 finalizer, it makes close input values produce unrelated results.
+        static constexpr uint64_t mixBits( uint64_t value )
+        {
+            value = ( value ^ ( value >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+            value = ( value ^ ( value >> 27 ) ) * 0x94D049BB133111EBULL;
+            return value ^ ( value >> 31 );
+        }
+
         // Defines a new templated false value to be used in static_assert
         // See https://devblogs.microsoft.com/oldnewthing/20200311-00/?p=103553
         template <typename T>
@@ -126,7 +183,48 @@ namespace Rand
         uint64_t _increment;
     };
 
-    uint32_t uniformIntDistribution( const uint32_t from, const uint32_t to, PCG32 & gen );
+    // Continues the generation of a random value in [0, range) when the first generated value falls into the biased part of the range.
+    // 'mult' is the product of the first generated value and 'range'. This function is not supposed to be called directly.
+    uint32_t uniformIntInIntervalRetry( const uint32_t range, uint64_t mult, PCG32 & gen );
+
+    // Implementation of Fast Random Integer Generation in an Interval (https://arxiv.org/abs/1805.10941)
+    // NOTE: we can't use std::uniform_int_distribution here because it behaves differently on different platforms
+    inline uint32_t uniformIntInInterval( const uint32_t range, PCG32 & gen )
+    {
+        assert( range > 0 );
+
+        // Our implementation assumes our RNG can use the entire range of uint32_t
+        static_assert( PCG32::min() == 0 && PCG32::max() == std::numeric_limits<uint32_t>::max() );
+
+        const uint64_t mult = static_cast<uint64_t>( gen() ) * range;
+
+        // Most values are accepted right away, without calculating the rejection threshold which requires a division.
+        if ( static_cast<uint32_t>( mult ) >= range ) {
+            return static_cast<uint32_t>( mult >> 32 );
+        }
+
+        return uniformIntInIntervalRetry( range, mult, gen );
+    }
+
+    inline uint32_t uniformIntDistribution( const uint32_t from, const uint32_t to, PCG32 & gen )
+    {
+        if ( from == to ) {
+            return from;
+        }
+
+        assert( from < to );
+        const uint32_t rangeExclusive = to - from;
+        // If the range is the entire uint32_t (from 0 to 2**32-1), we can just return a random number
+        if ( rangeExclusive == std::numeric_limits<uint32_t>::max() ) {
+            return gen();
+        }
+
+        return from + uniformIntInInterval( rangeExclusive + 1, gen );
+    }
+
+    // Fills the given buffer with random values in [from, to]. The result is exactly the same as the result of calling
+    // uniformIntDistribution() 'count' times, but the rejection threshold is calculated only once for all values.
+    void uniformIntDistribution( const uint32_t from, const uint32_t to, PCG32 & gen, uint32_t * result, const size_t count );
 
     // Fisher-Yates shuffle AKA Knuth shuffle, probably the same as std::shuffle.
     // NOTE: we can't use std::shuffle here because it uses std::uniform_int_distribution which behaves differently on different platforms.
@@ -177,7 +275,14 @@ namespace Rand
         return static_cast<T>( GetWithSeed( static_cast<uint32_t>( from ), static_cast<uint32_t>( to ), seed ) );
     }
 
-    uint32_t GetWithGen( uint32_t from, uint32_t to, PCG32 & gen );
+    inline uint32_t GetWithGen( uint32_t from, uint32_t to, PCG32 & gen )
+    {
+        if ( from > to ) {
+            std::swap( from, to );
+        }
+
+        return uniformIntDistribution( from, to, gen );
+    }
 
     template <typename T>
     void Shuffle( std::vector<T> & vec )
@@ -32,7 +32,7 @@ namespace fheroes2
         return processor;
     }
 
-    bool RenderProcessor::preRenderAction( std::vector<uint8_t> & palette )
+    const std::vector<uint8_t> * RenderProcessor::preRenderAction()
     {
         // We consider the start of rendering to be the moment when we reset the timer for the next frame.
         // This is because we have no control over how long the entire rendering process will take,
@@ -40,7 +40,7 @@ namespace fheroes2
         _lastRenderCall.reset();
 
         if ( !_enableCycling ) {
-            return false;
+            return nullptr;
         }
 
         if ( _enableRenderers && _preRenderer ) {
@@ -50,7 +50,7 @@ namespace fheroes2
         const uint64_t cyclingTime = _previousCyclingInterval + _cyclingTimer.getMs();
         if ( cyclingTime < ( _cyclingInterval * 2 - _frameHalfInterval ) ) {
             // If the current timer is less than cycling internal minus half of the frame generation then nothing is needed.
-            return false;
+            return nullptr;
         }
 
         _previousCyclingInterval = cyclingTime - _cyclingInterval;
@@ -64,9 +64,9 @@ namespace fheroes2
 
         // TODO: here we need to deduct possible time difference from the current time to have consistent FPS.
         _cyclingTimer.reset();
-        palette = PAL::GetCyclingPalette( _cyclingCounter );
+        const std::vector<uint8_t> & palette = PAL::GetCyclingPalette( _cyclingCounter );
         ++_cyclingCounter;
-        return true;
+        return &palette;
     }
 
     void RenderProcessor::postRenderAction() const
@@ -61,7 +61,8 @@ namespace fheroes2
             _enableRenderers = false;
         }
 
-        bool preRenderAction( std::vector<uint8_t> & palette );
+        // Returns the palette of the next color cycling step or nullptr if the palette must not be changed.
+        const std::vector<uint8_t> * preRenderAction();
 
         void postRenderAction() const;
 
@@ -87,6 +88,18 @@ namespace fheroes2
             return _enableCycling && _cyclingTimer.getMs() + _previousCyclingInterval >= 2 * _cyclingInterval && _lastRenderCall.getMs() > _frameHalfInterval;
         }
 
+        // Returns the time in milliseconds left until the next color cycling update, or UINT64_MAX if color cycling is disabled.
+        uint64_t getTimeUntilCyclingUpdate() const
+        {
+            if ( !_enableCycling ) {
+                return UINT64_MAX;
+            }
+
+            const uint64_t passedMs = _cyclingTimer.getMs() + _previousCyclingInterval;
+
+            return passedMs >= 2 * _cyclingInterval ? 0 : 2 * _cyclingInterval - passedMs;
+        }
+
     private:
         RenderProcessor() = default;
 
@@ -19,8 +19,10 @@
  ***************************************************************************/
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <iterator>
@@ -59,9 +61,13 @@
 #include <vita2d.h>
 #endif
 
+#include "frame_arena.h"
 #include "image_palette.h"
 #include "logging.h"
 #include "math_tools.h"
+#include "pal.h"
+#include "perf_counters.h"
+#include "profiler.h"
 #include "screen.h"
 #include "system.h"
 
@@ -263,10 +269,81 @@ namespace
         return true;
     }
 
+    // Every area is uploaded to the texture separately, so too many small areas are rendered as their bounding area.
+    const size_t maxRenderAreaCount{ 8 };
+
+    int64_t getRectArea( const fheroes2::Rect & rect )
+    {
+        return static_cast<int64_t>( rect.width ) * rect.height;
+    }
+
+    bool isRectOverlapping( const fheroes2::Rect & first, const fheroes2::Rect & second )
+    {
+        return first.x < second.x + second.width && second.x < first.x + first.width && first.y < second.y + second.height && second.y < first.y + first.height;
+    }
+
+    // Merges overlapping areas and areas which are close enough to each other, so that their bounding area is not much bigger than the areas themselves.
+    void mergeRenderAreas( std::vector<fheroes2::Rect> & areas )
+    {
+        bool isMerged = true;
+
+        while ( isMerged && areas.size() > 1 ) {
+            isMerged = false;
+
+            for ( size_t i = 0; i < areas.size() && !isMerged; ++i ) {
+                for ( size_t j = i + 1; j < areas.size(); ++j ) {
+                    const fheroes2::Rect boundary = fheroes2::getBoundaryRect( areas[i], areas[j] );
+
+                    // Allow the bounding area to be at most a third bigger than the areas themselves.
+                    if ( isRectOverlapping( areas[i], areas[j] ) || getRectArea( boundary ) * 3 <= ( getRectArea( areas[i] ) + getRectArea( areas[j] ) ) * 4 ) {
+                        areas[i] = boundary;
+                        areas.erase( areas.begin() + static_cast<ptrdiff_t>( j ) );
+
+                        isMerged = true;
+                        break;
+                    }
+                }
+            }
+        }
+
+        if ( areas.size() > maxRenderAreaCount ) {
+            fheroes2::Rect boundary = areas.front();
+            for ( const fheroes2::Rect & area : areas ) {
+                boundary = fheroes2::getBoundaryRect( boundary, area );
+            }
+
+            areas.clear();
+            areas.push_back( boundary );
+        }
+    }
+
     const uint8_t * currentPalette = PALPalette();
 
 // If SDL library is used
 #if !defined( TARGET_PS_VITA )
+    // Converts 8-bit image rows into 32-bit pixels using the given palette. Pitches are in bytes. The rows of big areas are converted in parallel.
+    void convertImageRows( const uint8_t * in, const int32_t inPitch, uint8_t * out, const int32_t outPitch, const int32_t width, const int32_t height,
+                           const uint32_t * palette )
+    {
+        const auto convertRows = [in, inPitch, out, outPitch, width, palette]( const int32_t beginY, const int32_t endY ) {
+            const uint8_t * inY = in + static_cast<ptrdiff_t>( beginY ) * inPitch;
+            uint8_t * outY = out + static_cast<ptrdiff_t>( beginY ) * outPitch;
+
+            for ( int32_t y = beginY; y < endY; ++y, inY += inPitch, outY += outPitch ) {
+                uint32_t * outX = reinterpret_cast<uint32_t *>( outY );
+                const uint32_t * outXEnd = outX + width;
+                const uint8_t * inX = inY;
+
+                for ( ; outX != outXEnd; ++outX, ++inX ) {
+                    *outX = *( palette + *inX );
+                }
+            }
+        };
+
+        // The conversion of a pixel is cheaper than most of image operations so the jobs are bigger.
+        fheroes2::processRowsInParallel( width, height, convertRows, 64 * 1024 );
+    }
+
     class BaseSDLRenderer
     {
     protected:
@@ -293,13 +370,7 @@ namespace
 
             if ( fullFrame ) {
                 if ( surface->format->BitsPerPixel == 32 ) {
-                    uint32_t * out = static_cast<uint32_t *>( surface->pixels );
-                    const uint32_t * outEnd = out + imageWidth * imageHeight;
-                    const uint8_t * in = imageIn;
-                    const uint32_t * transform = _palette32Bit.data();
-
-                    for ( ; out != outEnd; ++out, ++in )
-                        *out = *( transform + *in );
+                    convertImageRows( imageIn, imageWidth, static_cast<uint8_t *>( surface->pixels ), imageWidth * 4, imageWidth, imageHeight, _palette32Bit.data() );
                 }
                 else if ( ( surface->format->BitsPerPixel == 8 ) && ( surface->pixels != imageIn ) ) {
                     if ( imageWidth % 4 != 0 ) {
@@ -315,19 +386,8 @@ namespace
             }
             else {
                 if ( surface->format->BitsPerPixel == 32 ) {
-                    uint32_t * outY = static_cast<uint32_t *>( surface->pixels );
-                    const uint32_t * outYEnd = outY + imageWidth * roi.height;
-                    const uint8_t * inY = imageIn + roi.x + roi.y * imageWidth;
-                    const uint32_t * transform = _palette32Bit.data();
-
-                    for ( ; outY != outYEnd; outY += imageWidth, inY += imageWidth ) {
-                        uint32_t * outX = outY;
-                        const uint32_t * outXEnd = outX + roi.width;
-                        const uint8_t * inX = inY;
-
-                        for ( ; outX != outXEnd; ++outX, ++inX )
-                            *outX = *( transform + *inX );
-                    }
+                    convertImageRows( imageIn + roi.x + roi.y * imageWidth, imageWidth, static_cast<uint8_t *>( surface->pixels ), imageWidth * 4, roi.width,
+                                      roi.height, _palette32Bit.data() );
                 }
                 else if ( ( surface->format->BitsPerPixel == 8 ) && ( surface->pixels != imageIn ) ) {
                     const int32_t screenWidth = ( imageWidth / 4 ) * 4 + 4;
@@ -344,6 +404,16 @@ namespace
                 SDL_UnlockSurface( surface );
         }
 
+        // Converts an area of the image into 32-bit pixels of a buffer with the given pitch in bytes.
+        void copyImageToPixels( const fheroes2::Image & image, const fheroes2::Rect & roi, uint8_t * pixels, const int pitch ) const
+        {
+            assert( pixels != nullptr && !image.empty() && _palette32Bit.size() == 256 );
+
+            const int32_t imageWidth = image.width();
+
+            convertImageRows( image.image() + roi.x + roi.y * imageWidth, imageWidth, pixels, pitch, roi.width, roi.height, _palette32Bit.data() );
+        }
+
         void generatePalette( const std::vector<uint8_t> & colorIds, const SDL_Surface * surface )
         {
             assert( surface != nullptr );
@@ -1083,6 +1153,7 @@ namespace
         fheroes2::Size _windowedSize;
 
         bool _isVSyncEnabled{ false };
+        bool _isStreamingTexture{ false };
 
         RenderEngine() = default;
 
@@ -1093,6 +1164,8 @@ namespace
                 _texture = nullptr;
             }
 
+            _isStreamingTexture = false;
+
             if ( _renderer != nullptr ) {
                 SDL_DestroyRenderer( _renderer );
                 _renderer = nullptr;
@@ -1126,16 +1199,62 @@ namespace
 
             assert( _renderer != nullptr && _texture != nullptr );
 
-            copyImageToSurface( display, _surface, roi );
+            _updateTexture( display, roi );
+            _present();
+        }
+
+        void renderAreas( const fheroes2::Display & display, const std::vector<fheroes2::Rect> & areas ) override
+        {
+            if ( _surface == nullptr ) {
+                return;
+            }
+
+            assert( _renderer != nullptr && _texture != nullptr );
+
+            // Only the changed areas are converted and uploaded to the texture, but the whole texture is presented.
+            for ( const fheroes2::Rect & roi : areas ) {
+                _updateTexture( display, roi );
+            }
+
+            _present();
+        }
 
+        // Converts the given area of the display into the texture.
+        void _updateTexture( const fheroes2::Display & display, const fheroes2::Rect & roi )
+        {
             const bool fullFrame = ( roi.width == display.width() ) && ( roi.height == display.height() );
-            if ( fullFrame ) {
+
+            if ( _isStreamingTexture ) {
+                SDL_Rect area;
+                area.x = roi.x;
+                area.y = roi.y;
+                area.w = roi.width;
+                area.h = roi.height;
+
+                void * pixels = nullptr;
+                int pitch = 0;
+
+                // Pixels are converted directly into the texture memory without an intermediate copy in the surface.
+                const int returnCode = SDL_LockTexture( _texture, fullFrame ? nullptr : &area, &pixels, &pitch );
+                if ( returnCode < 0 ) {
+                    ERROR_LOG( "Failed to lock texture. The error value: " << returnCode << ", description: " << SDL_GetError() )
+                }
+                else {
+                    copyImageToPixels( display, roi, static_cast<uint8_t *>( pixels ), pitch );
+                    SDL_UnlockTexture( _texture );
+                }
+            }
+            else if ( fullFrame ) {
+                copyImageToSurface( display, _surface, roi );
+
                 const int returnCode = SDL_UpdateTexture( _texture, nullptr, _surface->pixels, _surface->pitch );
                 if ( returnCode < 0 ) {
                     ERROR_LOG( "Failed to update texture. The error value: " << returnCode << ", description: " << SDL_GetError() )
                 }
             }
             else {
+                copyImageToSurface( display, _surface, roi );
+
                 SDL_Rect area;
                 area.x = roi.x;
                 area.y = roi.y;
@@ -1147,7 +1266,10 @@ namespace
                     ERROR_LOG( "Failed to update texture. The error value: " << returnCode << ", description: " << SDL_GetError() )
                 }
             }
+        }
 
+        void _present()
+        {
             int returnCode = SDL_RenderClear( _renderer );
             if ( returnCode < 0 ) {
                 ERROR_LOG( "Failed to clear renderer. The error value: " << returnCode << ", description: " << SDL_GetError() )
@@ -1302,7 +1424,16 @@ namespace
                 return false;
             }
 
-            _texture = SDL_CreateTextureFromSurface( _renderer, _surface );
+            if ( _surface->format->BitsPerPixel == 32 ) {
+                // Colors of a streaming texture can be written directly. The texture has the surface pixel format to use the same palette.
+                _texture = SDL_CreateTexture( _renderer, _surface->format->format, SDL_TEXTUREACCESS_STREAMING, _surface->w, _surface->h );
+                _isStreamingTexture = ( _texture != nullptr );
+            }
+
+            if ( _texture == nullptr ) {
+                _texture = SDL_CreateTextureFromSurface( _renderer, _surface );
+            }
+
             if ( _texture == nullptr ) {
                 ERROR_LOG( "Failed to create a texture from a surface of " << resolutionInfo.gameWidth << " x " << resolutionInfo.gameHeight
                                                                            << " size. The error: " << SDL_GetError() )
@@ -1326,12 +1457,49 @@ namespace
             if ( _surface == nullptr || colorIds.size() != 256 )
                 return;
 
+            if ( _surface->format->BitsPerPixel != 8 ) {
+                generatePalette( colorIds, _surface );
+                return;
+            }
+
+            const bool isPaletteSet = ( _palette8Bit.size() == 256 );
+
+            std::array<SDL_Color, 256> previousPalette;
+            if ( isPaletteSet ) {
+                std::copy( _palette8Bit.begin(), _palette8Bit.end(), previousPalette.begin() );
+            }
+
             generatePalette( colorIds, _surface );
-            if ( _surface->format->BitsPerPixel == 8 ) {
-                const int returnCode = SDL_SetPaletteColors( _surface->format->palette, _palette8Bit.data(), 0, 256 );
-                if ( returnCode < 0 ) {
-                    ERROR_LOG( "Failed to set palette color. The error value: " << returnCode << ", description: " << SDL_GetError() )
+
+            // Only the range of changed colors is uploaded. Color cycling changes only a few of them.
+            int firstColorId = 0;
+            int lastColorId = 255;
+
+            if ( isPaletteSet ) {
+                const auto isSameColor = [&previousPalette, this]( const int colorId ) {
+                    const SDL_Color & previous = previousPalette[colorId];
+                    const SDL_Color & current = _palette8Bit[colorId];
+                    return previous.r == current.r && previous.g == current.g && previous.b == current.b;
+                };
+
+                while ( firstColorId <= lastColorId && isSameColor( firstColorId ) ) {
+                    ++firstColorId;
                 }
+
+                if ( firstColorId > lastColorId ) {
+                    // Nothing has changed.
+                    return;
+                }
+
+                while ( isSameColor( lastColorId ) ) {
+                    --lastColorId;
+                }
+            }
+
+            const int returnCode
+                = SDL_SetPaletteColors( _surface->format->palette, _palette8Bit.data() + firstColorId, firstColorId, lastColorId - firstColorId + 1 );
+            if ( returnCode < 0 ) {
+                ERROR_LOG( "Failed to set palette color. The error value: " << returnCode << ", description: " << SDL_GetError() )
             }
         }
 
@@ -1345,6 +1513,9 @@ namespace
             if ( _surface == nullptr )
                 return;
 
+            // The palette of a new surface must be fully set.
+            _palette8Bit.clear();
+
             updatePalette( StandardPaletteIndexes() );
 
             if ( _surface->format->BitsPerPixel == 8 ) {
@@ -1439,6 +1610,20 @@ namespace fheroes2
         Display::instance().linkRenderSurface( surface );
     }
 
+    void BaseRenderEngine::renderAreas( const Display & display, const std::vector<Rect> & areas )
+    {
+        if ( areas.empty() ) {
+            return;
+        }
+
+        Rect boundary = areas.front();
+        for ( const Rect & area : areas ) {
+            boundary = getBoundaryRect( boundary, area );
+        }
+
+        render( display, boundary );
+    }
+
     Display::Display()
         : _engine( RenderEngine::create() )
         , _cursor( RenderCursor::create() )
@@ -1467,7 +1652,7 @@ namespace fheroes2
         // deallocate engine resources
         _engine->clear();
 
-        _prevRoi = {};
+        _prevRenderAreas.clear();
 
         // allocate engine resources
         if ( !_engine->allocate( info, isFullScreen ) ) {
@@ -1487,7 +1672,7 @@ namespace fheroes2
         // deallocate engine resources
         _engine->clear();
 
-        _prevRoi = {};
+        _prevRenderAreas.clear();
 
         ResolutionInfo res( width(), height(), _screenSize.width, _screenSize.height );
 
@@ -1515,55 +1700,76 @@ namespace fheroes2
             return;
         }
 
-        if ( _cursor->isVisible() && _cursor->isSoftwareEmulation() && !_cursor->_image.empty() ) {
-            const Sprite & cursorImage = _cursor->_image;
-            Rect cursorROI( cursorImage.x(), cursorImage.y(), cursorImage.width(), cursorImage.height() );
+        {
+            const ProfilerScopedTimer renderTimer( ProfilerSection::DISPLAY_RENDER );
 
-            if ( _cursor->_keepInScreenArea ) {
-                cursorROI.x = std::clamp( cursorROI.x, 0, width() - cursorROI.width );
-                cursorROI.y = std::clamp( cursorROI.y, 0, height() - cursorROI.height );
-            }
+            _frameAreas.clear();
+            _frameAreas.push_back( temp );
 
-            const Sprite backup = Crop( *this, cursorROI.x, cursorROI.y, cursorROI.width, cursorROI.height );
-            Blit( cursorImage, 0, 0, *this, cursorROI.x, cursorROI.y, cursorROI.width, cursorROI.height );
+            if ( _cursor->isVisible() && _cursor->isSoftwareEmulation() && !_cursor->_image.empty() ) {
+                const Sprite & cursorImage = _cursor->_image;
+                Rect cursorROI( cursorImage.x(), cursorImage.y(), cursorImage.width(), cursorImage.height() );
 
-            // ROI must include cursor's area as well, otherwise cursor won't be rendered.
-            if ( !backup.empty() && getActiveArea( cursorROI, width(), height() ) ) {
-                temp = getBoundaryRect( temp, cursorROI );
-            }
+                if ( _cursor->_keepInScreenArea ) {
+                    cursorROI.x = std::clamp( cursorROI.x, 0, width() - cursorROI.width );
+                    cursorROI.y = std::clamp( cursorROI.y, 0, height() - cursorROI.height );
+                }
 
-            _renderFrame( temp );
+                const Sprite backup = Crop( *this, cursorROI.x, cursorROI.y, cursorROI.width, cursorROI.height );
+                Blit( cursorImage, 0, 0, *this, cursorROI.x, cursorROI.y, cursorROI.width, cursorROI.height );
 
-            if ( _postprocessing ) {
-                _postprocessing();
-            }
+                // Cursor's area must be rendered as well, otherwise cursor won't be rendered.
+                if ( !backup.empty() && getActiveArea( cursorROI, width(), height() ) ) {
+                    _frameAreas.push_back( cursorROI );
+                }
 
-            Copy( backup, 0, 0, *this, backup.x(), backup.y(), backup.width(), backup.height() );
-        }
-        else {
-            _renderFrame( temp );
+                _renderFrame( _frameAreas );
 
-            if ( _postprocessing ) {
-                _postprocessing();
+                if ( _postprocessing ) {
+                    _postprocessing();
+                }
+
+                Copy( backup, 0, 0, *this, backup.x(), backup.y(), backup.width(), backup.height() );
+            }
+            else {
+                _renderFrame( _frameAreas );
+
+                if ( _postprocessing ) {
+                    _postprocessing();
+                }
             }
+
+            std::swap( _prevRenderAreas, _frameAreas );
         }
 
-        _prevRoi = temp;
+        Profiler::instance().finishFrame();
+        PerfCounters::instance().finishFrame();
+
+        // All temporary objects of the frame are no longer needed.
+        FrameArena & frameArena = FrameArena::instance();
+        frameArena.reset();
+
+        addPerfCounter( PerfCounter::FRAME_ARENA_HEAP_ALLOCATIONS, frameArena.getLastFrameStatistics().heapAllocationCount );
     }
 
     void Display::updateNextRenderRoi( const Rect & roi )
     {
-        _prevRoi = getBoundaryRect( _prevRoi, roi );
-        getActiveArea( _prevRoi, width(), height() );
+        Rect area( roi );
+        if ( getActiveArea( area, width(), height() ) ) {
+            _prevRenderAreas.push_back( area );
+        }
     }
 
-    void Display::_renderFrame( const Rect & roi ) const
+    void Display::_renderFrame( const std::vector<Rect> & frameAreas ) const
     {
         bool updateImage = true;
         if ( _preprocessing ) {
-            std::vector<uint8_t> palette;
-            if ( _preprocessing( palette ) ) {
-                _engine->updatePalette( palette );
+            const std::vector<uint8_t> * palette = _preprocessing();
+
+            // There is no reason to update the palette and to render the whole frame if none of the cycling colors are on the screen.
+            // The next cycling step will be applied once any of them appear.
+            if ( palette != nullptr && PAL::ContainsCyclingColors( image(), static_cast<size_t>( width() ) * static_cast<size_t>( height() ) ) ) {
+                _engine->updatePalette( *palette );
                 // when we change a palette for 8-bit image we unwillingly call render so we don't need to re-render the same frame again
                 updateImage = ( _renderSurface == nullptr );
                 if ( updateImage ) {
@@ -1575,8 +1781,18 @@ namespace fheroes2
         }
 
         if ( updateImage ) {
-            // Make sure that we update the previously rendered area to avoid any ghost effect artefacts.
-            _engine->render( *this, getBoundaryRect( roi, _prevRoi ) );
+            // Make sure that we update the previously rendered areas to avoid any ghost effect artefacts.
+            _renderAreas.assign( frameAreas.begin(), frameAreas.end() );
+            _renderAreas.insert( _renderAreas.end(), _prevRenderAreas.begin(), _prevRenderAreas.end() );
+
+            mergeRenderAreas( _renderAreas );
+
+            if ( _renderAreas.size() == 1 ) {
+                _engine->render( *this, _renderAreas.front() );
+            }
+            else {
+                _engine->renderAreas( *this, _renderAreas );
+            }
         }
     }
 
@@ -1596,7 +1812,7 @@ namespace fheroes2
         _cursor.reset();
         clear();
 
-        _prevRoi = {};
+        _prevRenderAreas.clear();
     }
 
     void Display::changePalette( const uint8_t * palette, const bool forceDefaultPaletteUpdate ) const
@@ -167,6 +167,9 @@ namespace fheroes2
             // Do nothing.
         }
 
+        // Renders a frame in which only the given non-overlapping areas have been changed. By default, their bounding area is rendered.
+        virtual void renderAreas( const Display & display, const std::vector<Rect> & areas );
+
         virtual bool allocate( ResolutionInfo & /*unused*/, bool /*unused*/ )
         {
             return false;
@@ -238,8 +241,8 @@ namespace fheroes2
 
         void setWindowPos( const Point point );
 
-        // this function must return true if new palette has been generated
-        using PreRenderProcessing = std::function<bool( std::vector<uint8_t> & )>;
+        // this function must return a new palette if it has been generated or nullptr otherwise
+        using PreRenderProcessing = std::function<const std::vector<uint8_t> *()>;
         using PostRenderProcessing = std::function<void()>;
 
         void subscribe( const PreRenderProcessing & preprocessing, const PostRenderProcessing & postprocessing )
@@ -274,8 +277,12 @@ namespace fheroes2
 
         uint8_t * _renderSurface{ nullptr };
 
-        // Previous area drawn on the screen.
-        Rect _prevRoi;
+        // Areas drawn on the screen during the previous frame.
+        std::vector<Rect> _prevRenderAreas;
+
+        // Areas drawn during the current frame and all areas to be rendered on the screen. They are members to avoid memory allocations on every frame.
+        std::vector<Rect> _frameAreas;
+        mutable std::vector<Rect> _renderAreas;
 
         Size _screenSize;
 
@@ -287,7 +294,8 @@ namespace fheroes2
 
         Display();
 
-        void _renderFrame( const Rect & roi ) const; // prepare and render a frame
+        // Prepares and renders a frame in which the given areas have been drawn.
+        void _renderFrame( const std::vector<Rect> & frameAreas ) const;
     };
 
     class Cursor
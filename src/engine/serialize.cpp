@@ -24,6 +24,7 @@
 #include "serialize.h"
 
 #include <algorithm>
+#include <array>
 #include <cstring>
 #include <ostream>
 #include <string>
@@ -44,6 +45,39 @@
 namespace
 {
     const size_t minBufferCapacity = 1024;
+
+    // Reverses the byte order of each of 'count' integers of 'elementSize' bytes each. These loops are simple enough to be vectorized by
+    // the compiler.
+    void swapByteOrder( uint8_t * data, const size_t count, const size_t elementSize )
+    {
+        switch ( elementSize ) {
+        case 1:
+            break;
+        case 2:
+            for ( size_t i = 0; i < count; ++i ) {
+                uint16_t v;
+                std::memcpy( &v, data + i * 2, 2 );
+
+                v = static_cast<uint16_t>( ( v << 8 ) | ( v >> 8 ) );
+
+                std::memcpy( data + i * 2, &v, 2 );
+            }
+            break;
+        case 4:
+            for ( size_t i = 0; i < count; ++i ) {
+                uint32_t v;
+                std::memcpy( &v, data + i * 4, 4 );
+
+                v = ( v << 24 ) | ( ( v << 8 ) & 0x00FF0000 ) | ( ( v >> 8 ) & 0x0000FF00 ) | ( v >> 24 );
+
+                std::memcpy( data + i * 4, &v, 4 );
+            }
+            break;
+        default:
+            assert( 0 );
+            break;
+        }
+    }
 }
 
 void StreamBase::setBigendian( bool f )
@@ -76,6 +110,19 @@ uint32_t IStreamBase::get32()
     return bigendian() ? getBE32() : getLE32();
 }
 
+uint64_t IStreamBase::get64()
+{
+    if ( bigendian() ) {
+        const uint64_t hi = getBE32();
+
+        return ( hi << 32 ) | getBE32();
+    }
+
+    const uint64_t lo = getLE32();
+
+    return lo | ( static_cast<uint64_t>( getLE32() ) << 32 );
+}
+
 IStreamBase & IStreamBase::operator>>( bool & v )
 {
     v = ( get8() != 0 );
@@ -132,11 +179,18 @@ IStreamBase & IStreamBase::operator>>( uint32_t & v )
     return *this;
 }
 
+IStreamBase & IStreamBase::operator>>( uint64_t & v )
+{
+    v = get64();
+
+    return *this;
+}
+
 IStreamBase & IStreamBase::operator>>( std::string & v )
 {
     v.resize( get32() );
 
-    std::for_each( v.begin(), v.end(), [this]( char & item ) { item = get8(); } );
+    readRaw( v.data(), v.size() );
 
     return *this;
 }
@@ -146,6 +200,15 @@ IStreamBase & IStreamBase::operator>>( fheroes2::Point & v )
     return *this >> v.x >> v.y;
 }
 
+void IStreamBase::getArray( void * ptr, const size_t count, const size_t elementSize )
+{
+    readRaw( ptr, count * elementSize );
+
+    if ( bigendian() != IS_BIGENDIAN ) {
+        swapByteOrder( static_cast<uint8_t *>( ptr ), count, elementSize );
+    }
+}
+
 void OStreamBase::put16( uint16_t v )
 {
     bigendian() ? putBE16( v ) : putLE16( v );
@@ -156,6 +219,21 @@ void OStreamBase::put32( uint32_t v )
     bigendian() ? putBE32( v ) : putLE32( v );
 }
 
+void OStreamBase::put64( uint64_t v )
+{
+    const uint32_t lo = static_cast<uint32_t>( v & 0xFFFFFFFF );
+    const uint32_t hi = static_cast<uint32_t>( v >> 32 );
+
+    if ( bigendian() ) {
+        putBE32( hi );
+        putBE32( lo );
+    }
+    else {
+        putLE32( lo );
+        putLE32( hi );
+    }
+}
+
 OStreamBase & OStreamBase::operator<<( const bool v )
 {
     put8( v );
@@ -212,6 +290,13 @@ OStreamBase & OStreamBase::operator<<( const uint32_t v )
     return *this;
 }
 
+OStreamBase & OStreamBase::operator<<( const uint64_t v )
+{
+    put64( v );
+
+    return *this;
+}
+
 OStreamBase & OStreamBase::operator<<( const std::string_view v )
 {
     put32( static_cast<uint32_t>( v.size() ) );
@@ -227,6 +312,29 @@ OStreamBase & OStreamBase::operator<<( const fheroes2::Point & v )
     return *this << v.x << v.y;
 }
 
+void OStreamBase::putArray( const void * ptr, const size_t count, const size_t elementSize )
+{
+    if ( bigendian() == IS_BIGENDIAN || elementSize == 1 ) {
+        putRaw( ptr, count * elementSize );
+        return;
+    }
+
+    // The source data cannot be modified, so it is converted piece by piece in a temporary buffer.
+    std::array<uint8_t, 4096> buffer;
+
+    const size_t countPerChunk = buffer.size() / elementSize;
+    const uint8_t * data = static_cast<const uint8_t *>( ptr );
+
+    for ( size_t offset = 0; offset < count; offset += countPerChunk ) {
+        const size_t chunkCount = std::min( countPerChunk, count - offset );
+
+        std::memcpy( buffer.data(), data + offset * elementSize, chunkCount * elementSize );
+        swapByteOrder( buffer.data(), chunkCount, elementSize );
+
+        putRaw( buffer.data(), chunkCount * elementSize );
+    }
+}
+
 RWStreamBuf::RWStreamBuf( const size_t size )
 {
     if ( size ) {
@@ -377,6 +485,18 @@ ROStreamBuf::ROStreamBuf( std::vector<uint8_t> && buf )
     setBigendian( IS_BIGENDIAN );
 }
 
+ROStreamBuf::ROStreamBuf( const uint8_t * data, const size_t size )
+{
+    assert( data != nullptr || size == 0 );
+
+    _itbeg = data;
+    _itend = _itbeg + size;
+    _itget = _itbeg;
+    _itput = _itend;
+
+    setBigendian( IS_BIGENDIAN );
+}
+
 std::pair<const uint8_t *, size_t> ROStreamBuf::getRawView( const size_t size /* = 0 */ )
 {
     const size_t remainSize = sizeg();
@@ -610,6 +730,24 @@ std::vector<uint8_t> StreamFile::getRaw( const size_t size )
     return v;
 }
 
+void StreamFile::readRaw( void * ptr, const size_t size )
+{
+    if ( size == 0 ) {
+        return;
+    }
+
+    if ( !_file ) {
+        std::memset( ptr, 0, size );
+        return;
+    }
+
+    if ( std::fread( ptr, size, 1, _file.get() ) != 1 ) {
+        std::memset( ptr, 0, size );
+
+        setFail();
+    }
+}
+
 void StreamFile::putRaw( const void * ptr, size_t size )
 {
     if ( size == 0 ) {
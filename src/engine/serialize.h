@@ -150,6 +150,12 @@ private:
     uint32_t _flags{ 0 };
 };
 
+// Integral types (except bool) whose serialized form is their in-memory representation in the byte order of the stream, so that arrays
+// of these types can be read and written as a single block of memory
+template <typename Type>
+inline constexpr bool isBulkSerializable
+    = std::is_integral_v<Type> && !std::is_same_v<Type, bool> && ( sizeof( Type ) == 1 || sizeof( Type ) == 2 || sizeof( Type ) == 4 );
+
 // Interface that declares the methods needed to read from a stream
 class IStreamBase : virtual public StreamBase
 {
@@ -170,8 +176,13 @@ public:
     // If a zero size is specified, then all still unread data is returned
     virtual std::vector<uint8_t> getRaw( size_t ) = 0;
 
+    // Reads exactly 'size' bytes of data to the given memory region. If there is not enough data, the rest of the region is filled with zeros
+    // and the stream is marked as failed.
+    virtual void readRaw( void * ptr, const size_t size ) = 0;
+
     uint16_t get16();
     uint32_t get32();
+    uint64_t get64();
 
     uint8_t get()
     {
@@ -186,6 +197,7 @@ public:
     IStreamBase & operator>>( uint16_t & v );
     IStreamBase & operator>>( int32_t & v );
     IStreamBase & operator>>( uint32_t & v );
+    IStreamBase & operator>>( uint64_t & v );
     IStreamBase & operator>>( std::string & v );
 
     IStreamBase & operator>>( fheroes2::Point & v );
@@ -231,7 +243,12 @@ public:
     {
         v.resize( get32() );
 
-        std::for_each( v.begin(), v.end(), [this]( auto & item ) { *this >> item; } );
+        if constexpr ( isBulkSerializable<Type> ) {
+            getArray( v.data(), v.size(), sizeof( Type ) );
+        }
+        else {
+            std::for_each( v.begin(), v.end(), [this]( auto & item ) { *this >> item; } );
+        }
 
         return *this;
     }
@@ -276,7 +293,12 @@ public:
             return *this;
         }
 
-        std::for_each( v.begin(), v.end(), [this]( auto & item ) { *this >> item; } );
+        if constexpr ( isBulkSerializable<Type> ) {
+            getArray( v.data(), v.size(), sizeof( Type ) );
+        }
+        else {
+            std::for_each( v.begin(), v.end(), [this]( auto & item ) { *this >> item; } );
+        }
 
         return *this;
     }
@@ -285,6 +307,10 @@ protected:
     IStreamBase() = default;
 
     virtual uint8_t get8() = 0;
+
+private:
+    // Reads 'count' integers of 'elementSize' bytes each, converting them from the byte order of the stream to the system byte order
+    void getArray( void * ptr, const size_t count, const size_t elementSize );
 };
 
 // Interface that declares the methods needed to write to a stream
@@ -306,6 +332,7 @@ public:
 
     void put16( uint16_t );
     void put32( uint32_t );
+    void put64( uint64_t );
 
     void put( const uint8_t ch )
     {
@@ -320,6 +347,7 @@ public:
     OStreamBase & operator<<( const uint16_t v );
     OStreamBase & operator<<( const int32_t v );
     OStreamBase & operator<<( const uint32_t v );
+    OStreamBase & operator<<( const uint64_t v );
     OStreamBase & operator<<( const std::string_view v );
 
     OStreamBase & operator<<( const fheroes2::Point & v );
@@ -354,7 +382,12 @@ public:
     {
         put32( static_cast<uint32_t>( v.size() ) );
 
-        std::for_each( v.begin(), v.end(), [this]( const auto & item ) { *this << item; } );
+        if constexpr ( isBulkSerializable<Type> ) {
+            putArray( v.data(), v.size(), sizeof( Type ) );
+        }
+        else {
+            std::for_each( v.begin(), v.end(), [this]( const auto & item ) { *this << item; } );
+        }
 
         return *this;
     }
@@ -384,7 +417,12 @@ public:
     {
         put32( static_cast<uint32_t>( v.size() ) );
 
-        std::for_each( v.begin(), v.end(), [this]( const auto & item ) { *this << item; } );
+        if constexpr ( isBulkSerializable<Type> ) {
+            putArray( v.data(), v.size(), sizeof( Type ) );
+        }
+        else {
+            std::for_each( v.begin(), v.end(), [this]( const auto & item ) { *this << item; } );
+        }
 
         return *this;
     }
@@ -393,6 +431,10 @@ protected:
     OStreamBase() = default;
 
     virtual void put8( const uint8_t ) = 0;
+
+private:
+    // Writes 'count' integers of 'elementSize' bytes each, converting them from the system byte order to the byte order of the stream
+    void putArray( const void * ptr, const size_t count, const size_t elementSize );
 };
 
 // Interface that declares a stream with an in-memory storage backend that can be read from
@@ -502,6 +544,22 @@ public:
         return v;
     }
 
+    void readRaw( void * ptr, const size_t size ) override
+    {
+        const size_t sizeToCopy = std::min( size, sizeg() );
+
+        uint8_t * out = static_cast<uint8_t *>( ptr );
+
+        std::copy( _itget, _itget + sizeToCopy, out );
+        std::fill( out + sizeToCopy, out + size, static_cast<uint8_t>( 0 ) );
+
+        _itget += sizeToCopy;
+
+        if ( sizeToCopy < size ) {
+            setFail();
+        }
+    }
+
     // Reads no more than 'size' bytes of data (if a zero size is specified, then all still unread data
     // is read), forms a string that ends with the first null character found in this data (or includes
     // all data if this data does not contain null characters), and returns this string
@@ -599,6 +657,8 @@ public:
     explicit ROStreamBuf( const std::vector<uint8_t> & buf );
     // Takes ownership of the given buffer (through the move operation) and creates a stream on top of it
     explicit ROStreamBuf( std::vector<uint8_t> && buf );
+    // Creates a non-owning stream on top of an external memory region ("view mode")
+    ROStreamBuf( const uint8_t * data, const size_t size );
 
     ROStreamBuf( const ROStreamBuf & ) = delete;
 
@@ -659,6 +719,8 @@ public:
     // If a zero size is specified, then all still unread data is returned
     std::vector<uint8_t> getRaw( const size_t size ) override;
 
+    void readRaw( void * ptr, const size_t size ) override;
+
     void putRaw( const void * ptr, size_t size ) override;
 
     // Reads no more than 'size' bytes of data (if a zero size is specified, then all still unread data
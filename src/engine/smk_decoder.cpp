@@ -23,20 +23,29 @@
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <condition_variable>
+#include <cstddef>
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
+#include <deque>
+#include <mutex>
 #include <ostream>
+#include <utility>
 
 #include "exception.h"
 #include "image.h"
 #include "logging.h"
 #include "serialize.h"
+#include "thread.h"
 
 namespace
 {
     const size_t audioHeaderSize = 44;
 
+    // Memory held by all open video sequences.
+    size_t videoMemoryUsage{ 0 };
+
     void verifyVideoFile( const std::string & filePath )
     {
         if ( filePath.empty() ) {
@@ -61,6 +70,177 @@ namespace
     }
 }
 
+// Video frames are decoded in the worker thread in advance and are kept in a queue of decoded frames. The main thread takes the frames from
+// the front of this queue, buffers of used frames are returned to a pool and reused for the next decoded frames.
+class SMKVideoSequence::FrameDecoder final : public MultiThreading::AsyncManager
+{
+public:
+    struct Frame
+    {
+        std::vector<uint8_t> pixels;
+        std::vector<uint8_t> palette;
+        // Whether the palette differs from the palette of the previous frame.
+        bool isPaletteChanged{ true };
+    };
+
+    FrameDecoder( smk_t * videoFile, const unsigned long frameCount, const size_t frameSize )
+        : _videoFile( videoFile )
+        , _frameCount( frameCount )
+        , _frameSize( frameSize )
+    {
+        assert( _videoFile != nullptr && _frameCount > 0 );
+    }
+
+    void start()
+    {
+        createWorker();
+
+        const std::scoped_lock<std::mutex> lock( _mutex );
+
+        notifyWorker();
+    }
+
+    // Returns the frame at the front of the queue, waits for it to be decoded if necessary. The returned frame remains valid until it is
+    // removed from the queue by the same thread.
+    const Frame & getFrontFrame()
+    {
+        std::unique_lock<std::mutex> lock( _mutex );
+
+        _frameNotification.wait( lock, [this]() { return !_decodedFrames.empty(); } );
+
+        return _decodedFrames.front();
+    }
+
+    void removeFrontFrame()
+    {
+        std::unique_lock<std::mutex> lock( _mutex );
+
+        _frameNotification.wait( lock, [this]() { return !_decodedFrames.empty(); } );
+
+        _freeFrames.emplace_back( std::move( _decodedFrames.front() ) );
+        _decodedFrames.pop_front();
+
+        notifyWorker();
+    }
+
+    // Restarts decoding from the first frame. All frames that have been decoded so far are discarded.
+    void reset()
+    {
+        const std::scoped_lock<std::mutex> lock( _mutex );
+
+        for ( Frame & frame : _decodedFrames ) {
+            _freeFrames.emplace_back( std::move( frame ) );
+        }
+        _decodedFrames.clear();
+
+        _nextFrameId = 0;
+        ++_generation;
+
+        notifyWorker();
+    }
+
+    // Returns the size of all frame buffers once the decoding is running at full speed.
+    size_t getBufferSize() const
+    {
+        // A decoded frame in the queue can be accompanied by the frame being decoded.
+        return ( framesToDecodeAhead + 1 ) * _frameSize;
+    }
+
+private:
+    // Video frames are quite large, so only a few of them are decoded in advance.
+    static constexpr size_t framesToDecodeAhead{ 4 };
+
+    smk_t * const _videoFile;
+    const unsigned long _frameCount;
+    const size_t _frameSize;
+
+    std::condition_variable _frameNotification;
+
+    std::deque<Frame> _decodedFrames;
+    std::vector<Frame> _freeFrames;
+
+    unsigned long _nextFrameId{ 0 };
+    // Incremented on every reset so that a frame which was being decoded during the reset is discarded.
+    uint32_t _generation{ 0 };
+
+    // These members are used only by the worker thread.
+    std::vector<uint8_t> _previousPalette;
+    Frame _taskFrame;
+    unsigned long _taskFrameId{ 0 };
+    uint32_t _taskGeneration{ 0 };
+    bool _isTaskPrepared{ false };
+
+    // This method is called by the worker thread and is protected by _mutex
+    bool prepareTask() override
+    {
+        _isTaskPrepared = false;
+
+        if ( _nextFrameId >= _frameCount || _decodedFrames.size() >= framesToDecodeAhead ) {
+            return false;
+        }
+
+        _taskFrameId = _nextFrameId;
+        _taskGeneration = _generation;
+
+        ++_nextFrameId;
+
+        if ( !_freeFrames.empty() ) {
+            _taskFrame = std::move( _freeFrames.back() );
+            _freeFrames.pop_back();
+        }
+
+        _isTaskPrepared = true;
+
+        return true;
+    }
+
+    // This method is called by the worker thread, but is not protected by _mutex
+    void executeTask() override
+    {
+        if ( !_isTaskPrepared ) {
+            return;
+        }
+
+        // Frames of the same generation are always decoded one after another, so only the first frame requires rewinding the video.
+        if ( _taskFrameId == 0 ) {
+            if ( const signed char returnValue = smk_first( _videoFile ); returnValue < 0 ) {
+                ERROR_LOG( "smk_first() failed with error code: " << static_cast<int>( returnValue ) )
+            }
+        }
+        else if ( const signed char returnValue = smk_next( _videoFile ); returnValue < 0 ) {
+            ERROR_LOG( "smk_next() failed with error code: " << static_cast<int>( returnValue ) )
+        }
+
+        const uint8_t * data = smk_get_video( _videoFile );
+        const uint8_t * paletteData = smk_get_palette( _videoFile );
+        assert( data != nullptr && paletteData != nullptr );
+
+        _taskFrame.pixels.assign( data, data + _frameSize );
+        _taskFrame.palette.assign( paletteData, paletteData + 256 * 3 );
+
+        // Most of the videos never change their palette, so it is compared here and not by the main thread on every frame.
+        _taskFrame.isPaletteChanged = ( _taskFrameId == 0 || _taskFrame.palette != _previousPalette );
+        if ( _taskFrame.isPaletteChanged ) {
+            _previousPalette = _taskFrame.palette;
+        }
+
+        {
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
+            if ( _taskGeneration == _generation ) {
+                _decodedFrames.emplace_back( std::move( _taskFrame ) );
+            }
+            else {
+                _freeFrames.emplace_back( std::move( _taskFrame ) );
+            }
+        }
+
+        _taskFrame = {};
+
+        _frameNotification.notify_all();
+    }
+};
+
 SMKVideoSequence::SMKVideoSequence( const std::string & filePath )
 {
     verifyVideoFile( filePath );
@@ -221,32 +401,60 @@ SMKVideoSequence::SMKVideoSequence( const std::string & filePath )
     if ( const signed char returnValue = smk_first( _videoFile.get() ); returnValue < 0 ) {
         ERROR_LOG( "smk_first() failed with error code: " << static_cast<int>( returnValue ) )
     }
+
+    if ( _frameCount > 0 ) {
+        // From now on the video file is accessed only by the frame decoder.
+        _frameDecoder = std::make_unique<FrameDecoder>( _videoFile.get(), _frameCount, static_cast<size_t>( width ) * height );
+        _frameDecoder->start();
+
+        _memoryUsage = _frameDecoder->getBufferSize();
+    }
+
+    for ( const std::vector<uint8_t> & channel : _audioChannel ) {
+        _memoryUsage += channel.capacity();
+    }
+
+    videoMemoryUsage += _memoryUsage;
+}
+
+SMKVideoSequence::~SMKVideoSequence()
+{
+    if ( _frameDecoder ) {
+        _frameDecoder->stopWorker();
+    }
+
+    assert( videoMemoryUsage >= _memoryUsage );
+    videoMemoryUsage -= _memoryUsage;
+}
+
+size_t SMKVideoSequence::getTotalMemoryUsage()
+{
+    return videoMemoryUsage;
 }
 
 void SMKVideoSequence::resetFrame()
 {
-    if ( !_videoFile ) {
+    if ( !_frameDecoder ) {
         return;
     }
 
-    if ( const signed char returnValue = smk_first( _videoFile.get() ); returnValue < 0 ) {
-        ERROR_LOG( "smk_first() failed with error code: " << static_cast<int>( returnValue ) )
-    }
+    _frameDecoder->reset();
 
     _currentFrameId = 0;
 }
 
-void SMKVideoSequence::getCurrentFrame( fheroes2::Image & image, const int32_t x, const int32_t y, int32_t & width, int32_t & height,
+bool SMKVideoSequence::getCurrentFrame( fheroes2::Image & image, const int32_t x, const int32_t y, int32_t & width, int32_t & height,
                                         std::vector<uint8_t> & palette ) const
 {
-    if ( !_videoFile || image.empty() || x < 0 || y < 0 || x >= image.width() || y >= image.height() || !image.singleLayer() ) {
+    if ( !_frameDecoder || image.empty() || x < 0 || y < 0 || x >= image.width() || y >= image.height() || !image.singleLayer() ) {
         width = 0;
         height = 0;
-        return;
+        return false;
     }
 
-    const uint8_t * data = smk_get_video( _videoFile.get() );
-    const uint8_t * paletteData = smk_get_palette( _videoFile.get() );
+    const FrameDecoder::Frame & frame = _frameDecoder->getFrontFrame();
+
+    const uint8_t * data = frame.pixels.data();
 
     width = _width;
     height = _height;
@@ -300,26 +508,27 @@ void SMKVideoSequence::getCurrentFrame( fheroes2::Image & image, const int32_t x
         }
     }
 
-    palette.resize( 256 * 3 );
-    memcpy( palette.data(), paletteData, 256 * 3 );
+    if ( !frame.isPaletteChanged && !palette.empty() ) {
+        return false;
+    }
+
+    palette = frame.palette;
+
+    return true;
 }
 
 void SMKVideoSequence::skipFrame()
 {
     ++_currentFrameId;
-    if ( _currentFrameId < _frameCount ) {
-        if ( const signed char returnValue = smk_next( _videoFile.get() ); returnValue < 0 ) {
-            ERROR_LOG( "smk_next() failed with error code: " << static_cast<int>( returnValue ) )
-        }
+    if ( _currentFrameId < _frameCount && _frameDecoder ) {
+        // The last frame is kept, the same as the video file itself keeps it when there are no more frames.
+        _frameDecoder->removeFrontFrame();
     }
 }
 
 std::vector<uint8_t> SMKVideoSequence::getCurrentPalette() const
 {
-    assert( _videoFile );
-
-    const uint8_t * paletteData = smk_get_palette( _videoFile.get() );
-    assert( paletteData != nullptr );
+    assert( _frameDecoder );
 
-    return std::vector<uint8_t>( paletteData, paletteData + 256 * 3 );
+    return _frameDecoder->getFrontFrame().palette;
 }
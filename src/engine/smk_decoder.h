@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -36,7 +37,7 @@ class SMKVideoSequence final
 {
 public:
     explicit SMKVideoSequence( const std::string & filePath );
-    ~SMKVideoSequence() = default;
+    ~SMKVideoSequence();
 
     SMKVideoSequence( const SMKVideoSequence & ) = delete;
     SMKVideoSequence & operator=( const SMKVideoSequence & ) = delete;
@@ -45,14 +46,19 @@ public:
 
     // Input image must be resized to accommodate the frame, and also it must be a single layer image as video frames shouldn't have any transform-related information.
     // If the image is smaller than the frame then only a part of the frame will be drawn.
-    void getCurrentFrame( fheroes2::Image & image, int32_t x, int32_t y, int32_t & width, int32_t & height, std::vector<uint8_t> & palette ) const;
+    // The palette is updated only if the palette of the frame differs from the palette of the previous frame or if the given palette is empty.
+    // Returns true if the palette has been updated.
+    bool getCurrentFrame( fheroes2::Image & image, int32_t x, int32_t y, int32_t & width, int32_t & height, std::vector<uint8_t> & palette ) const;
 
     // Input image must be resized to accommodate the frame and also it must be a single layer image as video frames shouldn't have any transform-related information.
     // If the image is smaller than the frame then only a part of the frame will be drawn.
-    void getNextFrame( fheroes2::Image & image, const int32_t x, const int32_t y, int32_t & width, int32_t & height, std::vector<uint8_t> & palette )
+    // Returns true if the palette has been updated.
+    bool getNextFrame( fheroes2::Image & image, const int32_t x, const int32_t y, int32_t & width, int32_t & height, std::vector<uint8_t> & palette )
     {
-        getCurrentFrame( image, x, y, width, height, palette );
+        const bool isPaletteUpdated = getCurrentFrame( image, x, y, width, height, palette );
         skipFrame();
+
+        return isPaletteUpdated;
     }
 
     void skipFrame();
@@ -89,7 +95,14 @@ public:
         return _currentFrameId;
     }
 
+    // Returns the memory held by the audio and the frame buffers of all open video sequences. Video sequences must be used only by
+    // the main thread.
+    static size_t getTotalMemoryUsage();
+
 private:
+    // Decodes video frames ahead of their playback in a separate thread.
+    class FrameDecoder;
+
     std::vector<std::vector<uint8_t>> _audioChannel;
     int32_t _width{ 0 };
     int32_t _height{ 0 };
@@ -97,6 +110,8 @@ private:
     double _microsecondsPerFrame{ 0 };
     unsigned long _frameCount{ 0 };
     unsigned long _currentFrameId{ 0 };
+    size_t _memoryUsage{ 0 };
 
     std::unique_ptr<struct smk_t, void ( * )( struct smk_t * )> _videoFile{ nullptr, smk_close };
+    std::unique_ptr<FrameDecoder> _frameDecoder;
 };
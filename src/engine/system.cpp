@@ -47,6 +47,10 @@
 #include <strings.h>
 #endif
 
+#if defined( __linux__ ) || defined( __APPLE__ )
+#include <sys/resource.h>
+#endif
+
 // Managing compiler warnings for SDL headers
 #if defined( __GNUC__ )
 #pragma GCC diagnostic push
@@ -297,6 +301,26 @@ bool System::isShellLevelGlobbingSupported()
 #endif
 }
 
+uint64_t System::getPeakMemoryUsage()
+{
+#if defined( __linux__ ) || defined( __APPLE__ )
+    rusage usage{};
+    if ( getrusage( RUSAGE_SELF, &usage ) != 0 || usage.ru_maxrss < 0 ) {
+        return 0;
+    }
+
+#if defined( __APPLE__ )
+    // The value is reported in bytes on macOS...
+    return static_cast<uint64_t>( usage.ru_maxrss );
+#else
+    // ... and in kilobytes on Linux.
+    return static_cast<uint64_t>( usage.ru_maxrss ) * 1024;
+#endif
+#else
+    return 0;
+#endif
+}
+
 bool System::MakeDirectory( const std::string_view path )
 {
     std::error_code ec;
@@ -451,6 +475,33 @@ bool System::IsDirectory( const std::string_view path )
     return std::filesystem::is_directory( correctedPath, ec );
 }
 
+bool System::GetFileStamp( const std::string_view path, uint64_t & fileSize, int64_t & modificationTime )
+{
+    if ( path.empty() ) {
+        return false;
+    }
+
+    const std::filesystem::path fsPath{ path };
+
+    std::error_code ec;
+
+    // Using the non-throwing overloads
+    const std::uintmax_t size = std::filesystem::file_size( fsPath, ec );
+    if ( ec ) {
+        return false;
+    }
+
+    const std::filesystem::file_time_type lastWriteTime = std::filesystem::last_write_time( fsPath, ec );
+    if ( ec ) {
+        return false;
+    }
+
+    fileSize = static_cast<uint64_t>( size );
+    modificationTime = static_cast<int64_t>( lastWriteTime.time_since_epoch().count() );
+
+    return true;
+}
+
 bool System::GetCaseInsensitivePath( const std::string_view path, std::string & correctedPath )
 {
 #if !defined( _WIN32 ) && !defined( ANDROID ) && !defined( TARGET_PS_VITA ) && !defined( __IPHONEOS__ )
@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <ctime>
 #include <filesystem>
 #include <string>
@@ -42,6 +43,9 @@ namespace System
     // Otherwise returns false, which means that app need to resolve wildcard patterns itself (for example, on Windows).
     bool isShellLevelGlobbingSupported();
 
+    // Returns the peak amount of physical memory used by the process so far in bytes, or 0 if this information is not available on the target platform.
+    uint64_t getPeakMemoryUsage();
+
     bool MakeDirectory( const std::string_view path );
     bool Unlink( const std::string_view path );
 
@@ -64,6 +68,10 @@ namespace System
     bool IsFile( const std::string_view path );
     bool IsDirectory( const std::string_view path );
 
+    // Retrieves the size and the last modification time of the given file. The modification time is only suitable for comparing it
+    // with another value retrieved by this function. Returns false if this information is not available.
+    bool GetFileStamp( const std::string_view path, uint64_t & fileSize, int64_t & modificationTime );
+
     bool GetCaseInsensitivePath( const std::string_view path, std::string & correctedPath );
 
     // Resolves the wildcard pattern 'glob' and appends matching paths to 'fileNames'. Supported wildcards are '?' and '*'.
@@ -20,12 +20,18 @@
 
 #include "thread.h"
 
+#include <algorithm>
 #include <cassert>
+#include <iterator>
+#include <limits>
 #include <memory>
 
-#if defined( __EMSCRIPTEN__ ) && !defined( __EMSCRIPTEN_PTHREADS__ )
 namespace
 {
+    // The index of the JobSystem worker running on the current thread, the maximum value for other threads.
+    thread_local size_t currentWorkerId = std::numeric_limits<size_t>::max();
+
+#if defined( __EMSCRIPTEN__ ) && !defined( __EMSCRIPTEN_PTHREADS__ )
     class MutexUnlocker
     {
     public:
@@ -47,8 +53,8 @@ namespace
     private:
         std::mutex & _mutex;
     };
-}
 #endif
+}
 
 namespace MultiThreading
 {
@@ -56,6 +62,7 @@ namespace MultiThreading
     {
 #if !defined( __EMSCRIPTEN__ ) || defined( __EMSCRIPTEN_PTHREADS__ )
         if ( !_worker ) {
+            _exitFlag = false;
             _runFlag = true;
             _worker = std::make_unique<std::thread>( AsyncManager::_workerThread, this );
 
@@ -150,4 +157,228 @@ namespace MultiThreading
             manager->executeTask();
         }
     }
+
+    JobSystem & JobSystem::Get()
+    {
+        static JobSystem jobSystem;
+
+        return jobSystem;
+    }
+
+    JobSystem::JobSystem()
+    {
+#if ( !defined( __EMSCRIPTEN__ ) || defined( __EMSCRIPTEN_PTHREADS__ ) ) && !defined( TARGET_PS_VITA ) && !defined( TARGET_NINTENDO_SWITCH )
+        // The submitting thread takes part in the execution of jobs while it waits for them, so it is not counted here.
+        // hardware_concurrency() may return 0 if the value is not computable.
+        const unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        size_t workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+
+#if defined( __EMSCRIPTEN_PTHREADS__ ) && defined( FHEROES2_PTHREAD_POOL_SIZE )
+        // In a web browser threads run in Web Workers from a pool created on startup. A thread started when the pool is
+        // exhausted waits for the main thread to return to the browser event loop, which doesn't happen while the main
+        // thread waits for jobs. Some workers of the pool are left to the other engine threads (logging, audio, video
+        // decoding and networking).
+        const size_t reservedThreads = 5;
+        const size_t maxWorkerCount = FHEROES2_PTHREAD_POOL_SIZE > reservedThreads ? FHEROES2_PTHREAD_POOL_SIZE - reservedThreads : 0;
+
+        workerCount = std::min( workerCount, maxWorkerCount );
+#endif
+
+        _workers.reserve( workerCount );
+
+        for ( size_t i = 0; i < workerCount; ++i ) {
+            _workers.emplace_back( std::make_unique<Worker>() );
+        }
+
+        // Threads are started only when all the queues exist because workers steal jobs from each other.
+        for ( size_t i = 0; i < workerCount; ++i ) {
+            _workers[i]->thread = std::thread( &JobSystem::_workerThread, this, i );
+        }
+#endif
+    }
+
+    JobSystem::~JobSystem()
+    {
+        {
+            const std::scoped_lock<std::mutex> lock( _sleepMutex );
+
+            _exitFlag = true;
+        }
+
+        _sleepNotification.notify_all();
+
+        for ( const auto & worker : _workers ) {
+            worker->thread.join();
+        }
+    }
+
+    void JobSystem::parallelFor( const size_t begin, const size_t end, const std::function<void( size_t )> & body, const size_t grainSize /* = 1 */ )
+    {
+        if ( begin >= end ) {
+            return;
+        }
+
+        const size_t count = end - begin;
+
+        // A few jobs per thread let faster threads take over the work of slower ones.
+        const size_t jobCount = std::min( std::max<size_t>( count / std::max<size_t>( grainSize, 1 ), 1 ), ( _workers.size() + 1 ) * 4 );
+        if ( jobCount == 1 ) {
+            for ( size_t i = begin; i < end; ++i ) {
+                body( i );
+            }
+
+            return;
+        }
+
+        TaskGroup group( *this );
+
+        for ( size_t job = 0; job < jobCount; ++job ) {
+            const size_t jobBegin = begin + count * job / jobCount;
+            const size_t jobEnd = begin + count * ( job + 1 ) / jobCount;
+
+            group.run( [&body, jobBegin, jobEnd]() {
+                for ( size_t i = jobBegin; i < jobEnd; ++i ) {
+                    body( i );
+                }
+            } );
+        }
+
+        group.wait();
+    }
+
+    void JobSystem::_submit( std::function<void()> job, const TaskGroup * group )
+    {
+        if ( _workers.empty() ) {
+            job();
+            return;
+        }
+
+        // A job submitted by a worker is put into its own queue, so it is likely executed by the same thread while its data
+        // is still in the cache. Other threads distribute their jobs between workers.
+        const size_t workerId = ( currentWorkerId < _workers.size() ) ? currentWorkerId : ( _nextWorkerId++ % _workers.size() );
+
+        {
+            // The counter is modified under the lock to not miss the wake-up of a worker which is about to sleep. It is
+            // incremented before the job is queued, so it never goes below zero when the job is taken.
+            const std::scoped_lock<std::mutex> lock( _sleepMutex );
+
+            ++_pendingJobs;
+        }
+
+        {
+            Worker & worker = *_workers[workerId];
+            const std::scoped_lock<std::mutex> lock( worker.mutex );
+
+            worker.jobs.push_back( { std::move( job ), group } );
+        }
+
+        _sleepNotification.notify_one();
+    }
+
+    bool JobSystem::_runPendingJob( const TaskGroup & group )
+    {
+        std::optional<std::function<void()>> job = _takeJob( currentWorkerId < _workers.size() ? currentWorkerId : 0, &group );
+        if ( !job ) {
+            return false;
+        }
+
+        ( *job )();
+
+        return true;
+    }
+
+    void JobSystem::_workerThread( const size_t workerId )
+    {
+        currentWorkerId = workerId;
+
+        while ( true ) {
+            std::optional<std::function<void()>> job = _takeJob( workerId, nullptr );
+            if ( job ) {
+                ( *job )();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock( _sleepMutex );
+
+            _sleepNotification.wait( lock, [this] { return _exitFlag || _pendingJobs > 0; } );
+
+            if ( _exitFlag ) {
+                break;
+            }
+        }
+    }
+
+    std::optional<std::function<void()>> JobSystem::_takeJob( const size_t preferredWorkerId, const TaskGroup * group )
+    {
+        if ( _pendingJobs == 0 ) {
+            return std::nullopt;
+        }
+
+        const size_t workerCount = _workers.size();
+
+        for ( size_t i = 0; i < workerCount; ++i ) {
+            const size_t workerId = ( preferredWorkerId + i ) % workerCount;
+            Worker & worker = *_workers[workerId];
+
+            const std::scoped_lock<std::mutex> lock( worker.mutex );
+
+            if ( worker.jobs.empty() ) {
+                continue;
+            }
+
+            // The owner takes the most recent job, thieves take the oldest one.
+            auto jobIter = ( i == 0 ) ? std::prev( worker.jobs.end() ) : worker.jobs.begin();
+
+            if ( group != nullptr ) {
+                const auto isGroupJob = [group]( const Job & job ) { return job.group == group; };
+
+                if ( i == 0 ) {
+                    const auto reverseIter = std::find_if( worker.jobs.rbegin(), worker.jobs.rend(), isGroupJob );
+                    if ( reverseIter == worker.jobs.rend() ) {
+                        continue;
+                    }
+
+                    jobIter = std::prev( reverseIter.base() );
+                }
+                else {
+                    jobIter = std::find_if( worker.jobs.begin(), worker.jobs.end(), isGroupJob );
+                    if ( jobIter == worker.jobs.end() ) {
+                        continue;
+                    }
+                }
+            }
+
+            std::function<void()> job = std::move( jobIter->function );
+            worker.jobs.erase( jobIter );
+
+            --_pendingJobs;
+
+            return job;
+        }
+
+        return std::nullopt;
+    }
+
+    void TaskGroup::run( std::function<void()> job )
+    {
+        ++_unfinishedJobs;
+
+        _jobSystem._submit(
+            [this, job = std::move( job )]() {
+                job();
+
+                --_unfinishedJobs;
+            },
+            this );
+    }
+
+    void TaskGroup::wait()
+    {
+        while ( _unfinishedJobs > 0 ) {
+            if ( !_jobSystem._runPendingJob( *this ) ) {
+                // The remaining jobs are being executed by other threads.
+                std::this_thread::yield();
+            }
+        }
+    }
 }
@@ -22,12 +22,22 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace MultiThreading
 {
+    class TaskGroup;
+
     class AsyncManager
     {
     public:
@@ -39,7 +49,7 @@ namespace MultiThreading
         AsyncManager & operator=( const AsyncManager & ) = delete;
 
         // Create the worker thread if it doesn't exist yet. Both createWorker() and stopWorker() are not
-        // designed to be executed concurrently.
+        // designed to be executed concurrently. A stopped worker can be created again.
         void createWorker();
 
         // Stop and join the worker thread. This cannot be done in the destructor (directly or indirectly) due
@@ -70,4 +80,182 @@ namespace MultiThreading
 
         static void _workerThread( AsyncManager * manager );
     };
+
+    // Pool of worker threads executing short independent jobs. Every worker has its own queue of jobs, a worker which
+    // runs out of jobs steals them from the other workers. The number of workers is derived from the number of hardware
+    // threads. On platforms without thread support or with few cores (Emscripten without pthreads, PS Vita, Nintendo
+    // Switch) there are no workers and every job is executed by the submitting thread right away.
+    //
+    // A thread waiting for jobs of a group to complete (see TaskGroup::wait()) executes pending jobs of the same group
+    // meanwhile, so jobs can safely submit and wait for other jobs. Other jobs, such as long jobs started by async(), are
+    // never picked up by a waiting thread, so the wait does not last longer than the jobs of the group. This is not the
+    // case for std::future::wait(), so futures must not be waited for from within a job.
+    class JobSystem
+    {
+    public:
+        JobSystem( const JobSystem & ) = delete;
+        JobSystem & operator=( const JobSystem & ) = delete;
+
+        static JobSystem & Get();
+
+        size_t getWorkerCount() const
+        {
+            return _workers.size();
+        }
+
+        // Submits the job for execution and returns the future holding its result.
+        template <typename Function>
+        auto async( Function && function ) -> std::future<std::invoke_result_t<std::decay_t<Function>>>
+        {
+            using Result = std::invoke_result_t<std::decay_t<Function>>;
+
+            // std::function requires a copyable target.
+            auto task = std::make_shared<std::packaged_task<Result()>>( std::forward<Function>( function ) );
+            std::future<Result> result = task->get_future();
+
+            submit( [task = std::move( task )]() { ( *task )(); } );
+
+            return result;
+        }
+
+        // Calls 'body( i )' for every i in [begin, end) and returns once all the calls are completed. Indexes are grouped
+        // into jobs of at least 'grainSize' indexes. The calls can be made concurrently and in any order, so they must only
+        // write to their own data.
+        void parallelFor( const size_t begin, const size_t end, const std::function<void( size_t )> & body, const size_t grainSize = 1 );
+
+        void submit( std::function<void()> job )
+        {
+            _submit( std::move( job ), nullptr );
+        }
+
+    private:
+        friend class TaskGroup;
+
+        struct Job
+        {
+            std::function<void()> function;
+
+            // The group the job belongs to, nullptr for jobs outside of any group.
+            const TaskGroup * group{ nullptr };
+        };
+
+        struct Worker
+        {
+            std::mutex mutex;
+            std::deque<Job> jobs;
+            std::thread thread;
+        };
+
+        JobSystem();
+        ~JobSystem();
+
+        void _workerThread( const size_t workerId );
+
+        void _submit( std::function<void()> job, const TaskGroup * group );
+
+        // Executes one pending job of the given group, if any, on the calling thread. Returns false if there are no such jobs.
+        bool _runPendingJob( const TaskGroup & group );
+
+        // Takes a pending job of the given group, or of any group if 'group' is nullptr.
+        std::optional<std::function<void()>> _takeJob( const size_t preferredWorkerId, const TaskGroup * group );
+
+        std::vector<std::unique_ptr<Worker>> _workers;
+
+        std::mutex _sleepMutex;
+        std::condition_variable _sleepNotification;
+
+        // The number of jobs in all queues.
+        std::atomic<size_t> _pendingJobs{ 0 };
+        std::atomic<size_t> _nextWorkerId{ 0 };
+        std::atomic<bool> _exitFlag{ false };
+    };
+
+    // A set of jobs that can be waited for together. The destructor waits for all the jobs of the group.
+    class TaskGroup
+    {
+    public:
+        explicit TaskGroup( JobSystem & jobSystem = JobSystem::Get() )
+            : _jobSystem( jobSystem )
+        {}
+
+        TaskGroup( const TaskGroup & ) = delete;
+
+        ~TaskGroup()
+        {
+            wait();
+        }
+
+        TaskGroup & operator=( const TaskGroup & ) = delete;
+
+        void run( std::function<void()> job );
+
+        // Waits for all the jobs submitted so far, executing pending jobs of this group by the calling thread meanwhile.
+        void wait();
+
+    private:
+        JobSystem & _jobSystem;
+
+        std::atomic<size_t> _unfinishedJobs{ 0 };
+    };
+
+    // Bounded lock-free queue for exactly one producer thread and one consumer thread. push() must only be
+    // called by the producer and pop() only by the consumer.
+    template <typename T>
+    class SpscQueue
+    {
+    public:
+        explicit SpscQueue( const size_t capacity )
+            : _items( capacity + 1 )
+        {}
+
+        SpscQueue( const SpscQueue & ) = delete;
+
+        ~SpscQueue() = default;
+
+        SpscQueue & operator=( const SpscQueue & ) = delete;
+
+        // Returns false if the queue is full. The item is left untouched in this case.
+        bool push( T && item )
+        {
+            const size_t tail = _tail.load( std::memory_order_relaxed );
+            const size_t next = _next( tail );
+            if ( next == _head.load( std::memory_order_acquire ) ) {
+                return false;
+            }
+
+            _items[tail] = std::move( item );
+            _tail.store( next, std::memory_order_release );
+
+            return true;
+        }
+
+        std::optional<T> pop()
+        {
+            const size_t head = _head.load( std::memory_order_relaxed );
+            if ( head == _tail.load( std::memory_order_acquire ) ) {
+                return std::nullopt;
+            }
+
+            std::optional<T> item = std::move( _items[head] );
+            _head.store( _next( head ), std::memory_order_release );
+
+            return item;
+        }
+
+        bool empty() const
+        {
+            return _head.load( std::memory_order_acquire ) == _tail.load( std::memory_order_acquire );
+        }
+
+    private:
+        std::vector<T> _items;
+
+        std::atomic<size_t> _head{ 0 };
+        std::atomic<size_t> _tail{ 0 };
+
+        size_t _next( const size_t pos ) const
+        {
+            return pos + 1 == _items.size() ? 0 : pos + 1;
+        }
+    };
 }
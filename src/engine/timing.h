@@ -92,6 +92,19 @@ namespace fheroes2
             return passedMs >= delayMs;
         }
 
+        // Returns the time in milliseconds left until the given delay passes, or 0 if it has already passed.
+        uint64_t getRemainingMs( const uint64_t delayMs ) const
+        {
+            const auto time = std::chrono::duration_cast<std::chrono::milliseconds>( std::chrono::steady_clock::now() - _prevTime );
+            const uint64_t passedMs = time.count();
+            return passedMs >= delayMs ? 0 : delayMs - passedMs;
+        }
+
+        uint64_t getRemainingMs() const
+        {
+            return getRemainingMs( _delayMs );
+        }
+
         // Reset delay by starting the count from the current time.
         void reset()
         {
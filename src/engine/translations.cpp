@@ -35,7 +35,6 @@
 #include <ostream>
 #include <string>
 #include <string_view>
-#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
@@ -293,6 +292,9 @@ namespace
         return iter->second;
     }
 
+    // The compile-time version of the hash must be identical to this one.
+    static_assert( Translation::getStringHash( "123456789" ) == 0xCBF43926 );
+
     uint32_t crc32b( const std::string_view str )
     {
         uint32_t crc = 0xFFFFFFFF;
@@ -340,6 +342,11 @@ namespace
         MOFile() = default;
 
         const char * ngettext( const char * str, const size_t plural ) const
+        {
+            return ngettext( str, crc32b( str ), plural );
+        }
+
+        const char * ngettext( const char * str, const uint32_t hash, const size_t plural ) const
         {
             if ( !_isValid ) {
                 assert( 0 );
@@ -347,22 +354,30 @@ namespace
                 return stripContext( str );
             }
 
-            const auto iter = std::as_const( _translations ).find( crc32b( str ) );
-            if ( iter == _translations.cend() ) {
+            const auto iter = std::lower_bound( _translations.begin(), _translations.end(), hash,
+                                                []( const TranslationInfo & info, const uint32_t value ) { return info.hash < value; } );
+            if ( iter == _translations.end() || iter->hash != hash ) {
                 return stripContext( str );
             }
 
-            const auto & [dummy, pluralFormTranslations] = *iter;
-            if ( plural >= pluralFormTranslations.size() ) {
-                return stripContext( str );
+            // Plural forms of the translation are stored one after another, separated by null characters. The last plural form is also
+            // followed by a null character, this was verified during the loading.
+            const char * translatedStr = reinterpret_cast<const char *>( _data.data() ) + iter->offset;
+            const char * translationsEnd = translatedStr + iter->size;
+
+            for ( size_t i = 0; i < plural; ++i ) {
+                translatedStr += std::strlen( translatedStr ) + 1;
+
+                if ( translatedStr >= translationsEnd ) {
+                    return stripContext( str );
+                }
             }
 
-            const std::string & translatedStr = pluralFormTranslations[plural];
-            if ( translatedStr.empty() ) {
+            if ( *translatedStr == '\0' ) {
                 return stripContext( str );
             }
 
-            return translatedStr.c_str();
+            return translatedStr;
         }
 
         bool load( const std::string_view langName, const std::string & fileName )
@@ -374,7 +389,8 @@ namespace
                 return false;
             }
 
-            ROStreamBuf sb = sf.getStreamBuf();
+            // The contents of the file are kept in memory as is, and the translated strings are used directly from there.
+            _data = sf.getRaw( 0 );
             if ( sf.fail() ) {
                 ERROR_LOG( "I/O error when reading " << fileName )
                 return false;
@@ -382,6 +398,8 @@ namespace
 
             sf.close();
 
+            ROStreamBuf sb( _data );
+
             {
                 const uint32_t magicNumber = sb.getLE32();
                 if ( sb.fail() ) {
@@ -439,6 +457,8 @@ namespace
             // specific implementation and is not documented. See https://www.gnu.org/software/gettext/manual/html_node/MO-Files.html
             // for details.
 
+            _translations.reserve( stringsCount );
+
             for ( uint32_t i = 0; i < stringsCount; ++i ) {
                 sb.seek( originalStringsTableOffset + i * 8 );
 
@@ -476,23 +496,32 @@ namespace
                     continue;
                 }
 
-                sb.seek( tranStrOff );
-
-                const auto [tranBufPtr, tranBufLen] = sb.getRawView( tranStrLen );
-                if ( sb.fail() ) {
+                // Every string in the MO file should be followed by a null character which is not included in its length.
+                if ( static_cast<size_t>( tranStrOff ) + tranStrLen >= _data.size() || _data[static_cast<size_t>( tranStrOff ) + tranStrLen] != 0 ) {
                     ERROR_LOG( "I/O error when parsing " << fileName )
                     return false;
                 }
 
-                static_assert( std::is_same_v<std::remove_const_t<std::remove_reference_t<decltype( *tranBufPtr )>>, unsigned char> );
-
-                if ( const auto [dummy, inserted]
-                     = _translations.try_emplace( crc32b( origStr ), StringSplit( { reinterpret_cast<const char *>( tranBufPtr ), tranBufLen }, '\0' ) );
-                     !inserted ) {
-                    ERROR_LOG( "Hash collision detected for string \"" << origStr << "\"" )
-                }
+                _translations.push_back( { crc32b( origStr ), tranStrOff, tranStrLen } );
             }
 
+            // The stable sort keeps the first of the translations with the same hash in front of the others.
+            std::stable_sort( _translations.begin(), _translations.end(),
+                              []( const TranslationInfo & first, const TranslationInfo & second ) { return first.hash < second.hash; } );
+
+            _translations.erase( std::unique( _translations.begin(), _translations.end(),
+                                              [this]( const TranslationInfo & first, const TranslationInfo & second ) {
+                                                  if ( first.hash != second.hash ) {
+                                                      return false;
+                                                  }
+
+                                                  ERROR_LOG( "Hash collision detected for translated string \""
+                                                             << reinterpret_cast<const char *>( _data.data() ) + second.offset << "\"" )
+
+                                                  return true;
+                                              } ),
+                                 _translations.end() );
+
             if ( _translations.empty() ) {
                 ERROR_LOG( "There are no translated strings in " << fileName )
                 return false;
@@ -550,15 +579,41 @@ namespace
             return _isValid;
         }
 
+        size_t getMemorySize() const
+        {
+            return _data.capacity() + _translations.capacity() * sizeof( TranslationInfo ) + _encoding.capacity();
+        }
+
     private:
+        struct TranslationInfo
+        {
+            // Hash of the original string.
+            uint32_t hash;
+            // Offset and size of the translation in the MO file data.
+            uint32_t offset;
+            uint32_t size;
+        };
+
         LocaleType _locale{ LocaleType::LOCALE_EN };
-        std::unordered_map<uint32_t, std::vector<std::string>> _translations;
+        // Contents of the MO file.
+        std::vector<uint8_t> _data;
+        // Translations sorted by the hashes of the original strings.
+        std::vector<TranslationInfo> _translations;
         std::string _encoding;
         bool _isValid{ false };
     };
 
     MOFile * current = nullptr;
     std::map<std::string, MOFile, std::less<>> cache;
+
+    uint32_t languageGeneration{ 0 };
+
+    void setCurrentFile( MOFile * file )
+    {
+        current = file;
+
+        ++languageGeneration;
+    }
 }
 
 std::pair<bool, bool> Translation::setLanguage( const std::string_view langName )
@@ -569,7 +624,7 @@ std::pair<bool, bool> Translation::setLanguage( const std::string_view langName
         MOFile & item = iter->second;
 
         if ( item.isValid() ) {
-            current = &item;
+            setCurrentFile( &item );
         }
 
         return { true, item.isValid() };
@@ -587,7 +642,7 @@ bool Translation::setLanguage( const std::string & langName, const std::string_v
 
     if ( !inserted ) {
         if ( item.isValid() ) {
-            current = &item;
+            setCurrentFile( &item );
         }
 
         return item.isValid();
@@ -601,14 +656,30 @@ bool Translation::setLanguage( const std::string & langName, const std::string_v
 
     assert( item.isValid() );
 
-    current = &item;
+    setCurrentFile( &item );
 
     return true;
 }
 
 void Translation::reset()
 {
-    current = nullptr;
+    setCurrentFile( nullptr );
+}
+
+uint32_t Translation::getLanguageGeneration()
+{
+    return languageGeneration;
+}
+
+size_t Translation::getMemoryUsage()
+{
+    size_t size = 0;
+
+    for ( const auto & [langName, file] : cache ) {
+        size += file.getMemorySize();
+    }
+
+    return size;
 }
 
 const char * Translation::gettext( const std::string & str )
@@ -621,6 +692,13 @@ const char * Translation::gettext( const char * str )
     return current ? current->ngettext( str, 0 ) : stripContext( str );
 }
 
+const char * Translation::gettext( const char * str, const uint32_t hash )
+{
+    assert( hash == crc32b( str ) );
+
+    return current ? current->ngettext( str, hash, 0 ) : stripContext( str );
+}
+
 const char * Translation::ngettext( const char * str, const char * plural, const size_t n )
 {
     if ( current ) {
@@ -24,8 +24,10 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <utility>
 
 namespace Translation
@@ -50,6 +52,70 @@ namespace Translation
     const char * gettext( const std::string & str );
     const char * ngettext( const char * str, const char * plural, const size_t n );
 
+    // Same as above, but uses the given precomputed hash of the string (see getStringHash()) instead of calculating it.
+    const char * gettext( const char * str, const uint32_t hash );
+
+    // Returns the hash of the string which is used to find its translation. For string literals it can be calculated at compile time.
+    constexpr uint32_t getStringHash( const std::string_view str )
+    {
+        // This is CRC32 (the same algorithm as the one used by the MO files parser) calculated without a lookup table.
+        uint32_t crc = 0xFFFFFFFF;
+
+        for ( const char ch : str ) {
+            crc ^= static_cast<uint8_t>( ch );
+
+            for ( int i = 0; i < 8; ++i ) {
+                crc = ( crc >> 1 ) ^ ( 0xEDB88320 & ( 0 - ( crc & 1 ) ) );
+            }
+        }
+
+        return ~crc;
+    }
+
+    // Returns the number which changes every time the current language changes.
+    uint32_t getLanguageGeneration();
+
+    // Returns the size of all loaded translations, including the cached ones of other languages.
+    size_t getMemoryUsage();
+
+    // Translation of a string literal which is looked up only once after every change of the current language. Use the _c() macro instead of
+    // creating instances of this class directly. This class must be used only by the main thread.
+    class CachedTranslation
+    {
+    public:
+        constexpr CachedTranslation( const char * str, const uint32_t hash )
+            : _str( str )
+            , _hash( hash )
+        {
+            // Do nothing.
+        }
+
+        CachedTranslation( const CachedTranslation & ) = delete;
+
+        ~CachedTranslation() = default;
+
+        CachedTranslation & operator=( const CachedTranslation & ) = delete;
+
+        const char * get()
+        {
+            const uint32_t generation = getLanguageGeneration();
+
+            if ( _translatedStr == nullptr || _generation != generation ) {
+                _translatedStr = gettext( _str, _hash );
+                _generation = generation;
+            }
+
+            return _translatedStr;
+        }
+
+    private:
+        const char * const _str;
+        const uint32_t _hash;
+
+        const char * _translatedStr{ nullptr };
+        uint32_t _generation{ 0 };
+    };
+
     // Converts the given string to lowercase in a locale aware way
     std::string StringLower( std::string str );
 }
@@ -57,6 +123,14 @@ namespace Translation
 #define _( str ) Translation::gettext( str )
 #define _n( str, plural, num ) Translation::ngettext( str, plural, num )
 
+// Same as _(), but only for string literals. The hash of the string is calculated at compile time, and its translation is cached until the current
+// language changes, which makes this macro suitable for the code that is executed on every redraw. Can only be used by the main thread.
+#define _c( str )                                                                                                                                    \
+    ( []() -> const char * {                                                                                                                         \
+        static Translation::CachedTranslation cachedTranslation( str, std::integral_constant<uint32_t, Translation::getStringHash( str )>::value ); \
+        return cachedTranslation.get();                                                                                                              \
+    }() )
+
 constexpr const char * gettext_noop( const char * s )
 {
     return s;
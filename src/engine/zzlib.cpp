@@ -23,18 +23,234 @@
 
 #include "zzlib.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstring>
+#include <memory>
 #include <ostream>
 
+#if defined( WITH_LIBDEFLATE )
+#include <libdeflate.h>
+#else
 #include <zconf.h>
 #include <zlib.h>
+#endif
 
 #include "logging.h"
 #include "serialize.h"
+#include "thread.h"
 
 namespace
 {
+    enum class UnzipResult
+    {
+        SUCCESS,
+        INSUFFICIENT_SPACE,
+        FAILURE
+    };
+
+#if defined( WITH_LIBDEFLATE )
+    // libdeflate compressors and decompressors are not thread-safe, so every thread has its own ones.
+    libdeflate_decompressor * getDecompressor()
+    {
+        thread_local const std::unique_ptr<libdeflate_decompressor, void ( * )( libdeflate_decompressor * )> decompressor( libdeflate_alloc_decompressor(),
+                                                                                                                          libdeflate_free_decompressor );
+        return decompressor.get();
+    }
+
+    libdeflate_compressor * getCompressor( const int level )
+    {
+        thread_local std::unique_ptr<libdeflate_compressor, void ( * )( libdeflate_compressor * )> compressor( nullptr, libdeflate_free_compressor );
+        thread_local int compressorLevel = 0;
+
+        if ( !compressor || compressorLevel != level ) {
+            compressor.reset( libdeflate_alloc_compressor( level ) );
+            compressorLevel = level;
+        }
+
+        return compressor.get();
+    }
+
+    // Decompresses the zlib stream into the given buffer. On success 'dstSize' is set to the size of the decompressed data.
+    UnzipResult unzipToBuffer( uint8_t * dst, size_t & dstSize, const uint8_t * src, const size_t srcSize )
+    {
+        libdeflate_decompressor * decompressor = getDecompressor();
+        if ( decompressor == nullptr ) {
+            ERROR_LOG( "Failed to allocate a libdeflate decompressor" )
+            return UnzipResult::FAILURE;
+        }
+
+        size_t actualSize = 0;
+
+        const libdeflate_result ret = libdeflate_zlib_decompress( decompressor, src, srcSize, dst, dstSize, &actualSize );
+        if ( ret == LIBDEFLATE_INSUFFICIENT_SPACE ) {
+            return UnzipResult::INSUFFICIENT_SPACE;
+        }
+
+        if ( ret != LIBDEFLATE_SUCCESS ) {
+            ERROR_LOG( "libdeflate error: " << ret )
+            return UnzipResult::FAILURE;
+        }
+
+        dstSize = actualSize;
+
+        return UnzipResult::SUCCESS;
+    }
+
+    size_t getZipBound( const size_t srcSize, const int level )
+    {
+        libdeflate_compressor * compressor = getCompressor( level );
+        if ( compressor == nullptr ) {
+            return 0;
+        }
+
+        return libdeflate_zlib_compress_bound( compressor, srcSize );
+    }
+
+    // Compresses the data into the given buffer that is not smaller than the result of getZipBound(). On success 'dstSize' is set to the size
+    // of the compressed data.
+    bool zipToBuffer( uint8_t * dst, size_t & dstSize, const uint8_t * src, const size_t srcSize, const int level )
+    {
+        libdeflate_compressor * compressor = getCompressor( level );
+        if ( compressor == nullptr ) {
+            ERROR_LOG( "Failed to allocate a libdeflate compressor" )
+            return false;
+        }
+
+        dstSize = libdeflate_zlib_compress( compressor, src, srcSize, dst, dstSize );
+        if ( dstSize == 0 ) {
+            ERROR_LOG( "libdeflate failed to compress the data" )
+            return false;
+        }
+
+        return true;
+    }
+#else
+    UnzipResult unzipToBuffer( uint8_t * dst, size_t & dstSize, const uint8_t * src, const size_t srcSize )
+    {
+        const uLong srcSizeULong = static_cast<uLong>( srcSize );
+        if ( srcSizeULong != srcSize ) {
+            ERROR_LOG( "The size of the compressed data is too large" )
+            return UnzipResult::FAILURE;
+        }
+
+        uLong dstSizeULong = static_cast<uLong>( dstSize );
+        if ( dstSizeULong != dstSize ) {
+            ERROR_LOG( "The size of the decompressed data is too large" )
+            return UnzipResult::FAILURE;
+        }
+
+        const int ret = uncompress( dst, &dstSizeULong, src, srcSizeULong );
+        if ( ret == Z_BUF_ERROR ) {
+            return UnzipResult::INSUFFICIENT_SPACE;
+        }
+
+        if ( ret != Z_OK ) {
+            ERROR_LOG( "zlib error: " << ret )
+            return UnzipResult::FAILURE;
+        }
+
+        dstSize = dstSizeULong;
+
+        return UnzipResult::SUCCESS;
+    }
+
+    size_t getZipBound( const size_t srcSize, const int /* level */ )
+    {
+        const uLong srcSizeULong = static_cast<uLong>( srcSize );
+        if ( srcSizeULong != srcSize ) {
+            return 0;
+        }
+
+        return compressBound( srcSizeULong );
+    }
+
+    bool zipToBuffer( uint8_t * dst, size_t & dstSize, const uint8_t * src, const size_t srcSize, const int level )
+    {
+        const uLong srcSizeULong = static_cast<uLong>( srcSize );
+        uLong dstSizeULong = static_cast<uLong>( dstSize );
+        if ( srcSizeULong != srcSize || dstSizeULong != dstSize ) {
+            ERROR_LOG( "The size of the data is too large" )
+            return false;
+        }
+
+        const int ret = compress2( dst, &dstSizeULong, src, srcSizeULong, level );
+        if ( ret != Z_OK ) {
+            ERROR_LOG( "zlib error: " << ret )
+            return false;
+        }
+
+        dstSize = dstSizeULong;
+
+        return true;
+    }
+#endif
+
     constexpr uint16_t FORMAT_VERSION_0 = 0;
+
+    // The data is split into chunks which are compressed independently, so they can be compressed and decompressed in parallel.
+    constexpr uint16_t FORMAT_VERSION_1 = 1;
+
+    // Data not larger than this size is stored as a single chunk using the FORMAT_VERSION_0 format.
+    constexpr size_t zipChunkSize = 1024 * 1024;
+
+    bool unzipChunks( IStreamBase & inputStream, OStreamBase & outputStream, const uint32_t rawSize, const uint32_t zipSize )
+    {
+        const uint32_t chunkCount = inputStream.get32();
+
+        // Every chunk contains at least one byte of compressed data.
+        if ( chunkCount == 0 || chunkCount > zipSize ) {
+            return false;
+        }
+
+        std::vector<uint32_t> chunkRawSizes( chunkCount );
+        std::vector<uint32_t> chunkZipSizes( chunkCount );
+        std::vector<size_t> chunkRawOffsets( chunkCount );
+        std::vector<size_t> chunkZipOffsets( chunkCount );
+
+        size_t totalRawSize = 0;
+        size_t totalZipSize = 0;
+
+        for ( uint32_t i = 0; i < chunkCount; ++i ) {
+            chunkRawSizes[i] = inputStream.get32();
+            chunkZipSizes[i] = inputStream.get32();
+
+            chunkRawOffsets[i] = totalRawSize;
+            chunkZipOffsets[i] = totalZipSize;
+
+            totalRawSize += chunkRawSizes[i];
+            totalZipSize += chunkZipSizes[i];
+        }
+
+        if ( inputStream.fail() || totalRawSize != rawSize || totalZipSize != zipSize ) {
+            return false;
+        }
+
+        const std::vector<uint8_t> zip = inputStream.getRaw( zipSize );
+        if ( zip.size() != zipSize ) {
+            return false;
+        }
+
+        std::vector<uint8_t> raw( rawSize );
+        std::atomic<bool> isValid{ true };
+
+        MultiThreading::JobSystem::Get().parallelFor( 0, chunkCount, [&]( const size_t i ) {
+            size_t chunkRawSize = chunkRawSizes[i];
+
+            if ( unzipToBuffer( raw.data() + chunkRawOffsets[i], chunkRawSize, zip.data() + chunkZipOffsets[i], chunkZipSizes[i] ) != UnzipResult::SUCCESS
+                 || chunkRawSize != chunkRawSizes[i] ) {
+                isValid = false;
+            }
+        } );
+
+        if ( !isValid ) {
+            return false;
+        }
+
+        outputStream.putRaw( raw.data(), raw.size() );
+
+        return !outputStream.fail();
+    }
 }
 
 std::vector<uint8_t> Compression::unzipData( const uint8_t * src, const size_t srcSize, size_t realSize /* = 0 */ )
@@ -43,12 +259,6 @@ std::vector<uint8_t> Compression::unzipData( const uint8_t * src, const size_t s
         return {};
     }
 
-    const uLong srcSizeULong = static_cast<uLong>( srcSize );
-    if ( srcSizeULong != srcSize ) {
-        ERROR_LOG( "The size of the compressed data is too large" )
-        return {};
-    }
-
     std::vector<uint8_t> res( realSize );
 
     if ( realSize == 0 ) {
@@ -65,14 +275,10 @@ std::vector<uint8_t> Compression::unzipData( const uint8_t * src, const size_t s
         res.resize( realSize );
     }
 
-    uLong dstSizeULong = static_cast<uLong>( res.size() );
-    if ( dstSizeULong != res.size() ) {
-        ERROR_LOG( "The size of the decompressed data is too large" )
-        return {};
-    }
+    size_t dstSize = res.size();
 
-    int ret = Z_BUF_ERROR;
-    while ( Z_BUF_ERROR == ( ret = uncompress( res.data(), &dstSizeULong, src, srcSizeULong ) ) ) {
+    UnzipResult ret = UnzipResult::INSUFFICIENT_SPACE;
+    while ( UnzipResult::INSUFFICIENT_SPACE == ( ret = unzipToBuffer( res.data(), dstSize, src, srcSize ) ) ) {
         constexpr size_t sizeMultiplier = 2;
 
         // Avoid infinite loop due to unsigned overflow on multiplication
@@ -83,51 +289,40 @@ std::vector<uint8_t> Compression::unzipData( const uint8_t * src, const size_t s
 
         res.resize( res.size() * sizeMultiplier );
 
-        dstSizeULong = static_cast<uLong>( res.size() );
-        if ( dstSizeULong != res.size() ) {
-            ERROR_LOG( "The size of the decompressed data is too large" )
-            return {};
-        }
+        dstSize = res.size();
     }
 
-    if ( ret != Z_OK ) {
-        ERROR_LOG( "zlib error: " << ret )
+    if ( ret != UnzipResult::SUCCESS ) {
         return {};
     }
 
-    res.resize( dstSizeULong );
+    res.resize( dstSize );
 
     return res;
 }
 
-std::vector<uint8_t> Compression::zipData( const uint8_t * src, const size_t srcSize )
+std::vector<uint8_t> Compression::zipData( const uint8_t * src, const size_t srcSize, const int level /* = defaultLevel */ )
 {
     if ( src == nullptr || srcSize == 0 ) {
         return {};
     }
 
-    const uLong srcSizeULong = static_cast<uLong>( srcSize );
-    if ( srcSizeULong != srcSize ) {
-        ERROR_LOG( "The size of the source data is too large" )
-        return {};
-    }
-
-    std::vector<uint8_t> res( compressBound( srcSizeULong ) );
+    const int zipLevel = std::clamp( level, minLevel, maxLevel );
 
-    uLong dstSizeULong = static_cast<uLong>( res.size() );
-    if ( dstSizeULong != res.size() ) {
-        ERROR_LOG( "The size of the compressed data is too large" )
+    const size_t zipBound = getZipBound( srcSize, zipLevel );
+    if ( zipBound == 0 ) {
+        ERROR_LOG( "The size of the source data is too large" )
         return {};
     }
 
-    const int ret = compress( res.data(), &dstSizeULong, src, srcSizeULong );
+    std::vector<uint8_t> res( zipBound );
 
-    if ( ret != Z_OK ) {
-        ERROR_LOG( "zlib error: " << ret )
+    size_t dstSize = res.size();
+    if ( !zipToBuffer( res.data(), dstSize, src, srcSize, zipLevel ) ) {
         return {};
     }
 
-    res.resize( dstSizeULong );
+    res.resize( dstSize );
 
     return res;
 }
@@ -141,12 +336,16 @@ bool Compression::unzipStream( IStreamBase & inputStream, OStreamBase & outputSt
     }
 
     const uint16_t version = inputStream.get16();
-    if ( version != FORMAT_VERSION_0 ) {
+    if ( version != FORMAT_VERSION_0 && version != FORMAT_VERSION_1 ) {
         return false;
     }
 
     inputStream.skip( 2 ); // Unused bytes
 
+    if ( version == FORMAT_VERSION_1 ) {
+        return unzipChunks( inputStream, outputStream, rawSize, zipSize );
+    }
+
     const std::vector<uint8_t> zip = inputStream.getRaw( zipSize );
     const std::vector<uint8_t> raw = unzipData( zip.data(), zip.size(), rawSize );
     if ( raw.size() != rawSize ) {
@@ -158,14 +357,55 @@ bool Compression::unzipStream( IStreamBase & inputStream, OStreamBase & outputSt
     return !outputStream.fail();
 }
 
-bool Compression::zipStreamBuf( const IStreamBuf & inputStream, OStreamBase & outputStream )
+bool Compression::zipStreamBuf( const IStreamBuf & inputStream, OStreamBase & outputStream, const int level /* = defaultLevel */ )
 {
-    const std::vector<uint8_t> zip = zipData( inputStream.data(), inputStream.size() );
+    const uint8_t * data = inputStream.data();
+    const size_t dataSize = inputStream.size();
+
+    if ( dataSize > zipChunkSize ) {
+        const size_t chunkCount = ( dataSize + zipChunkSize - 1 ) / zipChunkSize;
+
+        std::vector<std::vector<uint8_t>> zipChunks( chunkCount );
+
+        MultiThreading::JobSystem::Get().parallelFor( 0, chunkCount, [data, dataSize, level, &zipChunks]( const size_t i ) {
+            const size_t offset = i * zipChunkSize;
+
+            zipChunks[i] = zipData( data + offset, std::min( zipChunkSize, dataSize - offset ), level );
+        } );
+
+        size_t zipSize = 0;
+        for ( const std::vector<uint8_t> & chunk : zipChunks ) {
+            if ( chunk.empty() ) {
+                return false;
+            }
+
+            zipSize += chunk.size();
+        }
+
+        outputStream.put32( static_cast<uint32_t>( dataSize ) );
+        outputStream.put32( static_cast<uint32_t>( zipSize ) );
+        outputStream.put16( FORMAT_VERSION_1 );
+        outputStream.put16( 0 ); // Unused bytes
+        outputStream.put32( static_cast<uint32_t>( chunkCount ) );
+
+        for ( size_t i = 0; i < chunkCount; ++i ) {
+            outputStream.put32( static_cast<uint32_t>( std::min( zipChunkSize, dataSize - i * zipChunkSize ) ) );
+            outputStream.put32( static_cast<uint32_t>( zipChunks[i].size() ) );
+        }
+
+        for ( const std::vector<uint8_t> & chunk : zipChunks ) {
+            outputStream.putRaw( chunk.data(), chunk.size() );
+        }
+
+        return !outputStream.fail();
+    }
+
+    const std::vector<uint8_t> zip = zipData( data, dataSize, level );
     if ( zip.empty() ) {
         return false;
     }
 
-    outputStream.put32( static_cast<uint32_t>( inputStream.size() ) );
+    outputStream.put32( static_cast<uint32_t>( dataSize ) );
     outputStream.put32( static_cast<uint32_t>( zip.size() ) );
     outputStream.put16( FORMAT_VERSION_0 );
     outputStream.put16( 0 ); // Unused bytes
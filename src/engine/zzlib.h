@@ -35,6 +35,12 @@ class IStreamBuf;
 
 namespace Compression
 {
+    // Compression levels are the same as in zlib: from 1 (the fastest) to 9 (the smallest output). Both zlib and libdeflate
+    // (if fheroes2 is built with it) produce data in the zlib format, so either of them can decompress data compressed by another one.
+    constexpr int minLevel = 1;
+    constexpr int maxLevel = 9;
+    constexpr int defaultLevel = 6;
+
     // Unzips the input data and returns the uncompressed data or an empty vector in case of an error.
     // The 'realSize' parameter represents the planned size of the decompressed data and is optional
     // (it is only used to speed up the decompression process). If this parameter is omitted or set to
@@ -42,16 +48,16 @@ namespace Compression
     std::vector<uint8_t> unzipData( const uint8_t * src, const size_t srcSize, size_t realSize = 0 );
 
     // Zips the input data and returns the compressed data or an empty vector in case of an error.
-    std::vector<uint8_t> zipData( const uint8_t * src, const size_t srcSize );
+    std::vector<uint8_t> zipData( const uint8_t * src, const size_t srcSize, const int level = defaultLevel );
 
     // Reads & unzips the zipped chunk from the given input stream and writes it to the given output
     // stream. Returns true on success or false on error.
     bool unzipStream( IStreamBase & inputStream, OStreamBase & outputStream );
 
     // Zips the contents of the buffer from the current read position to the end of the buffer and writes
-    // it to the given output stream. The current read position of the buffer does not change. Returns
-    // true on success and false on error.
-    bool zipStreamBuf( const IStreamBuf & inputStream, OStreamBase & outputStream );
+    // it to the given output stream. The current read position of the buffer does not change. Large buffers
+    // are split into chunks which are compressed in parallel. Returns true on success and false on error.
+    bool zipStreamBuf( const IStreamBuf & inputStream, OStreamBase & outputStream, const int level = defaultLevel );
 
     fheroes2::Image CreateImageFromZlib( int32_t width, int32_t height, const uint8_t * imageData, size_t imageSize, bool doubleLayer );
 }
@@ -22,6 +22,7 @@
  ***************************************************************************/
 
 #include <list>
+#include <mutex>
 #include <stdexcept>
 #include <utility>
 
@@ -35,10 +36,15 @@ namespace
 {
     fheroes2::AGGFile heroes2_agg;
     fheroes2::AGGFile heroes2x_agg;
+
+    // AGG files are read by the background ICN preloader as well.
+    std::mutex aggFileMutex;
 }
 
 std::vector<uint8_t> AGG::getDataFromAggFile( const std::string & key, const bool ignoreExpansion )
 {
+    const std::scoped_lock<std::mutex> lock( aggFileMutex );
+
     if ( !ignoreExpansion && heroes2x_agg.isGood() ) {
         // Make sure that the below container is not const and not a reference
         // so returning it from the function will invoke a move constructor instead of copy constructor.
@@ -50,6 +56,37 @@ std::vector<uint8_t> AGG::getDataFromAggFile( const std::string & key, const boo
     return heroes2_agg.read( key );
 }
 
+std::pair<const uint8_t *, size_t> AGG::getDataViewFromAggFile( const std::string & key, const bool ignoreExpansion, std::vector<uint8_t> & buffer )
+{
+    const auto readIntoBuffer = [&key, ignoreExpansion, &buffer]() -> std::pair<const uint8_t *, size_t> {
+        buffer = getDataFromAggFile( key, ignoreExpansion );
+        return { buffer.data(), buffer.size() };
+    };
+
+    // Memory-mapped files are never modified after opening, so their views can be accessed without locking.
+    if ( !ignoreExpansion && heroes2x_agg.isGood() ) {
+        if ( !heroes2x_agg.isMemoryMapped() ) {
+            return readIntoBuffer();
+        }
+
+        const std::pair<const uint8_t *, size_t> view = heroes2x_agg.readView( key );
+        if ( view.first != nullptr ) {
+            return view;
+        }
+    }
+
+    if ( !heroes2_agg.isMemoryMapped() ) {
+        return readIntoBuffer();
+    }
+
+    return heroes2_agg.readView( key );
+}
+
+uint64_t AGG::getAGGFilesSignature()
+{
+    return heroes2_agg.getSignature() ^ ( heroes2x_agg.isGood() ? ( heroes2x_agg.getSignature() << 1 ) : 0 );
+}
+
 AGG::AGGInitializer::AGGInitializer()
 {
     if ( init() ) {
@@ -23,8 +23,10 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace AGG
@@ -56,4 +58,11 @@ namespace AGG
     };
 
     std::vector<uint8_t> getDataFromAggFile( const std::string & key, const bool ignoreExpansion );
+
+    // Returns a view of the data of the given AGG file entry. If the AGG file is memory-mapped the view points directly into
+    // the mapped file, otherwise the data is read into the provided buffer which must outlive the view.
+    std::pair<const uint8_t *, size_t> getDataViewFromAggFile( const std::string & key, const bool ignoreExpansion, std::vector<uint8_t> & buffer );
+
+    // Returns the combined signature of all opened AGG files.
+    uint64_t getAGGFilesSignature();
 }
@@ -24,10 +24,15 @@
 #include <array>
 #include <cassert>
 #include <cmath>
+#include <condition_variable>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <initializer_list>
 #include <map>
+#include <mutex>
 #include <numeric>
+#include <optional>
 #include <set>
 #include <stdexcept>
 #include <string>
@@ -36,18 +41,23 @@
 
 #include "agg.h"
 #include "agg_file.h"
+#include "agg_image_cache.h"
 #include "battle_cell.h"
 #include "exception.h"
 #include "game_language.h"
 #include "h2d.h"
 #include "icn.h"
 #include "image.h"
+#include "image_compact.h"
 #include "image_tool.h"
+#include "logging.h"
 #include "math_base.h"
+#include "network/state_hash.h"
 #include "pal.h"
 #include "rand.h"
 #include "screen.h"
 #include "serialize.h"
+#include "thread.h"
 #include "til.h"
 #include "tools.h"
 #include "translations.h"
@@ -56,6 +66,7 @@
 #include "ui_language.h"
 #include "ui_text.h"
 #include "ui_tool.h"
+#include "version.h"
 
 namespace
 {
@@ -69,6 +80,56 @@ namespace
 
     std::map<int, std::vector<fheroes2::Sprite>> _icnVsScaledSprite;
 
+    // ICNs released from memory to fit into the memory budget are kept in the compact form if it takes much less memory.
+    // Such ICNs are decompressed on the next request instead of being decoded and processed again.
+    std::map<int, std::vector<fheroes2::CompactSprite>> _icnVsCompactSprite;
+
+    // The value of the access counter at the moment of the last access to each ICN. It is used to find the least recently used ICNs.
+    std::vector<uint64_t> _icnLastAccess( ICN::LASTICN, 0 );
+    uint64_t _icnAccessCounter{ 0 };
+
+    // Memory budget in bytes for decoded ICN sprites. 0 means that the amount of memory is not limited.
+#if defined( TARGET_PS_VITA )
+    size_t _icnMemoryBudget{ 48 * 1024 * 1024 };
+#elif defined( TARGET_NINTENDO_SWITCH )
+    size_t _icnMemoryBudget{ 128 * 1024 * 1024 };
+#else
+    size_t _icnMemoryBudget{ 0 };
+#endif
+
+    // These ICNs are never released from memory:
+    // - fonts are modified in place at the time of setting up a language, so they cannot be just reloaded from AGG file
+    // - MINIMON is modified in place while generating mini monster images, reloading it would lead to the images modified twice
+    // - the rest are used almost on every screen and would be reloaded right away
+    const std::set<int> pinnedIcnId{ ICN::FONT,
+                                     ICN::SMALFONT,
+                                     ICN::BUTTON_GOOD_FONT_RELEASED,
+                                     ICN::BUTTON_GOOD_FONT_PRESSED,
+                                     ICN::BUTTON_EVIL_FONT_RELEASED,
+                                     ICN::BUTTON_EVIL_FONT_PRESSED,
+                                     ICN::YELLOW_FONT,
+                                     ICN::YELLOW_SMALLFONT,
+                                     ICN::GRAY_FONT,
+                                     ICN::GRAY_SMALL_FONT,
+                                     ICN::WHITE_LARGE_FONT,
+                                     ICN::GOLDEN_GRADIENT_FONT,
+                                     ICN::GOLDEN_GRADIENT_LARGE_FONT,
+                                     ICN::SILVER_GRADIENT_FONT,
+                                     ICN::SILVER_GRADIENT_LARGE_FONT,
+                                     ICN::MINIMON,
+                                     ICN::MINI_MONSTER_IMAGE,
+                                     ICN::MINI_MONSTER_SHADOW,
+                                     ICN::ADVMCO,
+                                     ICN::SPELCO,
+                                     ICN::CMSECO,
+                                     ICN::TEXTBACK,
+                                     ICN::TEXTBAK2,
+                                     ICN::SYSTEM,
+                                     ICN::SYSTEME,
+                                     ICN::REDBACK,
+                                     ICN::STONEBAK,
+                                     ICN::STONEBAK_EVIL };
+
     // Some resources are language dependent. These are mostly buttons with a text of them.
     // Once a user changes a language we have to update resources. To do this we need to clear the existing images.
 
@@ -207,6 +268,37 @@ namespace
         return id > ICN::UNKNOWN && static_cast<size_t>( id ) < _icnVsSprite.size();
     }
 
+    size_t getSpriteMemorySize( const fheroes2::Sprite & sprite )
+    {
+        const size_t pixelCount = static_cast<size_t>( sprite.width() ) * static_cast<size_t>( sprite.height() );
+        return sprite.singleLayer() ? pixelCount : pixelCount * 2;
+    }
+
+    size_t getICNMemorySize( const int id )
+    {
+        size_t size = 0;
+
+        for ( const fheroes2::Sprite & sprite : _icnVsSprite[id] ) {
+            size += getSpriteMemorySize( sprite );
+        }
+
+        const auto scaledIter = _icnVsScaledSprite.find( id );
+        if ( scaledIter != _icnVsScaledSprite.end() ) {
+            for ( const fheroes2::Sprite & sprite : scaledIter->second ) {
+                size += getSpriteMemorySize( sprite );
+            }
+        }
+
+        const auto compactIter = _icnVsCompactSprite.find( id );
+        if ( compactIter != _icnVsCompactSprite.end() ) {
+            for ( const fheroes2::CompactSprite & sprite : compactIter->second ) {
+                size += sprite.getMemorySize();
+            }
+        }
+
+        return size;
+    }
+
     bool IsValidTILId( int id )
     {
         return id >= 0 && static_cast<size_t>( id ) < _tilVsImage.size();
@@ -259,6 +351,7 @@ namespace
     }
 
     // This class serves the purpose of preserving the original alphabet which is loaded from AGG files for cases when we generate new language alphabet.
+    // Button fonts are not preserved since they are fully generated and are rebuilt on demand for the current language.
     class OriginalAlphabetPreserver final
     {
     public:
@@ -270,17 +363,9 @@ namespace
 
             fheroes2::AGG::GetICN( ICN::FONT, 0 );
             fheroes2::AGG::GetICN( ICN::SMALFONT, 0 );
-            fheroes2::AGG::GetICN( ICN::BUTTON_GOOD_FONT_RELEASED, 0 );
-            fheroes2::AGG::GetICN( ICN::BUTTON_GOOD_FONT_PRESSED, 0 );
-            fheroes2::AGG::GetICN( ICN::BUTTON_EVIL_FONT_RELEASED, 0 );
-            fheroes2::AGG::GetICN( ICN::BUTTON_EVIL_FONT_PRESSED, 0 );
 
             _normalFont = _icnVsSprite[ICN::FONT];
             _smallFont = _icnVsSprite[ICN::SMALFONT];
-            _buttonGoodReleasedFont = _icnVsSprite[ICN::BUTTON_GOOD_FONT_RELEASED];
-            _buttonGoodPressedFont = _icnVsSprite[ICN::BUTTON_GOOD_FONT_PRESSED];
-            _buttonEvilReleasedFont = _icnVsSprite[ICN::BUTTON_EVIL_FONT_RELEASED];
-            _buttonEvilPressedFont = _icnVsSprite[ICN::BUTTON_EVIL_FONT_PRESSED];
 
             _isPreserved = true;
         }
@@ -294,10 +379,6 @@ namespace
             // Restore the original font.
             _icnVsSprite[ICN::FONT] = _normalFont;
             _icnVsSprite[ICN::SMALFONT] = _smallFont;
-            _icnVsSprite[ICN::BUTTON_GOOD_FONT_RELEASED] = _buttonGoodReleasedFont;
-            _icnVsSprite[ICN::BUTTON_GOOD_FONT_PRESSED] = _buttonGoodPressedFont;
-            _icnVsSprite[ICN::BUTTON_EVIL_FONT_RELEASED] = _buttonEvilReleasedFont;
-            _icnVsSprite[ICN::BUTTON_EVIL_FONT_PRESSED] = _buttonEvilPressedFont;
 
             // Clear modified fonts.
             _icnVsSprite[ICN::YELLOW_FONT].clear();
@@ -321,22 +402,24 @@ namespace
 
         std::vector<fheroes2::Sprite> _normalFont;
         std::vector<fheroes2::Sprite> _smallFont;
-        std::vector<fheroes2::Sprite> _buttonGoodReleasedFont;
-        std::vector<fheroes2::Sprite> _buttonGoodPressedFont;
-        std::vector<fheroes2::Sprite> _buttonEvilReleasedFont;
-        std::vector<fheroes2::Sprite> _buttonEvilPressedFont;
     };
 
     OriginalAlphabetPreserver alphabetPreserver;
 
+    // The language for which button fonts are generated the next time they are requested.
+    fheroes2::SupportedLanguage buttonFontLanguage{ fheroes2::SupportedLanguage::English };
+
     // This class is used for situations when we need to remove letter-specific offsets, like when we display single letters in a row,
     // and then restore these offsets within the scope of the code
     class ButtonFontOffsetRestorer final
     {
     public:
-        ButtonFontOffsetRestorer( std::vector<fheroes2::Sprite> & font, const int32_t offsetX )
-            : _font( font )
+        ButtonFontOffsetRestorer( const int fontIcnId, const int32_t offsetX )
+            : _font( _icnVsSprite[fontIcnId] )
         {
+            // Button fonts are generated on demand so make sure that they exist before changing the offsets.
+            fheroes2::AGG::GetICN( fontIcnId, 0 );
+
             _originalXOffsets.reserve( _font.size() );
 
             for ( fheroes2::Sprite & characterSprite : _font ) {
@@ -547,18 +630,17 @@ namespace
 
     // This function returns true if sprites were successfully loaded from AGG file.
     // WARNING: this function must be called once - only in the beginning of `loadICN()` function.
-    bool readIcnFromAgg( const int id )
+    // Reads and decodes the ICN from AGG file without altering the ICN storage, so it can be called from any thread.
+    bool decodeIcnFromAgg( const int id, std::vector<fheroes2::Sprite> & sprites )
     {
-        // If this assertion blows up then something wrong with your logic and you load resources more than once!
-        assert( _icnVsSprite[id].empty() );
+        std::vector<uint8_t> buffer;
+        const auto [body, bodySize] = ::AGG::getDataViewFromAggFile( ICN::getIcnFileName( id ), false, buffer );
 
-        const std::vector<uint8_t> & body = ::AGG::getDataFromAggFile( ICN::getIcnFileName( id ), false );
-
-        if ( body.empty() ) {
+        if ( bodySize == 0 ) {
             return false;
         }
 
-        ROStreamBuf imageStream( body );
+        ROStreamBuf imageStream( body, bodySize );
 
         const uint32_t count = imageStream.getLE16();
         const uint32_t blockSize = imageStream.getLE32();
@@ -566,7 +648,7 @@ namespace
             return false;
         }
 
-        _icnVsSprite[id].resize( count );
+        sprites.resize( count );
 
         for ( uint32_t i = 0; i < count; ++i ) {
             imageStream.seek( headerSize + i * 13 );
@@ -587,22 +669,142 @@ namespace
                 dataSize = blockSize - header1.offsetData;
             }
 
-            if ( headerSize + header1.offsetData + dataSize > body.size() ) {
+            if ( headerSize + header1.offsetData + dataSize > bodySize ) {
                 // This is a corrupted AGG file.
                 throw fheroes2::InvalidDataResources( "ICN Id " + std::to_string( id ) + ", index " + std::to_string( i )
                                                       + " is being corrupted. "
                                                         "Make sure that you own an official version of the game." );
             }
 
-            const uint8_t * data = body.data() + headerSize + header1.offsetData;
+            const uint8_t * data = body + headerSize + header1.offsetData;
             const uint8_t * dataEnd = data + dataSize;
 
-            _icnVsSprite[id][i] = fheroes2::decodeICNSprite( data, dataEnd, header1 );
+            sprites[i] = fheroes2::decodeICNSprite( data, dataEnd, header1 );
         }
 
         return true;
     }
 
+    // Decodes ICNs from AGG file in advance using the job system. The decoded ICNs are kept here until the main thread requests them.
+    class ICNPreloader
+    {
+    public:
+        void prefetch( const int id )
+        {
+            {
+                const std::scoped_lock<std::mutex> lock( _mutex );
+
+                if ( !_icns.emplace( id, std::nullopt ).second ) {
+                    // This ICN is already being decoded.
+                    return;
+                }
+            }
+
+            MultiThreading::JobSystem::Get().submit( [this, id]() {
+                std::vector<fheroes2::Sprite> sprites;
+
+                try {
+                    if ( !decodeIcnFromAgg( id, sprites ) ) {
+                        sprites.clear();
+                    }
+                }
+                catch ( ... ) {
+                    // The main thread is going to decode this ICN again and handle the error.
+                    sprites.clear();
+                }
+
+                {
+                    const std::scoped_lock<std::mutex> lock( _mutex );
+
+                    auto iter = _icns.find( id );
+                    assert( iter != _icns.end() );
+
+                    iter->second = std::move( sprites );
+                }
+
+                _decodedNotification.notify_all();
+            } );
+        }
+
+        // Returns true and moves the sprites of the prefetched ICN out of the preloader if the ICN has been successfully decoded.
+        // Waits for the decoding if it is still in progress.
+        bool take( const int id, std::vector<fheroes2::Sprite> & sprites )
+        {
+            std::unique_lock<std::mutex> lock( _mutex );
+
+            auto iter = _icns.find( id );
+            if ( iter == _icns.end() ) {
+                return false;
+            }
+
+            // Other pending jobs are not executed meanwhile as they may take much longer than the decoding of this ICN.
+            _decodedNotification.wait( lock, [&iter]() { return iter->second.has_value(); } );
+
+            const bool isDecoded = !iter->second->empty();
+            if ( isDecoded ) {
+                sprites = std::move( *iter->second );
+            }
+
+            _icns.erase( iter );
+
+            return isDecoded;
+        }
+
+        // Returns true if the ICN is not being decoded, so take() returns immediately.
+        bool isDecoded( const int id )
+        {
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
+            const auto iter = _icns.find( id );
+            return iter == _icns.end() || iter->second.has_value();
+        }
+
+        // Discards all decoded ICNs which have not been requested.
+        void clear()
+        {
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
+            for ( auto iter = _icns.begin(); iter != _icns.end(); ) {
+                if ( iter->second ) {
+                    iter = _icns.erase( iter );
+                }
+                else {
+                    ++iter;
+                }
+            }
+        }
+
+    private:
+        std::mutex _mutex;
+        std::condition_variable _decodedNotification;
+
+        // The ICN has no value while it is being decoded.
+        std::map<int, std::optional<std::vector<fheroes2::Sprite>>> _icns;
+    };
+
+    ICNPreloader icnPreloader;
+
+    fheroes2::ICNDiskCache icnDiskCache;
+
+    bool isICNDiskCacheable( const int id )
+    {
+        // Pinned ICNs are either modified in place by other code or modify other ICNs while being generated.
+        // Language dependent ICNs contain translated texts.
+        return icnDiskCache.isOpen() && pinnedIcnId.count( id ) == 0 && !isLanguageDependentIcnId( id );
+    }
+
+    bool readIcnFromAgg( const int id )
+    {
+        // If this assertion blows up then something wrong with your logic and you load resources more than once!
+        assert( _icnVsSprite[id].empty() );
+
+        if ( icnPreloader.take( id, _icnVsSprite[id] ) ) {
+            return true;
+        }
+
+        return decodeIcnFromAgg( id, _icnVsSprite[id] );
+    }
+
     // Helper function for processICN
     void CopyICNWithPalette( const int icnId, const int originalIcnId, const PAL::PaletteType paletteType )
     {
@@ -1253,8 +1455,8 @@ namespace
 
             // We need to temporarily remove the letter-specific X offsets in the font because if not the letters will
             // be off-centered when we are displaying one letter per line
-            const ButtonFontOffsetRestorer fontReleased( _icnVsSprite[ICN::BUTTON_GOOD_FONT_RELEASED], -1 );
-            const ButtonFontOffsetRestorer fontPressed( _icnVsSprite[ICN::BUTTON_GOOD_FONT_PRESSED], -1 );
+            const ButtonFontOffsetRestorer fontReleased( ICN::BUTTON_GOOD_FONT_RELEASED, -1 );
+            const ButtonFontOffsetRestorer fontPressed( ICN::BUTTON_GOOD_FONT_PRESSED, -1 );
 
             const char * text = fheroes2::getSupportedText( gettext_noop( "D\nI\nS\nM\nI\nS\nS" ), fheroes2::FontType::buttonReleasedWhite() );
             getTextAdaptedSprite( _icnVsSprite[id][0], _icnVsSprite[id][1], text, ICN::EMPTY_VERTICAL_GOOD_BUTTON, ICN::REDBAK_SMALL_VERTICAL );
@@ -1284,8 +1486,8 @@ namespace
 
             // We need to temporarily remove the letter specific X offsets in the font because if not the letters will
             // be off-centered when we are displaying one letter per line
-            const ButtonFontOffsetRestorer fontReleased( _icnVsSprite[ICN::BUTTON_GOOD_FONT_RELEASED], -1 );
-            const ButtonFontOffsetRestorer fontPressed( _icnVsSprite[ICN::BUTTON_GOOD_FONT_PRESSED], -1 );
+            const ButtonFontOffsetRestorer fontReleased( ICN::BUTTON_GOOD_FONT_RELEASED, -1 );
+            const ButtonFontOffsetRestorer fontPressed( ICN::BUTTON_GOOD_FONT_PRESSED, -1 );
 
             const char * text = fheroes2::getSupportedText( gettext_noop( "E\nX\nI\nT" ), fheroes2::FontType::buttonReleasedWhite() );
             getTextAdaptedSprite( _icnVsSprite[id][0], _icnVsSprite[id][1], text, ICN::EMPTY_VERTICAL_GOOD_BUTTON, ICN::REDBAK_SMALL_VERTICAL );
@@ -1336,8 +1538,8 @@ namespace
                 buttonText = gettext_noop( "E\nX\nI\nT" );
             }
 
-            const ButtonFontOffsetRestorer fontRestorerReleased( _icnVsSprite[ICN::BUTTON_GOOD_FONT_RELEASED], -1 );
-            const ButtonFontOffsetRestorer fontRestorerPressed( _icnVsSprite[ICN::BUTTON_GOOD_FONT_PRESSED], -1 );
+            const ButtonFontOffsetRestorer fontRestorerReleased( ICN::BUTTON_GOOD_FONT_RELEASED, -1 );
+            const ButtonFontOffsetRestorer fontRestorerPressed( ICN::BUTTON_GOOD_FONT_PRESSED, -1 );
 
             const char * translatedText = fheroes2::getSupportedText( buttonText, fheroes2::FontType{ fheroes2::FontSize::BUTTON_RELEASED, fheroes2::FontColor::WHITE } );
             fheroes2::renderTextOnButton( _icnVsSprite[id][0], _icnVsSprite[id][1], translatedText, { 3, 4 }, { 2, 5 }, { 23, 133 }, fheroes2::FontColor::WHITE );
@@ -1780,8 +1982,8 @@ namespace
 
             // We need to temporarily remove the letter specific X offsets in the font because if not the letters will
             // be off-centered when we are displaying one letter per line
-            const ButtonFontOffsetRestorer fontReleased( _icnVsSprite[ICN::BUTTON_GOOD_FONT_RELEASED], -1 );
-            const ButtonFontOffsetRestorer fontPressed( _icnVsSprite[ICN::BUTTON_GOOD_FONT_PRESSED], -1 );
+            const ButtonFontOffsetRestorer fontReleased( ICN::BUTTON_GOOD_FONT_RELEASED, -1 );
+            const ButtonFontOffsetRestorer fontPressed( ICN::BUTTON_GOOD_FONT_PRESSED, -1 );
 
             const char * text = fheroes2::getSupportedText( gettext_noop( "P\nA\nT\nR\nO\nL" ), fheroes2::FontType::buttonReleasedWhite() );
             getTextAdaptedSprite( _icnVsSprite[id][0], _icnVsSprite[id][1], text, ICN::EMPTY_VERTICAL_GOOD_BUTTON, ICN::REDBAK_SMALL_VERTICAL );
@@ -4667,8 +4869,8 @@ namespace
         case ICN::BUTTON_GOOD_FONT_PRESSED:
         case ICN::BUTTON_EVIL_FONT_RELEASED:
         case ICN::BUTTON_EVIL_FONT_PRESSED: {
-            generateBaseButtonFont( _icnVsSprite[ICN::BUTTON_GOOD_FONT_RELEASED], _icnVsSprite[ICN::BUTTON_GOOD_FONT_PRESSED],
-                                    _icnVsSprite[ICN::BUTTON_EVIL_FONT_RELEASED], _icnVsSprite[ICN::BUTTON_EVIL_FONT_PRESSED] );
+            // All button fonts are generated at once only when one of them is requested for the first time after a language change.
+            generateButtonAlphabet( buttonFontLanguage, _icnVsSprite );
             break;
         }
         case ICN::HISCORE: {
@@ -5387,12 +5589,29 @@ namespace
             return;
         }
 
+        const auto compactIter = _icnVsCompactSprite.find( id );
+        if ( compactIter != _icnVsCompactSprite.end() ) {
+            _icnVsSprite[id].reserve( compactIter->second.size() );
+
+            for ( const fheroes2::CompactSprite & sprite : compactIter->second ) {
+                _icnVsSprite[id].emplace_back( sprite.decompress() );
+            }
+
+            _icnVsCompactSprite.erase( compactIter );
+            return;
+        }
+
         // Some images contain text. This text should be adapted to a chosen language.
         if ( isLanguageDependentIcnId( id ) ) {
             generateLanguageSpecificImages( id );
             return;
         }
 
+        const bool isCacheable = isICNDiskCacheable( id );
+        if ( isCacheable && icnDiskCache.load( id, _icnVsSprite[id] ) ) {
+            return;
+        }
+
         // Load the original ICN from AGG file.
         // WARNING: The `readIcnFromAgg()` function must be called only in this place!
         if ( id < ICN::LAST_VALID_FILE_ICN && !readIcnFromAgg( id ) ) {
@@ -5409,6 +5628,11 @@ namespace
             // This could happen by one reason: asking to render an ICN that simply doesn't exist within the resources.
             // In order to avoid subsequent attempts to get resources from this ICN we are making it as non-empty.
             _icnVsSprite[id].resize( 1 );
+            return;
+        }
+
+        if ( isCacheable ) {
+            icnDiskCache.store( id, _icnVsSprite[id] );
         }
     }
 
@@ -5426,24 +5650,25 @@ namespace
         if ( tilImages.empty() ) {
             tilImages.resize( 4 ); // 4 possible sides
 
-            const std::vector<uint8_t> & data = ::AGG::getDataFromAggFile( tilFileName[id], false );
-            if ( data.size() < headerSize ) {
+            std::vector<uint8_t> dataBuffer;
+            const auto [data, dataSize] = ::AGG::getDataViewFromAggFile( tilFileName[id], false, dataBuffer );
+            if ( dataSize < headerSize ) {
                 // The important resource is absent! Make sure that you are using the correct version of the game.
                 assert( 0 );
                 return 0;
             }
 
-            ROStreamBuf buffer( data );
+            ROStreamBuf buffer( data, dataSize );
 
             const size_t count = buffer.getLE16();
             const int32_t width = buffer.getLE16();
             const int32_t height = buffer.getLE16();
-            if ( count < 1 || width < 1 || height < 1 || ( headerSize + count * width * height ) != data.size() ) {
+            if ( count < 1 || width < 1 || height < 1 || ( headerSize + count * width * height ) != dataSize ) {
                 return 0;
             }
 
             std::vector<fheroes2::Image> & originalTIL = tilImages[0];
-            decodeTILImages( data.data() + headerSize, count, width, height, originalTIL );
+            decodeTILImages( data + headerSize, count, width, height, originalTIL );
 
             for ( uint32_t shapeId = 1; shapeId < 4; ++shapeId ) {
                 tilImages[shapeId].resize( count );
@@ -5539,6 +5764,8 @@ namespace fheroes2::AGG
             return errorImage;
         }
 
+        _icnLastAccess[icnId] = ++_icnAccessCounter;
+
         if ( IsScalableICN( icnId ) ) {
             return GetScaledICN( icnId, index );
         }
@@ -5555,6 +5782,167 @@ namespace fheroes2::AGG
         return static_cast<uint32_t>( GetMaximumICNIndex( icnId ) );
     }
 
+    void setICNMemoryBudget( const size_t bytes )
+    {
+        _icnMemoryBudget = bytes;
+    }
+
+    bool openICNDiskCache( const std::string & filePath )
+    {
+        uint64_t signature = ::AGG::getAGGFilesSignature();
+        for ( const uint64_t version : { MAJOR_VERSION, MINOR_VERSION, INTERMEDIATE_VERSION, BUILD_VERSION } ) {
+            signature = Network::mixHash( signature ^ version );
+        }
+
+        return icnDiskCache.open( filePath, signature );
+    }
+
+    void prefetchICNs( const std::vector<int> & icnIds )
+    {
+        for ( const int id : icnIds ) {
+            // Only ICNs stored in AGG files can be decoded in advance. The rest are generated and processed by the main thread.
+            if ( !IsValidICNId( id ) || id >= ICN::LAST_VALID_FILE_ICN || !_icnVsSprite[id].empty() || isLanguageDependentIcnId( id ) ) {
+                continue;
+            }
+
+            icnPreloader.prefetch( id );
+        }
+    }
+
+    bool isICNReady( const int icnId )
+    {
+        if ( !IsValidICNId( icnId ) || icnId >= ICN::LAST_VALID_FILE_ICN || !_icnVsSprite[icnId].empty() || isLanguageDependentIcnId( icnId ) ) {
+            return true;
+        }
+
+        // Nothing happens if the ICN is already being decoded.
+        icnPreloader.prefetch( icnId );
+
+        return icnPreloader.isDecoded( icnId );
+    }
+
+    void releaseUnusedICNs()
+    {
+        icnPreloader.clear();
+
+        if ( _icnMemoryBudget == 0 ) {
+            return;
+        }
+
+        std::vector<std::pair<uint64_t, int>> candidates;
+        size_t totalSize = 0;
+
+        for ( int id = ICN::UNKNOWN + 1; id < ICN::LASTICN; ++id ) {
+            const size_t size = getICNMemorySize( id );
+            if ( size == 0 ) {
+                continue;
+            }
+
+            totalSize += size;
+
+            if ( pinnedIcnId.count( id ) == 0 ) {
+                candidates.emplace_back( _icnLastAccess[id], id );
+            }
+        }
+
+        if ( totalSize <= _icnMemoryBudget ) {
+            return;
+        }
+
+        std::sort( candidates.begin(), candidates.end() );
+
+        size_t releasedSize = 0;
+        size_t releasedCount = 0;
+        size_t compactedCount = 0;
+
+        // Decoded ICNs are compacted first. The ICNs are released completely only if it is not enough to fit into the budget.
+        for ( const bool isCompactingAllowed : { true, false } ) {
+            for ( const auto & [lastAccess, id] : candidates ) {
+                if ( totalSize - releasedSize <= _icnMemoryBudget ) {
+                    break;
+                }
+
+                const size_t size = getICNMemorySize( id );
+                if ( size == 0 ) {
+                    continue;
+                }
+
+                if ( isCompactingAllowed ) {
+                    // Language dependent ICNs are generated again after changing the language, so they cannot be stored.
+                    if ( _icnVsSprite[id].empty() || isLanguageDependentIcnId( id ) ) {
+                        continue;
+                    }
+
+                    size_t compactSize = 0;
+
+                    std::vector<fheroes2::CompactSprite> compactSprites;
+                    compactSprites.reserve( _icnVsSprite[id].size() );
+
+                    for ( const fheroes2::Sprite & sprite : _icnVsSprite[id] ) {
+                        compactSprites.emplace_back( sprite );
+                        compactSize += compactSprites.back().getMemorySize();
+                    }
+
+                    // It makes no sense to keep ICNs which take almost the same memory in the compact form.
+                    if ( compactSize > size / 2 ) {
+                        continue;
+                    }
+
+                    _icnVsCompactSprite[id] = std::move( compactSprites );
+                    releasedSize += size - compactSize;
+                    ++compactedCount;
+                }
+                else {
+                    releasedSize += size;
+                    ++releasedCount;
+
+                    _icnVsCompactSprite.erase( id );
+                }
+
+                // Swap with an empty vector to actually free the memory. The empty vector means that the ICN is going to be loaded on the next request.
+                std::vector<fheroes2::Sprite>().swap( _icnVsSprite[id] );
+                _icnVsScaledSprite.erase( id );
+            }
+        }
+
+        DEBUG_LOG( DBG_ENGINE, DBG_INFO,
+                   "Compacted " << compactedCount << " and released " << releasedCount << " ICNs, " << releasedSize << " bytes. " << totalSize - releasedSize
+                                << " bytes of " << _icnMemoryBudget << " bytes of the budget are still in use." )
+    }
+
+    size_t getICNMemoryUsage()
+    {
+        size_t totalSize = 0;
+
+        for ( int id = ICN::UNKNOWN + 1; id < ICN::LASTICN; ++id ) {
+            totalSize += getICNMemorySize( id );
+        }
+
+        return totalSize;
+    }
+
+    void logICNMemoryUsage()
+    {
+        std::vector<std::pair<size_t, int>> usage;
+        size_t totalSize = 0;
+
+        for ( int id = ICN::UNKNOWN + 1; id < ICN::LASTICN; ++id ) {
+            const size_t size = getICNMemorySize( id );
+            if ( size > 0 ) {
+                usage.emplace_back( size, id );
+                totalSize += size;
+            }
+        }
+
+        std::sort( usage.begin(), usage.end(), std::greater<>() );
+
+        COUT( "Decoded ICNs: " << usage.size() << ", resident memory: " << totalSize << " bytes, budget: " << _icnMemoryBudget << " bytes." )
+
+        for ( const auto & [size, id] : usage ) {
+            COUT( ICN::getIcnFileName( id ) << " (" << id << "): " << size << " bytes" << ( pinnedIcnId.count( id ) > 0 ? ", pinned" : "" ) )
+        }
+    }
+
     const Image & GetTIL( int tilId, uint32_t index, uint32_t shapeId )
     {
         if ( shapeId > 3 ) {
@@ -5608,7 +5996,12 @@ namespace fheroes2::AGG
             generateAlphabet( language, _icnVsSprite );
         }
 
-        generateButtonAlphabet( language, _icnVsSprite );
+        // Button fonts are going to be generated for the new language when they are requested.
+        buttonFontLanguage = language;
+        _icnVsSprite[ICN::BUTTON_GOOD_FONT_RELEASED].clear();
+        _icnVsSprite[ICN::BUTTON_GOOD_FONT_PRESSED].clear();
+        _icnVsSprite[ICN::BUTTON_EVIL_FONT_RELEASED].clear();
+        _icnVsSprite[ICN::BUTTON_EVIL_FONT_PRESSED].clear();
 
         // Clear language dependent resources.
         for ( const int id : languageDependentIcnId ) {
@@ -20,7 +20,10 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <string>
+#include <vector>
 
 namespace fheroes2
 {
@@ -31,9 +34,34 @@ namespace fheroes2
 
     namespace AGG
     {
+        // Must be called only from the main thread as ICNs are loaded and generated on demand. Use prefetchICNs() to decode ICNs in the background.
         const Sprite & GetICN( int icnId, uint32_t index );
         uint32_t GetICNCount( int icnId );
 
+        // Opens the on-disk cache of processed ICNs. Must be called after AGG files are opened and before any ICN is loaded.
+        bool openICNDiskCache( const std::string & filePath );
+
+        // Starts decoding of the given ICNs in the background. Call it before a screen transition with the list of ICNs the next screen needs.
+        void prefetchICNs( const std::vector<int> & icnIds );
+
+        // Returns true if GetICN() can return the sprites of the given ICN without decoding them. Otherwise starts decoding the ICN in the background
+        // and returns false, so the caller can draw something else instead of the ICN sprites and try again later. ICNs which cannot be decoded
+        // in the background are always reported as ready.
+        bool isICNReady( const int icnId );
+
+        // Sets the maximum amount of memory in bytes used by decoded ICN sprites. 0 means no limit.
+        void setICNMemoryBudget( const size_t bytes );
+
+        // Releases the least recently used ICNs until their total size fits into the memory budget.
+        // Sprites returned by GetICN() might be released, so call this function only at a point where no references to them are held.
+        void releaseUnusedICNs();
+
+        // Returns the resident memory size of all decoded ICNs.
+        size_t getICNMemoryUsage();
+
+        // Prints the resident memory size of every decoded ICN.
+        void logICNMemoryUsage();
+
         // shapeId could be 0, 1, 2 or 3 only
         const Image & GetTIL( int tilId, uint32_t index, uint32_t shapeId );
 
@@ -0,0 +1,233 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "agg_image_cache.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "image.h"
+#include "logging.h"
+#include "system.h"
+
+namespace
+{
+    const uint32_t cacheMagic{ 0x49324846 }; // "FH2I"
+
+    // Increase this number every time the format of the cache file changes.
+    const uint32_t cacheFormatVersion{ 1 };
+
+    // Magic, format version and signature.
+    const size_t headerSize{ 4 + 4 + 8 };
+
+    // ICN ID and the ICN data size.
+    const size_t entryHeaderSize{ 4 + 4 };
+
+    // Width, height, x and y offsets and the single layer flag.
+    const size_t spriteHeaderSize{ 4 + 4 + 4 + 4 + 1 };
+
+    const int32_t maxSpriteSize{ 65535 };
+
+    void writeHeader( StreamFile & stream, const uint64_t signature )
+    {
+        stream.putLE32( cacheMagic );
+        stream.putLE32( cacheFormatVersion );
+        stream.put64( signature );
+    }
+}
+
+namespace fheroes2
+{
+    bool ICNDiskCache::open( const std::string & filePath, const uint64_t signature )
+    {
+        _isOpen = false;
+        _data.clear();
+        _entries.clear();
+        _storedIcnIds.clear();
+
+        size_t validSize = 0;
+
+        {
+            StreamFile input;
+            if ( System::IsFile( filePath ) && input.open( filePath, "rb" ) ) {
+                _data = input.getRaw( input.size() );
+            }
+        }
+
+        if ( _data.size() >= headerSize ) {
+            ROStreamBuf stream( _data );
+
+            if ( stream.getLE32() == cacheMagic && stream.getLE32() == cacheFormatVersion && stream.get64() == signature ) {
+                validSize = headerSize;
+            }
+        }
+
+        if ( validSize == 0 ) {
+            DEBUG_LOG( DBG_ENGINE, DBG_INFO, "The ICN cache " << filePath << " is absent or outdated and is going to be rebuilt." )
+
+            return _recreate( filePath, signature );
+        }
+
+        // Index all the complete entries. An incomplete entry could appear if the game was terminated while writing it.
+        while ( validSize + entryHeaderSize <= _data.size() ) {
+            ROStreamBuf stream( _data.data() + validSize, entryHeaderSize );
+
+            const int icnId = static_cast<int>( stream.getLE32() );
+            const size_t entrySize = stream.getLE32();
+
+            if ( validSize + entryHeaderSize + entrySize > _data.size() ) {
+                break;
+            }
+
+            _entries[icnId] = { validSize + entryHeaderSize, entrySize };
+            validSize += entryHeaderSize + entrySize;
+        }
+
+        if ( validSize != _data.size() ) {
+            // Remove the incomplete entry from the file, otherwise new entries will be appended after it.
+            if ( !_output.open( filePath, "wb" ) ) {
+                return false;
+            }
+
+            _output.putRaw( _data.data(), validSize );
+        }
+        else if ( !_output.open( filePath, "ab" ) ) {
+            return false;
+        }
+
+        DEBUG_LOG( DBG_ENGINE, DBG_INFO, "The ICN cache " << filePath << " contains " << _entries.size() << " ICNs." )
+
+        _isOpen = true;
+        return true;
+    }
+
+    bool ICNDiskCache::load( const int icnId, std::vector<Sprite> & sprites ) const
+    {
+        const auto iter = _entries.find( icnId );
+        if ( iter == _entries.end() ) {
+            return false;
+        }
+
+        const auto [offset, size] = iter->second;
+        ROStreamBuf stream( _data.data() + offset, size );
+
+        const uint32_t count = stream.getLE32();
+
+        std::vector<Sprite> loaded( count );
+
+        for ( Sprite & sprite : loaded ) {
+            if ( stream.size() < spriteHeaderSize ) {
+                return false;
+            }
+
+            const int32_t width = static_cast<int32_t>( stream.getLE32() );
+            const int32_t height = static_cast<int32_t>( stream.getLE32() );
+            const int32_t x = static_cast<int32_t>( stream.getLE32() );
+            const int32_t y = static_cast<int32_t>( stream.getLE32() );
+            const bool isSingleLayer = ( stream.get() != 0 );
+
+            if ( width < 0 || height < 0 || width > maxSpriteSize || height > maxSpriteSize ) {
+                return false;
+            }
+
+            if ( isSingleLayer ) {
+                sprite._disableTransformLayer();
+            }
+
+            sprite.resize( width, height );
+            sprite.setPosition( x, y );
+
+            if ( sprite.empty() ) {
+                continue;
+            }
+
+            const size_t dataSize = static_cast<size_t>( width ) * static_cast<size_t>( height ) * ( isSingleLayer ? 1 : 2 );
+            const auto [data, dataViewSize] = stream.getRawView( dataSize );
+            if ( dataViewSize != dataSize ) {
+                return false;
+            }
+
+            memcpy( sprite.image(), data, dataSize );
+        }
+
+        sprites = std::move( loaded );
+
+        return true;
+    }
+
+    void ICNDiskCache::store( const int icnId, const std::vector<Sprite> & sprites )
+    {
+        if ( !_isOpen || _entries.count( icnId ) > 0 || _storedIcnIds.count( icnId ) > 0 ) {
+            return;
+        }
+
+        RWStreamBuf buffer( 4 );
+        buffer.putLE32( static_cast<uint32_t>( sprites.size() ) );
+
+        for ( const Sprite & sprite : sprites ) {
+            buffer.putLE32( static_cast<uint32_t>( sprite.width() ) );
+            buffer.putLE32( static_cast<uint32_t>( sprite.height() ) );
+            buffer.putLE32( static_cast<uint32_t>( sprite.x() ) );
+            buffer.putLE32( static_cast<uint32_t>( sprite.y() ) );
+            buffer.put( sprite.singleLayer() ? 1 : 0 );
+
+            if ( !sprite.empty() ) {
+                const size_t pixelCount = static_cast<size_t>( sprite.width() ) * static_cast<size_t>( sprite.height() );
+                buffer.putRaw( sprite.image(), sprite.singleLayer() ? pixelCount : pixelCount * 2 );
+            }
+        }
+
+        _output.putLE32( static_cast<uint32_t>( icnId ) );
+        _output.putLE32( static_cast<uint32_t>( buffer.size() ) );
+        _output.putRaw( buffer.data(), buffer.size() );
+
+        if ( _output.fail() ) {
+            ERROR_LOG( "Failed to write ICN " << icnId << " to the ICN cache." )
+
+            _isOpen = false;
+            return;
+        }
+
+        _storedIcnIds.emplace( icnId );
+    }
+
+    bool ICNDiskCache::_recreate( const std::string & filePath, const uint64_t signature )
+    {
+        _data.clear();
+        _entries.clear();
+
+        if ( !_output.open( filePath, "wb" ) ) {
+            return false;
+        }
+
+        writeHeader( _output, signature );
+
+        if ( _output.fail() ) {
+            return false;
+        }
+
+        _isOpen = true;
+        return true;
+    }
+}
@@ -0,0 +1,77 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "serialize.h"
+
+namespace fheroes2
+{
+    class Sprite;
+
+    // On-disk cache of fully processed ICN sprites. The cache file is bound to a signature (of AGG files and of the game build):
+    // a cache file with a different signature is discarded and filled again as ICNs are being loaded.
+    class ICNDiskCache
+    {
+    public:
+        ICNDiskCache() = default;
+        ICNDiskCache( const ICNDiskCache & ) = delete;
+
+        ~ICNDiskCache() = default;
+
+        ICNDiskCache & operator=( const ICNDiskCache & ) = delete;
+
+        bool open( const std::string & filePath, const uint64_t signature );
+
+        bool isOpen() const
+        {
+            return _isOpen;
+        }
+
+        // Returns false if the ICN is not present in the cache.
+        bool load( const int icnId, std::vector<Sprite> & sprites ) const;
+
+        void store( const int icnId, const std::vector<Sprite> & sprites );
+
+    private:
+        bool _recreate( const std::string & filePath, const uint64_t signature );
+
+        // The content of the cache file at the time of opening.
+        std::vector<uint8_t> _data;
+
+        // ICN ID and the offset and the size of the ICN data within '_data'.
+        std::map<int, std::pair<size_t, size_t>> _entries;
+
+        // ICNs written to the cache file during this session. They are available only on the next launch.
+        std::set<int> _storedIcnIds;
+
+        StreamFile _output;
+
+        bool _isOpen{ false };
+    };
+}
@@ -24,6 +24,7 @@
 #include <cstdlib>
 #include <initializer_list>
 #include <map>
+#include <mutex>
 #include <ostream>
 #include <string>
 #include <utility>
@@ -51,25 +52,30 @@ namespace
     class MonsterAnimCache
     {
     public:
-        Bin_Info::MonsterAnimInfo getAnimInfo( const int monsterID )
+        const Bin_Info::MonsterAnimInfo & getAnimInfo( const int monsterID )
         {
+            // Battle simulation might run on worker threads. References to map elements stay valid after insertion so they can be returned outside the lock.
+            const std::lock_guard<std::mutex> lock( _mutex );
+
             auto mapIterator = _animMap.find( monsterID );
             if ( mapIterator != _animMap.end() ) {
                 return mapIterator->second;
             }
 
             Bin_Info::MonsterAnimInfo info( monsterID, AGG::getDataFromAggFile( GetFilename( monsterID ), false ) );
-            if ( info.isValid() ) {
-                _animMap[monsterID] = info;
-                return info;
+            if ( !info.isValid() ) {
+                DEBUG_LOG( DBG_GAME, DBG_WARN, "Missing BIN file data: " << GetFilename( monsterID ) << ", monster ID: " << monsterID )
+
+                // Store an empty object to avoid loading the data again.
+                info = {};
             }
 
-            DEBUG_LOG( DBG_GAME, DBG_WARN, "Missing BIN file data: " << GetFilename( monsterID ) << ", monster ID: " << monsterID )
-            return {};
+            return _animMap.emplace( monsterID, std::move( info ) ).first->second;
         }
 
     private:
         std::map<int, Bin_Info::MonsterAnimInfo> _animMap;
+        std::mutex _mutex;
     };
 
     MonsterAnimCache _infoCache;
@@ -228,6 +234,10 @@ namespace Bin_Info
             projectileAngles.push_back( getValue<float>( data, 187, i ) );
         }
 
+        for ( size_t i = 1; i < projectileAngles.size(); ++i ) {
+            projectileAngleBoundaries.push_back( static_cast<double>( projectileAngles[i - 1] + projectileAngles[i] ) / 2.0 );
+        }
+
         // Positional offsets for sprites & drawing
         troopCountOffsetLeft = getValue<int32_t>( data, 235 );
         troopCountOffsetRight = getValue<int32_t>( data, 239 );
@@ -508,21 +518,16 @@ namespace Bin_Info
 
     size_t MonsterAnimInfo::getProjectileID( const double angle ) const
     {
-        const std::vector<float> & angles = projectileAngles;
-        if ( angles.empty() ) {
-            return 0;
-        }
-
-        for ( size_t id = 0u; id < angles.size() - 1; ++id ) {
-            if ( angle >= static_cast<double>( angles[id] + angles[id + 1] ) / 2.0 ) {
+        for ( size_t id = 0; id < projectileAngleBoundaries.size(); ++id ) {
+            if ( angle >= projectileAngleBoundaries[id] ) {
                 return id;
             }
         }
 
-        return angles.size() - 1;
+        return projectileAngleBoundaries.size();
     }
 
-    MonsterAnimInfo GetMonsterInfo( const uint32_t monsterID )
+    const MonsterAnimInfo & GetMonsterInfo( const uint32_t monsterID )
     {
         return _infoCache.getAnimInfo( monsterID );
     }
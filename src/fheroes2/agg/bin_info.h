@@ -78,6 +78,8 @@ namespace Bin_Info
         int32_t troopCountOffsetRight{ 0 };
         std::vector<fheroes2::Point> projectileOffset;
         std::vector<float> projectileAngles;
+        // Boundaries between neighbouring projectile angles used to pick a projectile sprite.
+        std::vector<double> projectileAngleBoundaries;
         std::vector<float> idlePriority;
         std::vector<uint32_t> unusedIdleDelays;
         uint32_t idleAnimationCount{ 0 };
@@ -95,5 +97,6 @@ namespace Bin_Info
         size_t getProjectileID( const double angle ) const;
     };
 
-    MonsterAnimInfo GetMonsterInfo( const uint32_t monsterID );
+    // The returned object is shared between all users and is kept in memory until the application exits.
+    const MonsterAnimInfo & GetMonsterInfo( const uint32_t monsterID );
 }
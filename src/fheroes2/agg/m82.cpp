@@ -202,6 +202,58 @@ int M82::FromSpell( const int spellID )
     return UNKNOWN;
 }
 
+bool M82::isSpellSound( const int m82 )
+{
+    // All sounds returned by FromSpell().
+    switch ( m82 ) {
+    case FIREBALL:
+    case LIGHTBLT:
+    case CHAINLTE:
+    case TELEIN:
+    case CURE:
+    case MASSCURE:
+    case RESURECT:
+    case RESURTRU:
+    case HASTE:
+    case MASSHAST:
+    case SLOW:
+    case MASSSLOW:
+    case BLIND:
+    case BLESS:
+    case MASSBLES:
+    case STONSKIN:
+    case STELSKIN:
+    case CURSE:
+    case MASSCURS:
+    case ANTIMAGK:
+    case DIPMAGK:
+    case MAGCAROW:
+    case BERZERK:
+    case ARMGEDN:
+    case STORM:
+    case METEOR:
+    case PARALIZE:
+    case HYPNOTIZ:
+    case COLDRAY:
+    case COLDRING:
+    case DISRUPTR:
+    case MNRDEATH:
+    case DRGNSLAY:
+    case BLOODLUS:
+    case MIRRORIM:
+    case SHIELD:
+    case MASSSHIE:
+    case SUMNELM:
+    case ERTHQUAK:
+    case H2MINE:
+        return true;
+    default:
+        break;
+    }
+
+    return false;
+}
+
 M82::SoundType M82::getAdventureMapTileSound( const Maps::Tile & tile )
 {
     if ( tile.isStream() ) {
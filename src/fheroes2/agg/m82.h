@@ -355,6 +355,9 @@ namespace M82
     const char * GetString( int m82 );
     int FromSpell( const int spellID );
 
+    // Returns true if the sound is played when a spell is cast.
+    bool isSpellSound( const int m82 );
+
     // Returns the ambient soundtrack for a given tile or M82::UNKNOWN if there is no track
     SoundType getAdventureMapTileSound( const Maps::Tile & tile );
 }
@@ -39,6 +39,8 @@
 #include <utility>
 #include <vector>
 
+#include "ai_battle_estimates.h"
+#include "ai_battle_snapshot.h"
 #include "artifact.h"
 #include "artifact_info.h"
 #include "battle.h"
@@ -95,20 +97,25 @@ namespace
                     && ValueHasImproved( newOutcome.positionValue, previous.positionValue, newOutcome.attackValue, previous.attackValue ) );
     }
 
-    double doubleCellAttackValue( const Battle::Unit & attacker, const Battle::Unit & target, const int32_t from, const int32_t targetCell )
+    double doubleCellAttackValue( const AI::UnitDamageEstimates & attackerEstimates, const Battle::Unit & target, const int32_t from, const int32_t targetCell )
     {
+        const Battle::Unit & attacker = attackerEstimates.getUnit();
+
         const Battle::Cell * behind = Battle::Board::GetCell( targetCell, Battle::Board::GetDirection( from, targetCell ) );
         const Battle::Unit * secondaryTarget = ( behind != nullptr ) ? behind->GetUnit() : nullptr;
 
         if ( secondaryTarget && secondaryTarget->GetUID() != target.GetUID() && secondaryTarget->GetUID() != attacker.GetUID() ) {
-            return secondaryTarget->evaluateThreatForUnit( attacker );
+            return attackerEstimates.getThreatOfUnit( *secondaryTarget );
         }
 
         return 0.0;
     }
 
-    std::pair<int32_t, Battle::CellDirection> optimalAttackVector( const Battle::Unit & attacker, const Battle::Unit & target, const Battle::Position & attackPos )
+    std::pair<int32_t, Battle::CellDirection> optimalAttackVector( const AI::UnitDamageEstimates & attackerEstimates, const Battle::Unit & target,
+                                                                   const Battle::Position & attackPos )
     {
+        const Battle::Unit & attacker = attackerEstimates.getUnit();
+
         assert( attackPos.isValidForUnit( attacker ) );
         assert( Battle::Board::CanAttackTargetFromPosition( attacker, target, attackPos.GetHead()->GetIndex() ) );
 
@@ -146,7 +153,7 @@ namespace
                     return { targetCellIdx, Battle::Board::GetDirection( attackCellIdx, targetCellIdx ) };
                 }
 
-                const double attackValue = doubleCellAttackValue( attacker, target, attackCellIdx, targetCellIdx );
+                const double attackValue = doubleCellAttackValue( attackerEstimates, target, attackCellIdx, targetCellIdx );
                 if ( bestAttackVector.first == -1 || bestAttackValue < attackValue ) {
                     bestAttackVector = { targetCellIdx, Battle::Board::GetDirection( attackCellIdx, targetCellIdx ) };
                     bestAttackValue = attackValue;
@@ -157,8 +164,10 @@ namespace
         return bestAttackVector;
     }
 
-    double optimalAttackValue( const Battle::Unit & attacker, const Battle::Unit & target, const Battle::Position & attackPos )
+    double optimalAttackValue( const AI::UnitDamageEstimates & attackerEstimates, const Battle::Unit & target, const Battle::Position & attackPos )
     {
+        const Battle::Unit & attacker = attackerEstimates.getUnit();
+
         assert( attackPos.isValidForUnit( attacker ) );
 
         if ( attacker.isAllAdjacentCellsAttack() ) {
@@ -178,20 +187,22 @@ namespace
             }
 
             return std::accumulate( unitsUnderAttack.begin(), unitsUnderAttack.end(), static_cast<double>( 0.0 ),
-                                    [&attacker]( const double total, const Battle::Unit * unit ) { return total + unit->evaluateThreatForUnit( attacker ); } );
+                                    [&attackerEstimates]( const double total, const Battle::Unit * unit ) {
+                                        return total + attackerEstimates.getThreatOfUnit( *unit );
+                                    } );
         }
 
-        double attackValue = target.evaluateThreatForUnit( attacker );
+        double attackValue = attackerEstimates.getThreatOfUnit( target );
 
         // A double cell attack should only be considered if the attacker is actually able to attack the target from the given attack position. Otherwise, the attacker
         // can at least block the target if the target is a shooter, so this position can be valuable in any case.
         if ( attacker.isDoubleCellAttack() && Battle::Board::CanAttackTargetFromPosition( attacker, target, attackPos.GetHead()->GetIndex() ) ) {
-            const auto [attackTargetIdx, attackDirection] = optimalAttackVector( attacker, target, attackPos );
+            const auto [attackTargetIdx, attackDirection] = optimalAttackVector( attackerEstimates, target, attackPos );
             assert( Battle::Board::isValidDirection( attackTargetIdx, Battle::Board::GetReflectDirection( attackDirection ) ) );
 
-            attackValue
-                += doubleCellAttackValue( attacker, target, Battle::Board::GetIndexDirection( attackTargetIdx, Battle::Board::GetReflectDirection( attackDirection ) ),
-                                          attackTargetIdx );
+            attackValue += doubleCellAttackValue( attackerEstimates, target,
+                                                  Battle::Board::GetIndexDirection( attackTargetIdx, Battle::Board::GetReflectDirection( attackDirection ) ),
+                                                  attackTargetIdx );
         }
 
         return attackValue;
@@ -199,8 +210,10 @@ namespace
 
     using PositionValues = std::map<Battle::Position, double>;
 
-    PositionValues evaluatePotentialAttackPositions( Battle::Arena & arena, const Battle::Unit & attacker )
+    PositionValues evaluatePotentialAttackPositions( Battle::Arena & arena, const AI::UnitDamageEstimates & attackerEstimates )
     {
+        const Battle::Unit & attacker = attackerEstimates.getUnit();
+
         // Attacking unit can be under the influence of the Hypnotize spell
         Battle::Units enemies( arena.getEnemyForce( attacker.GetCurrentColor() ).getUnits(), Battle::Units::REMOVE_INVALID_UNITS_AND_SPECIFIED_UNIT, &attacker );
 
@@ -246,7 +259,7 @@ namespace
                     continue;
                 }
 
-                const double attackValue = optimalAttackValue( attacker, *enemyUnit, pos );
+                const double attackValue = optimalAttackValue( attackerEstimates, *enemyUnit, pos );
 
                 if ( const auto [iter, inserted] = result.try_emplace( pos, attackValue ); !inserted ) {
                     // If attacker is able to attack all adjacent cells, then the values of all units in adjacent cells (including archers) have already been taken into
@@ -294,9 +307,11 @@ namespace
         return false;
     }
 
-    MeleeAttackOutcome BestAttackOutcome( const Battle::Unit & attacker, const Battle::Unit & defender, const PositionValues & valuesOfAttackPositions,
-                                          const std::function<bool( const Battle::Position & )> & posFilter = {} )
+    MeleeAttackOutcome BestAttackOutcome( const AI::UnitDamageEstimates & attackerEstimates, const Battle::Unit & defender,
+                                          const PositionValues & valuesOfAttackPositions, const std::function<bool( const Battle::Position & )> & posFilter = {} )
     {
+        const Battle::Unit & attacker = attackerEstimates.getUnit();
+
         MeleeAttackOutcome bestOutcome;
 
         std::vector<Battle::Position> aroundDefender;
@@ -332,7 +347,7 @@ namespace
             assert( posValueIter != valuesOfAttackPositions.end() );
 
             MeleeAttackOutcome current;
-            current.attackValue = optimalAttackValue( attacker, defender, pos );
+            current.attackValue = optimalAttackValue( attackerEstimates, defender, pos );
             current.positionValue = posValueIter->second;
             current.canAttackImmediately = Battle::Board::CanAttackTargetFromPosition( attacker, defender, posHeadIdx );
 
@@ -348,8 +363,11 @@ namespace
         return bestOutcome;
     }
 
-    int32_t findOptimalPositionForSubsequentAttack( Battle::Arena & arena, const Battle::Indexes & path, const Battle::Unit & currentUnit, const Battle::Units & enemies )
+    int32_t findOptimalPositionForSubsequentAttack( Battle::Arena & arena, const Battle::Indexes & path, const AI::UnitDamageEstimates & currentUnitEstimates,
+                                                    const Battle::Units & enemies )
     {
+        const Battle::Unit & currentUnit = currentUnitEstimates.getUnit();
+
         const Battle::Position & currentUnitPos = currentUnit.GetPosition();
 
         std::vector<std::pair<Battle::Position, double>> pathStepsThreatLevels;
@@ -397,7 +415,7 @@ namespace
                 }
 
                 // Rough estimate: the threat assessment is performed for the current position of the unit, not its new position at this step
-                stepThreatLevel += enemy->evaluateThreatForUnit( currentUnit );
+                stepThreatLevel += currentUnitEstimates.getThreatOfUnit( *enemy );
             }
         }
 
@@ -600,6 +618,87 @@ namespace
 
         return actions;
     }
+
+    // Lookahead is not critical for the choice of the target, so it is abandoned if it needs to apply more commands to snapshots than this.
+    // The limit doesn't depend on the speed of the machine, so the choice of the target is always the same for the same battle.
+    const uint32_t meleeLookaheadCommandLimit{ 2000 };
+
+    // Returns the index of the cell from which the given unit is able to attack the given position on the current turn, or -1 if there
+    // is no such cell. The reach is checked by the battle pathfinder, so obstacles and castle walls are taken into account.
+    int32_t getReachableAttackCellIndex( const Battle::Unit & unit, const Battle::Position & targetPos )
+    {
+        for ( const int32_t nearbyIdx : Battle::Board::GetAroundIndexes( targetPos ) ) {
+            const Battle::Position nearbyPos = Battle::Position::GetReachable( unit, nearbyIdx );
+            if ( nearbyPos.GetHead() != nullptr ) {
+                return nearbyIdx;
+            }
+        }
+
+        return -1;
+    }
+
+    // Returns the strength balance for the side of the attacker after it attacks the defender from the given cell (ply one) and then one of
+    // the enemy units that has not moved yet makes the attack that is the most favorable for the enemy side (ply two). The reach of enemy units
+    // is checked on the current board, where the attacker has not moved yet. Every command applied to a snapshot is deducted from the given
+    // budget, an empty result is returned if the budget is exhausted.
+    std::optional<double> evaluateMeleeAttackWithLookahead( const AI::BattleSnapshot & snapshot, const Battle::Unit & attacker, const Battle::Unit & defender,
+                                                            const int32_t fromIndex, uint32_t & commandBudget )
+    {
+        const PlayerColor attackerColor = attacker.GetCurrentColor();
+
+        if ( commandBudget == 0 ) {
+            return {};
+        }
+
+        --commandBudget;
+
+        AI::BattleSnapshot afterAttack( snapshot );
+        if ( !afterAttack.applyCommand(
+                 Battle::Command( Battle::Command::ATTACK, attacker.GetUID(), defender.GetUID(), ( attacker.GetHeadIndex() == fromIndex ? -1 : fromIndex ), -1, -1 ) ) ) {
+            return snapshot.getStrengthBalance( attackerColor );
+        }
+
+        double worstBalance = afterAttack.getStrengthBalance( attackerColor );
+
+        for ( const AI::BattleSnapshot::UnitState & enemyState : afterAttack.getUnitStates() ) {
+            if ( !enemyState.isValid() || enemyState.isMoved || enemyState.color == attackerColor || enemyState.unit->isImmovable() ) {
+                continue;
+            }
+
+            const bool canShoot = enemyState.unit->isArchers() && enemyState.shots > 0 && !enemyState.unit->isHandFighting();
+
+            for ( const AI::BattleSnapshot::UnitState & targetState : afterAttack.getUnitStates() ) {
+                if ( !targetState.isValid() || targetState.color != attackerColor ) {
+                    continue;
+                }
+
+                int32_t enemyMoveTargetIdx = -1;
+
+                if ( !canShoot ) {
+                    enemyMoveTargetIdx = getReachableAttackCellIndex( *enemyState.unit, Battle::Position::GetPosition( *targetState.unit, targetState.headIndex ) );
+                    if ( enemyMoveTargetIdx < 0 ) {
+                        continue;
+                    }
+                }
+
+                if ( commandBudget == 0 ) {
+                    return {};
+                }
+
+                --commandBudget;
+
+                AI::BattleSnapshot afterResponse( afterAttack );
+                if ( !afterResponse.applyCommand( Battle::Command( Battle::Command::ATTACK, enemyState.unit->GetUID(), targetState.unit->GetUID(), enemyMoveTargetIdx, -1,
+                                                                   -1 ) ) ) {
+                    continue;
+                }
+
+                worstBalance = std::min( worstBalance, afterResponse.getStrengthBalance( attackerColor ) );
+            }
+        }
+
+        return worstBalance;
+    }
 }
 
 AI::BattlePlanner & AI::BattlePlanner::Get()
@@ -614,6 +713,11 @@ void AI::BattlePlanner::battleBegins()
     _numberOfRemainingTurnsWithoutDeaths = MAX_TURNS_WITHOUT_DEATHS;
     _attackerForceTotalNumberOfDeadUnits = 0;
     _defenderForceTotalNumberOfDeadUnits = 0;
+
+    _spellEffectCache.clear();
+    _spellEffectCacheStateHash = 0;
+    _spellEffectCacheTurnNumber = 0;
+    _spellEffectCacheUnitUID = 0;
 }
 
 void AI::BattlePlanner::BattleTurn( Battle::Arena & arena, const Battle::Unit & currentUnit, Battle::Actions & actions )
@@ -891,8 +995,11 @@ Battle::Actions AI::BattlePlanner::planUnitTurn( Battle::Arena & arena, const Ba
     // Step 4. Current unit decision tree
     const size_t actionsSize = actions.size();
 
+    // Units don't change their state or position until the decision is made, so the estimates can be calculated once for all the candidate targets
+    const UnitDamageEstimates currentUnitEstimates( arena, currentUnit );
+
     if ( currentUnit.isArchers() ) {
-        const Battle::Actions archerActions = archerDecision( arena, currentUnit );
+        const Battle::Actions archerActions = archerDecision( arena, currentUnit, currentUnitEstimates );
         actions.insert( actions.end(), archerActions.begin(), archerActions.end() );
     }
     else {
@@ -901,10 +1008,10 @@ Battle::Actions AI::BattlePlanner::planUnitTurn( Battle::Arena & arena, const Ba
 
         // Determine unit target or cell to move to
         if ( _defensiveTactics ) {
-            target = meleeUnitDefense( arena, currentUnit );
+            target = meleeUnitDefense( arena, currentUnit, currentUnitEstimates );
         }
         else {
-            target = meleeUnitOffense( arena, currentUnit );
+            target = meleeUnitOffense( arena, currentUnit, currentUnitEstimates );
         }
 
         // Melee unit final stage - add actions to the queue
@@ -916,7 +1023,7 @@ Battle::Actions AI::BattlePlanner::planUnitTurn( Battle::Arena & arena, const Ba
                 const Battle::Position attackPos = Battle::Position::GetReachable( currentUnit, moveTargetIdx );
                 assert( attackPos.isValidForUnit( currentUnit ) );
 
-                const auto [attackTargetIdx, attackDirection] = optimalAttackVector( currentUnit, *target.unit, attackPos );
+                const auto [attackTargetIdx, attackDirection] = optimalAttackVector( currentUnitEstimates, *target.unit, attackPos );
 
                 actions.emplace_back( Battle::Command::ATTACK, currentUnit.GetUID(), target.unit->GetUID(),
                                       ( currentUnit.GetHeadIndex() == moveTargetIdx ? -1 : moveTargetIdx ), attackTargetIdx, static_cast<int>( attackDirection ) );
@@ -924,7 +1031,7 @@ Battle::Actions AI::BattlePlanner::planUnitTurn( Battle::Arena & arena, const Ba
                 DEBUG_LOG( DBG_BATTLE, DBG_INFO,
                            currentUnit.GetName() << " attacking enemy " << target.unit->GetName() << " from cell " << moveTargetIdx << ", attack vector: "
                                                  << Battle::Board::GetIndexDirection( attackTargetIdx, Battle::Board::GetReflectDirection( attackDirection ) ) << " -> "
-                                                 << attackTargetIdx << ", threat level: " << target.unit->evaluateThreatForUnit( currentUnit ) )
+                                                 << attackTargetIdx << ", threat level: " << currentUnitEstimates.getThreatOfUnit( *target.unit ) )
             }
             else if ( currentUnit.GetHeadIndex() != moveTargetIdx ) {
                 actions.emplace_back( Battle::Command::MOVE, currentUnit.GetUID(), moveTargetIdx );
@@ -1169,7 +1276,7 @@ void AI::BattlePlanner::analyzeBattleState( const Battle::Arena & arena, const B
                    << ", enemy army strength: " << _enemyArmyStrength << ", enemy shooters strength: " << _enemyShootersStrength )
 }
 
-Battle::Actions AI::BattlePlanner::archerDecision( Battle::Arena & arena, const Battle::Unit & currentUnit ) const
+Battle::Actions AI::BattlePlanner::archerDecision( Battle::Arena & arena, const Battle::Unit & currentUnit, const UnitDamageEstimates & currentUnitEstimates ) const
 {
     Battle::Actions actions;
 
@@ -1410,7 +1517,7 @@ Battle::Actions AI::BattlePlanner::archerDecision( Battle::Arena & arena, const
                 continue;
             }
 
-            const uint32_t archerMeleeDmg = currentUnit.getPotentialDamage( *enemy );
+            const uint32_t archerMeleeDmg = currentUnitEstimates.getPotentialDamageToUnit( *enemy );
             const uint32_t retaliatoryDmg = enemy->EstimateRetaliatoryDamage( archerMeleeDmg );
             const int32_t damageDiff = static_cast<int32_t>( archerMeleeDmg ) - static_cast<int32_t>( retaliatoryDmg );
             if ( bestOutcome < damageDiff ) {
@@ -1450,7 +1557,7 @@ Battle::Actions AI::BattlePlanner::archerDecision( Battle::Arena & arena, const
             };
 
             if ( isAreaShotAbilityPresent ) {
-                const auto calculateAreaShotAttackPriority = [&arena, &currentUnit, enemy]( const int32_t targetIdx, bool & isDangerousMove ) {
+                const auto calculateAreaShotAttackPriority = [&arena, &currentUnit, &currentUnitEstimates, enemy]( const int32_t targetIdx, bool & isDangerousMove ) {
                     double result = 0.0;
 
                     // Indexes of the head cells of the units are used instead of pointers because the exact result of adding several
@@ -1477,7 +1584,7 @@ Battle::Actions AI::BattlePlanner::archerDecision( Battle::Arena & arena, const
                         assert( unit != nullptr );
 
                         if ( isExtraLogicAllowed ) {
-                            const uint32_t damageHitPoints = std::min( unit->GetHitPoints(), currentUnit.getPotentialDamage( *unit ) );
+                            const uint32_t damageHitPoints = std::min( unit->GetHitPoints(), currentUnitEstimates.getPotentialDamageToUnit( *unit ) );
                             if ( currentUnit.GetColor() == unit->GetCurrentColor() ) {
                                 friendDamageHitPoints += damageHitPoints;
                             }
@@ -1486,7 +1593,7 @@ Battle::Actions AI::BattlePlanner::archerDecision( Battle::Arena & arena, const
                             }
                         }
 
-                        result += unit->evaluateThreatForUnit( currentUnit );
+                        result += currentUnitEstimates.getThreatOfUnit( *unit );
                     }
 
                     if ( isExtraLogicAllowed ) {
@@ -1523,7 +1630,7 @@ Battle::Actions AI::BattlePlanner::archerDecision( Battle::Arena & arena, const
                 continue;
             }
 
-            updateBestTarget( enemy->evaluateThreatForUnit( currentUnit ), -1 );
+            updateBestTarget( currentUnitEstimates.getThreatOfUnit( *enemy ), -1 );
         }
 
         if ( target.unit ) {
@@ -1536,36 +1643,77 @@ Battle::Actions AI::BattlePlanner::archerDecision( Battle::Arena & arena, const
     return actions;
 }
 
-double AI::BattlePlanner::getMeleeBestOutcome( Battle::Arena & arena, const Battle::Unit & currentUnit, const Battle::Units & enemies, BattleTargetPair & bestTarget )
+double AI::BattlePlanner::getMeleeBestOutcome( Battle::Arena & arena, const Battle::Unit & currentUnit, const UnitDamageEstimates & currentUnitEstimates,
+                                               const Battle::Units & enemies, BattleTargetPair & bestTarget )
 {
-    const PositionValues valuesOfAttackPositions = evaluatePotentialAttackPositions( arena, currentUnit );
+    const PositionValues valuesOfAttackPositions = evaluatePotentialAttackPositions( arena, currentUnitEstimates );
 
-    MeleeAttackOutcome bestOutcome;
+    std::vector<std::pair<const Battle::Unit *, MeleeAttackOutcome>> candidates;
 
     for ( const Battle::Unit * enemy : enemies ) {
         assert( enemy != nullptr );
 
-        const MeleeAttackOutcome outcome = BestAttackOutcome( currentUnit, *enemy, valuesOfAttackPositions );
+        const MeleeAttackOutcome outcome = BestAttackOutcome( currentUnitEstimates, *enemy, valuesOfAttackPositions );
 
         if ( !outcome.canAttackImmediately ) {
             continue;
         }
 
-        if ( IsOutcomeImproved( outcome, bestOutcome ) ) {
+        candidates.emplace_back( enemy, outcome );
+    }
+
+    // If there are several targets within reach, compare the results of attacking them by looking two plies ahead. These results are used instead of
+    // the attack values, but only if all the targets have been evaluated in time.
+    std::vector<double> lookaheadValues;
+
+    if ( candidates.size() > 1 ) {
+        const BattleSnapshot snapshot( arena );
+        uint32_t commandBudget = meleeLookaheadCommandLimit;
+
+        lookaheadValues.reserve( candidates.size() );
+
+        for ( const auto & [enemy, outcome] : candidates ) {
+            const std::optional<double> value = evaluateMeleeAttackWithLookahead( snapshot, currentUnit, *enemy, outcome.fromIndex, commandBudget );
+            if ( !value ) {
+                DEBUG_LOG( DBG_BATTLE, DBG_TRACE, "- Lookahead command limit exceeded, " << lookaheadValues.size() << " of " << candidates.size() << " targets evaluated" )
+
+                lookaheadValues.clear();
+                break;
+            }
+
+            lookaheadValues.push_back( *value );
+        }
+    }
+
+    MeleeAttackOutcome bestOutcome;
+    MeleeAttackOutcome bestComparableOutcome;
+
+    for ( size_t i = 0; i < candidates.size(); ++i ) {
+        const auto & [enemy, outcome] = candidates[i];
+
+        MeleeAttackOutcome comparableOutcome = outcome;
+        if ( !lookaheadValues.empty() ) {
+            comparableOutcome.attackValue = lookaheadValues[i];
+        }
+
+        if ( IsOutcomeImproved( comparableOutcome, bestComparableOutcome ) ) {
             bestOutcome = outcome;
+            bestComparableOutcome = comparableOutcome;
 
             bestTarget.cell = outcome.fromIndex;
             bestTarget.unit = enemy;
 
             DEBUG_LOG( DBG_BATTLE, DBG_TRACE,
-                       "- Set attack priority on " << enemy->GetName() << ", attack value: " << outcome.attackValue << ", position value: " << outcome.positionValue )
+                       "- Set attack priority on " << enemy->GetName() << ", attack value: " << outcome.attackValue << ", position value: " << outcome.positionValue
+                                                   << ", lookahead value: " << comparableOutcome.attackValue )
         }
     }
 
     return bestOutcome.attackValue;
 }
 
-AI::BattleTargetPair AI::BattlePlanner::meleeUnitOffense( Battle::Arena & arena, const Battle::Unit & currentUnit ) const
+AI::BattleTargetPair AI::BattlePlanner::meleeUnitOffense( Battle::Arena & arena, const Battle::Unit & currentUnit,
+                                                         const UnitDamageEstimates & currentUnitEstimates ) const
 {
     // Current unit can be under the influence of the Hypnotize spell
     const Battle::Units enemies( arena.getEnemyForce( _myColor ).getUnits(), Battle::Units::REMOVE_INVALID_UNITS_AND_SPECIFIED_UNIT, &currentUnit );
@@ -1574,7 +1722,7 @@ AI::BattleTargetPair AI::BattlePlanner::meleeUnitOffense( Battle::Arena & arena,
 
     // 1. Choose the best target within reach, if any
     {
-        getMeleeBestOutcome( arena, currentUnit, enemies, target );
+        getMeleeBestOutcome( arena, currentUnit, currentUnitEstimates, enemies, target );
 
         if ( target.unit ) {
             DEBUG_LOG( DBG_BATTLE, DBG_INFO, currentUnit.GetName() << " attacking " << target.unit->GetName() << " from cell " << target.cell )
@@ -1585,7 +1733,7 @@ AI::BattleTargetPair AI::BattlePlanner::meleeUnitOffense( Battle::Arena & arena,
 
     // 2. For units that don't have a target within reach, choose a target depending on distance-based priority
     {
-        const auto chooseDistantTarget = [this, &arena, &currentUnit, &target, &enemies]( const auto enemyPredicate ) {
+        const auto chooseDistantTarget = [this, &arena, &currentUnit, &currentUnitEstimates, &target, &enemies]( const auto enemyPredicate ) {
             double maxPriority = std::numeric_limits<double>::lowest();
 
             for ( const Battle::Unit * enemy : enemies ) {
@@ -1603,7 +1751,7 @@ AI::BattleTargetPair AI::BattlePlanner::meleeUnitOffense( Battle::Arena & arena,
                 // If this distance was zero, it would mean that this enemy unit would have already been attacked by the current unit
                 assert( nearestCellInfo.dist > 0 );
 
-                const double priority = enemy->evaluateThreatForUnit( currentUnit ) / nearestCellInfo.dist;
+                const double priority = currentUnitEstimates.getThreatOfUnit( *enemy ) / nearestCellInfo.dist;
                 if ( priority < maxPriority ) {
                     continue;
                 }
@@ -1626,7 +1774,7 @@ AI::BattleTargetPair AI::BattlePlanner::meleeUnitOffense( Battle::Arena & arena,
                     DEBUG_LOG( DBG_BATTLE, DBG_TRACE, "- Going after target " << enemy->GetName() << ", stopping in the moat at cell " << target.cell )
                 }
                 else if ( _cautiousOffensive ) {
-                    target.cell = findOptimalPositionForSubsequentAttack( arena, path, currentUnit, enemies );
+                    target.cell = findOptimalPositionForSubsequentAttack( arena, path, currentUnitEstimates, enemies );
 
                     DEBUG_LOG( DBG_BATTLE, DBG_TRACE, "- Going after target " << enemy->GetName() << " using a cautious offensive, stopping at cell " << target.cell )
                 }
@@ -1705,11 +1853,12 @@ AI::BattleTargetPair AI::BattlePlanner::meleeUnitOffense( Battle::Arena & arena,
     return target;
 }
 
-AI::BattleTargetPair AI::BattlePlanner::meleeUnitDefense( Battle::Arena & arena, const Battle::Unit & currentUnit ) const
+AI::BattleTargetPair AI::BattlePlanner::meleeUnitDefense( Battle::Arena & arena, const Battle::Unit & currentUnit,
+                                                         const UnitDamageEstimates & currentUnitEstimates ) const
 {
     BattleTargetPair target;
 
-    const PositionValues valuesOfAttackPositions = evaluatePotentialAttackPositions( arena, currentUnit );
+    const PositionValues valuesOfAttackPositions = evaluatePotentialAttackPositions( arena, currentUnitEstimates );
 
     const Battle::Units friendly( arena.getForce( _myColor ).getUnits(), Battle::Units::REMOVE_INVALID_UNITS_AND_SPECIFIED_UNIT, &currentUnit );
     // Current unit can be under the influence of the Hypnotize spell
@@ -1719,10 +1868,10 @@ AI::BattleTargetPair AI::BattlePlanner::meleeUnitDefense( Battle::Arena & arena,
     // such units will block them instead of covering them.
     if ( currentUnit.GetArmyColor() == _myColor ) {
         const bool isAnyEnemyCanBeAttackedImmediately
-            = std::any_of( enemies.begin(), enemies.end(), [&currentUnit, &valuesOfAttackPositions]( const Battle::Unit * enemy ) {
+            = std::any_of( enemies.begin(), enemies.end(), [&currentUnitEstimates, &valuesOfAttackPositions]( const Battle::Unit * enemy ) {
                   assert( enemy != nullptr );
 
-                  const MeleeAttackOutcome outcome = BestAttackOutcome( currentUnit, *enemy, valuesOfAttackPositions );
+                  const MeleeAttackOutcome outcome = BestAttackOutcome( currentUnitEstimates, *enemy, valuesOfAttackPositions );
 
                   return outcome.canAttackImmediately;
               } );
@@ -1960,7 +2109,7 @@ AI::BattleTargetPair AI::BattlePlanner::meleeUnitDefense( Battle::Arena & arena,
                 for ( const Battle::Unit * enemy : adjacentEnemies ) {
                     assert( enemy != nullptr );
 
-                    const MeleeAttackOutcome outcome = BestAttackOutcome( currentUnit, *enemy, valuesOfAttackPositions );
+                    const MeleeAttackOutcome outcome = BestAttackOutcome( currentUnitEstimates, *enemy, valuesOfAttackPositions );
 
                     if ( IsOutcomeImproved( outcome, bestOutcome ) ) {
                         bestOutcome = outcome;
@@ -2006,7 +2155,7 @@ AI::BattleTargetPair AI::BattlePlanner::meleeUnitDefense( Battle::Arena & arena,
                     const Battle::Position pos = Battle::Position::GetReachable( currentUnit, target.cell );
                     assert( pos.isValidForUnit( currentUnit ) );
 
-                    const double attackValue = optimalAttackValue( currentUnit, *enemy, pos );
+                    const double attackValue = optimalAttackValue( currentUnitEstimates, *enemy, pos );
                     if ( bestAttackValue < attackValue ) {
                         bestAttackValue = attackValue;
 
@@ -2037,9 +2186,10 @@ AI::BattleTargetPair AI::BattlePlanner::meleeUnitDefense( Battle::Arena & arena,
         for ( const Battle::Unit * enemy : enemies ) {
             assert( enemy != nullptr );
 
-            const MeleeAttackOutcome outcome = BestAttackOutcome( currentUnit, *enemy, valuesOfAttackPositions, [this, &currentUnit]( const Battle::Position & pos ) {
-                return isPositionLocatedInDefendedArea( currentUnit, pos );
-            } );
+            const MeleeAttackOutcome outcome = BestAttackOutcome( currentUnitEstimates, *enemy, valuesOfAttackPositions,
+                                                                  [this, &currentUnit]( const Battle::Position & pos ) {
+                                                                      return isPositionLocatedInDefendedArea( currentUnit, pos );
+                                                                  } );
 
             if ( !Battle::Board::isValidIndex( outcome.fromIndex ) ) {
                 continue;
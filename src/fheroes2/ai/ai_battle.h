@@ -21,6 +21,7 @@
 #pragma once
 
 #include <cstdint>
+#include <unordered_map>
 
 #include "color.h"
 
@@ -38,6 +39,8 @@ namespace Battle
 
 namespace AI
 {
+    class UnitDamageEstimates;
+
     struct BattleTargetPair
     {
         int cell{ -1 };
@@ -91,10 +94,10 @@ namespace AI
 
         void analyzeBattleState( const Battle::Arena & arena, const Battle::Unit & currentUnit );
 
-        Battle::Actions archerDecision( Battle::Arena & arena, const Battle::Unit & currentUnit ) const;
+        Battle::Actions archerDecision( Battle::Arena & arena, const Battle::Unit & currentUnit, const UnitDamageEstimates & currentUnitEstimates ) const;
 
-        BattleTargetPair meleeUnitOffense( Battle::Arena & arena, const Battle::Unit & currentUnit ) const;
-        BattleTargetPair meleeUnitDefense( Battle::Arena & arena, const Battle::Unit & currentUnit ) const;
+        BattleTargetPair meleeUnitOffense( Battle::Arena & arena, const Battle::Unit & currentUnit, const UnitDamageEstimates & currentUnitEstimates ) const;
+        BattleTargetPair meleeUnitDefense( Battle::Arena & arena, const Battle::Unit & currentUnit, const UnitDamageEstimates & currentUnitEstimates ) const;
 
         bool isPositionLocatedInDefendedArea( const Battle::Unit & currentUnit, const Battle::Position & pos ) const;
 
@@ -111,6 +114,8 @@ namespace AI
         SpellcastOutcome spellEffectValue( const Spell & spell, const Battle::Units & targets, const Battle::Units & enemies ) const;
 
         double spellEffectValue( const Spell & spell, const Battle::Unit & target, const Battle::Units & enemies, const bool targetIsLast, const bool forDispel ) const;
+        double evaluateSpellEffectValue( const Spell & spell, const Battle::Unit & target, const Battle::Units & enemies, const bool targetIsLast,
+                                         const bool forDispel ) const;
         double getSpellDisruptingRayRatio( const Battle::Unit & target ) const;
         double getSpellSlowRatio( const Battle::Unit & target ) const;
         double getSpellHasteRatio( const Battle::Unit & target ) const;
@@ -118,7 +123,11 @@ namespace AI
 
         bool isSpellcastUselessForUnit( const Battle::Unit & unit, const Battle::Units & enemies, const Spell & spell ) const;
 
-        static double getMeleeBestOutcome( Battle::Arena & arena, const Battle::Unit & currentUnit, const Battle::Units & enemies, BattleTargetPair & bestTarget );
+        // Drops the memoized spell effect values if they were evaluated for a different battle state
+        void validateSpellEffectCache( const Battle::Arena & arena, const Battle::Unit & currentUnit ) const;
+
+        static double getMeleeBestOutcome( Battle::Arena & arena, const Battle::Unit & currentUnit, const UnitDamageEstimates & currentUnitEstimates,
+                                           const Battle::Units & enemies, BattleTargetPair & bestTarget );
 
         // When this limit of turns without deaths is exceeded for an attacking AI-controlled hero,
         // the auto combat should be interrupted (one way or another)
@@ -148,5 +157,12 @@ namespace AI
         bool _defensiveTactics{ false };
         bool _cautiousOffensive{ false };
         bool _avoidStackingUnits{ false };
+
+        // Memoized results of spellEffectValue() for the given spell, target unit and evaluation flags. These values depend only on the state
+        // of the units and on the variables above, so they remain valid until the next applied action, the next turn or the next unit to act.
+        mutable std::unordered_map<uint64_t, double> _spellEffectCache;
+        mutable uint64_t _spellEffectCacheStateHash{ 0 };
+        mutable uint32_t _spellEffectCacheTurnNumber{ 0 };
+        mutable uint32_t _spellEffectCacheUnitUID{ 0 };
     };
 }
@@ -0,0 +1,85 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "ai_battle_estimates.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "battle_arena.h"
+#include "battle_army.h"
+#include "battle_troop.h"
+
+AI::UnitDamageEstimates::UnitDamageEstimates( const Battle::Arena & arena, const Battle::Unit & unit )
+    : _unit( unit )
+{
+    const Battle::Force & attackingForce = arena.getAttackingForce();
+    const Battle::Force & defendingForce = arena.getDefendingForce();
+
+    const size_t unitsCount = attackingForce.size() + defendingForce.size();
+
+    _uids.reserve( unitsCount );
+    _threatsOfUnits.reserve( unitsCount );
+    _potentialDamageToUnits.reserve( unitsCount );
+
+    for ( const Battle::Force * force : { &attackingForce, &defendingForce } ) {
+        for ( const Battle::Unit * other : *force ) {
+            assert( other != nullptr );
+
+            if ( other == &unit || !other->isValid() ) {
+                continue;
+            }
+
+            _uids.push_back( other->GetUID() );
+            _threatsOfUnits.push_back( other->evaluateThreatForUnit( unit ) );
+            _potentialDamageToUnits.push_back( unit.getPotentialDamage( *other ) );
+        }
+    }
+}
+
+double AI::UnitDamageEstimates::getThreatOfUnit( const Battle::Unit & other ) const
+{
+    const ptrdiff_t idx = _findUnit( other );
+    if ( idx < 0 ) {
+        return other.evaluateThreatForUnit( _unit );
+    }
+
+    return _threatsOfUnits[idx];
+}
+
+uint32_t AI::UnitDamageEstimates::getPotentialDamageToUnit( const Battle::Unit & other ) const
+{
+    const ptrdiff_t idx = _findUnit( other );
+    if ( idx < 0 ) {
+        return _unit.getPotentialDamage( other );
+    }
+
+    return _potentialDamageToUnits[idx];
+}
+
+ptrdiff_t AI::UnitDamageEstimates::_findUnit( const Battle::Unit & other ) const
+{
+    const auto iter = std::find( _uids.begin(), _uids.end(), other.GetUID() );
+    if ( iter == _uids.end() ) {
+        return -1;
+    }
+
+    return iter - _uids.begin();
+}
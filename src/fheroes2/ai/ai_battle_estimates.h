@@ -0,0 +1,68 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Battle
+{
+    class Arena;
+    class Unit;
+}
+
+namespace AI
+{
+    // Estimates of the outcome of attacks between the given unit and all other units on the battlefield. The estimates for all units are calculated
+    // at once and are stored in flat arrays indexed in the same way, so that target scoring loops just look up the values instead of repeating the
+    // same damage calculations for every attack position. The estimates are valid only as long as the state and the positions of units stay the same.
+    class UnitDamageEstimates
+    {
+    public:
+        UnitDamageEstimates( const Battle::Arena & arena, const Battle::Unit & unit );
+
+        UnitDamageEstimates( const UnitDamageEstimates & ) = delete;
+
+        UnitDamageEstimates & operator=( const UnitDamageEstimates & ) = delete;
+
+        const Battle::Unit & getUnit() const
+        {
+            return _unit;
+        }
+
+        // Returns the same value as other.evaluateThreatForUnit( unit )
+        double getThreatOfUnit( const Battle::Unit & other ) const;
+
+        // Returns the same value as unit.getPotentialDamage( other )
+        uint32_t getPotentialDamageToUnit( const Battle::Unit & other ) const;
+
+    private:
+        // Returns the index of the given unit in the arrays below or -1 if there are no estimates for this unit
+        ptrdiff_t _findUnit( const Battle::Unit & other ) const;
+
+        const Battle::Unit & _unit;
+
+        std::vector<uint32_t> _uids;
+        std::vector<double> _threatsOfUnits;
+        std::vector<uint32_t> _potentialDamageToUnits;
+    };
+}
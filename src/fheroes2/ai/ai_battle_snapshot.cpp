@@ -0,0 +1,282 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "ai_battle_snapshot.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+
+#include "battle.h"
+#include "battle_arena.h"
+#include "battle_army.h"
+#include "battle_command.h"
+#include "battle_tower.h"
+#include "battle_troop.h"
+#include "monster.h"
+#include "monster_info.h"
+
+namespace
+{
+    // Returns the parameter of the command with the given index in the order in which they were passed to the command constructor
+    int getCommandParam( const Battle::Command & command, const size_t paramIdx )
+    {
+        assert( paramIdx < command.size() );
+
+        // Parameters are stored in reverse order
+        return *( command.end() - 1 - paramIdx );
+    }
+}
+
+AI::BattleSnapshot::BattleSnapshot( const Battle::Arena & arena )
+    : _units( std::make_shared<std::vector<UnitState>>() )
+{
+    const Battle::Force & attackingForce = arena.getAttackingForce();
+    const Battle::Force & defendingForce = arena.getDefendingForce();
+
+    _units->reserve( attackingForce.size() + defendingForce.size() );
+
+    for ( const Battle::Force * force : { &attackingForce, &defendingForce } ) {
+        for ( const Battle::Unit * unit : *force ) {
+            assert( unit != nullptr );
+
+            if ( !unit->isValid() ) {
+                continue;
+            }
+
+            UnitState & state = _units->emplace_back();
+
+            state.unit = unit;
+            state.count = unit->GetCount();
+            state.hitPoints = unit->GetHitPoints();
+            state.shots = unit->GetShots();
+            state.headIndex = unit->GetHeadIndex();
+            state.color = unit->GetCurrentColor();
+            state.isRetaliated = !unit->isRetaliationAllowed();
+            state.isMoved = unit->Modes( Battle::TR_MOVED );
+        }
+    }
+
+    for ( const Battle::TowerType type : { Battle::TowerType::TWR_LEFT, Battle::TowerType::TWR_CENTER, Battle::TowerType::TWR_RIGHT } ) {
+        const Battle::Tower * tower = Battle::Arena::GetTower( type );
+
+        _towers[static_cast<size_t>( type )] = ( tower != nullptr && tower->isValid() ) ? tower : nullptr;
+    }
+}
+
+bool AI::BattleSnapshot::applyCommand( const Battle::Command & command )
+{
+    switch ( command.GetType() ) {
+    case Battle::CommandType::MOVE: {
+        assert( command.size() == 2 );
+
+        UnitState * unitState = _getMutableUnitState( getCommandParam( command, 0 ) );
+        if ( unitState == nullptr || !unitState->isValid() || unitState->isMoved ) {
+            return false;
+        }
+
+        unitState->headIndex = getCommandParam( command, 1 );
+        unitState->isMoved = true;
+
+        return true;
+    }
+
+    case Battle::CommandType::ATTACK:
+        assert( command.size() == 5 );
+
+        return _applyAttack( getCommandParam( command, 0 ), getCommandParam( command, 1 ), getCommandParam( command, 2 ) );
+
+    case Battle::CommandType::SKIP: {
+        assert( command.size() == 1 );
+
+        UnitState * unitState = _getMutableUnitState( getCommandParam( command, 0 ) );
+        if ( unitState == nullptr || !unitState->isValid() || unitState->isMoved ) {
+            return false;
+        }
+
+        unitState->isMoved = true;
+
+        return true;
+    }
+
+    case Battle::CommandType::TOWER:
+        assert( command.size() == 2 );
+
+        return _applyTowerShot( getCommandParam( command, 0 ), getCommandParam( command, 1 ) );
+
+    default:
+        break;
+    }
+
+    return false;
+}
+
+const AI::BattleSnapshot::UnitState * AI::BattleSnapshot::getUnitState( const uint32_t uid ) const
+{
+    const auto iter = std::find_if( _units->begin(), _units->end(), [uid]( const UnitState & state ) { return state.unit->GetUID() == uid; } );
+    if ( iter == _units->end() ) {
+        return nullptr;
+    }
+
+    return &( *iter );
+}
+
+double AI::BattleSnapshot::getStrengthBalance( const PlayerColor color ) const
+{
+    double balance = 0.0;
+
+    for ( const UnitState & state : *_units ) {
+        if ( !state.isValid() ) {
+            continue;
+        }
+
+        const double strength = state.unit->GetMonsterStrength() * state.count;
+
+        balance += ( state.color == color ) ? strength : -strength;
+    }
+
+    return balance;
+}
+
+uint32_t AI::BattleSnapshot::estimateDamage( const UnitState & attacker, const UnitState & defender )
+{
+    assert( attacker.unit != nullptr && defender.unit != nullptr );
+
+    const uint32_t unitCount = attacker.unit->GetCount();
+    if ( unitCount == 0 || !attacker.isValid() ) {
+        return 0;
+    }
+
+    const uint32_t damage = attacker.unit->getPotentialDamage( *defender.unit );
+
+    // Damage is proportional to the number of creatures in the attacking unit
+    return static_cast<uint32_t>( static_cast<uint64_t>( damage ) * attacker.count / unitCount );
+}
+
+AI::BattleSnapshot::UnitState * AI::BattleSnapshot::_getMutableUnitState( const uint32_t uid )
+{
+    const auto iter = std::find_if( _units->begin(), _units->end(), [uid]( const UnitState & state ) { return state.unit->GetUID() == uid; } );
+    if ( iter == _units->end() ) {
+        return nullptr;
+    }
+
+    if ( _units.use_count() > 1 ) {
+        const ptrdiff_t unitIdx = iter - _units->begin();
+
+        _units = std::make_shared<std::vector<UnitState>>( *_units );
+
+        return &( *_units )[unitIdx];
+    }
+
+    return &( *iter );
+}
+
+bool AI::BattleSnapshot::_applyAttack( const uint32_t attackerUID, const uint32_t defenderUID, const int32_t moveTargetIdx )
+{
+    {
+        const UnitState * attacker = getUnitState( attackerUID );
+        const UnitState * defender = getUnitState( defenderUID );
+
+        if ( attacker == nullptr || defender == nullptr || !attacker->isValid() || !defender->isValid() || attacker->isMoved ) {
+            return false;
+        }
+
+        if ( attacker->color == defender->color ) {
+            return false;
+        }
+    }
+
+    // Both states should be obtained after the state of units is copied (if necessary), otherwise one of them may point to the shared state
+    UnitState * attacker = _getMutableUnitState( attackerUID );
+    UnitState * defender = _getMutableUnitState( defenderUID );
+    assert( attacker != nullptr && defender != nullptr );
+
+    if ( moveTargetIdx != -1 ) {
+        attacker->headIndex = moveTargetIdx;
+    }
+
+    // Archers shoot if they are not blocked by enemy units and have shots left. The current position of the archer on the battlefield is used
+    // to determine whether it is blocked, because the snapshot doesn't keep track of the board cells.
+    const bool isShot = attacker->unit->isArchers() && attacker->shots > 0 && moveTargetIdx == -1 && !attacker->unit->isHandFighting();
+    const bool isDoubleAttack = attacker->unit->isDoubleAttack();
+
+    _applyDamage( *defender, estimateDamage( *attacker, *defender ) );
+
+    if ( isShot ) {
+        --attacker->shots;
+    }
+
+    if ( defender->isValid() && !isShot && !attacker->unit->isIgnoringRetaliation() && !defender->isRetaliated ) {
+        _applyDamage( *attacker, estimateDamage( *defender, *attacker ) );
+
+        defender->isRetaliated = !defender->unit->isAbilityPresent( fheroes2::MonsterAbilityType::UNLIMITED_RETALIATION );
+    }
+
+    if ( isDoubleAttack && attacker->isValid() && defender->isValid() && ( !isShot || attacker->shots > 0 ) ) {
+        _applyDamage( *defender, estimateDamage( *attacker, *defender ) );
+
+        if ( isShot ) {
+            --attacker->shots;
+        }
+    }
+
+    attacker->isMoved = true;
+
+    return true;
+}
+
+bool AI::BattleSnapshot::_applyTowerShot( const int towerType, const uint32_t targetUID )
+{
+    if ( towerType < 0 || static_cast<size_t>( towerType ) >= _towers.size() ) {
+        return false;
+    }
+
+    const Battle::Tower * tower = _towers[towerType];
+    if ( tower == nullptr ) {
+        return false;
+    }
+
+    UnitState * target = _getMutableUnitState( targetUID );
+    if ( target == nullptr || !target->isValid() ) {
+        return false;
+    }
+
+    _applyDamage( *target, tower->getPotentialDamage( *target->unit ) );
+
+    return true;
+}
+
+void AI::BattleSnapshot::_applyDamage( UnitState & target, const uint32_t damage )
+{
+    if ( damage == 0 || !target.isValid() ) {
+        return;
+    }
+
+    // Mirror images are destroyed by any damage
+    if ( damage >= target.hitPoints || target.unit->Modes( Battle::CAP_MIRRORIMAGE ) ) {
+        target.hitPoints = 0;
+        target.count = 0;
+
+        return;
+    }
+
+    target.hitPoints -= damage;
+    target.count = Monster::GetCountFromHitPoints( *target.unit, target.hitPoints );
+}
@@ -0,0 +1,100 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "color.h"
+
+namespace Battle
+{
+    class Arena;
+    class Command;
+    class Tower;
+    class Unit;
+}
+
+namespace AI
+{
+    // Lightweight copy of the state of the battle that is relevant for the simulation of the exchange of blows between units. Unlike
+    // Battle::Arena, snapshots can be copied (forked) cheaply: the forks share the state of units until one of them is modified.
+    class BattleSnapshot
+    {
+    public:
+        struct UnitState
+        {
+            // Unit whose state is copied, it is used to get the properties that don't change during the simulation (attack, defense,
+            // damage, abilities, etc.) and is never modified
+            const Battle::Unit * unit{ nullptr };
+
+            uint32_t count{ 0 };
+            uint32_t hitPoints{ 0 };
+            uint32_t shots{ 0 };
+            int32_t headIndex{ -1 };
+            PlayerColor color{ PlayerColor::NONE };
+            bool isRetaliated{ false };
+            bool isMoved{ false };
+
+            bool isValid() const
+            {
+                return count > 0;
+            }
+        };
+
+        explicit BattleSnapshot( const Battle::Arena & arena );
+
+        // Applies the command to this snapshot without any user interface and without changing the state of the arena. Only the commands
+        // that directly affect units (movement, attack, skipping the turn and tower shots) are supported, the rest of them are ignored.
+        // Damage is always estimated as average damage instead of being random. Returns true if the command has been applied.
+        bool applyCommand( const Battle::Command & command );
+
+        const std::vector<UnitState> & getUnitStates() const
+        {
+            return *_units;
+        }
+
+        const UnitState * getUnitState( const uint32_t uid ) const;
+
+        // Returns the difference between the total strength of units of the given color and the total strength of their enemies
+        double getStrengthBalance( const PlayerColor color ) const;
+
+        // Returns the average damage the attacker would deal to the defender in their current states
+        static uint32_t estimateDamage( const UnitState & attacker, const UnitState & defender );
+
+    private:
+        // Returns the state of the unit with the given UID that can be modified, the state of units is copied first if it is shared
+        // with other snapshots. Returns nullptr if there is no such unit.
+        UnitState * _getMutableUnitState( const uint32_t uid );
+
+        bool _applyAttack( const uint32_t attackerUID, const uint32_t defenderUID, const int32_t moveTargetIdx );
+        bool _applyTowerShot( const int towerType, const uint32_t targetUID );
+
+        static void _applyDamage( UnitState & target, const uint32_t damage );
+
+        std::shared_ptr<std::vector<UnitState>> _units;
+
+        // The state of towers doesn't change during the simulation, so there is no need to copy them
+        std::array<const Battle::Tower *, 3> _towers{};
+    };
+}
@@ -19,6 +19,7 @@
  ***************************************************************************/
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
 #include <cstddef>
@@ -27,6 +28,7 @@
 #include <vector>
 
 #include "ai_battle.h" // IWYU pragma: associated
+#include "ai_battle_estimates.h"
 #include "army_troop.h"
 #include "artifact.h"
 #include "artifact_info.h"
@@ -60,6 +62,11 @@ namespace
         return result;
     }
 
+    uint64_t getSpellEffectCacheKey( const Spell & spell, const Battle::Unit & target, const bool targetIsLast, const bool forDispel )
+    {
+        return ( static_cast<uint64_t>( target.GetUID() ) << 32 ) | ( static_cast<uint64_t>( spell.GetID() ) << 2 ) | ( targetIsLast ? 2 : 0 ) | ( forDispel ? 1 : 0 );
+    }
+
     int32_t getSpellPower( const HeroBase * hero )
     {
         assert( hero != nullptr );
@@ -78,6 +85,8 @@ AI::SpellSelection AI::BattlePlanner::selectBestSpell( Battle::Arena & arena, co
         return bestSpell;
     }
 
+    validateSpellEffectCache( arena, currentUnit );
+
     const SpellStorage allSpells = _commander->getAllSpells();
 
     const Battle::Units friendly( arena.getForce( _myColor ).getUnits(), Battle::Units::REMOVE_INVALID_UNITS );
@@ -252,7 +261,7 @@ AI::SpellcastOutcome AI::BattlePlanner::spellDamageValue( const Spell & spell, B
 
         if ( spell.GetID() == Spell::CHAINLIGHTNING ) {
             for ( const Battle::Unit * enemy : enemies ) {
-                if ( !enemy->AllowApplySpell( spell, _commander ) ) {
+                if ( !arena.isSpellApplicable( *enemy, spell, _commander ) ) {
                     continue;
                 }
 
@@ -261,10 +270,83 @@ AI::SpellcastOutcome AI::BattlePlanner::spellDamageValue( const Spell & spell, B
             }
         }
         else {
+            // The remaining damage spells affect all the cells within a fixed radius around the target cell, see Arena::GetTargetsForSpell().
+            // The value of each unit does not depend on the target cell, so it is calculated only once, and the affected units for every
+            // target cell are resolved using the precomputed area masks.
+            assert( spell.GetID() == Spell::FIREBALL || spell.GetID() == Spell::FIREBLAST || spell.GetID() == Spell::COLDRING
+                    || spell.GetID() == Spell::METEORSHOWER );
+
+            const uint32_t areaRadius = ( spell.GetID() == Spell::FIREBLAST ) ? 2 : 1;
+            const bool isCenterAffected = ( spell.GetID() != Spell::COLDRING );
+
+            Battle::CellMask occupiedCells;
+            std::array<const Battle::Unit *, Battle::Board::sizeInCells> cellUnits{};
+            // Unit values and whether it is unacceptable to lose the unit, indexed by the head cell index of the unit
+            std::array<double, Battle::Board::sizeInCells> unitValues{};
+            std::array<bool, Battle::Board::sizeInCells> isUnacceptableLoss{};
+
             const Battle::Board & board = *Battle::Arena::GetBoard();
             for ( const Battle::Cell & cell : board ) {
+                const Battle::Unit * unit = cell.GetUnit();
+                if ( unit == nullptr || !unit->AllowApplySpell( spell, _commander ) ) {
+                    continue;
+                }
+
                 const int32_t index = cell.GetIndex();
-                areaOfEffectCheck( arena.GetTargetsForSpell( _commander, spell, index ), index, _myColor );
+
+                occupiedCells.set( index );
+                cellUnits[index] = unit;
+
+                if ( index != unit->GetHeadIndex() ) {
+                    continue;
+                }
+
+                if ( unit->GetCurrentColor() == _myColor ) {
+                    const double valueLost = damageHeuristic( unit, _myArmyStrength, _myArmyAverageSpeed );
+
+                    // Check if we're retreating and will lose current unit
+                    isUnacceptableLoss[index] = retreating && unit->isUID( currentUnit.GetUID() ) && std::fabs( valueLost - unit->GetStrength() ) < 0.001;
+                    unitValues[index] = -valueLost;
+                }
+                else {
+                    unitValues[index] = damageHeuristic( unit, _enemyArmyStrength, _enemyAverageSpeed );
+                }
+            }
+
+            for ( const Battle::Cell & cell : board ) {
+                const int32_t index = cell.GetIndex();
+
+                Battle::CellMask area = Battle::Board::GetDistanceMask( index, areaRadius );
+                if ( !isCenterAffected ) {
+                    area.reset( index );
+                }
+
+                const Battle::CellMask affectedCells = area & occupiedCells;
+
+                double spellHeuristic = 0;
+                bool isAcceptable = true;
+
+                affectedCells.forEach( [&affectedCells, &cellUnits, &unitValues, &isUnacceptableLoss, &spellHeuristic, &isAcceptable]( const int32_t cellIdx ) {
+                    const int32_t headIdx = cellUnits[cellIdx]->GetHeadIndex();
+
+                    // Wide units should be taken into account only once
+                    if ( cellIdx != headIdx && affectedCells.test( headIdx ) ) {
+                        return;
+                    }
+
+                    if ( isUnacceptableLoss[headIdx] ) {
+                        isAcceptable = false;
+                    }
+
+                    spellHeuristic += unitValues[headIdx];
+                } );
+
+                // Avoid this spell without updating the outcome
+                if ( !isAcceptable ) {
+                    continue;
+                }
+
+                bestOutcome.updateOutcome( spellHeuristic, index );
             }
         }
     }
@@ -365,11 +447,44 @@ double AI::BattlePlanner::getSpellHasteRatio( const Battle::Unit & target ) cons
     return ratio;
 }
 
+void AI::BattlePlanner::validateSpellEffectCache( const Battle::Arena & arena, const Battle::Unit & currentUnit ) const
+{
+    // Spell durations are decreased at the beginning of each turn without applying any action, so the turn number should be checked as well
+    if ( _spellEffectCacheStateHash == arena.getStateHash() && _spellEffectCacheTurnNumber == arena.GetTurnNumber()
+         && _spellEffectCacheUnitUID == currentUnit.GetUID() ) {
+        return;
+    }
+
+    _spellEffectCache.clear();
+    _spellEffectCacheStateHash = arena.getStateHash();
+    _spellEffectCacheTurnNumber = arena.GetTurnNumber();
+    _spellEffectCacheUnitUID = currentUnit.GetUID();
+}
+
 double AI::BattlePlanner::spellEffectValue( const Spell & spell, const Battle::Unit & target, const Battle::Units & enemies, const bool targetIsLast,
                                             const bool forDispel ) const
+{
+    const uint64_t cacheKey = getSpellEffectCacheKey( spell, target, targetIsLast, forDispel );
+
+    const auto cacheIter = _spellEffectCache.find( cacheKey );
+    if ( cacheIter != _spellEffectCache.end() ) {
+        return cacheIter->second;
+    }
+
+    const double value = evaluateSpellEffectValue( spell, target, enemies, targetIsLast, forDispel );
+    _spellEffectCache.emplace( cacheKey, value );
+
+    return value;
+}
+
+double AI::BattlePlanner::evaluateSpellEffectValue( const Spell & spell, const Battle::Unit & target, const Battle::Units & enemies, const bool targetIsLast,
+                                                    const bool forDispel ) const
 {
     // Make sure that this spell makes sense to apply (skip this check to evaluate the effect of dispelling)
-    if ( !forDispel && ( isSpellcastUselessForUnit( target, enemies, spell ) || !target.AllowApplySpell( spell, _commander ) ) ) {
+    const Battle::Arena * arena = Battle::GetArena();
+    assert( arena != nullptr );
+
+    if ( !forDispel && ( isSpellcastUselessForUnit( target, enemies, spell ) || !arena->isSpellApplicable( target, spell, _commander ) ) ) {
         return 0.0;
     }
 
@@ -513,7 +628,7 @@ double AI::BattlePlanner::spellEffectValue( const Spell & spell, const Battle::U
 
         const SpellStorage spellList = _commander->getAllSpells();
         for ( const Spell & otherSpell : spellList ) {
-            if ( otherSpell.isResurrect() && _commander->HaveSpellPoints( otherSpell ) && target.AllowApplySpell( otherSpell, _commander ) ) {
+            if ( otherSpell.isResurrect() && _commander->HaveSpellPoints( otherSpell ) && arena->isSpellApplicable( target, otherSpell, _commander ) ) {
                 // Can resurrect unit in the future, limit the ratio
                 ratioLimit = 0.35;
                 break;
@@ -650,7 +765,7 @@ AI::SpellcastOutcome AI::BattlePlanner::spellResurrectValue( const Spell & spell
             continue;
         }
 
-        if ( !unit->AllowApplySpell( spell, _commander ) ) {
+        if ( !arena.isSpellApplicable( *unit, spell, _commander ) ) {
             continue;
         }
 
@@ -866,7 +981,7 @@ AI::SpellcastOutcome AI::BattlePlanner::spellTeleportValue( Battle::Arena & aren
     Battle::Position currentPos = currentUnit.GetPosition();
 
     BattleTargetPair currentBestTarget;
-    const double currentDamage = getMeleeBestOutcome( arena, currentUnit, enemies, currentBestTarget );
+    const double currentDamage = getMeleeBestOutcome( arena, currentUnit, UnitDamageEstimates( arena, currentUnit ), enemies, currentBestTarget );
     if ( currentDamage > 0.1 ) {
         // The current monster can reach some enemies.
         return {};
@@ -894,7 +1009,7 @@ AI::SpellcastOutcome AI::BattlePlanner::spellTeleportValue( Battle::Arena & aren
     tempUnit->SetModes( Battle::TELEPORT_ABILITY );
 
     BattleTargetPair bestTarget;
-    const double bestDamage = getMeleeBestOutcome( arena, currentUnit, enemies, bestTarget );
+    const double bestDamage = getMeleeBestOutcome( arena, currentUnit, UnitDamageEstimates( arena, currentUnit ), enemies, bestTarget );
 
     tempUnit->ResetModes( Battle::TELEPORT_ABILITY );
 
@@ -848,6 +848,7 @@ namespace
 
                     Troop & troop = world.GetCapturedObject( dstIndex ).GetTroop();
                     troop.SetCount( monstersLeft );
+                    world.markMonsterDataChanged();
 
                     // If all the guards are defeated, but the hero has lost the battle,
                     // just remove the protection from the object
@@ -2261,24 +2262,32 @@ fheroes2::GameMode AI::HeroesMove( Heroes & hero )
         }
 
         if ( hideAIMovements || !AIIsShowAnimationForHero( hero, colors ) ) {
-            // A hero might have been moving with visible animation for humans till he reaches the area
-            // where animation is not needed. This can be in the middle of movement between tiles.
-            // In this case it is important to reset animation sprite to make sure that the hero is
-            // ready for jump steps.
-            hero.resetHeroSprite();
-
-            hero.Move( true );
             recenterNeeded = true;
 
-            if ( hero.isAction() ) {
-                hero.ResetAction();
+            // Nothing is shown to the player while the hero is moving like this, so instead of handling events after every single step
+            // make as many steps as possible until the next frame is due. The steps themselves are exactly the same as before.
+            do {
+                // A hero might have been moving with visible animation for humans till he reaches the area
+                // where animation is not needed. This can be in the middle of movement between tiles.
+                // In this case it is important to reset animation sprite to make sure that the hero is
+                // ready for jump steps.
+                hero.resetHeroSprite();
+                hero.Move( true );
+
+                if ( hero.isAction() ) {
+                    hero.ResetAction();
 
-                // Check if the game is over after the hero's action.
-                const fheroes2::GameMode gameState = GameOver::Result::Get().checkGameOver();
-                if ( gameState != fheroes2::GameMode::CANCEL ) {
-                    return gameState;
+                    // Check if the game is over after the hero's action.
+                    const fheroes2::GameMode gameState = GameOver::Result::Get().checkGameOver();
+                    if ( gameState != fheroes2::GameMode::CANCEL ) {
+                        return gameState;
+                    }
+
+                    // The action could show a dialog or a battle, let the event loop catch up before continuing.
+                    break;
                 }
-            }
+            } while ( hero.isActive() && hero.isMoveEnabled() && !Game::hasEveryDelayPassed( { Game::MAPS_DELAY } )
+                      && ( hideAIMovements || !AIIsShowAnimationForHero( hero, colors ) ) );
 
             // Render a frame only if there is a need to show one.
             if ( Game::validateAnimationDelay( Game::MAPS_DELAY ) ) {
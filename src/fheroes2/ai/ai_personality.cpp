@@ -20,9 +20,19 @@
 
 #include "ai_personality.h"
 
+#include <map>
+
+#include "color.h"
 #include "rand.h"
 #include "translations.h"
 
+namespace
+{
+    const AI::PlannerParameters defaultPlannerParameters;
+
+    std::map<PlayerColor, AI::PlannerParameters> plannerParameters;
+}
+
 AI::Personality AI::getRandomPersonality()
 {
     return Rand::Get( Personality::WARRIOR, Personality::EXPLORER );
@@ -43,3 +53,23 @@ std::string AI::getPersonalityString( const Personality personality )
 
     return _( "None" );
 }
+
+const AI::PlannerParameters & AI::getPlannerParameters( const PlayerColor color )
+{
+    const auto iter = plannerParameters.find( color );
+    if ( iter == plannerParameters.end() ) {
+        return defaultPlannerParameters;
+    }
+
+    return iter->second;
+}
+
+void AI::setPlannerParameters( const PlayerColor color, const PlannerParameters & parameters )
+{
+    plannerParameters[color] = parameters;
+}
+
+void AI::resetPlannerParameters()
+{
+    plannerParameters.clear();
+}
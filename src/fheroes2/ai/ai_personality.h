@@ -23,6 +23,8 @@
 #include <cstdint>
 #include <string>
 
+enum class PlayerColor : uint8_t;
+
 namespace AI
 {
     enum class Personality : int32_t
@@ -33,6 +35,28 @@ namespace AI
         EXPLORER
     };
 
+    // Hand-tuned constants of the adventure map AI. Every AI kingdom can use its own values to compare them in self-play games.
+    struct PlannerParameters
+    {
+        // Minimal ratio of the AI army strength to the strength of an enemy army to attack it.
+        double armyAdvantageDesperate{ 0.8 };
+        double armyAdvantageSmall{ 1.3 };
+        double armyAdvantageMedium{ 1.5 };
+        double armyAdvantageLarge{ 1.8 };
+
+        // Ratio of spell points that heroes keep in reserve while looking for targets with the respective army advantage.
+        double spellPointsReserveRatioLarge{ 0.5 };
+        double spellPointsReserveRatioMedium{ 0.25 };
+    };
+
     Personality getRandomPersonality();
     std::string getPersonalityString( const Personality personality );
+
+    // Returns the parameters used by the kingdom of the given color. Default parameters are returned if none were set for this kingdom.
+    const PlannerParameters & getPlannerParameters( const PlayerColor color );
+
+    void setPlannerParameters( const PlayerColor color, const PlannerParameters & parameters );
+
+    // Makes all kingdoms use the default parameters.
+    void resetPlannerParameters();
 }
@@ -35,6 +35,7 @@
 #include "profit.h"
 #include "resource.h"
 #include "route.h"
+#include "settings.h"
 #include "world.h"
 #include "world_pathfinding.h"
 
@@ -47,6 +48,10 @@ AI::Planner & AI::Planner::Get()
 void AI::Planner::resetPathfinder()
 {
     _pathfinder.reset();
+
+    for ( const auto & pathfinder : _threatPathfinders ) {
+        pathfinder->reset();
+    }
 }
 
 void AI::Planner::revealFog( const Maps::Tile & tile, const Kingdom & kingdom )
@@ -78,6 +83,11 @@ void AI::Planner::revealFog( const Maps::Tile & tile, const Kingdom & kingdom )
 
 double AI::Planner::getTileArmyStrength( const Maps::Tile & tile )
 {
+    if ( const uint32_t monsterDataVersion = world.getMonsterDataVersion(); monsterDataVersion != _tileArmyStrengthVersion ) {
+        _tileArmyStrengthValues.clear();
+        _tileArmyStrengthVersion = monsterDataVersion;
+    }
+
     const auto [iter, inserted] = _tileArmyStrengthValues.try_emplace( tile.GetIndex(), 0.0 );
     if ( inserted ) {
         // Creating an Army instance is a relatively heavy operation, so cache it to speed up calculations
@@ -90,6 +100,13 @@ double AI::Planner::getTileArmyStrength( const Maps::Tile & tile )
     return iter->second;
 }
 
+bool AI::Planner::isTurnTimeLimitExceeded() const
+{
+    const int timeLimit = Settings::Get().AITurnTimeLimit();
+
+    return timeLimit > 0 && _turnTimer.getS() >= timeLimit;
+}
+
 double AI::Planner::getResourcePriorityModifier( const int resource, const bool isMine ) const
 {
     // Not all resources are equally valuable: 1 gold does not have the same value as 1 gemstone, so we need to
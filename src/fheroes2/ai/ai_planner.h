@@ -23,12 +23,16 @@
 #include <array>
 #include <cassert>
 #include <cstdint>
+#include <map>
+#include <memory>
 #include <set>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "ai_turn_profiler.h"
 #include "resource.h"
+#include "timing.h"
 #include "world_pathfinding.h"
 
 class Castle;
@@ -39,6 +43,8 @@ class Kingdom;
 struct VecCastles;
 struct VecHeroes;
 
+enum class PlayerColor : uint8_t;
+
 namespace fheroes2
 {
     enum class GameMode : int;
@@ -74,7 +80,7 @@ namespace AI
         REINFORCE
     };
 
-    // TODO: this structure is not being updated during AI heroes' actions.
+    // TODO: only castles and threats of this structure are updated during AI heroes' actions.
     struct RegionStats
     {
         bool evaluated = false;
@@ -84,6 +90,7 @@ namespace AI
         int enemyCastles = 0;
         int safetyFactor = 0;
         int spellLevel = 2;
+        std::vector<int32_t> castleIndexes;
     };
 
     struct AICastle
@@ -208,9 +215,15 @@ namespace AI
 
         bool recruitHero( Castle & castle, bool buyArmy );
 
-        void evaluateRegionSafety();
+        // Evaluates safety of all regions for the kingdom of the given color. The evaluation is skipped if neither castles and threats
+        // in regions nor regions themselves have changed since the previous evaluation for this kingdom.
+        void evaluateRegionSafety( const PlayerColor color );
+
+        // Updates castle and threat counters of the region containing the given tile after an action on this tile.
+        void updateRegionStats( const int32_t tileIndex, const PlayerColor color );
 
-        std::vector<AICastle> getSortedCastleList( const VecCastles & castles, const std::set<int> & castlesInDanger );
+        // Fills the given list with the castles sorted by their defense priority. The list of castles in danger must be sorted.
+        void updateSortedCastleList( const VecCastles & castles, const std::vector<int32_t> & castlesInDanger, std::vector<AICastle> & sortedCastleList );
 
         int getPriorityTarget( Heroes & hero, double & maxPriority );
 
@@ -227,12 +240,16 @@ namespace AI
         void updatePriorityTargets( Heroes & hero, const int32_t tileIndex, const MP2::MapObjectType objectType );
         void updateKingdomBudget( const Kingdom & kingdom );
 
-        bool purchaseNewHeroes( const std::vector<AICastle> & sortedCastleList, const std::set<int> & castlesInDanger, const int32_t availableHeroCount,
+        bool purchaseNewHeroes( const std::vector<AICastle> & sortedCastleList, const std::vector<int32_t> & castlesInDanger, const int32_t availableHeroCount,
                                 const bool moreTasksForHeroes );
 
         void updateMapActionObjectCache( const int mapIndex );
 
-        std::set<int> findCastlesInDanger( const Kingdom & kingdom );
+        // Returns true if the current kingdom turn takes longer than allowed by Settings::AITurnTimeLimit().
+        bool isTurnTimeLimitExceeded() const;
+
+        // Fills the given list with the sorted indexes of castles in danger.
+        void findCastlesInDanger( const Kingdom & kingdom, std::vector<int32_t> & castlesInDanger );
 
         void updatePriorityForEnemyArmy( const Kingdom & kingdom, const EnemyArmy & enemyArmy );
         void updatePriorityForCastle( const Castle & castle );
@@ -240,6 +257,11 @@ namespace AI
         // Return true if the castle is in danger.
         // IMPORTANT!!! Do not call this method directly. Use other methods which call it internally.
         bool updateIndividualPriorityForCastle( const Castle & castle, const EnemyArmy & enemyArmy );
+        // Same as above for the given distance from the enemy army to the castle.
+        bool updateIndividualPriorityForCastle( const Castle & castle, const EnemyArmy & enemyArmy, const uint32_t dist );
+        // Same as above for all the castles of a kingdom at once, which is faster than the evaluation of every castle separately. Appends
+        // the indexes of castles in danger to the given list, if any.
+        void updateIndividualPriorityForCastles( const VecCastles & castles, const EnemyArmy & enemyArmy, std::vector<int32_t> * castlesInDanger = nullptr );
 
         void removePriorityAttackTarget( const int32_t tileIndex );
         void updatePriorityAttackTarget( const Kingdom & kingdom, const Maps::Tile & tile );
@@ -267,13 +289,61 @@ namespace AI
 
         // Strength of the armies guarding the tiles (neutral monsters, guardians of dwellings, and so on) is constant for AI
         // during the same turn, but its calculation is a heavy operation, so it needs to be cached to speed up estimations.
-        // It is important to update this cache after performing an action on the corresponding tile.
+        // It is important to update this cache after performing an action on the corresponding tile. The cache is also dropped
+        // whenever the world reports a change of the monsters on the map (see World::getMonsterDataVersion()).
         std::unordered_map<int32_t, double> _tileArmyStrengthValues;
+        uint32_t _tileArmyStrengthVersion{ 0 };
 
         std::vector<RegionStats> _regions;
 
+        // Inputs and results of the last evaluation of region safety for every kingdom.
+        struct RegionSafetyCache
+        {
+            uint32_t regionDataVersion{ 0 };
+            std::vector<int> initialSafetyFactors;
+            std::vector<int> safetyFactors;
+        };
+
+        std::map<PlayerColor, RegionSafetyCache> _regionSafetyCache;
+
+        // Temporary containers used by the evaluations which are repeated many times during a kingdom turn. Their content is valid only
+        // within the method that fills it, but the allocated memory is kept between the calls and between the turns of all AI kingdoms.
+        struct TurnScratch
+        {
+            std::vector<int32_t> castlesInDanger;
+            std::vector<AICastle> sortedCastleList;
+
+            // Used by updateIndividualPriorityForCastles().
+            std::vector<const Castle *> closeCastles;
+            std::vector<int32_t> closeCastleIndexes;
+
+            // Used by getPriorityTarget(), indexed by tile.
+            std::vector<double> enemyThreatPenalties;
+            std::vector<int8_t> currentValidObjects;
+            std::vector<int32_t> futureValidObjects;
+
+            void clear()
+            {
+                castlesInDanger.clear();
+                sortedCastleList.clear();
+                closeCastles.clear();
+                closeCastleIndexes.clear();
+                enemyThreatPenalties.clear();
+                currentValidObjects.clear();
+                futureValidObjects.clear();
+            }
+        };
+
+        TurnScratch _turnScratch;
+
         std::array<BudgetEntry, 7> _budget = { Resource::WOOD, Resource::MERCURY, Resource::ORE, Resource::SULFUR, Resource::CRYSTAL, Resource::GEMS, Resource::GOLD };
 
+        // Measures the duration of the current kingdom turn.
+        fheroes2::Time _turnTimer;
+        TurnProfiler _turnProfiler;
+
         AIWorldPathfinder _pathfinder;
+        // Pathfinders used to evaluate enemy heroes concurrently, see getPriorityTarget().
+        std::vector<std::unique_ptr<AIWorldPathfinder>> _threatPathfinders;
     };
 }
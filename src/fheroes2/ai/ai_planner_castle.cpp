@@ -283,7 +283,15 @@ void AI::Planner::updateKingdomBudget( const Kingdom & kingdom )
 
         const int race = castle->GetRace();
         const std::vector<BuildOrder> & buildOrder = GetBuildOrder( race );
+
+        // Buildings with missing requirements can never lack only resources so they are filtered out in one go.
+        const uint32_t candidateBuildings = castle->getBuildingsWithMetRequirements();
+
         for ( const BuildOrder & order : buildOrder ) {
+            if ( !( candidateBuildings & order.building ) ) {
+                continue;
+            }
+
             const BuildingStatus status = castle->CheckBuyBuilding( order.building );
             if ( status == BuildingStatus::LACK_RESOURCES ) {
                 Funds missing = PaymentConditions::BuyBuilding( race, order.building ) - kindgomFunds;
@@ -515,6 +523,8 @@ void AI::Planner::reinforceCastle( Castle & castle )
 
 void AI::Planner::CastleTurn( Castle & castle, const bool defensiveStrategy )
 {
+    const TurnProfiler::Scope profilerScope( _turnProfiler, TurnPhase::CASTLES, _pathfinder );
+
     if ( defensiveStrategy ) {
         // If the castle is potentially under threat, then it makes sense to try to hire the maximum number of troops so that the enemy cannot hire them even if he
         // captures the castle, therefore, it is worth starting with hiring.
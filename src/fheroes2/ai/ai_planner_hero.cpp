@@ -24,8 +24,9 @@
 #include <cstddef>
 #include <cstdint>
 #include <functional>
-#include <list>
+#include <limits>
 #include <map>
+#include <memory>
 #include <ostream>
 #include <set>
 #include <string>
@@ -35,6 +36,7 @@
 
 #include "ai_common.h"
 #include "ai_hero_action.h"
+#include "ai_personality.h"
 #include "ai_planner.h" // IWYU pragma: associated
 #include "ai_planner_internals.h"
 #include "army.h"
@@ -74,6 +76,7 @@
 #include "settings.h"
 #include "skill.h"
 #include "spell.h"
+#include "thread.h"
 #include "visit.h"
 #include "world.h"
 #include "world_pathfinding.h"
@@ -101,6 +104,8 @@ namespace
         ~TileRestorer()
         {
             _originalTile = std::move( _copyTile );
+
+            world.updateTileScanData( _originalTile );
         }
 
     private:
@@ -119,7 +124,7 @@ namespace
         return numOfDaysPerWeek - currentDay + 1;
     }
 
-    int32_t completedDaysToTarget( const std::list<Route::Step> & steps, const Heroes & hero )
+    int32_t completedDaysToTarget( const std::vector<Route::Step> & steps, const Heroes & hero )
     {
         int32_t days{ 0 };
         uint32_t currentMovePoints = hero.GetMovePoints();
@@ -214,14 +219,11 @@ namespace
     {
         const uint32_t regularMovementDist = pathfinder.getDistance( index );
 
-        const std::list<Route::Step> dimensionDoorPath = pathfinder.buildDimensionDoorPath( index );
-        if ( dimensionDoorPath.empty() ) {
+        const uint32_t dimensionDoorDist = pathfinder.getDimensionDoorDistance( index );
+        if ( dimensionDoorDist == 0 ) {
             return { regularMovementDist, false };
         }
 
-        const uint32_t dimensionDoorDist = Route::calculatePathPenalty( dimensionDoorPath );
-        assert( dimensionDoorDist > 0 );
-
         if ( shouldUseDimensionDoor( regularMovementDist, dimensionDoorDist ) ) {
             return { dimensionDoorDist, true };
         }
@@ -252,7 +254,8 @@ namespace
             return false;
         }
 
-        const double advantage = hero.isLosingGame() ? AI::ARMY_ADVANTAGE_DESPERATE : AI::ARMY_ADVANTAGE_MEDIUM;
+        const AI::PlannerParameters & parameters = AI::getPlannerParameters( hero.GetColor() );
+        const double advantage = hero.isLosingGame() ? parameters.armyAdvantageDesperate : parameters.armyAdvantageMedium;
         const double castleStrength = castle->GetGarrisonStrength( hero ) * advantage;
 
         return heroArmyStrength > castleStrength;
@@ -358,7 +361,7 @@ namespace
         case MP2::OBJ_SAWMILL:
             if ( !hero.isFriends( getColorFromTile( tile ) ) ) {
                 if ( isCaptureObjectProtected( tile ) ) {
-                    return isHeroStrongerThan( tile, ai, heroArmyStrength, AI::ARMY_ADVANTAGE_SMALL );
+                    return isHeroStrongerThan( tile, ai, heroArmyStrength, AI::getPlannerParameters( hero.GetColor() ).armyAdvantageSmall );
                 }
 
                 return true;
@@ -366,7 +369,7 @@ namespace
             break;
 
         case MP2::OBJ_ABANDONED_MINE:
-            return isHeroStrongerThan( tile, ai, heroArmyStrength, AI::ARMY_ADVANTAGE_LARGE );
+            return isHeroStrongerThan( tile, ai, heroArmyStrength, AI::getPlannerParameters( hero.GetColor() ).armyAdvantageLarge );
 
         case MP2::OBJ_LEAN_TO:
         case MP2::OBJ_MAGIC_GARDEN:
@@ -400,7 +403,7 @@ namespace
             }
 
             if ( condition >= Maps::ArtifactCaptureCondition::FIGHT_50_ROGUES && condition <= Maps::ArtifactCaptureCondition::FIGHT_1_BONE_DRAGON ) {
-                return isHeroStrongerThan( tile, ai, heroArmyStrength, AI::ARMY_ADVANTAGE_LARGE );
+                return isHeroStrongerThan( tile, ai, heroArmyStrength, AI::getPlannerParameters( hero.GetColor() ).armyAdvantageLarge );
             }
 
             // No conditions to capture an artifact exist.
@@ -613,7 +616,7 @@ namespace
         case MP2::OBJ_DRAGON_CITY:
         case MP2::OBJ_TROLL_BRIDGE: {
             if ( getColorFromTile( tile ) == PlayerColor::NONE ) {
-                return isHeroStrongerThan( tile, ai, heroArmyStrength, AI::ARMY_ADVANTAGE_MEDIUM );
+                return isHeroStrongerThan( tile, ai, heroArmyStrength, AI::getPlannerParameters( hero.GetColor() ).armyAdvantageMedium );
             }
 
             return isArmyValuableToHire( army, kingdom, tile, armyStrengthThreshold );
@@ -660,19 +663,19 @@ namespace
             if ( !hero.isVisited( tile, Visit::GLOBAL ) && doesTileContainValuableItems( tile ) ) {
                 Army enemy( tile );
                 return enemy.isValid() && Skill::Level::EXPERT == hero.GetLevelSkill( Skill::Secondary::WISDOM )
-                       && isHeroStrongerThan( tile, ai, heroArmyStrength, AI::ARMY_ADVANTAGE_LARGE );
+                       && isHeroStrongerThan( tile, ai, heroArmyStrength, AI::getPlannerParameters( hero.GetColor() ).armyAdvantageLarge );
             }
             break;
 
         case MP2::OBJ_DAEMON_CAVE:
             if ( doesTileContainValuableItems( tile ) ) {
                 // AI always chooses to fight the demon's servants and doesn't roll the dice
-                return isHeroStrongerThan( tile, ai, heroArmyStrength, AI::ARMY_ADVANTAGE_MEDIUM );
+                return isHeroStrongerThan( tile, ai, heroArmyStrength, AI::getPlannerParameters( hero.GetColor() ).armyAdvantageMedium );
             }
             break;
 
         case MP2::OBJ_MONSTER:
-            return isHeroStrongerThan( tile, ai, heroArmyStrength, ( hero.isLosingGame() ? 1.0 : AI::ARMY_ADVANTAGE_MEDIUM ) );
+            return isHeroStrongerThan( tile, ai, heroArmyStrength, ( hero.isLosingGame() ? 1.0 : AI::getPlannerParameters( hero.GetColor() ).armyAdvantageMedium ) );
 
         case MP2::OBJ_HERO: {
             const Heroes * otherHero = tile.getHero();
@@ -701,7 +704,8 @@ namespace
                 return AIShouldVisitCastle( hero, index, heroArmyStrength );
             }
 
-            return army.isStrongerThan( otherHero->GetArmy(), hero.isLosingGame() ? AI::ARMY_ADVANTAGE_DESPERATE : AI::ARMY_ADVANTAGE_SMALL );
+            const AI::PlannerParameters & parameters = AI::getPlannerParameters( hero.GetColor() );
+            return army.isStrongerThan( otherHero->GetArmy(), hero.isLosingGame() ? parameters.armyAdvantageDesperate : parameters.armyAdvantageSmall );
         }
 
         case MP2::OBJ_CASTLE:
@@ -806,38 +810,43 @@ namespace
     class ObjectValidator final
     {
     public:
-        explicit ObjectValidator( const Heroes & hero, AIWorldPathfinder & pathfinder, AI::Planner & ai )
+        // The given containers are used as per-tile caches, their previous content is discarded.
+        ObjectValidator( const Heroes & hero, AIWorldPathfinder & pathfinder, AI::Planner & ai, std::vector<int8_t> & currentValidObjects,
+                         std::vector<int32_t> & futureValidObjects )
             : _hero( hero )
             , _pathfinder( pathfinder )
             , _ai( ai )
             , _heroArmyStrength( hero.GetArmy().GetStrength() )
             , _armyStrengthThreshold( hero.getAIMinimumJoiningArmyStrength() )
+            , _currentValidObjects( currentValidObjects )
+            , _futureValidObjects( futureValidObjects )
         {
-            // Do nothing.
+            _currentValidObjects.assign( world.getSize(), unknownCurrentValidity );
+            _futureValidObjects.assign( world.getSize(), unknownFutureValidity );
         }
 
         bool isCurrentlyValid( const int index )
         {
-            auto iter = _currentValidObjects.find( index );
-            if ( iter != _currentValidObjects.end() ) {
-                return iter->second;
+            assert( index >= 0 && static_cast<size_t>( index ) < _currentValidObjects.size() );
+
+            int8_t & cached = _currentValidObjects[index];
+            if ( cached == unknownCurrentValidity ) {
+                cached = isValidObjectForHero( _hero, _heroArmyStrength, index, _pathfinder, _ai, _armyStrengthThreshold, false ) ? 1 : 0;
             }
 
-            const bool valid = isValidObjectForHero( _hero, _heroArmyStrength, index, _pathfinder, _ai, _armyStrengthThreshold, false );
-            _currentValidObjects[index] = valid;
-            return valid;
+            return cached != 0;
         }
 
         int32_t whenGoingToBeValidInDays( const int index )
         {
-            auto iter = _futureValidObjects.find( index );
-            if ( iter != _futureValidObjects.end() ) {
-                return iter->second;
+            assert( index >= 0 && static_cast<size_t>( index ) < _futureValidObjects.size() );
+
+            int32_t & cached = _futureValidObjects[index];
+            if ( cached == unknownFutureValidity ) {
+                cached = getDaysWhenObjectWillBeValid( index, false );
             }
 
-            const int32_t days = getDaysWhenObjectWillBeValid( index, false );
-            _futureValidObjects[index] = days;
-            return days;
+            return cached;
         }
 
     private:
@@ -852,9 +861,11 @@ namespace
         // Army strength threshold is used to decide whether getting extra monsters is useful.
         const double _armyStrengthThreshold;
 
-        std::map<int, bool> _currentValidObjects;
+        static constexpr int8_t unknownCurrentValidity{ -1 };
+        static constexpr int32_t unknownFutureValidity{ std::numeric_limits<int32_t>::min() };
 
-        std::map<int, int> _futureValidObjects;
+        std::vector<int8_t> & _currentValidObjects;
+        std::vector<int32_t> & _futureValidObjects;
     };
 
     // Used for caching of object value estimation per hero.
@@ -2380,16 +2391,23 @@ int AI::Planner::getPriorityTarget( Heroes & hero, double & maxPriority )
 #endif
 
     // Pre-calculate penalties for tiles where there is a threat of enemy attack
-    const std::vector<double> enemyThreatPenalties = [this, &hero = std::as_const( hero )]() {
-        std::vector<double> result( world.getSize(), 0.0 );
+    const std::vector<double> & enemyThreatPenalties = [this, &hero = std::as_const( hero )]() -> const std::vector<double> & {
+        std::vector<double> & result = _turnScratch.enemyThreatPenalties;
+        result.assign( world.getSize(), 0.0 );
 
-        const AIWorldPathfinderStateRestorer pathfinderStateRestorer( _pathfinder );
+        struct Threat
+        {
+            const EnemyArmy * enemyArmy{ nullptr };
+            uint32_t movePointsThreshold{ 0 };
+            // Pathfinder pre-cached for the enemy hero, nullptr if a rough estimate is used.
+            AIWorldPathfinder * pathfinder{ nullptr };
+        };
 
-        // Use the "optimistic" pathfinder settings for enemy heroes - minimal army advantage, minimal reserve of spell points
-        _pathfinder.setMinimalArmyStrengthAdvantage( ARMY_ADVANTAGE_DESPERATE );
-        _pathfinder.setSpellPointsReserveRatio( 0.0 );
+        std::vector<Threat> threats;
+        std::vector<Threat *> threatsToEvaluate;
 
         const double heroStrength = hero.GetArmy().GetStrength();
+        const PlannerParameters & parameters = getPlannerParameters( hero.GetColor() );
 
         for ( const auto & [dummy, enemyArmy] : _enemyArmies ) {
             // Only enemy heroes are taken into account
@@ -2398,7 +2416,7 @@ int AI::Planner::getPriorityTarget( Heroes & hero, double & maxPriority )
             }
 
             // An enemy hero does not pose a threat if he is approximately equal in strength or weaker than our hero
-            if ( heroStrength * ARMY_ADVANTAGE_SMALL >= enemyArmy.strength ) {
+            if ( heroStrength * parameters.armyAdvantageSmall >= enemyArmy.strength ) {
                 continue;
             }
 
@@ -2410,27 +2428,54 @@ int AI::Planner::getPriorityTarget( Heroes & hero, double & maxPriority )
 
             // Safe tiles should not be located close to a tile accessible to an enemy hero, some margin is needed
             const uint32_t enemyArmyMovePointsThreshold = enemyArmy.movePoints + Maps::Ground::slowestMovePenalty * 2;
+
+            threats.push_back( { &enemyArmy, enemyArmyMovePointsThreshold, nullptr } );
+        }
+
+        for ( Threat & threat : threats ) {
             // If the enemy hero can't cross paths with our hero anywhere, then it makes sense to use a rough but quick estimate. Otherwise, an accurate but
             // relatively slow estimate will be used.
-            const bool useRoughEstimate = ( Maps::GetApproximateDistance( hero.GetIndex(), enemyArmy.index ) * Maps::Ground::fastestMovePenalty
-                                            > hero.GetMovePoints() + enemyArmyMovePointsThreshold );
+            const bool useRoughEstimate = ( Maps::GetApproximateDistance( hero.GetIndex(), threat.enemyArmy->index ) * Maps::Ground::fastestMovePenalty
+                                            > hero.GetMovePoints() + threat.movePointsThreshold );
 
             if ( !useRoughEstimate ) {
-                // Pre-cache the pathfinder database for the enemy hero
-                _pathfinder.reEvaluateIfNeeded( *enemyArmy.hero );
+                if ( _threatPathfinders.size() == threatsToEvaluate.size() ) {
+                    _threatPathfinders.emplace_back( std::make_unique<AIWorldPathfinder>() );
+                }
+
+                threat.pathfinder = _threatPathfinders[threatsToEvaluate.size()].get();
+                threatsToEvaluate.push_back( &threat );
             }
+        }
+
+        // Pre-cache the pathfinder database for every enemy hero. This is the most expensive part of the evaluation, and since every enemy hero has its own
+        // pathfinder and the world is not modified meanwhile, this is done concurrently.
+        MultiThreading::JobSystem::Get().parallelFor( 0, threatsToEvaluate.size(), [&threatsToEvaluate, &parameters]( const size_t i ) {
+            const Threat & threat = *threatsToEvaluate[i];
+
+            // Use the "optimistic" pathfinder settings for enemy heroes - minimal army advantage, minimal reserve of spell points
+            threat.pathfinder->setMinimalArmyStrengthAdvantage( parameters.armyAdvantageDesperate );
+            threat.pathfinder->setSpellPointsReserveRatio( 0.0 );
+
+            threat.pathfinder->reEvaluateIfNeeded( *threat.enemyArmy->hero );
+        } );
+
+        // Penalties are accumulated in the same order regardless of the order in which pathfinders were evaluated, so the result is always the same.
+        for ( const Threat & threat : threats ) {
+            const int32_t enemyArmyIdx = threat.enemyArmy->index;
+            const uint32_t enemyArmyMovePointsThreshold = threat.movePointsThreshold;
 
             for ( size_t i = 0; i < result.size(); ++i ) {
                 const int32_t tileIdx = static_cast<int32_t>( i );
                 assert( Maps::isValidAbsIndex( tileIdx ) );
 
-                const auto [distToTile, isTileConsideredSafe] = [this, enemyArmyIdx = enemyArmy.index, enemyArmyMovePointsThreshold, useRoughEstimate, tileIdx]() {
+                const auto [distToTile, isTileConsideredSafe] = [&threat, enemyArmyIdx, enemyArmyMovePointsThreshold, tileIdx]() {
                     // The tile on which the enemy hero is located is always considered unsafe
                     if ( tileIdx == enemyArmyIdx ) {
                         return std::make_pair( static_cast<uint32_t>( 0 ), false );
                     }
 
-                    if ( useRoughEstimate ) {
+                    if ( threat.pathfinder == nullptr ) {
                         const uint32_t dist = Maps::GetApproximateDistance( tileIdx, enemyArmyIdx ) * Maps::Ground::fastestMovePenalty;
 
                         // When using a rough estimate, a tile is considered safe if the enemy hero cannot reach it within one turn, even if the path from the enemy
@@ -2439,7 +2484,7 @@ int AI::Planner::getPriorityTarget( Heroes & hero, double & maxPriority )
                         return std::make_pair( dist, dist > enemyArmyMovePointsThreshold );
                     }
 
-                    const uint32_t dist = _pathfinder.getDistance( tileIdx );
+                    const uint32_t dist = threat.pathfinder->getDistance( tileIdx );
 
                     // When using an accurate estimate, a tile is considered safe if the enemy hero does not have access to it (in particular, if it is hidden from
                     // him in the fog) or he cannot reach it within one turn. The potential ability of the enemy hero to use spells to move to this tile (for example,
@@ -2463,42 +2508,49 @@ int AI::Planner::getPriorityTarget( Heroes & hero, double & maxPriority )
     // Pre-cache the pathfinder database for our hero
     _pathfinder.reEvaluateIfNeeded( hero );
 
-    ObjectValidator objectValidator( hero, _pathfinder, *this );
+    ObjectValidator objectValidator( hero, _pathfinder, *this, _turnScratch.currentValidObjects, _turnScratch.futureValidObjects );
     ObjectValueStorage valueStorage( hero, *this, lowestPossibleValue );
 
-    const auto getObjectValue = [this, &hero = std::as_const( hero ), &enemyThreatPenalties, &objectValidator,
-                                 &valueStorage]( const int destination, uint32_t & distance, double & value, const MP2::MapObjectType type, const bool isDimensionDoor ) {
+    const auto getObjectsOnTheWay = [this]( const int destination, const bool isDimensionDoor ) {
         // Dimension door path does not include any objects on the way.
-        if ( !isDimensionDoor ) {
-            for ( const IndexObject & pair : _pathfinder.getObjectsOnTheWay( destination ) ) {
-                const bool isValidObject = objectValidator.isCurrentlyValid( pair.first );
-                const int32_t dayToBecomeValid = objectValidator.whenGoingToBeValidInDays( pair.first );
+        if ( isDimensionDoor ) {
+            return std::vector<IndexObject>{};
+        }
 
-                if ( !isValidObject && dayToBecomeValid < 1 ) {
-                    // This is not a valid object and it is not going to be valid in the future.
-                    continue;
-                }
+        return _pathfinder.getObjectsOnTheWay( destination );
+    };
 
-                if ( const auto iter = _mapActionObjects.find( pair.first ); iter == _mapActionObjects.end() || iter->second != pair.second ) {
-                    continue;
-                }
+    const auto getObjectValue = [this, &hero = std::as_const( hero ), &enemyThreatPenalties, &objectValidator,
+                                 &valueStorage]( const int destination, uint32_t & distance, double & value, const MP2::MapObjectType type,
+                                                 const std::vector<IndexObject> & objectsOnTheWay ) {
+        for ( const IndexObject & pair : objectsOnTheWay ) {
+            const bool isValidObject = objectValidator.isCurrentlyValid( pair.first );
+            const int32_t dayToBecomeValid = objectValidator.whenGoingToBeValidInDays( pair.first );
+
+            if ( !isValidObject && dayToBecomeValid < 1 ) {
+                // This is not a valid object and it is not going to be valid in the future.
+                continue;
+            }
+
+            if ( const auto iter = _mapActionObjects.find( pair.first ); iter == _mapActionObjects.end() || iter->second != pair.second ) {
+                continue;
+            }
 
-                double extraValue = 0;
+            double extraValue = 0;
 
-                if ( isValidObject ) {
-                    extraValue = valueStorage.value( pair, 0 );
-                }
-                else {
-                    const int32_t daysToReachObject = completedDaysToTarget( _pathfinder.buildPath( pair.first ), hero );
-                    if ( daysToReachObject < dayToBecomeValid ) {
-                        extraValue = valueStorage.futureValue( pair, 0 );
-                    }
+            if ( isValidObject ) {
+                extraValue = valueStorage.value( pair, 0 );
+            }
+            else {
+                const int32_t daysToReachObject = completedDaysToTarget( _pathfinder.buildPath( pair.first ), hero );
+                if ( daysToReachObject < dayToBecomeValid ) {
+                    extraValue = valueStorage.futureValue( pair, 0 );
                 }
+            }
 
-                if ( extraValue > 0 ) {
-                    // There is no need to reduce the quality of the object even if the path has others.
-                    value += extraValue;
-                }
+            if ( extraValue > 0 ) {
+                // There is no need to reduce the quality of the object even if the path has others.
+                value += extraValue;
             }
         }
 
@@ -2549,6 +2601,18 @@ int AI::Planner::getPriorityTarget( Heroes & hero, double & maxPriority )
         }
     }
 
+    struct Candidate
+    {
+        int32_t index{ -1 };
+        MP2::MapObjectType type{ MP2::OBJ_NONE };
+        uint32_t distance{ 0 };
+        bool useDimensionDoor{ false };
+        bool isCurrentlyValid{ false };
+    };
+
+    std::vector<Candidate> candidates;
+    candidates.reserve( _mapActionObjects.size() );
+
     for ( const auto & [idx, objType] : _mapActionObjects ) {
         const bool isCurrentlyValid = objectValidator.isCurrentlyValid( idx );
         const int32_t daysToBeAvailable = objectValidator.whenGoingToBeValidInDays( idx );
@@ -2576,15 +2640,40 @@ int AI::Planner::getPriorityTarget( Heroes & hero, double & maxPriority )
             }
         }
 
+        candidates.push_back( { idx, objType, dist, useDimensionDoor, isCurrentlyValid } );
+    }
+
+    // Collecting the objects on the way to every candidate is the most expensive part of the evaluation. The pathfinder has already been evaluated
+    // for this hero and these queries do not modify it, so they can be done concurrently. Everything else relies on memoizing caches and thus is done
+    // sequentially in the original order of candidates to keep the choice of the target deterministic.
+    std::vector<std::vector<IndexObject>> objectsOnTheWay( candidates.size() );
+
+    MultiThreading::JobSystem::Get().parallelFor( 0, candidates.size(), [this, &candidates, &objectsOnTheWay]( const size_t i ) {
+        if ( !candidates[i].useDimensionDoor ) {
+            objectsOnTheWay[i] = _pathfinder.getObjectsOnTheWay( candidates[i].index );
+        }
+    } );
+
+    Interface::StatusPanel & status = Interface::AdventureMap::Get().getStatusPanel();
+
+    for ( size_t i = 0; i < candidates.size(); ++i ) {
+        // The evaluation of all candidates can take a noticeable time on big maps.
+        status.keepAITurnResponsive();
+
+        const Candidate & candidate = candidates[i];
+        const int32_t idx = candidate.index;
+        const MP2::MapObjectType objType = candidate.type;
+        uint32_t dist = candidate.distance;
+
         double value = 0;
-        if ( isCurrentlyValid ) {
+        if ( candidate.isCurrentlyValid ) {
             value = valueStorage.value( { idx, objType }, dist );
         }
         else {
             value = valueStorage.futureValue( { idx, objType }, dist );
         }
 
-        getObjectValue( idx, dist, value, objType, useDimensionDoor );
+        getObjectValue( idx, dist, value, objType, objectsOnTheWay[i] );
 
         if ( dist > 0 && value > maxPriority ) {
             priorityTarget = idx;
@@ -2608,7 +2697,7 @@ int AI::Planner::getPriorityTarget( Heroes & hero, double & maxPriority )
 
             if ( dist > 0 ) {
                 double value = ( isFindUltimateArtifactVictoryCondition() ? 3000.0 : 1500.0 ) * art.getArtifactValue();
-                getObjectValue( idx, dist, value, MP2::OBJ_ARTIFACT, useDimensionDoor );
+                getObjectValue( idx, dist, value, MP2::OBJ_ARTIFACT, getObjectsOnTheWay( idx, useDimensionDoor ) );
 
                 if ( dist > 0 && ( priorityTarget == -1 || value > maxPriority ) ) {
                     priorityTarget = idx;
@@ -2653,7 +2742,7 @@ int AI::Planner::getPriorityTarget( Heroes & hero, double & maxPriority )
             }
         }
 
-        getObjectValue( idx, dist, value, MP2::OBJ_NONE, useDimensionDoor );
+        getObjectValue( idx, dist, value, MP2::OBJ_NONE, getObjectsOnTheWay( idx, useDimensionDoor ) );
 
         if ( dist > 0 && ( priorityTarget == -1 || value > maxPriority ) ) {
             priorityTarget = idx;
@@ -2902,6 +2991,10 @@ void AI::Planner::HeroesActionComplete( Heroes & hero, const int32_t tileIndex,
 
     updatePriorityTargets( hero, tileIndex, objectType );
 
+    if ( objectType == MP2::OBJ_CASTLE || objectType == MP2::OBJ_HERO ) {
+        updateRegionStats( tileIndex, hero.GetColor() );
+    }
+
     updateMapActionObjectCache( tileIndex );
 }
 
@@ -3033,12 +3126,18 @@ fheroes2::GameMode AI::Planner::HeroesTurn( VecHeroes & heroes, uint32_t & curre
         int bestTargetIndex = -1;
 
         {
+            // Heroes and their armies are not modified while the targets are being selected, but the strength of the same armies is requested
+            // many times (per each object in the evaluation and per each tile with a hero in pathfinders).
+            const Army::StrengthCacheScope strengthCacheScope;
+
             const bool isLosingGame = bestHero->isLosingGame();
 
-            static const std::vector<std::pair<double, double>> commonPathfinderConfigurations{ { ARMY_ADVANTAGE_LARGE, 0.5 },
-                                                                                                { ARMY_ADVANTAGE_MEDIUM, 0.25 },
-                                                                                                { ARMY_ADVANTAGE_SMALL, 0.0 } };
-            static const std::vector<std::pair<double, double>> emergencyPathfinderConfigurations{ { ARMY_ADVANTAGE_DESPERATE, 0.0 } };
+            const PlannerParameters & parameters = getPlannerParameters( bestHero->GetColor() );
+
+            const std::vector<std::pair<double, double>> commonPathfinderConfigurations{ { parameters.armyAdvantageLarge, parameters.spellPointsReserveRatioLarge },
+                                                                                         { parameters.armyAdvantageMedium, parameters.spellPointsReserveRatioMedium },
+                                                                                         { parameters.armyAdvantageSmall, 0.0 } };
+            const std::vector<std::pair<double, double>> emergencyPathfinderConfigurations{ { parameters.armyAdvantageDesperate, 0.0 } };
 
             for ( const auto & [minStrengthAdvantage, spReserveRatio] : isLosingGame ? emergencyPathfinderConfigurations : commonPathfinderConfigurations ) {
                 _pathfinder.setMinimalArmyStrengthAdvantage( minStrengthAdvantage );
@@ -3048,7 +3147,11 @@ fheroes2::GameMode AI::Planner::HeroesTurn( VecHeroes & heroes, uint32_t & curre
 
                 for ( Heroes * hero : availableHeroes ) {
                     double priority = -1;
-                    const int targetIndex = getPriorityTarget( *hero, priority );
+                    const int targetIndex = [this, hero, &priority]() {
+                        const TurnProfiler::Scope profilerScope( _turnProfiler, TurnPhase::TARGET_SELECTION, _pathfinder, hero );
+
+                        return getPriorityTarget( *hero, priority );
+                    }();
 
                     if ( targetIndex != -1 && ( priority > maxPriority || bestTargetIndex == -1 ) ) {
                         maxPriority = priority;
@@ -3058,6 +3161,12 @@ fheroes2::GameMode AI::Planner::HeroesTurn( VecHeroes & heroes, uint32_t & curre
 
                     // This loop may take many time for computations, so pump the event queue and update the animation of the hourglass grains.
                     status.drawAITurnProgress( currentProgressValue );
+
+                    // Choosing the best hero among all of them is the most expensive part of the turn. Once the time limit is exceeded,
+                    // the first hero who has a valid target goes there without comparing him with the rest of heroes.
+                    if ( bestTargetIndex != -1 && isTurnTimeLimitExceeded() ) {
+                        break;
+                    }
                 }
 
                 if ( bestTargetIndex != -1 ) {
@@ -3112,12 +3221,14 @@ fheroes2::GameMode AI::Planner::HeroesTurn( VecHeroes & heroes, uint32_t & curre
         }
 
         const size_t heroesBefore = heroes.size();
-        _pathfinder.reEvaluateIfNeeded( *bestHero );
-
         int prevHeroPosition = bestHero->GetIndex();
 
         {
-            std::list<Route::Step> dimensionDoorPath = _pathfinder.buildDimensionDoorPath( bestTargetIndex );
+            const TurnProfiler::Scope profilerScope( _turnProfiler, TurnPhase::HERO_MOVEMENT, _pathfinder, bestHero );
+
+            _pathfinder.reEvaluateIfNeeded( *bestHero );
+
+            std::vector<Route::Step> dimensionDoorPath = _pathfinder.buildDimensionDoorPath( bestTargetIndex );
             uint32_t regularMovementDist = _pathfinder.getDistance( bestTargetIndex );
             uint32_t dimensionDoorDist = Route::calculatePathPenalty( dimensionDoorPath );
 
@@ -3131,7 +3242,7 @@ fheroes2::GameMode AI::Planner::HeroesTurn( VecHeroes & heroes, uint32_t & curre
                     _pathfinder.reEvaluateIfNeeded( *bestHero );
                     regularMovementDist = _pathfinder.getDistance( bestTargetIndex );
 
-                    dimensionDoorPath.pop_front();
+                    dimensionDoorPath.erase( dimensionDoorPath.begin() );
 
                     // Hero can jump straight into the fog using the Dimension Door spell, which triggers the mechanics of fog revealing for his new tile
                     // and this results in inserting a new hero position into the action object cache. Perform the necessary updates.
@@ -24,11 +24,6 @@
 
 namespace AI
 {
-    const double ARMY_ADVANTAGE_DESPERATE = 0.8;
-    const double ARMY_ADVANTAGE_SMALL = 1.3;
-    const double ARMY_ADVANTAGE_MEDIUM = 1.5;
-    const double ARMY_ADVANTAGE_LARGE = 1.8;
-
     class AIWorldPathfinderStateRestorer
     {
     public:
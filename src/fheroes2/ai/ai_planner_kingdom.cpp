@@ -32,6 +32,7 @@
 #include <vector>
 
 #include "ai_common.h"
+#include "ai_personality.h"
 #include "ai_planner.h" // IWYU pragma: associated
 #include "ai_planner_internals.h"
 #include "army.h"
@@ -67,6 +68,14 @@
 
 namespace
 {
+    // 30 tiles, roughly how much maxed out hero can move in a turn.
+    const uint32_t threatDistanceLimit = 3000;
+
+    bool isEnemyArmyCloseToCastle( const Castle & castle, const AI::EnemyArmy & enemyArmy )
+    {
+        return Maps::GetApproximateDistance( enemyArmy.index, castle.GetIndex() ) * Maps::Ground::fastestMovePenalty <= threatDistanceLimit;
+    }
+
     struct HeroValue
     {
         Heroes * hero = nullptr;
@@ -127,6 +136,57 @@ namespace
         std::vector<Heroes *> _heroes;
     };
 
+    // Coarse grid of castles used to find the castles which may be threatened by an army without checking every castle of a kingdom.
+    // The cell size is equal to the threat radius so only the cell of an army and its neighbours have to be checked.
+    class CastleProximityGrid
+    {
+    public:
+        explicit CastleProximityGrid( const VecCastles & castles )
+            : _cellsX( ( world.w() + cellSize - 1 ) / cellSize )
+            , _cellsY( ( world.h() + cellSize - 1 ) / cellSize )
+            , _cells( static_cast<size_t>( _cellsX ) * _cellsY )
+        {
+            for ( Castle * castle : castles ) {
+                if ( castle == nullptr ) {
+                    // How is it even possible? Check the logic!
+                    assert( 0 );
+                    continue;
+                }
+
+                const fheroes2::Point & pos = castle->GetCenter();
+                _cells[static_cast<size_t>( pos.y / cellSize ) * _cellsX + pos.x / cellSize].push_back( castle );
+            }
+        }
+
+        // Returns the castles which are located near the given tile. Castles beyond the threat radius might be returned as well, so the caller should still
+        // perform an exact distance check.
+        VecCastles getCastlesNear( const int32_t tileIndex ) const
+        {
+            const fheroes2::Point pos = Maps::GetPoint( tileIndex );
+            const int32_t cellX = pos.x / cellSize;
+            const int32_t cellY = pos.y / cellSize;
+
+            VecCastles result;
+
+            for ( int32_t y = std::max( cellY - 1, 0 ); y <= std::min( cellY + 1, _cellsY - 1 ); ++y ) {
+                for ( int32_t x = std::max( cellX - 1, 0 ); x <= std::min( cellX + 1, _cellsX - 1 ); ++x ) {
+                    const std::vector<Castle *> & cell = _cells[static_cast<size_t>( y ) * _cellsX + x];
+                    result.insert( result.end(), cell.begin(), cell.end() );
+                }
+            }
+
+            return result;
+        }
+
+    private:
+        // The approximate distance between two tiles is never less than the largest of the coordinate differences.
+        static constexpr int32_t cellSize{ static_cast<int32_t>( threatDistanceLimit / Maps::Ground::fastestMovePenalty ) };
+
+        const int32_t _cellsX;
+        const int32_t _cellsY;
+        std::vector<std::vector<Castle *>> _cells;
+    };
+
     void setHeroRoles( VecHeroes & heroes, const int difficulty )
     {
         if ( heroes.empty() ) {
@@ -320,8 +380,14 @@ bool AI::Planner::recruitHero( Castle & castle, bool buyArmy )
     return true;
 }
 
-void AI::Planner::evaluateRegionSafety()
+void AI::Planner::evaluateRegionSafety( const PlayerColor color )
 {
+    RegionSafetyCache & cache = _regionSafetyCache[color];
+
+    // The safety of a region depends on its neighbours, so a change in any region might affect all of them. However, most of the time
+    // nothing that the evaluation depends on changes between the turns of the same kingdom.
+    bool isCacheValid = ( cache.regionDataVersion == world.getRegionDataVersion() && cache.initialSafetyFactors.size() == _regions.size() );
+
     std::vector<std::pair<size_t, int>> regionsToCheck;
     size_t lastPositive = 0;
     for ( size_t regionID = 0; regionID < _regions.size(); ++regionID ) {
@@ -351,6 +417,26 @@ void AI::Planner::evaluateRegionSafety()
             stats.safetyFactor = 0;
             stats.evaluated = false;
         }
+
+        if ( isCacheValid && cache.initialSafetyFactors[regionID] != stats.safetyFactor ) {
+            isCacheValid = false;
+        }
+    }
+
+    if ( isCacheValid ) {
+        assert( cache.safetyFactors.size() == _regions.size() );
+
+        for ( size_t regionID = 0; regionID < _regions.size(); ++regionID ) {
+            _regions[regionID].safetyFactor = cache.safetyFactors[regionID];
+        }
+
+        return;
+    }
+
+    cache.regionDataVersion = world.getRegionDataVersion();
+    cache.initialSafetyFactors.resize( _regions.size() );
+    for ( size_t regionID = 0; regionID < _regions.size(); ++regionID ) {
+        cache.initialSafetyFactors[regionID] = _regions[regionID].safetyFactor;
     }
     std::sort( regionsToCheck.begin(), regionsToCheck.end(),
                []( const std::pair<size_t, int> & left, const std::pair<size_t, int> & right ) { return left.second > right.second; } );
@@ -389,11 +475,49 @@ void AI::Planner::evaluateRegionSafety()
         }
         ++currentEntry;
     }
+
+    cache.safetyFactors.resize( _regions.size() );
+    for ( size_t regionID = 0; regionID < _regions.size(); ++regionID ) {
+        cache.safetyFactors[regionID] = _regions[regionID].safetyFactor;
+    }
+}
+
+void AI::Planner::updateRegionStats( const int32_t tileIndex, const PlayerColor color )
+{
+    const uint32_t regionID = world.getTile( tileIndex ).GetRegion();
+    if ( regionID >= _regions.size() ) {
+        return;
+    }
+
+    RegionStats & stats = _regions[regionID];
+
+    stats.friendlyCastles = 0;
+    stats.enemyCastles = 0;
+    for ( const int32_t castleIndex : stats.castleIndexes ) {
+        const Castle * castle = world.getCastleEntrance( Maps::GetPoint( castleIndex ) );
+        assert( castle != nullptr );
+
+        if ( castle->isFriends( color ) ) {
+            ++stats.friendlyCastles;
+        }
+        else if ( castle->GetColor() != PlayerColor::NONE ) {
+            ++stats.enemyCastles;
+        }
+    }
+
+    stats.highestThreat = -1;
+    for ( const auto & [enemyArmyIndex, enemyArmy] : _enemyArmies ) {
+        if ( world.getTile( enemyArmyIndex ).GetRegion() == regionID && stats.highestThreat < enemyArmy.strength ) {
+            stats.highestThreat = enemyArmy.strength;
+        }
+    }
 }
 
-std::vector<AI::AICastle> AI::Planner::getSortedCastleList( const VecCastles & castles, const std::set<int> & castlesInDanger )
+void AI::Planner::updateSortedCastleList( const VecCastles & castles, const std::vector<int32_t> & castlesInDanger, std::vector<AICastle> & sortedCastleList )
 {
-    std::vector<AICastle> sortedCastleList;
+    assert( std::is_sorted( castlesInDanger.begin(), castlesInDanger.end() ) );
+
+    sortedCastleList.clear();
     sortedCastleList.reserve( castles.size() );
 
     for ( Castle * castle : castles ) {
@@ -404,7 +528,8 @@ std::vector<AI::AICastle> AI::Planner::getSortedCastleList( const VecCastles & c
         const int32_t castleIndex = castle->GetIndex();
         const uint32_t regionID = world.getTile( castleIndex ).GetRegion();
 
-        sortedCastleList.emplace_back( castle, castlesInDanger.count( castleIndex ) > 0, _regions[regionID].safetyFactor, castle->getBuildingValue() );
+        sortedCastleList.emplace_back( castle, std::binary_search( castlesInDanger.begin(), castlesInDanger.end(), castleIndex ), _regions[regionID].safetyFactor,
+                                       castle->getBuildingValue() );
     }
 
     std::sort( sortedCastleList.begin(), sortedCastleList.end(), []( const AICastle & left, const AICastle & right ) {
@@ -424,13 +549,11 @@ std::vector<AI::AICastle> AI::Planner::getSortedCastleList( const VecCastles & c
         // Since we compare 2 castles we need to use safety factor of the opposite castle.
         return left.buildingValue * right.safetyFactor > right.buildingValue * left.safetyFactor;
     } );
-
-    return sortedCastleList;
 }
 
-std::set<int> AI::Planner::findCastlesInDanger( const Kingdom & kingdom )
+void AI::Planner::findCastlesInDanger( const Kingdom & kingdom, std::vector<int32_t> & castlesInDanger )
 {
-    std::set<int> castlesInDanger;
+    castlesInDanger.clear();
 
     // Since we are estimating danger for a castle and we need to know if an enemy hero can reach it
     // if no our heroes exist. So we are temporary removing them from the map.
@@ -439,24 +562,18 @@ std::set<int> AI::Planner::findCastlesInDanger( const Kingdom & kingdom )
     const AIWorldPathfinderStateRestorer pathfinderStateRestorer( _pathfinder );
 
     // Use the "optimistic" pathfinder settings for enemy armies - minimal army advantage, minimal reserve of spell points
-    _pathfinder.setMinimalArmyStrengthAdvantage( ARMY_ADVANTAGE_DESPERATE );
+    _pathfinder.setMinimalArmyStrengthAdvantage( getPlannerParameters( kingdom.GetColor() ).armyAdvantageDesperate );
     _pathfinder.setSpellPointsReserveRatio( 0.0 );
 
-    for ( const auto & [dummy, enemyArmy] : _enemyArmies ) {
-        for ( const Castle * castle : kingdom.GetCastles() ) {
-            if ( castle == nullptr ) {
-                // How is it even possible? Check the logic!
-                assert( 0 );
-                continue;
-            }
+    const CastleProximityGrid castleGrid( kingdom.GetCastles() );
 
-            if ( updateIndividualPriorityForCastle( *castle, enemyArmy ) ) {
-                castlesInDanger.insert( castle->GetIndex() );
-            }
-        }
+    for ( const auto & [dummy, enemyArmy] : _enemyArmies ) {
+        updateIndividualPriorityForCastles( castleGrid.getCastlesNear( enemyArmy.index ), enemyArmy, &castlesInDanger );
     }
 
-    return castlesInDanger;
+    // The same castle can be threatened by several enemy armies.
+    std::sort( castlesInDanger.begin(), castlesInDanger.end() );
+    castlesInDanger.erase( std::unique( castlesInDanger.begin(), castlesInDanger.end() ), castlesInDanger.end() );
 }
 
 void AI::Planner::updatePriorityForEnemyArmy( const Kingdom & kingdom, const EnemyArmy & enemyArmy )
@@ -468,18 +585,10 @@ void AI::Planner::updatePriorityForEnemyArmy( const Kingdom & kingdom, const Ene
     const AIWorldPathfinderStateRestorer pathfinderStateRestorer( _pathfinder );
 
     // Use the "optimistic" pathfinder settings for enemy armies - minimal army advantage, minimal reserve of spell points
-    _pathfinder.setMinimalArmyStrengthAdvantage( ARMY_ADVANTAGE_DESPERATE );
+    _pathfinder.setMinimalArmyStrengthAdvantage( getPlannerParameters( kingdom.GetColor() ).armyAdvantageDesperate );
     _pathfinder.setSpellPointsReserveRatio( 0.0 );
 
-    for ( const Castle * castle : kingdom.GetCastles() ) {
-        if ( castle == nullptr ) {
-            // How is it even possible? Check the logic!
-            assert( 0 );
-            continue;
-        }
-
-        updateIndividualPriorityForCastle( *castle, enemyArmy );
-    }
+    updateIndividualPriorityForCastles( kingdom.GetCastles(), enemyArmy );
 }
 
 void AI::Planner::updatePriorityForCastle( const Castle & castle )
@@ -491,7 +600,7 @@ void AI::Planner::updatePriorityForCastle( const Castle & castle )
     const AIWorldPathfinderStateRestorer pathfinderStateRestorer( _pathfinder );
 
     // Use the "optimistic" pathfinder settings for enemy armies - minimal army advantage, minimal reserve of spell points
-    _pathfinder.setMinimalArmyStrengthAdvantage( ARMY_ADVANTAGE_DESPERATE );
+    _pathfinder.setMinimalArmyStrengthAdvantage( getPlannerParameters( castle.GetColor() ).armyAdvantageDesperate );
     _pathfinder.setSpellPointsReserveRatio( 0.0 );
 
     for ( const auto & [dummy, enemyArmy] : _enemyArmies ) {
@@ -501,13 +610,8 @@ void AI::Planner::updatePriorityForCastle( const Castle & castle )
 
 bool AI::Planner::updateIndividualPriorityForCastle( const Castle & castle, const EnemyArmy & enemyArmy )
 {
-    // 30 tiles, roughly how much maxed out hero can move in a turn.
-    const uint32_t threatDistanceLimit = 3000;
-
-    const int32_t castleIndex = castle.GetIndex();
-
     // Skip precise distance check if army is too far to be a threat
-    if ( Maps::GetApproximateDistance( enemyArmy.index, castleIndex ) * Maps::Ground::fastestMovePenalty > threatDistanceLimit ) {
+    if ( !isEnemyArmyCloseToCastle( castle, enemyArmy ) ) {
         return false;
     }
 
@@ -517,7 +621,54 @@ bool AI::Planner::updateIndividualPriorityForCastle( const Castle & castle, cons
     //
     // Of course, on the other hand, it may be the other way around - the enemy army may have access to some path that is not yet visible to the castle owner,
     // but since the castle owner doesn't know about this for sure, using this option smacks of cheating.
-    const uint32_t dist = _pathfinder.getDistance( enemyArmy.index, castleIndex, castle.GetColor(), enemyArmy.strength );
+    return updateIndividualPriorityForCastle( castle, enemyArmy, _pathfinder.getDistance( enemyArmy.index, castle.GetIndex(), castle.GetColor(), enemyArmy.strength ) );
+}
+
+void AI::Planner::updateIndividualPriorityForCastles( const VecCastles & castles, const EnemyArmy & enemyArmy, std::vector<int32_t> * castlesInDanger )
+{
+    std::vector<const Castle *> & closeCastles = _turnScratch.closeCastles;
+    std::vector<int32_t> & targets = _turnScratch.closeCastleIndexes;
+
+    closeCastles.clear();
+    targets.clear();
+
+    for ( const Castle * castle : castles ) {
+        if ( castle == nullptr ) {
+            // How is it even possible? Check the logic!
+            assert( 0 );
+            continue;
+        }
+
+        // Skip precise distance check if army is too far to be a threat
+        if ( isEnemyArmyCloseToCastle( *castle, enemyArmy ) ) {
+            closeCastles.push_back( castle );
+            targets.push_back( castle->GetIndex() );
+        }
+    }
+
+    if ( closeCastles.empty() ) {
+        return;
+    }
+
+    // All the castles of a kingdom have the same color, so the distances to all of them are evaluated by a single search from the enemy army (see the comment
+    // in the method above regarding the choice of the color). Castles which are farther than the threat distance limit are not considered at all, so the search
+    // stops there.
+    const PlayerColor color = closeCastles.front()->GetColor();
+    assert( std::all_of( closeCastles.begin(), closeCastles.end(), [color]( const Castle * castle ) { return castle->GetColor() == color; } ) );
+
+    const std::vector<uint32_t> distances = _pathfinder.getDistances( enemyArmy.index, targets, color, enemyArmy.strength, threatDistanceLimit );
+
+    for ( size_t i = 0; i < closeCastles.size(); ++i ) {
+        if ( updateIndividualPriorityForCastle( *closeCastles[i], enemyArmy, distances[i] ) && castlesInDanger != nullptr ) {
+            castlesInDanger->push_back( closeCastles[i]->GetIndex() );
+        }
+    }
+}
+
+bool AI::Planner::updateIndividualPriorityForCastle( const Castle & castle, const EnemyArmy & enemyArmy, const uint32_t dist )
+{
+    const int32_t castleIndex = castle.GetIndex();
+
     if ( dist == 0 || dist >= threatDistanceLimit ) {
         return false;
     }
@@ -556,7 +707,7 @@ bool AI::Planner::updateIndividualPriorityForCastle( const Castle & castle, cons
     // If the guest hero himself is not able to defeat a threatening enemy in an open field, then the castle
     // is considered to be in danger, and the guest hero should probably stay in it
     const Heroes * hero = castle.GetHero();
-    if ( hero && hero->GetArmy().GetStrength() <= enemyStrength * ARMY_ADVANTAGE_SMALL ) {
+    if ( hero && hero->GetArmy().GetStrength() <= enemyStrength * getPlannerParameters( castle.GetColor() ).armyAdvantageSmall ) {
         return true;
     }
 
@@ -651,6 +802,9 @@ fheroes2::GameMode AI::Planner::KingdomTurn( Kingdom & kingdom )
     const AIAutoControlModeCommitter aiAutoControlModeCommitter( kingdom );
 #endif
 
+    _turnTimer.reset();
+    _turnProfiler.reset();
+
     _mapActionObjects.clear();
     _priorityTargets.clear();
     _enemyArmies.clear();
@@ -713,79 +867,81 @@ fheroes2::GameMode AI::Planner::KingdomTurn( Kingdom & kingdom )
         return true;
     }();
 
-    const int mapSize = world.w() * world.h();
-
-    for ( int idx = 0; idx < mapSize; ++idx ) {
-        const Maps::Tile & tile = world.getTile( idx );
-        MP2::MapObjectType objectType = tile.getMainObjectType();
+    {
+        const TurnProfiler::Scope profilerScope( _turnProfiler, TurnPhase::PREPARATION, _pathfinder );
 
-        const uint32_t regionID = tile.GetRegion();
-        if ( regionID >= _regions.size() ) {
-            assert( 0 );
-            continue;
-        }
+        // The world keeps track of tiles of every object type, so there is no need to scan the whole map: only tiles with action objects are relevant here.
+        for ( const int32_t idx : world.getActionObjectTileIndexes() ) {
+            const Maps::Tile & tile = world.getTile( idx );
+            MP2::MapObjectType objectType = tile.getMainObjectType();
+            assert( MP2::isInGameActionObject( objectType ) );
 
-        RegionStats & stats = _regions[regionID];
-        if ( !isUnderViewSpell && tile.isFog( myColor ) ) {
-            continue;
-        }
+            const uint32_t regionID = tile.GetRegion();
+            if ( regionID >= _regions.size() ) {
+                assert( 0 );
+                continue;
+            }
 
-        if ( !MP2::isInGameActionObject( objectType ) ) {
-            continue;
-        }
+            RegionStats & stats = _regions[regionID];
+            if ( !isUnderViewSpell && tile.isFog( myColor ) ) {
+                continue;
+            }
 
-        if ( const auto [dummy, inserted] = _mapActionObjects.try_emplace( idx, objectType ); !inserted ) {
-            assert( 0 );
-        }
+            if ( const auto [dummy, inserted] = _mapActionObjects.try_emplace( idx, objectType ); !inserted ) {
+                assert( 0 );
+            }
 
-        if ( objectType == MP2::OBJ_HERO ) {
-            const Heroes * hero = tile.getHero();
-            assert( hero != nullptr );
+            if ( objectType == MP2::OBJ_HERO ) {
+                const Heroes * hero = tile.getHero();
+                assert( hero != nullptr );
 
-            if ( hero->GetColor() == myColor && !hero->Modes( Heroes::PATROL ) ) {
-                ++stats.friendlyHeroes;
+                if ( hero->GetColor() == myColor && !hero->Modes( Heroes::PATROL ) ) {
+                    ++stats.friendlyHeroes;
 
-                const int wisdomLevel = hero->GetLevelSkill( Skill::Secondary::WISDOM );
-                if ( wisdomLevel + 2 > stats.spellLevel ) {
-                    stats.spellLevel = wisdomLevel + 2;
+                    const int wisdomLevel = hero->GetLevelSkill( Skill::Secondary::WISDOM );
+                    if ( wisdomLevel + 2 > stats.spellLevel ) {
+                        stats.spellLevel = wisdomLevel + 2;
+                    }
                 }
+
+                // This hero can be in a castle
+                objectType = tile.getMainObjectType( false );
             }
 
-            // This hero can be in a castle
-            objectType = tile.getMainObjectType( false );
-        }
+            if ( objectType == MP2::OBJ_CASTLE ) {
+                const Castle * castle = world.getCastleEntrance( Maps::GetPoint( idx ) );
+                assert( castle != nullptr );
 
-        if ( objectType == MP2::OBJ_CASTLE ) {
-            const Castle * castle = world.getCastleEntrance( Maps::GetPoint( idx ) );
-            assert( castle != nullptr );
+                stats.castleIndexes.push_back( idx );
 
-            if ( castle->isFriends( myColor ) ) {
-                ++stats.friendlyCastles;
-            }
-            else if ( castle->GetColor() != PlayerColor::NONE ) {
-                ++stats.enemyCastles;
+                if ( castle->isFriends( myColor ) ) {
+                    ++stats.friendlyCastles;
+                }
+                else if ( castle->GetColor() != PlayerColor::NONE ) {
+                    ++stats.enemyCastles;
+                }
             }
-        }
 
-        const auto enemyArmy = getEnemyArmyOnTile( myColor, tile );
-        if ( enemyArmy ) {
-            assert( enemyArmy->index == idx );
+            const auto enemyArmy = getEnemyArmyOnTile( myColor, tile );
+            if ( enemyArmy ) {
+                assert( enemyArmy->index == idx );
 
-            if ( const auto [dummy, inserted] = _enemyArmies.try_emplace( idx, *enemyArmy ); !inserted ) {
-                assert( 0 );
-            }
+                if ( const auto [dummy, inserted] = _enemyArmies.try_emplace( idx, *enemyArmy ); !inserted ) {
+                    assert( 0 );
+                }
 
-            if ( stats.highestThreat < enemyArmy->strength ) {
-                stats.highestThreat = enemyArmy->strength;
+                if ( stats.highestThreat < enemyArmy->strength ) {
+                    stats.highestThreat = enemyArmy->strength;
+                }
             }
         }
-    }
 
-    DEBUG_LOG( DBG_AI, DBG_TRACE, Color::String( myColor ) << " found " << _mapActionObjects.size() << " valid objects" )
+        DEBUG_LOG( DBG_AI, DBG_TRACE, Color::String( myColor ) << " found " << _mapActionObjects.size() << " valid objects" )
 
-    evaluateRegionSafety();
+        evaluateRegionSafety( myColor );
 
-    updateKingdomBudget( kingdom );
+        updateKingdomBudget( kingdom );
+    }
 
     uint32_t currentProgressValue = 1;
     status.drawAITurnProgress( currentProgressValue );
@@ -817,8 +973,8 @@ fheroes2::GameMode AI::Planner::KingdomTurn( Kingdom & kingdom )
         }
     }
 
-    std::set<int> castlesInDanger;
-    std::vector<AICastle> sortedCastleList;
+    std::vector<int32_t> & castlesInDanger = _turnScratch.castlesInDanger;
+    std::vector<AICastle> & sortedCastleList = _turnScratch.sortedCastleList;
 
     while ( true ) {
         // If a hero is standing in a castle most likely he has nothing to do so let's try to give him more army.
@@ -830,11 +986,11 @@ fheroes2::GameMode AI::Planner::KingdomTurn( Kingdom & kingdom )
 
         setHeroRoles( heroes, Game::getDifficulty() );
 
-        castlesInDanger = findCastlesInDanger( kingdom );
+        findCastlesInDanger( kingdom, castlesInDanger );
         for ( Heroes * hero : heroes ) {
             assert( hero != nullptr );
 
-            if ( castlesInDanger.find( hero->GetIndex() ) == castlesInDanger.end() ) {
+            if ( !std::binary_search( castlesInDanger.begin(), castlesInDanger.end(), hero->GetIndex() ) ) {
                 continue;
             }
 
@@ -844,7 +1000,7 @@ fheroes2::GameMode AI::Planner::KingdomTurn( Kingdom & kingdom )
             HeroesActionComplete( *hero, hero->GetIndex(), hero->getObjectTypeUnderHero() );
         }
 
-        sortedCastleList = getSortedCastleList( castles, castlesInDanger );
+        updateSortedCastleList( castles, castlesInDanger, sortedCastleList );
 
         // If AI has less than three heroes at the start of the turn we assume
         // that he will buy another one in this turn and allow progress to increase only for 2 points.
@@ -894,10 +1050,10 @@ fheroes2::GameMode AI::Planner::KingdomTurn( Kingdom & kingdom )
 
     // Sync the list of castles (if new ones were captured during the turn)
     if ( castles.size() != sortedCastleList.size() ) {
-        evaluateRegionSafety();
+        evaluateRegionSafety( myColor );
 
-        castlesInDanger = findCastlesInDanger( kingdom );
-        sortedCastleList = getSortedCastleList( castles, castlesInDanger );
+        findCastlesInDanger( kingdom, castlesInDanger );
+        updateSortedCastleList( castles, castlesInDanger, sortedCastleList );
     }
 
     // Perform the castle development
@@ -907,6 +1063,8 @@ fheroes2::GameMode AI::Planner::KingdomTurn( Kingdom & kingdom )
         }
 
         CastleTurn( *entry.castle, entry.underThreat );
+
+        status.keepAITurnResponsive();
     }
 
     // For heroes in castles or towns, transfer their slowest troops to the garrison at the end of the turn to try to get a movement bonus on the next turn
@@ -921,12 +1079,16 @@ fheroes2::GameMode AI::Planner::KingdomTurn( Kingdom & kingdom )
         transferSlowestTroopsToGarrison( hero, castle );
     }
 
+    _turnProfiler.report( Color::String( myColor ) );
+
+    _turnScratch.clear();
+
     status.resetAITurnProgress();
 
     return fheroes2::GameMode::END_TURN;
 }
 
-bool AI::Planner::purchaseNewHeroes( const std::vector<AICastle> & sortedCastleList, const std::set<int> & castlesInDanger, const int32_t availableHeroCount,
+bool AI::Planner::purchaseNewHeroes( const std::vector<AICastle> & sortedCastleList, const std::vector<int32_t> & castlesInDanger, const int32_t availableHeroCount,
                                      const bool moreTasksForHeroes )
 {
     const bool isEarlyGameWithSingleCastle = world.CountDay() < 5 && sortedCastleList.size() == 1;
@@ -957,7 +1119,7 @@ bool AI::Planner::purchaseNewHeroes( const std::vector<AICastle> & sortedCastleL
             const int mapIndex = castle->GetIndex();
 
             // Make sure there is no hero in castle already and we're not under threat while having other heroes.
-            if ( hero != nullptr || ( availableHeroCount > 0 && castlesInDanger.find( mapIndex ) != castlesInDanger.end() ) )
+            if ( hero != nullptr || ( availableHeroCount > 0 && std::binary_search( castlesInDanger.begin(), castlesInDanger.end(), mapIndex ) ) )
                 continue;
 
             const uint32_t regionID = world.getTile( mapIndex ).GetRegion();
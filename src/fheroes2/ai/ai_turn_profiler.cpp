@@ -0,0 +1,175 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "ai_turn_profiler.h"
+
+#include <sstream>
+
+#include "heroes.h"
+#include "logging.h"
+#include "perf_counters.h"
+#include "world_pathfinding.h"
+
+namespace
+{
+    const char * getTurnPhaseName( const AI::TurnPhase phase )
+    {
+        switch ( phase ) {
+        case AI::TurnPhase::PREPARATION:
+            return "preparation";
+        case AI::TurnPhase::TARGET_SELECTION:
+            return "target_selection";
+        case AI::TurnPhase::HERO_MOVEMENT:
+            return "hero_movement";
+        case AI::TurnPhase::CASTLES:
+            return "castles";
+        default:
+            break;
+        }
+
+        return "unknown";
+    }
+
+    std::string escapeJsonString( const std::string & str )
+    {
+        std::string result;
+        result.reserve( str.size() );
+
+        for ( const char c : str ) {
+            if ( c == '"' || c == '\\' ) {
+                result.push_back( '\\' );
+            }
+
+            result.push_back( c );
+        }
+
+        return result;
+    }
+
+    template <typename PhaseStats>
+    void writePhasesJson( std::ostringstream & os, const PhaseStats & phases )
+    {
+        os << '{';
+
+        for ( size_t i = 0; i < phases.size(); ++i ) {
+            const AI::TurnPhaseStats & stats = phases[i];
+
+            os << ( i > 0 ? "," : "" ) << '"' << getTurnPhaseName( static_cast<AI::TurnPhase>( i ) ) << "\":{\"time\":" << stats.time << ",\"calls\":" << stats.calls
+               << ",\"pathfinder_evaluations\":" << stats.pathfinderEvaluations << '}';
+        }
+
+        os << '}';
+    }
+}
+
+AI::TurnProfiler::Scope::Scope( TurnProfiler & profiler, const TurnPhase phase, const AIWorldPathfinder & pathfinder, const Heroes * hero /* = nullptr */ )
+    : _profiler( profiler )
+    , _pathfinder( pathfinder )
+    , _hero( hero )
+    , _phase( phase )
+    , _initialPathfinderEvaluations( pathfinder.getEvaluationCount() )
+{}
+
+AI::TurnProfiler::Scope::~Scope()
+{
+    _profiler._add( _phase, _hero, _timer.getS(), _pathfinder.getEvaluationCount() - _initialPathfinderEvaluations );
+}
+
+void AI::TurnProfiler::reset()
+{
+    _phases = {};
+    _heroes.clear();
+    _turnTimer.reset();
+}
+
+void AI::TurnProfiler::report( [[maybe_unused]] const std::string & kingdomName ) const
+{
+    fheroes2::addPerfSample( fheroes2::PerfHistogram::AI_TURN_TIME_MS, _turnTimer.getMs() );
+
+#if defined( WITH_DEBUG )
+    if ( !IS_DEBUG( DBG_AI, DBG_INFO ) ) {
+        return;
+    }
+
+    const double turnTime = _turnTimer.getS();
+    double accountedTime = 0;
+
+    for ( size_t i = 0; i < _phases.size(); ++i ) {
+        const TurnPhaseStats & stats = _phases[i];
+        accountedTime += stats.time;
+
+        DEBUG_LOG( DBG_AI, DBG_INFO,
+                   kingdomName << " turn phase " << getTurnPhaseName( static_cast<TurnPhase>( i ) ) << ": " << stats.time << " s, " << stats.calls << " calls, "
+                               << stats.pathfinderEvaluations << " pathfinder evaluations" )
+    }
+
+    DEBUG_LOG( DBG_AI, DBG_INFO, kingdomName << " turn took " << turnTime << " s, " << turnTime - accountedTime << " s are not accounted to any phase" )
+
+    for ( const auto & [heroName, phases] : _heroes ) {
+        const TurnPhaseStats & selection = phases[static_cast<size_t>( TurnPhase::TARGET_SELECTION )];
+        const TurnPhaseStats & movement = phases[static_cast<size_t>( TurnPhase::HERO_MOVEMENT )];
+
+        DEBUG_LOG( DBG_AI, DBG_INFO,
+                   heroName << ": target selection " << selection.time << " s (" << selection.calls << " calls, " << selection.pathfinderEvaluations
+                            << " pathfinder evaluations), movement " << movement.time << " s (" << movement.calls << " calls, " << movement.pathfinderEvaluations
+                            << " pathfinder evaluations)" )
+    }
+
+    DEBUG_LOG( DBG_AI, DBG_TRACE, "AI turn profile: " << _toJson( kingdomName ) )
+#endif
+}
+
+void AI::TurnProfiler::_add( const TurnPhase phase, const Heroes * hero, const double time, const uint32_t pathfinderEvaluations )
+{
+    const auto addStats = [phase, time, pathfinderEvaluations]( PhaseStats & phases ) {
+        TurnPhaseStats & stats = phases[static_cast<size_t>( phase )];
+
+        stats.time += time;
+        ++stats.calls;
+        stats.pathfinderEvaluations += pathfinderEvaluations;
+    };
+
+    addStats( _phases );
+
+    if ( hero != nullptr ) {
+        addStats( _heroes[hero->GetName()] );
+    }
+}
+
+std::string AI::TurnProfiler::_toJson( const std::string & kingdomName ) const
+{
+    std::ostringstream os;
+
+    os << "{\"kingdom\":\"" << escapeJsonString( kingdomName ) << "\",\"time\":" << _turnTimer.getS() << ",\"phases\":";
+    writePhasesJson( os, _phases );
+    os << ",\"heroes\":{";
+
+    bool isFirstHero = true;
+    for ( const auto & [heroName, phases] : _heroes ) {
+        os << ( isFirstHero ? "" : "," ) << '"' << escapeJsonString( heroName ) << "\":";
+        writePhasesJson( os, phases );
+
+        isFirstHero = false;
+    }
+
+    os << "}}";
+
+    return os.str();
+}
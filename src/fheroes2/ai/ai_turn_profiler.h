@@ -0,0 +1,100 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include "timing.h"
+
+class AIWorldPathfinder;
+class Heroes;
+
+namespace AI
+{
+    enum class TurnPhase : uint8_t
+    {
+        // Map scan, evaluation of regions and the kingdom budget.
+        PREPARATION,
+        // Evaluation of targets for heroes.
+        TARGET_SELECTION,
+        // Movement of heroes including their actions and battles.
+        HERO_MOVEMENT,
+        // Development of castles.
+        CASTLES,
+
+        PHASE_COUNT
+    };
+
+    struct TurnPhaseStats
+    {
+        double time{ 0 };
+        uint32_t calls{ 0 };
+        uint32_t pathfinderEvaluations{ 0 };
+    };
+
+    // Collects the time, the number of calls and the number of pathfinder evaluations for every phase of a single AI kingdom turn,
+    // both in total and for every hero.
+    class TurnProfiler
+    {
+    public:
+        // Measures everything done during its lifetime and accounts it to the given phase (and hero, if any).
+        class Scope
+        {
+        public:
+            Scope( TurnProfiler & profiler, const TurnPhase phase, const AIWorldPathfinder & pathfinder, const Heroes * hero = nullptr );
+
+            Scope( const Scope & ) = delete;
+
+            ~Scope();
+
+            Scope & operator=( const Scope & ) = delete;
+
+        private:
+            TurnProfiler & _profiler;
+            const AIWorldPathfinder & _pathfinder;
+            const Heroes * _hero;
+            const TurnPhase _phase;
+            const uint32_t _initialPathfinderEvaluations;
+            const fheroes2::Time _timer;
+        };
+
+        void reset();
+
+        // Writes the collected statistics to the log using the DBG_AI category: a human-readable breakdown at the info level and
+        // a single line JSON dump at the trace level.
+        void report( const std::string & kingdomName ) const;
+
+    private:
+        using PhaseStats = std::array<TurnPhaseStats, static_cast<size_t>( TurnPhase::PHASE_COUNT )>;
+
+        void _add( const TurnPhase phase, const Heroes * hero, const double time, const uint32_t pathfinderEvaluations );
+
+        std::string _toJson( const std::string & kingdomName ) const;
+
+        PhaseStats _phases;
+        std::map<std::string, PhaseStats> _heroes;
+        fheroes2::Time _turnTimer;
+    };
+}
@@ -150,6 +150,44 @@ namespace
 
         return { 0, 0 };
     }
+
+    // See Army::StrengthCacheScope. These values are changed only outside of concurrent jobs, so they can be read from any thread.
+    uint32_t strengthCacheScopeDepth{ 0 };
+    uint32_t strengthCacheEpoch{ 0 };
+
+    struct ArmyStrengthCacheEntry
+    {
+        const HeroBase * commander{ nullptr };
+        std::vector<std::pair<int, uint32_t>> troops;
+        double strength{ 0 };
+    };
+
+    struct ArmyStrengthCache
+    {
+        uint32_t epoch{ 0 };
+        std::unordered_map<const Army *, ArmyStrengthCacheEntry> entries;
+    };
+
+    // AI pathfinders can be evaluated concurrently, so every thread has its own cache.
+    thread_local ArmyStrengthCache armyStrengthCache;
+
+    bool isSameArmyComposition( const ArmyStrengthCacheEntry & entry, const HeroBase * commander, const Troops & troops )
+    {
+        if ( entry.commander != commander || entry.troops.size() != troops.Size() ) {
+            return false;
+        }
+
+        for ( size_t i = 0; i < entry.troops.size(); ++i ) {
+            const Troop * troop = troops.GetTroop( i );
+            assert( troop != nullptr );
+
+            if ( entry.troops[i].first != troop->GetID() || entry.troops[i].second != troop->GetCount() ) {
+                return false;
+            }
+        }
+
+        return true;
+    }
 }
 
 std::string Army::TroopSizeString( const Troop & troop )
@@ -1283,7 +1321,56 @@ int Army::GetMoraleModificator( std::string * strs ) const
     return result;
 }
 
+Army::StrengthCacheScope::StrengthCacheScope()
+{
+    if ( strengthCacheScopeDepth == 0 ) {
+        ++strengthCacheEpoch;
+    }
+
+    ++strengthCacheScopeDepth;
+}
+
+Army::StrengthCacheScope::~StrengthCacheScope()
+{
+    assert( strengthCacheScopeDepth > 0 );
+
+    --strengthCacheScopeDepth;
+}
+
 double Army::GetStrength() const
+{
+    if ( strengthCacheScopeDepth == 0 ) {
+        return _calculateStrength();
+    }
+
+    ArmyStrengthCache & cache = armyStrengthCache;
+    if ( cache.epoch != strengthCacheEpoch ) {
+        cache.entries.clear();
+        cache.epoch = strengthCacheEpoch;
+    }
+
+    const auto [iter, inserted] = cache.entries.try_emplace( this );
+    ArmyStrengthCacheEntry & entry = iter->second;
+
+    if ( !inserted && isSameArmyComposition( entry, commander, *this ) ) {
+        return entry.strength;
+    }
+
+    entry.commander = commander;
+    entry.troops.clear();
+
+    for ( const Troop * troop : *this ) {
+        assert( troop != nullptr );
+
+        entry.troops.emplace_back( troop->GetID(), troop->GetCount() );
+    }
+
+    entry.strength = _calculateStrength();
+
+    return entry.strength;
+}
+
+double Army::_calculateStrength() const
 {
     double result = 0;
 
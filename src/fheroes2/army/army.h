@@ -162,6 +162,20 @@ class Army final : public Troops, public Control
 public:
     static const size_t maximumTroopCount = 5;
 
+    // While at least one instance of this class exists, the strength of an army is calculated only once and then reused as long as the army
+    // consists of the same troops under the same commander. The caller must guarantee that commanders (their skills, artifacts, spells, etc.)
+    // are not modified meanwhile, e.g. while AI evaluates its options. Scopes must be created and destroyed outside of concurrent jobs.
+    class StrengthCacheScope
+    {
+    public:
+        StrengthCacheScope();
+        StrengthCacheScope( const StrengthCacheScope & ) = delete;
+
+        ~StrengthCacheScope();
+
+        StrengthCacheScope & operator=( const StrengthCacheScope & ) = delete;
+    };
+
     static std::string SizeString( uint32_t );
     static std::string TroopSizeString( const Troop & );
 
@@ -272,6 +286,8 @@ private:
     // the tile index) with a random chance to get an upgraded stack of monsters in the center (if allowed)
     void ArrangeForBattle( const Monster & monster, const uint32_t monstersCount, const int32_t tileIndex, const bool allowUpgrade );
 
+    double _calculateStrength() const;
+
     HeroBase * commander;
     bool _isSpreadCombatFormation{ true };
     PlayerColor _color{ PlayerColor::NONE };
@@ -270,7 +270,9 @@ void ArmyBar::RedrawItem( ArmyTroop & troop, const fheroes2::Rect & pos, bool se
         return;
     }
 
-    const fheroes2::Text text( std::to_string( troop.GetCount() ), use_mini_sprite ? fheroes2::FontType::smallWhite() : fheroes2::FontType::normalWhite() );
+    const fheroes2::FontType fontType = use_mini_sprite ? fheroes2::FontType::smallWhite() : fheroes2::FontType::normalWhite();
+    const fheroes2::RenderedText & text = fheroes2::getRenderedText( std::to_string( troop.GetCount() ), fontType );
+    const int32_t textHeight = fheroes2::getFontHeight( fontType.size );
 
     if ( use_mini_sprite ) {
         const fheroes2::Sprite & mons32 = fheroes2::AGG::GetICN( ICN::MONS32, troop.GetSpriteIndex() );
@@ -289,12 +291,12 @@ void ArmyBar::RedrawItem( ArmyTroop & troop, const fheroes2::Rect & pos, bool se
         fheroes2::Blit( mons32, srcrt.x, srcrt.y, dstsf, pos.x + ( pos.width - mons32.width() ) / 2, pos.y + pos.height - mons32.height() - 1, srcrt.width,
                         srcrt.height );
 
-        text.draw( pos.x + pos.width - text.width() - 3, pos.y + pos.height - text.height() + 2, dstsf );
+        fheroes2::Blit( text.image, dstsf, pos.x + pos.width - text.width - 3 + text.image.x(), pos.y + pos.height - textHeight + 2 + text.image.y() );
     }
     else {
         fheroes2::renderMonsterFrame( troop, dstsf, pos.getPosition() );
 
-        text.draw( pos.x + pos.width - text.width() - 3, pos.y + pos.height - text.height() + 1, dstsf );
+        fheroes2::Blit( text.image, dstsf, pos.x + pos.width - text.width - 3 + text.image.x(), pos.y + pos.height - textHeight + 1 + text.image.y() );
     }
 
     if ( selected ) {
@@ -28,10 +28,14 @@
 #include <cstddef>
 #include <cstdlib>
 #include <deque>
+#include <iomanip>
 #include <list>
 #include <mutex>
 #include <optional>
 #include <ostream>
+#include <set>
+#include <sstream>
+#include <string_view>
 #include <utility>
 
 #include "agg_file.h"
@@ -49,6 +53,13 @@
 
 namespace
 {
+#if defined( TARGET_PS_VITA ) || defined( TARGET_NINTENDO_SWITCH )
+    // Handheld devices have less CPU power for sound mixing.
+    const int maxSoundChannels{ 16 };
+#else
+    const int maxSoundChannels{ 32 };
+#endif
+
     struct MusicFileType
     {
         explicit MusicFileType( const MUS::ExternalMusicNamingScheme scheme )
@@ -254,6 +265,7 @@ namespace
     // Returns the ID of the channel occupied by the sound being played, or a negative value (-1) in case of failure.
     int PlaySoundImpl( const int m82 );
     void PlayMusicImpl( const int trackId, const MusicSource musicType, const Music::PlaybackMode playbackMode );
+    void convertMIDImpl( const int xmi );
     void playLoopSoundsImpl( std::map<M82::SoundType, std::vector<AudioManager::AudioLoopEffectInfo>> soundEffects, const bool is3DAudioEnabled );
 
     // SDL MIDI player is a single threaded library which requires a lot of time to start playing some long midi compositions.
@@ -295,6 +307,17 @@ namespace
             notifyWorker();
         }
 
+        void pushMidiConversion( const int xmi )
+        {
+            createWorker();
+
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
+            _midiConversionTasks.emplace_back( xmi );
+
+            notifyWorker();
+        }
+
         void removeMusicTask()
         {
             const std::scoped_lock<std::mutex> lock( _mutex );
@@ -334,6 +357,7 @@ namespace
             }
         }
 
+        // MIDI conversion tasks are not related to the playback, so they are not removed by this method.
         void removeAllTasks()
         {
             const std::scoped_lock<std::mutex> lock( _mutex );
@@ -342,7 +366,20 @@ namespace
             _soundTasks.clear();
             _loopSoundTask.reset();
 
-            _taskToExecute = TaskType::None;
+            if ( _taskToExecute != TaskType::ConvertMidi ) {
+                _taskToExecute = TaskType::None;
+            }
+        }
+
+        void removeMidiConversionTasks()
+        {
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
+            _midiConversionTasks.clear();
+
+            if ( _taskToExecute == TaskType::ConvertMidi ) {
+                _taskToExecute = TaskType::None;
+            }
         }
 
         // This mutex protects operations with AudioManager's resources, such as AGG files, data caches, etc
@@ -357,7 +394,8 @@ namespace
             None,
             PlayMusic,
             PlaySound,
-            PlayLoopSound
+            PlayLoopSound,
+            ConvertMidi
         };
 
         struct MusicTask
@@ -408,10 +446,12 @@ namespace
         std::optional<MusicTask> _musicTask;
         std::deque<SoundTask> _soundTasks;
         std::optional<LoopSoundTask> _loopSoundTask;
+        std::deque<int> _midiConversionTasks;
 
         MusicTask _currentMusicTask;
         SoundTask _currentSoundTask;
         LoopSoundTask _currentLoopSoundTask;
+        int _currentMidiConversionTask{ 0 };
 
         std::atomic<TaskType> _taskToExecute{ TaskType::None };
 
@@ -447,6 +487,16 @@ namespace
                 return true;
             }
 
+            // MIDI conversion tasks have the lowest priority and are executed one by one, so they never delay the playback for long
+            if ( !_midiConversionTasks.empty() ) {
+                _currentMidiConversionTask = _midiConversionTasks.front();
+                _midiConversionTasks.pop_front();
+
+                _taskToExecute = TaskType::ConvertMidi;
+
+                return true;
+            }
+
             _taskToExecute = TaskType::None;
 
             return false;
@@ -455,6 +505,13 @@ namespace
         // This method is called by the worker thread, but is not protected by _mutex
         void executeTask() override
         {
+            if ( _taskToExecute == TaskType::ConvertMidi ) {
+                // The conversion acquires the resource mutex only to access the AGG files and the MIDI data cache, the conversion itself
+                // is performed without it so as not to block the playback of sounds requested by the main thread.
+                convertMIDImpl( _currentMidiConversionTask );
+                return;
+            }
+
             // Do not allow the main thread to acquire this mutex in the interval between the
             // _taskToExecute was checked and the task was started executing. Release it only
             // when the task is fully completed.
@@ -473,6 +530,10 @@ namespace
             case TaskType::PlayLoopSound:
                 playLoopSoundsImpl( std::move( _currentLoopSoundTask.soundEffects ), _currentLoopSoundTask.is3DAudioEnabled );
                 return;
+            case TaskType::ConvertMidi:
+                // This task has already been executed above.
+                assert( 0 );
+                return;
             default:
                 // How is it even possible? Did you add a new task?
                 assert( 0 );
@@ -484,6 +545,9 @@ namespace
     std::map<M82::SoundType, std::vector<ChannelAudioLoopEffectInfo>> currentAudioLoopEffects;
     bool is3DAudioLoopEffectsEnabled{ false };
 
+    // The audio loop effects last requested to be played. Used only by the main thread to skip requests that don't change anything.
+    std::optional<std::pair<std::map<M82::SoundType, std::vector<AudioManager::AudioLoopEffectInfo>>, bool>> lastRequestedAudioLoopEffects;
+
     // The music track last requested to be played
     int lastRequestedMusicTrackId{ MUS::UNKNOWN };
     // The music track that is currently being played
@@ -507,6 +571,208 @@ namespace
 
     AsyncSoundManager g_asyncSoundManager;
 
+#if defined( TARGET_PS_VITA ) || defined( TARGET_NINTENDO_SWITCH ) || defined( ANDROID ) || defined( __IPHONEOS__ ) || defined( __EMSCRIPTEN__ )
+    // These platforms are not able to launch another process of the game.
+    constexpr bool isMidiRenderingSupported{ false };
+#else
+    constexpr bool isMidiRenderingSupported{ true };
+#endif
+
+    const std::string_view midiRenderCommand{ "--render-midi" };
+
+    std::string quoteCommandArgument( const std::string & argument )
+    {
+        return '"' + argument + '"';
+    }
+
+    // Real-time MIDI synthesis is CPU-heavy on weak devices. MIDI tracks are rendered to WAV files once, and these files are played instead of
+    // MIDI tracks afterwards. Every track is rendered by a separate process of the game (see AudioManager::renderMidiTrack()) because SDL_mixer
+    // is able to synthesize MIDI only into the audio device which is already in use by this process. The rendering takes a lot of time, so
+    // it has its own worker thread in order not to delay the playback of sounds.
+    class MidiRenderManager final : public MultiThreading::AsyncManager
+    {
+    public:
+        void initialize( const std::string & programPath, const std::string & cacheDirectory, const ListFiles & soundFonts, const std::string & timidityCfgPath )
+        {
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
+            _programPath = programPath;
+            _cacheDirectory = cacheDirectory;
+            _soundFonts = soundFonts;
+            _timidityCfgPath = timidityCfgPath;
+        }
+
+        void reset()
+        {
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
+            _cacheDirectory.clear();
+            _renderTasks.clear();
+            _requestedTracks.clear();
+        }
+
+        // Returns the path to the rendered MIDI track if it is available, otherwise returns an empty string.
+        std::string getRenderedTrackPath( const int xmi )
+        {
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
+            if ( _cacheDirectory.empty() ) {
+                return {};
+            }
+
+            std::string filePath = getFilePath( xmi, ".wav" );
+            if ( !System::IsFile( filePath ) ) {
+                return {};
+            }
+
+            return filePath;
+        }
+
+        void pushRendering( const int xmi )
+        {
+            {
+                const std::scoped_lock<std::mutex> lock( _mutex );
+
+                if ( _cacheDirectory.empty() || !_requestedTracks.emplace( xmi ).second ) {
+                    return;
+                }
+            }
+
+            createWorker();
+
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
+            _renderTasks.emplace_back( xmi );
+
+            notifyWorker();
+        }
+
+    private:
+        std::string _programPath;
+        std::string _cacheDirectory;
+        ListFiles _soundFonts;
+        std::string _timidityCfgPath;
+
+        std::deque<int> _renderTasks;
+        // Every track is rendered at most once per game session even if the rendering fails.
+        std::set<int> _requestedTracks;
+
+        int _currentTrack{ XMI::UNKNOWN };
+        std::string _currentMidiFilePath;
+        std::string _currentWavFilePath;
+        std::string _currentCommand;
+
+        std::string getFilePath( const int xmi, const std::string_view extension ) const
+        {
+            return System::concatPath( _cacheDirectory, "midi_" + std::to_string( xmi ) ) + std::string( extension );
+        }
+
+        // This method is called by the worker thread and is protected by _mutex
+        bool prepareTask() override
+        {
+            if ( _renderTasks.empty() || _cacheDirectory.empty() ) {
+                _currentTrack = XMI::UNKNOWN;
+
+                return false;
+            }
+
+            _currentTrack = _renderTasks.front();
+            _renderTasks.pop_front();
+
+            _currentMidiFilePath = getFilePath( _currentTrack, ".mid" );
+            _currentWavFilePath = getFilePath( _currentTrack, ".wav" );
+
+            _currentCommand = quoteCommandArgument( _programPath ) + ' ' + std::string( midiRenderCommand ) + ' ' + quoteCommandArgument( _currentMidiFilePath ) + ' '
+                              + quoteCommandArgument( _currentWavFilePath ) + ' ' + quoteCommandArgument( _timidityCfgPath );
+
+            for ( const std::string & soundFont : _soundFonts ) {
+                _currentCommand += ' ' + quoteCommandArgument( soundFont );
+            }
+
+#if defined( _WIN32 )
+            // The command interpreter strips the outermost quotes.
+            _currentCommand = quoteCommandArgument( _currentCommand );
+#endif
+
+            return true;
+        }
+
+        // This method is called by the worker thread, but is not protected by _mutex
+        void executeTask() override
+        {
+            if ( _currentTrack == XMI::UNKNOWN || System::IsFile( _currentWavFilePath ) ) {
+                return;
+            }
+
+            std::vector<uint8_t> midi;
+
+            {
+                const std::scoped_lock<std::recursive_mutex> lock( g_asyncSoundManager.resourceMutex() );
+
+                midi = GetMID( _currentTrack );
+            }
+
+            if ( midi.empty() ) {
+                return;
+            }
+
+            {
+                StreamFile midiFile;
+                if ( !midiFile.open( _currentMidiFilePath, "wb" ) ) {
+                    ERROR_LOG( "Failed to create a file " << _currentMidiFilePath )
+                    return;
+                }
+
+                midiFile.putRaw( midi.data(), midi.size() );
+            }
+
+            const int result = std::system( _currentCommand.c_str() );
+
+            System::Unlink( _currentMidiFilePath );
+
+            if ( result != 0 ) {
+                ERROR_LOG( "Failed to render MIDI track " << XMI::GetString( _currentTrack ) << ", the exit code: " << result )
+
+                // Do not leave a partially written file.
+                System::Unlink( _currentWavFilePath );
+                return;
+            }
+
+            DEBUG_LOG( DBG_GAME, DBG_INFO, "Rendered MIDI track " << XMI::GetString( _currentTrack ) << " to " << _currentWavFilePath )
+        }
+    };
+
+    MidiRenderManager g_midiRenderManager;
+
+    // The rendered tracks depend on the synthesizer settings, so every set of SoundFonts and timidity.cfg has its own cache directory.
+    // The MIDI tracks themselves depend on the presence of the expansion, so this is also taken into account.
+    std::string getMidiRenderCacheDirectory( const ListFiles & soundFonts, const std::string & timidityCfgPath, const bool isExpansionAvailable )
+    {
+        std::ostringstream key;
+        key << isExpansionAvailable << ';' << timidityCfgPath;
+
+        for ( const std::string & soundFont : soundFonts ) {
+            uint64_t fileSize = 0;
+            int64_t modificationTime = 0;
+            System::GetFileStamp( soundFont, fileSize, modificationTime );
+
+            key << ';' << soundFont << ';' << fileSize << ';' << modificationTime;
+        }
+
+        const std::string keyString = key.str();
+        const uint32_t crc = fheroes2::calculateCRC32( reinterpret_cast<const uint8_t *>( keyString.data() ), keyString.size() );
+
+        const std::string dataDirectory = System::GetDataDirectory( "fheroes2" );
+        if ( dataDirectory.empty() ) {
+            return {};
+        }
+
+        std::ostringstream directoryName;
+        directoryName << std::hex << std::setw( 8 ) << std::setfill( '0' ) << crc;
+
+        return System::concatPath( System::concatPath( System::concatPath( dataDirectory, "files" ), "midi_cache" ), directoryName.str() );
+    }
+
     int PlaySoundImpl( const int m82 )
     {
         const std::scoped_lock<std::recursive_mutex> lock( g_asyncSoundManager.resourceMutex() );
@@ -518,7 +784,45 @@ namespace
             return -1;
         }
 
-        return Mixer::Play( v.data(), static_cast<uint32_t>( v.size() ), false );
+        // Spell sounds are more important than the sounds of creatures, which are more important than ambient sounds.
+        const Mixer::Priority priority = M82::isSpellSound( m82 ) ? Mixer::Priority::HIGH : Mixer::Priority::NORMAL;
+
+        return Mixer::Play( static_cast<uint64_t>( m82 ), v.data(), static_cast<uint32_t>( v.size() ), false, {}, priority );
+    }
+
+    void convertMIDImpl( const int xmi )
+    {
+        std::vector<uint8_t> body;
+
+        {
+            const std::scoped_lock<std::recursive_mutex> lock( g_asyncSoundManager.resourceMutex() );
+
+            const auto iter = MIDDataCache.find( xmi );
+            if ( iter != MIDDataCache.end() && !iter->second.empty() ) {
+                // This track has already been converted.
+                return;
+            }
+
+            body = getDataFromAggFile( XMI::GetString( xmi ), xmi >= XMI::MIDI_ORIGINAL_KNIGHT );
+        }
+
+        if ( body.empty() ) {
+            return;
+        }
+
+        std::vector<uint8_t> midi = Music::Xmi2Mid( body );
+        if ( midi.empty() ) {
+            return;
+        }
+
+        const std::scoped_lock<std::recursive_mutex> lock( g_asyncSoundManager.resourceMutex() );
+
+        std::vector<uint8_t> & v = MIDDataCache[xmi];
+        if ( v.empty() ) {
+            DEBUG_LOG( DBG_GAME, DBG_TRACE, "Converted MIDI track " << XMI::GetString( xmi ) << " in advance" )
+
+            v = std::move( midi );
+        }
     }
 
     uint64_t getMusicUID( const int trackId, const MusicSource musicType )
@@ -580,11 +884,24 @@ namespace
         }
 
         if ( XMI::UNKNOWN != xmi ) {
+            if ( const std::string filePath = g_midiRenderManager.getRenderedTrackPath( xmi ); !filePath.empty() ) {
+                Music::Play( musicUID, filePath, playbackMode );
+
+                currentMusicTrackId = trackId;
+
+                DEBUG_LOG( DBG_GAME, DBG_TRACE, "Play rendered MIDI music track " << XMI::GetString( xmi ) )
+
+                return;
+            }
+
             const std::vector<uint8_t> & v = GetMID( xmi );
             if ( !v.empty() ) {
                 Music::Play( musicUID, v, playbackMode );
 
                 currentMusicTrackId = trackId;
+
+                // The next time this track will be played from the rendered file.
+                g_midiRenderManager.pushRendering( xmi );
             }
         }
 
@@ -761,8 +1078,8 @@ namespace
 
                 assert( is3DAudioEnabled || effectInfo.angle == 0 );
 
-                const int channelId
-                    = Mixer::Play( audioData.data(), static_cast<uint32_t>( audioData.size() ), true, std::pair{ effectInfo.angle, effectInfo.distance } );
+                const int channelId = Mixer::Play( static_cast<uint64_t>( soundType ), audioData.data(), static_cast<uint32_t>( audioData.size() ), true,
+                                                   std::pair{ effectInfo.angle, effectInfo.distance }, Mixer::Priority::LOW );
                 if ( channelId < 0 ) {
                     // Unable to play this sound.
                     continue;
@@ -782,7 +1099,7 @@ namespace AudioManager
                                         const std::string & timidityCfgPath )
     {
         if ( Audio::isValid() ) {
-            Mixer::SetChannels( 32 );
+            Mixer::SetChannels( maxSoundChannels );
 
             // Some platforms (e.g. Linux) may have their own predefined soundfonts, don't overwrite them if we don't have our own
             if ( !midiSoundFonts.empty() ) {
@@ -808,16 +1125,42 @@ namespace AudioManager
         if ( !expansionAGGFilePath.empty() && !g_midiHeroes2xAGG.open( expansionAGGFilePath ) ) {
             VERBOSE_LOG( "Failed to open HEROES2X.AGG file for audio playback." )
         }
+
+        if constexpr ( isMidiRenderingSupported ) {
+            if ( Audio::isValid() && Settings::Get().isMidiRenderCacheEnabled() ) {
+                const std::string cacheDirectory = getMidiRenderCacheDirectory( midiSoundFonts, timidityCfgPath, g_midiHeroes2xAGG.isGood() );
+
+                if ( !cacheDirectory.empty() && ( System::IsDirectory( cacheDirectory ) || System::MakeDirectory( cacheDirectory ) ) ) {
+                    g_midiRenderManager.initialize( Settings::Get().getProgramPath(), cacheDirectory, midiSoundFonts, timidityCfgPath );
+                }
+                else {
+                    ERROR_LOG( "Failed to create the MIDI render cache directory " << cacheDirectory )
+                }
+            }
+        }
+
+        if ( Audio::isValid() ) {
+            // Convert all XMI tracks to MIDI in the background so that switching music tracks doesn't have to wait for it.
+            for ( int xmi = XMI::MIDI0002; xmi <= XMI::MIDI_ORIGINAL_NECROMANCER; ++xmi ) {
+                g_asyncSoundManager.pushMidiConversion( xmi );
+            }
+        }
     }
 
     AudioInitializer::~AudioInitializer()
     {
         g_asyncSoundManager.removeAllTasks();
+        g_asyncSoundManager.removeMidiConversionTasks();
         g_asyncSoundManager.stopWorker();
 
+        // The track being rendered at the moment is finished by the worker before it stops.
+        g_midiRenderManager.reset();
+        g_midiRenderManager.stopWorker();
+
         wavDataCache.clear();
         MIDDataCache.clear();
         currentAudioLoopEffects.clear();
+        lastRequestedAudioLoopEffects.reset();
     }
 
     MusicRestorer::MusicRestorer()
@@ -838,7 +1181,17 @@ namespace AudioManager
             return;
         }
 
-        g_asyncSoundManager.pushLoopSound( std::move( soundEffects ), Settings::Get().is3DAudioEnabled() );
+        const bool is3DAudioEnabled = Settings::Get().is3DAudioEnabled();
+
+        // The list of sounds is usually the same while the adventure map is being scrolled or a hero is moving within the same area.
+        // There is no need to pass the same list to the worker thread again, all the sounds from it are already playing.
+        if ( lastRequestedAudioLoopEffects && lastRequestedAudioLoopEffects->second == is3DAudioEnabled && lastRequestedAudioLoopEffects->first == soundEffects ) {
+            return;
+        }
+
+        lastRequestedAudioLoopEffects.emplace( soundEffects, is3DAudioEnabled );
+
+        g_asyncSoundManager.pushLoopSound( std::move( soundEffects ), is3DAudioEnabled );
     }
 
     int PlaySound( const int m82 )
@@ -869,6 +1222,28 @@ namespace AudioManager
         g_asyncSoundManager.pushSound( m82 );
     }
 
+    void preloadSounds( const std::vector<int> & m82List )
+    {
+        if ( !Audio::isValid() ) {
+            return;
+        }
+
+        const std::scoped_lock<std::recursive_mutex> lock( g_asyncSoundManager.resourceMutex() );
+
+        for ( const int m82 : m82List ) {
+            if ( m82 == M82::UNKNOWN ) {
+                continue;
+            }
+
+            const std::vector<uint8_t> & v = GetWAV( m82 );
+            if ( v.empty() ) {
+                continue;
+            }
+
+            Mixer::preload( static_cast<uint64_t>( m82 ), v.data(), static_cast<uint32_t>( v.size() ) );
+        }
+    }
+
     bool isExternalMusicFileAvailable( const int trackId )
     {
         return !getExternalMusicFile( trackId ).empty();
@@ -925,6 +1300,41 @@ namespace AudioManager
         PlayMusicImpl( trackId, Settings::Get().MusicType(), Music::PlaybackMode::RESUME_AND_PLAY_INFINITE );
     }
 
+    bool isMidiRenderCommand( const int argc, char ** argv )
+    {
+        return argc > 1 && std::string_view( argv[1] ) == midiRenderCommand;
+    }
+
+    int renderMidiTrack( const int argc, char ** argv )
+    {
+        assert( isMidiRenderCommand( argc, argv ) );
+
+        // The arguments are: the MIDI file, the resulting WAV file, the path to timidity.cfg (can be empty) and the list of SoundFonts.
+        if ( argc < 5 ) {
+            ERROR_LOG( "Not enough arguments to render a MIDI track." )
+            return EXIT_FAILURE;
+        }
+
+        std::vector<uint8_t> midi;
+
+        {
+            StreamFile midiFile;
+            if ( !midiFile.open( argv[2], "rb" ) ) {
+                ERROR_LOG( "Failed to open a file " << argv[2] )
+                return EXIT_FAILURE;
+            }
+
+            midi = midiFile.getRaw( 0 );
+        }
+
+        ListFiles soundFonts;
+        for ( int i = 5; i < argc; ++i ) {
+            soundFonts.emplace_back( argv[i] );
+        }
+
+        return Music::renderMidiToWav( midi, argv[3], soundFonts, argv[4] ) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
     void stopSounds()
     {
         if ( !Audio::isValid() ) {
@@ -933,6 +1343,8 @@ namespace AudioManager
 
         g_asyncSoundManager.removeAllSoundTasks();
 
+        lastRequestedAudioLoopEffects.reset();
+
         const std::scoped_lock<std::recursive_mutex> lock( g_asyncSoundManager.resourceMutex() );
 
         clearAllAudioLoopEffects();
@@ -948,6 +1360,8 @@ namespace AudioManager
 
         g_asyncSoundManager.removeAllTasks();
 
+        lastRequestedAudioLoopEffects.reset();
+
         const std::scoped_lock<std::recursive_mutex> lock( g_asyncSoundManager.resourceMutex() );
 
         clearAllAudioLoopEffects();
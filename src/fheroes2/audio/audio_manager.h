@@ -97,6 +97,9 @@ namespace AudioManager
     int PlaySound( const int m82 );
     void PlaySoundAsync( const int m82 );
 
+    // Loads and decodes the given sounds in advance, so that there is no delay when they are played for the first time.
+    void preloadSounds( const std::vector<int> & m82List );
+
     // Returns true if an external music file is available for the music track with the specified ID, otherwise returns false.
     bool isExternalMusicFileAvailable( const int trackId );
 
@@ -112,6 +115,13 @@ namespace AudioManager
     // TODO: the worker thread for playback) may be played.
     void PlayCurrentMusic();
 
+    // MIDI tracks are rendered to WAV files by separate processes of the game when the MIDI render cache is enabled.
+    // Returns true if the command line arguments belong to such a process.
+    bool isMidiRenderCommand( const int argc, char ** argv );
+
+    // Renders the MIDI track specified by the command line arguments, returns the exit code of the process.
+    int renderMidiTrack( const int argc, char ** argv );
+
     void stopSounds();
     void ResetAudio();
 }
@@ -25,6 +25,7 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <initializer_list>
 #include <map>
 #include <memory>
 #include <ostream>
@@ -52,6 +53,7 @@
 #include "logging.h"
 #include "monster.h"
 #include "monster_info.h"
+#include "network/state_hash.h"
 #include "players.h"
 #include "rand.h"
 #include "resource.h"
@@ -407,6 +409,14 @@ void Battle::Arena::ApplyAction( Command & cmd )
     default:
         break;
     }
+
+    for ( const Force * force : { _attackingArmy.get(), _defendingArmy.get() } ) {
+        for ( const Unit * unit : *force ) {
+            _stateHash = Network::mixHash( _stateHash ^ unit->getStateDigest() );
+        }
+    }
+
+    _unitTable.update( *_attackingArmy, *_defendingArmy );
 }
 
 void Battle::Arena::ApplyActionSpellCast( Command & cmd )
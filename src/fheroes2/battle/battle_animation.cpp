@@ -28,6 +28,15 @@
 #include "monster_anim.h"
 #include "rand.h"
 
+namespace
+{
+    const Bin_Info::MonsterAnimInfo & getEmptyMonsterInfo()
+    {
+        static const Bin_Info::MonsterAnimInfo info;
+        return info;
+    }
+}
+
 bool RandomizedDelay::checkDelay()
 {
     if ( !timerIsSet ) {
@@ -92,12 +101,13 @@ double AnimationSequence::movementProgress() const
 
 AnimationReference::AnimationReference( const int monsterID )
     : _monsterID( monsterID )
+    , _monsterInfo( &getEmptyMonsterInfo() )
 {
     if ( monsterID < Monster::PEASANT || monsterID > Monster::WATER_ELEMENT ) {
         return;
     }
 
-    _monsterInfo = Bin_Info::GetMonsterInfo( monsterID );
+    _monsterInfo = &Bin_Info::GetMonsterInfo( monsterID );
 
     // STATIC is our default
     // appendFrames inserts to vector so ref is still valid
@@ -114,7 +124,7 @@ AnimationReference::AnimationReference( const int monsterID )
     appendFrames( _death, Bin_Info::MonsterAnimInfo::DEATH );
 
     // Idle animations
-    for ( uint32_t idx = Bin_Info::MonsterAnimInfo::IDLE1; idx < _monsterInfo.idleAnimationCount + Bin_Info::MonsterAnimInfo::IDLE1; ++idx ) {
+    for ( uint32_t idx = Bin_Info::MonsterAnimInfo::IDLE1; idx < _monsterInfo->idleAnimationCount + Bin_Info::MonsterAnimInfo::IDLE1; ++idx ) {
         std::vector<int> idleAnim;
 
         if ( appendFrames( idleAnim, idx ) ) {
@@ -123,14 +133,12 @@ AnimationReference::AnimationReference( const int monsterID )
     }
 
     // Movement sequences
-    _offsetX = _monsterInfo.frameXOffset;
-
     // Every unit has MOVE_MAIN anim, use it as a base
     appendFrames( _moving, Bin_Info::MonsterAnimInfo::MOVE_TILE_START );
     appendFrames( _moving, Bin_Info::MonsterAnimInfo::MOVE_MAIN );
     appendFrames( _moving, Bin_Info::MonsterAnimInfo::MOVE_TILE_END );
 
-    if ( _monsterInfo.hasAnim( Bin_Info::MonsterAnimInfo::MOVE_ONE ) ) {
+    if ( _monsterInfo->hasAnim( Bin_Info::MonsterAnimInfo::MOVE_ONE ) ) {
         appendFrames( _moveOneTile, Bin_Info::MonsterAnimInfo::MOVE_ONE );
     }
     else {
@@ -166,7 +174,7 @@ AnimationReference::AnimationReference( const int monsterID )
     appendFrames( _melee[Monster_Info::BOTTOM].end, Bin_Info::MonsterAnimInfo::ATTACK3_END );
 
     // Use either shooting or breath attack animation as ranged
-    if ( _monsterInfo.hasAnim( Bin_Info::MonsterAnimInfo::SHOOT2 ) ) {
+    if ( _monsterInfo->hasAnim( Bin_Info::MonsterAnimInfo::SHOOT2 ) ) {
         appendFrames( _ranged[Monster_Info::TOP].start, Bin_Info::MonsterAnimInfo::SHOOT1 );
         appendFrames( _ranged[Monster_Info::TOP].end, Bin_Info::MonsterAnimInfo::SHOOT1_END );
 
@@ -176,7 +184,7 @@ AnimationReference::AnimationReference( const int monsterID )
         appendFrames( _ranged[Monster_Info::BOTTOM].start, Bin_Info::MonsterAnimInfo::SHOOT3 );
         appendFrames( _ranged[Monster_Info::BOTTOM].end, Bin_Info::MonsterAnimInfo::SHOOT3_END );
     }
-    else if ( _monsterInfo.hasAnim( Bin_Info::MonsterAnimInfo::DOUBLEHEX2 ) ) {
+    else if ( _monsterInfo->hasAnim( Bin_Info::MonsterAnimInfo::DOUBLEHEX2 ) ) {
         // Only 6 units should have this (in the original game)
         appendFrames( _ranged[Monster_Info::TOP].start, Bin_Info::MonsterAnimInfo::DOUBLEHEX1 );
         appendFrames( _ranged[Monster_Info::TOP].end, Bin_Info::MonsterAnimInfo::DOUBLEHEX1_END );
@@ -191,8 +199,8 @@ AnimationReference::AnimationReference( const int monsterID )
 
 bool AnimationReference::appendFrames( std::vector<int> & target, const size_t animID )
 {
-    if ( _monsterInfo.hasAnim( animID ) ) {
-        target.insert( target.end(), _monsterInfo.animationFrames[animID].begin(), _monsterInfo.animationFrames[animID].end() );
+    if ( _monsterInfo->hasAnim( animID ) ) {
+        target.insert( target.end(), _monsterInfo->animationFrames[animID].begin(), _monsterInfo->animationFrames[animID].end() );
         return true;
     }
 
@@ -207,11 +215,11 @@ const std::vector<int> & AnimationReference::getAnimationVector( const int animS
         return _static;
     case Monster_Info::IDLE:
         // Pick random animation
-        if ( !_idle.empty() && _idle.size() == _monsterInfo.idlePriority.size() ) {
+        if ( !_idle.empty() && _idle.size() == _monsterInfo->idlePriority.size() ) {
             Rand::Queue picker;
 
             for ( size_t i = 0; i < _idle.size(); ++i ) {
-                picker.Push( static_cast<int32_t>( i ), static_cast<uint32_t>( _monsterInfo.idlePriority[i] * 100 ) );
+                picker.Push( static_cast<int32_t>( i ), static_cast<uint32_t>( _monsterInfo->idlePriority[i] * 100 ) );
             }
             // picker is expected to return at least 0
             const size_t id = static_cast<size_t>( picker.Get() );
@@ -270,6 +278,8 @@ const std::vector<int> & AnimationReference::getAnimationVector( const int animS
 
 std::vector<int> AnimationReference::getAnimationOffset( const int animState ) const
 {
+    const std::vector<std::vector<int>> & offsetX = _monsterInfo->frameXOffset;
+
     std::vector<int> offset;
     switch ( animState ) {
     case Monster_Info::STAND_STILL:
@@ -280,24 +290,24 @@ std::vector<int> AnimationReference::getAnimationOffset( const int animState ) c
         offset.resize( _idle.front().size(), 0 );
         break;
     case Monster_Info::MOVE_START:
-        offset.insert( offset.end(), _offsetX[Bin_Info::MonsterAnimInfo::MOVE_START].begin(), _offsetX[Bin_Info::MonsterAnimInfo::MOVE_START].end() );
-        offset.insert( offset.end(), _offsetX[Bin_Info::MonsterAnimInfo::MOVE_MAIN].begin(), _offsetX[Bin_Info::MonsterAnimInfo::MOVE_MAIN].end() );
-        offset.insert( offset.end(), _offsetX[Bin_Info::MonsterAnimInfo::MOVE_TILE_END].begin(), _offsetX[Bin_Info::MonsterAnimInfo::MOVE_TILE_END].end() );
+        offset.insert( offset.end(), offsetX[Bin_Info::MonsterAnimInfo::MOVE_START].begin(), offsetX[Bin_Info::MonsterAnimInfo::MOVE_START].end() );
+        offset.insert( offset.end(), offsetX[Bin_Info::MonsterAnimInfo::MOVE_MAIN].begin(), offsetX[Bin_Info::MonsterAnimInfo::MOVE_MAIN].end() );
+        offset.insert( offset.end(), offsetX[Bin_Info::MonsterAnimInfo::MOVE_TILE_END].begin(), offsetX[Bin_Info::MonsterAnimInfo::MOVE_TILE_END].end() );
         break;
     case Monster_Info::MOVING:
-        offset.insert( offset.end(), _offsetX[Bin_Info::MonsterAnimInfo::MOVE_TILE_START].begin(), _offsetX[Bin_Info::MonsterAnimInfo::MOVE_TILE_START].end() );
-        offset.insert( offset.end(), _offsetX[Bin_Info::MonsterAnimInfo::MOVE_MAIN].begin(), _offsetX[Bin_Info::MonsterAnimInfo::MOVE_MAIN].end() );
-        offset.insert( offset.end(), _offsetX[Bin_Info::MonsterAnimInfo::MOVE_TILE_END].begin(), _offsetX[Bin_Info::MonsterAnimInfo::MOVE_TILE_END].end() );
+        offset.insert( offset.end(), offsetX[Bin_Info::MonsterAnimInfo::MOVE_TILE_START].begin(), offsetX[Bin_Info::MonsterAnimInfo::MOVE_TILE_START].end() );
+        offset.insert( offset.end(), offsetX[Bin_Info::MonsterAnimInfo::MOVE_MAIN].begin(), offsetX[Bin_Info::MonsterAnimInfo::MOVE_MAIN].end() );
+        offset.insert( offset.end(), offsetX[Bin_Info::MonsterAnimInfo::MOVE_TILE_END].begin(), offsetX[Bin_Info::MonsterAnimInfo::MOVE_TILE_END].end() );
         break;
     case Monster_Info::MOVE_END:
-        offset.insert( offset.end(), _offsetX[Bin_Info::MonsterAnimInfo::MOVE_TILE_START].begin(), _offsetX[Bin_Info::MonsterAnimInfo::MOVE_TILE_START].end() );
-        offset.insert( offset.end(), _offsetX[Bin_Info::MonsterAnimInfo::MOVE_MAIN].begin(), _offsetX[Bin_Info::MonsterAnimInfo::MOVE_MAIN].end() );
-        offset.insert( offset.end(), _offsetX[Bin_Info::MonsterAnimInfo::MOVE_STOP].begin(), _offsetX[Bin_Info::MonsterAnimInfo::MOVE_STOP].end() );
+        offset.insert( offset.end(), offsetX[Bin_Info::MonsterAnimInfo::MOVE_TILE_START].begin(), offsetX[Bin_Info::MonsterAnimInfo::MOVE_TILE_START].end() );
+        offset.insert( offset.end(), offsetX[Bin_Info::MonsterAnimInfo::MOVE_MAIN].begin(), offsetX[Bin_Info::MonsterAnimInfo::MOVE_MAIN].end() );
+        offset.insert( offset.end(), offsetX[Bin_Info::MonsterAnimInfo::MOVE_STOP].begin(), offsetX[Bin_Info::MonsterAnimInfo::MOVE_STOP].end() );
         break;
     case Monster_Info::MOVE_QUICK:
-        offset.insert( offset.end(), _offsetX[Bin_Info::MonsterAnimInfo::MOVE_START].begin(), _offsetX[Bin_Info::MonsterAnimInfo::MOVE_START].end() );
-        offset.insert( offset.end(), _offsetX[Bin_Info::MonsterAnimInfo::MOVE_MAIN].begin(), _offsetX[Bin_Info::MonsterAnimInfo::MOVE_MAIN].end() );
-        offset.insert( offset.end(), _offsetX[Bin_Info::MonsterAnimInfo::MOVE_STOP].begin(), _offsetX[Bin_Info::MonsterAnimInfo::MOVE_STOP].end() );
+        offset.insert( offset.end(), offsetX[Bin_Info::MonsterAnimInfo::MOVE_START].begin(), offsetX[Bin_Info::MonsterAnimInfo::MOVE_START].end() );
+        offset.insert( offset.end(), offsetX[Bin_Info::MonsterAnimInfo::MOVE_MAIN].begin(), offsetX[Bin_Info::MonsterAnimInfo::MOVE_MAIN].end() );
+        offset.insert( offset.end(), offsetX[Bin_Info::MonsterAnimInfo::MOVE_STOP].begin(), offsetX[Bin_Info::MonsterAnimInfo::MOVE_STOP].end() );
         break;
     case Monster_Info::FLY_UP:
         offset.resize( _flying.start.size(), 0 );
@@ -362,8 +372,8 @@ std::vector<int> AnimationReference::getAnimationOffset( const int animState ) c
 
 fheroes2::Point AnimationReference::getProjectileOffset( const size_t direction ) const
 {
-    if ( _monsterInfo.projectileOffset.size() > direction ) {
-        return _monsterInfo.projectileOffset[direction];
+    if ( _monsterInfo->projectileOffset.size() > direction ) {
+        return _monsterInfo->projectileOffset[direction];
     }
 
     return {};
@@ -453,23 +463,25 @@ int32_t AnimationState::getCurrentFrameXOffset() const
         return 0;
     }
 
+    const std::vector<std::vector<int>> & offsetX = _monsterInfo->frameXOffset;
+
     // The frame number of current subsequence start.
     size_t subequenceStart = 0;
     // The frame number in the full animation sequence, which include subsequences.
     const size_t currentFrame = _currentSequence.getCurrentFrameId();
 
-    // Get frame offset from _offsetX, analyzing in which subsequence it is.
+    // Get frame offset from offsetX, analyzing in which subsequence it is.
     for ( const int32_t animSubsequence : animSubsequences ) {
         // Get the current subsequence end (it is the frame number after the last subsequence frame).
-        const size_t subequenceEnd = _offsetX[animSubsequence].size() + subequenceStart;
+        const size_t subequenceEnd = offsetX[animSubsequence].size() + subequenceStart;
         if ( currentFrame < subequenceEnd ) {
-            return _offsetX[animSubsequence][currentFrame - subequenceStart];
+            return offsetX[animSubsequence][currentFrame - subequenceStart];
         }
         subequenceStart = subequenceEnd;
     }
 
     // If there is no horizontal offset data for currentFrame, return 0 as offset.
-    DEBUG_LOG( DBG_GAME, DBG_WARN, "Frame " << currentFrame << " is outside _offsetX [0 - " << subequenceStart << "] for animation state " << _animState )
+    DEBUG_LOG( DBG_GAME, DBG_WARN, "Frame " << currentFrame << " is outside offsetX [0 - " << subequenceStart << "] for animation state " << _animState )
 
     return 0;
 }
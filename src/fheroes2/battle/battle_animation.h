@@ -127,39 +127,39 @@ public:
 
     uint32_t getMoveSpeed() const
     {
-        return _monsterInfo.moveSpeed;
+        return _monsterInfo->moveSpeed;
     }
 
     uint32_t getFlightSpeed() const
     {
-        return _monsterInfo.flightSpeed;
+        return _monsterInfo->flightSpeed;
     }
 
     uint32_t getShootingSpeed() const
     {
-        return _monsterInfo.shootSpeed;
+        return _monsterInfo->shootSpeed;
     }
 
     fheroes2::Point getBlindOffset() const
     {
-        return _monsterInfo.eyePosition;
+        return _monsterInfo->eyePosition;
     }
 
     fheroes2::Point getProjectileOffset( const size_t direction ) const;
 
     int32_t getTroopCountOffset( const bool isReflect ) const
     {
-        return isReflect ? _monsterInfo.troopCountOffsetRight : _monsterInfo.troopCountOffsetLeft;
+        return isReflect ? _monsterInfo->troopCountOffsetRight : _monsterInfo->troopCountOffsetLeft;
     }
 
     uint32_t getIdleDelay() const
     {
-        return _monsterInfo.idleAnimationDelay;
+        return _monsterInfo->idleAnimationDelay;
     }
 
 protected:
     int _monsterID;
-    Bin_Info::MonsterAnimInfo _monsterInfo;
+    const Bin_Info::MonsterAnimInfo * _monsterInfo;
 
     std::vector<int> _static;
     std::vector<int> _moveFirstTile;
@@ -174,7 +174,6 @@ protected:
     MonsterReturnAnim _melee[3];
     MonsterReturnAnim _ranged[3];
     std::vector<std::vector<int>> _idle;
-    std::vector<std::vector<int>> _offsetX;
 
     bool appendFrames( std::vector<int> & target, const size_t animID );
 };
@@ -34,6 +34,7 @@
 #include <ostream>
 #include <type_traits>
 
+#include "agg_image.h"
 #include "ai_battle.h"
 #include "army.h"
 #include "army_troop.h"
@@ -166,89 +167,46 @@ namespace
         return covrs.empty() ? ICN::UNKNOWN : Rand::GetWithGen( covrs, gen );
     }
 
-    Battle::Unit * GetCurrentUnit( Battle::Units & attackingUnits, Battle::Units & defendingUnits, const bool attackingUnitsGoFirst, const bool ordersMode )
+    // Returns the position in the table of the unit which acts next according to the given speeds, or -1 if no unit can act. Units of the
+    // preferred army go first if the speeds are equal.
+    int32_t selectNextUnit( const Battle::UnitTable & table, const std::vector<uint32_t> & speeds, const bool attackingUnitsGoFirst )
     {
-        Battle::Unit * result = nullptr;
+        const int32_t attackingUnitIdx = table.getFastest( true, speeds );
+        const int32_t defendingUnitIdx = table.getFastest( false, speeds );
 
-        const auto unitFilter = []( const Battle::Unit * unit ) { return unit->GetSpeed() > Speed::STANDING; };
-
-        const Battle::Units::iterator attackingUnitsIter = std::find_if( attackingUnits.begin(), attackingUnits.end(), unitFilter );
-        const Battle::Units::iterator defendingUnitsIter = std::find_if( defendingUnits.begin(), defendingUnits.end(), unitFilter );
-
-        if ( attackingUnitsIter != attackingUnits.end() && defendingUnitsIter != defendingUnits.end() ) {
-            if ( ( *attackingUnitsIter )->GetSpeed() == ( *defendingUnitsIter )->GetSpeed() ) {
-                result = attackingUnitsGoFirst ? *attackingUnitsIter : *defendingUnitsIter;
-            }
-            else {
-                result = ( ( *attackingUnitsIter )->GetSpeed() > ( *defendingUnitsIter )->GetSpeed() ) ? *attackingUnitsIter : *defendingUnitsIter;
-            }
+        if ( attackingUnitIdx < 0 ) {
+            return defendingUnitIdx;
         }
-        else if ( attackingUnitsIter != attackingUnits.end() ) {
-            result = *attackingUnitsIter;
-        }
-        else if ( defendingUnitsIter != defendingUnits.end() ) {
-            result = *defendingUnitsIter;
+        if ( defendingUnitIdx < 0 ) {
+            return attackingUnitIdx;
         }
 
-        if ( result && ordersMode ) {
-            if ( attackingUnitsIter != attackingUnits.end() && result == *attackingUnitsIter ) {
-                attackingUnits.erase( attackingUnitsIter );
-            }
-            else if ( defendingUnitsIter != defendingUnits.end() && result == *defendingUnitsIter ) {
-                defendingUnits.erase( defendingUnitsIter );
-            }
+        const uint32_t attackingUnitSpeed = speeds[attackingUnitIdx];
+        const uint32_t defendingUnitSpeed = speeds[defendingUnitIdx];
+
+        if ( attackingUnitSpeed == defendingUnitSpeed ) {
+            return attackingUnitsGoFirst ? attackingUnitIdx : defendingUnitIdx;
         }
 
-        return result;
+        return attackingUnitSpeed > defendingUnitSpeed ? attackingUnitIdx : defendingUnitIdx;
     }
 
-    Battle::Unit * GetCurrentUnit( const Battle::Force & attackingArmy, const Battle::Force & defendingArmy, const PlayerColor preferredColor )
+    Battle::Unit * GetCurrentUnit( Battle::UnitTable & table, const Battle::Force & attackingArmy, const Battle::Force & defendingArmy,
+                                   const PlayerColor preferredColor )
     {
-        Battle::Units attackingUnits( attackingArmy.getUnits(), Battle::Units::REMOVE_INVALID_UNITS );
-        Battle::Units defendingUnits( defendingArmy.getUnits(), Battle::Units::REMOVE_INVALID_UNITS );
-
-        attackingUnits.SortFastest();
-        defendingUnits.SortFastest();
+        table.update( attackingArmy, defendingArmy );
 
-        Battle::Unit * result = GetCurrentUnit( attackingUnits, defendingUnits, preferredColor != defendingArmy.GetColor(), false );
-        if ( result == nullptr ) {
-            return result;
+        const int32_t unitIdx = selectNextUnit( table, table.speeds, preferredColor != defendingArmy.GetColor() );
+        if ( unitIdx < 0 ) {
+            return nullptr;
         }
 
+        Battle::Unit * result = table.units[unitIdx];
         assert( result->isValid() );
 
         return result;
     }
 
-    void UpdateOrderOfUnits( const Battle::Force & attackingArmy, const Battle::Force & defendingArmy, const Battle::Unit * currentUnit, PlayerColor preferredColor,
-                             const Battle::Units & orderHistory, Battle::Units & orderOfUnits )
-    {
-        orderOfUnits.assign( orderHistory.begin(), orderHistory.end() );
-
-        Battle::Units attackingUnits( attackingArmy.getUnits(), Battle::Units::REMOVE_INVALID_UNITS );
-        Battle::Units defendingUnits( defendingArmy.getUnits(), Battle::Units::REMOVE_INVALID_UNITS );
-
-        attackingUnits.SortFastest();
-        defendingUnits.SortFastest();
-
-        while ( true ) {
-            Battle::Unit * unit = GetCurrentUnit( attackingUnits, defendingUnits, preferredColor != defendingArmy.GetColor(), true );
-            if ( unit == nullptr ) {
-                break;
-            }
-
-            assert( unit->isValid() );
-
-            if ( unit == currentUnit ) {
-                continue;
-            }
-
-            preferredColor = ( unit->GetArmyColor() == attackingArmy.GetColor() ) ? defendingArmy.GetColor() : attackingArmy.GetColor();
-
-            orderOfUnits.push_back( unit );
-        }
-    }
-
     size_t getPositionOfCastleDefenseStructure( const Battle::CastleDefenseStructure structure )
     {
         switch ( structure ) {
@@ -362,6 +320,9 @@ Battle::Arena::Arena( Army & attackingArmy, Army & defendingArmy, const int32_t
     }
 
     if ( isShowInterface ) {
+        // Decode the battlefield images while the interface is being prepared.
+        fheroes2::AGG::prefetchICNs( Interface::getIcnManifest( tileIndex, *_attackingArmy, *_defendingArmy ) );
+
         _interface = std::make_unique<Interface>( *this, tileIndex );
         board.SetArea( _interface->GetArea() );
 
@@ -471,11 +432,14 @@ void Battle::Arena::UnitTurn( const Units & orderHistory )
 
     bool endOfTurn = false;
 
+    // The same buffer is reused for all the iterations to avoid reallocating it for every action of the unit
+    Actions actions;
+
     while ( !endOfTurn ) {
         // There should be no dead units on the board at the beginning of each iteration
         assert( std::all_of( board.begin(), board.end(), []( const Cell & cell ) { return ( cell.GetUnit() == nullptr || cell.GetUnit()->isValid() ); } ) );
 
-        Actions actions;
+        actions.clear();
 
         if ( _interface ) {
             _interface->getPendingActions( actions );
@@ -518,15 +482,15 @@ void Battle::Arena::UnitTurn( const Units & orderHistory )
                                                     []( const uint64_t stream, const Command & cmd ) { return cmd.updatePCG32Stream( stream ); } );
         _randomGenerator.setStream( newStream );
 
-        while ( !actions.empty() ) {
-            ApplyAction( actions.front() );
-            actions.pop_front();
+        // New actions can be appended during the iteration, so the elements are accessed by index
+        for ( size_t i = 0; i < actions.size(); ++i ) {
+            ApplyAction( actions[i] );
 
             board.removeDeadUnits();
 
             if ( _orderOfUnits ) {
                 // Applied action could kill someone or affect the speed of some unit, update the order of units
-                UpdateOrderOfUnits( *_attackingArmy, *_defendingArmy, _currentUnit, GetOppositeColor( _currentUnit->GetArmyColor() ), orderHistory, *_orderOfUnits );
+                updateOrderOfUnits( _currentUnit, GetOppositeColor( _currentUnit->GetArmyColor() ), orderHistory, true );
             }
 
             if ( !BattleValid() ) {
@@ -544,6 +508,60 @@ void Battle::Arena::UnitTurn( const Units & orderHistory )
     }
 }
 
+void Battle::Arena::updateOrderOfUnits( const Unit * currentUnit, const PlayerColor preferredColor, const Units & orderHistory, const bool refreshUnitTable )
+{
+    assert( _orderOfUnits );
+
+    if ( refreshUnitTable ) {
+        _unitTable.update( *_attackingArmy, *_defendingArmy );
+    }
+
+    OrderOfUnitsParameters & params = _orderOfUnitsParameters;
+
+    if ( params.currentUnit == currentUnit && params.preferredColor == preferredColor && params.units == _unitTable.units && params.speeds == _unitTable.speeds
+         && params.history.size() == orderHistory.size() && std::equal( orderHistory.begin(), orderHistory.end(), params.history.begin() ) ) {
+        // Nothing that affects the order of units has changed
+        return;
+    }
+
+    params.units = _unitTable.units;
+    params.speeds = _unitTable.speeds;
+    params.history.assign( orderHistory.begin(), orderHistory.end() );
+    params.currentUnit = currentUnit;
+    params.preferredColor = preferredColor;
+
+    Units & orderOfUnits = *_orderOfUnits;
+    orderOfUnits.assign( orderHistory.begin(), orderHistory.end() );
+
+    const PlayerColor attackingArmyColor = _attackingArmy->GetColor();
+    const PlayerColor defendingArmyColor = _defendingArmy->GetColor();
+
+    // Units already put in the queue are excluded by marking them as standing
+    std::vector<uint32_t> speeds( _unitTable.speeds );
+
+    PlayerColor nextPreferredColor = preferredColor;
+
+    while ( true ) {
+        const int32_t unitIdx = selectNextUnit( _unitTable, speeds, nextPreferredColor != defendingArmyColor );
+        if ( unitIdx < 0 ) {
+            break;
+        }
+
+        speeds[unitIdx] = Speed::STANDING;
+
+        Unit * unit = _unitTable.units[unitIdx];
+        assert( unit->isValid() );
+
+        if ( unit == currentUnit ) {
+            continue;
+        }
+
+        nextPreferredColor = _unitTable.isAttacker[unitIdx] ? defendingArmyColor : attackingArmyColor;
+
+        orderOfUnits.push_back( unit );
+    }
+}
+
 bool Battle::Arena::BattleValid() const
 {
     return _attackingArmy->isValid() && _defendingArmy->isValid() && 0 == _battleResult.attacker && 0 == _battleResult.defender;
@@ -569,7 +587,7 @@ void Battle::Arena::Turns()
         orderHistory.reserve( 25 );
 
         // Build the initial order of units
-        UpdateOrderOfUnits( *_attackingArmy, *_defendingArmy, nullptr, GetOppositeColor( _lastActiveUnitArmyColor ), orderHistory, *_orderOfUnits );
+        updateOrderOfUnits( nullptr, GetOppositeColor( _lastActiveUnitArmyColor ), orderHistory, true );
     }
 
     {
@@ -578,7 +596,7 @@ void Battle::Arena::Turns()
 
         while ( BattleValid() ) {
             // We can get the nullptr here if there are no units left waiting for their turn
-            _currentUnit = GetCurrentUnit( *_attackingArmy, *_defendingArmy, GetOppositeColor( _lastActiveUnitArmyColor ) );
+            _currentUnit = GetCurrentUnit( _unitTable, *_attackingArmy, *_defendingArmy, GetOppositeColor( _lastActiveUnitArmyColor ) );
 
             if ( _orderOfUnits ) {
                 // Add unit to the history
@@ -586,9 +604,8 @@ void Battle::Arena::Turns()
                     orderHistory.push_back( _currentUnit );
                 }
 
-                // Update the order of units
-                UpdateOrderOfUnits( *_attackingArmy, *_defendingArmy, _currentUnit,
-                                    GetOppositeColor( _currentUnit ? _currentUnit->GetArmyColor() : _lastActiveUnitArmyColor ), orderHistory, *_orderOfUnits );
+                // Update the order of units, the unit table has just been updated while selecting the current unit
+                updateOrderOfUnits( _currentUnit, GetOppositeColor( _currentUnit ? _currentUnit->GetArmyColor() : _lastActiveUnitArmyColor ), orderHistory, false );
             }
 
             if ( castle ) {
@@ -614,9 +631,8 @@ void Battle::Arena::Turns()
 
                         if ( _orderOfUnits ) {
                             // Tower could kill someone, update the order of units
-                            UpdateOrderOfUnits( *_attackingArmy, *_defendingArmy, _currentUnit,
-                                                GetOppositeColor( _currentUnit ? _currentUnit->GetArmyColor() : _lastActiveUnitArmyColor ), orderHistory,
-                                                *_orderOfUnits );
+                            updateOrderOfUnits( _currentUnit, GetOppositeColor( _currentUnit ? _currentUnit->GetArmyColor() : _lastActiveUnitArmyColor ),
+                                                orderHistory, true );
                         }
                     };
 
@@ -909,6 +925,35 @@ bool Battle::Arena::CanRetreatOpponent( const PlayerColor color ) const
     return hero && hero->isHeroes() && ( color == _attackingArmy->GetColor() || hero->inCastle() == nullptr );
 }
 
+bool Battle::Arena::isSpellApplicable( const Unit & unit, const Spell & spell, const HeroBase * commander ) const
+{
+    const uint32_t currentUnitUID = _currentUnit == nullptr ? 0 : _currentUnit->GetUID();
+
+    // Spell durations are decreased at the beginning of each turn without applying any action, so the turn number should be checked as well
+    if ( _spellApplicabilityCommander != commander || _spellApplicabilityStateHash != _stateHash || _spellApplicabilityTurnNumber != _turnNumber
+         || _spellApplicabilityUnitUID != currentUnitUID ) {
+        std::fill( _spellApplicability.begin(), _spellApplicability.end(), static_cast<uint8_t>( 0 ) );
+
+        _spellApplicabilityCommander = commander;
+        _spellApplicabilityStateHash = _stateHash;
+        _spellApplicabilityTurnNumber = _turnNumber;
+        _spellApplicabilityUnitUID = currentUnitUID;
+    }
+
+    const size_t index = static_cast<size_t>( unit.GetUID() ) * Spell::SPELL_COUNT + static_cast<size_t>( spell.GetID() );
+    if ( index >= _spellApplicability.size() ) {
+        // Unit UIDs are small sequential numbers, so the table only grows when new units (elementals, mirror images) appear.
+        _spellApplicability.resize( ( static_cast<size_t>( unit.GetUID() ) + 1 ) * Spell::SPELL_COUNT, 0 );
+    }
+
+    uint8_t & result = _spellApplicability[index];
+    if ( result == 0 ) {
+        result = unit.AllowApplySpell( spell, commander ) ? 2 : 1;
+    }
+
+    return result == 2;
+}
+
 bool Battle::Arena::isSpellcastDisabled() const
 {
     const HeroBase * attackingHero = _attackingArmy->GetCommander();
@@ -25,7 +25,6 @@
 
 #include <array>
 #include <cstdint>
-#include <list>
 #include <memory>
 #include <string>
 #include <utility>
@@ -37,6 +36,7 @@
 #include "battle_command.h"
 #include "battle_grave.h"
 #include "battle_pathfinding.h"
+#include "battle_unit_table.h"
 #include "color.h"
 #include "icn.h"
 #include "spell.h"
@@ -71,7 +71,7 @@ namespace Battle
         EarthquakeSpell
     };
 
-    class Actions : public std::list<Command>
+    class Actions : public std::vector<Command>
     {};
 
     class TroopsUidGenerator
@@ -115,6 +115,19 @@ namespace Battle
             return _turnNumber;
         }
 
+        // Returns the hash of the unit state after all actions applied so far. It changes after every action which affects any unit,
+        // so it can be used to invalidate cached data that depends on the state of the battlefield.
+        uint64_t getStateHash() const
+        {
+            return _stateHash;
+        }
+
+        // Simulation-relevant state of all units as of the last applied action or the last update of the unit turn order.
+        const UnitTable & getUnitTable() const
+        {
+            return _unitTable;
+        }
+
         Result & GetResult()
         {
             return _battleResult;
@@ -212,6 +225,11 @@ namespace Battle
             return GetTargetsForSpell( hero, spell, dst, false, nullptr );
         }
 
+        // Returns the same as 'unit.AllowApplySpell( spell, commander )'. Results are memoized for the current unit turn until the state of the
+        // battle changes, so the spell casting UI and the AI may query every spell against every unit without evaluating the rules each time.
+        // It must not be used while an action is being applied, as the units are modified at that time.
+        bool isSpellApplicable( const Unit & unit, const Spell & spell, const HeroBase * commander ) const;
+
         bool isSpellcastDisabled() const;
         bool isDisableCastSpell( const Spell & spell, std::string * msg = nullptr ) const;
 
@@ -276,6 +294,11 @@ namespace Battle
     private:
         void UnitTurn( const Units & orderHistory );
 
+        // Updates the order of units displayed by the interface, the units from 'orderHistory' are put first. The order is recalculated
+        // only if the speed of some unit, the set of units or the other parameters have changed since the previous update. If the unit
+        // table has just been updated by the caller, then 'refreshUnitTable' can be set to false to avoid updating it again.
+        void updateOrderOfUnits( const Unit * currentUnit, const PlayerColor preferredColor, const Units & orderHistory, const bool refreshUnitTable );
+
         void TowerAction( const Tower & );
         void CatapultAction();
 
@@ -334,6 +357,18 @@ namespace Battle
         std::unique_ptr<Force> _defendingArmy;
         std::shared_ptr<Units> _orderOfUnits;
 
+        // Parameters for which '_orderOfUnits' was calculated the last time, see updateOrderOfUnits()
+        struct OrderOfUnitsParameters
+        {
+            std::vector<Unit *> units;
+            std::vector<uint32_t> speeds;
+            std::vector<Unit *> history;
+            const Unit * currentUnit{ nullptr };
+            PlayerColor preferredColor{ PlayerColor::NONE };
+        };
+
+        OrderOfUnitsParameters _orderOfUnitsParameters;
+
         // The unit that is currently active. Please note that some battle actions (e.g. catapult or castle tower shots) can be performed without an active unit.
         Unit * _currentUnit{ nullptr };
 
@@ -360,6 +395,7 @@ namespace Battle
         int _covrIcnId{ ICN::UNKNOWN };
 
         uint32_t _turnNumber{ 0 };
+        uint64_t _stateHash{ 0 };
         // A set of colors of players for whom the auto combat mode is enabled
         PlayerColorsSet _autoCombatColors{ 0 };
 
@@ -372,6 +408,16 @@ namespace Battle
 
         TroopsUidGenerator _uidGenerator;
 
+        UnitTable _unitTable;
+
+        // Results of Unit::AllowApplySpell() indexed by unit UID and spell ID: 0 - not evaluated yet, 1 - not applicable, 2 - applicable.
+        // The cache is valid for a single commander, the turn number, the current unit and the state hash it was filled in for.
+        mutable std::vector<uint8_t> _spellApplicability;
+        mutable const HeroBase * _spellApplicabilityCommander{ nullptr };
+        mutable uint64_t _spellApplicabilityStateHash{ 0 };
+        mutable uint32_t _spellApplicabilityTurnNumber{ 0 };
+        mutable uint32_t _spellApplicabilityUnitUID{ 0 };
+
         enum
         {
             CHAIN_LIGHTNING_CREATURE_COUNT = 4
@@ -46,6 +46,158 @@
 
 namespace
 {
+    constexpr int32_t boardWidth{ Battle::Board::widthInCells };
+    constexpr int32_t boardHeight{ Battle::Board::heightInCells };
+    constexpr int32_t boardSize{ Battle::Board::sizeInCells };
+
+    // Basic cell directions in the order of their bits.
+    constexpr std::array<Battle::CellDirection, 6> basicCellDirections{ Battle::CellDirection::TOP_LEFT,     Battle::CellDirection::TOP_RIGHT,
+                                                                        Battle::CellDirection::RIGHT,        Battle::CellDirection::BOTTOM_RIGHT,
+                                                                        Battle::CellDirection::BOTTOM_LEFT, Battle::CellDirection::LEFT };
+
+    // Returns the position of the direction in 'basicCellDirections' or -1 if it is not a basic one.
+    constexpr int getBasicCellDirectionIndex( const Battle::CellDirection dir )
+    {
+        switch ( dir ) {
+        case Battle::CellDirection::TOP_LEFT:
+            return 0;
+        case Battle::CellDirection::TOP_RIGHT:
+            return 1;
+        case Battle::CellDirection::RIGHT:
+            return 2;
+        case Battle::CellDirection::BOTTOM_RIGHT:
+            return 3;
+        case Battle::CellDirection::BOTTOM_LEFT:
+            return 4;
+        case Battle::CellDirection::LEFT:
+            return 5;
+        default:
+            break;
+        }
+
+        return -1;
+    }
+
+    // The board is a fixed hex grid, so all the relations between its cells are calculated once at compile time.
+    struct BoardGeometry
+    {
+        // Index of the adjacent cell in every basic direction. It is the result of the plain index arithmetic, so it makes sense
+        // only if the cell actually has a neighbour in this direction, see 'validDirections'.
+        std::array<std::array<int8_t, basicCellDirections.size()>, boardSize> neighbours{};
+        // Bitmask of the basic directions in which the cell has a neighbour.
+        std::array<uint8_t, boardSize> validDirections{};
+        // Direction from the first cell to the second one, UNKNOWN if the cells are not adjacent.
+        std::array<std::array<uint8_t, boardSize>, boardSize> directions{};
+        std::array<std::array<uint8_t, boardSize>, boardSize> distances{};
+        // Cells around every cell for each area radius, the center cell is included.
+        std::array<std::array<Battle::CellMask, boardSize>, Battle::Board::maxAreaRadius + 1> areas{};
+    };
+
+    constexpr int32_t calculateAbs( const int32_t value )
+    {
+        return value < 0 ? -value : value;
+    }
+
+    constexpr bool calculateIsValidDirection( const int32_t index, const Battle::CellDirection dir )
+    {
+        const int32_t x = index % boardWidth;
+        const int32_t y = index / boardWidth;
+
+        switch ( dir ) {
+        case Battle::CellDirection::TOP_LEFT:
+            return !( 0 == y || ( 0 == x && ( y % 2 ) ) );
+        case Battle::CellDirection::TOP_RIGHT:
+            return !( 0 == y || ( ( boardWidth - 1 ) == x && !( y % 2 ) ) );
+        case Battle::CellDirection::LEFT:
+            return !( 0 == x );
+        case Battle::CellDirection::RIGHT:
+            return !( ( boardWidth - 1 ) == x );
+        case Battle::CellDirection::BOTTOM_LEFT:
+            return !( ( boardHeight - 1 ) == y || ( 0 == x && ( y % 2 ) ) );
+        case Battle::CellDirection::BOTTOM_RIGHT:
+            return !( ( boardHeight - 1 ) == y || ( ( boardWidth - 1 ) == x && !( y % 2 ) ) );
+        default:
+            break;
+        }
+
+        return false;
+    }
+
+    constexpr int32_t calculateIndexDirection( const int32_t index, const Battle::CellDirection dir )
+    {
+        switch ( dir ) {
+        case Battle::CellDirection::TOP_LEFT:
+            return index - ( ( ( index / boardWidth ) % 2 ) ? boardWidth + 1 : boardWidth );
+        case Battle::CellDirection::TOP_RIGHT:
+            return index - ( ( ( index / boardWidth ) % 2 ) ? boardWidth : boardWidth - 1 );
+        case Battle::CellDirection::LEFT:
+            return index - 1;
+        case Battle::CellDirection::RIGHT:
+            return index + 1;
+        case Battle::CellDirection::BOTTOM_LEFT:
+            return index + ( ( ( index / boardWidth ) % 2 ) ? boardWidth - 1 : boardWidth );
+        case Battle::CellDirection::BOTTOM_RIGHT:
+            return index + ( ( ( index / boardWidth ) % 2 ) ? boardWidth : boardWidth + 1 );
+        default:
+            break;
+        }
+
+        return -1;
+    }
+
+    constexpr uint32_t calculateDistance( const int32_t index1, const int32_t index2 )
+    {
+        const int32_t x1 = index1 % boardWidth;
+        const int32_t y1 = index1 / boardWidth;
+
+        const int32_t x2 = index2 % boardWidth;
+        const int32_t y2 = index2 / boardWidth;
+
+        const int32_t du = y2 - y1;
+        const int32_t dv = ( x2 + y2 / 2 ) - ( x1 + y1 / 2 );
+
+        if ( ( du >= 0 && dv >= 0 ) || ( du < 0 && dv < 0 ) ) {
+            return static_cast<uint32_t>( std::max( calculateAbs( du ), calculateAbs( dv ) ) );
+        }
+
+        return static_cast<uint32_t>( calculateAbs( du ) + calculateAbs( dv ) );
+    }
+
+    constexpr BoardGeometry calculateBoardGeometry()
+    {
+        BoardGeometry geometry;
+
+        for ( int32_t index = 0; index < boardSize; ++index ) {
+            for ( size_t i = 0; i < basicCellDirections.size(); ++i ) {
+                const Battle::CellDirection dir = basicCellDirections[i];
+                const int32_t neighbourIndex = calculateIndexDirection( index, dir );
+
+                geometry.neighbours[index][i] = static_cast<int8_t>( neighbourIndex );
+
+                if ( calculateIsValidDirection( index, dir ) ) {
+                    geometry.validDirections[index] = static_cast<uint8_t>( geometry.validDirections[index] | static_cast<uint8_t>( dir ) );
+                    geometry.directions[index][neighbourIndex] = static_cast<uint8_t>( dir );
+                }
+            }
+
+            geometry.directions[index][index] = static_cast<uint8_t>( Battle::CellDirection::CENTER );
+
+            for ( int32_t otherIndex = 0; otherIndex < boardSize; ++otherIndex ) {
+                const uint32_t distance = calculateDistance( index, otherIndex );
+
+                geometry.distances[index][otherIndex] = static_cast<uint8_t>( distance );
+
+                for ( uint32_t radius = distance; radius <= Battle::Board::maxAreaRadius; ++radius ) {
+                    geometry.areas[radius][index].set( otherIndex );
+                }
+            }
+        }
+
+        return geometry;
+    }
+
+    constexpr BoardGeometry boardGeometry{ calculateBoardGeometry() };
+
     uint32_t GetRandomObstaclePosition( Rand::PCG32 & gen )
     {
         return Rand::GetWithGen( 2, 8, gen ) + ( 11 * Rand::GetWithGen( 0, 8, gen ) );
@@ -127,20 +279,7 @@ uint32_t Battle::Board::GetDistance( const int32_t index1, const int32_t index2
         return 0;
     }
 
-    const int32_t x1 = index1 % widthInCells;
-    const int32_t y1 = index1 / widthInCells;
-
-    const int32_t x2 = index2 % widthInCells;
-    const int32_t y2 = index2 / widthInCells;
-
-    const int32_t du = y2 - y1;
-    const int32_t dv = ( x2 + y2 / 2 ) - ( x1 + y1 / 2 );
-
-    if ( ( du >= 0 && dv >= 0 ) || ( du < 0 && dv < 0 ) ) {
-        return std::max( std::abs( du ), std::abs( dv ) );
-    }
-
-    return std::abs( du ) + std::abs( dv );
+    return boardGeometry.distances[index1][index2];
 }
 
 uint32_t Battle::Board::GetDistance( const Position & pos1, const Position & pos2 )
@@ -225,17 +364,7 @@ Battle::CellDirection Battle::Board::GetDirection( const int32_t index1, const i
         return CellDirection::UNKNOWN;
     }
 
-    if ( index1 == index2 ) {
-        return CellDirection::CENTER;
-    }
-
-    for ( CellDirection dir = CellDirection::TOP_LEFT; dir < CellDirection::CENTER; ++dir ) {
-        if ( isValidDirection( index1, dir ) && index2 == GetIndexDirection( index1, dir ) ) {
-            return dir;
-        }
-    }
-
-    return CellDirection::UNKNOWN;
+    return static_cast<CellDirection>( boardGeometry.directions[index1][index2] );
 }
 
 Battle::CellDirection Battle::Board::GetReflectDirection( const CellDirection dir )
@@ -279,27 +408,11 @@ bool Battle::Board::isValidDirection( const int32_t index, const CellDirection d
         return true;
     }
 
-    const int32_t x = index % widthInCells;
-    const int32_t y = index / widthInCells;
-
-    switch ( dir ) {
-    case CellDirection::TOP_LEFT:
-        return !( 0 == y || ( 0 == x && ( y % 2 ) ) );
-    case CellDirection::TOP_RIGHT:
-        return !( 0 == y || ( ( widthInCells - 1 ) == x && !( y % 2 ) ) );
-    case CellDirection::LEFT:
-        return !( 0 == x );
-    case CellDirection::RIGHT:
-        return !( ( widthInCells - 1 ) == x );
-    case CellDirection::BOTTOM_LEFT:
-        return !( ( heightInCells - 1 ) == y || ( 0 == x && ( y % 2 ) ) );
-    case CellDirection::BOTTOM_RIGHT:
-        return !( ( heightInCells - 1 ) == y || ( ( widthInCells - 1 ) == x && !( y % 2 ) ) );
-    default:
-        break;
+    if ( getBasicCellDirectionIndex( dir ) < 0 ) {
+        return false;
     }
 
-    return false;
+    return ( boardGeometry.validDirections[index] & static_cast<uint8_t>( dir ) ) != 0;
 }
 
 int32_t Battle::Board::GetIndexDirection( const int32_t index, const CellDirection dir )
@@ -308,26 +421,16 @@ int32_t Battle::Board::GetIndexDirection( const int32_t index, const CellDirecti
         return -1;
     }
 
-    switch ( dir ) {
-    case CellDirection::CENTER:
+    if ( dir == CellDirection::CENTER ) {
         return index;
-    case CellDirection::TOP_LEFT:
-        return index - ( ( ( index / widthInCells ) % 2 ) ? widthInCells + 1 : widthInCells );
-    case CellDirection::TOP_RIGHT:
-        return index - ( ( ( index / widthInCells ) % 2 ) ? widthInCells : widthInCells - 1 );
-    case CellDirection::LEFT:
-        return index - 1;
-    case CellDirection::RIGHT:
-        return index + 1;
-    case CellDirection::BOTTOM_LEFT:
-        return index + ( ( ( index / widthInCells ) % 2 ) ? widthInCells - 1 : widthInCells );
-    case CellDirection::BOTTOM_RIGHT:
-        return index + ( ( ( index / widthInCells ) % 2 ) ? widthInCells : widthInCells + 1 );
-    default:
-        break;
     }
 
-    return -1;
+    const int dirIndex = getBasicCellDirectionIndex( dir );
+    if ( dirIndex < 0 ) {
+        return -1;
+    }
+
+    return boardGeometry.neighbours[index][dirIndex];
 }
 
 int32_t Battle::Board::GetIndexAbsPosition( const fheroes2::Point & pt ) const
@@ -878,6 +981,17 @@ Battle::Indexes Battle::Board::GetDistanceIndexes( const int32_t center, const u
     return result;
 }
 
+Battle::CellMask Battle::Board::GetDistanceMask( const int32_t center, const uint32_t radius )
+{
+    assert( radius <= maxAreaRadius );
+
+    if ( !isValidIndex( center ) ) {
+        return {};
+    }
+
+    return boardGeometry.areas[std::min( radius, maxAreaRadius )][center];
+}
+
 Battle::Indexes Battle::Board::GetDistanceIndexes( const Position & pos, const uint32_t radius )
 {
     const std::array<int32_t, 2> posIndexes = { pos.GetHead() ? pos.GetHead()->GetIndex() : -1, pos.GetTail() ? pos.GetTail()->GetIndex() : -1 };
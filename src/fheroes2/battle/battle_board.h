@@ -24,6 +24,8 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -65,6 +67,57 @@ namespace Battle
 
     using Indexes = std::vector<int32_t>;
 
+    // Set of the battlefield cells, one bit per cell index.
+    class CellMask
+    {
+    public:
+        constexpr CellMask() = default;
+
+        constexpr void set( const int32_t index )
+        {
+            _bits[index / 64] |= uint64_t{ 1 } << ( index % 64 );
+        }
+
+        constexpr void reset( const int32_t index )
+        {
+            _bits[index / 64] &= ~( uint64_t{ 1 } << ( index % 64 ) );
+        }
+
+        constexpr bool test( const int32_t index ) const
+        {
+            return ( ( _bits[index / 64] >> ( index % 64 ) ) & 1 ) != 0;
+        }
+
+        constexpr CellMask operator&( const CellMask & other ) const
+        {
+            CellMask result;
+
+            for ( size_t i = 0; i < _bits.size(); ++i ) {
+                result._bits[i] = _bits[i] & other._bits[i];
+            }
+
+            return result;
+        }
+
+        // Calls the given function for every cell index in the set in ascending order.
+        template <typename Func>
+        void forEach( const Func & func ) const
+        {
+            for ( size_t i = 0; i < _bits.size(); ++i ) {
+                int32_t index = static_cast<int32_t>( i * 64 );
+
+                for ( uint64_t bits = _bits[i]; bits != 0; bits >>= 1, ++index ) {
+                    if ( bits & 1 ) {
+                        func( index );
+                    }
+                }
+            }
+        }
+
+    private:
+        std::array<uint64_t, 2> _bits{};
+    };
+
     class Board : public std::vector<Cell>
     {
     public:
@@ -74,6 +127,8 @@ namespace Battle
         static constexpr int heightInCells{ 9 };
         // Total number of cells on the battlefield
         static constexpr int sizeInCells{ widthInCells * heightInCells };
+        // The largest radius of the area of effect spells
+        static constexpr uint32_t maxAreaRadius{ 2 };
 
         Board();
         Board( const Board & ) = delete;
@@ -134,6 +189,9 @@ namespace Battle
         static int32_t GetIndexDirection( const int32_t index, const CellDirection dir );
 
         static Indexes GetDistanceIndexes( const int32_t center, const uint32_t radius );
+        // Returns the mask of the cells located no further than 'radius' (up to 'maxAreaRadius') from the center cell. Unlike
+        // GetDistanceIndexes(), the center cell is included. If the index is not valid, then returns an empty mask.
+        static CellMask GetDistanceMask( const int32_t center, const uint32_t radius );
         static Indexes GetDistanceIndexes( const Unit & unit, const uint32_t radius );
         static Indexes GetDistanceIndexes( const Position & pos, const uint32_t radius );
 
@@ -45,9 +45,9 @@ uint64_t Battle::Command::updatePCG32Stream( uint64_t stream ) const
         Rand::combineSeedWithValueHash( stream, _type );
         // Use only cell index to move and attacker & defender UIDs, because cell index to attack and attack direction may differ depending on whether the AI or the human
         // player gives the command
-        Rand::combineSeedWithValueHash( stream, at( 2 ) );
-        Rand::combineSeedWithValueHash( stream, at( 3 ) );
-        Rand::combineSeedWithValueHash( stream, at( 4 ) );
+        Rand::combineSeedWithValueHash( stream, begin()[2] );
+        Rand::combineSeedWithValueHash( stream, begin()[3] );
+        Rand::combineSeedWithValueHash( stream, begin()[4] );
         break;
 
     case CommandType::MOVE:
@@ -77,16 +77,40 @@ uint64_t Battle::Command::updatePCG32Stream( uint64_t stream ) const
 
 Battle::Command & Battle::Command::operator<<( const int val )
 {
-    push_back( val );
+    if ( _size < inPlaceParamsCount ) {
+        _inPlaceParams[_size] = val;
+    }
+    else {
+        if ( _size == inPlaceParamsCount ) {
+            // The in place storage is full, move all the parameters to the heap
+            _heapParams.reserve( inPlaceParamsCount * 2 );
+            _heapParams.assign( _inPlaceParams.begin(), _inPlaceParams.end() );
+        }
+
+        _heapParams.push_back( val );
+    }
+
+    ++_size;
 
     return *this;
 }
 
 Battle::Command & Battle::Command::operator>>( int & val )
 {
-    if ( !empty() ) {
-        val = back();
-        pop_back();
+    if ( _size == 0 ) {
+        return *this;
+    }
+
+    val = _data()[_size - 1];
+    --_size;
+
+    if ( _size == inPlaceParamsCount ) {
+        // All the remaining parameters fit into the in place storage again
+        std::copy( _heapParams.begin(), _heapParams.begin() + inPlaceParamsCount, _inPlaceParams.begin() );
+        _heapParams.clear();
+    }
+    else if ( _size > inPlaceParamsCount ) {
+        _heapParams.pop_back();
     }
 
     return *this;
@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <array>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
@@ -50,7 +51,7 @@ namespace Battle
         QUICK_COMBAT
     };
 
-    class Command final : public std::vector<int>
+    class Command final
     {
     public:
         static constexpr std::integral_constant<CommandType, CommandType::MOVE> MOVE{};
@@ -116,7 +117,7 @@ namespace Battle
             }
 
             if constexpr ( sizeof...( params ) > 0 ) {
-                reserve( sizeof...( params ) );
+                static_assert( sizeof...( params ) <= inPlaceParamsCount );
 
                 // Put the elements of the parameter pack in reverse order using the right-to-left sequencing of the assignment operator
                 int dummy = 0;
@@ -129,6 +130,36 @@ namespace Battle
             return _type;
         }
 
+        size_t size() const
+        {
+            return _size;
+        }
+
+        bool empty() const
+        {
+            return _size == 0;
+        }
+
+        int * begin()
+        {
+            return _data();
+        }
+
+        int * end()
+        {
+            return _data() + _size;
+        }
+
+        const int * begin() const
+        {
+            return _data();
+        }
+
+        const int * end() const
+        {
+            return _data() + _size;
+        }
+
         int GetNextValue();
 
         // Updates the specified PCG32 stream using the contents of this command. Returns the updated stream (or the original stream if
@@ -138,8 +169,27 @@ namespace Battle
         Command & operator<<( const int val );
 
     private:
+        // No command type has more parameters than this except for the catapult command, which has 3 parameters per shot.
+        static constexpr size_t inPlaceParamsCount = 7;
+
         Command & operator>>( int & val );
 
+        int * _data()
+        {
+            return _size > inPlaceParamsCount ? _heapParams.data() : _inPlaceParams.data();
+        }
+
+        const int * _data() const
+        {
+            return _size > inPlaceParamsCount ? _heapParams.data() : _inPlaceParams.data();
+        }
+
+        // Commands are created for every action of every unit, so the parameters are stored in place to avoid heap allocations. Only
+        // if the number of parameters exceeds the capacity of the in place storage, all of them are moved to the heap.
+        std::array<int, inPlaceParamsCount> _inPlaceParams{};
+        std::vector<int> _heapParams;
+        size_t _size{ 0 };
+
         CommandType _type;
     };
 }
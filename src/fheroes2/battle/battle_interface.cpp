@@ -35,7 +35,10 @@
 #include <iterator>
 #include <ostream>
 #include <set>
+#include <tuple>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "agg_image.h"
 #include "audio.h"
@@ -51,6 +54,7 @@
 #include "battle_troop.h"
 #include "bin_info.h"
 #include "castle.h"
+#include "frame_arena.h"
 #include "game.h"
 #include "game_delays.h"
 #include "game_hotkeys.h"
@@ -70,6 +74,7 @@
 #include "mus.h"
 #include "pal.h"
 #include "players.h"
+#include "profiler.h"
 #include "race.h"
 #include "rand.h"
 #include "settings.h"
@@ -80,6 +85,7 @@
 #include "ui_constants.h"
 #include "ui_dialog.h"
 #include "ui_scrollbar.h"
+#include "ui_text.h"
 #include "ui_tool.h"
 #include "ui_window.h"
 #include "world.h"
@@ -796,6 +802,56 @@ namespace
 
         return pos;
     }
+
+    // Returns the ICN IDs of the battlefield background and of the objects at the battlefield border.
+    std::pair<int, int> getBattlefieldIcnIds( const int groundType, const bool trees )
+    {
+        switch ( groundType ) {
+        case Maps::Ground::DESERT:
+            return { ICN::CBKGDSRT, ICN::FRNG0004 };
+        case Maps::Ground::SNOW:
+            return { trees ? ICN::CBKGSNTR : ICN::CBKGSNMT, trees ? ICN::FRNG0006 : ICN::FRNG0007 };
+        case Maps::Ground::SWAMP:
+            return { ICN::CBKGSWMP, ICN::FRNG0008 };
+        case Maps::Ground::WASTELAND:
+            return { ICN::CBKGCRCK, ICN::FRNG0003 };
+        case Maps::Ground::BEACH:
+            return { ICN::CBKGBEAC, ICN::FRNG0002 };
+        case Maps::Ground::LAVA:
+            return { ICN::CBKGLAVA, ICN::FRNG0005 };
+        case Maps::Ground::DIRT:
+            return { trees ? ICN::CBKGDITR : ICN::CBKGDIMT, trees ? ICN::FRNG0010 : ICN::FRNG0009 };
+        case Maps::Ground::GRASS:
+            return { trees ? ICN::CBKGGRTR : ICN::CBKGGRMT, trees ? ICN::FRNG0011 : ICN::FRNG0012 };
+        case Maps::Ground::WATER:
+            return { ICN::CBKGWATR, ICN::FRNG0013 };
+        default:
+            break;
+        }
+
+        return { ICN::UNKNOWN, ICN::UNKNOWN };
+    }
+
+    // Returns the IDs of all the sounds that can be made by the units taking part in the battle.
+    std::vector<int> getBattleUnitSounds( const Battle::Arena & arena )
+    {
+        std::vector<int> m82List;
+
+        for ( const Battle::Force * force : { &arena.getAttackingForce(), &arena.getDefendingForce() } ) {
+            for ( const Battle::Unit * unit : *force ) {
+                const fheroes2::MonsterSound & sounds = fheroes2::getMonsterData( unit->GetID() ).sounds;
+
+                for ( const int m82 : { sounds.meleeAttack, sounds.death, sounds.movement, sounds.wince, sounds.rangeAttack, sounds.takeoff, sounds.landing,
+                                        sounds.explosion } ) {
+                    if ( m82 != M82::UNKNOWN && std::find( m82List.begin(), m82List.end(), m82 ) == m82List.end() ) {
+                        m82List.push_back( m82 );
+                    }
+                }
+            }
+        }
+
+        return m82List;
+    }
 }
 
 namespace Battle
@@ -1192,7 +1248,7 @@ bool Battle::TurnOrder::queueEventProcessing( Interface & interface, std::string
 
         const fheroes2::Rect unitRoi = _isInsideBattleField ? ( unitPos + offset ) : unitPos;
         if ( le.isMouseCursorPosInArea( unitRoi ) ) {
-            msg = _( "View %{monster} info" );
+            msg = _c( "View %{monster} info" );
             StringReplaceWithLowercase( msg, "%{monster}", unit->GetName() );
 
             interface.setUnitTobeHighlighted( unit );
@@ -1356,6 +1412,22 @@ void Battle::TurnOrder::redraw( const Unit * current, const uint8_t currentUnitC
     }
 }
 
+std::vector<int> Battle::Interface::getIcnManifest( const int32_t tileIndex, const Units & attackers, const Units & defenders )
+{
+    const bool trees = !Maps::ScanAroundObject( tileIndex, MP2::OBJ_TREES ).empty();
+    const auto [battleGroundIcn, borderObjectsIcn] = getBattlefieldIcnIds( world.getTile( tileIndex ).GetGround(), trees );
+
+    std::vector<int> icnIds{ battleGroundIcn, borderObjectsIcn, ICN::TEXTBAR };
+
+    for ( const Units * units : { &attackers, &defenders } ) {
+        for ( const Unit * unit : *units ) {
+            icnIds.emplace_back( unit->GetMonsterSprite() );
+        }
+    }
+
+    return icnIds;
+}
+
 Battle::Interface::Interface( Arena & battleArena, const int32_t tileIndex )
     : arena( battleArena )
 {
@@ -1383,46 +1455,7 @@ Battle::Interface::Interface( Arena & battleArena, const int32_t tileIndex )
         _contourColor = 108;
     }
 
-    switch ( groundType ) {
-    case Maps::Ground::DESERT:
-        _battleGroundIcn = ICN::CBKGDSRT;
-        _borderObjectsIcn = ICN::FRNG0004;
-        break;
-    case Maps::Ground::SNOW:
-        _battleGroundIcn = trees ? ICN::CBKGSNTR : ICN::CBKGSNMT;
-        _borderObjectsIcn = trees ? ICN::FRNG0006 : ICN::FRNG0007;
-        break;
-    case Maps::Ground::SWAMP:
-        _battleGroundIcn = ICN::CBKGSWMP;
-        _borderObjectsIcn = ICN::FRNG0008;
-        break;
-    case Maps::Ground::WASTELAND:
-        _battleGroundIcn = ICN::CBKGCRCK;
-        _borderObjectsIcn = ICN::FRNG0003;
-        break;
-    case Maps::Ground::BEACH:
-        _battleGroundIcn = ICN::CBKGBEAC;
-        _borderObjectsIcn = ICN::FRNG0002;
-        break;
-    case Maps::Ground::LAVA:
-        _battleGroundIcn = ICN::CBKGLAVA;
-        _borderObjectsIcn = ICN::FRNG0005;
-        break;
-    case Maps::Ground::DIRT:
-        _battleGroundIcn = trees ? ICN::CBKGDITR : ICN::CBKGDIMT;
-        _borderObjectsIcn = trees ? ICN::FRNG0010 : ICN::FRNG0009;
-        break;
-    case Maps::Ground::GRASS:
-        _battleGroundIcn = trees ? ICN::CBKGGRTR : ICN::CBKGGRMT;
-        _borderObjectsIcn = trees ? ICN::FRNG0011 : ICN::FRNG0012;
-        break;
-    case Maps::Ground::WATER:
-        _battleGroundIcn = ICN::CBKGWATR;
-        _borderObjectsIcn = ICN::FRNG0013;
-        break;
-    default:
-        break;
-    }
+    std::tie( _battleGroundIcn, _borderObjectsIcn ) = getBattlefieldIcnIds( groundType, trees );
 
     // hexagon
     _hexagonGrid = DrawHexagon( fheroes2::GetColorId( 0x68, 0x8C, 0x04 ) );
@@ -1471,6 +1504,7 @@ Battle::Interface::Interface( Arena & battleArena, const int32_t tileIndex )
 
     // As `_battleGround` and '_mainSurface' are used to prepare battlefield screen to render on display they do not need to have a transform layer.
     _battleGround._disableTransformLayer();
+    _battleGroundWithShadow._disableTransformLayer();
     _mainSurface._disableTransformLayer();
 
     // Battlefield area excludes the lower part where the status log is located.
@@ -1478,10 +1512,16 @@ Battle::Interface::Interface( Arena & battleArena, const int32_t tileIndex )
     _battleGround.resize( area.width, battlefieldHeight );
 
     AudioManager::ResetAudio();
+
+    // Decode the sounds of the units in advance to avoid delays when these sounds are played for the first time.
+    AudioManager::preloadSounds( getBattleUnitSounds( arena ) );
 }
 
 Battle::Interface::~Interface()
 {
+    // The fast-forward mode should never affect anything outside the battle
+    Game::setBattleAnimationFastForward( false );
+
     AudioManager::ResetAudio();
 
     // Turn order dialog can be outside the battlefield area.
@@ -1595,6 +1635,8 @@ void Battle::Interface::Redraw()
 
 void Battle::Interface::RedrawPartialStart()
 {
+    const fheroes2::ProfilerScopedTimer redrawTimer( fheroes2::ProfilerSection::BATTLEFIELD );
+
     RedrawCover();
     RedrawArmies();
 }
@@ -1603,12 +1645,31 @@ void Battle::Interface::RedrawPartialFinish()
 {
     redrawPreRender();
 
-    auto & display = fheroes2::Display::instance();
-    display.render( fheroes2::getBoundaryRect( _interfacePosition, _turnOrder.getRenderingRoi() ) );
+    // In the fast-forward mode only some of the frames are rendered, the rest of them are just drawn to the display buffer
+    if ( Game::isBattleAnimationFastForwardEnabled() ) {
+        if ( !_fastForwardRenderDelay.isPassed() ) {
+            return;
+        }
+
+        _fastForwardRenderDelay.reset();
+    }
+
+    // The status bar and the buttons are drawn directly on the display so they are always rendered.
+    fheroes2::Rect renderRoi = fheroes2::getBoundaryRect( _pendingRenderRoi, status );
+    renderRoi = fheroes2::getBoundaryRect( renderRoi, _buttonAuto.area() );
+    renderRoi = fheroes2::getBoundaryRect( renderRoi, _buttonSettings.area() );
+    renderRoi = fheroes2::getBoundaryRect( renderRoi, _buttonSkip.area() );
+    renderRoi = fheroes2::getBoundaryRect( renderRoi, _turnOrder.getRenderingRoi() );
+
+    _pendingRenderRoi = {};
+
+    fheroes2::Display::instance().render( renderRoi );
 }
 
 void Battle::Interface::redrawPreRender()
 {
+    const fheroes2::ProfilerScopedTimer redrawTimer( fheroes2::ProfilerSection::BATTLEFIELD );
+
     if ( Settings::Get().BattleShowTurnOrder() ) {
         const Unit * unit = nullptr;
         const Cell * cell = Board::GetCell( _currentCellIndex );
@@ -1635,7 +1696,17 @@ void Battle::Interface::redrawPreRender()
     }
 #endif
 
-    fheroes2::Copy( _mainSurface, 0, 0, fheroes2::Display::instance(), _interfacePosition.x, _interfacePosition.y, _mainSurface.width(), _mainSurface.height() );
+    fheroes2::Display & display = fheroes2::Display::instance();
+
+    // Most of the frames change only a small part of the battlefield (an animated unit, a spell effect) so instead of rendering the whole battle
+    // area we find the area which differs from the previous frame which is still in the display buffer. Comparing the frames is much cheaper
+    // than sending the whole area to the screen and, unlike tracking of every drawn sprite, it can not miss any change.
+    // The popup and the battle log are drawn on top of the display so their areas are always included by the comparison.
+    const fheroes2::Rect changedRoi
+        = fheroes2::GetDifferenceROI( _mainSurface, 0, 0, display, _interfacePosition.x, _interfacePosition.y, _mainSurface.width(), _mainSurface.height() );
+    _pendingRenderRoi = fheroes2::getBoundaryRect( _pendingRenderRoi, changedRoi );
+
+    fheroes2::Copy( _mainSurface, 0, 0, display, _interfacePosition.x, _interfacePosition.y, _mainSurface.width(), _mainSurface.height() );
     RedrawInterface();
 }
 
@@ -1670,6 +1741,17 @@ void Battle::Interface::RedrawArmies()
         RedrawKilled();
     }
 
+    _updateArmyRenderRows();
+
+    // Appends the spell effect overlays of the given unit to the given list. There are no overlays most of the time.
+    const auto collectOverlaySprites = [this]( const Unit & unit, fheroes2::FrameVector<const UnitSpellEffectInfo *> & overlaySprites ) {
+        for ( const Battle::UnitSpellEffectInfo & overlaySprite : _unitSpellEffectInfos ) {
+            if ( overlaySprite.unitId == unit.GetUID() ) {
+                overlaySprites.emplace_back( &overlaySprite );
+            }
+        }
+    };
+
     for ( int32_t cellRowId = 0; cellRowId < Board::heightInCells; ++cellRowId ) {
         // Redraw objects.
         for ( int32_t cellColumnId = 0; cellColumnId < Board::widthInCells; ++cellColumnId ) {
@@ -1686,29 +1768,29 @@ void Battle::Interface::RedrawArmies()
                 RedrawCastle( *castle, Arena::CATAPULT_POS );
             }
 
-            std::vector<const Unit *> deadTroopBeforeWall;
-            std::vector<const Unit *> deadTroopAfterWall;
+            fheroes2::FrameVector<const Unit *> deadTroopBeforeWall;
+            fheroes2::FrameVector<const Unit *> deadTroopAfterWall;
 
-            std::vector<const Unit *> troopCounterBeforeWall;
-            std::vector<const Unit *> troopCounterAfterWall;
+            fheroes2::FrameVector<const Unit *> troopCounterBeforeWall;
+            fheroes2::FrameVector<const Unit *> troopCounterAfterWall;
 
-            std::vector<const Unit *> troopBeforeWall;
-            std::vector<const Unit *> troopAfterWall;
-            std::vector<const Unit *> movingTroopBeforeWall;
+            fheroes2::FrameVector<const Unit *> troopBeforeWall;
+            fheroes2::FrameVector<const Unit *> troopAfterWall;
+            fheroes2::FrameVector<const Unit *> movingTroopBeforeWall;
 
-            std::vector<const Unit *> downwardMovingTroopBeforeWall;
-            std::vector<const Unit *> downwardMovingTroopAfterWall;
-            std::vector<const Unit *> movingTroopAfterWall;
+            fheroes2::FrameVector<const Unit *> downwardMovingTroopBeforeWall;
+            fheroes2::FrameVector<const Unit *> downwardMovingTroopAfterWall;
+            fheroes2::FrameVector<const Unit *> movingTroopAfterWall;
 
             // Overlay sprites for troops (i.e. spell effect animation) should be rendered after rendering all troops
             // for current row so the next troop will not be rendered over the overlay sprite.
-            std::vector<const UnitSpellEffectInfo *> troopOverlaySpriteBeforeWall;
-            std::vector<const UnitSpellEffectInfo *> troopOverlaySpriteAfterWall;
+            fheroes2::FrameVector<const UnitSpellEffectInfo *> troopOverlaySpriteBeforeWall;
+            fheroes2::FrameVector<const UnitSpellEffectInfo *> troopOverlaySpriteAfterWall;
 
             const int32_t wallCellId = wallCellIds[cellRowId];
 
-            for ( int32_t cellColumnId = 0; cellColumnId < Board::widthInCells; ++cellColumnId ) {
-                const int32_t cellId = cellRowId * Board::widthInCells + cellColumnId;
+            for ( const ArmyRenderItem & item : _armyRenderRows[cellRowId] ) {
+                const int32_t cellId = item.cellId;
 
                 bool isCellBefore = true;
                 if ( cellRowId < 5 ) {
@@ -1722,34 +1804,28 @@ void Battle::Interface::RedrawArmies()
                     }
                 }
 
-                for ( const Unit * deadUnit : arena.getGraveyardUnits( cellId ) ) {
-                    if ( deadUnit && cellId != deadUnit->GetTailIndex() ) {
+                if ( item.isDead ) {
+                    if ( cellId != item.unit->GetTailIndex() ) {
                         if ( isCellBefore ) {
-                            deadTroopBeforeWall.emplace_back( deadUnit );
+                            deadTroopBeforeWall.emplace_back( item.unit );
 
                             // Check for overlay sprites of dead units (i.e. Resurrect spell).
-                            for ( const Battle::UnitSpellEffectInfo & overlaySprite : _unitSpellEffectInfos ) {
-                                if ( overlaySprite.unitId == deadUnit->GetUID() ) {
-                                    troopOverlaySpriteBeforeWall.emplace_back( &overlaySprite );
-                                }
-                            }
+                            collectOverlaySprites( *item.unit, troopOverlaySpriteBeforeWall );
                         }
                         else {
-                            deadTroopAfterWall.emplace_back( deadUnit );
+                            deadTroopAfterWall.emplace_back( item.unit );
 
                             // Check for overlay sprites of dead units (i.e. Resurrect spell).
-                            for ( const Battle::UnitSpellEffectInfo & overlaySprite : _unitSpellEffectInfos ) {
-                                if ( overlaySprite.unitId == deadUnit->GetUID() ) {
-                                    troopOverlaySpriteAfterWall.emplace_back( &overlaySprite );
-                                }
-                            }
+                            collectOverlaySprites( *item.unit, troopOverlaySpriteAfterWall );
                         }
                     }
+
+                    continue;
                 }
 
                 const Cell * currentCell = Board::GetCell( cellId );
-                const Unit * unitOnCell = currentCell->GetUnit();
-                if ( unitOnCell == nullptr || _flyingUnit == unitOnCell || cellId == unitOnCell->GetTailIndex() ) {
+                const Unit * unitOnCell = item.unit;
+                if ( _flyingUnit == unitOnCell ) {
                     continue;
                 }
 
@@ -1792,16 +1868,7 @@ void Battle::Interface::RedrawArmies()
                 }
 
                 // Check for overlay sprites for 'unitOnCell'.
-                for ( const Battle::UnitSpellEffectInfo & overlaySprite : _unitSpellEffectInfos ) {
-                    if ( overlaySprite.unitId == unitOnCell->GetUID() ) {
-                        if ( isCellBefore ) {
-                            troopOverlaySpriteBeforeWall.emplace_back( &overlaySprite );
-                        }
-                        else {
-                            troopOverlaySpriteAfterWall.emplace_back( &overlaySprite );
-                        }
-                    }
-                }
+                collectOverlaySprites( *unitOnCell, isCellBefore ? troopOverlaySpriteBeforeWall : troopOverlaySpriteAfterWall );
             }
 
             for ( const Unit * unit : deadTroopBeforeWall ) {
@@ -1861,26 +1928,21 @@ void Battle::Interface::RedrawArmies()
             }
         }
         else {
-            std::vector<const Unit *> troopCounter;
-            std::vector<const Unit *> troop;
-            std::vector<const Unit *> downwardMovingTroop;
-            std::vector<const UnitSpellEffectInfo *> troopOverlaySprite;
-
-            for ( int32_t cellColumnId = 0; cellColumnId < Board::widthInCells; ++cellColumnId ) {
-                const int32_t cellId = cellRowId * Board::widthInCells + cellColumnId;
-
-                // Check for overlay sprites of dead units (i.e. Resurrect spell).
-                for ( const Unit * deadUnit : arena.getGraveyardUnits( cellId ) ) {
-                    for ( const Battle::UnitSpellEffectInfo & overlaySprite : _unitSpellEffectInfos ) {
-                        if ( overlaySprite.unitId == deadUnit->GetUID() ) {
-                            troopOverlaySprite.emplace_back( &overlaySprite );
-                        }
-                    }
+            fheroes2::FrameVector<const Unit *> troopCounter;
+            fheroes2::FrameVector<const Unit *> troop;
+            fheroes2::FrameVector<const Unit *> downwardMovingTroop;
+            fheroes2::FrameVector<const UnitSpellEffectInfo *> troopOverlaySprite;
+
+            for ( const ArmyRenderItem & item : _armyRenderRows[cellRowId] ) {
+                if ( item.isDead ) {
+                    // Check for overlay sprites of dead units (i.e. Resurrect spell).
+                    collectOverlaySprites( *item.unit, troopOverlaySprite );
+                    continue;
                 }
 
-                const Cell * currentCell = Board::GetCell( cellId );
-                const Unit * unitOnCell = currentCell->GetUnit();
-                if ( unitOnCell == nullptr || _flyingUnit == unitOnCell || cellId == unitOnCell->GetTailIndex() ) {
+                const Cell * currentCell = Board::GetCell( item.cellId );
+                const Unit * unitOnCell = item.unit;
+                if ( _flyingUnit == unitOnCell ) {
                     continue;
                 }
 
@@ -1903,11 +1965,7 @@ void Battle::Interface::RedrawArmies()
                 }
 
                 // Check for overlay sprites for 'unitOnCell'.
-                for ( const Battle::UnitSpellEffectInfo & overlaySprite : _unitSpellEffectInfos ) {
-                    if ( overlaySprite.unitId == unitOnCell->GetUID() ) {
-                        troopOverlaySprite.emplace_back( &overlaySprite );
-                    }
-                }
+                collectOverlaySprites( *unitOnCell, troopOverlaySprite );
             }
 
             // Redraw monsters.
@@ -1943,6 +2001,40 @@ void Battle::Interface::RedrawArmies()
     }
 }
 
+void Battle::Interface::_updateArmyRenderRows()
+{
+    for ( std::vector<ArmyRenderItem> & row : _armyRenderRows ) {
+        row.clear();
+    }
+
+    // Dead units are added first, so within a cell they stay in front of the living unit after the stable sort below, which keeps the drawing
+    // order of the former cell by cell lookup.
+    for ( const auto & [cellId, units] : *Arena::GetGraveyard() ) {
+        if ( !Board::isValidIndex( cellId ) ) {
+            continue;
+        }
+
+        for ( const Unit * unit : units ) {
+            if ( unit != nullptr ) {
+                _armyRenderRows[cellId / Board::widthInCells].push_back( { cellId, unit, true } );
+            }
+        }
+    }
+
+    for ( const Cell & cell : *Arena::GetBoard() ) {
+        const Unit * unit = cell.GetUnit();
+
+        // Wide units are drawn from their head cell only.
+        if ( unit != nullptr && cell.GetIndex() != unit->GetTailIndex() ) {
+            _armyRenderRows[cell.GetIndex() / Board::widthInCells].push_back( { cell.GetIndex(), unit, false } );
+        }
+    }
+
+    for ( std::vector<ArmyRenderItem> & row : _armyRenderRows ) {
+        std::stable_sort( row.begin(), row.end(), []( const ArmyRenderItem & first, const ArmyRenderItem & second ) { return first.cellId < second.cellId; } );
+    }
+}
+
 void Battle::Interface::RedrawOpponents()
 {
     if ( _attackingOpponent )
@@ -2096,8 +2188,10 @@ void Battle::Interface::RedrawTroopCount( const Unit & unit )
 
     fheroes2::Copy( bar, 0, 0, _mainSurface, sx, sy, bar.width(), bar.height() );
 
-    const fheroes2::Text text( fheroes2::abbreviateNumber( static_cast<int32_t>( unit.GetCount() ) ), fheroes2::FontType::smallWhite() );
-    text.draw( sx + ( bar.width() - text.width() ) / 2, sy + 2, _mainSurface );
+    // Troop counts are drawn on every frame, use the cached rendered texts.
+    const fheroes2::RenderedText & text
+        = fheroes2::getRenderedText( fheroes2::abbreviateNumber( static_cast<int32_t>( unit.GetCount() ) ), fheroes2::FontType::smallWhite() );
+    fheroes2::Blit( text.image, _mainSurface, sx + ( bar.width() - text.width ) / 2 + text.image.x(), sy + 2 + text.image.y() );
 }
 
 void Battle::Interface::RedrawCover()
@@ -2298,7 +2392,7 @@ void Battle::Interface::RedrawCover()
             if ( isApplicable ) {
                 const Unit * highlightedUnit = highlightedCell->GetUnit();
 
-                isApplicable = highlightedUnit == nullptr || !humanturn_spell.isValid() || highlightedUnit->AllowApplySpell( humanturn_spell, currentCommander );
+                isApplicable = highlightedUnit == nullptr || !humanturn_spell.isValid() || arena.isSpellApplicable( *highlightedUnit, humanturn_spell, currentCommander );
             }
 
             if ( isApplicable ) {
@@ -2310,6 +2404,9 @@ void Battle::Interface::RedrawCover()
 
 void Battle::Interface::_redrawBattleGround()
 {
+    // The ground is going to change, so the ground with the movement shadow has to be rebuilt as well.
+    _battleGroundShadowUnit = nullptr;
+
     // Battlefield background image.
     if ( _battleGroundIcn != ICN::UNKNOWN ) {
         const fheroes2::Sprite & cbkg = fheroes2::AGG::GetICN( _battleGroundIcn, 0 );
@@ -2391,12 +2488,18 @@ void Battle::Interface::_redrawBattleGround()
 
 void Battle::Interface::_redrawCoverStatic()
 {
-    fheroes2::Copy( _battleGround, _mainSurface );
-
     const Settings & conf = Settings::Get();
 
-    // Movement shadow.
-    if ( !_movingUnit && conf.BattleShowMoveShadow() && _currentUnit && !( _currentUnit->GetCurrentControl() & CONTROL_AI ) ) {
+    if ( _movingUnit || !conf.BattleShowMoveShadow() || _currentUnit == nullptr || ( _currentUnit->GetCurrentControl() & CONTROL_AI ) ) {
+        fheroes2::Copy( _battleGround, _mainSurface );
+        return;
+    }
+
+    // Movement shadow. Reachable cells can only change after an action, so the shadow is drawn once and reused for every frame until then.
+    if ( _battleGroundShadowUnit != _currentUnit || _battleGroundShadowStateHash != arena.getStateHash() || _battleGroundShadowTurnNumber != arena.GetTurnNumber() ) {
+        _battleGroundWithShadow.resize( _battleGround.width(), _battleGround.height() );
+        fheroes2::Copy( _battleGround, _battleGroundWithShadow );
+
         const fheroes2::Image & shadowImage = conf.BattleShowGrid() ? _hexagonGridShadow : _hexagonShadow;
         const Board & board = *Arena::GetBoard();
 
@@ -2405,10 +2508,16 @@ void Battle::Interface::_redrawCoverStatic()
             if ( pos.GetHead() != nullptr ) {
                 assert( pos.isValidForUnit( _currentUnit ) );
 
-                fheroes2::Blit( shadowImage, _mainSurface, cell.GetPos().x, cell.GetPos().y );
+                fheroes2::Blit( shadowImage, _battleGroundWithShadow, cell.GetPos().x, cell.GetPos().y );
             }
         }
+
+        _battleGroundShadowUnit = _currentUnit;
+        _battleGroundShadowStateHash = arena.getStateHash();
+        _battleGroundShadowTurnNumber = arena.GetTurnNumber();
     }
+
+    fheroes2::Copy( _battleGroundWithShadow, _mainSurface );
 }
 
 void Battle::Interface::RedrawCastle( const Castle & castle, const int32_t cellId )
@@ -2700,7 +2809,7 @@ int Battle::Interface::GetBattleCursor( std::string & statusMsg ) const
         const auto formatViewInfoMsg = []( const Unit * unit ) {
             assert( unit != nullptr );
 
-            std::string msg = _( "View %{monster} info" );
+            std::string msg = _c( "View %{monster} info" );
             StringReplaceWithLowercase( msg, "%{monster}", unit->GetMultiName() );
 
             return msg;
@@ -2735,7 +2844,7 @@ int Battle::Interface::GetBattleCursor( std::string & statusMsg ) const
             }
 
             if ( _currentUnit->isArchers() && !_currentUnit->isHandFighting() ) {
-                statusMsg = _( "Shoot %{monster}" );
+                statusMsg = _c( "Shoot %{monster}" );
                 statusMsg.append( " " );
                 statusMsg.append( _n( "(1 shot left)", "(%{count} shots left)", _currentUnit->GetShots() ) );
                 StringReplaceWithLowercase( statusMsg, "%{monster}", unit->GetMultiName() );
@@ -2816,7 +2925,7 @@ int Battle::Interface::GetBattleCursor( std::string & statusMsg ) const
 
                 const int cursor = getSwordCursorForAttackDirection( currentDirection );
 
-                statusMsg = _( "Attack %{monster}" );
+                statusMsg = _c( "Attack %{monster}" );
                 StringReplaceWithLowercase( statusMsg, "%{monster}", unit->GetName() );
 
                 return cursor;
@@ -2824,7 +2933,7 @@ int Battle::Interface::GetBattleCursor( std::string & statusMsg ) const
         }
     }
 
-    statusMsg = _( "Turn %{turn}" );
+    statusMsg = _c( "Turn %{turn}" );
     StringReplace( statusMsg, "%{turn}", arena.GetTurnNumber() );
 
     return Cursor::WAR_NONE;
@@ -2852,18 +2961,18 @@ int Battle::Interface::GetBattleSpellCursor( std::string & statusMsg ) const
             assert( unitToTeleport != nullptr );
 
             if ( unitOnCell == nullptr && cell->isPassableForUnit( *unitToTeleport ) ) {
-                statusMsg = _( "Teleport here" );
+                statusMsg = _c( "Teleport here" );
 
                 return Cursor::SP_TELEPORT;
             }
 
-            statusMsg = _( "Invalid teleport destination" );
+            statusMsg = _c( "Invalid teleport destination" );
 
             return Cursor::WAR_NONE;
         }
 
-        if ( unitOnCell && unitOnCell->AllowApplySpell( spell, _currentUnit->GetCurrentOrArmyCommander() ) ) {
-            statusMsg = _( "Cast %{spell} on %{monster}" );
+        if ( unitOnCell && arena.isSpellApplicable( *unitOnCell, spell, _currentUnit->GetCurrentOrArmyCommander() ) ) {
+            statusMsg = _c( "Cast %{spell} on %{monster}" );
             StringReplace( statusMsg, "%{spell}", spell.GetName() );
             StringReplaceWithLowercase( statusMsg, "%{monster}", unitOnCell->GetName() );
 
@@ -2871,14 +2980,14 @@ int Battle::Interface::GetBattleSpellCursor( std::string & statusMsg ) const
         }
 
         if ( !spell.isApplyToFriends() && !spell.isApplyToEnemies() && !spell.isApplyToAnyTroops() ) {
-            statusMsg = _( "Cast %{spell}" );
+            statusMsg = _c( "Cast %{spell}" );
             StringReplace( statusMsg, "%{spell}", spell.GetName() );
 
             return getCursorForSpell( spell.GetID() );
         }
     }
 
-    statusMsg = _( "Select spell target" );
+    statusMsg = _c( "Select spell target" );
 
     return Cursor::WAR_NONE;
 }
@@ -2904,6 +3013,9 @@ void Battle::Interface::HumanTurn( const Unit & unit, Actions & actions )
     humanturn_exit = false;
     catapult_frame = 0;
 
+    _isHumanTurnInProgress = true;
+    Game::setBattleAnimationFastForward( false );
+
     // in case we moved the window
     _interfacePosition = border.GetArea();
 
@@ -2968,6 +3080,9 @@ void Battle::Interface::HumanTurn( const Unit & unit, Actions & actions )
 
     popup.reset();
 
+    _isHumanTurnInProgress = false;
+    Game::setBattleAnimationFastForward( _isFastForwardEnabled );
+
     _currentUnit = nullptr;
 }
 
@@ -3054,7 +3169,7 @@ void Battle::Interface::HumanBattleTurn( const Unit & unit, Actions & actions, s
     }
     else if ( Arena::GetTower( TowerType::TWR_CENTER ) && le.isMouseCursorPosInArea( _ballistaTowerRect ) ) {
         cursor.SetThemes( Cursor::WAR_INFO );
-        msg = _( "View Ballista info" );
+        msg = _c( "View Ballista info" );
 
         if ( le.MouseClickLeft( _ballistaTowerRect ) || le.isMouseRightButtonPressedInArea( _ballistaTowerRect ) ) {
             const Castle * cstl = Arena::GetCastle();
@@ -3077,7 +3192,7 @@ void Battle::Interface::HumanBattleTurn( const Unit & unit, Actions & actions, s
     else if ( le.isMouseCursorPosInArea( _buttonAuto.area() ) ) {
         cursor.SetThemes( Cursor::WAR_POINTER );
 
-        msg = _( "Automatic combat modes" );
+        msg = _c( "Automatic combat modes" );
 
         if ( le.MouseClickLeft( _buttonAuto.area() ) ) {
             OpenAutoModeDialog( unit, actions );
@@ -3090,7 +3205,7 @@ void Battle::Interface::HumanBattleTurn( const Unit & unit, Actions & actions, s
     else if ( le.isMouseCursorPosInArea( _buttonSettings.area() ) ) {
         cursor.SetThemes( Cursor::WAR_POINTER );
 
-        msg = _( "Customize system options" );
+        msg = _c( "Customize system options" );
 
         if ( le.MouseClickLeft( _buttonSettings.area() ) ) {
             _openBattleSettingsDialog();
@@ -3104,7 +3219,7 @@ void Battle::Interface::HumanBattleTurn( const Unit & unit, Actions & actions, s
     else if ( le.isMouseCursorPosInArea( _buttonSkip.area() ) ) {
         cursor.SetThemes( Cursor::WAR_POINTER );
 
-        msg = _( "Skip this unit" );
+        msg = _c( "Skip this unit" );
 
         if ( le.MouseClickLeft( _buttonSkip.area() ) ) {
             assert( _currentUnit != nullptr );
@@ -3123,10 +3238,10 @@ void Battle::Interface::HumanBattleTurn( const Unit & unit, Actions & actions, s
         const fheroes2::Rect attackingOpponentArea = _attackingOpponent->GetArea() + _interfacePosition.getPosition();
         if ( arena.GetCurrentColor() == arena.getAttackingArmyColor() ) {
             if ( _attackingOpponent->GetHero()->isCaptain() ) {
-                msg = _( "View Captain's options" );
+                msg = _c( "View Captain's options" );
             }
             else {
-                msg = _( "View Hero's options" );
+                msg = _c( "View Hero's options" );
             }
             cursor.SetThemes( Cursor::WAR_HERO );
 
@@ -3137,10 +3252,10 @@ void Battle::Interface::HumanBattleTurn( const Unit & unit, Actions & actions, s
         }
         else {
             if ( _attackingOpponent->GetHero()->isCaptain() ) {
-                msg = _( "View opposing Captain" );
+                msg = _c( "View opposing Captain" );
             }
             else {
-                msg = _( "View opposing Hero" );
+                msg = _c( "View opposing Hero" );
             }
             cursor.SetThemes( Cursor::WAR_INFO );
 
@@ -3159,10 +3274,10 @@ void Battle::Interface::HumanBattleTurn( const Unit & unit, Actions & actions, s
         const fheroes2::Rect defendingOpponentArea = _defendingOpponent->GetArea() + _interfacePosition.getPosition();
         if ( arena.GetCurrentColor() == arena.getDefendingForce().GetColor() ) {
             if ( _defendingOpponent->GetHero()->isCaptain() ) {
-                msg = _( "View Captain's options" );
+                msg = _c( "View Captain's options" );
             }
             else {
-                msg = _( "View Hero's options" );
+                msg = _c( "View Hero's options" );
             }
 
             cursor.SetThemes( Cursor::WAR_HERO );
@@ -3174,10 +3289,10 @@ void Battle::Interface::HumanBattleTurn( const Unit & unit, Actions & actions, s
         }
         else {
             if ( _defendingOpponent->GetHero()->isCaptain() ) {
-                msg = _( "View opposing Captain" );
+                msg = _c( "View opposing Captain" );
             }
             else {
-                msg = _( "View opposing Hero" );
+                msg = _c( "View opposing Hero" );
             }
 
             cursor.SetThemes( Cursor::WAR_INFO );
@@ -6892,10 +7007,27 @@ void Battle::Interface::CheckGlobalEvents( LocalEvent & le )
         }
     }
 
+    if ( Game::HotKeyPressEvent( Game::HotKeyEvent::BATTLE_TOGGLE_FAST_FORWARD ) ) {
+        _toggleFastForward();
+    }
+
     // Check if auto combat interruption was requested.
     InterruptAutoCombatIfRequested( le );
 }
 
+void Battle::Interface::_toggleFastForward()
+{
+    _isFastForwardEnabled = !_isFastForwardEnabled;
+
+    if ( !_isHumanTurnInProgress ) {
+        Game::setBattleAnimationFastForward( _isFastForwardEnabled );
+    }
+
+    status.setMessage( _isFastForwardEnabled ? _( "Fast-forward of battle animations is on." ) : _( "Fast-forward of battle animations is off." ), true );
+
+    humanturn_redraw = true;
+}
+
 void Battle::Interface::InterruptAutoCombatIfRequested( LocalEvent & le )
 {
     // Interrupt only if automation is currently on.
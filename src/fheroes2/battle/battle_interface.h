@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <array>
 #include <cstdint>
 #include <memory>
 #include <optional>
@@ -41,6 +42,7 @@
 #include "math_base.h"
 #include "screen.h"
 #include "spell.h"
+#include "timing.h"
 #include "ui_button.h"
 #include "ui_text.h"
 
@@ -323,6 +325,9 @@ namespace Battle
 
         Interface & operator=( const Interface & ) = delete;
 
+        // Returns the list of ICNs required to render the battlefield at the given tile and the given units.
+        static std::vector<int> getIcnManifest( const int32_t tileIndex, const Units & attackers, const Units & defenders );
+
         void fullRedraw(); // only at the start of the battle
         void Redraw();
         void RedrawPartialStart();
@@ -391,6 +396,8 @@ namespace Battle
 
         void RedrawCover();
         void _redrawBattleGround();
+        // Fills in '_armyRenderRows' from the board and the graveyard.
+        void _updateArmyRenderRows();
         void _redrawCoverStatic();
 
         // Draws cracks and pools that are not higher than the ground level.
@@ -449,6 +456,7 @@ namespace Battle
         void UpdateContourColor();
         void CheckGlobalEvents( LocalEvent & );
         void InterruptAutoCombatIfRequested( LocalEvent & le );
+        void _toggleFastForward();
         void SetHeroAnimationReactionToTroopDeath( const PlayerColor deathColor ) const;
 
         void ProcessingHeroDialogResult( const int result, Actions & actions );
@@ -472,6 +480,12 @@ namespace Battle
         fheroes2::Rect _surfaceInnerArea{ 0, 0, fheroes2::Display::DEFAULT_WIDTH, fheroes2::Display::DEFAULT_HEIGHT };
         fheroes2::Image _mainSurface;
         fheroes2::Image _battleGround;
+        // Battlefield ground with the movement shadow of a unit on top of it. It is rebuilt only when the shadow would look different: for
+        // another unit, after any battle action or at the start of a new turn.
+        fheroes2::Image _battleGroundWithShadow;
+        const Unit * _battleGroundShadowUnit{ nullptr };
+        uint64_t _battleGroundShadowStateHash{ 0 };
+        uint32_t _battleGroundShadowTurnNumber{ 0 };
         fheroes2::Image _hexagonGrid;
         fheroes2::Image _hexagonShadow;
         fheroes2::Image _hexagonGridShadow;
@@ -496,6 +510,15 @@ namespace Battle
 
         PlayerColor _interruptAutoCombatForColor{ PlayerColor::NONE };
 
+        // In the fast-forward mode the battle animations are played without delays and only some of their frames are rendered. This mode
+        // is suspended while a human player is making a decision to keep the interface responsive.
+        bool _isFastForwardEnabled{ false };
+        bool _isHumanTurnInProgress{ false };
+        fheroes2::TimeDelay _fastForwardRenderDelay{ 100 };
+
+        // Area of the display which has been changed by the battlefield redraws since the last render. Only this area is sent to the screen.
+        fheroes2::Rect _pendingRenderRoi;
+
         // The Channel ID of pre-battle sound. Used to check it is over to start the battle music.
         std::optional<int> _preBattleSoundChannelId{ -1 };
 
@@ -505,6 +528,17 @@ namespace Battle
         bool _brightLandType{ false };
         uint32_t _contourCycle{ 0 };
 
+        // Units to draw in every row of the battlefield, living and dead, sorted by cell. The lists are rebuilt for every frame, but their storage
+        // is kept between frames.
+        struct ArmyRenderItem
+        {
+            int32_t cellId;
+            const Unit * unit;
+            bool isDead;
+        };
+
+        std::array<std::vector<ArmyRenderItem>, Board::heightInCells> _armyRenderRows;
+
         const Unit * _currentUnit{ nullptr };
         const Unit * _movingUnit{ nullptr };
         const Unit * _flyingUnit{ nullptr };
@@ -21,11 +21,11 @@
 #include "battle_pathfinding.h"
 
 #include <algorithm>
+#include <array>
+#include <bitset>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
-#include <functional>
-#include <set>
 #include <tuple>
 #include <vector>
 
@@ -42,7 +42,41 @@ namespace
 
 namespace Battle
 {
-    void BattlePathfinder::reEvaluateIfNeeded( const Unit & unit )
+    BattleNodeIndex BattlePathfinder::Graph::getBattleNodeIndex( const size_t nodeIdx ) const
+    {
+        assert( nodeIdx < nodes.size() );
+
+        const int32_t headCellIdx = static_cast<int32_t>( nodeIdx / 2 );
+
+        if ( !isWide ) {
+            // Odd indexes are not used by narrow units
+            if ( nodeIdx % 2 != 0 ) {
+                return { -1, -1 };
+            }
+
+            return { headCellIdx, -1 };
+        }
+
+        return { headCellIdx, nodeIdx % 2 == 0 ? headCellIdx - 1 : headCellIdx + 1 };
+    }
+
+    size_t BattlePathfinder::getNodeIdx( const BattleNodeIndex & index )
+    {
+        const auto [headCellIdx, tailCellIdx] = index;
+        assert( Board::isValidIndex( headCellIdx ) );
+        assert( tailCellIdx == -1 || tailCellIdx == headCellIdx - 1 || tailCellIdx == headCellIdx + 1 );
+
+        return static_cast<size_t>( headCellIdx ) * 2 + ( tailCellIdx > headCellIdx ? 1 : 0 );
+    }
+
+    BattleNodeIndex BattlePathfinder::getBattleNodeIndex( const Position & position )
+    {
+        assert( position.GetHead() != nullptr );
+
+        return { position.GetHead()->GetIndex(), position.GetTail() ? position.GetTail()->GetIndex() : -1 };
+    }
+
+    BattlePathfinder::Graph & BattlePathfinder::getGraph( const Unit & unit )
     {
         assert( unit.GetHeadIndex() != -1 && ( unit.isWide() ? unit.GetTailIndex() != -1 : unit.GetTailIndex() == -1 ) );
 
@@ -59,25 +93,59 @@ namespace Battle
             boardStatus[cellIdx] = cell.isPassable( true );
         }
 
-        auto currentSettings = std::tie( _pathStart, _speed, _isWide, _isFlying, _color, _boardStatus );
-        const auto newSettings = std::make_tuple( BattleNodeIndex{ unit.GetHeadIndex(), unit.GetTailIndex() }, unit.GetSpeed(), unit.isWide(), unit.isFlying(),
-                                                  unit.GetColor(), std::cref( boardStatus ) );
+        if ( boardStatus != _boardStatus ) {
+            _boardStatus = boardStatus;
+            _graphs.clear();
+        }
 
-        // If all the current parameters match the parameters for which the current cache was built, then there is no need to rebuild it
-        if ( currentSettings == newSettings ) {
-            return;
+        ++_useCounter;
+
+        const auto newSettings = std::make_tuple( BattleNodeIndex{ unit.GetHeadIndex(), unit.GetTailIndex() }, unit.isWide(), unit.isFlying(), unit.GetColor() );
+
+        for ( Graph & graph : _graphs ) {
+            // If all the parameters match the parameters for which the graph was built, then there is no need to rebuild it
+            if ( std::tie( graph.pathStart, graph.isWide, graph.isFlying, graph.color ) == newSettings ) {
+                graph.lastUse = _useCounter;
+
+                return graph;
+            }
         }
 
-        currentSettings = newSettings;
+        // There can hardly be more units on the battlefield that the AI evaluates at the same time
+        const size_t maxCachedGraphs = 16;
+
+        Graph * graph = nullptr;
+
+        if ( _graphs.size() < maxCachedGraphs ) {
+            graph = &_graphs.emplace_back();
+        }
+        else {
+            graph = &*std::min_element( _graphs.begin(), _graphs.end(), []( const Graph & left, const Graph & right ) { return left.lastUse < right.lastUse; } );
+        }
+
+        std::tie( graph->pathStart, graph->isWide, graph->isFlying, graph->color ) = newSettings;
+        graph->lastUse = _useCounter;
+
+        buildGraph( *graph, unit );
+
+        return *graph;
+    }
+
+    void BattlePathfinder::buildGraph( Graph & graph, const Unit & unit )
+    {
+        const Board * board = Arena::GetBoard();
+        assert( board != nullptr );
 
         const Castle * castle = Arena::GetCastle();
         const bool isMoatBuilt = castle && castle->isBuild( BUILD_MOAT );
 
-        _cache.clear();
-        _cache.try_emplace( _pathStart );
+        graph.nodes.fill( {} );
+        graph.isReachableHeadCellsValid = false;
+
+        const BattleNodeIndex & pathStart = graph.pathStart;
 
         // Flying units can land wherever they can fit
-        if ( _isFlying ) {
+        if ( graph.isFlying ) {
             for ( const Cell & cell : *board ) {
                 const Position pos = Position::GetPosition( unit, cell.GetIndex() );
 
@@ -90,12 +158,17 @@ namespace Battle
                 const int32_t headCellIdx = pos.GetHead()->GetIndex();
                 const int32_t tailCellIdx = pos.GetTail() ? pos.GetTail()->GetIndex() : -1;
 
-                if ( const auto [iter, inserted] = _cache.try_emplace( { headCellIdx, tailCellIdx } ); inserted ) {
+                const BattleNodeIndex nodeIdx = { headCellIdx, tailCellIdx };
+                if ( nodeIdx == pathStart ) {
+                    continue;
+                }
+
+                if ( BattleNode & node = graph.nodes[getNodeIdx( nodeIdx )]; node._from == BattleNodeIndex{ -1, -1 } ) {
                     // Wide units can occupy overlapping positions, the distance between which is actually zero,
                     // but since the movement takes place, we will consider the distance equal to 1 in this case
                     const uint32_t distance = std::max<uint32_t>( Board::GetDistance( unit.GetPosition(), pos ), 1U );
 
-                    iter->second.update( _pathStart, 1, distance );
+                    node.update( pathStart, 1, distance );
                 }
             }
 
@@ -104,22 +177,22 @@ namespace Battle
 
         // The index of that of the cells of the initial unit's position, which is located
         // in the moat (-1, if there is none)
-        const int32_t pathStartMoatCellIdx = [this, &unit, isMoatBuilt]() -> int32_t {
+        const int32_t pathStartMoatCellIdx = [&pathStart, &unit, isMoatBuilt, isWide = graph.isWide]() -> int32_t {
             if ( !isMoatBuilt ) {
                 return -1;
             }
 
-            assert( _pathStart.first != -1 );
+            assert( pathStart.first != -1 );
 
-            if ( Board::isMoatIndex( _pathStart.first, unit ) ) {
-                return _pathStart.first;
+            if ( Board::isMoatIndex( pathStart.first, unit ) ) {
+                return pathStart.first;
             }
 
-            if ( _isWide ) {
-                assert( _pathStart.second != -1 );
+            if ( isWide ) {
+                assert( pathStart.second != -1 );
 
-                if ( Board::isMoatIndex( _pathStart.second, unit ) ) {
-                    return _pathStart.second;
+                if ( Board::isMoatIndex( pathStart.second, unit ) ) {
+                    return pathStart.second;
                 }
             }
 
@@ -128,13 +201,13 @@ namespace Battle
 
         std::vector<BattleNodeIndex> nodesToExplore;
         nodesToExplore.reserve( Board::sizeInCells * 2 );
-        nodesToExplore.push_back( _pathStart );
+        nodesToExplore.push_back( pathStart );
 
         for ( size_t nodesToExploreIdx = 0; nodesToExploreIdx < nodesToExplore.size(); ++nodesToExploreIdx ) {
             const BattleNodeIndex currentNodeIdx = nodesToExplore[nodesToExploreIdx];
-            const BattleNode & currentNode = _cache[currentNodeIdx];
+            const BattleNode & currentNode = graph.nodes[getNodeIdx( currentNodeIdx )];
 
-            if ( _isWide ) {
+            if ( graph.isWide ) {
                 assert( currentNodeIdx.first != -1 && currentNodeIdx.second != -1 );
 
                 const auto [currentHeadCellIdx, currentTailCellIdx] = currentNodeIdx;
@@ -161,7 +234,7 @@ namespace Battle
                     const int32_t tailCellIdx = isLeftSide( Board::GetDirection( currentHeadCellIdx, headCellIdx ) ) ? headCellIdx + 1 : headCellIdx - 1;
 
                     const BattleNodeIndex newNodeIdx = { headCellIdx, tailCellIdx };
-                    if ( newNodeIdx == _pathStart ) {
+                    if ( newNodeIdx == pathStart ) {
                         continue;
                     }
 
@@ -169,7 +242,7 @@ namespace Battle
                     const uint32_t cost = currentNode._cost + ( newNodeIdx == flippedCurrentNodeIdx ? 0 : movementPenalty );
                     const uint32_t distance = currentNode._distance + ( newNodeIdx == flippedCurrentNodeIdx ? 0 : 1 );
 
-                    BattleNode & newNode = _cache[newNodeIdx];
+                    BattleNode & newNode = graph.nodes[getNodeIdx( newNodeIdx )];
                     if ( newNode._from == BattleNodeIndex{ -1, -1 } || newNode._cost > cost ) {
                         newNode.update( currentNodeIdx, cost, distance );
 
@@ -199,14 +272,14 @@ namespace Battle
                     }
 
                     const BattleNodeIndex newNodeIdx = { cellIdx, -1 };
-                    if ( newNodeIdx == _pathStart ) {
+                    if ( newNodeIdx == pathStart ) {
                         continue;
                     }
 
                     const uint32_t cost = currentNode._cost + movementPenalty;
                     const uint32_t distance = currentNode._distance + 1;
 
-                    BattleNode & newNode = _cache[newNodeIdx];
+                    BattleNode & newNode = graph.nodes[getNodeIdx( newNodeIdx )];
                     if ( newNode._from == BattleNodeIndex{ -1, -1 } || newNode._cost > cost ) {
                         newNode.update( currentNodeIdx, cost, distance );
 
@@ -217,6 +290,28 @@ namespace Battle
         }
     }
 
+    const std::bitset<Board::sizeInCells> & BattlePathfinder::getReachableHeadCells( Graph & graph, const uint32_t speed )
+    {
+        if ( graph.isReachableHeadCellsValid && graph.reachableHeadCellsSpeed == speed ) {
+            return graph.reachableHeadCells;
+        }
+
+        graph.reachableHeadCells.reset();
+
+        for ( size_t nodeIdx = 0; nodeIdx < graph.nodes.size(); ++nodeIdx ) {
+            if ( graph.getBattleNodeIndex( nodeIdx ) == graph.pathStart || !graph.isReached( nodeIdx ) || graph.nodes[nodeIdx]._cost > speed ) {
+                continue;
+            }
+
+            graph.reachableHeadCells.set( nodeIdx / 2 );
+        }
+
+        graph.reachableHeadCellsSpeed = speed;
+        graph.isReachableHeadCellsValid = true;
+
+        return graph.reachableHeadCells;
+    }
+
     bool BattlePathfinder::isPositionReachable( const Unit & unit, const Position & position, const bool isOnCurrentTurn )
     {
         // Invalid positions are allowed here, but they are always unreachable
@@ -224,111 +319,91 @@ namespace Battle
             return false;
         }
 
-        reEvaluateIfNeeded( unit );
-
-        const BattleNodeIndex nodeIdx = { position.GetHead()->GetIndex(), position.GetTail() ? position.GetTail()->GetIndex() : -1 };
+        const BattleNodeIndex nodeIdx = getBattleNodeIndex( position );
 
-        const auto iter = _cache.find( nodeIdx );
-        if ( iter == _cache.end() ) {
+        // Positions that don't match the unit's width are always unreachable
+        if ( unit.isWide() != ( nodeIdx.second != -1 ) ) {
             return false;
         }
 
-        const auto & [index, node] = *iter;
+        const Graph & graph = getGraph( unit );
+        const BattleNode & node = graph.nodes[getNodeIdx( nodeIdx )];
 
-        return ( index == _pathStart || node._from != BattleNodeIndex{ -1, -1 } ) && ( !isOnCurrentTurn || node._cost <= _speed );
+        return ( nodeIdx == graph.pathStart || node._from != BattleNodeIndex{ -1, -1 } ) && ( !isOnCurrentTurn || node._cost <= unit.GetSpeed() );
     }
 
     uint32_t BattlePathfinder::getCost( const Unit & unit, const Position & position )
     {
-        assert( position.GetHead() != nullptr );
-
-        reEvaluateIfNeeded( unit );
-
-        const BattleNodeIndex nodeIdx = { position.GetHead()->GetIndex(), position.GetTail() ? position.GetTail()->GetIndex() : -1 };
+        const BattleNodeIndex nodeIdx = getBattleNodeIndex( position );
 
-        const auto iter = _cache.find( nodeIdx );
-        assert( iter != _cache.end() );
+        const Graph & graph = getGraph( unit );
+        const BattleNode & node = graph.nodes[getNodeIdx( nodeIdx )];
 
-        const auto & [index, node] = *iter;
         // MSVC 2017 fails to properly expand the assert() macro without additional parentheses
-        assert( ( index == _pathStart || node._from != BattleNodeIndex{ -1, -1 } ) );
+        assert( ( nodeIdx == graph.pathStart || node._from != BattleNodeIndex{ -1, -1 } ) );
 
         return node._cost;
     }
 
     uint32_t BattlePathfinder::getDistance( const Unit & unit, const Position & position )
     {
-        assert( position.GetHead() != nullptr );
-
-        reEvaluateIfNeeded( unit );
+        const BattleNodeIndex nodeIdx = getBattleNodeIndex( position );
 
-        const BattleNodeIndex nodeIdx = { position.GetHead()->GetIndex(), position.GetTail() ? position.GetTail()->GetIndex() : -1 };
+        const Graph & graph = getGraph( unit );
+        const BattleNode & node = graph.nodes[getNodeIdx( nodeIdx )];
 
-        const auto iter = _cache.find( nodeIdx );
-        assert( iter != _cache.end() );
-
-        const auto & [index, node] = *iter;
         // MSVC 2017 fails to properly expand the assert() macro without additional parentheses
-        assert( ( index == _pathStart || node._from != BattleNodeIndex{ -1, -1 } ) );
+        assert( ( nodeIdx == graph.pathStart || node._from != BattleNodeIndex{ -1, -1 } ) );
 
         return node._distance;
     }
 
     Indexes BattlePathfinder::getAllAvailableMoves( const Unit & unit )
     {
-        reEvaluateIfNeeded( unit );
+        const std::bitset<Board::sizeInCells> & reachableHeadCells = getReachableHeadCells( getGraph( unit ), unit.GetSpeed() );
 
-        std::set<int32_t> boardIndexes;
+        Indexes result;
+        result.reserve( reachableHeadCells.count() );
 
-        for ( const auto & [index, node] : _cache ) {
-            if ( index == _pathStart || node._from == BattleNodeIndex{ -1, -1 } || node._cost > _speed ) {
-                continue;
+        for ( int32_t cellIdx = 0; cellIdx < Board::sizeInCells; ++cellIdx ) {
+            if ( reachableHeadCells.test( cellIdx ) ) {
+                result.push_back( cellIdx );
             }
-
-            assert( index.first != -1 );
-
-            boardIndexes.insert( index.first );
         }
 
-        Indexes result;
-
-        result.reserve( boardIndexes.size() );
-        result.assign( boardIndexes.begin(), boardIndexes.end() );
-
         return result;
     }
 
     Indexes BattlePathfinder::buildPath( const Unit & unit, const Position & position )
     {
-        assert( position.GetHead() != nullptr );
-
-        reEvaluateIfNeeded( unit );
+        const Graph & graph = getGraph( unit );
+        const uint32_t speed = unit.GetSpeed();
 
         Indexes result;
         result.reserve( Speed::INSTANT );
 
         BattleNodeIndex lastReachableNodeIdx{ -1, -1 };
-        BattleNodeIndex nodeIdx = { position.GetHead()->GetIndex(), position.GetTail() ? position.GetTail()->GetIndex() : -1 };
+        BattleNodeIndex nodeIdx = getBattleNodeIndex( position );
 
-        for ( auto iter = _cache.find( nodeIdx ); iter != _cache.end(); iter = _cache.find( nodeIdx ) ) {
-            const auto & [index, node] = *iter;
+        while ( nodeIdx != graph.pathStart ) {
+            const BattleNode & node = graph.nodes[getNodeIdx( nodeIdx )];
 
-            if ( index == _pathStart ) {
+            // Unreachable position
+            if ( node._from == BattleNodeIndex{ -1, -1 } ) {
                 break;
             }
 
-            // MSVC 2017 fails to properly expand the assert() macro without additional parentheses
-            assert( ( node._from != BattleNodeIndex{ -1, -1 } ) );
+            const BattleNodeIndex index = nodeIdx;
 
             nodeIdx = node._from;
 
             // A given position may be reachable in principle, but is not reachable on the current turn.
             // Skip the steps that are not reachable on this turn.
-            if ( node._cost > _speed ) {
+            if ( node._cost > speed ) {
                 continue;
             }
 
-            if ( _isWide && lastReachableNodeIdx == BattleNodeIndex{ -1, -1 } ) {
+            if ( graph.isWide && lastReachableNodeIdx == BattleNodeIndex{ -1, -1 } ) {
                 assert( index.first != -1 && index.second != -1 );
 
                 lastReachableNodeIdx = index;
@@ -341,7 +416,7 @@ namespace Battle
 
         // If a given position is not reachable on the current turn, then the last reachable position of
         // a wide unit may be reversed in regard to the target one. Detect this and add an extra U-turn.
-        if ( _isWide && !result.empty() ) {
+        if ( graph.isWide && !result.empty() ) {
             assert( lastReachableNodeIdx.first != -1 && lastReachableNodeIdx.second != -1 );
 
             const bool isReflect = lastReachableNodeIdx.first < lastReachableNodeIdx.second;
@@ -359,33 +434,32 @@ namespace Battle
 
     Position BattlePathfinder::getClosestReachablePosition( const Unit & unit, const Position & position )
     {
-        assert( position.GetHead() != nullptr );
-
-        reEvaluateIfNeeded( unit );
+        const Graph & graph = getGraph( unit );
+        const uint32_t speed = unit.GetSpeed();
 
-        BattleNodeIndex nodeIdx = { position.GetHead()->GetIndex(), position.GetTail() ? position.GetTail()->GetIndex() : -1 };
+        BattleNodeIndex nodeIdx = getBattleNodeIndex( position );
 
-        for ( auto iter = _cache.find( nodeIdx ); iter != _cache.end(); iter = _cache.find( nodeIdx ) ) {
-            const auto & [index, node] = *iter;
+        while ( nodeIdx != graph.pathStart ) {
+            const BattleNode & node = graph.nodes[getNodeIdx( nodeIdx )];
 
-            if ( index == _pathStart ) {
+            // Unreachable position
+            if ( node._from == BattleNodeIndex{ -1, -1 } ) {
                 break;
             }
 
-            // MSVC 2017 fails to properly expand the assert() macro without additional parentheses
-            assert( ( node._from != BattleNodeIndex{ -1, -1 } ) );
+            const BattleNodeIndex index = nodeIdx;
 
             nodeIdx = node._from;
 
             // A given position may be reachable in principle, but is not reachable on the current turn.
             // Skip the steps that are not reachable on this turn.
-            if ( node._cost > _speed ) {
+            if ( node._cost > speed ) {
                 continue;
             }
 
             Position result;
 
-            if ( _isWide ) {
+            if ( graph.isWide ) {
                 assert( index.first != -1 && index.second != -1 );
 
                 const bool isReflect = index.first < index.second;
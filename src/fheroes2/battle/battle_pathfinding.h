@@ -21,10 +21,11 @@
 #pragma once
 
 #include <array>
+#include <bitset>
 #include <cstddef>
 #include <cstdint>
-#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "battle_board.h"
 #include "color.h"
@@ -36,19 +37,6 @@ namespace Battle
 
     using BattleNodeIndex = std::pair<int32_t, int32_t>;
 
-    struct BattleNodeIndexHash final
-    {
-        std::size_t operator()( const BattleNodeIndex & index ) const noexcept
-        {
-            const uint64_t f = index.first;
-            const uint64_t s = index.second;
-
-            std::hash<uint64_t> hasher;
-
-            return hasher( ( f << 32 ) + s );
-        }
-    };
-
     struct BattleNode final
     {
         BattleNodeIndex _from{ -1, -1 };
@@ -106,19 +94,53 @@ namespace Battle
         Position getClosestReachablePosition( const Unit & unit, const Position & position );
 
     private:
-        // Rebuilds the graph of available positions for the given unit if necessary (if it is not already cached)
-        void reEvaluateIfNeeded( const Unit & unit );
-
-        std::unordered_map<BattleNodeIndex, BattleNode, BattleNodeIndexHash> _cache;
-
-        // Parameters of the unit for which the current cache is created
-        BattleNodeIndex _pathStart{ -1, -1 };
-        uint32_t _speed{ 0 };
-        bool _isWide{ false };
-        bool _isFlying{ false };
-        // The unit's color (or rather, the unit's army color) affects the ability to pass the castle bridge
-        PlayerColor _color{ PlayerColor::NONE };
-        // Board cells passability status at the time of current cache creation
+        // Graph of available positions for a unit. The graph doesn't depend on the unit's speed, which is only taken into account when
+        // checking the reachability on the current turn, so it is shared by all units with the same movement profile and starting position.
+        struct Graph final
+        {
+            // Parameters of the unit for which this graph is created
+            BattleNodeIndex pathStart{ -1, -1 };
+            bool isWide{ false };
+            bool isFlying{ false };
+            // The unit's color (or rather, the unit's army color) affects the ability to pass the castle bridge
+            PlayerColor color{ PlayerColor::NONE };
+
+            // Nodes are stored in a flat array, see getNodeIdx()
+            std::array<BattleNode, Board::sizeInCells * 2> nodes{};
+
+            // Cells that can be occupied by the unit's head on the current turn, evaluated for the given speed
+            std::bitset<Board::sizeInCells> reachableHeadCells;
+            uint32_t reachableHeadCellsSpeed{ 0 };
+            bool isReachableHeadCellsValid{ false };
+
+            // Value of the use counter at the moment of the last use, the least recently used graph is evicted first
+            uint32_t lastUse{ 0 };
+
+            bool isReached( const size_t nodeIdx ) const
+            {
+                return getBattleNodeIndex( nodeIdx ) == pathStart || nodes[nodeIdx]._from != BattleNodeIndex{ -1, -1 };
+            }
+
+            BattleNodeIndex getBattleNodeIndex( const size_t nodeIdx ) const;
+        };
+
+        // Nodes of narrow units are stored at even indexes, nodes of wide units are stored at even or odd indexes depending on which side
+        // of the head the tail is.
+        static size_t getNodeIdx( const BattleNodeIndex & index );
+
+        static BattleNodeIndex getBattleNodeIndex( const Position & position );
+
+        // Returns the graph of available positions for the given unit, building it if it is not already cached
+        Graph & getGraph( const Unit & unit );
+
+        static void buildGraph( Graph & graph, const Unit & unit );
+
+        static const std::bitset<Board::sizeInCells> & getReachableHeadCells( Graph & graph, const uint32_t speed );
+
+        std::vector<Graph> _graphs;
+        uint32_t _useCounter{ 0 };
+
+        // Board cells passability status at the time of creation of the cached graphs
         std::array<bool, Board::sizeInCells> _boardStatus{};
     };
 }
@@ -0,0 +1,112 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "battle_simulation.h"
+
+#include <cassert>
+
+#include "battle_arena.h"
+#include "battle_army.h"
+#include "heroes_base.h"
+#include "kingdom.h"
+#include "logging.h"
+#include "rand.h"
+#include "resource.h"
+#include "world.h"
+
+namespace
+{
+    // Everything outside the arena that a battle may change: the commander spends spell points, and the kingdom pays or receives gold when someone
+    // surrenders
+    class ArmyStateRestorer final
+    {
+    public:
+        explicit ArmyStateRestorer( Army & army )
+            : _commander( army.GetCommander() )
+        {
+            if ( _commander == nullptr ) {
+                return;
+            }
+
+            _spellPoints = _commander->GetSpellPoints();
+
+            _kingdom = &world.GetKingdom( army.GetColor() );
+            _funds = _kingdom->GetFunds();
+        }
+
+        ArmyStateRestorer( const ArmyStateRestorer & ) = delete;
+
+        ~ArmyStateRestorer()
+        {
+            if ( _commander == nullptr ) {
+                return;
+            }
+
+            _commander->SetSpellPoints( _spellPoints );
+
+            assert( _kingdom != nullptr );
+
+            const Funds fundsDiff = _kingdom->GetFunds() - _funds;
+            assert( _kingdom->AllowPayment( fundsDiff ) );
+
+            _kingdom->OddFundsResource( fundsDiff );
+        }
+
+        ArmyStateRestorer & operator=( const ArmyStateRestorer & ) = delete;
+
+    private:
+        HeroBase * _commander{ nullptr };
+        uint32_t _spellPoints{ 0 };
+
+        Kingdom * _kingdom{ nullptr };
+        Funds _funds;
+    };
+}
+
+Battle::SimulationResult Battle::Simulate( Army & attackingArmy, Army & defendingArmy, const int32_t tileIndex, const uint32_t seed, const uint32_t maxTurns )
+{
+    assert( attackingArmy.isValid() && defendingArmy.isValid() );
+
+    const ArmyStateRestorer attackingArmyRestorer( attackingArmy );
+    const ArmyStateRestorer defendingArmyRestorer( defendingArmy );
+
+    Rand::PCG32 randomGenerator( seed );
+    Arena arena( attackingArmy, defendingArmy, tileIndex, false, randomGenerator );
+
+    // The original armies are never synchronized with the arena, so the troops stay intact
+    while ( arena.BattleValid() && arena.GetTurnNumber() < maxTurns ) {
+        arena.Turns();
+    }
+
+    const bool isFinished = !arena.BattleValid();
+    if ( !isFinished ) {
+        DEBUG_LOG( DBG_BATTLE, DBG_INFO, "Simulated battle was stopped after " << arena.GetTurnNumber() << " turns" )
+    }
+
+    const UnitTable & unitTable = arena.getUnitTable();
+
+    SimulationResult result{ isFinished ? arena.GetResult() : Result{}, arena.getAttackingForce().GetKilledTroops(), arena.getDefendingForce().GetKilledTroops() };
+    result.attackerHitPoints = unitTable.getTotalHitPoints( true );
+    result.defenderHitPoints = unitTable.getTotalHitPoints( false );
+    result.numberOfTurns = arena.GetTurnNumber();
+    result.isFinished = isFinished;
+
+    return result;
+}
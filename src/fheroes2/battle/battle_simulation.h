@@ -0,0 +1,53 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+#include "army.h"
+#include "battle.h"
+
+namespace Battle
+{
+    struct SimulationResult
+    {
+        Result result;
+
+        // Troops killed in each army
+        Troops attackerLosses;
+        Troops defenderLosses;
+
+        // Hit points left in each army at the end of the battle
+        uint32_t attackerHitPoints{ 0 };
+        uint32_t defenderHitPoints{ 0 };
+
+        uint32_t numberOfTurns{ 0 };
+
+        // False if the battle was stopped because it exceeded the limit of turns. In this case the result doesn't contain the winner.
+        bool isFinished{ false };
+    };
+
+    // Runs the battle between the given armies on the given tile of the world map to its end without any user interface, the human players are
+    // replaced by the AI, as in the auto combat mode. Unlike Loader() this function doesn't change anything: the armies keep their troops, and the
+    // spell points of the army commanders as well as the funds of their kingdoms are restored after the battle, so the same battle can be simulated
+    // many times with different seeds. It can't be called while another battle is in progress.
+    SimulationResult Simulate( Army & attackingArmy, Army & defendingArmy, const int32_t tileIndex, const uint32_t seed, const uint32_t maxTurns = 100 );
+}
@@ -51,6 +51,7 @@
 #include "monster_anim.h"
 #include "monster_info.h"
 #include "morale.h"
+#include "network/state_hash.h"
 #include "rand.h"
 #include "resource.h"
 #include "skill.h"
@@ -251,6 +252,32 @@ std::string Battle::Unit::GetSpeedString() const
     return Troop::GetSpeedString( speed );
 }
 
+uint64_t Battle::Unit::getStateDigest() const
+{
+    uint64_t digest = 0;
+
+    const auto add = [&digest]( const uint64_t value ) { digest = Network::mixHash( digest ^ value ); };
+
+    add( _uid );
+    add( static_cast<uint64_t>( GetID() ) );
+    add( GetCount() );
+    add( _hitPoints );
+    add( _maxCount );
+    add( _deadCount );
+    add( _shotsLeft );
+    add( _disruptingRaysNum );
+    add( static_cast<uint64_t>( GetHeadIndex() ) );
+    add( _isReflected ? 1 : 0 );
+    add( modes );
+    add( static_cast<uint64_t>( GetCurrentColor() ) );
+
+    for ( const ModeDuration & affection : _affected ) {
+        add( ( static_cast<uint64_t>( affection.first ) << 32 ) | affection.second );
+    }
+
+    return digest;
+}
+
 uint32_t Battle::Unit::GetHitPointsLeft() const
 {
     return GetHitPoints() - ( GetCount() - 1 ) * Monster::GetHitPoints();
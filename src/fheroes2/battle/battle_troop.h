@@ -143,6 +143,9 @@ namespace Battle
 
         std::string String( const bool more = false ) const;
 
+        // Returns a digest of the unit state which affects the course of the battle. Used to detect changes of the battle state.
+        uint64_t getStateDigest() const;
+
         uint32_t GetUID() const
         {
             return _uid;
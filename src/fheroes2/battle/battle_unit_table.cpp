@@ -0,0 +1,105 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "battle_unit_table.h"
+
+#include <cassert>
+
+#include "battle_army.h"
+#include "battle_troop.h"
+#include "speed.h"
+
+void Battle::UnitTable::update( const Force & attackingArmy, const Force & defendingArmy )
+{
+    _clear();
+
+    for ( const Force * force : { &attackingArmy, &defendingArmy } ) {
+        const uint8_t isAttackingForce = ( force == &attackingArmy ) ? 1 : 0;
+
+        for ( Unit * unit : *force ) {
+            units.push_back( unit );
+            uids.push_back( unit->GetUID() );
+            counts.push_back( unit->GetCount() );
+            hitPoints.push_back( unit->GetHitPoints() );
+            headIndexes.push_back( unit->GetHeadIndex() );
+            speeds.push_back( unit->GetSpeed() );
+            armyColors.push_back( unit->GetArmyColor() );
+            isAttacker.push_back( isAttackingForce );
+        }
+    }
+}
+
+int32_t Battle::UnitTable::find( const uint32_t uid ) const
+{
+    for ( size_t i = 0; i < uids.size(); ++i ) {
+        if ( uids[i] == uid ) {
+            return static_cast<int32_t>( i );
+        }
+    }
+
+    return -1;
+}
+
+int32_t Battle::UnitTable::getFastest( const bool isAttackingSide, const std::vector<uint32_t> & unitSpeeds ) const
+{
+    assert( unitSpeeds.size() == isAttacker.size() );
+
+    const uint8_t side = isAttackingSide ? 1 : 0;
+
+    int32_t result = -1;
+    uint32_t bestSpeed = Speed::STANDING;
+
+    for ( size_t i = 0; i < unitSpeeds.size(); ++i ) {
+        // Strict comparison keeps the first of the units having the same speed, as the stable sort does. Dead units are always standing.
+        if ( isAttacker[i] == side && unitSpeeds[i] > bestSpeed ) {
+            bestSpeed = unitSpeeds[i];
+            result = static_cast<int32_t>( i );
+        }
+    }
+
+    return result;
+}
+
+uint32_t Battle::UnitTable::getTotalHitPoints( const bool isAttackingSide ) const
+{
+    const uint8_t side = isAttackingSide ? 1 : 0;
+
+    uint32_t result = 0;
+
+    for ( size_t i = 0; i < hitPoints.size(); ++i ) {
+        if ( isAttacker[i] == side ) {
+            result += hitPoints[i];
+        }
+    }
+
+    return result;
+}
+
+void Battle::UnitTable::_clear()
+{
+    units.clear();
+    uids.clear();
+    counts.clear();
+    hitPoints.clear();
+    headIndexes.clear();
+    speeds.clear();
+    armyColors.clear();
+    isAttacker.clear();
+}
@@ -0,0 +1,85 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "color.h"
+
+namespace Battle
+{
+    class Force;
+    class Unit;
+
+    // Flat copy of the unit fields used by simulation loops (turn order, AI scoring, headless battles). Each field is stored in its own
+    // array in the same order as the units of the attacking army followed by the units of the defending army, so a loop over one field
+    // doesn't load the rest of the unit. The table is a snapshot: it is refreshed by the arena and must not be used while an action is
+    // being applied.
+    class UnitTable
+    {
+    public:
+        UnitTable() = default;
+        UnitTable( const UnitTable & ) = delete;
+
+        ~UnitTable() = default;
+
+        UnitTable & operator=( const UnitTable & ) = delete;
+
+        // Copies the current state of all units of both armies, including the dead ones. Storage is reused between calls.
+        void update( const Force & attackingArmy, const Force & defendingArmy );
+
+        size_t size() const
+        {
+            return units.size();
+        }
+
+        // Returns the position of the unit with the given UID, or -1 if there is no such unit.
+        int32_t find( const uint32_t uid ) const;
+
+        // Returns the position of the first unit of the given side having the highest speed among the units able to act, or -1 if there is
+        // no such unit. This is the unit that Units::SortFastest() would put first. The speeds are taken from the given array, which must be
+        // of the same size as the table, so that the caller can exclude units by setting their speed to Speed::STANDING.
+        int32_t getFastest( const bool isAttackingSide, const std::vector<uint32_t> & unitSpeeds ) const;
+
+        int32_t getFastest( const bool isAttackingSide ) const
+        {
+            return getFastest( isAttackingSide, speeds );
+        }
+
+        // Total hit points of the alive units of the given side.
+        uint32_t getTotalHitPoints( const bool isAttackingSide ) const;
+
+        std::vector<Unit *> units;
+        std::vector<uint32_t> uids;
+        std::vector<uint32_t> counts;
+        std::vector<uint32_t> hitPoints;
+        std::vector<int32_t> headIndexes;
+        // Current speed as returned by Unit::GetSpeed(), it is Speed::STANDING for units which can't act on this turn.
+        std::vector<uint32_t> speeds;
+        std::vector<PlayerColor> armyColors;
+        std::vector<uint8_t> isAttacker;
+
+    private:
+        void _clear();
+    };
+}
@@ -1219,10 +1219,8 @@ BuildingStatus Castle::CheckBuyBuilding( const uint32_t build ) const
 
     const uint32_t requirement = fheroes2::getBuildingRequirement( _race, static_cast<BuildingType>( build ) );
 
-    for ( uint32_t itr = 0x00000001; itr; itr <<= 1 ) {
-        if ( ( requirement & itr ) && !( _constructedBuildings & itr ) ) {
-            return BuildingStatus::REQUIRES_BUILD;
-        }
+    if ( ( requirement & _constructedBuildings ) != requirement ) {
+        return BuildingStatus::REQUIRES_BUILD;
     }
 
     if ( !GetKingdom().AllowPayment( PaymentConditions::BuyBuilding( _race, build ) ) ) {
@@ -1241,21 +1239,45 @@ BuildingStatus Castle::GetAllBuildingStatus( const Castle & castle )
 
     const uint32_t rest = ~castle._constructedBuildings;
 
-    for ( uint32_t itr = 0x00000001; itr; itr <<= 1 )
-        if ( ( rest & itr ) && ( BuildingStatus::ALLOW_BUILD == castle.CheckBuyBuilding( itr ) ) )
+    // Statuses are checked in a single pass and the most favorable one is kept: ALLOW_BUILD, then LACK_RESOURCES, then REQUIRES_BUILD.
+    bool isLackOfResources = false;
+    bool isRequirementMissing = false;
+
+    for ( uint32_t itr = 0x00000001; itr; itr <<= 1 ) {
+        if ( !( rest & itr ) ) {
+            continue;
+        }
+
+        switch ( castle.CheckBuyBuilding( itr ) ) {
+        case BuildingStatus::ALLOW_BUILD:
             return BuildingStatus::ALLOW_BUILD;
+        case BuildingStatus::LACK_RESOURCES:
+            isLackOfResources = true;
+            break;
+        case BuildingStatus::REQUIRES_BUILD:
+            isRequirementMissing = true;
+            break;
+        default:
+            break;
+        }
+    }
 
-    for ( uint32_t itr = 0x00000001; itr; itr <<= 1 )
-        if ( ( rest & itr ) && ( BuildingStatus::LACK_RESOURCES == castle.CheckBuyBuilding( itr ) ) )
-            return BuildingStatus::LACK_RESOURCES;
+    if ( isLackOfResources ) {
+        return BuildingStatus::LACK_RESOURCES;
+    }
 
-    for ( uint32_t itr = 0x00000001; itr; itr <<= 1 )
-        if ( ( rest & itr ) && ( BuildingStatus::REQUIRES_BUILD == castle.CheckBuyBuilding( itr ) ) )
-            return BuildingStatus::REQUIRES_BUILD;
+    if ( isRequirementMissing ) {
+        return BuildingStatus::REQUIRES_BUILD;
+    }
 
     return BuildingStatus::UNKNOWN_COND;
 }
 
+uint32_t Castle::getBuildingsWithMetRequirements() const
+{
+    return fheroes2::getBuildingsWithMetRequirements( _race, _constructedBuildings ) & ~_constructedBuildings & ~_disabledBuildings;
+}
+
 bool Castle::BuyBuilding( const uint32_t buildingType )
 {
     if ( !AllowBuyBuilding( buildingType ) ) {
@@ -1269,6 +1291,7 @@ bool Castle::BuyBuilding( const uint32_t buildingType )
     switch ( buildingType ) {
     case BUILD_CASTLE:
         _constructedBuildings &= ~BUILD_TENT;
+        GetKingdom().updateCastleCounters();
         Maps::UpdateCastleSprite( GetCenter(), _race );
         Maps::ClearFog( GetIndex(), GameStatic::getFogDiscoveryDistance( GameStatic::FogDiscoveryType::CASTLE ), GetColor() );
         break;
@@ -322,8 +322,16 @@ public:
         return ( _constructedBuildings & buildingType ) != 0;
     }
 
+    uint32_t getConstructedBuildings() const
+    {
+        return _constructedBuildings;
+    }
+
     bool BuyBuilding( const uint32_t buildingType );
 
+    // Returns a bit mask of buildings which are neither built nor disabled and whose required buildings are already constructed.
+    uint32_t getBuildingsWithMetRequirements() const;
+
     BuildingStatus CheckBuyBuilding( const uint32_t build ) const;
     static BuildingStatus GetAllBuildingStatus( const Castle & castle );
 
@@ -519,8 +527,13 @@ namespace CastleDialog
         BuildingsRenderQueue( const Castle & castle, const fheroes2::Point & top );
     };
 
+    // The first frame of the town (animation index 0 without a fading building) is cached for the last visited towns, so opening
+    // a town again only needs to copy it.
     void redrawAllBuildings( const Castle & castle, const fheroes2::Point & offset, const BuildingsRenderQueue & buildings,
                              const CastleDialog::FadeBuilding & alphaBuilding, const uint32_t animationIndex );
+
+    // Returns the list of ICNs required to render the town background and the buildings of the given castle.
+    std::vector<int> getIcnManifest( const Castle & castle );
 }
 
 struct VecCastles : public std::vector<Castle *>
@@ -24,16 +24,21 @@
 #include <algorithm>
 #include <cassert>
 #include <cstdint>
+#include <list>
+#include <map>
+#include <utility>
 #include <vector>
 
 #include "agg_image.h"
 #include "castle.h" // IWYU pragma: associated
 #include "castle_building_info.h"
+#include "color.h"
 #include "game_delays.h"
 #include "icn.h"
 #include "image.h"
 #include "maps_fileinfo.h"
 #include "math_base.h"
+#include "profiler.h"
 #include "race.h"
 #include "screen.h"
 #include "settings.h"
@@ -64,6 +69,84 @@ namespace
         return ICN::UNKNOWN;
     }
 
+    // Drawing order and areas of all buildings of a race, relative to the town background. They never change so they are looked up
+    // only once per race and game version.
+    const std::vector<CastleDialog::BuildingRenderInfo> & getRaceBuildings( const int race, const GameVersion version )
+    {
+        static std::map<std::pair<int, GameVersion>, std::vector<CastleDialog::BuildingRenderInfo>> raceBuildings;
+
+        const auto [iter, isInserted] = raceBuildings.try_emplace( std::make_pair( race, version ) );
+        if ( isInserted ) {
+            for ( const BuildingType buildingId : fheroes2::getBuildingDrawingPriorities( race, version ) ) {
+                iter->second.emplace_back( buildingId, fheroes2::getCastleBuildingArea( race, buildingId ) );
+            }
+        }
+
+        return iter->second;
+    }
+
+    // Everything that affects the look of the first frame of the town.
+    struct TownImageKey
+    {
+        explicit TownImageKey( const Castle & castle )
+            : race( castle.GetRace() )
+            , version( Settings::Get().getCurrentMapInfo().version )
+            , buildings( castle.getConstructedBuildings() )
+            , color( castle.GetColor() )
+            , hasSeaAccess( castle.HasSeaAccess() )
+            , hasBoatNearby( castle.HasBoatNearby() )
+        {
+            // Do nothing.
+        }
+
+        bool operator==( const TownImageKey & other ) const
+        {
+            return race == other.race && version == other.version && buildings == other.buildings && color == other.color && hasSeaAccess == other.hasSeaAccess
+                   && hasBoatNearby == other.hasBoatNearby;
+        }
+
+        int race;
+        GameVersion version;
+        uint32_t buildings;
+        PlayerColor color;
+        bool hasSeaAccess;
+        bool hasBoatNearby;
+    };
+
+    // The first frames of the last visited towns. Players open the same towns many times per turn, mostly without any changes.
+    class TownImageCache
+    {
+    public:
+        const fheroes2::Image * get( const TownImageKey & key )
+        {
+            for ( auto iter = _entries.begin(); iter != _entries.end(); ++iter ) {
+                if ( iter->first == key ) {
+                    // Move the entry to the front as the most recently used one.
+                    _entries.splice( _entries.begin(), _entries, iter );
+                    return &_entries.front().second;
+                }
+            }
+
+            return nullptr;
+        }
+
+        void add( const TownImageKey & key, fheroes2::Image image )
+        {
+            _entries.emplace_front( key, std::move( image ) );
+
+            if ( _entries.size() > maxEntries ) {
+                _entries.pop_back();
+            }
+        }
+
+    private:
+        static constexpr size_t maxEntries = 8;
+
+        std::list<std::pair<TownImageKey, fheroes2::Image>> _entries;
+    };
+
+    TownImageCache townImageCache;
+
     fheroes2::Rect CastleGetMaxArea( const Castle & castle, const fheroes2::Point & top )
     {
         const fheroes2::Sprite & townbkg = fheroes2::AGG::GetICN( getTownIcnId( castle.GetRace() ), 0 );
@@ -463,17 +546,37 @@ namespace
 
 CastleDialog::BuildingsRenderQueue::BuildingsRenderQueue( const Castle & castle, const fheroes2::Point & top )
 {
-    const int castleRace = castle.GetRace();
-    const std::vector<BuildingType> ordersBuildings = fheroes2::getBuildingDrawingPriorities( castleRace, Settings::Get().getCurrentMapInfo().version );
+    const std::vector<BuildingRenderInfo> & raceBuildings = getRaceBuildings( castle.GetRace(), Settings::Get().getCurrentMapInfo().version );
+
+    reserve( raceBuildings.size() );
 
-    for ( const BuildingType buildingId : ordersBuildings ) {
-        auto areas = fheroes2::getCastleBuildingArea( castleRace, buildingId );
-        for ( auto & area : areas ) {
+    for ( const BuildingRenderInfo & building : raceBuildings ) {
+        std::vector<fheroes2::Rect> areas = building.areas;
+        for ( fheroes2::Rect & area : areas ) {
             area = area + top;
         }
 
-        emplace_back( buildingId, std::move( areas ) );
+        emplace_back( building.id, std::move( areas ) );
+    }
+}
+
+std::vector<int> CastleDialog::getIcnManifest( const Castle & castle )
+{
+    const int castleRace = castle.GetRace();
+
+    std::vector<int> icnIds{ getTownIcnId( castleRace ) };
+
+    for ( const BuildingType buildingId : fheroes2::getBuildingDrawingPriorities( castleRace, Settings::Get().getCurrentMapInfo().version ) ) {
+        if ( castle.isBuild( buildingId ) ) {
+            icnIds.emplace_back( Castle::GetICNBuilding( buildingId, castleRace ) );
+        }
+    }
+
+    if ( castle.isBuild( BUILD_SHIPYARD ) ) {
+        icnIds.emplace_back( Castle::GetICNBoat( castleRace ) );
     }
+
+    return icnIds;
 }
 
 bool CastleDialog::FadeBuilding::updateFadeAlpha()
@@ -495,6 +598,31 @@ bool CastleDialog::FadeBuilding::updateFadeAlpha()
 void CastleDialog::redrawAllBuildings( const Castle & castle, const fheroes2::Point & offset, const BuildingsRenderQueue & buildings,
                                        const CastleDialog::FadeBuilding & alphaBuilding, const uint32_t animationIndex )
 {
-    redrawCastleBuildings( castle, offset, buildings, alphaBuilding, animationIndex );
-    fheroes2::drawCastleName( castle, fheroes2::Display::instance(), offset );
+    const fheroes2::ProfilerScopedTimer redrawTimer( fheroes2::ProfilerSection::CASTLE_SCREEN );
+
+    fheroes2::Display & display = fheroes2::Display::instance();
+
+    if ( animationIndex != 0 || alphaBuilding.getBuilding() != BUILD_NOTHING ) {
+        redrawCastleBuildings( castle, offset, buildings, alphaBuilding, animationIndex );
+        fheroes2::drawCastleName( castle, display, offset );
+        return;
+    }
+
+    const TownImageKey key( castle );
+    const fheroes2::Rect roi = CastleGetMaxArea( castle, offset );
+
+    if ( const fheroes2::Image * cachedImage = townImageCache.get( key ); cachedImage != nullptr ) {
+        fheroes2::Copy( *cachedImage, 0, 0, display, roi.x, roi.y, roi.width, roi.height );
+    }
+    else {
+        redrawCastleBuildings( castle, offset, buildings, alphaBuilding, animationIndex );
+
+        fheroes2::Image townImage( roi.width, roi.height );
+        townImage._disableTransformLayer();
+        fheroes2::Copy( display, roi.x, roi.y, townImage, 0, 0, roi.width, roi.height );
+
+        townImageCache.add( key, std::move( townImage ) );
+    }
+
+    fheroes2::drawCastleName( castle, display, offset );
 }
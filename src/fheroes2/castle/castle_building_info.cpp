@@ -20,7 +20,9 @@
 
 #include "castle_building_info.h"
 
+#include <array>
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 
 #include "maps_fileinfo.h"
@@ -799,6 +801,312 @@ namespace
         assert( 0 );
         return nullptr;
     }
+
+    uint32_t calculateBuildingRequirement( const int race, const BuildingType building )
+    {
+        uint32_t requirement = 0;
+
+        switch ( building ) {
+        case BUILD_SPEC:
+            if ( race == Race::WZRD ) {
+                requirement |= BUILD_MAGEGUILD1;
+            }
+            break;
+
+        case DWELLING_MONSTER2:
+            switch ( race ) {
+            case Race::KNGT:
+            case Race::BARB:
+            case Race::WZRD:
+            case Race::WRLK:
+            case Race::NECR:
+                requirement |= DWELLING_MONSTER1;
+                break;
+
+            case Race::SORC:
+                requirement |= DWELLING_MONSTER1;
+                requirement |= BUILD_TAVERN;
+                break;
+
+            default:
+                break;
+            }
+            break;
+
+        case DWELLING_MONSTER3:
+            switch ( race ) {
+            case Race::KNGT:
+                requirement |= DWELLING_MONSTER1;
+                requirement |= BUILD_WELL;
+                break;
+
+            case Race::BARB:
+            case Race::SORC:
+            case Race::WZRD:
+            case Race::WRLK:
+            case Race::NECR:
+                requirement |= DWELLING_MONSTER1;
+                break;
+
+            default:
+                break;
+            }
+            break;
+
+        case DWELLING_MONSTER4:
+            switch ( race ) {
+            case Race::KNGT:
+                requirement |= DWELLING_MONSTER1;
+                requirement |= BUILD_TAVERN;
+                break;
+
+            case Race::BARB:
+                requirement |= DWELLING_MONSTER1;
+                break;
+
+            case Race::SORC:
+                requirement |= DWELLING_MONSTER3;
+                requirement |= BUILD_MAGEGUILD1;
+                break;
+
+            case Race::WZRD:
+            case Race::WRLK:
+                requirement |= DWELLING_MONSTER2;
+                break;
+
+            case Race::NECR:
+                requirement |= DWELLING_MONSTER3;
+                requirement |= BUILD_THIEVESGUILD;
+                break;
+
+            default:
+                break;
+            }
+            break;
+
+        case DWELLING_MONSTER5:
+            switch ( race ) {
+            case Race::KNGT:
+            case Race::BARB:
+                requirement |= DWELLING_MONSTER2;
+                requirement |= DWELLING_MONSTER3;
+                requirement |= DWELLING_MONSTER4;
+                break;
+
+            case Race::SORC:
+                requirement |= DWELLING_MONSTER4;
+                break;
+
+            case Race::WRLK:
+                requirement |= DWELLING_MONSTER3;
+                break;
+
+            case Race::WZRD:
+                requirement |= DWELLING_MONSTER3;
+                requirement |= BUILD_MAGEGUILD1;
+                break;
+
+            case Race::NECR:
+                requirement |= DWELLING_MONSTER2;
+                requirement |= BUILD_MAGEGUILD1;
+                break;
+
+            default:
+                break;
+            }
+            break;
+
+        case DWELLING_MONSTER6:
+            switch ( race ) {
+            case Race::KNGT:
+                requirement |= DWELLING_MONSTER2;
+                requirement |= DWELLING_MONSTER3;
+                requirement |= DWELLING_MONSTER4;
+                break;
+
+            case Race::BARB:
+            case Race::SORC:
+            case Race::NECR:
+                requirement |= DWELLING_MONSTER5;
+                break;
+
+            case Race::WRLK:
+            case Race::WZRD:
+                requirement |= DWELLING_MONSTER4;
+                requirement |= DWELLING_MONSTER5;
+                break;
+
+            default:
+                break;
+            }
+            break;
+
+        case DWELLING_UPGRADE2:
+            switch ( race ) {
+            case Race::KNGT:
+            case Race::BARB:
+                requirement |= DWELLING_MONSTER2;
+                requirement |= DWELLING_MONSTER3;
+                requirement |= DWELLING_MONSTER4;
+                break;
+
+            case Race::SORC:
+                requirement |= DWELLING_MONSTER2;
+                requirement |= BUILD_WELL;
+                break;
+
+            case Race::NECR:
+                requirement |= DWELLING_MONSTER2;
+                break;
+
+            default:
+                break;
+            }
+            break;
+
+        case DWELLING_UPGRADE3:
+            switch ( race ) {
+            case Race::KNGT:
+                requirement |= DWELLING_MONSTER2;
+                requirement |= DWELLING_MONSTER3;
+                requirement |= DWELLING_MONSTER4;
+                break;
+
+            case Race::SORC:
+                requirement |= DWELLING_MONSTER3;
+                requirement |= DWELLING_MONSTER4;
+                break;
+
+            case Race::WZRD:
+                requirement |= DWELLING_MONSTER3;
+                requirement |= BUILD_WELL;
+                break;
+
+            case Race::NECR:
+                requirement |= DWELLING_MONSTER3;
+                break;
+
+            default:
+                break;
+            }
+            break;
+
+        case DWELLING_UPGRADE4:
+            switch ( race ) {
+            case Race::KNGT:
+            case Race::BARB:
+                requirement |= DWELLING_MONSTER2;
+                requirement |= DWELLING_MONSTER3;
+                requirement |= DWELLING_MONSTER4;
+                break;
+
+            case Race::SORC:
+            case Race::WRLK:
+            case Race::NECR:
+                requirement |= DWELLING_MONSTER4;
+                break;
+
+            default:
+                break;
+            }
+            break;
+
+        case DWELLING_UPGRADE5:
+            switch ( race ) {
+            case Race::KNGT:
+            case Race::BARB:
+                requirement |= DWELLING_MONSTER5;
+                break;
+
+            case Race::WZRD:
+                requirement |= BUILD_SPEC;
+                requirement |= DWELLING_MONSTER5;
+                break;
+
+            case Race::NECR:
+                requirement |= BUILD_MAGEGUILD2;
+                requirement |= DWELLING_MONSTER5;
+                break;
+
+            default:
+                break;
+            }
+            break;
+
+        case DWELLING_UPGRADE6:
+            switch ( race ) {
+            case Race::KNGT:
+            case Race::WRLK:
+            case Race::WZRD:
+                requirement |= DWELLING_MONSTER6;
+                break;
+
+            default:
+                break;
+            }
+            break;
+        case DWELLING_UPGRADE7:
+            if ( race == Race::WRLK )
+                requirement |= DWELLING_UPGRADE6;
+            break;
+
+        default:
+            break;
+        }
+
+        return requirement;
+    }
+
+    // Number of playable races. Race IDs are single bits starting from Race::KNGT.
+    const size_t raceCount = 6;
+
+    // Requirements of every building of every race as bit masks. The table is indexed by the race index and the bit position of the building.
+    using BuildingRequirementTable = std::array<std::array<uint32_t, 32>, raceCount>;
+
+    int getRaceIndex( const int race )
+    {
+        for ( size_t i = 0; i < raceCount; ++i ) {
+            if ( race == ( Race::KNGT << i ) ) {
+                return static_cast<int>( i );
+            }
+        }
+
+        return -1;
+    }
+
+    int getBuildingBitPosition( const uint32_t building )
+    {
+        if ( building == 0 || ( building & ( building - 1 ) ) != 0 ) {
+            // Not a single building.
+            return -1;
+        }
+
+        int position = 0;
+        for ( uint32_t value = building; value > 1; value >>= 1 ) {
+            ++position;
+        }
+
+        return position;
+    }
+
+    const BuildingRequirementTable & getBuildingRequirementTable()
+    {
+        static const BuildingRequirementTable table = []() {
+            BuildingRequirementTable result{};
+
+            for ( size_t raceId = 0; raceId < raceCount; ++raceId ) {
+                const int race = Race::KNGT << raceId;
+
+                for ( size_t bit = 0; bit < result[raceId].size(); ++bit ) {
+                    result[raceId][bit] = calculateBuildingRequirement( race, static_cast<BuildingType>( 1U << bit ) );
+                }
+            }
+
+            return result;
+        }();
+
+        return table;
+    }
 }
 
 namespace fheroes2
@@ -1096,257 +1404,32 @@ namespace fheroes2
 
     BuildingType getBuildingRequirement( const int race, const BuildingType building )
     {
-        uint32_t requirement = 0;
-
-        switch ( building ) {
-        case BUILD_SPEC:
-            if ( race == Race::WZRD ) {
-                requirement |= BUILD_MAGEGUILD1;
-            }
-            break;
-
-        case DWELLING_MONSTER2:
-            switch ( race ) {
-            case Race::KNGT:
-            case Race::BARB:
-            case Race::WZRD:
-            case Race::WRLK:
-            case Race::NECR:
-                requirement |= DWELLING_MONSTER1;
-                break;
-
-            case Race::SORC:
-                requirement |= DWELLING_MONSTER1;
-                requirement |= BUILD_TAVERN;
-                break;
-
-            default:
-                break;
-            }
-            break;
-
-        case DWELLING_MONSTER3:
-            switch ( race ) {
-            case Race::KNGT:
-                requirement |= DWELLING_MONSTER1;
-                requirement |= BUILD_WELL;
-                break;
-
-            case Race::BARB:
-            case Race::SORC:
-            case Race::WZRD:
-            case Race::WRLK:
-            case Race::NECR:
-                requirement |= DWELLING_MONSTER1;
-                break;
-
-            default:
-                break;
-            }
-            break;
-
-        case DWELLING_MONSTER4:
-            switch ( race ) {
-            case Race::KNGT:
-                requirement |= DWELLING_MONSTER1;
-                requirement |= BUILD_TAVERN;
-                break;
-
-            case Race::BARB:
-                requirement |= DWELLING_MONSTER1;
-                break;
-
-            case Race::SORC:
-                requirement |= DWELLING_MONSTER3;
-                requirement |= BUILD_MAGEGUILD1;
-                break;
-
-            case Race::WZRD:
-            case Race::WRLK:
-                requirement |= DWELLING_MONSTER2;
-                break;
-
-            case Race::NECR:
-                requirement |= DWELLING_MONSTER3;
-                requirement |= BUILD_THIEVESGUILD;
-                break;
-
-            default:
-                break;
-            }
-            break;
-
-        case DWELLING_MONSTER5:
-            switch ( race ) {
-            case Race::KNGT:
-            case Race::BARB:
-                requirement |= DWELLING_MONSTER2;
-                requirement |= DWELLING_MONSTER3;
-                requirement |= DWELLING_MONSTER4;
-                break;
-
-            case Race::SORC:
-                requirement |= DWELLING_MONSTER4;
-                break;
-
-            case Race::WRLK:
-                requirement |= DWELLING_MONSTER3;
-                break;
-
-            case Race::WZRD:
-                requirement |= DWELLING_MONSTER3;
-                requirement |= BUILD_MAGEGUILD1;
-                break;
-
-            case Race::NECR:
-                requirement |= DWELLING_MONSTER2;
-                requirement |= BUILD_MAGEGUILD1;
-                break;
-
-            default:
-                break;
-            }
-            break;
-
-        case DWELLING_MONSTER6:
-            switch ( race ) {
-            case Race::KNGT:
-                requirement |= DWELLING_MONSTER2;
-                requirement |= DWELLING_MONSTER3;
-                requirement |= DWELLING_MONSTER4;
-                break;
-
-            case Race::BARB:
-            case Race::SORC:
-            case Race::NECR:
-                requirement |= DWELLING_MONSTER5;
-                break;
-
-            case Race::WRLK:
-            case Race::WZRD:
-                requirement |= DWELLING_MONSTER4;
-                requirement |= DWELLING_MONSTER5;
-                break;
-
-            default:
-                break;
-            }
-            break;
-
-        case DWELLING_UPGRADE2:
-            switch ( race ) {
-            case Race::KNGT:
-            case Race::BARB:
-                requirement |= DWELLING_MONSTER2;
-                requirement |= DWELLING_MONSTER3;
-                requirement |= DWELLING_MONSTER4;
-                break;
-
-            case Race::SORC:
-                requirement |= DWELLING_MONSTER2;
-                requirement |= BUILD_WELL;
-                break;
-
-            case Race::NECR:
-                requirement |= DWELLING_MONSTER2;
-                break;
-
-            default:
-                break;
-            }
-            break;
-
-        case DWELLING_UPGRADE3:
-            switch ( race ) {
-            case Race::KNGT:
-                requirement |= DWELLING_MONSTER2;
-                requirement |= DWELLING_MONSTER3;
-                requirement |= DWELLING_MONSTER4;
-                break;
-
-            case Race::SORC:
-                requirement |= DWELLING_MONSTER3;
-                requirement |= DWELLING_MONSTER4;
-                break;
-
-            case Race::WZRD:
-                requirement |= DWELLING_MONSTER3;
-                requirement |= BUILD_WELL;
-                break;
-
-            case Race::NECR:
-                requirement |= DWELLING_MONSTER3;
-                break;
-
-            default:
-                break;
-            }
-            break;
-
-        case DWELLING_UPGRADE4:
-            switch ( race ) {
-            case Race::KNGT:
-            case Race::BARB:
-                requirement |= DWELLING_MONSTER2;
-                requirement |= DWELLING_MONSTER3;
-                requirement |= DWELLING_MONSTER4;
-                break;
-
-            case Race::SORC:
-            case Race::WRLK:
-            case Race::NECR:
-                requirement |= DWELLING_MONSTER4;
-                break;
-
-            default:
-                break;
-            }
-            break;
-
-        case DWELLING_UPGRADE5:
-            switch ( race ) {
-            case Race::KNGT:
-            case Race::BARB:
-                requirement |= DWELLING_MONSTER5;
-                break;
-
-            case Race::WZRD:
-                requirement |= BUILD_SPEC;
-                requirement |= DWELLING_MONSTER5;
-                break;
+        const int raceId = getRaceIndex( race );
+        const int bit = getBuildingBitPosition( building );
+        if ( raceId < 0 || bit < 0 ) {
+            return static_cast<BuildingType>( calculateBuildingRequirement( race, building ) );
+        }
 
-            case Race::NECR:
-                requirement |= BUILD_MAGEGUILD2;
-                requirement |= DWELLING_MONSTER5;
-                break;
+        return static_cast<BuildingType>( getBuildingRequirementTable()[raceId][bit] );
+    }
 
-            default:
-                break;
-            }
-            break;
+    uint32_t getBuildingsWithMetRequirements( const int race, const uint32_t constructedBuildings )
+    {
+        const int raceId = getRaceIndex( race );
+        if ( raceId < 0 ) {
+            return 0;
+        }
 
-        case DWELLING_UPGRADE6:
-            switch ( race ) {
-            case Race::KNGT:
-            case Race::WRLK:
-            case Race::WZRD:
-                requirement |= DWELLING_MONSTER6;
-                break;
+        const std::array<uint32_t, 32> & requirements = getBuildingRequirementTable()[raceId];
 
-            default:
-                break;
+        uint32_t buildings = 0;
+        for ( size_t bit = 0; bit < requirements.size(); ++bit ) {
+            if ( ( requirements[bit] & constructedBuildings ) == requirements[bit] ) {
+                buildings |= ( 1U << bit );
             }
-            break;
-        case DWELLING_UPGRADE7:
-            if ( race == Race::WRLK )
-                requirement |= DWELLING_UPGRADE6;
-            break;
-
-        default:
-            break;
         }
 
-        return static_cast<BuildingType>( requirement );
+        return buildings;
     }
 
     std::string getBuildingRequirementString( const int race, const BuildingType building )
@@ -42,6 +42,10 @@ namespace fheroes2
 
     BuildingType getBuildingRequirement( const int race, const BuildingType building );
 
+    // Returns a bit mask of all buildings of the given race whose requirements are satisfied by the given constructed buildings.
+    // Other conditions like money, the day limit or the presence of a castle are not taken into account.
+    uint32_t getBuildingsWithMetRequirements( const int race, const uint32_t constructedBuildings );
+
     std::string getBuildingRequirementString( const int race, const BuildingType building );
 
     int getIndexBuildingSprite( const BuildingType build );
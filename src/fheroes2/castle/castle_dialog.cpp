@@ -244,6 +244,9 @@ Castle::CastleDialogReturnValue Castle::OpenDialog( const bool openConstructionW
         restorer = std::make_unique<fheroes2::ImageRestorer>( display, dialogRoi.x, dialogRoi.y, dialogRoi.width, dialogRoi.height );
     }
 
+    // Decode the castle images while the previous screen fades out.
+    fheroes2::AGG::prefetchICNs( CastleDialog::getIcnManifest( *this ) );
+
     // Fade-out game screen only for 640x480 resolution and if 'renderBackgroundDialog' is false (we are replacing image in already opened dialog).
     const bool isDefaultScreenSize = display.isDefaultSize();
     if ( fade && ( isDefaultScreenSize || !renderBackgroundDialog ) ) {
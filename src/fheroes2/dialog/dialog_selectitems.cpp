@@ -29,6 +29,7 @@
 #include <cstddef>
 #include <initializer_list>
 #include <iterator>
+#include <map>
 #include <numeric>
 #include <utility>
 
@@ -101,7 +102,7 @@ namespace
 
         void RedrawItem( const int32_t & index, int32_t dstx, int32_t dsty, bool current ) override
         {
-            renderItem( getImage( index ), Monster{ index }.GetName(), { dstx, dsty }, 45 / 2, 50, _offsetY / 2, current );
+            renderItem( _getListImage( index ), Monster{ index }.GetName(), { dstx, dsty }, 45 / 2, 50, _offsetY / 2, current );
         }
 
         void ActionListPressRight( int32_t & index ) override
@@ -115,6 +116,18 @@ namespace
             Dialog::ArmyInfo( Troop( monster, 0 ), Dialog::ZERO );
         }
 
+    protected:
+        // Must be called when the images returned by getImage() are changed.
+        void resetListImage( const int32_t index )
+        {
+            _imageCache.erase( index );
+        }
+
+        void resetListImages()
+        {
+            _imageCache.clear();
+        }
+
     private:
         static const int32_t _offsetY{ 43 };
 
@@ -124,6 +137,20 @@ namespace
             const fheroes2::Sprite & monsterSprite = fheroes2::AGG::GetICN( ICN::MONS32, mons.GetSpriteIndex() );
             return renderMonsterOnBackground( monsterSprite );
         }
+
+        // Rendering a monster on its background is too slow to be done on every list redraw.
+        // Only the images of the visible items are generated and they are kept until the dialog is closed.
+        const fheroes2::Sprite & _getListImage( const int32_t index )
+        {
+            auto [iter, isEmplaced] = _imageCache.try_emplace( index );
+            if ( isEmplaced ) {
+                iter->second = getImage( index );
+            }
+
+            return iter->second;
+        }
+
+        std::map<int32_t, fheroes2::Sprite> _imageCache;
     };
 
     class MultiMonsterSelection final : public SelectEnumMonster
@@ -180,6 +207,8 @@ namespace
                 _selected.emplace( id );
             }
 
+            resetListImages();
+
             setButtonOkayStatus( true );
         }
 
@@ -187,6 +216,8 @@ namespace
         {
             _selected = {};
 
+            resetListImages();
+
             setButtonOkayStatus( false );
         }
 
@@ -205,6 +236,8 @@ namespace
                 _selected.erase( id );
             }
 
+            resetListImage( id );
+
             setButtonOkayStatus( !_selected.empty() );
         }
 
@@ -395,6 +428,8 @@ namespace
             , _imageOffsetX( imageOffsetX )
             , _textOffsetX( textOffsetX )
             , _offsetY( offsetY )
+            , _imageCache( objectInfo.size() )
+            , _nameCache( objectInfo.size() )
         {
             SetAreaMaxItems( rtAreaItems.height / _offsetY );
         }
@@ -406,20 +441,7 @@ namespace
             // If this assertion blows up then you are setting different number of items.
             assert( objectId >= 0 && objectId < static_cast<int>( _objectInfo.size() ) );
 
-            const fheroes2::Sprite & image = getObjectImage( _objectInfo[objectId] );
-
-            const int32_t imageHeight = image.height();
-            const int32_t imageWidth = image.width();
-            if ( imageHeight > fheroes2::tileWidthPx * 3 || imageWidth > fheroes2::tileWidthPx * 5 ) {
-                // Reduce the size of very tall images to fit the list.
-                const double ratio = std::max( imageHeight / ( fheroes2::tileWidthPx * 3. ), imageWidth / ( fheroes2::tileWidthPx * 5. ) );
-                fheroes2::Sprite resized( static_cast<int32_t>( imageWidth / ratio ), static_cast<int32_t>( imageHeight / ratio ) );
-                fheroes2::Resize( image, resized );
-                renderItem( resized, getObjectName( _objectInfo[objectId] ), { posX, posY }, _imageOffsetX, _textOffsetX, _offsetY / 2, isSelected );
-            }
-            else {
-                renderItem( image, getObjectName( _objectInfo[objectId] ), { posX, posY }, _imageOffsetX, _textOffsetX, _offsetY / 2, isSelected );
-            }
+            renderItem( _getListImage( objectId ), _getListName( objectId ), { posX, posY }, _imageOffsetX, _textOffsetX, _offsetY / 2, isSelected );
         }
 
         void ActionListPressRight( int32_t & objectId ) override
@@ -440,6 +462,44 @@ namespace
             return fheroes2::generateMapObjectImage( object );
         }
 
+        // Generating an object image requires to combine and sometimes to resize multiple sprites which is too slow to be done on every list redraw.
+        // Only the images of the visible items are generated and they are kept until the dialog is closed.
+        const fheroes2::Sprite & _getListImage( const int32_t objectId )
+        {
+            fheroes2::Sprite & listImage = _imageCache[objectId];
+            if ( !listImage.empty() ) {
+                return listImage;
+            }
+
+            fheroes2::Sprite image = getObjectImage( _objectInfo[objectId] );
+
+            const int32_t imageHeight = image.height();
+            const int32_t imageWidth = image.width();
+            if ( imageHeight > fheroes2::tileWidthPx * 3 || imageWidth > fheroes2::tileWidthPx * 5 ) {
+                // Reduce the size of very tall images to fit the list.
+                const double ratio = std::max( imageHeight / ( fheroes2::tileWidthPx * 3. ), imageWidth / ( fheroes2::tileWidthPx * 5. ) );
+                listImage = fheroes2::Sprite( static_cast<int32_t>( imageWidth / ratio ), static_cast<int32_t>( imageHeight / ratio ) );
+                fheroes2::Resize( image, listImage );
+            }
+            else {
+                listImage = std::move( image );
+            }
+
+            return listImage;
+        }
+
+        // Object names are often composed from several translated strings. The language cannot be changed while the dialog is open
+        // so the names are generated only once.
+        const std::string & _getListName( const int32_t objectId )
+        {
+            std::string & listName = _nameCache[objectId];
+            if ( listName.empty() ) {
+                listName = getObjectName( _objectInfo[objectId] );
+            }
+
+            return listName;
+        }
+
         const std::vector<Maps::ObjectInfo> & _objectInfo;
 
         const int32_t _imageOffsetX{ 0 };
@@ -447,6 +507,10 @@ namespace
         const int32_t _textOffsetX{ 0 };
 
         const int32_t _offsetY{ 0 };
+
+        std::vector<fheroes2::Sprite> _imageCache;
+
+        std::vector<std::string> _nameCache;
     };
 
     class MonsterTypeSelection final : public ObjectTypeSelection
@@ -50,6 +50,7 @@
 #include "ui_constants.h"
 #include "ui_dialog.h"
 #include "ui_language.h"
+#include "ui_map_preview.h"
 #include "ui_scrollbar.h"
 #include "ui_text.h"
 
@@ -176,7 +177,14 @@ namespace
         body.add( { _( "\n\nLocation: " ), fheroes2::FontType::smallYellow() } );
         body.add( { info->filename, fheroes2::FontType::smallWhite() } );
 
-        fheroes2::showMessage( header, body, Dialog::ZERO );
+        const fheroes2::Image preview = fheroes2::getMapPreview( *info, fheroes2::radarWidthPx );
+        if ( preview.empty() ) {
+            fheroes2::showMessage( header, body, Dialog::ZERO );
+            return;
+        }
+
+        const fheroes2::CustomImageDialogElement previewElement( preview );
+        fheroes2::showMessage( header, body, Dialog::ZERO, { &previewElement } );
     }
 
     void LossConditionInfo( const Maps::FileInfo * info )
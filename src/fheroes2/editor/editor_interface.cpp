@@ -23,11 +23,14 @@
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <chrono>
 #include <cstddef>
+#include <future>
 #include <map>
 #include <memory>
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "artifact.h"
@@ -55,6 +58,7 @@
 #include "heroes.h"
 #include "history_manager.h"
 #include "icn.h"
+#include "image.h"
 #include "interface_base.h"
 #include "interface_border.h"
 #include "interface_gamearea.h"
@@ -67,6 +71,7 @@
 #include "maps_tiles.h"
 #include "maps_tiles_helper.h"
 #include "math_base.h"
+#include "math_tools.h"
 #include "monster.h"
 #include "mp2.h"
 #include "players.h"
@@ -78,6 +83,7 @@
 #include "settings.h"
 #include "spell.h"
 #include "system.h"
+#include "thread.h"
 #include "tools.h"
 #include "translations.h"
 #include "ui_button.h"
@@ -1015,7 +1021,7 @@ namespace Interface
                 else if ( HotKeyPressEvent( Game::HotKeyEvent::EDITOR_RANDOM_MAP_REGENERATE ) ) {
                     fheroes2::ActionCreator action( _historyManager, _mapFormat );
 
-                    if ( Maps::Random_Generator::generateMap( _mapFormat, _randomMapConfig, _mapFormat.width, _mapFormat.width ) ) {
+                    if ( generateRandomMap( _mapFormat.width ) ) {
                         _redraw |= mapUpdateFlags;
 
                         action.commit();
@@ -1282,7 +1288,13 @@ namespace Interface
                         fheroes2::ActionCreator action( _historyManager, _mapFormat );
 
                         const int groundId = _editorPanel.selectedGroundType();
-                        Maps::setTerrainWithTransition( _mapFormat, _areaSelectionStartTileId, _tileUnderCursor, groundId );
+                        if ( _areaSelectionStartTileId == _tileUnderCursor && ( LocalEvent::getCurrentKeyModifiers() & fheroes2::KeyModifier::KEY_MODIFIER_CTRL ) ) {
+                            // Flood fill the area of the same ground under the cursor.
+                            Maps::fillTerrainWithTransition( _mapFormat, _tileUnderCursor, groundId );
+                        }
+                        else {
+                            Maps::setTerrainWithTransition( _mapFormat, _areaSelectionStartTileId, _tileUnderCursor, groundId );
+                        }
                         _validateObjectsOnTerrainUpdate();
 
                         action.commit();
@@ -1328,6 +1340,8 @@ namespace Interface
 
             assert( res == fheroes2::GameMode::CANCEL );
 
+            _updateMapValidation();
+
             // Map objects animation
             if ( Game::validateAnimationDelay( Game::MAPS_DELAY ) ) {
                 if ( conf.isEditorAnimationEnabled() ) {
@@ -2251,7 +2265,57 @@ namespace Interface
 
     bool EditorInterface::generateRandomMap( const int32_t mapWidth )
     {
-        return Maps::Random_Generator::generateMap( _mapFormat, _randomMapConfig, mapWidth, mapWidth );
+        fheroes2::Display & display = fheroes2::Display::instance();
+
+        // The preview shows map terrain with the same colors as the radar does.
+        fheroes2::Image terrainImage( mapWidth, mapWidth );
+        terrainImage._disableTransformLayer();
+
+        const int32_t previewSize = std::min( display.height() / 2, mapWidth * 2 );
+        fheroes2::Image preview( previewSize, previewSize );
+        preview._disableTransformLayer();
+
+        const fheroes2::Rect previewRoi{ ( display.width() - previewSize ) / 2, ( display.height() - previewSize ) / 2, previewSize, previewSize };
+        const fheroes2::Rect textRoi{ 0, previewRoi.y + previewRoi.height + 8, display.width(), fheroes2::getFontHeight( fheroes2::FontSize::NORMAL ) };
+
+        fheroes2::ImageRestorer previewRestorer( display, previewRoi.x, previewRoi.y, previewRoi.width, previewRoi.height );
+        fheroes2::ImageRestorer textRestorer( display, textRoi.x, textRoi.y, textRoi.width, textRoi.height );
+
+        LocalEvent & le = LocalEvent::Get();
+
+        const auto progressCallback = [&]( const Maps::Random_Generator::GenerationStep step, const Maps::Map_Format::MapFormat & map ) {
+            // Generation of big maps takes time, so we pump the event queue to keep the application responsive and to let the user cancel it.
+            if ( !le.HandleEvents( false ) || HotKeyPressEvent( Game::HotKeyEvent::DEFAULT_CANCEL ) ) {
+                return false;
+            }
+
+            assert( map.tiles.size() == static_cast<size_t>( mapWidth ) * mapWidth );
+
+            uint8_t * imageOut = terrainImage.image();
+            for ( const Maps::Map_Format::TileInfo & tile : map.tiles ) {
+                *imageOut = Radar::getGroundPaletteIndex( Maps::Ground::getGroundByImageIndex( tile.terrainIndex ) );
+                ++imageOut;
+            }
+
+            fheroes2::Resize( terrainImage, preview );
+            fheroes2::Copy( preview, 0, 0, display, previewRoi.x, previewRoi.y, previewRoi.width, previewRoi.height );
+
+            std::string message = _( "Generating map: step %{step} of %{count}" );
+            StringReplace( message, "%{step}", static_cast<int>( step ) + 1 );
+            StringReplace( message, "%{count}", static_cast<int>( Maps::Random_Generator::GenerationStep::STEP_COUNT ) );
+
+            textRestorer.restore();
+
+            const fheroes2::Text text( std::move( message ), fheroes2::FontType::normalWhite() );
+            text.draw( ( display.width() - text.width() ) / 2, textRoi.y, display );
+
+            display.render( fheroes2::getBoundaryRect( previewRoi, textRoi ) );
+
+            return true;
+        };
+
+        // The restorers bring back the original screen content once the generation is over.
+        return Maps::Random_Generator::generateMap( _mapFormat, _randomMapConfig, mapWidth, mapWidth, progressCallback );
     }
 
     bool EditorInterface::generateNewMap( const int32_t mapWidth )
@@ -2327,7 +2391,7 @@ namespace Interface
 
     void EditorInterface::saveMapToFile()
     {
-        if ( !Maps::updateMapPlayers( _mapFormat ) ) {
+        if ( !_updateMapPlayers() ) {
             fheroes2::showStandardTextMessage( _( "Error" ), _( "The map is corrupted." ), Dialog::OK );
             return;
         }
@@ -2471,6 +2535,76 @@ namespace Interface
         return true;
     }
 
+    void EditorInterface::_redrawUpdatedArea()
+    {
+        const fheroes2::Rect & updatedArea = _historyManager.getLastUpdatedArea();
+        if ( updatedArea.width > 0 && updatedArea.height > 0 ) {
+            _radar.SetRenderArea( updatedArea );
+        }
+
+        _redraw |= ( REDRAW_GAMEAREA | REDRAW_RADAR );
+    }
+
+    void EditorInterface::_updateMapValidation()
+    {
+        _collectMapValidationResult();
+
+        if ( _mapValidationJob.valid() || _validatedMapRevision == _historyManager.getRevision() ) {
+            // The validation is in progress or the map has not been changed since the last one.
+            return;
+        }
+
+        // The validation reads only heroes, towns and their flags so only these objects are copied. Other tiles stay empty.
+        auto map = std::make_shared<Maps::Map_Format::MapFormat>();
+        map->width = _mapFormat.width;
+        map->tiles.resize( _mapFormat.tiles.size() );
+
+        for ( size_t tileIndex = 0; tileIndex < _mapFormat.tiles.size(); ++tileIndex ) {
+            for ( const auto & object : _mapFormat.tiles[tileIndex].objects ) {
+                if ( object.group == Maps::ObjectGroup::KINGDOM_HEROES || object.group == Maps::ObjectGroup::KINGDOM_TOWNS
+                     || object.group == Maps::ObjectGroup::LANDSCAPE_FLAGS ) {
+                    map->tiles[tileIndex].objects.push_back( object );
+                }
+            }
+        }
+
+        _mapValidationJobRevision = _historyManager.getRevision();
+        _mapValidationJob = MultiThreading::JobSystem::Get().async( [map = std::move( map )]() -> std::optional<Maps::MapPlayerRaces> {
+            Maps::MapPlayerRaces races;
+            if ( !Maps::getMapPlayerRaces( *map, races ) ) {
+                return {};
+            }
+
+            return races;
+        } );
+    }
+
+    void EditorInterface::_collectMapValidationResult()
+    {
+        if ( !_mapValidationJob.valid() || _mapValidationJob.wait_for( std::chrono::seconds( 0 ) ) != std::future_status::ready ) {
+            return;
+        }
+
+        _validatedPlayerRaces = _mapValidationJob.get();
+        _validatedMapRevision = _mapValidationJobRevision;
+
+        if ( !_validatedPlayerRaces && _validatedMapRevision == _historyManager.getRevision() ) {
+            _warningMessage.reset( _( "The map is corrupted." ) );
+        }
+    }
+
+    bool EditorInterface::_updateMapPlayers()
+    {
+        _collectMapValidationResult();
+
+        if ( _validatedMapRevision != _historyManager.getRevision() ) {
+            // The map has been changed after the last validation.
+            return Maps::updateMapPlayers( _mapFormat );
+        }
+
+        return _validatedPlayerRaces && Maps::updateMapPlayers( _mapFormat, *_validatedPlayerRaces );
+    }
+
     void EditorInterface::_validateObjectsOnTerrainUpdate()
     {
         std::string errorMessage;
@@ -22,6 +22,8 @@
 
 #include <cstdint>
 #include <functional>
+#include <future>
+#include <optional>
 #include <set>
 #include <string>
 #include <utility>
@@ -30,8 +32,10 @@
 #include "game_mode.h"
 #include "history_manager.h"
 #include "interface_base.h"
+#include "map_format_helper.h"
 #include "map_format_info.h"
 #include "map_random_generator.h"
+#include "memory_usage.h"
 #include "timing.h"
 
 enum class PlayerColor : uint8_t;
@@ -79,14 +83,14 @@ namespace Interface
         void undoAction()
         {
             if ( _historyManager.undo() ) {
-                _redraw |= ( REDRAW_GAMEAREA | REDRAW_RADAR );
+                _redrawUpdatedArea();
             }
         }
 
         void redoAction()
         {
             if ( _historyManager.redo() ) {
-                _redraw |= ( REDRAW_GAMEAREA | REDRAW_RADAR );
+                _redrawUpdatedArea();
             }
         }
 
@@ -155,6 +159,9 @@ namespace Interface
             _historyManager.setStateCallback( [&editorPanel = _editorPanel]( const bool isUndoAvailable, const bool isRedoAvailable ) {
                 editorPanel.updateUndoRedoButtonsStates( isUndoAvailable, isRedoAvailable );
             } );
+
+            // The interface is a singleton, so it outlives all the users of the counter.
+            fheroes2::setMemoryUsageCounter( fheroes2::MemoryOwner::EDITOR_HISTORY, [this]() { return _historyManager.getMemoryUsage(); } );
         }
 
         bool _setObjectOnTile( Maps::Tile & tile, const Maps::ObjectGroup groupType, const int32_t objectIndex );
@@ -165,6 +172,9 @@ namespace Interface
 
         void _validateObjectsOnTerrainUpdate();
 
+        // Sets the redraw flags after undo or redo, limiting the radar update to the area changed by the action if possible.
+        void _redrawUpdatedArea();
+
         // Returns true if an existing object was moved.
         bool _moveExistingObject( const int32_t tileIndex, const Maps::ObjectGroup groupType, int32_t objectIndex );
 
@@ -174,6 +184,14 @@ namespace Interface
 
         bool _placeCastle( const int32_t posX, const int32_t posY, const PlayerColor color, const int32_t type );
 
+        // Collects the result of the background map validation if it is finished and starts a new one if the map has been changed since the last validation.
+        void _updateMapValidation();
+
+        void _collectMapValidationResult();
+
+        // Updates player information of the map using the result of the background map validation if it matches the current state of the map.
+        bool _updateMapPlayers();
+
         EditorPanel _editorPanel;
 
         int32_t _areaSelectionStartTileId{ -1 };
@@ -192,5 +210,13 @@ namespace Interface
         WarningMessage _warningMessage;
 
         std::string _loadedFileName;
+
+        // The map validation runs in the background over a copy of the map objects it needs made at the given history revision.
+        std::future<std::optional<Maps::MapPlayerRaces>> _mapValidationJob;
+        uint64_t _mapValidationJobRevision{ 0 };
+
+        // An empty value of the player races means that the map validation has failed.
+        std::optional<uint64_t> _validatedMapRevision;
+        std::optional<Maps::MapPlayerRaces> _validatedPlayerRaces;
     };
 }
@@ -20,29 +20,57 @@
 
 #include "history_manager.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
+#include <set>
+#include <vector>
 
 #include "map_format_helper.h"
 #include "map_format_info.h"
+#include "maps_tiles.h"
 #include "serialize.h"
+#include "world.h"
 #include "world_object_uid.h"
 
 namespace
 {
-    // This class holds 2 copies of MapFormat objects in a compressed format:
-    // - one copy before the action
-    // - one copy after the action
+    std::vector<uint8_t> saveMapWithoutTiles( const Maps::Map_Format::MapFormat & mapFormat )
+    {
+        RWStreamBuf stream;
+        stream.setBigendian( true );
+
+        if ( !Maps::Map_Format::saveMapWithoutTiles( stream, mapFormat ) ) {
+            assert( 0 );
+            return {};
+        }
+
+        return { stream.data(), stream.data() + stream.size() };
+    }
+
+    bool loadMapWithoutTiles( const std::vector<uint8_t> & data, Maps::Map_Format::MapFormat & mapFormat )
+    {
+        ROStreamBuf stream( data );
+        stream.setBigendian( true );
+
+        return Maps::Map_Format::loadMapWithoutTiles( stream, mapFormat );
+    }
+
+    // This class holds only the changes made to MapFormat by the action:
+    // - the tiles which are different before and after the action
+    // - the rest of the map data (everything except tiles) before and after the action, only if it has been changed
+    // Until the action is prepared, it holds the complete state of the map before the action to be able to revert it.
     class MapAction final : public fheroes2::Action
     {
     public:
         explicit MapAction( Maps::Map_Format::MapFormat & mapFormat )
             : _mapFormat( mapFormat )
+            , _tilesBefore( mapFormat.tiles )
+            , _dataBefore( saveMapWithoutTiles( mapFormat ) )
             , _latestObjectUIDBefore( Maps::getLastObjectUID() )
         {
-            if ( !Maps::Map_Format::saveMap( _beforeMapFormat, _mapFormat ) ) {
-                assert( 0 );
-            }
+            // Do nothing.
         }
 
         // Disable the copy and move (implicitly) constructors and assignment operators.
@@ -52,64 +80,201 @@ namespace
 
         bool prepare()
         {
-            if ( !Maps::Map_Format::saveMap( _afterMapFormat, _mapFormat ) ) {
+            if ( _tilesBefore.size() != _mapFormat.tiles.size() ) {
+                // Tiles cannot be added or removed by an action.
                 assert( 0 );
                 return false;
             }
 
+            for ( size_t i = 0; i < _tilesBefore.size(); ++i ) {
+                if ( _tilesBefore[i] != _mapFormat.tiles[i] ) {
+                    _changedTiles.push_back( { i, std::move( _tilesBefore[i] ), _mapFormat.tiles[i] } );
+                }
+            }
+
+            // The complete copy of tiles is not needed anymore.
+            _tilesBefore = {};
+
+            _dataAfter = saveMapWithoutTiles( _mapFormat );
+
+            if ( _dataAfter == _dataBefore ) {
+                _dataBefore = {};
+                _dataAfter = {};
+            }
+
             _latestObjectUIDAfter = Maps::getLastObjectUID();
 
+            _isTerrainChangeOnly = _dataBefore.empty() && std::all_of( _changedTiles.begin(), _changedTiles.end(), []( const TileChange & change ) {
+                                       return change.before.objects == change.after.objects;
+                                   } );
+
+            if ( !_changedTiles.empty() ) {
+                const int32_t mapWidth = _mapFormat.width;
+
+                int32_t minX = mapWidth;
+                int32_t minY = mapWidth;
+                int32_t maxX = 0;
+                int32_t maxY = 0;
+
+                for ( const TileChange & change : _changedTiles ) {
+                    const int32_t x = static_cast<int32_t>( change.index ) % mapWidth;
+                    const int32_t y = static_cast<int32_t>( change.index ) / mapWidth;
+
+                    minX = std::min( minX, x );
+                    minY = std::min( minY, y );
+                    maxX = std::max( maxX, x );
+                    maxY = std::max( maxY, y );
+                }
+
+                _changedTilesArea = { minX, minY, maxX - minX + 1, maxY - minY + 1 };
+            }
+
+            _isPrepared = true;
+
             return true;
         }
 
         bool redo() override
         {
-            if ( !Maps::Map_Format::loadMap( _afterMapFormat, _mapFormat ) ) {
+            assert( _isPrepared );
+
+            for ( const TileChange & change : _changedTiles ) {
+                _mapFormat.tiles[change.index] = change.after;
+            }
+
+            if ( _isTerrainChangeOnly ) {
+                return _applyTerrain( _latestObjectUIDAfter );
+            }
+
+            return _apply( _dataAfter, _latestObjectUIDAfter );
+        }
+
+        bool undo() override
+        {
+            if ( _isPrepared ) {
+                for ( const TileChange & change : _changedTiles ) {
+                    _mapFormat.tiles[change.index] = change.before;
+                }
+
+                if ( _isTerrainChangeOnly ) {
+                    return _applyTerrain( _latestObjectUIDBefore );
+                }
+            }
+            else {
+                _mapFormat.tiles = _tilesBefore;
+            }
+
+            return _apply( _dataBefore, _latestObjectUIDBefore );
+        }
+
+        fheroes2::Rect getUpdatedArea() const override
+        {
+            return _isTerrainChangeOnly ? _changedTilesArea : fheroes2::Rect{};
+        }
+
+        size_t getMemoryUsage() const override
+        {
+            size_t size = sizeof( MapAction ) + _dataBefore.capacity() + _dataAfter.capacity();
+
+            size += _tilesBefore.capacity() * sizeof( Maps::Map_Format::TileInfo );
+            for ( const Maps::Map_Format::TileInfo & tile : _tilesBefore ) {
+                size += tile.objects.capacity() * sizeof( Maps::Map_Format::TileObjectInfo );
+            }
+
+            size += _changedTiles.capacity() * sizeof( TileChange );
+            for ( const TileChange & change : _changedTiles ) {
+                size += ( change.before.objects.capacity() + change.after.objects.capacity() ) * sizeof( Maps::Map_Format::TileObjectInfo );
+            }
+
+            return size;
+        }
+
+    private:
+        struct TileChange
+        {
+            size_t index{ 0 };
+            Maps::Map_Format::TileInfo before;
+            Maps::Map_Format::TileInfo after;
+        };
+
+        bool _apply( const std::vector<uint8_t> & data, const uint32_t latestObjectUID )
+        {
+            // An empty data means that nothing except tiles has been changed by the action.
+            if ( !data.empty() && !loadMapWithoutTiles( data, _mapFormat ) ) {
                 assert( 0 );
                 return false;
             }
 
-            _afterMapFormat.seek( 0 );
-
             if ( !Maps::readMapInEditor( _mapFormat ) ) {
                 // If this assertion blows up then something is really wrong with the Editor.
                 assert( 0 );
                 return false;
             }
 
-            Maps::setLastObjectUID( _latestObjectUIDAfter );
+            Maps::setLastObjectUID( latestObjectUID );
 
             return true;
         }
 
-        bool undo() override
+        // Only the terrain of the changed tiles is updated in the world, instead of reading the whole map again.
+        bool _applyTerrain( const uint32_t latestObjectUID )
         {
-            if ( !Maps::Map_Format::loadMap( _beforeMapFormat, _mapFormat ) ) {
-                assert( 0 );
-                return false;
+            assert( _mapFormat.width == world.w() && _mapFormat.width == world.h() );
+
+            const int32_t mapWidth = _mapFormat.width;
+
+            // The passability of a tile depends on the tiles to the left, to the right and below it.
+            std::set<int32_t> tilesToUpdatePassability;
+
+            for ( const TileChange & change : _changedTiles ) {
+                const Maps::Map_Format::TileInfo & mapTile = _mapFormat.tiles[change.index];
+                const int32_t tileIndex = static_cast<int32_t>( change.index );
+
+                world.getTile( tileIndex ).setTerrain( mapTile.terrainIndex, mapTile.terrainFlags );
+
+                tilesToUpdatePassability.insert( tileIndex );
+
+                if ( tileIndex % mapWidth > 0 ) {
+                    tilesToUpdatePassability.insert( tileIndex - 1 );
+                }
+                if ( tileIndex % mapWidth < mapWidth - 1 ) {
+                    tilesToUpdatePassability.insert( tileIndex + 1 );
+                }
+                if ( tileIndex >= mapWidth ) {
+                    tilesToUpdatePassability.insert( tileIndex - mapWidth );
+                }
             }
 
-            _beforeMapFormat.seek( 0 );
+            for ( const int32_t tileIndex : tilesToUpdatePassability ) {
+                assert( tileIndex >= 0 && static_cast<size_t>( tileIndex ) < _mapFormat.tiles.size() );
 
-            if ( !Maps::readMapInEditor( _mapFormat ) ) {
-                // If this assertion blows up then something is really wrong with the Editor.
-                assert( 0 );
-                return false;
+                world.getTile( tileIndex ).setInitialPassability();
+            }
+
+            for ( const int32_t tileIndex : tilesToUpdatePassability ) {
+                world.getTile( tileIndex ).updatePassability();
             }
 
-            Maps::setLastObjectUID( _latestObjectUIDBefore );
+            Maps::setLastObjectUID( latestObjectUID );
 
             return true;
         }
 
-    private:
         Maps::Map_Format::MapFormat & _mapFormat;
 
-        RWStreamBuf _beforeMapFormat;
-        RWStreamBuf _afterMapFormat;
+        std::vector<Maps::Map_Format::TileInfo> _tilesBefore;
+        std::vector<TileChange> _changedTiles;
+
+        std::vector<uint8_t> _dataBefore;
+        std::vector<uint8_t> _dataAfter;
 
         const uint32_t _latestObjectUIDBefore{ 0 };
         uint32_t _latestObjectUIDAfter{ 0 };
+
+        fheroes2::Rect _changedTilesArea;
+
+        bool _isPrepared{ false };
+        bool _isTerrainChangeOnly{ false };
     };
 }
 
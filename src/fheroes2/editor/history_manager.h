@@ -23,11 +23,14 @@
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <deque>
 #include <functional>
 #include <memory>
 #include <utility>
 
+#include "math_base.h"
+
 namespace Maps::Map_Format
 {
     struct MapFormat;
@@ -45,6 +48,16 @@ namespace fheroes2
         virtual bool redo() = 0;
 
         virtual bool undo() = 0;
+
+        // Returns the area of the map (in tiles) which has been updated by the last call of redo() or undo().
+        // An empty area means that the whole map has been updated.
+        virtual fheroes2::Rect getUpdatedArea() const
+        {
+            return {};
+        }
+
+        // Returns the memory held by the action in bytes.
+        virtual size_t getMemoryUsage() const = 0;
     };
 
     // Remember the map state and create an action if the map has changed.
@@ -85,6 +98,7 @@ namespace fheroes2
         {
             _actions.clear();
             _lastActionId = 0;
+            ++_revision;
 
             if ( _stateCallback ) {
                 _stateCallback( false, false );
@@ -98,6 +112,7 @@ namespace fheroes2
             _actions.push_back( std::move( action ) );
 
             ++_lastActionId;
+            ++_revision;
 
             if ( _actions.size() > maxActions ) {
                 --_lastActionId;
@@ -129,7 +144,9 @@ namespace fheroes2
             }
 
             --_lastActionId;
+            ++_revision;
             const bool result = _actions[_lastActionId]->undo();
+            _lastUpdatedArea = _actions[_lastActionId]->getUpdatedArea();
 
             if ( _stateCallback ) {
                 _stateCallback( isUndoAvailable(), isRedoAvailable() );
@@ -146,7 +163,9 @@ namespace fheroes2
             }
 
             const bool result = _actions[_lastActionId]->redo();
+            _lastUpdatedArea = _actions[_lastActionId]->getUpdatedArea();
             ++_lastActionId;
+            ++_revision;
 
             if ( _stateCallback ) {
                 _stateCallback( isUndoAvailable(), isRedoAvailable() );
@@ -155,6 +174,29 @@ namespace fheroes2
             return result;
         }
 
+        size_t getMemoryUsage() const
+        {
+            size_t size = 0;
+
+            for ( const std::unique_ptr<Action> & action : _actions ) {
+                size += action->getMemoryUsage();
+            }
+
+            return size;
+        }
+
+        // Returns the number of changes made to the map through this manager. It is used to detect whether the map has been changed since some moment.
+        uint64_t getRevision() const
+        {
+            return _revision;
+        }
+
+        // Returns the area of the map (in tiles) updated by the last undo or redo operation. An empty area means the whole map.
+        const fheroes2::Rect & getLastUpdatedArea() const
+        {
+            return _lastUpdatedArea;
+        }
+
     private:
         // We shouldn't store too many actions. It is extremely rare when there is a need to revert so many changes.
         static const size_t maxActions{ 999 };
@@ -163,6 +205,10 @@ namespace fheroes2
 
         size_t _lastActionId{ 0 };
 
+        uint64_t _revision{ 0 };
+
+        fheroes2::Rect _lastUpdatedArea;
+
         std::function<void( const bool, const bool )> _stateCallback;
     };
 }
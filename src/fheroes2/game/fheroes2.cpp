@@ -31,6 +31,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <string_view>
 #include <vector>
 
 // Managing compiler warnings for SDL headers
@@ -58,6 +59,7 @@
 
 #include "agg.h"
 #include "agg_image.h"
+#include "audio.h"
 #include "audio_manager.h"
 #include "core.h"
 #include "cursor.h"
@@ -72,15 +74,22 @@
 #include "icn.h"
 #include "image.h"
 #include "image_palette.h"
+#include "input_session.h"
 #include "localevent.h"
 #include "logging.h"
+#include "maps_fileinfo.h"
 #include "math_base.h"
+#include "memory_usage.h"
+#include "perf_counters.h"
 #include "render_processor.h"
 #include "screen.h"
 #include "settings.h"
+#include "smk_decoder.h"
 #include "system.h"
 #include "timing.h"
+#include "translations.h"
 #include "ui_tool.h"
+#include "world.h"
 #include "zzlib.h"
 
 namespace
@@ -192,7 +201,7 @@ namespace
 
             fheroes2::RenderProcessor & renderProcessor = fheroes2::RenderProcessor::instance();
 
-            display.subscribe( [&renderProcessor]( std::vector<uint8_t> & palette ) { return renderProcessor.preRenderAction( palette ); },
+            display.subscribe( [&renderProcessor]() { return renderProcessor.preRenderAction(); },
                                [&renderProcessor]() { renderProcessor.postRenderAction(); } );
 
             // Initialize system info renderer.
@@ -240,6 +249,10 @@ namespace
 
                 _h2dInitializer.reset( new fheroes2::h2d::H2DInitializer );
 
+                if ( Settings::Get().isICNDiskCacheEnabled() ) {
+                    openICNDiskCache();
+                }
+
                 // Verify that the font is present and it is not corrupted.
                 fheroes2::AGG::GetICN( ICN::FONT, 0 );
             }
@@ -265,10 +278,59 @@ namespace
         }
 
     private:
+        static void openICNDiskCache()
+        {
+            const std::string dataDir = System::GetDataDirectory( "fheroes2" );
+            if ( dataDir.empty() ) {
+                return;
+            }
+
+            const std::string cacheFilePath = System::concatPath( System::concatPath( dataDir, "files" ), "icn.cache" );
+            if ( !fheroes2::AGG::openICNDiskCache( cacheFilePath ) ) {
+                ERROR_LOG( "Failed to open ICN cache file " << cacheFilePath )
+            }
+        }
+
         std::unique_ptr<AGG::AGGInitializer> _aggInitializer;
         std::unique_ptr<fheroes2::h2d::H2DInitializer> _h2dInitializer;
     };
 
+    // Measures the duration of the startup phases. The results are written to the log in debug builds with the DBG_GAME debug flag.
+    class StartupTimer
+    {
+    public:
+        void finishPhase( [[maybe_unused]] const char * phaseName )
+        {
+#if defined( WITH_DEBUG )
+            DEBUG_LOG( DBG_GAME, DBG_INFO,
+                       "Startup phase '" << phaseName << "' took " << _phaseTimer.getMs() << " ms, " << _totalTimer.getMs() << " ms since the launch" )
+            _phaseTimer.reset();
+#endif
+        }
+
+    private:
+#if defined( WITH_DEBUG )
+        fheroes2::Time _totalTimer;
+        fheroes2::Time _phaseTimer;
+#endif
+    };
+
+    void registerMemoryUsageCounters()
+    {
+        fheroes2::setMemoryUsageCounter( fheroes2::MemoryOwner::ICN_SPRITES, []() { return fheroes2::AGG::getICNMemoryUsage(); } );
+        fheroes2::setMemoryUsageCounter( fheroes2::MemoryOwner::WORLD, []() { return world.getMemoryUsage(); } );
+        fheroes2::setMemoryUsageCounter( fheroes2::MemoryOwner::AUDIO, []() { return Audio::getMemoryUsage(); } );
+        fheroes2::setMemoryUsageCounter( fheroes2::MemoryOwner::VIDEO, []() {
+            const fheroes2::Display & display = fheroes2::Display::instance();
+            const size_t pixelCount = static_cast<size_t>( display.width() ) * static_cast<size_t>( display.height() );
+
+            return ( display.singleLayer() ? pixelCount : pixelCount * 2 ) + SMKVideoSequence::getTotalMemoryUsage();
+        } );
+        fheroes2::setMemoryUsageCounter( fheroes2::MemoryOwner::TRANSLATIONS, []() { return Translation::getMemoryUsage(); } );
+
+        // The editor history is registered by the editor interface.
+    }
+
     // This function checks for a possible situation when a user uses a demo version
     // of the game. There is no 100% certain way to detect this, so assumptions are made.
     bool isProbablyDemoVersion()
@@ -281,6 +343,79 @@ namespace
         const ListFiles maps = Settings::FindFiles( "maps", ".mp2", false );
         return maps.size() == 1;
     }
+
+    // Input sessions are recorded and replayed to compare the rendering performance on identical sessions. The supported options are:
+    // --record-input <file>       - record all keyboard and mouse input into the file
+    // --replay-input <file>       - replay the recorded input instead of the real one
+    // --profiler-csv <file>       - write the time of every frame of the replayed session into the CSV file
+    void initInputSession( const int argc, char ** argv )
+    {
+        std::string recordFilePath;
+        std::string replayFilePath;
+        std::string profilerCsvFilePath;
+
+        for ( int i = 1; i + 1 < argc; ++i ) {
+            const std::string_view option( argv[i] );
+
+            if ( option == "--record-input" ) {
+                recordFilePath = argv[++i];
+            }
+            else if ( option == "--replay-input" ) {
+                replayFilePath = argv[++i];
+            }
+            else if ( option == "--profiler-csv" ) {
+                profilerCsvFilePath = argv[++i];
+            }
+        }
+
+        if ( !replayFilePath.empty() ) {
+            if ( !recordFilePath.empty() ) {
+                ERROR_LOG( "The input session cannot be recorded and replayed at the same time." )
+                return;
+            }
+
+            fheroes2::startInputReplay( replayFilePath, profilerCsvFilePath );
+        }
+        else if ( !recordFilePath.empty() ) {
+            fheroes2::startInputRecording( recordFilePath );
+        }
+    }
+
+    // Performance counters are collected for the whole session and written into the file at exit if the --perf-report=<file> option is given.
+    class PerfReportWriter
+    {
+    public:
+        PerfReportWriter( const int argc, char ** argv )
+        {
+            const std::string_view prefix( "--perf-report=" );
+
+            for ( int i = 1; i < argc; ++i ) {
+                const std::string_view option( argv[i] );
+
+                if ( option.size() > prefix.size() && option.substr( 0, prefix.size() ) == prefix ) {
+                    _filePath = option.substr( prefix.size() );
+                }
+            }
+
+            if ( !_filePath.empty() ) {
+                fheroes2::PerfCounters::instance().enable();
+            }
+        }
+
+        PerfReportWriter( const PerfReportWriter & ) = delete;
+
+        ~PerfReportWriter()
+        {
+            if ( !_filePath.empty() && fheroes2::PerfCounters::instance().writeReport( _filePath ) ) {
+                COUT( "Performance report has been written to " << _filePath )
+            }
+        }
+
+        PerfReportWriter & operator=( const PerfReportWriter & ) = delete;
+
+    private:
+        std::string _filePath;
+    };
 }
 
 int main( int argc, char ** argv )
@@ -290,14 +425,20 @@ int main( int argc, char ** argv )
     assert( argc == __argc );
 
     argv = __argv;
-#else
-    (void)argc;
 #endif
 
     try {
+        StartupTimer startupTimer;
+
         const fheroes2::HardwareInitializer hardwareInitializer;
         Logging::InitLog();
 
+        if ( AudioManager::isMidiRenderCommand( argc, argv ) ) {
+            return AudioManager::renderMidiTrack( argc, argv );
+        }
+
+        const PerfReportWriter perfReportWriter( argc, argv );
+
         COUT( GetCaption() )
 
         Settings & conf = Settings::Get();
@@ -307,6 +448,8 @@ int main( int argc, char ** argv )
         InitDataDir();
         ReadConfigs();
 
+        startupTimer.finishPhase( "configuration" );
+
         std::set<fheroes2::SystemInitializationComponent> coreComponents{ fheroes2::SystemInitializationComponent::Audio,
                                                                           fheroes2::SystemInitializationComponent::Video };
 
@@ -316,11 +459,22 @@ int main( int argc, char ** argv )
 
         const fheroes2::CoreInitializer coreInitializer( coreComponents );
 
+        startupTimer.finishPhase( "core" );
+
         DEBUG_LOG( DBG_GAME, DBG_INFO, conf.String() )
 
         const DisplayInitializer displayInitializer;
+
+        startupTimer.finishPhase( "display" );
+
         const DataInitializer dataInitializer;
 
+        startupTimer.finishPhase( "game data" );
+
+        // The resources of the main menu and the map list are read in the background while the rest of the startup is done.
+        fheroes2::AGG::prefetchICNs( { ICN::HEROES, ICN::BTNSHNGL, ICN::SHNGANIM } );
+        Maps::prefetchMapFileInfos();
+
         ListFiles midiSoundFonts;
         {
             const std::string path = System::concatPath( "files", "soundfonts" );
@@ -351,6 +505,8 @@ int main( int argc, char ** argv )
         const AudioManager::AudioInitializer audioInitializer( dataInitializer.getOriginalAGGFilePath(), dataInitializer.getExpansionAGGFilePath(), midiSoundFonts,
                                                                timidityCfgPath );
 
+        startupTimer.finishPhase( "audio" );
+
         // Load palette.
         fheroes2::setGamePalette( AGG::getDataFromAggFile( "KB.PAL", false ) );
         const fheroes2::Display & display = fheroes2::Display::instance();
@@ -362,9 +518,15 @@ int main( int argc, char ** argv )
         // initialization the English language is forced to properly read the configuration files.
         conf.setGameLanguage( conf.getGameLanguage() );
 
+        startupTimer.finishPhase( "palette and language" );
+
         // Initialize game data.
         Game::Init();
 
+        registerMemoryUsageCounters();
+
+        startupTimer.finishPhase( "game initialization" );
+
         if ( conf.isShowIntro() ) {
             fheroes2::showTeamInfo();
             for ( const char * logo : { "NWCLOGO.SMK", "CYLOGO.SMK", "H2XINTRO.SMK" } ) {
@@ -372,6 +534,11 @@ int main( int argc, char ** argv )
             }
         }
 
+        startupTimer.finishPhase( "intro" );
+
+        // The input session starts from the main menu, so the intro is not a part of it.
+        initInputSession( argc, argv );
+
         try {
             const CursorRestorer cursorRestorer( true, Cursor::POINTER );
             const fheroes2::Point pos = conf.getSavedWindowPos();
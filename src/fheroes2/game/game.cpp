@@ -214,14 +214,13 @@ void Game::updateAdventureMapAnimationIndex()
 
 void Game::EnvironmentSoundMixer()
 {
-    int availableChannels = Mixer::getChannelCount();
-    if ( availableChannels <= 2 ) {
-        // 2 channels are left for hero's movement.
+    // Ambient sounds have the lowest priority in the mixer. They use at most half of the channels, so that other sounds rarely have to take over
+    // their channels. The sources are sorted by distance below, so the most distant ones are culled first.
+    int availableChannels = Mixer::getChannelCount() / 2;
+    if ( availableChannels <= 0 ) {
         return;
     }
 
-    availableChannels -= 2;
-
     fheroes2::Point center;
     fheroes2::Point tilePixelOffset;
 
@@ -23,6 +23,7 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <future>
 #include <map>
 #include <optional>
 #include <ostream>
@@ -70,6 +71,7 @@
 #include "screen.h"
 #include "settings.h"
 #include "skill.h"
+#include "thread.h"
 #include "tools.h"
 #include "translations.h"
 #include "ui_button.h"
@@ -1294,6 +1296,9 @@ fheroes2::GameMode Game::SelectCampaignScenario( const fheroes2::GameMode prevMo
 
     const fheroes2::GameInterfaceTypeRestorer gameInterfaceRestorer( chosenCampaignID == Campaign::ROLAND_CAMPAIGN ? InterfaceType::GOOD : InterfaceType::EVIL );
 
+    // The scenario map is read in the background while the briefing video plays and the player looks through the scenario details.
+    std::future<Maps::FileInfo> scenarioMapInfo = MultiThreading::JobSystem::Get().async( [&scenario]() { return scenario.loadMap(); } );
+
     if ( !allowToRestart ) {
         playCurrentScenarioVideo();
     }
@@ -1594,7 +1599,8 @@ fheroes2::GameMode Game::SelectCampaignScenario( const fheroes2::GameMode prevMo
                 continue;
             }
 
-            Maps::FileInfo mapInfo = scenario.loadMap();
+            // The prefetched map information can be used only once: if the scenario fails to load it is read again.
+            Maps::FileInfo mapInfo = scenarioMapInfo.valid() ? scenarioMapInfo.get() : scenario.loadMap();
 
             // Update French language-specific characters to match CP1252 only for French assets when French language is selected.
             if ( mapInfo.version != GameVersion::RESURRECTION && fheroes2::getCurrentLanguage() == fheroes2::SupportedLanguage::French
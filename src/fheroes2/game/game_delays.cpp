@@ -23,8 +23,11 @@
 
 #include "game_delays.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
 
+#include "localevent.h"
 #include "settings.h"
 #include "timing.h"
 
@@ -39,6 +42,34 @@ namespace
     int humanHeroMultiplier = 1;
     int aiHeroMultiplier = 1;
 
+    bool isBattleAnimationFastForward = false;
+
+    bool isBattleAnimationDelay( const Game::DelayType delayType )
+    {
+        switch ( delayType ) {
+        case Game::BATTLE_FRAME_DELAY:
+        case Game::BATTLE_MISSILE_DELAY:
+        case Game::BATTLE_SPELL_DELAY:
+        case Game::BATTLE_DISRUPTING_DELAY:
+        case Game::BATTLE_CATAPULT_DELAY:
+        case Game::BATTLE_CATAPULT_BOULDER_DELAY:
+        case Game::BATTLE_CATAPULT_CLOUD_DELAY:
+        case Game::BATTLE_BRIDGE_DELAY:
+        case Game::CUSTOM_BATTLE_UNIT_MOVEMENT_DELAY:
+        case Game::CUSTOM_DELAY:
+            return true;
+        default:
+            break;
+        }
+
+        return false;
+    }
+
+    bool isDelayPassed( const Game::DelayType delayType )
+    {
+        return ( isBattleAnimationFastForward && isBattleAnimationDelay( delayType ) ) || delays[delayType].isPassed();
+    }
+
     void SetupHeroMovement( const int speed, fheroes2::TimeDelay & delay, int & multiplier )
     {
         switch ( speed ) {
@@ -138,7 +169,7 @@ void Game::AnimateResetDelay( const DelayType delayType )
 
 bool Game::validateCustomAnimationDelay( const uint64_t delayMs )
 {
-    if ( delays[Game::DelayType::CUSTOM_DELAY].isPassed( delayMs ) ) {
+    if ( isBattleAnimationFastForward || delays[Game::DelayType::CUSTOM_DELAY].isPassed( delayMs ) ) {
         delays[Game::DelayType::CUSTOM_DELAY].reset();
         return true;
     }
@@ -150,7 +181,7 @@ bool Game::validateAnimationDelay( const DelayType delayType )
 {
     assert( delayType != Game::DelayType::CUSTOM_DELAY );
 
-    if ( delays[delayType].isPassed() ) {
+    if ( isDelayPassed( delayType ) ) {
         delays[delayType].reset();
         return true;
     }
@@ -225,7 +256,7 @@ uint32_t Game::ApplyBattleSpeed( const uint32_t delay )
 bool Game::hasEveryDelayPassed( const std::vector<Game::DelayType> & delayTypes )
 {
     for ( const Game::DelayType type : delayTypes ) {
-        if ( !delays[type].isPassed() ) {
+        if ( !isDelayPassed( type ) ) {
             return false;
         }
     }
@@ -235,20 +266,44 @@ bool Game::hasEveryDelayPassed( const std::vector<Game::DelayType> & delayTypes
 
 bool Game::isDelayNeeded( const std::vector<Game::DelayType> & delayTypes )
 {
+    uint64_t idleTimeMs = UINT64_MAX;
+
     for ( const Game::DelayType type : delayTypes ) {
         assert( type != Game::DelayType::CUSTOM_DELAY );
 
-        if ( delays[type].isPassed() ) {
+        if ( isDelayPassed( type ) ) {
             return false;
         }
+
+        idleTimeMs = std::min( idleTimeMs, delays[type].getRemainingMs() );
     }
 
+    // The event processing can wait for input events until the nearest delay passes.
+    LocalEvent::Get().setIdleTimeBeforeNextEvent( idleTimeMs );
+
     return true;
 }
 
 bool Game::isCustomDelayNeeded( const uint64_t delayMs )
 {
-    return !delays[Game::DelayType::CUSTOM_DELAY].isPassed( delayMs );
+    if ( isBattleAnimationFastForward || delays[Game::DelayType::CUSTOM_DELAY].isPassed( delayMs ) ) {
+        return false;
+    }
+
+    // The event processing can wait for input events until the delay passes.
+    LocalEvent::Get().setIdleTimeBeforeNextEvent( delays[Game::DelayType::CUSTOM_DELAY].getRemainingMs( delayMs ) );
+
+    return true;
+}
+
+void Game::setBattleAnimationFastForward( const bool enable )
+{
+    isBattleAnimationFastForward = enable;
+}
+
+bool Game::isBattleAnimationFastForwardEnabled()
+{
+    return isBattleAnimationFastForward;
 }
 
 uint64_t Game::getAnimationDelayValue( const DelayType delayType )
@@ -103,4 +103,9 @@ namespace Game
 
     // Custom delay must never be called in this function.
     uint64_t getAnimationDelayValue( const DelayType delayType );
+
+    // In the fast-forward mode the delays of battle animations (including the custom delay) are always considered as passed,
+    // so that these animations are played as fast as possible. The rest of the delays are not affected.
+    void setBattleAnimationFastForward( const bool enable );
+    bool isBattleAnimationFastForwardEnabled();
 }
@@ -42,7 +42,10 @@
 #include "interface_gamearea.h"
 #include "localevent.h"
 #include "logging.h"
+#include "perf_counters.h"
 #include "players.h"
+#include "profiler.h"
+#include "render_processor.h"
 #include "serialize.h"
 #include "settings.h"
 #include "system.h"
@@ -107,6 +110,8 @@ namespace
             = { Game::HotKeyCategory::GLOBAL, gettext_noop( "hotkey|toggle fullscreen" ), fheroes2::Key::KEY_F4 };
         hotKeyEventInfo[hotKeyEventToInt( Game::HotKeyEvent::GLOBAL_TOGGLE_TEXT_SUPPORT_MODE )]
             = { Game::HotKeyCategory::GLOBAL, gettext_noop( "hotkey|toggle text support mode" ), fheroes2::Key::KEY_F10 };
+        hotKeyEventInfo[hotKeyEventToInt( Game::HotKeyEvent::GLOBAL_TOGGLE_PROFILER )]
+            = { Game::HotKeyCategory::GLOBAL, gettext_noop( "hotkey|toggle profiler" ), fheroes2::Key::KEY_F11 };
 
 #if defined( WITH_DEBUG )
         hotKeyEventInfo[hotKeyEventToInt( Game::HotKeyEvent::GLOBAL_TOGGLE_DEVELOPER_MODE )]
@@ -298,6 +303,8 @@ namespace
             = { Game::HotKeyCategory::BATTLE, gettext_noop( "hotkey|cast battle spell" ), fheroes2::Key::KEY_C };
         hotKeyEventInfo[hotKeyEventToInt( Game::HotKeyEvent::BATTLE_TOGGLE_TURN_ORDER_DISPLAY )]
             = { Game::HotKeyCategory::BATTLE, gettext_noop( "hotkey|toggle display of battle turn order" ), fheroes2::Key::KEY_T };
+        hotKeyEventInfo[hotKeyEventToInt( Game::HotKeyEvent::BATTLE_TOGGLE_FAST_FORWARD )]
+            = { Game::HotKeyCategory::BATTLE, gettext_noop( "hotkey|toggle fast-forward of battle animations" ), fheroes2::Key::KEY_F };
 
         hotKeyEventInfo[hotKeyEventToInt( Game::HotKeyEvent::TOWN_DWELLING_LEVEL_1 )]
             = { Game::HotKeyCategory::TOWN, gettext_noop( "hotkey|dwelling level 1" ), fheroes2::Key::KEY_1 };
@@ -515,6 +522,27 @@ void Game::globalKeyDownEvent( const fheroes2::Key key, const int32_t modifier )
         conf.setTextSupportMode( !conf.isTextSupportModeEnabled() );
         conf.Save( Settings::configFileName );
     }
+    else if ( key == hotKeyEventInfo[hotKeyEventToInt( HotKeyEvent::GLOBAL_TOGGLE_PROFILER )].key ) {
+        fheroes2::Profiler & profiler = fheroes2::Profiler::instance();
+
+        if ( profiler.isEnabled() ) {
+            profiler.disable();
+
+            if ( !conf.isSystemInfoEnabled() ) {
+                fheroes2::RenderProcessor::instance().disableRenderers();
+            }
+        }
+        else {
+            // The time of every frame is written into a CSV file next to the configuration file.
+            profiler.enable( System::concatPath( System::GetConfigDirectory( "fheroes2" ), "profiler.csv" ) );
+
+            // Performance counters are shown along with the profiler statistics. They are never reset to not lose the data for the report.
+            fheroes2::PerfCounters::instance().enable();
+
+            // Profiler statistics are displayed by the system info renderer.
+            fheroes2::RenderProcessor::instance().enableRenderers();
+        }
+    }
 #if defined( WITH_DEBUG )
     else if ( key == hotKeyEventInfo[hotKeyEventToInt( HotKeyEvent::GLOBAL_TOGGLE_DEVELOPER_MODE )].key ) {
         Logging::setDebugLevel( DBG_DEVEL ^ Logging::getDebugLevel() );
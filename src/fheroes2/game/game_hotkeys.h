@@ -45,6 +45,7 @@ namespace Game
 
         GLOBAL_TOGGLE_FULLSCREEN,
         GLOBAL_TOGGLE_TEXT_SUPPORT_MODE,
+        GLOBAL_TOGGLE_PROFILER,
 
 #if defined( WITH_DEBUG )
         // This hotkey is only for debug mode.
@@ -156,6 +157,7 @@ namespace Game
         BATTLE_SKIP,
         BATTLE_CAST_SPELL,
         BATTLE_TOGGLE_TURN_ORDER_DISPLAY,
+        BATTLE_TOGGLE_FAST_FORWARD,
 
         TOWN_DWELLING_LEVEL_1,
         TOWN_DWELLING_LEVEL_2,
@@ -131,8 +131,13 @@ void Interface::AdventureMap::redraw( const uint32_t force )
     const uint32_t combinedRedraw = _redraw | force;
     const bool hideInterface = conf.isHideInterfaceEnabled();
 
-    if ( combinedRedraw & REDRAW_GAMEAREA ) {
-        _gameArea.Redraw( fheroes2::Display::instance(), LEVEL_ALL );
+    if ( combinedRedraw & ( REDRAW_GAMEAREA | REDRAW_GAMEAREA_ANIMATION ) ) {
+        if ( combinedRedraw & REDRAW_GAMEAREA ) {
+            _gameArea.Redraw( fheroes2::Display::instance(), LEVEL_ALL );
+        }
+        else {
+            _gameArea.redrawAnimatedObjects( fheroes2::Display::instance(), LEVEL_ALL );
+        }
 
         if ( hideInterface && conf.ShowControlPanel() ) {
             _controlPanel._redraw();
@@ -144,22 +149,27 @@ void Interface::AdventureMap::redraw( const uint32_t force )
         _radar._redraw( combinedRedraw & REDRAW_RADAR );
     }
 
+    // Panels skip their redraw if nothing visible in them has changed. This is not possible in the "no interface" mode
+    // as they are drawn over the game area, or when the whole interface is being redrawn since their areas might have been
+    // overwritten by something else.
+    const bool forcePanelRedraw = hideInterface || ( combinedRedraw & REDRAW_BORDER );
+
     if ( ( hideInterface && conf.ShowIcons() ) || ( combinedRedraw & REDRAW_ICONS ) ) {
-        _iconsPanel._redraw();
+        _iconsPanel._redraw( forcePanelRedraw );
     }
     else if ( combinedRedraw & REDRAW_HEROES ) {
-        _iconsPanel._redrawIcons( ICON_HEROES );
+        _iconsPanel._redrawIcons( ICON_HEROES, forcePanelRedraw );
     }
     else if ( combinedRedraw & REDRAW_CASTLES ) {
-        _iconsPanel._redrawIcons( ICON_CASTLES );
+        _iconsPanel._redrawIcons( ICON_CASTLES, forcePanelRedraw );
     }
 
     if ( ( hideInterface && conf.ShowButtons() ) || ( combinedRedraw & REDRAW_BUTTONS ) ) {
-        _buttonsPanel._redraw();
+        _buttonsPanel._redraw( forcePanelRedraw );
     }
 
     if ( ( hideInterface && conf.ShowStatus() ) || ( combinedRedraw & REDRAW_STATUS ) ) {
-        _statusPanel._redraw();
+        _statusPanel._redraw( forcePanelRedraw );
     }
 
     if ( combinedRedraw & REDRAW_BORDER ) {
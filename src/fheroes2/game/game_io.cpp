@@ -26,7 +26,12 @@
 #include <algorithm>
 #include <cctype>
 #include <cstdint>
+#include <chrono>
 #include <ctime>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <ostream>
 #include <utility>
 
@@ -42,6 +47,7 @@
 #include "serialize.h"
 #include "settings.h"
 #include "system.h"
+#include "thread.h"
 #include "translations.h"
 #include "ui_dialog.h"
 #include "ui_font.h"
@@ -57,7 +63,20 @@ namespace
 
     const uint16_t saveFileMagicNumber{ 0xFF03 };
 
-    uint16_t versionOfCurrentSaveFile = CURRENT_FORMAT_VERSION;
+    // Save file headers can be read by several threads at once, each of them deserializing its own version of the save format.
+    thread_local uint16_t versionOfCurrentSaveFile = CURRENT_FORMAT_VERSION;
+
+    struct SaveFileInfoCacheEntry
+    {
+        uint64_t fileSize{ 0 };
+        int64_t modificationTime{ 0 };
+        int gameType{ 0 };
+        Maps::FileInfo info;
+    };
+
+    // Headers of the save files which were already read, so they don't need to be read again until the file is modified.
+    std::map<std::string, SaveFileInfoCacheEntry> saveFileInfoCache;
+    std::mutex saveFileInfoCacheMutex;
 
     std::string lastSaveName;
 
@@ -101,11 +120,188 @@ namespace
     {
         return stream >> hdr.requirements >> hdr.info >> hdr.gameType;
     }
+
+    // The result of the autosave being written in the background.
+    std::future<bool> autoSaveResult;
+
+    // Serializes the save file header and the uncompressed game state. Must be called from the main thread.
+    bool serializeGame( OStreamBase & headerStream, RWStreamBuf & dataStream )
+    {
+        // Always use the latest version of the file save format
+        Game::SetVersionOfCurrentSaveFile( CURRENT_FORMAT_VERSION );
+        const uint16_t saveFileVersion = CURRENT_FORMAT_VERSION;
+
+        // Header
+        const Settings & conf = Settings::Get();
+
+        headerStream << saveFileMagicNumber << std::to_string( saveFileVersion ) << saveFileVersion
+                     << HeaderSAV( conf.getCurrentMapInfo(), conf.GameType(), world.GetDay(), world.GetWeek(), world.GetMonth() );
+        if ( headerStream.fail() ) {
+            return false;
+        }
+
+        dataStream.setBigendian( true );
+
+        dataStream << World::Get() << conf << GameOver::Result::Get();
+        if ( dataStream.fail() ) {
+            return false;
+        }
+
+        if ( conf.isCampaignGameType() ) {
+            dataStream << Campaign::CampaignSaveData::Get();
+        }
+
+        // End-of-data marker
+        dataStream << saveFileMagicNumber;
+
+        return !dataStream.fail();
+    }
+
+    bool readSaveFileHeader( const std::string & filePath, Maps::FileInfo & fileInfo, int & gameType )
+    {
+        DEBUG_LOG( DBG_GAME, DBG_INFO, filePath )
+
+        StreamFile fs;
+        fs.setBigendian( true );
+
+        if ( !fs.open( filePath, "rb" ) ) {
+            DEBUG_LOG( DBG_GAME, DBG_WARN, "Error opening the file " << filePath )
+            return false;
+        }
+
+        uint16_t magicNumber = 0;
+        fs >> magicNumber;
+
+        if ( magicNumber != saveFileMagicNumber ) {
+            DEBUG_LOG( DBG_GAME, DBG_WARN, "Invalid file identifier in the file " << filePath )
+            return false;
+        }
+
+        std::string saveFileVersionStr;
+        uint16_t saveFileVersion = 0;
+
+        fs >> saveFileVersionStr >> saveFileVersion;
+
+        DEBUG_LOG( DBG_GAME, DBG_TRACE, "Version of the file " << filePath << ": " << saveFileVersion )
+
+        if ( saveFileVersion > CURRENT_FORMAT_VERSION || saveFileVersion < LAST_SUPPORTED_FORMAT_VERSION ) {
+            return false;
+        }
+
+        Game::SetVersionOfCurrentSaveFile( saveFileVersion );
+
+        HeaderSAV header;
+        fs >> header;
+
+        if ( fs.fail() ) {
+            return false;
+        }
+
+        fileInfo = std::move( header.info );
+        gameType = header.gameType;
+
+        return true;
+    }
+
+    // Can be called by several threads at once.
+    bool loadSaveFileInfo( std::string filePath, Maps::FileInfo & fileInfo )
+    {
+        uint64_t fileSize = 0;
+        int64_t modificationTime = 0;
+
+        const bool hasFileStamp = System::GetFileStamp( filePath, fileSize, modificationTime );
+
+        int gameType = 0;
+        bool isCached = false;
+
+        if ( hasFileStamp ) {
+            const std::scoped_lock<std::mutex> lock( saveFileInfoCacheMutex );
+
+            const auto iter = saveFileInfoCache.find( filePath );
+            if ( iter != saveFileInfoCache.end() && iter->second.fileSize == fileSize && iter->second.modificationTime == modificationTime ) {
+                fileInfo = iter->second.info;
+                gameType = iter->second.gameType;
+                isCached = true;
+            }
+        }
+
+        if ( !isCached ) {
+            if ( !readSaveFileHeader( filePath, fileInfo, gameType ) ) {
+                return false;
+            }
+
+            if ( hasFileStamp ) {
+                const std::scoped_lock<std::mutex> lock( saveFileInfoCacheMutex );
+
+                saveFileInfoCache[filePath] = { fileSize, modificationTime, gameType, fileInfo };
+            }
+        }
+
+        if ( ( Settings::Get().GameType() & gameType ) == 0 ) {
+            return false;
+        }
+
+        fileInfo.filename = std::move( filePath );
+
+        return true;
+    }
 }
 
 bool Game::AutoSave()
 {
-    return Game::Save( System::concatPath( GetSaveDir(), autoSaveName + GetSaveFileExtension() ), true );
+    waitForAutoSave();
+
+    const std::string filePath = System::concatPath( GetSaveDir(), autoSaveName + GetSaveFileExtension() );
+
+    DEBUG_LOG( DBG_GAME, DBG_INFO, filePath )
+
+    // The game state is serialized right away, so the player can continue playing while it is compressed and written to the disk.
+    auto headerStream = std::make_shared<RWStreamBuf>();
+    headerStream->setBigendian( true );
+
+    auto dataStream = std::make_shared<RWStreamBuf>();
+
+    if ( !serializeGame( *headerStream, *dataStream ) ) {
+        return false;
+    }
+
+    const int compressionLevel = Settings::Get().saveCompressionLevel();
+
+    autoSaveResult = MultiThreading::JobSystem::Get().async( [filePath, headerStream, dataStream, compressionLevel]() {
+        StreamFile fileStream;
+        fileStream.setBigendian( true );
+
+        if ( !fileStream.open( filePath, "wb" ) ) {
+            return false;
+        }
+
+        fileStream.putRaw( headerStream->data(), headerStream->size() );
+
+        return !fileStream.fail() && Compression::zipStreamBuf( *dataStream, fileStream, compressionLevel );
+    } );
+
+    return true;
+}
+
+void Game::waitForAutoSave()
+{
+    if ( autoSaveResult.valid() ) {
+        autoSaveResult.wait();
+    }
+}
+
+std::optional<bool> Game::takeAutoSaveResult()
+{
+    if ( !autoSaveResult.valid() || autoSaveResult.wait_for( std::chrono::seconds( 0 ) ) != std::future_status::ready ) {
+        return {};
+    }
+
+    const bool isSaved = autoSaveResult.get();
+    if ( !isSaved ) {
+        ERROR_LOG( "Failed to write the autosave file." )
+    }
+
+    return isSaved;
 }
 
 bool Game::QuickSave()
@@ -117,6 +313,9 @@ bool Game::Save( const std::string & filePath, const bool autoSave /* = false */
 {
     DEBUG_LOG( DBG_GAME, DBG_INFO, filePath )
 
+    // The autosave might be still written to the same file.
+    waitForAutoSave();
+
     StreamFile fileStream;
     fileStream.setBigendian( true );
 
@@ -125,34 +324,9 @@ bool Game::Save( const std::string & filePath, const bool autoSave /* = false */
         return false;
     }
 
-    // Always use the latest version of the file save format
-    SetVersionOfCurrentSaveFile( CURRENT_FORMAT_VERSION );
-    const uint16_t saveFileVersion = CURRENT_FORMAT_VERSION;
-
-    // Header
-    const Settings & conf = Settings::Get();
-
-    fileStream << saveFileMagicNumber << std::to_string( saveFileVersion ) << saveFileVersion
-               << HeaderSAV( conf.getCurrentMapInfo(), conf.GameType(), world.GetDay(), world.GetWeek(), world.GetMonth() );
-    if ( fileStream.fail() ) {
-        return false;
-    }
-
     RWStreamBuf dataStream;
-    dataStream.setBigendian( true );
-
-    dataStream << World::Get() << conf << GameOver::Result::Get();
-    if ( dataStream.fail() ) {
-        return false;
-    }
-
-    if ( conf.isCampaignGameType() ) {
-        dataStream << Campaign::CampaignSaveData::Get();
-    }
 
-    // End-of-data marker
-    dataStream << saveFileMagicNumber;
-    if ( dataStream.fail() || !Compression::zipStreamBuf( dataStream, fileStream ) ) {
+    if ( !serializeGame( fileStream, dataStream ) || !Compression::zipStreamBuf( dataStream, fileStream, Settings::Get().saveCompressionLevel() ) ) {
         return false;
     }
 
@@ -169,6 +343,9 @@ fheroes2::GameMode Game::Load( const std::string & filePath )
 
     const auto showGenericErrorMessage = []() { fheroes2::showStandardTextMessage( _( "Error" ), _( "The save file is corrupted." ), Dialog::OK ); };
 
+    // The file might be the autosave which is still being written.
+    waitForAutoSave();
+
     StreamFile fileStream;
     fileStream.setBigendian( true );
 
@@ -306,52 +483,33 @@ fheroes2::GameMode Game::Load( const std::string & filePath )
 
 bool Game::LoadSAV2FileInfo( std::string filePath, Maps::FileInfo & fileInfo )
 {
-    DEBUG_LOG( DBG_GAME, DBG_INFO, filePath )
+    waitForAutoSave();
 
-    StreamFile fs;
-    fs.setBigendian( true );
-
-    if ( !fs.open( filePath, "rb" ) ) {
-        DEBUG_LOG( DBG_GAME, DBG_WARN, "Error opening the file " << filePath )
-        return false;
-    }
-
-    uint16_t magicNumber = 0;
-    fs >> magicNumber;
-
-    if ( magicNumber != saveFileMagicNumber ) {
-        DEBUG_LOG( DBG_GAME, DBG_WARN, "Invalid file identifier in the file " << filePath )
-        return false;
-    }
-
-    std::string saveFileVersionStr;
-    uint16_t saveFileVersion = 0;
-
-    fs >> saveFileVersionStr >> saveFileVersion;
-
-    DEBUG_LOG( DBG_GAME, DBG_TRACE, "Version of the file " << filePath << ": " << saveFileVersion )
+    return loadSaveFileInfo( std::move( filePath ), fileInfo );
+}
 
-    if ( saveFileVersion > CURRENT_FORMAT_VERSION || saveFileVersion < LAST_SUPPORTED_FORMAT_VERSION ) {
-        return false;
-    }
+std::vector<Maps::FileInfo> Game::LoadSAV2FileInfos( const std::vector<std::string> & filePaths )
+{
+    waitForAutoSave();
 
-    SetVersionOfCurrentSaveFile( saveFileVersion );
+    std::vector<Maps::FileInfo> fileInfos( filePaths.size() );
+    // std::vector<bool> cannot be used here since its elements are modified by different threads.
+    std::vector<uint8_t> isLoaded( filePaths.size(), 0 );
 
-    HeaderSAV header;
-    fs >> header;
+    MultiThreading::JobSystem::Get().parallelFor( 0, filePaths.size(), [&filePaths, &fileInfos, &isLoaded]( const size_t i ) {
+        isLoaded[i] = loadSaveFileInfo( filePaths[i], fileInfos[i] ) ? 1 : 0;
+    } );
 
-    if ( fs.fail() ) {
-        return false;
-    }
+    std::vector<Maps::FileInfo> result;
+    result.reserve( fileInfos.size() );
 
-    if ( ( Settings::Get().GameType() & header.gameType ) == 0 ) {
-        return false;
+    for ( size_t i = 0; i < fileInfos.size(); ++i ) {
+        if ( isLoaded[i] ) {
+            result.emplace_back( std::move( fileInfos[i] ) );
+        }
     }
 
-    fileInfo = std::move( header.info );
-    fileInfo.filename = std::move( filePath );
-
-    return true;
+    return result;
 }
 
 void Game::SetVersionOfCurrentSaveFile( const uint16_t version )
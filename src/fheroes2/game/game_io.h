@@ -24,7 +24,9 @@
 #pragma once
 
 #include <cstdint>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include "game_mode.h"
 
@@ -46,9 +48,17 @@ namespace Game
     std::string GetSaveFileExtension();
     std::string GetSaveFileExtension( const int gameType );
 
+    // Takes a snapshot of the game state and writes it to the autosave file in the background.
+    // Returns false if the snapshot could not be taken.
     bool AutoSave();
     bool QuickSave();
 
+    // Blocks until the autosave being written in the background, if any, is completed.
+    void waitForAutoSave();
+
+    // Returns the result of the background autosave if it has been completed since the last call.
+    std::optional<bool> takeAutoSaveResult();
+
     bool Save( const std::string & filePath, const bool autoSave = false );
 
     // Returns GameMode::CANCEL in case of failure.
@@ -56,5 +66,8 @@ namespace Game
 
     bool LoadSAV2FileInfo( std::string filePath, Maps::FileInfo & fileInfo );
 
+    // Reads the headers of the given save files in parallel. Files which cannot be read or do not match the current game type are skipped.
+    std::vector<Maps::FileInfo> LoadSAV2FileInfos( const std::vector<std::string> & filePaths );
+
     bool SaveCompletedCampaignScenario();
 }
@@ -30,15 +30,23 @@
 
 #include "cursor.h"
 #include "dialog.h"
+#include "dialog_selectscenario.h"
+#include "game_mainmenu_ui.h"
 #include "localevent.h"
+#include "maps_fileinfo.h"
 #include "screen.h"
+#include "serialize.h"
 #include "settings.h"
+#include "system.h"
 #include "translations.h"
+#include "ui_button.h"
+#include "ui_dialog.h"
 #include "ui_text.h"
 #include "ui_tool.h"
 #include "ui_window.h"
 
 #include "network/lan_lobby.h"
+#include "network/lan_lobby_worker.h"
 
 namespace
 {
@@ -53,22 +61,30 @@ namespace
         return ( privacy == Network::LobbyPrivacy::InviteOnly ) ? _( "Invite only" ) : _( "Open" );
     }
 
-    void drainChat( Network::LanLobbyHost & host, std::deque<Network::LobbyChatMessage> & chatLog, bool & changed )
+    std::string connectionStatsToString( const Network::LobbyConnectionStats & stats )
     {
-        while ( true ) {
-            auto msg = host.popChat();
-            if ( !msg ) {
-                break;
-            }
-            chatLog.emplace_back( std::move( *msg ) );
-            changed = true;
-        }
+        std::string line = std::to_string( stats.rttMs );
+        line += _( " ms" );
+        line += ", ";
+        line += std::to_string( stats.bytesIn / 1024 );
+        line += _( " KB in" );
+        line += ", ";
+        line += std::to_string( stats.bytesOut / 1024 );
+        line += _( " KB out" );
+
+        if ( stats.queuedBytes > 0 ) {
+            line += ", ";
+            line += std::to_string( stats.queuedBytes / 1024 );
+            line += _( " KB queued" );
+        }
+
+        return line;
     }
 
-    void drainChat( Network::LanLobbyClient & client, std::deque<Network::LobbyChatMessage> & chatLog, bool & changed )
+    void drainChat( Network::LanLobbyWorker & lobby, std::deque<Network::LobbyChatMessage> & chatLog, bool & changed )
     {
         while ( true ) {
-            auto msg = client.popChat();
+            auto msg = lobby.popChat();
             if ( !msg ) {
                 break;
             }
@@ -120,6 +136,18 @@ namespace
                                     multiline, {} );
     }
 
+    bool readMapFile( const std::string & path, std::vector<uint8_t> & content )
+    {
+        StreamFile file;
+        if ( !file.open( path, "rb" ) ) {
+            return false;
+        }
+
+        content = file.getRaw( 0 );
+
+        return !file.fail() && !content.empty();
+    }
+
     bool hostInfoEquals( const Network::LobbyHostInfo & a, const Network::LobbyHostInfo & b )
     {
         return a.lobbyId == b.lobbyId && a.endpoint.address == b.endpoint.address && a.endpoint.port == b.endpoint.port;
@@ -189,16 +217,35 @@ fheroes2::GameMode Game::LocalLanLobby()
     Network::LobbyPrivacy privacy = Network::LobbyPrivacy::Open;
     std::string inviteCode;
 
-    Network::LanLobbyHost host;
-    Network::LanLobbyClient client;
+    // Address of the relay server for internet games, see Network::LobbyRelayServer.
+    std::string relayAddress;
+
+    // The map offered by the host to the clients, see Network::LanLobbyHost::offerFile().
+    std::string offeredMapName;
+    uint32_t offeredMapTransferId = 0;
+
+    // Lobby networking runs on background threads, the UI only exchanges messages with them.
+    Network::LanLobbyHostWorker host;
+    Network::LanLobbyClientWorker client;
     client.startDiscovery();
 
+    // Maps offered by the host are downloaded next to the user's own maps so they show up in the scenario list.
+    if ( const std::string dataPath = System::GetDataDirectory( "fheroes2" ); !dataPath.empty() ) {
+        const std::string mapDirectory = System::concatPath( dataPath, "maps" );
+        if ( System::IsDirectory( mapDirectory ) || System::MakeDirectory( mapDirectory ) ) {
+            client.setDownloadDirectory( mapDirectory );
+        }
+    }
+
     std::vector<Network::LobbyHostInfo> discovered;
     int32_t selectedLobby = -1;
     int32_t discoveredScroll = 0;
 
     std::optional<Network::LobbyHostInfo> connectedHost;
 
+    // Quality of the connections to the clients when hosting, or of the connection to the host when joined.
+    std::vector<Network::LobbyConnectionStats> connectionStats;
+
     // These get recomputed when drawing Join view.
     fheroes2::Rect discoveredListRoi;
     int32_t discoveredRowHeight = 0;
@@ -221,6 +268,8 @@ fheroes2::GameMode Game::LocalLanLobby()
     fheroes2::ButtonSprite buttonSetLobby;
     fheroes2::ButtonSprite buttonPrivacy;
     fheroes2::ButtonSprite buttonInvite;
+    fheroes2::ButtonSprite buttonOfferMap;
+    fheroes2::ButtonSprite buttonJoinRelay;
 
     const fheroes2::FontType headerFont = fheroes2::FontType::normalYellow();
 
@@ -262,6 +311,12 @@ fheroes2::GameMode Game::LocalLanLobby()
                 line += std::to_string( connectedHost->endpoint.port );
                 line += ")";
             }
+
+            if ( client.isConnected() && !connectionStats.empty() ) {
+                line += " - ";
+                line += std::to_string( connectionStats.front().rttMs );
+                line += _( " ms" );
+            }
         }
 
         fheroes2::Text chatHeader( line, headerFont );
@@ -293,6 +348,8 @@ fheroes2::GameMode Game::LocalLanLobby()
         // Mode-specific buttons must be explicitly toggled to avoid drawing stale sprites.
         buttonSetLobby.disable();
         buttonPrivacy.disable();
+        buttonOfferMap.disable();
+        buttonJoinRelay.disable();
 
         const int32_t x = leftPanel.x + 8;
         int32_t y = leftPanel.y + 8;
@@ -315,7 +372,11 @@ fheroes2::GameMode Game::LocalLanLobby()
             y += buttonPrivacy.area().height + 6;
 
             window.renderTextAdaptedButtonSprite( buttonInvite, _( "Set invite code" ), { x - active.x, y - active.y }, fheroes2::StandardWindow::Padding::TOP_LEFT );
-            y += buttonInvite.area().height + 10;
+            y += buttonInvite.area().height + 6;
+
+            window.renderTextAdaptedButtonSprite( buttonOfferMap, _( "Offer map" ), { x - active.x, y - active.y }, fheroes2::StandardWindow::Padding::TOP_LEFT );
+            buttonOfferMap.enable();
+            y += buttonOfferMap.area().height + 10;
 
             const fheroes2::FontType font( fheroes2::FontSize::SMALL, fheroes2::FontColor::WHITE );
             const fheroes2::FontType highlightFont( fheroes2::FontSize::SMALL, fheroes2::FontColor::YELLOW );
@@ -347,6 +408,34 @@ fheroes2::GameMode Game::LocalLanLobby()
                 invite.fitToOneRow( leftPanel.width - 16 );
                 invite.draw( x, y, display );
             }
+            y += fheroes2::Text( std::string(), font ).height() + 6;
+
+            if ( host.isRunning() && offeredMapTransferId != 0 ) {
+                std::string mapLine = _( "Map:" ) + std::string( " " ) + offeredMapName + " - ";
+                mapLine += host.isFileDelivered( offeredMapTransferId ) ? _( "received by all players" ) : _( "sending" );
+
+                fheroes2::Text mapInfo( mapLine, font );
+                mapInfo.fitToOneRow( leftPanel.width - 16 );
+                mapInfo.draw( x, y, display );
+                y += mapInfo.height() + 6;
+            }
+
+            if ( host.isRunning() && !connectionStats.empty() ) {
+                fheroes2::Text connectionsHeader( _( "Connections:" ), font );
+                connectionsHeader.draw( x, y, display );
+                y += connectionsHeader.height() + 2;
+
+                for ( const Network::LobbyConnectionStats & stats : connectionStats ) {
+                    fheroes2::Text connection( stats.name + ": " + connectionStatsToString( stats ), font );
+                    if ( y + connection.height() > leftPanel.y + leftPanel.height - 8 ) {
+                        break;
+                    }
+
+                    connection.fitToOneRow( leftPanel.width - 16 );
+                    connection.draw( x, y, display );
+                    y += connection.height();
+                }
+            }
         }
         else {
             const std::string actionText = client.isConnected() ? _( "Disconnect" ) : _( "Connect" );
@@ -357,7 +446,16 @@ fheroes2::GameMode Game::LocalLanLobby()
             y += buttonSetName.area().height + 6;
 
             window.renderTextAdaptedButtonSprite( buttonInvite, _( "Set invite code" ), { x - active.x, y - active.y }, fheroes2::StandardWindow::Padding::TOP_LEFT );
-            y += buttonInvite.area().height + 10;
+            y += buttonInvite.area().height + 6;
+
+            if ( !client.isConnected() ) {
+                window.renderTextAdaptedButtonSprite( buttonJoinRelay, _( "Join via relay" ), { x - active.x, y - active.y },
+                                                      fheroes2::StandardWindow::Padding::TOP_LEFT );
+                buttonJoinRelay.enable();
+                y += buttonJoinRelay.area().height + 6;
+            }
+
+            y += 4;
 
             const fheroes2::FontType font( fheroes2::FontSize::SMALL, fheroes2::FontColor::WHITE );
 
@@ -460,20 +558,32 @@ fheroes2::GameMode Game::LocalLanLobby()
     bool needChatRedraw = false;
 
     while ( le.HandleEvents() ) {
-        // Background pumping.
+        // Collect whatever the network workers have received since the last frame.
         if ( viewMode == LobbyViewMode::Host ) {
             if ( host.isRunning() ) {
-                host.pump();
                 drainChat( host, chatLog, needChatRedraw );
+
+                if ( std::optional<std::vector<Network::LobbyConnectionStats>> stats = host.popConnectionStats() ) {
+                    connectionStats = std::move( *stats );
+                    needLeftRedraw = true;
+                }
             }
         }
         else {
-            client.pumpDiscovery();
             mergeDiscovered( discovered, client.drainDiscovered(), needLeftRedraw );
 
             if ( client.isConnected() ) {
-                client.pumpConnection();
                 drainChat( client, chatLog, needChatRedraw );
+
+                if ( std::optional<std::vector<Network::LobbyConnectionStats>> stats = client.popConnectionStats() ) {
+                    connectionStats = std::move( *stats );
+                    renderChatHeader();
+                }
+
+                while ( std::optional<Network::LobbyReceivedFile> file = client.popReceivedFile() ) {
+                    chatLog.push_back( Network::LobbyChatMessage{ 0, "system", _( "Received file:" ) + std::string( " " ) + file->name } );
+                    needChatRedraw = true;
+                }
             }
         }
 
@@ -513,6 +623,12 @@ fheroes2::GameMode Game::LocalLanLobby()
         if ( buttonInvite.isEnabled() ) {
             buttonInvite.drawOnState( le.isMouseLeftButtonPressedAndHeldInArea( buttonInvite.area() ) );
         }
+        if ( buttonOfferMap.isEnabled() ) {
+            buttonOfferMap.drawOnState( le.isMouseLeftButtonPressedAndHeldInArea( buttonOfferMap.area() ) );
+        }
+        if ( buttonJoinRelay.isEnabled() ) {
+            buttonJoinRelay.drawOnState( le.isMouseLeftButtonPressedAndHeldInArea( buttonJoinRelay.area() ) );
+        }
 
         if ( le.MouseClickLeft( buttonBack.area() ) ) {
             if ( host.isRunning() ) {
@@ -528,6 +644,7 @@ fheroes2::GameMode Game::LocalLanLobby()
             client.disconnect();
             client.stopDiscovery();
             connectedHost.reset();
+            connectionStats.clear();
             discovered.clear();
             selectedLobby = -1;
             needLeftRedraw = true;
@@ -541,6 +658,7 @@ fheroes2::GameMode Game::LocalLanLobby()
             if ( host.isRunning() ) {
                 host.stop();
             }
+            connectionStats.clear();
             client.startDiscovery();
             needLeftRedraw = true;
             needChatRedraw = true;
@@ -601,6 +719,66 @@ fheroes2::GameMode Game::LocalLanLobby()
             needLeftRedraw = true;
         }
 
+        if ( viewMode == LobbyViewMode::Host && le.MouseClickLeft( buttonOfferMap.area() ) ) {
+            if ( !host.isRunning() ) {
+                fheroes2::showStandardTextMessage( _( "Offer map" ), _( "Start hosting first." ), Dialog::OK );
+            }
+            else {
+                // A network game has at least two human players: the host and a client.
+                MapsFileInfoList maps = Maps::getAllMapFileInfos( false, 2 );
+                const Maps::FileInfo * mapInfo = Dialog::SelectScenario( maps, false );
+
+                std::vector<uint8_t> content;
+                if ( mapInfo != nullptr && readMapFile( mapInfo->filename, content ) ) {
+                    // Clients keep the files they have already received, only the current map is streamed.
+                    if ( offeredMapTransferId != 0 ) {
+                        host.withdrawFile( offeredMapTransferId );
+                    }
+
+                    offeredMapName = mapInfo->name;
+                    offeredMapTransferId = host.offerFile( System::GetFileName( mapInfo->filename ), std::move( content ) );
+
+                    if ( offeredMapTransferId == 0 ) {
+                        fheroes2::showStandardTextMessage( _( "Error" ), _( "Failed to offer the map." ), Dialog::OK );
+                    }
+                }
+                else if ( mapInfo != nullptr ) {
+                    fheroes2::showStandardTextMessage( _( "Error" ), _( "Failed to read the map file." ), Dialog::OK );
+                }
+
+                display.render();
+                needLeftRedraw = true;
+            }
+        }
+
+        if ( viewMode == LobbyViewMode::Join && buttonJoinRelay.isEnabled() && le.MouseClickLeft( buttonJoinRelay.area() ) ) {
+            std::string address = relayAddress;
+            std::string name = lobbyName;
+            if ( inputText( _( "Relay Server" ), _( "Enter the relay server address (IP[:port]):" ), address, 32, false )
+                 && inputText( _( "Lobby Name" ), _( "Enter the name of the lobby to join or to create:" ), name, 32, false ) && !name.empty() ) {
+                const std::optional<Network::IpEndpoint> relay = Network::parseIpEndpoint( address, Network::lobbyRelayDefaultPort );
+                if ( !relay ) {
+                    fheroes2::showStandardTextMessage( _( "Error" ), _( "Invalid relay server address." ), Dialog::OK );
+                }
+                else {
+                    relayAddress = std::move( address );
+                    lobbyName = std::move( name );
+
+                    const Network::LobbyHostInfo info = Network::getRelayLobbyInfo( *relay, lobbyName );
+                    if ( !client.connectToHost( info, playerName, inviteCode ) ) {
+                        fheroes2::showStandardTextMessage( _( "Error" ), _( "Failed to connect." ), Dialog::OK );
+                    }
+                    else {
+                        connectedHost = info;
+                    }
+                }
+            }
+
+            needLeftRedraw = true;
+            needChatRedraw = true;
+            renderChatHeader();
+        }
+
         if ( le.MouseClickLeft( buttonInvite.area() ) ) {
             std::string tmp = inviteCode;
             if ( inputText( _( "Invite Code" ), _( "Enter invite code (leave empty for none):" ), tmp, 32, false ) ) {
@@ -613,6 +791,7 @@ fheroes2::GameMode Game::LocalLanLobby()
             if ( viewMode == LobbyViewMode::Host ) {
                 if ( host.isRunning() ) {
                     host.stop();
+                    connectionStats.clear();
                     needLeftRedraw = true;
                     renderChatHeader();
                 }
@@ -623,6 +802,10 @@ fheroes2::GameMode Game::LocalLanLobby()
                     else if ( !host.start( lobbyName, playerName, privacy, inviteCode ) ) {
                         fheroes2::showStandardTextMessage( _( "Error" ), _( "Failed to start hosting." ), Dialog::OK );
                     }
+
+                    // Offers do not survive a restart of the lobby.
+                    offeredMapName.clear();
+                    offeredMapTransferId = 0;
                     needLeftRedraw = true;
                     renderChatHeader();
                 }
@@ -631,6 +814,7 @@ fheroes2::GameMode Game::LocalLanLobby()
                 if ( client.isConnected() ) {
                     client.disconnect();
                     connectedHost.reset();
+                    connectionStats.clear();
                     needLeftRedraw = true;
                     needChatRedraw = true;
                     renderChatHeader();
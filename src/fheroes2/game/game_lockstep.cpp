@@ -0,0 +1,194 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "game_lockstep.h"
+
+#include "army_troop.h"
+#include "castle.h"
+#include "color.h"
+#include "heroes.h"
+#include "logging.h"
+#include "maps.h"
+#include "monster.h"
+#include "network/lobby_frame.h"
+#include "network/lockstep.h"
+#include "serialize.h"
+#include "world.h"
+
+namespace
+{
+    enum class CommandType : uint8_t
+    {
+        HERO_MOVE = 1,
+        BUILD = 2,
+        RECRUIT = 3
+    };
+
+    template <typename Writer>
+    std::vector<uint8_t> encode( const CommandType type, const Writer & writer )
+    {
+        std::vector<uint8_t> payload;
+
+        Network::FrameWriter stream( payload );
+        stream << type;
+        writer( stream );
+
+        return payload;
+    }
+
+    bool isOwnedBy( const ColorBase & object, const uint8_t player )
+    {
+        return static_cast<uint8_t>( object.GetColor() ) == player;
+    }
+
+    bool applyHeroMove( IStreamBase & stream, const uint8_t player )
+    {
+        int32_t heroId = 0;
+        int32_t destinationIdx = 0;
+        stream >> heroId >> destinationIdx;
+
+        if ( stream.fail() || !Maps::isValidAbsIndex( destinationIdx ) ) {
+            return false;
+        }
+
+        Heroes * hero = world.GetHeroes( heroId );
+        if ( hero == nullptr || !isOwnedBy( *hero, player ) ) {
+            return false;
+        }
+
+        hero->calculatePath( destinationIdx );
+        if ( !hero->GetPath().isValidForMovement() ) {
+            return false;
+        }
+
+        // The hero is moved by the adventure map loop the same way as for the local player.
+        hero->SetMove( true );
+
+        return true;
+    }
+
+    Castle * readCastle( IStreamBase & stream, const uint8_t player )
+    {
+        int32_t castleIdx = 0;
+        stream >> castleIdx;
+
+        if ( stream.fail() || !Maps::isValidAbsIndex( castleIdx ) ) {
+            return nullptr;
+        }
+
+        Castle * castle = world.getCastleEntrance( Maps::GetPoint( castleIdx ) );
+        if ( castle == nullptr || !isOwnedBy( *castle, player ) ) {
+            return nullptr;
+        }
+
+        return castle;
+    }
+
+    bool applyBuild( IStreamBase & stream, const uint8_t player )
+    {
+        Castle * castle = readCastle( stream, player );
+        if ( castle == nullptr ) {
+            return false;
+        }
+
+        uint32_t buildingType = 0;
+        stream >> buildingType;
+
+        if ( stream.fail() ) {
+            return false;
+        }
+
+        return castle->BuyBuilding( buildingType );
+    }
+
+    bool applyRecruit( IStreamBase & stream, const uint8_t player )
+    {
+        Castle * castle = readCastle( stream, player );
+        if ( castle == nullptr ) {
+            return false;
+        }
+
+        int32_t monsterId = 0;
+        uint32_t count = 0;
+        stream >> monsterId >> count;
+
+        if ( stream.fail() ) {
+            return false;
+        }
+
+        return castle->RecruitMonster( Troop( Monster( monsterId ), count ), false );
+    }
+}
+
+namespace Game::Lockstep
+{
+    std::vector<uint8_t> encodeHeroMove( const Heroes & hero, const int32_t destinationIdx )
+    {
+        return encode( CommandType::HERO_MOVE, [&hero, destinationIdx]( OStreamBase & stream ) { stream << hero.GetID() << destinationIdx; } );
+    }
+
+    std::vector<uint8_t> encodeBuild( const Castle & castle, const uint32_t buildingType )
+    {
+        return encode( CommandType::BUILD, [&castle, buildingType]( OStreamBase & stream ) { stream << castle.GetIndex() << buildingType; } );
+    }
+
+    std::vector<uint8_t> encodeRecruit( const Castle & castle, const Troop & troop )
+    {
+        return encode( CommandType::RECRUIT, [&castle, &troop]( OStreamBase & stream ) {
+            stream << castle.GetIndex() << static_cast<int32_t>( troop.GetID() ) << troop.GetCount();
+        } );
+    }
+
+    bool applyCommand( const Network::LockstepCommand & cmd )
+    {
+        if ( cmd.kind != Network::LockstepCommand::Kind::Action ) {
+            return true;
+        }
+
+        ROStreamBuf stream( cmd.payload );
+        stream.setBigendian( IS_BIGENDIAN );
+
+        CommandType type{};
+        stream >> type;
+
+        bool isApplied = false;
+
+        switch ( type ) {
+        case CommandType::HERO_MOVE:
+            isApplied = applyHeroMove( stream, cmd.player );
+            break;
+        case CommandType::BUILD:
+            isApplied = applyBuild( stream, cmd.player );
+            break;
+        case CommandType::RECRUIT:
+            isApplied = applyRecruit( stream, cmd.player );
+            break;
+        default:
+            break;
+        }
+
+        if ( !isApplied ) {
+            ERROR_LOG( "Failed to apply command " << cmd.sequence << " of player " << static_cast<int>( cmd.player ) << " in turn " << cmd.turn
+                                                  << ", type: " << static_cast<int>( type ) )
+        }
+
+        return isApplied;
+    }
+}
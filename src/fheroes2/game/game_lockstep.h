@@ -0,0 +1,46 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+class Castle;
+class Heroes;
+class Troop;
+
+namespace Network
+{
+    struct LockstepCommand;
+}
+
+// Player commands replicated between peers of a network game (see Network::LockstepSession). Every peer applies
+// the same commands to its own World, so only the commands are sent over the network and never the game state.
+namespace Game::Lockstep
+{
+    std::vector<uint8_t> encodeHeroMove( const Heroes & hero, const int32_t destinationIdx );
+    std::vector<uint8_t> encodeBuild( const Castle & castle, const uint32_t buildingType );
+    std::vector<uint8_t> encodeRecruit( const Castle & castle, const Troop & troop );
+
+    // Applies a command received from a remote peer to the local World. Returns false if the command is malformed
+    // or cannot be applied, which means that the peers are out of sync.
+    bool applyCommand( const Network::LockstepCommand & cmd );
+}
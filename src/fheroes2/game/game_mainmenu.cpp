@@ -109,6 +109,13 @@ void Game::mainGameLoop( bool isFirstGameRun, bool isProbablyDemoVersion )
     bool exit = false;
 
     while ( !exit ) {
+        // No references to ICN sprites are held between game modes, so it is a safe place to release unused resources.
+        fheroes2::AGG::releaseUnusedICNs();
+
+        if ( IS_DEBUG( DBG_ENGINE, DBG_TRACE ) ) {
+            fheroes2::AGG::logICNMemoryUsage();
+        }
+
         switch ( result ) {
         case fheroes2::GameMode::QUIT_GAME:
             exit = true;
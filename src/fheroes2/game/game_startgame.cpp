@@ -28,7 +28,9 @@
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <future>
 #include <memory>
+#include <optional>
 #include <ostream>
 #include <string>
 #include <utility>
@@ -77,6 +79,7 @@
 #include "resource.h"
 #include "screen.h"
 #include "settings.h"
+#include "thread.h"
 #include "tools.h"
 #include "translations.h"
 #include "ui_dialog.h"
@@ -94,6 +97,19 @@ namespace
                || ( ( player1->isControlHuman() == player2->isControlHuman() ) && ( player1->GetColor() < player2->GetColor() ) );
     }
 
+    // Returns the hero who gets the focus at the beginning of the turn of a human player, see Interface::AdventureMap::HumanTurn().
+    const Heroes * getHeroToFocus( const Kingdom & kingdom, const bool isLoadedFromSave )
+    {
+        if ( isLoadedFromSave ) {
+            return Interface::GetFocusHeroes();
+        }
+
+        const VecHeroes & heroes = kingdom.GetHeroes();
+        const auto iter = std::find_if( heroes.begin(), heroes.end(), []( const Heroes * hero ) { return !hero->Modes( Heroes::SLEEPER ); } );
+
+        return iter != heroes.end() ? *iter : nullptr;
+    }
+
     // Get colors value of players to use in fog directions update.
     // For human allied AI returns colors of this alliance, for hostile AI - colors of all human players and their allies.
     PlayerColorsSet hotSeatAIFogColors( const Player * player )
@@ -247,7 +263,12 @@ fheroes2::GameMode Game::StartGame()
     if ( !conf.LoadedGameVersion() )
         GameOver::Result::Get().Reset();
 
-    return Interface::AdventureMap::Get().StartGame();
+    const fheroes2::GameMode result = Interface::AdventureMap::Get().StartGame();
+
+    // Do not leave the game while the autosave is still being written.
+    Game::waitForAutoSave();
+
+    return result;
 }
 
 void Game::DialogPlayers( const PlayerColor color, std::string title, std::string message )
@@ -757,6 +778,16 @@ fheroes2::GameMode Interface::AdventureMap::StartGame()
     // Set need of fade-in of game screen.
     Game::setDisplayFadeIn();
 
+    {
+        // Decode the most frequently played adventure map sounds in advance to avoid delays when they are played for the first time.
+        std::vector<int> m82List{ M82::TREASURE, M82::EXPERNCE, M82::KILLFADE };
+        for ( int m82 = M82::WSND00; m82 <= M82::WSND26; ++m82 ) {
+            m82List.push_back( m82 );
+        }
+
+        AudioManager::preloadSounds( m82List );
+    }
+
     GameOver::Result & gameResult = GameOver::Result::Get();
     fheroes2::GameMode res = fheroes2::GameMode::END_TURN;
 
@@ -842,15 +873,34 @@ fheroes2::GameMode Interface::AdventureMap::StartGame()
 
                         validateFadeInAndRender();
 
-                        // Reset the music after closing the dialog
-                        const AudioManager::MusicRestorer musicRestorer;
+                        // The adventure map is not redrawn while the player change dialog is shown, so the fog directions, the radar
+                        // image and the paths of heroes of this player are prepared in the background meanwhile.
+                        std::future<void> turnPreparation = MultiThreading::JobSystem::Get().async( [this, &kingdom, isLoadedFromSave]() {
+                            Interface::GameArea::updateMapFogDirections();
 
-                        AudioManager::PlayMusic( MUS::NEW_MONTH, Music::PlaybackMode::PLAY_ONCE );
+                            _radar.prepareMapImage();
 
-                        Game::DialogPlayers( playerColor, "", _( "%{color} player's turn." ) );
-                    }
+                            kingdom.ActionBeforeTurn();
 
-                    kingdom.ActionBeforeTurn();
+                            if ( const Heroes * hero = getHeroToFocus( kingdom, isLoadedFromSave ); hero != nullptr && !hero->isMoveEnabled() ) {
+                                world.preparePathfinder( *hero );
+                            }
+                        } );
+
+                        {
+                            // Reset the music after closing the dialog
+                            const AudioManager::MusicRestorer musicRestorer;
+
+                            AudioManager::PlayMusic( MUS::NEW_MONTH, Music::PlaybackMode::PLAY_ONCE );
+
+                            Game::DialogPlayers( playerColor, "", _( "%{color} player's turn." ) );
+                        }
+
+                        turnPreparation.wait();
+                    }
+                    else {
+                        kingdom.ActionBeforeTurn();
+                    }
 
                     _iconsPanel.showIcons( ICON_ANY );
                     _iconsPanel.setRedraw();
@@ -984,12 +1034,6 @@ fheroes2::GameMode Interface::AdventureMap::HumanTurn( const bool isLoadedFromSa
     _gameArea.SetUpdateCursor();
 
     const Settings & conf = Settings::Get();
-    if ( conf.IsGameType( Game::TYPE_HOTSEAT ) ) {
-        // TODO: Cache fog directions for all Human players in array to not perform full update at every turn start.
-
-        // Fully update fog directions at the start of player's move in Hot Seat mode as the previous move could be done by opposing player.
-        Interface::GameArea::updateMapFogDirections();
-    }
 
     redraw( REDRAW_GAMEAREA | REDRAW_RADAR | REDRAW_ICONS | REDRAW_BUTTONS | REDRAW_STATUS | REDRAW_BORDER );
 
@@ -1090,6 +1134,11 @@ fheroes2::GameMode Interface::AdventureMap::HumanTurn( const bool isLoadedFromSa
         }
 #endif
 
+        if ( const std::optional<bool> isAutoSaved = Game::takeAutoSaveResult(); isAutoSaved.has_value() ) {
+            _statusPanel.setMessage( *isAutoSaved ? _( "The game has been autosaved." ) : _( "Failed to autosave the game." ) );
+            setRedraw( REDRAW_STATUS );
+        }
+
         // Pending timer events
         _statusPanel.TimerEventProcessing();
 
@@ -1534,16 +1583,25 @@ fheroes2::GameMode Interface::AdventureMap::HumanTurn( const bool isLoadedFromSa
         if ( Game::validateAnimationDelay( Game::MAPS_DELAY ) ) {
             Game::updateAdventureMapAnimationIndex();
 
-            _gameArea.SetRedraw();
+            setRedraw( REDRAW_GAMEAREA_ANIMATION );
         }
 
         if ( needRedraw() ) {
+            // When only map objects are animated just their areas of the screen have to be rendered.
+            // Interface elements are drawn over the game area when it is hidden so they are rendered fully.
+            const bool renderAnimatedAreasOnly = ( getRedrawMask() == REDRAW_GAMEAREA_ANIMATION ) && !conf.isHideInterfaceEnabled();
+
             redraw( 0 );
 
             // If this assertion blows up it means that we are holding a RedrawLocker lock for rendering which should not happen.
             assert( getRedrawMask() == 0 );
 
-            validateFadeInAndRender();
+            if ( renderAnimatedAreasOnly ) {
+                validateFadeInAndRender( _gameArea.getRedrawnAreas() );
+            }
+            else {
+                validateFadeInAndRender();
+            }
         }
     }
 
@@ -178,20 +178,19 @@ namespace Video
         display.fill( 0 );
         display.updateNextRenderRoi( { 0, 0, display.width(), display.height() } );
 
-        std::vector<uint8_t> currPalette;
-        std::vector<uint8_t> prevPalette;
+        std::vector<uint8_t> palette;
 
         // Render the first frame.
         for ( auto & [state, video] : sequences ) {
             video->resetFrame();
 
             if ( state.control & VideoControl::PLAY_VIDEO ) {
-                video->getNextFrame( display, state.area.x, state.area.y, state.area.width, state.area.height, prevPalette );
+                video->getNextFrame( display, state.area.x, state.area.y, state.area.width, state.area.height, palette );
             }
             else {
                 video->skipFrame();
             }
-            screenRestorer.changePalette( prevPalette.data() );
+            screenRestorer.changePalette( palette.data() );
 
             state.nextFrameInMs -= minDelayInMs;
         }
@@ -250,10 +249,12 @@ namespace Video
                             }
                         }
 
+                        bool isPaletteUpdated = false;
+
                         // Prepare the next frame for render.
                         if ( state.nextFrameInMs <= minDelayInMs ) {
                             if ( state.control & VideoControl::PLAY_VIDEO ) {
-                                video->getNextFrame( display, state.area.x, state.area.y, state.area.width, state.area.height, currPalette );
+                                isPaletteUpdated = video->getNextFrame( display, state.area.x, state.area.y, state.area.width, state.area.height, palette );
                             }
                             else {
                                 video->skipFrame();
@@ -262,14 +263,13 @@ namespace Video
                         }
                         else {
                             if ( state.control & VideoControl::PLAY_VIDEO ) {
-                                video->getCurrentFrame( display, state.area.x, state.area.y, state.area.width, state.area.height, currPalette );
+                                isPaletteUpdated = video->getCurrentFrame( display, state.area.x, state.area.y, state.area.width, state.area.height, palette );
                             }
                             state.nextFrameInMs -= minDelayInMs;
                         }
 
-                        if ( prevPalette != currPalette ) {
-                            screenRestorer.changePalette( currPalette.data() );
-                            std::swap( currPalette, prevPalette );
+                        if ( isPaletteUpdated ) {
+                            screenRestorer.changePalette( palette.data() );
                         }
                     }
                     else if ( !( state.control & VideoControl::PLAY_WAIT ) ) {
@@ -293,7 +293,7 @@ namespace Video
 
         if ( fadeColorsOnEnd ) {
             // Do color fade for 1 second with 15 FPS.
-            fheroes2::colorFade( currPalette, videoRoi, 1000, 15.0 );
+            fheroes2::colorFade( palette, videoRoi, 1000, 15.0 );
         }
         else {
             display.fill( 0 );
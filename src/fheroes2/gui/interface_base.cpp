@@ -20,6 +20,8 @@
 
 #include "interface_base.h"
 
+#include <cstddef>
+
 #include "game.h"
 #include "ui_tool.h"
 
@@ -48,4 +50,26 @@ namespace Interface
             fheroes2::Display::instance().render();
         }
     }
+
+    void Interface::BaseInterface::validateFadeInAndRender( const std::vector<fheroes2::Rect> & areas )
+    {
+        if ( Game::validateDisplayFadeIn() ) {
+            fheroes2::fadeInDisplay();
+
+            setRedraw( REDRAW_GAMEAREA );
+            return;
+        }
+
+        if ( areas.empty() ) {
+            return;
+        }
+
+        fheroes2::Display & display = fheroes2::Display::instance();
+
+        for ( size_t i = 1; i < areas.size(); ++i ) {
+            display.updateNextRenderRoi( areas[i] );
+        }
+
+        display.render( areas.front() );
+    }
 }
@@ -21,6 +21,7 @@
 #pragma once
 
 #include <cstdint>
+#include <vector>
 
 #include "game_mode.h"
 #include "interface_gamearea.h"
@@ -56,7 +57,10 @@ namespace Interface
         REDRAW_ALL = 0x1FF,
 
         // This option is only for the Editor.
-        REDRAW_PASSABILITIES = 0x200
+        REDRAW_PASSABILITIES = 0x200,
+
+        // To redraw only animated objects of the game area. This option is only for the game (Adventure Map).
+        REDRAW_GAMEAREA_ANIMATION = 0x400
     };
 
     class BaseInterface
@@ -152,6 +156,9 @@ namespace Interface
         // If display fade-in state is set reset it to false and fade-in the full display image. Otherwise render full display image without fade-in.
         void validateFadeInAndRender();
 
+        // The same as above but only the given areas of the display image are rendered when no fade-in is needed.
+        void validateFadeInAndRender( const std::vector<fheroes2::Rect> & areas );
+
         GameArea _gameArea;
         Radar _radar;
 
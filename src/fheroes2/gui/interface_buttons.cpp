@@ -25,6 +25,9 @@
 
 #include <algorithm>
 #include <cassert>
+#include <initializer_list>
+#include <utility>
+#include <vector>
 
 #include "dialog.h"
 #include "game_interface.h"
@@ -33,6 +36,7 @@
 #include "interface_base.h"
 #include "kingdom.h"
 #include "localevent.h"
+#include "math_base.h"
 #include "mp2.h"
 #include "route.h"
 #include "screen.h"
@@ -103,20 +107,29 @@ void Interface::ButtonsPanel::SetPos( int32_t x, int32_t y )
     _systemRect = _buttonSystem.area();
 }
 
-void Interface::ButtonsPanel::_redraw()
+void Interface::ButtonsPanel::_redraw( const bool force )
 {
     const Settings & conf = Settings::Get();
 
-    if ( conf.isHideInterfaceEnabled() ) {
-        if ( !conf.ShowButtons() ) {
-            return;
-        }
-
-        BorderWindow::Redraw();
+    if ( conf.isHideInterfaceEnabled() && !conf.ShowButtons() ) {
+        _drawnState.clear();
+        return;
     }
 
     _setButtonStatus();
 
+    std::vector<int32_t> state = _getVisibleState();
+    if ( !force && state == _drawnState ) {
+        // Nothing visible has changed since the last redraw.
+        return;
+    }
+
+    _drawnState = std::move( state );
+
+    if ( conf.isHideInterfaceEnabled() ) {
+        BorderWindow::Redraw();
+    }
+
     _buttonNextHero.draw();
     _buttonHeroMovement.draw();
     _buttonKingdom.draw();
@@ -242,6 +255,22 @@ fheroes2::GameMode Interface::ButtonsPanel::queueEventProcessing()
     return res;
 }
 
+std::vector<int32_t> Interface::ButtonsPanel::_getVisibleState() const
+{
+    const fheroes2::Rect & pos = GetArea();
+
+    std::vector<int32_t> state{ pos.x, pos.y, Settings::Get().isEvilInterfaceEnabled(), static_cast<int32_t>( _buttonHeroMovement.getReleasedIndex() ) };
+
+    for ( const fheroes2::Button * button : { &_buttonNextHero, &_buttonHeroMovement, &_buttonKingdom, &_buttonSpell, &_buttonEndTurn, &_buttonAdventure,
+                                              &_buttonFile, &_buttonSystem } ) {
+        state.push_back( button->isEnabled() );
+        state.push_back( button->isPressed() );
+        state.push_back( button->isVisible() );
+    }
+
+    return state;
+}
+
 void Interface::ButtonsPanel::_setButtonStatus()
 {
     Heroes * currentHero = GetFocusHeroes();
@@ -24,6 +24,7 @@
 #pragma once
 
 #include <cstdint>
+#include <vector>
 
 #include "game_mode.h"
 #include "interface_border.h"
@@ -58,11 +59,15 @@ namespace Interface
 
         // Do not call this method directly, use Interface::AdventureMap::redraw() instead to avoid issues in the "no interface" mode.
         // The name of this method starts from _ on purpose to do not mix with other public methods.
-        void _redraw();
+        // The buttons are not redrawn if none of them has changed since the last call, unless `force` is set.
+        void _redraw( const bool force );
 
     private:
         void _setButtonStatus();
 
+        // Returns the values which define everything that is drawn on the panel.
+        std::vector<int32_t> _getVisibleState() const;
+
         AdventureMap & _interface;
 
         fheroes2::Button _buttonNextHero;
@@ -82,5 +87,8 @@ namespace Interface
         fheroes2::Rect _adventureRect;
         fheroes2::Rect _fileRect;
         fheroes2::Rect _systemRect;
+
+        // The state of the panel at the time of the last redraw. It is empty if the panel has to be redrawn.
+        std::vector<int32_t> _drawnState;
     };
 }
@@ -24,19 +24,22 @@
 #include "interface_gamearea.h"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
+#include <cstdint>
 #include <cstdlib>
-#include <deque>
 #include <list>
 #include <map>
 #include <ostream>
 #include <type_traits>
+#include <vector>
 
 #include "agg_image.h"
 #include "castle.h"
 #include "color.h"
 #include "cursor.h"
 #include "direction.h"
+#include "frame_arena.h"
 #include "game_delays.h"
 #include "game_interface.h"
 #include "ground.h"
@@ -46,12 +49,16 @@
 #include "interface_cpanel.h"
 #include "localevent.h"
 #include "logging.h"
+#include "map_object_info.h"
 #include "maps.h"
 #include "maps_tiles.h"
 #include "maps_tiles_helper.h"
 #include "maps_tiles_render.h"
+#include "math_tools.h"
+#include "network/state_hash.h"
 #include "pal.h"
 #include "players.h"
+#include "profiler.h"
 #include "route.h"
 #include "screen.h"
 #include "settings.h"
@@ -65,24 +72,159 @@ namespace
 {
     const int32_t minimalRequiredDraggingMovement = 10;
 
+    // Terrain is cached by square chunks of this number of tiles.
+    const int32_t terrainChunkSize = 8;
+
+    // A tile key which never matches a key of a tile inside the world.
+    const uint64_t outsideWorldTileKey = 0xFFFFFFFFULL;
+
+    // Returns the index of a chunk containing the tile with the given coordinate. Tiles outside the world have negative coordinates.
+    int32_t getTerrainChunkIndex( const int32_t tileCoordinate )
+    {
+        return ( tileCoordinate >= 0 ) ? tileCoordinate / terrainChunkSize : ( tileCoordinate + 1 ) / terrainChunkSize - 1;
+    }
+
+    // Keeps recently visited chunks to make scrolling back and forth cheap but does not let the cache grow over the entire map.
+    template <typename ChunkMap>
+    void removeUnusedChunks( ChunkMap & chunks, const uint32_t currentFrame, const size_t visibleChunkCount )
+    {
+        if ( chunks.size() <= 4 * visibleChunkCount ) {
+            return;
+        }
+
+        for ( auto iter = chunks.begin(); iter != chunks.end(); ) {
+            if ( iter->second.lastUsedFrame != currentFrame ) {
+                iter = chunks.erase( iter );
+            }
+            else {
+                ++iter;
+            }
+        }
+    }
+
+    // Returns the coordinate of a tile containing the given pixel of the world.
+    int32_t getTileCoordinate( const int32_t pixelCoordinate )
+    {
+        return ( pixelCoordinate >= 0 ) ? pixelCoordinate / fheroes2::tileWidthPx : ( pixelCoordinate + 1 ) / fheroes2::tileWidthPx - 1;
+    }
+
+    // If there are more areas of animated objects it is faster to redraw the whole visible area.
+    const size_t maxAnimatedObjectAreaCount = 64;
+
+    // Merges overlapping areas and the areas which together form a rectangle, so no pixel is redrawn twice.
+    void mergeAnimatedObjectAreas( std::vector<fheroes2::Rect> & areas )
+    {
+        const auto getSize = []( const fheroes2::Rect & area ) { return static_cast<int64_t>( area.width ) * area.height; };
+
+        bool isMerged = true;
+        while ( isMerged ) {
+            isMerged = false;
+
+            for ( size_t i = 0; i < areas.size(); ++i ) {
+                for ( size_t j = i + 1; j < areas.size(); ++j ) {
+                    const fheroes2::Rect overlap = areas[i] ^ areas[j];
+                    const fheroes2::Rect boundary = fheroes2::getBoundaryRect( areas[i], areas[j] );
+
+                    if ( ( overlap.width > 0 && overlap.height > 0 ) || getSize( boundary ) <= getSize( areas[i] ) + getSize( areas[j] ) ) {
+                        areas[i] = boundary;
+                        areas[j] = areas.back();
+                        areas.pop_back();
+
+                        isMerged = true;
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
     static_assert( std::is_trivially_copyable<fheroes2::ObjectRenderingInfo>::value, "This class is not trivially copyable anymore. Add std::move where required." );
 
-    struct TileUnfitRenderObjectInfo
+    // Images of tile-unfit objects of one rendering layer. Images from all tiles are collected into a single buffer which is sorted by tiles
+    // before rendering, so the buffer can be reused for every frame instead of allocating containers for each tile.
+    class TileUnfitImageList
     {
-        std::map<fheroes2::Point, std::deque<fheroes2::ObjectRenderingInfo>> bottomImages;
-        std::map<fheroes2::Point, std::deque<fheroes2::ObjectRenderingInfo>> bottomBackgroundImages;
-        std::map<fheroes2::Point, std::deque<fheroes2::ObjectRenderingInfo>> topImages;
+    public:
+        // The image is going to be rendered before all images previously added for the same tile.
+        void addFront( const fheroes2::Point & tilePos, const fheroes2::ObjectRenderingInfo & info )
+        {
+            ++_imageCount;
+            _images.push_back( { tilePos, -_imageCount, info } );
+        }
+
+        // The image is going to be rendered after all images previously added for the same tile.
+        void addBack( const fheroes2::Point & tilePos, const fheroes2::ObjectRenderingInfo & info )
+        {
+            ++_imageCount;
+            _images.push_back( { tilePos, _imageCount, info } );
+        }
+
+        void clear()
+        {
+            _images.clear();
+            _imageCount = 0;
+        }
 
-        std::map<fheroes2::Point, std::deque<fheroes2::ObjectRenderingInfo>> lowPriorityBottomImages;
-        std::map<fheroes2::Point, std::deque<fheroes2::ObjectRenderingInfo>> highPriorityBottomImages;
+        void render( fheroes2::Image & output, const Interface::GameArea & area )
+        {
+            std::sort( _images.begin(), _images.end(), []( const TileImage & first, const TileImage & second ) {
+                if ( first.tilePos == second.tilePos ) {
+                    return first.order < second.order;
+                }
 
-        std::map<fheroes2::Point, std::deque<fheroes2::ObjectRenderingInfo>> heroBackgroundImages;
+                return first.tilePos < second.tilePos;
+            } );
 
-        std::map<fheroes2::Point, std::deque<fheroes2::ObjectRenderingInfo>> shadowImages;
+            for ( const TileImage & image : _images ) {
+                const fheroes2::ObjectRenderingInfo & info = image.info;
+                area.BlitOnTile( output, fheroes2::AGG::GetICN( info.icnId, info.icnIndex ), info.area, info.imageOffset.x, info.imageOffset.y, image.tilePos,
+                                 info.isFlipped, info.alphaValue );
+            }
+        }
+
+    private:
+        struct TileImage
+        {
+            fheroes2::Point tilePos;
+
+            // Images of the same tile are rendered in ascending order.
+            int32_t order{ 0 };
+
+            fheroes2::ObjectRenderingInfo info;
+        };
+
+        std::vector<TileImage> _images;
+
+        int32_t _imageCount{ 0 };
     };
 
-    void populateStaticTileUnfitObjectInfo( TileUnfitRenderObjectInfo & tileUnfit, std::vector<fheroes2::ObjectRenderingInfo> & imageInfo,
-                                            std::vector<fheroes2::ObjectRenderingInfo> & shadowInfo, const fheroes2::Point & offset, const uint8_t alphaValue,
+    struct TileUnfitRenderObjectInfo
+    {
+        TileUnfitImageList bottomImages;
+        TileUnfitImageList bottomBackgroundImages;
+        TileUnfitImageList topImages;
+
+        TileUnfitImageList lowPriorityBottomImages;
+        TileUnfitImageList highPriorityBottomImages;
+
+        TileUnfitImageList heroBackgroundImages;
+
+        TileUnfitImageList shadowImages;
+
+        void clear()
+        {
+            bottomImages.clear();
+            bottomBackgroundImages.clear();
+            topImages.clear();
+            lowPriorityBottomImages.clear();
+            highPriorityBottomImages.clear();
+            heroBackgroundImages.clear();
+            shadowImages.clear();
+        }
+    };
+
+    void populateStaticTileUnfitObjectInfo( TileUnfitRenderObjectInfo & tileUnfit, fheroes2::FrameVector<fheroes2::ObjectRenderingInfo> & imageInfo,
+                                            fheroes2::FrameVector<fheroes2::ObjectRenderingInfo> & shadowInfo, const fheroes2::Point & offset, const uint8_t alphaValue,
                                             const uint16_t fogDirection )
     {
         for ( auto & objectInfo : imageInfo ) {
@@ -91,18 +233,18 @@ namespace
 
             if ( imagePos.y > 0 ) {
                 if ( imagePos.x < 0 ) {
-                    tileUnfit.bottomBackgroundImages[imagePos + offset].emplace_front( objectInfo );
+                    tileUnfit.bottomBackgroundImages.addFront( imagePos + offset, objectInfo );
                 }
                 else {
-                    tileUnfit.bottomBackgroundImages[imagePos + offset].emplace_back( objectInfo );
+                    tileUnfit.bottomBackgroundImages.addBack( imagePos + offset, objectInfo );
                 }
             }
             else if ( imagePos.y == 0 ) {
                 if ( imagePos.x < 0 ) {
-                    tileUnfit.bottomImages[imagePos + offset].emplace_front( objectInfo );
+                    tileUnfit.bottomImages.addFront( imagePos + offset, objectInfo );
                 }
                 else {
-                    tileUnfit.bottomImages[imagePos + offset].emplace_back( objectInfo );
+                    tileUnfit.bottomImages.addBack( imagePos + offset, objectInfo );
                 }
             }
             else {
@@ -112,10 +254,10 @@ namespace
                 }
 
                 if ( imagePos.x < 0 ) {
-                    tileUnfit.topImages[imagePos + offset].emplace_front( objectInfo );
+                    tileUnfit.topImages.addFront( imagePos + offset, objectInfo );
                 }
                 else {
-                    tileUnfit.topImages[imagePos + offset].emplace_back( objectInfo );
+                    tileUnfit.topImages.addBack( imagePos + offset, objectInfo );
                 }
             }
         }
@@ -131,11 +273,11 @@ namespace
 
             objectInfo.alphaValue = alphaValue;
 
-            tileUnfit.shadowImages[imagePos].emplace_back( objectInfo );
+            tileUnfit.shadowImages.addBack( imagePos, objectInfo );
         }
     }
 
-    void populateStaticTileUnfitBackgroundObjectInfo( TileUnfitRenderObjectInfo & tileUnfit, std::vector<fheroes2::ObjectRenderingInfo> & imageInfo,
+    void populateStaticTileUnfitBackgroundObjectInfo( TileUnfitRenderObjectInfo & tileUnfit, fheroes2::FrameVector<fheroes2::ObjectRenderingInfo> & imageInfo,
                                                       const fheroes2::Point & offset, const uint8_t alphaValue )
     {
         for ( auto & objectInfo : imageInfo ) {
@@ -143,18 +285,20 @@ namespace
             objectInfo.alphaValue = alphaValue;
 
             if ( imagePos.y > 0 ) {
-                tileUnfit.bottomBackgroundImages[imagePos + offset].emplace_front( objectInfo );
+                tileUnfit.bottomBackgroundImages.addFront( imagePos + offset, objectInfo );
             }
             else if ( imagePos.y == 0 ) {
-                tileUnfit.bottomImages[imagePos + offset].emplace_front( objectInfo );
+                tileUnfit.bottomImages.addFront( imagePos + offset, objectInfo );
             }
             else {
-                tileUnfit.topImages[imagePos + offset].emplace_front( objectInfo );
+                tileUnfit.topImages.addFront( imagePos + offset, objectInfo );
             }
         }
     }
 
-    void populateHeroObjectInfo( TileUnfitRenderObjectInfo & tileUnfit, const Heroes * hero, const uint16_t fogDirection )
+    void populateHeroObjectInfo( TileUnfitRenderObjectInfo & tileUnfit, const Heroes * hero, const uint16_t fogDirection,
+                                 fheroes2::FrameVector<fheroes2::ObjectRenderingInfo> & spriteInfo,
+                                 fheroes2::FrameVector<fheroes2::ObjectRenderingInfo> & spriteShadowInfo )
     {
         assert( hero != nullptr );
 
@@ -178,8 +322,10 @@ namespace
         const uint8_t heroAlphaValue = hero->getAlphaValue();
         const int32_t worldHeight = world.h();
 
-        auto spriteInfo = Maps::getHeroSpritesPerTile( *hero );
-        auto spriteShadowInfo = Maps::getHeroShadowSpritesPerTile( *hero );
+        spriteInfo.clear();
+        spriteShadowInfo.clear();
+        Maps::getHeroSpritesPerTile( *hero, spriteInfo );
+        Maps::getHeroShadowSpritesPerTile( *hero, spriteShadowInfo );
 
         for ( auto & objectInfo : spriteInfo ) {
             const fheroes2::Point imagePos = objectInfo.tileOffset;
@@ -188,25 +334,25 @@ namespace
             if ( movingHero && imagePos.y == 0 ) {
                 if ( nextHeroPos.y > heroPos.y && nextHeroPos.x > heroPos.x && imagePos.x > 0 ) {
                     // The hero moves south-east. We need to render it over everything.
-                    tileUnfit.highPriorityBottomImages[imagePos + heroPos].emplace_back( objectInfo );
+                    tileUnfit.highPriorityBottomImages.addBack( imagePos + heroPos, objectInfo );
                     continue;
                 }
 
                 if ( nextHeroPos.y > heroPos.y && nextHeroPos.x < heroPos.x && imagePos.x < 0 ) {
                     // The hero moves south-west. We need to render it over everything.
-                    tileUnfit.highPriorityBottomImages[imagePos + heroPos].emplace_back( objectInfo );
+                    tileUnfit.highPriorityBottomImages.addBack( imagePos + heroPos, objectInfo );
                     continue;
                 }
 
                 if ( nextHeroPos.y < heroPos.y && nextHeroPos.x < heroPos.x && imagePos.x < 0 ) {
                     // The hero moves north-west. We need to render it under all other objects.
-                    tileUnfit.lowPriorityBottomImages[imagePos + heroPos].emplace_back( objectInfo );
+                    tileUnfit.lowPriorityBottomImages.addBack( imagePos + heroPos, objectInfo );
                     continue;
                 }
 
                 if ( nextHeroPos.y < heroPos.y && nextHeroPos.x > heroPos.x && imagePos.x > 0 ) {
                     // The hero moves north-east. We need to render it under all other objects.
-                    tileUnfit.lowPriorityBottomImages[imagePos + heroPos].emplace_back( objectInfo );
+                    tileUnfit.lowPriorityBottomImages.addBack( imagePos + heroPos, objectInfo );
                     continue;
                 }
             }
@@ -214,13 +360,13 @@ namespace
             if ( movingHero && imagePos.y == 1 ) {
                 if ( nextHeroPos.y > heroPos.y && nextHeroPos.x > heroPos.x && imagePos.x > 0 ) {
                     // The hero moves south-east. We need to render it over everything.
-                    tileUnfit.bottomImages[imagePos + heroPos].emplace_back( objectInfo );
+                    tileUnfit.bottomImages.addBack( imagePos + heroPos, objectInfo );
                     continue;
                 }
 
                 if ( nextHeroPos.y > heroPos.y && nextHeroPos.x < heroPos.x && imagePos.x < 0 ) {
                     // The hero moves south-west. We need to render it over everything.
-                    tileUnfit.bottomImages[imagePos + heroPos].emplace_back( objectInfo );
+                    tileUnfit.bottomImages.addBack( imagePos + heroPos, objectInfo );
                     continue;
                 }
             }
@@ -228,13 +374,13 @@ namespace
             if ( movingHero && imagePos.y == -1 ) {
                 if ( nextHeroPos.y < heroPos.y && nextHeroPos.x < heroPos.x && imagePos.x < 0 ) {
                     // The hero moves north-west. We need to render it under all other objects.
-                    tileUnfit.bottomImages[imagePos + heroPos].emplace_back( objectInfo );
+                    tileUnfit.bottomImages.addBack( imagePos + heroPos, objectInfo );
                     continue;
                 }
 
                 if ( nextHeroPos.y < heroPos.y && nextHeroPos.x > heroPos.x && imagePos.x > 0 ) {
                     // The hero moves north-east. We need to render it under all other objects.
-                    tileUnfit.bottomImages[imagePos + heroPos].emplace_back( objectInfo );
+                    tileUnfit.bottomImages.addBack( imagePos + heroPos, objectInfo );
                     continue;
                 }
             }
@@ -247,18 +393,18 @@ namespace
 
                 // The very bottom part of hero (or hero on boat) image should not be rendered before it's shadow so we place it in the extra deque.
                 if ( imagePos.x < 0 ) {
-                    tileUnfit.heroBackgroundImages[imagePos + heroPos].emplace_front( objectInfo );
+                    tileUnfit.heroBackgroundImages.addFront( imagePos + heroPos, objectInfo );
                 }
                 else {
-                    tileUnfit.heroBackgroundImages[imagePos + heroPos].emplace_back( objectInfo );
+                    tileUnfit.heroBackgroundImages.addBack( imagePos + heroPos, objectInfo );
                 }
             }
             else if ( imagePos.y == 0 || ( isHeroInCastle && imagePos.y > 0 ) ) {
                 if ( imagePos.x < 0 ) {
-                    tileUnfit.bottomImages[imagePos + heroPos].emplace_front( objectInfo );
+                    tileUnfit.bottomImages.addFront( imagePos + heroPos, objectInfo );
                 }
                 else {
-                    tileUnfit.bottomImages[imagePos + heroPos].emplace_back( objectInfo );
+                    tileUnfit.bottomImages.addBack( imagePos + heroPos, objectInfo );
                 }
             }
             else {
@@ -268,10 +414,10 @@ namespace
                 }
 
                 if ( imagePos.x < 0 ) {
-                    tileUnfit.topImages[imagePos + heroPos].emplace_front( objectInfo );
+                    tileUnfit.topImages.addFront( imagePos + heroPos, objectInfo );
                 }
                 else {
-                    tileUnfit.topImages[imagePos + heroPos].emplace_back( objectInfo );
+                    tileUnfit.topImages.addBack( imagePos + heroPos, objectInfo );
                 }
             }
         }
@@ -286,18 +432,7 @@ namespace
 
             objectInfo.alphaValue = heroAlphaValue;
 
-            tileUnfit.shadowImages[imagePos].emplace_back( objectInfo );
-        }
-    }
-
-    void renderImagesOnTiles( fheroes2::Image & output, const std::map<fheroes2::Point, std::deque<fheroes2::ObjectRenderingInfo>> & images,
-                              const Interface::GameArea & area )
-    {
-        for ( const auto & [offset, imgInfo] : images ) {
-            for ( const auto & info : imgInfo ) {
-                area.BlitOnTile( output, fheroes2::AGG::GetICN( info.icnId, info.icnIndex ), info.area, info.imageOffset.x, info.imageOffset.y, offset, info.isFlipped,
-                                 info.alphaValue );
-            }
+            tileUnfit.shadowImages.addBack( imagePos, objectInfo );
         }
     }
 
@@ -343,6 +478,9 @@ void Interface::GameArea::generate( const fheroes2::Size & screenSize, const boo
 void Interface::GameArea::SetAreaPosition( int32_t x, int32_t y, int32_t w, int32_t h )
 {
     _windowROI = { x, y, w, h };
+    _renderROI = _windowROI;
+    _isLastRedrawValidForAnimation = false;
+
     const fheroes2::Size worldSize( world.w() * fheroes2::tileWidthPx, world.h() * fheroes2::tileWidthPx );
 
     if ( worldSize.width > w ) {
@@ -375,7 +513,7 @@ void Interface::GameArea::BlitOnTile( fheroes2::Image & dst, const fheroes2::Ima
     const fheroes2::Point tileOffset = GetRelativeTilePosition( mp );
 
     const fheroes2::Rect imageRoi{ tileOffset.x + ox, tileOffset.y + oy, src.width(), src.height() };
-    const fheroes2::Rect overlappedRoi = _windowROI ^ imageRoi;
+    const fheroes2::Rect overlappedRoi = _renderROI ^ imageRoi;
 
     fheroes2::AlphaBlit( src, overlappedRoi.x - imageRoi.x, overlappedRoi.y - imageRoi.y, dst, overlappedRoi.x, overlappedRoi.y, overlappedRoi.width,
                          overlappedRoi.height, alpha, flip );
@@ -387,7 +525,7 @@ void Interface::GameArea::BlitOnTile( fheroes2::Image & dst, const fheroes2::Ima
     const fheroes2::Point tileOffset = GetRelativeTilePosition( mp );
 
     const fheroes2::Rect imageRoi{ tileOffset.x + ox, tileOffset.y + oy, srcRoi.width, srcRoi.height };
-    const fheroes2::Rect overlappedRoi = _windowROI ^ imageRoi;
+    const fheroes2::Rect overlappedRoi = _renderROI ^ imageRoi;
 
     fheroes2::AlphaBlit( src, srcRoi.x + overlappedRoi.x - imageRoi.x, srcRoi.y + overlappedRoi.y - imageRoi.y, dst, overlappedRoi.x, overlappedRoi.y,
                          overlappedRoi.width, overlappedRoi.height, alpha, flip );
@@ -398,27 +536,19 @@ void Interface::GameArea::DrawTile( fheroes2::Image & dst, const fheroes2::Image
     const fheroes2::Point tileOffset = GetRelativeTilePosition( mp );
 
     const fheroes2::Rect imageRoi{ tileOffset.x, tileOffset.y, src.width(), src.height() };
-    const fheroes2::Rect overlappedRoi = _windowROI ^ imageRoi;
+    const fheroes2::Rect overlappedRoi = _renderROI ^ imageRoi;
 
     fheroes2::Copy( src, overlappedRoi.x - imageRoi.x, overlappedRoi.y - imageRoi.y, dst, overlappedRoi.x, overlappedRoi.y, overlappedRoi.width, overlappedRoi.height );
 }
 
-void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzleDraw ) const
+void Interface::GameArea::_redrawTerrain( fheroes2::Image & dst, const bool skipFoggedTiles ) const
 {
-    const fheroes2::Rect & tileROI = GetVisibleTileROI();
+    const fheroes2::Rect tileROI = _getRenderTileROI();
 
-    int32_t maxX = tileROI.x + tileROI.width;
-    int32_t maxY = tileROI.y + tileROI.height;
+    const int32_t maxX = tileROI.x + tileROI.width;
     const int32_t worldWidth = world.w();
     const int32_t worldHeight = world.h();
 
-#ifdef WITH_DEBUG
-    const bool renderFog = ( ( flag & LEVEL_FOG ) == LEVEL_FOG ) && !IS_DEVEL();
-#else
-    const bool renderFog = ( flag & LEVEL_FOG ) == LEVEL_FOG;
-#endif
-
-    // Render terrain.
     for ( int32_t y = 0; y < tileROI.height; ++y ) {
         fheroes2::Point offset( tileROI.x, tileROI.y + y );
 
@@ -435,13 +565,196 @@ void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzle
                 else {
                     const Maps::Tile & tile = world.getTile( offset.x, offset.y );
                     // Do not render terrain on the tiles fully covered with the fog.
-                    if ( !renderFog || tile.getFogDirection() != DIRECTION_ALL ) {
+                    if ( !skipFoggedTiles || tile.getFogDirection() != DIRECTION_ALL ) {
                         DrawTile( dst, getTileSurface( tile ), offset );
                     }
                 }
             }
         }
     }
+}
+
+void Interface::GameArea::_redrawCachedTerrain( fheroes2::Image & dst ) const
+{
+    const fheroes2::Rect tileROI = _getRenderTileROI();
+
+    const int32_t worldWidth = world.w();
+    const int32_t worldHeight = world.h();
+
+    const int32_t minChunkX = getTerrainChunkIndex( tileROI.x );
+    const int32_t minChunkY = getTerrainChunkIndex( tileROI.y );
+    const int32_t maxChunkX = getTerrainChunkIndex( tileROI.x + tileROI.width - 1 );
+    const int32_t maxChunkY = getTerrainChunkIndex( tileROI.y + tileROI.height - 1 );
+
+    ++_terrainChunkFrame;
+
+    for ( int32_t chunkY = minChunkY; chunkY <= maxChunkY; ++chunkY ) {
+        for ( int32_t chunkX = minChunkX; chunkX <= maxChunkX; ++chunkX ) {
+            const fheroes2::Point firstTile{ chunkX * terrainChunkSize, chunkY * terrainChunkSize };
+
+            // Tiles outside the world depend only on their position and the world size.
+            uint64_t key = Network::mixHash( ( static_cast<uint64_t>( static_cast<uint32_t>( worldWidth ) ) << 32 ) | static_cast<uint32_t>( worldHeight ) );
+
+            for ( int32_t y = firstTile.y; y < firstTile.y + terrainChunkSize; ++y ) {
+                for ( int32_t x = firstTile.x; x < firstTile.x + terrainChunkSize; ++x ) {
+                    if ( x < 0 || y < 0 || x >= worldWidth || y >= worldHeight ) {
+                        key = Network::mixHash( key ^ outsideWorldTileKey );
+                        continue;
+                    }
+
+                    const Maps::Tile & tile = world.getTile( x, y );
+                    key = Network::mixHash( key ^ ( ( static_cast<uint64_t>( tile.getTerrainImageIndex() ) << 8 ) | ( tile.getTerrainFlags() & 0x3 ) ) );
+                }
+            }
+
+            ImageChunk & chunk = _terrainChunks[{ chunkX, chunkY }];
+
+            if ( chunk.image.empty() || chunk.key != key ) {
+                chunk.image._disableTransformLayer();
+                chunk.image.resize( terrainChunkSize * fheroes2::tileWidthPx, terrainChunkSize * fheroes2::tileWidthPx );
+
+                for ( int32_t y = 0; y < terrainChunkSize; ++y ) {
+                    for ( int32_t x = 0; x < terrainChunkSize; ++x ) {
+                        const fheroes2::Point mp{ firstTile.x + x, firstTile.y + y };
+                        const bool isInsideWorld = ( mp.x >= 0 && mp.y >= 0 && mp.x < worldWidth && mp.y < worldHeight );
+
+                        const fheroes2::Image & surface = isInsideWorld ? getTileSurface( world.getTile( mp.x, mp.y ) ) : Maps::getEmptyTileSurface( mp );
+                        fheroes2::Copy( surface, 0, 0, chunk.image, x * fheroes2::tileWidthPx, y * fheroes2::tileWidthPx, surface.width(), surface.height() );
+                    }
+                }
+
+                chunk.key = key;
+            }
+
+            chunk.lastUsedFrame = _terrainChunkFrame;
+
+            DrawTile( dst, chunk.image, firstTile );
+        }
+    }
+
+    if ( _renderROI != _windowROI ) {
+        // Only a part of the visible area has been redrawn so other visible chunks are still in use.
+        return;
+    }
+
+    const size_t visibleChunkCount = static_cast<size_t>( maxChunkX - minChunkX + 1 ) * static_cast<size_t>( maxChunkY - minChunkY + 1 );
+    removeUnusedChunks( _terrainChunks, _terrainChunkFrame, visibleChunkCount );
+}
+
+void Interface::GameArea::_redrawCachedPassabilities( fheroes2::Image & dst, const bool isEditor ) const
+{
+    const fheroes2::Rect tileROI = _getRenderTileROI();
+
+    const int32_t worldWidth = world.w();
+    const int32_t worldHeight = world.h();
+
+    const int32_t minChunkX = getTerrainChunkIndex( tileROI.x );
+    const int32_t minChunkY = getTerrainChunkIndex( tileROI.y );
+    const int32_t maxChunkX = getTerrainChunkIndex( tileROI.x + tileROI.width - 1 );
+    const int32_t maxChunkY = getTerrainChunkIndex( tileROI.y + tileROI.height - 1 );
+
+    ++_passabilityChunkFrame;
+
+    std::array<uint32_t, terrainChunkSize * terrainChunkSize> imageKeys;
+
+    for ( int32_t chunkY = minChunkY; chunkY <= maxChunkY; ++chunkY ) {
+        for ( int32_t chunkX = minChunkX; chunkX <= maxChunkX; ++chunkX ) {
+            const fheroes2::Point firstTile{ chunkX * terrainChunkSize, chunkY * terrainChunkSize };
+
+            uint64_t key = 0;
+            bool isEmpty = true;
+
+            for ( int32_t y = 0; y < terrainChunkSize; ++y ) {
+                for ( int32_t x = 0; x < terrainChunkSize; ++x ) {
+                    const fheroes2::Point mp{ firstTile.x + x, firstTile.y + y };
+                    const bool isInsideWorld = ( mp.x >= 0 && mp.y >= 0 && mp.x < worldWidth && mp.y < worldHeight );
+
+                    // Nothing is drawn for tiles outside the world.
+                    const uint32_t imageKey = isInsideWorld ? Maps::getPassableImageKey( world.getTile( mp.x, mp.y ), isEditor ) : 0;
+
+                    imageKeys[static_cast<size_t>( y * terrainChunkSize + x )] = imageKey;
+                    key = Network::mixHash( key ^ imageKey );
+                    isEmpty = isEmpty && ( imageKey == 0 );
+                }
+            }
+
+            if ( isEmpty ) {
+                // There is nothing to draw and to keep in the cache.
+                continue;
+            }
+
+            ImageChunk & chunk = _passabilityChunks[{ chunkX, chunkY }];
+
+            if ( chunk.image.empty() || chunk.key != key ) {
+                chunk.image.resize( terrainChunkSize * fheroes2::tileWidthPx, terrainChunkSize * fheroes2::tileWidthPx );
+                chunk.image.reset();
+
+                for ( int32_t y = 0; y < terrainChunkSize; ++y ) {
+                    for ( int32_t x = 0; x < terrainChunkSize; ++x ) {
+                        Maps::drawPassable( imageKeys[static_cast<size_t>( y * terrainChunkSize + x )], chunk.image,
+                                            { x * fheroes2::tileWidthPx, y * fheroes2::tileWidthPx } );
+                    }
+                }
+
+                chunk.key = key;
+            }
+
+            chunk.lastUsedFrame = _passabilityChunkFrame;
+
+            BlitOnTile( dst, chunk.image, 0, 0, firstTile, false, 255 );
+        }
+    }
+
+    if ( _renderROI != _windowROI ) {
+        return;
+    }
+
+    const size_t visibleChunkCount = static_cast<size_t>( maxChunkX - minChunkX + 1 ) * static_cast<size_t>( maxChunkY - minChunkY + 1 );
+    removeUnusedChunks( _passabilityChunks, _passabilityChunkFrame, visibleChunkCount );
+}
+
+void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzleDraw ) const
+{
+    const fheroes2::ProfilerScopedTimer redrawTimer( fheroes2::ProfilerSection::ADVENTURE_MAP_AREA );
+
+    const bool isFullRedraw = ( _renderROI == _windowROI );
+    if ( isFullRedraw ) {
+        // Objects could be changed so their animated areas have to be collected again.
+        _lastRedrawTopLeftTileOffset = _topLeftTileOffset;
+        _lastRedrawFlag = flag;
+        _isLastRedrawValidForAnimation = !isPuzzleDraw;
+        _areAnimatedObjectAreasCollected = false;
+    }
+
+    const fheroes2::Rect tileROI = _getRenderTileROI();
+
+    int32_t maxX = tileROI.x + tileROI.width;
+    int32_t maxY = tileROI.y + tileROI.height;
+    const int32_t worldWidth = world.w();
+    const int32_t worldHeight = world.h();
+
+#ifdef WITH_DEBUG
+    const bool renderFog = ( ( flag & LEVEL_FOG ) == LEVEL_FOG ) && !IS_DEVEL();
+#else
+    const bool renderFog = ( flag & LEVEL_FOG ) == LEVEL_FOG;
+#endif
+
+    bool drawPassabilities = ( flag & LEVEL_PASSABILITIES );
+
+#ifdef WITH_DEBUG
+    if ( IS_DEVEL() && ( flag & LEVEL_ALL ) ) {
+        drawPassabilities = true;
+    }
+#endif
+
+    // Render terrain. Tiles fully covered with the fog are not rendered as the fog is drawn over them later.
+    // Terrain chunks contain all tiles so they can be used only when the fog is going to be drawn.
+    if ( renderFog && drawPassabilities ) {
+        _redrawTerrain( dst, true );
+    }
+    else {
+        _redrawCachedTerrain( dst );
+    }
 
     const int32_t minX = std::max<int32_t>( tileROI.x, 0 );
     const int32_t minY = std::max<int32_t>( tileROI.y, 0 );
@@ -449,8 +762,8 @@ void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzle
     maxY = std::min( maxY, worldHeight );
 
     if ( minX >= maxX || minY >= maxY ) {
-        // This can't be true! Please check your code changes as we shouldn't have an empty area.
-        assert( 0 );
+        // This can't be true for the whole visible area! Please check your code changes as we shouldn't have an empty area.
+        assert( !isFullRedraw );
         return;
     }
 
@@ -475,7 +788,12 @@ void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzle
 
     const bool drawHeroes = ( flag & LEVEL_HEROES ) == LEVEL_HEROES;
 
-    TileUnfitRenderObjectInfo tileUnfit;
+    // Collected images are kept between frames to reuse the allocated memory.
+    thread_local TileUnfitRenderObjectInfo tileUnfit;
+    tileUnfit.clear();
+
+    fheroes2::FrameVector<fheroes2::ObjectRenderingInfo> spriteInfo;
+    fheroes2::FrameVector<fheroes2::ObjectRenderingInfo> spriteShadowInfo;
 
     // TODO: Dragon City with Object ICN Type OBJ_ICN_TYPE_OBJNMUL2 and object index 46 is a bottom layer sprite.
     // TODO: When a hero standing besides this turns a part of the hero is visible. This can be fixed only by some hack.
@@ -489,7 +807,7 @@ void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzle
 
     const bool isEditor = _interface.isEditor();
 
-    std::vector<fheroes2::Point> ghostAnimationPos;
+    fheroes2::FrameVector<fheroes2::Point> ghostAnimationPos;
 
     for ( int32_t posY = roiToRenderMinY; posY < roiToRenderMaxY; ++posY ) {
         const int32_t offset = posY * worldWidth;
@@ -508,10 +826,11 @@ void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzle
                 if ( isEditor ) {
                     const uint8_t alphaValue = getObjectAlphaValue( tileIndex, MP2::OBJ_HERO );
 
-                    auto spriteInfo = getEditorHeroSpritesPerTile( tile );
+                    spriteInfo.clear();
+                    spriteShadowInfo.clear();
+                    getEditorHeroSpritesPerTile( tile, spriteInfo );
 
-                    std::vector<fheroes2::ObjectRenderingInfo> temp;
-                    populateStaticTileUnfitObjectInfo( tileUnfit, spriteInfo, temp, { posX, posY }, alphaValue, fogDirection );
+                    populateStaticTileUnfitObjectInfo( tileUnfit, spriteInfo, spriteShadowInfo, { posX, posY }, alphaValue, fogDirection );
                     continue;
                 }
 
@@ -529,7 +848,7 @@ void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzle
                     continue;
                 }
 
-                populateHeroObjectInfo( tileUnfit, hero, fogDirection );
+                populateHeroObjectInfo( tileUnfit, hero, fogDirection, spriteInfo, spriteShadowInfo );
 
                 // Update object type as it could be an object under the hero.
                 objectType = tile.getMainObjectType( false );
@@ -544,8 +863,10 @@ void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzle
 
                 const uint8_t alphaValue = getObjectAlphaValue( tileIndex, MP2::OBJ_MONSTER );
 
-                auto spriteInfo = getMonsterSpritesPerTile( tile, isEditor );
-                auto spriteShadowInfo = getMonsterShadowSpritesPerTile( tile, isEditor );
+                spriteInfo.clear();
+                spriteShadowInfo.clear();
+                getMonsterSpritesPerTile( tile, isEditor, spriteInfo );
+                getMonsterShadowSpritesPerTile( tile, isEditor, spriteShadowInfo );
 
                 populateStaticTileUnfitObjectInfo( tileUnfit, spriteInfo, spriteShadowInfo, { posX, posY }, alphaValue, fogDirection );
 
@@ -563,8 +884,10 @@ void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzle
 
                 const uint8_t alphaValue = getObjectAlphaValue( tileIndex, MP2::OBJ_BOAT );
 
-                auto spriteInfo = getBoatSpritesPerTile( tile );
-                auto spriteShadowInfo = getBoatShadowSpritesPerTile( tile );
+                spriteInfo.clear();
+                spriteShadowInfo.clear();
+                getBoatSpritesPerTile( tile, spriteInfo );
+                getBoatShadowSpritesPerTile( tile, spriteShadowInfo );
 
                 populateStaticTileUnfitObjectInfo( tileUnfit, spriteInfo, spriteShadowInfo, { posX, posY }, alphaValue, fogDirection );
 
@@ -587,7 +910,8 @@ void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzle
                 ghostAnimationPos.emplace_back( posX, posY );
             }
             else if ( objectType == MP2::OBJ_MINE && !isTileUnderFog ) {
-                auto spriteInfo = getMineGuardianSpritesPerTile( tile );
+                spriteInfo.clear();
+                getMineGuardianSpritesPerTile( tile, spriteInfo );
                 if ( !spriteInfo.empty() ) {
                     const uint8_t alphaValue = getObjectAlphaValue( tile.getMainObjectPart()._uid );
                     populateStaticTileUnfitBackgroundObjectInfo( tileUnfit, spriteInfo, { posX, posY }, alphaValue );
@@ -614,7 +938,7 @@ void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzle
     }
 
     // Draw the lower part of tile-unfit object's sprite.
-    renderImagesOnTiles( dst, tileUnfit.bottomBackgroundImages, *this );
+    tileUnfit.bottomBackgroundImages.render( dst, *this );
 
     for ( int32_t y = minY; y < maxY; ++y ) {
         const int32_t offset = y * worldWidth;
@@ -630,13 +954,13 @@ void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzle
     }
 
     // Draw all shadows from tile-unfit objects.
-    renderImagesOnTiles( dst, tileUnfit.shadowImages, *this );
+    tileUnfit.shadowImages.render( dst, *this );
 
     // Draw the lower part of hero's sprite including boat sprite when it is controlled by hero.
-    renderImagesOnTiles( dst, tileUnfit.heroBackgroundImages, *this );
+    tileUnfit.heroBackgroundImages.render( dst, *this );
 
     // Low priority images are drawn before any other object on this tile.
-    renderImagesOnTiles( dst, tileUnfit.lowPriorityBottomImages, *this );
+    tileUnfit.lowPriorityBottomImages.render( dst, *this );
 
     for ( int32_t y = minY; y < maxY; ++y ) {
         const int32_t offset = y * worldWidth;
@@ -653,10 +977,10 @@ void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzle
     }
 
     // Draw middle part of tile-unfit sprites.
-    renderImagesOnTiles( dst, tileUnfit.bottomImages, *this );
+    tileUnfit.bottomImages.render( dst, *this );
 
     // High priority images are drawn after any other object on this tile.
-    renderImagesOnTiles( dst, tileUnfit.highPriorityBottomImages, *this );
+    tileUnfit.highPriorityBottomImages.render( dst, *this );
 
     std::vector<std::pair<const Maps::ObjectPart *, int32_t>> topLayerTallObjects;
 
@@ -689,7 +1013,7 @@ void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzle
     }
 
     // Draw upper part of tile-unfit sprites.
-    renderImagesOnTiles( dst, tileUnfit.topImages, *this );
+    tileUnfit.topImages.render( dst, *this );
 
     // Draw the top part of tall objects.
     for ( const auto & [part, tileIndex] : topLayerTallObjects ) {
@@ -750,23 +1074,19 @@ void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzle
         }
     }
 
-    bool drawPassabilities = ( flag & LEVEL_PASSABILITIES );
-
-#ifdef WITH_DEBUG
-    if ( IS_DEVEL() && ( flag & LEVEL_ALL ) ) {
-        drawPassabilities = true;
-    }
-#endif
-
     if ( drawPassabilities ) {
+#ifdef WITH_DEBUG
         const PlayerColorsSet friendColors = Players::FriendColors();
 
         for ( int32_t y = minY; y < maxY; ++y ) {
             const int32_t offset = y * worldWidth;
             for ( int32_t x = minX; x < maxX; ++x ) {
-                redrawPassable( world.getTile( x + offset ), dst, friendColors, *this, isEditor );
+                redrawDebugFog( world.getTile( x + offset ), dst, friendColors, *this );
             }
         }
+#endif
+
+        _redrawCachedPassabilities( dst, isEditor );
     }
     else if ( renderFog ) {
         const bool drawTowns = ( flag & LEVEL_TOWNS );
@@ -795,6 +1115,140 @@ void Interface::GameArea::Redraw( fheroes2::Image & dst, int flag, bool isPuzzle
     updateObjectAnimationInfo();
 }
 
+void Interface::GameArea::redrawAnimatedObjects( fheroes2::Image & dst, const int flag ) const
+{
+    _redrawnAreas.clear();
+
+    // Fading animations and any changes of the view require the whole area to be redrawn.
+    if ( !_isLastRedrawValidForAnimation || flag != _lastRedrawFlag || _topLeftTileOffset != _lastRedrawTopLeftTileOffset || !_animationInfo.empty() ) {
+        Redraw( dst, flag );
+        _redrawnAreas.push_back( _windowROI );
+        return;
+    }
+
+    if ( !_areAnimatedObjectAreasCollected ) {
+        _collectAnimatedObjectAreas();
+        _areAnimatedObjectAreasCollected = true;
+    }
+
+    if ( _animatedObjectAreas.size() == 1 && _animatedObjectAreas.front() == _windowROI ) {
+        Redraw( dst, flag );
+
+        // Nothing has changed on the map so the collected areas are still valid.
+        _areAnimatedObjectAreasCollected = true;
+    }
+    else {
+        for ( const fheroes2::Rect & area : _animatedObjectAreas ) {
+            _renderROI = area;
+            Redraw( dst, flag );
+        }
+
+        _renderROI = _windowROI;
+    }
+
+    _redrawnAreas = _animatedObjectAreas;
+}
+
+void Interface::GameArea::_collectAnimatedObjectAreas() const
+{
+    _animatedObjectAreas.clear();
+
+    const fheroes2::Rect tileROI = GetVisibleTileROI();
+    const int32_t worldWidth = world.w();
+    const int32_t worldHeight = world.h();
+
+    // Sprites of some objects are bigger than a tile so the tiles around the visible area are checked as well.
+    const int32_t minX = std::max<int32_t>( tileROI.x - 1, 0 );
+    const int32_t minY = std::max<int32_t>( tileROI.y - 1, 0 );
+    const int32_t maxX = std::min( tileROI.x + tileROI.width + 2, worldWidth );
+    const int32_t maxY = std::min( tileROI.y + tileROI.height + 2, worldHeight );
+
+    // Animation frames of object parts are always within a tile.
+    const fheroes2::Rect objectPartArea{ 0, 0, fheroes2::tileWidthPx, fheroes2::tileWidthPx };
+
+    // Monsters and flags of heroes are animated. Their sprites and shadows cover nearby tiles, mostly above.
+    const fheroes2::Rect tileUnfitObjectArea{ -fheroes2::tileWidthPx, -2 * fheroes2::tileWidthPx, 3 * fheroes2::tileWidthPx, 4 * fheroes2::tileWidthPx };
+
+    // Flying ghosts are drawn over mines with sprites of different sizes.
+    fheroes2::Rect ghostArea;
+    for ( uint32_t i = 0; i < 15; ++i ) {
+        const fheroes2::Sprite & image = fheroes2::AGG::GetICN( ICN::OBJNHAUN, i );
+        const fheroes2::Rect imageArea{ image.x(), image.y(), image.width(), image.height() };
+
+        ghostArea = ( i == 0 ) ? imageArea : fheroes2::getBoundaryRect( ghostArea, imageArea );
+    }
+
+    const auto addArea = [this]( const fheroes2::Point & tilePos, const fheroes2::Rect & area ) {
+        const fheroes2::Point tileOffset = GetRelativeTilePosition( tilePos );
+        const fheroes2::Rect visibleArea = _windowROI ^ fheroes2::Rect{ tileOffset.x + area.x, tileOffset.y + area.y, area.width, area.height };
+
+        if ( visibleArea.width > 0 && visibleArea.height > 0 ) {
+            _animatedObjectAreas.push_back( visibleArea );
+        }
+    };
+
+    const auto isAnimatedPart = []( const Maps::ObjectPart & part ) {
+        if ( part.icnType == MP2::OBJ_ICN_TYPE_UNKNOWN ) {
+            return false;
+        }
+
+        const auto * objectInfo = Maps::getObjectPartByIcn( part.icnType, part.icnIndex );
+        return objectInfo != nullptr && objectInfo->animationFrames > 0;
+    };
+
+    for ( int32_t y = minY; y < maxY; ++y ) {
+        for ( int32_t x = minX; x < maxX; ++x ) {
+            const Maps::Tile & tile = world.getTile( x, y );
+
+            const MP2::MapObjectType objectType = tile.getMainObjectType();
+            if ( objectType == MP2::OBJ_HERO || objectType == MP2::OBJ_MONSTER ) {
+                addArea( { x, y }, tileUnfitObjectArea );
+            }
+
+            const MP2::MapObjectType objectTypeUnderHero = tile.getMainObjectType( false );
+            if ( objectTypeUnderHero == MP2::OBJ_ABANDONED_MINE || ( objectTypeUnderHero == MP2::OBJ_MINE && Maps::getMineSpellIdFromTile( tile ) == Spell::HAUNT ) ) {
+                addArea( { x, y }, ghostArea );
+            }
+
+            const std::vector<Maps::ObjectPart> & groundParts = tile.getGroundObjectParts();
+            const std::vector<Maps::ObjectPart> & topParts = tile.getTopObjectParts();
+
+            if ( isAnimatedPart( tile.getMainObjectPart() ) || std::any_of( groundParts.begin(), groundParts.end(), isAnimatedPart )
+                 || std::any_of( topParts.begin(), topParts.end(), isAnimatedPart ) ) {
+                addArea( { x, y }, objectPartArea );
+            }
+        }
+    }
+
+    mergeAnimatedObjectAreas( _animatedObjectAreas );
+
+    int64_t animatedPixelCount = 0;
+    for ( const fheroes2::Rect & area : _animatedObjectAreas ) {
+        animatedPixelCount += static_cast<int64_t>( area.width ) * area.height;
+    }
+
+    if ( _animatedObjectAreas.size() > maxAnimatedObjectAreaCount || animatedPixelCount * 2 > static_cast<int64_t>( _windowROI.width ) * _windowROI.height ) {
+        _animatedObjectAreas.clear();
+        _animatedObjectAreas.push_back( _windowROI );
+    }
+}
+
+fheroes2::Rect Interface::GameArea::_getRenderTileROI() const
+{
+    if ( _renderROI == _windowROI ) {
+        return GetVisibleTileROI();
+    }
+
+    const fheroes2::Point firstPixel = _topLeftTileOffset + _renderROI.getPosition() - _windowROI.getPosition();
+    const int32_t firstTileX = getTileCoordinate( firstPixel.x );
+    const int32_t firstTileY = getTileCoordinate( firstPixel.y );
+    const int32_t lastTileX = getTileCoordinate( firstPixel.x + _renderROI.width - 1 );
+    const int32_t lastTileY = getTileCoordinate( firstPixel.y + _renderROI.height - 1 );
+
+    // Add 1 extra tile for both axes in the same way as it is done for the visible area.
+    return { firstTileX, firstTileY, lastTileX - firstTileX + 2, lastTileY - firstTileY + 2 };
+}
+
 void Interface::GameArea::renderTileAreaSelect( fheroes2::Image & dst, const int32_t startTile, const int32_t endTile, const bool isActionObject ) const
 {
     if ( startTile < 0 || endTile < 0 ) {
@@ -1195,6 +1649,11 @@ uint8_t Interface::GameArea::getObjectAlphaValue( const uint32_t uid ) const
     return 255;
 }
 
+bool Interface::GameArea::isObjectIcnReady( const int icnId ) const
+{
+    return !_interface.isEditor() || fheroes2::AGG::isICNReady( icnId );
+}
+
 void Interface::GameArea::runSingleObjectAnimation( const std::shared_ptr<BaseObjectAnimationInfo> & info )
 {
     if ( !info ) {
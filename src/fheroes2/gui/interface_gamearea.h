@@ -25,6 +25,7 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <map>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -198,6 +199,15 @@ namespace Interface
         // Interface::BaseInterface::Redraw() instead to avoid issues in the "no interface" mode
         void Redraw( fheroes2::Image & dst, int flag, bool isPuzzleDraw = false ) const;
 
+        // Redraws only the areas of animated objects if nothing else has changed since the last redraw, otherwise the whole area is redrawn.
+        // Use getRedrawnAreas() to get the areas of the screen which have been updated.
+        void redrawAnimatedObjects( fheroes2::Image & dst, const int flag ) const;
+
+        const std::vector<fheroes2::Rect> & getRedrawnAreas() const
+        {
+            return _redrawnAreas;
+        }
+
         void renderTileAreaSelect( fheroes2::Image & dst, const int32_t startTile, const int32_t endTile, const bool isActionObject ) const;
 
         void BlitOnTile( fheroes2::Image & dst, const fheroes2::Image & src, int32_t ox, int32_t oy, const fheroes2::Point & mp, bool flip, uint8_t alpha ) const;
@@ -239,6 +249,10 @@ namespace Interface
 
         uint8_t getObjectAlphaValue( const uint32_t uid ) const;
 
+        // Returns false if the sprites of the given object ICN are still being decoded in the background. Only the editor renders objects
+        // without waiting for their sprites, so the first look at an area full of different objects does not freeze it.
+        bool isObjectIcnReady( const int icnId ) const;
+
         // Make sure you do not have a copy of this object after the execution of the method to avoid incorrect object removal in some cases.
         void runSingleObjectAnimation( const std::shared_ptr<BaseObjectAnimationInfo> & info );
 
@@ -270,6 +284,9 @@ namespace Interface
         BaseInterface & _interface;
 
         fheroes2::Rect _windowROI; // visible to draw area of World Map in pixels
+
+        // All rendering is limited by this area. It is the same as the window ROI unless only animated objects are redrawn.
+        mutable fheroes2::Rect _renderROI;
         fheroes2::Point _topLeftTileOffset; // offset of tiles to be drawn (from here we can find any tile ID)
 
         // boundaries for World Map
@@ -289,6 +306,32 @@ namespace Interface
         // This member needs to be mutable because it is modified during rendering.
         mutable std::vector<std::shared_ptr<BaseObjectAnimationInfo>> _animationInfo;
 
+        struct ImageChunk
+        {
+            fheroes2::Image image;
+            uint64_t key{ 0 };
+            uint32_t lastUsedFrame{ 0 };
+        };
+
+        // Terrain changes only when tiles are modified, so it is rendered by square chunks of tiles which are then copied on the screen.
+        // The key is a chunk position in chunks.
+        mutable std::map<fheroes2::Point, ImageChunk> _terrainChunks;
+        mutable uint32_t _terrainChunkFrame{ 0 };
+
+        // Passability changes only when objects are modified, so it is cached by chunks of the same size as terrain.
+        // Chunk images are transparent except for the passability marks.
+        mutable std::map<fheroes2::Point, ImageChunk> _passabilityChunks;
+        mutable uint32_t _passabilityChunkFrame{ 0 };
+
+        // Objects are animated within small areas of the screen so on animation ticks only these areas are redrawn.
+        // The areas are collected once after a full redraw and they stay valid until the next full redraw.
+        mutable std::vector<fheroes2::Rect> _animatedObjectAreas;
+        mutable std::vector<fheroes2::Rect> _redrawnAreas;
+        mutable fheroes2::Point _lastRedrawTopLeftTileOffset;
+        mutable int _lastRedrawFlag{ 0 };
+        mutable bool _isLastRedrawValidForAnimation{ false };
+        mutable bool _areAnimatedObjectAreasCollected{ false };
+
         fheroes2::Point _lastMouseDragPosition;
         fheroes2::Point _mousePositionForFastScroll;
         bool _mouseDraggingInitiated{ false };
@@ -308,5 +351,19 @@ namespace Interface
         void _setCenterToTile( const fheroes2::Point & tile ); // set center to the middle of tile (input is tile ID)
 
         void updateObjectAnimationInfo() const;
+
+        // Returns the ROI of tiles to be rendered within the current render area.
+        fheroes2::Rect _getRenderTileROI() const;
+
+        void _collectAnimatedObjectAreas() const;
+
+        // Renders terrain images of all visible tiles. Tiles fully hidden by the fog are skipped if 'skipFoggedTiles' is set.
+        void _redrawTerrain( fheroes2::Image & dst, const bool skipFoggedTiles ) const;
+
+        // Copies visible terrain from the chunk cache, updating chunks in which any of tiles has changed.
+        void _redrawCachedTerrain( fheroes2::Image & dst ) const;
+
+        // Blits visible passability marks from the chunk cache, updating chunks in which passability of any tile has changed.
+        void _redrawCachedPassabilities( fheroes2::Image & dst, const bool isEditor ) const;
     };
 }
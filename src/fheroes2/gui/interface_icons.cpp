@@ -24,7 +24,10 @@
 #include "interface_icons.h"
 
 #include <algorithm>
+#include <cassert>
+#include <cstddef>
 #include <iterator>
+#include <utility>
 #include <vector>
 
 #include "agg_image.h"
@@ -38,6 +41,7 @@
 #include "icn.h"
 #include "interface_base.h"
 #include "kingdom.h"
+#include "math_base.h"
 #include "screen.h"
 #include "settings.h"
 #include "ui_castle.h"
@@ -51,6 +55,37 @@ namespace
 {
     const int32_t iconsCursorWidth = 56;
     const int32_t iconsCursorHeight = 32;
+
+    template <class Item>
+    std::vector<int32_t> getListVisibleState( const Interface::ListBox<Item> & list, const fheroes2::Scrollbar & scrollbar, const fheroes2::Point & topLeftCorner,
+                                              const int32_t iconsCount, const bool show, const size_t itemCount )
+    {
+        return { topLeftCorner.x,
+                 topLeftCorner.y,
+                 iconsCount,
+                 show,
+                 static_cast<int32_t>( itemCount ),
+                 list.getTopId(),
+                 list.getCurrentId(),
+                 Settings::Get().isEvilInterfaceEnabled(),
+                 scrollbar.x(),
+                 scrollbar.y(),
+                 scrollbar.width(),
+                 scrollbar.height(),
+                 scrollbar.isHidden() };
+    }
+
+    void redrawIfChanged( Interface::ListBasic & list, std::vector<int32_t> state, std::vector<int32_t> & drawnState, const bool force )
+    {
+        if ( !force && state == drawnState ) {
+            // Nothing visible has changed since the last redraw.
+            return;
+        }
+
+        drawnState = std::move( state );
+
+        list.Redraw();
+    }
 }
 
 bool Interface::IconsBar::isVisible()
@@ -330,6 +365,57 @@ void Interface::HeroesIcons::setPos( const int32_t px, const int32_t py )
     }
 }
 
+std::vector<int32_t> Interface::HeroesIcons::getVisibleState()
+{
+    const VecHeroes & heroes = world.GetKingdom( Settings::Get().CurrentColor() ).GetHeroes();
+
+    std::vector<int32_t> state = getListVisibleState( *this, GetScrollbar(), _topLeftCorner, _iconsCount, _show, heroes.size() );
+
+    if ( !_show ) {
+        return state;
+    }
+
+    const int32_t itemCount = static_cast<int32_t>( heroes.size() );
+
+    for ( int32_t id = std::max( getTopId(), 0 ); id < std::min( getTopId() + _iconsCount, itemCount ); ++id ) {
+        const Heroes * hero = heroes[id];
+        assert( hero != nullptr );
+
+        state.push_back( hero->GetID() );
+        state.push_back( static_cast<int32_t>( hero->GetMobilityIndexSprite() ) );
+        state.push_back( static_cast<int32_t>( hero->getManaIndexSprite() ) );
+        state.push_back( hero->Modes( Heroes::SLEEPER ) ? 1 : 0 );
+        state.push_back( hero->isControlAI() );
+    }
+
+    return state;
+}
+
+std::vector<int32_t> Interface::CastleIcons::getVisibleState()
+{
+    const VecCastles & castles = world.GetKingdom( Settings::Get().CurrentColor() ).GetCastles();
+
+    std::vector<int32_t> state = getListVisibleState( *this, GetScrollbar(), _topLeftCorner, _iconsCount, _show, castles.size() );
+
+    if ( !_show ) {
+        return state;
+    }
+
+    const int32_t itemCount = static_cast<int32_t>( castles.size() );
+
+    for ( int32_t id = std::max( getTopId(), 0 ); id < std::min( getTopId() + _iconsCount, itemCount ); ++id ) {
+        const Castle * castle = castles[id];
+        assert( castle != nullptr );
+
+        state.push_back( castle->GetIndex() );
+        state.push_back( castle->GetRace() );
+        state.push_back( castle->isCastle() );
+        state.push_back( static_cast<int32_t>( Castle::GetAllBuildingStatus( *castle ) ) );
+    }
+
+    return state;
+}
+
 Interface::IconsPanel::IconsPanel( AdventureMap & interface )
     : BorderWindow( { 0, 0, 144, 128 } )
     , _interface( interface )
@@ -392,9 +478,11 @@ void Interface::IconsPanel::SetPos( int32_t x, int32_t y )
     _castleIcons.setPos( rect.x + 72, rect.y );
 }
 
-void Interface::IconsPanel::_redraw()
+void Interface::IconsPanel::_redraw( const bool force )
 {
     if ( !IconsBar::isVisible() ) {
+        _castleIconsDrawnState.clear();
+        _heroesIconsDrawnState.clear();
         return;
     }
 
@@ -402,8 +490,7 @@ void Interface::IconsPanel::_redraw()
         BorderWindow::Redraw();
     }
 
-    _heroesIcons.Redraw();
-    _castleIcons.Redraw();
+    _redrawIcons( ICON_ANY, force );
 }
 
 void Interface::IconsPanel::queueEventProcessing()
@@ -497,13 +584,13 @@ void Interface::IconsPanel::showIcons( const HeroesCastlesIcons type )
     }
 }
 
-void Interface::IconsPanel::_redrawIcons( const HeroesCastlesIcons type )
+void Interface::IconsPanel::_redrawIcons( const HeroesCastlesIcons type, const bool force )
 {
     if ( type & ICON_HEROES ) {
-        _heroesIcons.Redraw();
+        redrawIfChanged( _heroesIcons, _heroesIcons.getVisibleState(), _heroesIconsDrawnState, force );
     }
     if ( type & ICON_CASTLES ) {
-        _castleIcons.Redraw();
+        redrawIfChanged( _castleIcons, _castleIcons.getVisibleState(), _castleIconsDrawnState, force );
     }
 }
 
@@ -25,6 +25,7 @@
 
 #include <cassert>
 #include <cstdint>
+#include <vector>
 
 #include "image.h"
 #include "interface_border.h"
@@ -119,6 +120,9 @@ namespace Interface
         void setPos( const int32_t px, const int32_t py );
         void showIcons( const bool show );
 
+        // Returns the values which define everything that is drawn on the icons bar.
+        std::vector<int32_t> getVisibleState();
+
     private:
         using Interface::ListBox<HEROES>::ActionListDoubleClick;
         using Interface::ListBox<HEROES>::ActionListSingleClick;
@@ -157,6 +161,9 @@ namespace Interface
         void setPos( const int32_t px, const int32_t py );
         void showIcons( const bool show );
 
+        // Returns the values which define everything that is drawn on the icons bar.
+        std::vector<int32_t> getVisibleState();
+
     private:
         using Interface::ListBox<CASTLE>::ActionListDoubleClick;
         using Interface::ListBox<CASTLE>::ActionListSingleClick;
@@ -205,9 +212,10 @@ namespace Interface
 
         // Do not call this method directly, use Interface::AdventureMap::redraw() instead to avoid issues in the "no interface" mode.
         // The name of this method starts from _ on purpose to do not mix with other public methods.
-        void _redraw();
+        // The icons are not redrawn if nothing visible has changed since the last call, unless `force` is set.
+        void _redraw( const bool force );
         // The name of this method starts from _ on purpose to do not mix with other public methods.
-        void _redrawIcons( const HeroesCastlesIcons type );
+        void _redrawIcons( const HeroesCastlesIcons type, const bool force );
 
     private:
         AdventureMap & _interface;
@@ -216,5 +224,9 @@ namespace Interface
 
         CastleIcons _castleIcons{ 4, _sfMarker };
         HeroesIcons _heroesIcons{ 4, _sfMarker };
+
+        // The states of the icons bars at the time of the last redraw. A state is empty if the bar has to be redrawn.
+        std::vector<int32_t> _castleIconsDrawnState;
+        std::vector<int32_t> _heroesIconsDrawnState;
     };
 }
@@ -25,6 +25,7 @@
 
 #include <cassert>
 #include <cstring>
+#include <utility>
 
 #include "agg_image.h"
 #include "castle.h"
@@ -36,8 +37,10 @@
 #include "interface_gamearea.h"
 #include "localevent.h"
 #include "maps_tiles.h"
+#include "math_tools.h"
 #include "mp2.h"
 #include "players.h"
+#include "profiler.h"
 #include "screen.h"
 #include "settings.h"
 #include "translations.h"
@@ -139,6 +142,11 @@ namespace
     }
 }
 
+uint8_t Interface::Radar::getGroundPaletteIndex( const int ground )
+{
+    return GetPaletteIndexFromGround( ground );
+}
+
 Interface::Radar::Radar( BaseInterface & interface )
     : BorderWindow( { 0, 0, fheroes2::radarWidthPx, fheroes2::radarWidthPx } )
     , _radarType( RadarType::WorldMap )
@@ -178,7 +186,7 @@ void Interface::Radar::SetPos( int32_t x, int32_t y )
 void Interface::Radar::Build()
 {
     SetZoom();
-    _roi = { 0, 0, world.w(), world.h() };
+    ResetRenderArea();
 }
 
 void Interface::Radar::SetZoom()
@@ -208,12 +216,43 @@ void Interface::Radar::SetRenderArea( const fheroes2::Rect & roi )
     // We set ROI only if radar is visible as there will be no render of radar map image if it is hidden.
     if ( !conf.isHideInterfaceEnabled() || conf.ShowRadar() ) {
         // "_roi" should not be outside the "world".
-        _roi = roi ^ fheroes2::Rect( 0, 0, world.w(), world.h() );
+        fheroes2::Rect renderArea = roi ^ fheroes2::Rect( 0, 0, world.w(), world.h() );
+        if ( renderArea.width <= 0 || renderArea.height <= 0 ) {
+            renderArea = {};
+        }
+
+        // Areas can be set several times before the radar redraw so all of them must be rendered.
+        _roi = _isRenderAreaSet ? fheroes2::getBoundaryRect( _roi, renderArea ) : renderArea;
+        _isRenderAreaSet = true;
+    }
+}
+
+void Interface::Radar::ResetRenderArea()
+{
+    _roi = { 0, 0, world.w(), world.h() };
+    _isRenderAreaSet = false;
+}
+
+void Interface::Radar::prepareMapImage()
+{
+    const Settings & conf = Settings::Get();
+    if ( conf.isHideInterfaceEnabled() && !conf.ShowRadar() ) {
+        return;
     }
+
+    ResetRenderArea();
+    RedrawObjects( Players::FriendColors(), ViewWorldMode::OnlyVisible );
+
+    _isMapImagePrepared = true;
 }
 
 void Interface::Radar::_redraw( const bool redrawMapObjects )
 {
+    const fheroes2::ProfilerScopedTimer redrawTimer( fheroes2::ProfilerSection::RADAR );
+
+    // The prepared image can be used only once, the next changes of the world have to be rendered.
+    const bool isMapImagePrepared = std::exchange( _isMapImagePrepared, false );
+
     const Settings & conf = Settings::Get();
     if ( conf.isHideInterfaceEnabled() ) {
         if ( conf.ShowRadar() ) {
@@ -223,7 +262,7 @@ void Interface::Radar::_redraw( const bool redrawMapObjects )
             // We are in "Hide Interface" mode and radar is turned off so we have nothing to render.
 
             // Force set radar ROI for the whole world to be prepared to fully update radar when it will be shown.
-            _roi = { 0, 0, world.w(), world.h() };
+            ResetRenderArea();
             return;
         }
     }
@@ -234,12 +273,12 @@ void Interface::Radar::_redraw( const bool redrawMapObjects )
         fheroes2::Blit( fheroes2::AGG::GetICN( ( conf.isEvilInterfaceEnabled() ? ICN::HEROLOGE : ICN::HEROLOGO ), 0 ), display, rect.x, rect.y );
 
         // Force set radar ROI for the whole world to be prepared to fully update radar when it will be shown.
-        _roi = { 0, 0, world.w(), world.h() };
+        ResetRenderArea();
     }
     else {
         _cursorArea.hide();
 
-        if ( redrawMapObjects ) {
+        if ( redrawMapObjects && !isMapImagePrepared ) {
             RedrawObjects( Players::FriendColors(), ViewWorldMode::OnlyVisible );
         }
 
@@ -288,6 +327,14 @@ void Interface::Radar::RedrawObjects( const PlayerColorsSet playerColor, const V
     const bool revealAll = flags == ViewWorldMode::ViewAll;
 #endif
 
+    if ( _radarType == RadarType::WorldMap ) {
+        // Changes reported by the world are already included in a full redraw, otherwise they are added to the render area.
+        const fheroes2::Rect worldUpdateArea = world.takeRadarUpdateArea() ^ fheroes2::Rect( 0, 0, world.w(), world.h() );
+        if ( _isRenderAreaSet && worldUpdateArea.width > 0 && worldUpdateArea.height > 0 ) {
+            _roi = fheroes2::getBoundaryRect( _roi, worldUpdateArea );
+        }
+    }
+
     uint8_t * radarImage = _map.image();
 
     assert( _roi.x >= 0 && _roi.y >= 0 && ( _roi.width + _roi.x ) <= world.w() && ( _roi.height + _roi.y ) <= world.h() );
@@ -415,7 +462,7 @@ void Interface::Radar::RedrawObjects( const PlayerColorsSet playerColor, const V
     }
 
     // Reset ROI to full radar image to be able to redraw the mini-map without calling 'SetMapRedraw()'.
-    _roi = { 0, 0, world.w(), world.h() };
+    ResetRenderArea();
 }
 
 // Redraw radar cursor. RoiRectangle is a rectangle in tile unit of the current radar view.
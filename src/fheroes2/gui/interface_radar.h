@@ -62,11 +62,16 @@ namespace Interface
         void SetRedraw( const uint32_t redrawMode ) const;
 
         // Set the "need" of render the radar map only in the given 'roi' on next radar Redraw call.
+        // Several areas set before the redraw are combined together with the areas reported by the world.
         void SetRenderArea( const fheroes2::Rect & roi );
         void Build();
         void RedrawForViewWorld( const ViewWorld::ZoomROIs & roi, ViewWorldMode mode, const bool renderMapObjects );
         void redrawForEditor( const bool renderMapObjects );
 
+        // Renders the radar map image of the current player in advance, the next full radar redraw uses it as is. This can be done
+        // in a background thread as long as the radar is not redrawn meanwhile.
+        void prepareMapImage();
+
         void SetHide( bool f )
         {
             _hide = f;
@@ -75,6 +80,9 @@ namespace Interface
         void QueueEventProcessing();
         bool QueueEventProcessingForWorldView( ViewWorld::ZoomROIs & roi ) const;
 
+        // Returns the palette index used to display a tile of the given ground type on the radar.
+        static uint8_t getGroundPaletteIndex( const int ground );
+
         // Do not call this method directly, use Interface::AdventureMap::redraw() instead to avoid issues in the "no interface" mode.
         // The name of this method starts from _ on purpose to do not mix with other public methods.
         void _redraw( const bool redrawMapObjects );
@@ -91,14 +99,18 @@ namespace Interface
 
         void RedrawObjects( const PlayerColorsSet playerColor, const ViewWorldMode flags );
         void RedrawCursor( const fheroes2::Rect * roiRectangle = nullptr );
+        void ResetRenderArea();
 
         RadarType _radarType;
         BaseInterface & _interface;
 
         fheroes2::Image _map;
         fheroes2::MovableSprite _cursorArea;
+        // The area of the world in tiles to redraw. It is the whole world unless a render area is set.
         fheroes2::Rect _roi;
         double _zoom{ 1.0 };
         bool _hide{ true };
+        bool _isRenderAreaSet{ false };
+        bool _isMapImagePrepared{ false };
     };
 }
@@ -24,11 +24,14 @@
 #include "interface_status.h"
 
 #include <cassert>
+#include <cstddef>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "agg_image.h"
 #include "army.h"
+#include "army_troop.h"
 #include "castle.h"
 #include "color.h"
 #include "dialog.h"
@@ -43,6 +46,7 @@
 #include "localevent.h"
 #include "math_base.h"
 #include "players.h"
+#include "resource.h"
 #include "screen.h"
 #include "settings.h"
 #include "tools.h"
@@ -79,22 +83,84 @@ void Interface::StatusPanel::SetPos( int32_t x, int32_t y )
 
 void Interface::StatusPanel::SetState( const StatusType status )
 {
-    // SetResource() should be used to set this status
-    assert( status != StatusType::STATUS_RESOURCE );
+    // SetResource() and setMessage() should be used to set these statuses
+    assert( status != StatusType::STATUS_RESOURCE && status != StatusType::STATUS_MESSAGE );
 
-    if ( _state != StatusType::STATUS_RESOURCE ) {
+    // Messages should not hide the AI turn progress.
+    if ( _state != StatusType::STATUS_RESOURCE && ( _state != StatusType::STATUS_MESSAGE || status == StatusType::STATUS_AITURN ) ) {
         _state = status;
     }
 }
 
-void Interface::StatusPanel::_redraw() const
+std::vector<int32_t> Interface::StatusPanel::_getVisibleState() const
+{
+    const Settings & conf = Settings::Get();
+    const fheroes2::Rect & pos = GetArea();
+
+    std::vector<int32_t> state{ pos.x,
+                                pos.y,
+                                pos.width,
+                                pos.height,
+                                conf.isEvilInterfaceEnabled(),
+                                static_cast<int32_t>( _state ),
+                                static_cast<int32_t>( world.CountDay() ),
+                                static_cast<int32_t>( conf.CurrentColor() ) };
+
+    if ( _state == StatusType::STATUS_AITURN ) {
+        state.push_back( static_cast<int32_t>( _aiTurnProgress ) );
+        state.push_back( static_cast<int32_t>( Game::getAdventureMapAnimationIndex() - _grainsAnimationIndexOffset ) );
+
+        return state;
+    }
+
+    state.push_back( _lastResource );
+    state.push_back( static_cast<int32_t>( _lastResourceCount ) );
+
+    const Kingdom & kingdom = world.GetKingdom( conf.CurrentColor() );
+    const Funds & funds = kingdom.GetFunds();
+
+    state.insert( state.end(), { static_cast<int32_t>( kingdom.GetCountCastle() ), static_cast<int32_t>( kingdom.GetCountTown() ), funds.wood, funds.mercury,
+                                 funds.ore, funds.sulfur, funds.crystal, funds.gems, funds.gold } );
+
+    const Army * armyTroops = nullptr;
+
+    if ( const Heroes * focusedHero = GetFocusHeroes(); focusedHero != nullptr ) {
+        armyTroops = &focusedHero->GetArmy();
+    }
+    else if ( const Castle * focusedCastle = GetFocusCastle(); focusedCastle != nullptr ) {
+        armyTroops = &focusedCastle->GetArmy();
+    }
+
+    if ( armyTroops != nullptr ) {
+        for ( size_t i = 0; i < armyTroops->Size(); ++i ) {
+            const Troop * troop = armyTroops->GetTroop( i );
+            assert( troop != nullptr );
+
+            state.push_back( troop->GetID() );
+            state.push_back( static_cast<int32_t>( troop->GetCount() ) );
+        }
+    }
+
+    return state;
+}
+
+void Interface::StatusPanel::_redraw( const bool force )
 {
     const Settings & conf = Settings::Get();
     if ( conf.isHideInterfaceEnabled() && !conf.ShowStatus() ) {
         // The window is hidden.
+        _drawnState.clear();
+        return;
+    }
+
+    std::vector<int32_t> state = _getVisibleState();
+    if ( !force && state == _drawnState ) {
+        // Nothing visible has changed since the last redraw.
         return;
     }
 
+    _drawnState = std::move( state );
+
     const fheroes2::Rect & pos = GetArea();
 
     if ( conf.isHideInterfaceEnabled() ) {
@@ -123,11 +189,14 @@ void Interface::StatusPanel::_redraw() const
         if ( Players::HumanColors() & conf.CurrentColor() ) {
             _drawKingdomInfo( stonHeight + 5 );
 
-            if ( _state != StatusType::STATUS_RESOURCE ) {
-                _drawArmyInfo( 2 * stonHeight + 10 );
+            if ( _state == StatusType::STATUS_RESOURCE ) {
+                _drawResourceInfo( 2 * stonHeight + 10 );
+            }
+            else if ( _state == StatusType::STATUS_MESSAGE ) {
+                _drawMessage( 2 * stonHeight + 10 );
             }
             else {
-                _drawResourceInfo( 2 * stonHeight + 10 );
+                _drawArmyInfo( 2 * stonHeight + 10 );
             }
         }
     }
@@ -145,6 +214,9 @@ void Interface::StatusPanel::_redraw() const
         case StatusType::STATUS_RESOURCE:
             _drawResourceInfo( stonHeight + 5 );
             break;
+        case StatusType::STATUS_MESSAGE:
+            _drawMessage( stonHeight + 5 );
+            break;
         case StatusType::STATUS_UNKNOWN:
         case StatusType::STATUS_AITURN:
             assert( 0 ); // we shouldn't even reach this code
@@ -167,6 +239,9 @@ void Interface::StatusPanel::_redraw() const
         case StatusType::STATUS_RESOURCE:
             _drawResourceInfo();
             break;
+        case StatusType::STATUS_MESSAGE:
+            _drawMessage();
+            break;
         case StatusType::STATUS_UNKNOWN:
         case StatusType::STATUS_AITURN:
             assert( 0 ); // we shouldn't even reach this code
@@ -199,7 +274,7 @@ void Interface::StatusPanel::NextState()
             _state = StatusType::STATUS_DAY;
         }
     }
-    else if ( StatusType::STATUS_RESOURCE == _state ) {
+    else if ( StatusType::STATUS_RESOURCE == _state || StatusType::STATUS_MESSAGE == _state ) {
         _state = StatusType::STATUS_ARMY;
     }
 
@@ -315,6 +390,25 @@ void Interface::StatusPanel::_drawResourceInfo( const int32_t offsetY ) const
     text.draw( pos.x + ( pos.width - text.width() ) / 2, pos.y + offsetY + text.height() * 2 + spr.height() + 10, display );
 }
 
+void Interface::StatusPanel::setMessage( std::string message )
+{
+    _message = std::move( message );
+    _state = StatusType::STATUS_MESSAGE;
+
+    // The message text is not a part of the visible state.
+    _drawnState.clear();
+
+    _showLastResourceDelay.reset();
+}
+
+void Interface::StatusPanel::_drawMessage( const int32_t offsetY ) const
+{
+    const fheroes2::Rect & pos = GetArea();
+
+    const fheroes2::Text text{ _message, fheroes2::FontType::smallWhite() };
+    text.draw( pos.x, pos.y + 6 + offsetY, pos.width, fheroes2::Display::instance() );
+}
+
 void Interface::StatusPanel::_drawArmyInfo( const int32_t offsetY ) const
 {
     const Army * armyTroops = nullptr;
@@ -468,7 +562,7 @@ void Interface::StatusPanel::QueueEventProcessing()
 
 void Interface::StatusPanel::TimerEventProcessing()
 {
-    if ( _state != StatusType::STATUS_RESOURCE || !_showLastResourceDelay.isPassed() ) {
+    if ( ( _state != StatusType::STATUS_RESOURCE && _state != StatusType::STATUS_MESSAGE ) || !_showLastResourceDelay.isPassed() ) {
         return;
     }
 
@@ -494,6 +588,8 @@ void Interface::StatusPanel::drawAITurnProgress( const uint32_t progressValue )
     // another music chunk on some platforms (e.g. WebAssembly), etc.
     LocalEvent::Get().HandleEvents( false );
 
+    _aiTurnUpdateDelay.reset();
+
     const bool updateProgress = ( progressValue != _aiTurnProgress );
     const bool isMapAnimation = Game::validateAnimationDelay( Game::MAPS_DELAY );
 
@@ -518,5 +614,29 @@ void Interface::StatusPanel::drawAITurnProgress( const uint32_t progressValue )
 
     _interface.redraw( REDRAW_STATUS );
 
-    fheroes2::Display::instance().render();
+    if ( isMapAnimation ) {
+        fheroes2::Display::instance().render();
+    }
+    else {
+        // Only the hourglass has been updated.
+        fheroes2::Display::instance().render( GetRect() );
+    }
+}
+
+void Interface::StatusPanel::keepAITurnResponsive()
+{
+    if ( !_aiTurnUpdateDelay.isPassed() ) {
+        return;
+    }
+
+    if ( _aiTurnProgress > 9 ) {
+        // The turn progress has not been drawn yet, so there is nothing to animate.
+        LocalEvent::Get().HandleEvents( false );
+
+        _aiTurnUpdateDelay.reset();
+
+        return;
+    }
+
+    drawAITurnProgress( _aiTurnProgress );
 }
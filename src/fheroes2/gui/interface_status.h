@@ -24,6 +24,8 @@
 #pragma once
 
 #include <cstdint>
+#include <string>
+#include <vector>
 
 #include "interface_border.h"
 #include "resource.h"
@@ -40,7 +42,8 @@ namespace Interface
         STATUS_FUNDS,
         STATUS_ARMY,
         STATUS_RESOURCE,
-        STATUS_AITURN
+        STATUS_AITURN,
+        STATUS_MESSAGE
     };
 
     class StatusPanel final : public BorderWindow
@@ -68,14 +71,23 @@ namespace Interface
             _state = StatusType::STATUS_DAY;
             _lastResource = Resource::UNKNOWN;
             _lastResourceCount = 0;
+
+            _drawnState.clear();
         }
 
         void NextState();
 
         void SetState( const StatusType status );
         void SetResource( const int resource, const uint32_t count );
+
+        // Shows a short message for a few seconds in place of the army or resource info.
+        void setMessage( std::string message );
         void drawAITurnProgress( const uint32_t progressValue );
 
+        // Pumps the event queue and updates the hourglass animation for the current AI turn progress, but only if enough time has passed
+        // since the last update. It is cheap enough to be called from the inner loops of long AI computations to keep the application responsive.
+        void keepAITurnResponsive();
+
         void resetAITurnProgress()
         {
             // We set _aiTurnProgress equal to 10 to properly handle the first draw call for the '0' progress.
@@ -87,24 +99,36 @@ namespace Interface
 
         // Do not call this method directly, use Interface::AdventureMap::redraw() instead to avoid issues in the "no interface" mode.
         // The name of this method starts from _ on purpose to do not mix with other public methods.
-        void _redraw() const;
+        // The panel is not redrawn if nothing visible has changed since the last call, unless `force` is set.
+        void _redraw( const bool force );
 
     private:
+        // Returns the values which define everything that is drawn on the panel.
+        std::vector<int32_t> _getVisibleState() const;
+
         void _drawKingdomInfo( const int32_t offsetY = 0 ) const;
         void _drawDayInfo( const int32_t offsetY = 0 ) const;
         void _drawArmyInfo( const int32_t offsetY = 0 ) const;
         void _drawResourceInfo( const int32_t offsetY = 0 ) const;
+        void _drawMessage( const int32_t offsetY = 0 ) const;
         void _drawBackground() const;
         void _drawAITurns() const;
 
         fheroes2::TimeDelay _showLastResourceDelay{ 2500 };
 
+        // Updates during AI turn are performed approximately 60 times per second.
+        fheroes2::TimeDelay _aiTurnUpdateDelay{ 16 };
+
         BaseInterface & _interface;
 
         StatusType _state{ StatusType::STATUS_UNKNOWN };
         int _lastResource{ Resource::UNKNOWN };
         uint32_t _lastResourceCount{ 0 };
+        std::string _message;
         uint32_t _aiTurnProgress{ 10 };
         uint32_t _grainsAnimationIndexOffset{ 0 };
+
+        // The state of the panel at the time of the last redraw. It is empty if the panel has to be redrawn.
+        std::vector<int32_t> _drawnState;
     };
 }
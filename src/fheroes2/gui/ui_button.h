@@ -257,6 +257,11 @@ namespace fheroes2
             _updateButtonAreas();
         }
 
+        uint32_t getReleasedIndex() const
+        {
+            return _releasedIndex;
+        }
+
     protected:
         const Sprite & _getPressed() const override;
         const Sprite & _getReleased() const override;
@@ -0,0 +1,213 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include "ui_map_preview.h"
+
+#include <cstddef>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ground.h"
+#include "interface_radar.h"
+#include "logging.h"
+#include "map_format_info.h"
+#include "maps.h"
+#include "maps_fileinfo.h"
+#include "mp2.h"
+#include "serialize.h"
+#include "system.h"
+
+namespace
+{
+    const uint32_t mapPreviewMagicNumber{ 0x4D505631 };
+
+    // Only the palette index of every tile is stored in a preview.
+    struct MapPreview
+    {
+        int32_t width{ 0 };
+        std::vector<uint8_t> tiles;
+    };
+
+    bool isValidMapWidth( const int32_t width )
+    {
+        return width == Maps::SMALL || width == Maps::MEDIUM || width == Maps::LARGE || width == Maps::XLARGE;
+    }
+
+    bool readMP2MapPreview( const std::string & path, MapPreview & preview )
+    {
+        StreamFile fileStream;
+        if ( !fileStream.open( path, "rb" ) || fileStream.getBE32() != 0x5C000000 ) {
+            return false;
+        }
+
+        // Two 32-bit values representing width and height of the map are located at the end of the map info section.
+        fileStream.seek( MP2::MP2_MAP_INFO_SIZE - 2 * 4 );
+
+        const int32_t width = static_cast<int32_t>( fileStream.getLE32() );
+        const int32_t height = static_cast<int32_t>( fileStream.getLE32() );
+        if ( fileStream.fail() || width != height || !isValidMapWidth( width ) ) {
+            return false;
+        }
+
+        const size_t tileCount = static_cast<size_t>( width ) * height;
+
+        ROStreamBuf tileStream = fileStream.getStreamBuf( tileCount * MP2::MP2_TILE_STRUCTURE_SIZE );
+        if ( tileStream.size() != tileCount * MP2::MP2_TILE_STRUCTURE_SIZE ) {
+            return false;
+        }
+
+        preview.width = width;
+        preview.tiles.resize( tileCount );
+
+        for ( uint8_t & tile : preview.tiles ) {
+            // The terrain image index is the first field of the tile structure.
+            tile = Interface::Radar::getGroundPaletteIndex( Maps::Ground::getGroundByImageIndex( tileStream.getLE16() ) );
+            tileStream.skip( MP2::MP2_TILE_STRUCTURE_SIZE - 2 );
+        }
+
+        return true;
+    }
+
+    bool readResurrectionMapPreview( const std::string & path, MapPreview & preview )
+    {
+        Maps::Map_Format::MapFormat map;
+        if ( !Maps::Map_Format::loadMapTiles( path, map ) || !isValidMapWidth( map.width ) ) {
+            return false;
+        }
+
+        preview.width = map.width;
+        preview.tiles.resize( map.tiles.size() );
+
+        for ( size_t i = 0; i < map.tiles.size(); ++i ) {
+            preview.tiles[i] = Interface::Radar::getGroundPaletteIndex( Maps::Ground::getGroundByImageIndex( map.tiles[i].terrainIndex ) );
+        }
+
+        return true;
+    }
+
+    std::string getPreviewCacheDirectory()
+    {
+        return System::concatPath( System::GetDataDirectory( "fheroes2" ), "map_previews" );
+    }
+
+    std::string getPreviewCachePath( const std::string & mapPath )
+    {
+        std::ostringstream os;
+        os << std::hex << std::hash<std::string>{}( mapPath ) << ".cache";
+
+        return System::concatPath( getPreviewCacheDirectory(), os.str() );
+    }
+
+    // A cached preview is valid only as long as the size and the modification time of its map file are the same.
+    bool loadCachedPreview( const std::string & mapPath, const uint64_t fileSize, const int64_t modificationTime, MapPreview & preview )
+    {
+        const std::string cachePath = getPreviewCachePath( mapPath );
+
+        StreamFile fileStream;
+        fileStream.setBigendian( true );
+
+        if ( !System::IsFile( cachePath ) || !fileStream.open( cachePath, "rb" ) ) {
+            return false;
+        }
+
+        uint32_t magicNumber = 0;
+        std::string cachedMapPath;
+        uint64_t cachedFileSize = 0;
+        uint64_t cachedModificationTime = 0;
+
+        fileStream >> magicNumber >> cachedMapPath >> cachedFileSize >> cachedModificationTime;
+
+        if ( fileStream.fail() || magicNumber != mapPreviewMagicNumber || cachedMapPath != mapPath || cachedFileSize != fileSize
+             || static_cast<int64_t>( cachedModificationTime ) != modificationTime ) {
+            return false;
+        }
+
+        fileStream >> preview.width >> preview.tiles;
+
+        return !fileStream.fail() && isValidMapWidth( preview.width ) && preview.tiles.size() == static_cast<size_t>( preview.width ) * preview.width;
+    }
+
+    void saveCachedPreview( const std::string & mapPath, const uint64_t fileSize, const int64_t modificationTime, const MapPreview & preview )
+    {
+        const std::string cacheDirectory = getPreviewCacheDirectory();
+        if ( !System::IsDirectory( cacheDirectory ) && !System::MakeDirectory( cacheDirectory ) ) {
+            return;
+        }
+
+        const std::string cachePath = getPreviewCachePath( mapPath );
+
+        StreamFile fileStream;
+        fileStream.setBigendian( true );
+
+        if ( !fileStream.open( cachePath, "wb" ) ) {
+            ERROR_LOG( "Unable to write the map preview cache file " << cachePath )
+            return;
+        }
+
+        fileStream << mapPreviewMagicNumber << mapPath << fileSize << static_cast<uint64_t>( modificationTime ) << preview.width << preview.tiles;
+    }
+}
+
+namespace fheroes2
+{
+    Image getMapPreview( const Maps::FileInfo & info, const int32_t previewSize )
+    {
+        if ( previewSize <= 0 ) {
+            return {};
+        }
+
+        uint64_t fileSize = 0;
+        int64_t modificationTime = 0;
+        if ( !System::GetFileStamp( info.filename, fileSize, modificationTime ) ) {
+            return {};
+        }
+
+        MapPreview preview;
+
+        if ( !loadCachedPreview( info.filename, fileSize, modificationTime, preview ) ) {
+            preview = {};
+
+            const bool isRead = ( info.version == GameVersion::RESURRECTION ) ? readResurrectionMapPreview( info.filename, preview )
+                                                                               : readMP2MapPreview( info.filename, preview );
+            if ( !isRead ) {
+                return {};
+            }
+
+            saveCachedPreview( info.filename, fileSize, modificationTime, preview );
+        }
+
+        Image image( previewSize, previewSize );
+        image.fill( 0 );
+
+        uint8_t * imageY = image.image();
+
+        for ( int32_t y = 0; y < previewSize; ++y, imageY += previewSize ) {
+            const uint8_t * tileY = preview.tiles.data() + static_cast<size_t>( y * preview.width / previewSize ) * preview.width;
+
+            for ( int32_t x = 0; x < previewSize; ++x ) {
+                imageY[x] = tileY[x * preview.width / previewSize];
+            }
+        }
+
+        return image;
+    }
+}
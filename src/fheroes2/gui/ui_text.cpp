@@ -27,6 +27,12 @@
 #include <map>
 #include <memory>
 #include <numeric>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "agg_image.h"
 #include "icn.h"
@@ -314,6 +320,32 @@ namespace
         return std::max( maxWidth, width );
     }
 
+    struct TextLayoutKey
+    {
+        bool operator<( const TextLayoutKey & other ) const
+        {
+            return std::tie( maxWidth, rowHeight, fontSize, fontColor, language, keepLineTrailingSpaces, keepTextTrailingSpaces, text )
+                   < std::tie( other.maxWidth, other.rowHeight, other.fontSize, other.fontColor, other.language, other.keepLineTrailingSpaces,
+                               other.keepTextTrailingSpaces, other.text );
+        }
+
+        std::string text;
+        int32_t maxWidth{ 0 };
+        int32_t rowHeight{ 0 };
+        fheroes2::FontSize fontSize{ fheroes2::FontSize::NORMAL };
+        fheroes2::FontColor fontColor{ fheroes2::FontColor::WHITE };
+        fheroes2::SupportedLanguage language{ fheroes2::SupportedLanguage::English };
+        bool keepLineTrailingSpaces{ false };
+        bool keepTextTrailingSpaces{ false };
+    };
+
+    // The same texts are measured and rendered every time a dialog is redrawn, and the binary search of the best text width
+    // lays out the same text many times. Line breaking is done character by character so the results are cached.
+    // The cache is fully cleared when it is full as texts usually come in big groups from the same dialog.
+    std::map<TextLayoutKey, std::vector<fheroes2::TextLineInfo>> textLayoutCache;
+
+    const size_t textLayoutCacheLimit{ 4096 };
+
     std::unique_ptr<fheroes2::LanguageSwitcher> getLanguageSwitcher( const fheroes2::TextBase & text )
     {
         const auto & language = text.getLanguage();
@@ -323,6 +355,17 @@ namespace
 
         return std::make_unique<fheroes2::LanguageSwitcher>( language.value() );
     }
+
+    struct RenderedTextCacheEntry
+    {
+        fheroes2::RenderedText text;
+
+        // Value of the use counter at the moment of the last use, the least recently used entry is evicted first.
+        uint32_t lastUse{ 0 };
+    };
+
+    // Battles with many stacks draw a few dozen different troop counts per frame, this limit is enough to keep all of them.
+    const size_t renderedTextCacheLimit{ 256 };
 }
 
 namespace fheroes2
@@ -376,7 +419,7 @@ namespace fheroes2
         const auto languageSwitcher = getLanguageSwitcher( *this );
         const int32_t fontHeight = height();
 
-        std::vector<TextLineInfo> lineInfos;
+        FrameVector<TextLineInfo> lineInfos;
         _getTextLineInfos( lineInfos, maxWidth, fontHeight, false );
 
         if ( lineInfos.size() == 1 ) {
@@ -396,7 +439,7 @@ namespace fheroes2
 
         while ( startWidth + 1 < endWidth ) {
             const int32_t currentWidth = ( endWidth + startWidth ) / 2;
-            std::vector<TextLineInfo> tempLineInfos;
+            FrameVector<TextLineInfo> tempLineInfos;
             _getTextLineInfos( tempLineInfos, currentWidth, fontHeight, false );
 
             if ( tempLineInfos.size() > lineInfos.size() ) {
@@ -419,7 +462,7 @@ namespace fheroes2
         const auto languageSwitcher = getLanguageSwitcher( *this );
         const int32_t fontHeight = height();
 
-        std::vector<TextLineInfo> lineInfos;
+        FrameVector<TextLineInfo> lineInfos;
         _getTextLineInfos( lineInfos, maxWidth, fontHeight, false );
 
         return lineInfos.back().offsetY + fontHeight;
@@ -432,7 +475,7 @@ namespace fheroes2
         }
 
         const auto languageSwitcher = getLanguageSwitcher( *this );
-        std::vector<TextLineInfo> lineInfos;
+        FrameVector<TextLineInfo> lineInfos;
         _getTextLineInfos( lineInfos, maxWidth, height(), false );
 
         return static_cast<int32_t>( lineInfos.size() );
@@ -477,7 +520,7 @@ namespace fheroes2
 
         const auto languageSwitcher = getLanguageSwitcher( *this );
 
-        std::vector<TextLineInfo> lineInfos;
+        FrameVector<TextLineInfo> lineInfos;
         _getTextLineInfos( lineInfos, maxWidth, height(), false );
 
         const uint8_t * data = reinterpret_cast<const uint8_t *>( _text.data() );
@@ -563,7 +606,7 @@ namespace fheroes2
         }
     }
 
-    void Text::_getTextLineInfos( std::vector<TextLineInfo> & textLineInfos, const int32_t maxWidth, const int32_t rowHeight, const bool keepTextTrailingSpaces ) const
+    void Text::_getTextLineInfos( FrameVector<TextLineInfo> & textLineInfos, const int32_t maxWidth, const int32_t rowHeight, const bool keepTextTrailingSpaces ) const
     {
         assert( !_text.empty() );
 
@@ -585,6 +628,18 @@ namespace fheroes2
             return;
         }
 
+        // Only layouts starting from the beginning of a line do not depend on the previous texts so they can be cached.
+        std::optional<TextLayoutKey> layoutKey;
+        if ( textLineInfos.empty() ) {
+            layoutKey
+                = TextLayoutKey{ _text, maxWidth, rowHeight, _fontType.size, _fontType.color, getCurrentLanguage(), _keepLineTrailingSpaces, keepTextTrailingSpaces };
+
+            if ( auto iter = textLayoutCache.find( *layoutKey ); iter != textLayoutCache.end() ) {
+                textLineInfos.assign( iter->second.begin(), iter->second.end() );
+                return;
+            }
+        }
+
         int32_t offsetX = firstLineOffsetX;
         int32_t lineCharCount = 0;
         int32_t lastWordCharCount = 0;
@@ -700,6 +755,14 @@ namespace fheroes2
         }
 
         textLineInfos.emplace_back( offsetX, offsetY, lineWidth, lineCharCount );
+
+        if ( layoutKey ) {
+            if ( textLayoutCache.size() >= textLayoutCacheLimit ) {
+                textLayoutCache.clear();
+            }
+
+            textLayoutCache.emplace( std::move( *layoutKey ), std::vector<TextLineInfo>( textLineInfos.begin(), textLineInfos.end() ) );
+        }
     }
 
     int32_t TextInput::width() const
@@ -768,7 +831,7 @@ namespace fheroes2
 
     size_t TextInput::getCursorPositionInAdjacentLine( const size_t currentPos, const int32_t maxWidth, const bool moveUp )
     {
-        std::vector<TextLineInfo> tempLineInfos;
+        FrameVector<TextLineInfo> tempLineInfos;
         _getTextLineInfos( tempLineInfos, maxWidth, height(), true );
         if ( tempLineInfos.empty() ) {
             return currentPos;
@@ -946,7 +1009,7 @@ namespace fheroes2
             return 0;
         }
 
-        std::vector<TextLineInfo> lineInfos;
+        FrameVector<TextLineInfo> lineInfos;
         _getTextLineInfos( lineInfos, _maxTextWidth, fontHeight, true );
 
         if ( pointerLine >= static_cast<int32_t>( lineInfos.size() ) ) {
@@ -1054,7 +1117,7 @@ namespace fheroes2
             // This is a multi-line text.
 
             const int32_t textHeight = height();
-            std::vector<TextLineInfo> lineInfos;
+            FrameVector<TextLineInfo> lineInfos;
             _getTextLineInfos( lineInfos, _maxTextWidth, textHeight, true );
 
             if ( _cursorPositionInText == static_cast<int32_t>( _text.size() ) ) {
@@ -1120,7 +1183,7 @@ namespace fheroes2
     {
         const int32_t maxFontHeight = height();
 
-        std::vector<TextLineInfo> lineInfos;
+        FrameVector<TextLineInfo> lineInfos;
         _getMultiFontTextLineInfos( lineInfos, maxWidth, maxFontHeight );
 
         int32_t maxRowWidth = lineInfos.front().lineWidth;
@@ -1135,7 +1198,7 @@ namespace fheroes2
     {
         const int32_t maxFontHeight = height();
 
-        std::vector<TextLineInfo> lineInfos;
+        FrameVector<TextLineInfo> lineInfos;
         _getMultiFontTextLineInfos( lineInfos, maxWidth, maxFontHeight );
 
         return lineInfos.back().offsetY + maxFontHeight;
@@ -1149,7 +1212,7 @@ namespace fheroes2
 
         const int32_t maxFontHeight = height();
 
-        std::vector<TextLineInfo> lineInfos;
+        FrameVector<TextLineInfo> lineInfos;
         _getMultiFontTextLineInfos( lineInfos, maxWidth, maxFontHeight );
 
         if ( lineInfos.empty() ) {
@@ -1218,7 +1281,7 @@ namespace fheroes2
 
         const int32_t maxFontHeight = height();
 
-        std::vector<TextLineInfo> lineInfos;
+        FrameVector<TextLineInfo> lineInfos;
         _getMultiFontTextLineInfos( lineInfos, maxWidth, maxFontHeight );
 
         if ( lineInfos.empty() ) {
@@ -1226,7 +1289,7 @@ namespace fheroes2
         }
 
         // One line can contain text with a different font. Calculate the width of each line.
-        std::vector<int32_t> lineWidths;
+        FrameVector<int32_t> lineWidths;
         lineWidths.reserve( lineInfos.size() );
 
         int32_t offsetY = 0;
@@ -1320,7 +1383,7 @@ namespace fheroes2
         return output;
     }
 
-    void MultiFontText::_getMultiFontTextLineInfos( std::vector<TextLineInfo> & textLineInfos, const int32_t maxWidth, const int32_t rowHeight ) const
+    void MultiFontText::_getMultiFontTextLineInfos( FrameVector<TextLineInfo> & textLineInfos, const int32_t maxWidth, const int32_t rowHeight ) const
     {
         const size_t textsCount = _texts.size();
         for ( size_t i = 0; i < textsCount; ++i ) {
@@ -1429,4 +1492,52 @@ namespace fheroes2
     {
         return FontCharHandler{ type }.getSprite( cursorChar );
     }
+    const RenderedText & getRenderedText( const std::string & text, const FontType fontType )
+    {
+        assert( text.find( '\n' ) == std::string::npos );
+
+        static std::unordered_map<std::string, RenderedTextCacheEntry> cache;
+        static uint32_t useCounter{ 0 };
+
+        ++useCounter;
+
+        // Character sprites depend on the current language.
+        std::string key{ static_cast<char>( fontType.size ), static_cast<char>( fontType.color ), static_cast<char>( getCurrentLanguage() ) };
+        key += text;
+
+        if ( auto iter = cache.find( key ); iter != cache.end() ) {
+            iter->second.lastUse = useCounter;
+            return iter->second.text;
+        }
+
+        if ( cache.size() >= renderedTextCacheLimit ) {
+            cache.erase( std::min_element( cache.begin(), cache.end(),
+                                           []( const auto & left, const auto & right ) { return left.second.lastUse < right.second.lastUse; } ) );
+        }
+
+        RenderedTextCacheEntry & entry = cache[std::move( key )];
+        entry.lastUse = useCounter;
+
+        if ( text.empty() ) {
+            return entry.text;
+        }
+
+        const Text renderedText( text, fontType );
+        entry.text.width = renderedText.width();
+
+        // Some characters can be drawn outside of the text line box, so the image has to cover both.
+        const Rect area = renderedText.area();
+        const int32_t left = std::min( area.x, 0 );
+        const int32_t top = std::min( area.y, 0 );
+        const int32_t right = std::max( area.x + area.width, entry.text.width );
+        const int32_t bottom = std::max( area.y + area.height, renderedText.height() );
+
+        Sprite & image = entry.text.image;
+        image = Sprite( right - left, bottom - top, left, top );
+        image.reset();
+
+        renderedText.draw( -left, -top, image );
+
+        return entry.text;
+    }
 }
@@ -28,6 +28,7 @@
 #include <utility>
 #include <vector>
 
+#include "frame_arena.h"
 #include "image.h"
 #include "math_base.h"
 
@@ -266,7 +267,7 @@ namespace fheroes2
         // Returns text lines parameters (in pixels) in 'offsets': x - horizontal line shift, y - vertical line shift.
         // And in 'characterCount' - the number of characters on the line, in 'lineWidth' the width including the `offsetX` value.
         // The 'keepTextTrailingSpaces' is used to take into account all the spaces at the text end in example when you want to join multiple texts in multi-font texts.
-        void _getTextLineInfos( std::vector<TextLineInfo> & textLineInfos, const int32_t maxWidth, const int32_t rowHeight, const bool keepTextTrailingSpaces ) const;
+        void _getTextLineInfos( FrameVector<TextLineInfo> & textLineInfos, const int32_t maxWidth, const int32_t rowHeight, const bool keepTextTrailingSpaces ) const;
 
         std::string _text;
 
@@ -375,7 +376,7 @@ namespace fheroes2
         std::string text() const override;
 
     private:
-        void _getMultiFontTextLineInfos( std::vector<TextLineInfo> & textLineInfos, const int32_t maxWidth, const int32_t rowHeight ) const;
+        void _getMultiFontTextLineInfos( FrameVector<TextLineInfo> & textLineInfos, const int32_t maxWidth, const int32_t rowHeight ) const;
 
         std::vector<Text> _texts;
     };
@@ -419,4 +420,18 @@ namespace fheroes2
     int32_t getTruncationSymbolWidth( const FontType fontType );
 
     const Sprite & getCursorSprite( const FontType type );
+
+    struct RenderedText
+    {
+        // The text rendered on a transparent background. The sprite offset is relative to the text drawing position, so drawing
+        // the sprite at ( x + image.x(), y + image.y() ) gives the same result as calling Text::draw( x, y, ... ).
+        Sprite image;
+
+        // The same value as returned by Text::width().
+        int32_t width{ 0 };
+    };
+
+    // Returns a single-line text rendered using the given font. The most recently used texts are cached, which makes this function
+    // suitable for short texts which are drawn on every frame, like troop counts. The returned reference is valid only until the next call.
+    const RenderedText & getRenderedText( const std::string & text, const FontType fontType );
 }
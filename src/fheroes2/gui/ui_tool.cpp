@@ -24,6 +24,7 @@
 #include <array>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
 #include <cstring>
 #include <ctime>
 #include <stdexcept>
@@ -32,11 +33,15 @@
 
 #include "agg_image.h"
 #include "cursor.h"
+#include "frame_arena.h"
 #include "game_delays.h"
 #include "icn.h"
 #include "image_palette.h"
 #include "localevent.h"
+#include "memory_usage.h"
 #include "pal.h"
+#include "perf_counters.h"
+#include "profiler.h"
 #include "race.h"
 #include "render_processor.h"
 #include "screen.h"
@@ -57,6 +62,20 @@ namespace
     const uint32_t screenFadeFrameCount = 6;
     const uint8_t screenFadeStep = ( fullBrightAlpha - fullDarkAlpha ) / screenFadeFrameCount;
 
+    std::string getTimeMsString( const double timeMs )
+    {
+        const int64_t timeTenthMs = std::llround( timeMs * 10 );
+
+        return std::to_string( timeTenthMs / 10 ) + '.' + std::to_string( timeTenthMs % 10 );
+    }
+
+    std::string getMemorySizeString( const size_t bytes )
+    {
+        const size_t tenthMb = ( bytes * 10 + 512 * 1024 ) / ( 1024 * 1024 );
+
+        return std::to_string( tenthMb / 10 ) + '.' + std::to_string( tenthMb % 10 ) + " MB";
+    }
+
     void fadeDisplay( const uint8_t startAlpha, const uint8_t endAlpha, const fheroes2::Rect & roi, const uint32_t fadeTimeMs, const uint32_t frameCount )
     {
         if ( frameCount < 2 || roi.height <= 0 || roi.width <= 0 ) {
@@ -254,6 +273,9 @@ namespace fheroes2
     SystemInfoRenderer::SystemInfoRenderer()
         : _startTime( std::chrono::steady_clock::now() )
         , _text( fheroes2::Display::instance() )
+        , _profilerText( fheroes2::Display::instance() )
+        , _memoryText( fheroes2::Display::instance() )
+        , _perfCountersText( fheroes2::Display::instance() )
     {}
 
     void SystemInfoRenderer::preRender()
@@ -306,6 +328,109 @@ namespace fheroes2
         _text.draw( offsetX, offsetY );
 
         display.updateNextRenderRoi( fpsRoi );
+
+        const Profiler & profiler = Profiler::instance();
+        if ( !profiler.isEnabled() ) {
+            return;
+        }
+
+        // Profiler statistics are for developers only so they are not translated.
+        std::string profilerInfo = "Frame: " + getTimeMsString( profiler.getAverageFrameTimeMs() ) + " ms";
+
+        const std::array<double, Profiler::sectionCount> & sectionTimeMs = profiler.getAverageSectionTimeMs();
+        for ( size_t i = 0; i < sectionTimeMs.size(); ++i ) {
+            profilerInfo += ", ";
+            profilerInfo += getProfilerSectionName( static_cast<ProfilerSection>( i ) );
+            profilerInfo += ": ";
+            profilerInfo += getTimeMsString( sectionTimeMs[i] );
+        }
+
+        // Allocations of temporary objects during the previous frame. The heap should not be used by the arena in the steady state.
+        const FrameArena::Statistics & arenaStatistics = FrameArena::instance().getLastFrameStatistics();
+        profilerInfo += ", Frame arena: ";
+        profilerInfo += std::to_string( arenaStatistics.allocationCount );
+        profilerInfo += " allocs, ";
+        profilerInfo += getMemorySizeString( arenaStatistics.allocatedBytes );
+        profilerInfo += ", heap allocs: ";
+        profilerInfo += std::to_string( arenaStatistics.heapAllocationCount );
+
+        auto profilerText = std::make_unique<fheroes2::Text>( std::move( profilerInfo ), fheroes2::FontType::smallWhite() );
+
+        const int32_t profilerOffsetY = offsetY - profilerText->height() - 2;
+
+        fheroes2::Rect profilerRoi( profilerText->area() );
+        profilerRoi.x += offsetX;
+        profilerRoi.y += profilerOffsetY;
+
+        _profilerText.update( std::move( profilerText ) );
+        _profilerText.draw( offsetX, profilerOffsetY );
+
+        display.updateNextRenderRoi( profilerRoi );
+
+        if ( _memoryInfo.empty() || endTime - _memoryUpdateTime >= std::chrono::seconds( 1 ) ) {
+            _memoryUpdateTime = endTime;
+
+            const std::array<size_t, memoryOwnerCount> usage = getMemoryUsage();
+
+            size_t totalSize = 0;
+            _memoryInfo.clear();
+
+            for ( size_t i = 0; i < usage.size(); ++i ) {
+                totalSize += usage[i];
+
+                _memoryInfo += ", ";
+                _memoryInfo += getMemoryOwnerName( static_cast<MemoryOwner>( i ) );
+                _memoryInfo += ": ";
+                _memoryInfo += getMemorySizeString( usage[i] );
+            }
+
+            _memoryInfo.insert( 0, "Memory: " + getMemorySizeString( totalSize ) );
+
+            const PerfCounters & perfCounters = PerfCounters::instance();
+            _perfCountersInfo.clear();
+
+            for ( size_t i = 0; i < PerfCounters::counterCount; ++i ) {
+                const PerfCounter counter = static_cast<PerfCounter>( i );
+
+                if ( !_perfCountersInfo.empty() ) {
+                    _perfCountersInfo += ", ";
+                }
+                _perfCountersInfo += getPerfCounterName( counter );
+                _perfCountersInfo += ": ";
+                _perfCountersInfo += std::to_string( perfCounters.getCounter( counter ) );
+            }
+
+            const PerfCounters::HistogramStatistics frameTime = perfCounters.getHistogram( PerfHistogram::FRAME_TIME_US );
+            _perfCountersInfo += ", frame time 99%: ";
+            _perfCountersInfo += getTimeMsString( static_cast<double>( frameTime.getPercentile( 0.99 ) ) / 1000 );
+            _perfCountersInfo += " ms";
+        }
+
+        auto memoryText = std::make_unique<fheroes2::Text>( _memoryInfo, fheroes2::FontType::smallWhite() );
+
+        const int32_t memoryOffsetY = profilerOffsetY - memoryText->height() - 2;
+
+        fheroes2::Rect memoryRoi( memoryText->area() );
+        memoryRoi.x += offsetX;
+        memoryRoi.y += memoryOffsetY;
+
+        _memoryText.update( std::move( memoryText ) );
+        _memoryText.draw( offsetX, memoryOffsetY );
+
+        display.updateNextRenderRoi( memoryRoi );
+
+        auto perfCountersText = std::make_unique<fheroes2::Text>( _perfCountersInfo, fheroes2::FontType::smallWhite() );
+
+        const int32_t perfCountersOffsetY = memoryOffsetY - perfCountersText->height() - 2;
+
+        fheroes2::Rect perfCountersRoi( perfCountersText->area() );
+        perfCountersRoi.x += offsetX;
+        perfCountersRoi.y += perfCountersOffsetY;
+
+        _perfCountersText.update( std::move( perfCountersText ) );
+        _perfCountersText.draw( offsetX, perfCountersOffsetY );
+
+        display.updateNextRenderRoi( perfCountersRoi );
     }
 
     void TimedEventValidator::senderUpdate( const ActionObject * sender )
@@ -197,7 +197,7 @@ namespace fheroes2
         bool _isSingleLineTextCenterAligned{ false };
     };
 
-    // Renderer of current time and FPS on screen
+    // Renderer of current time, FPS, profiler statistics, memory usage and performance counters on screen
     class SystemInfoRenderer
     {
     public:
@@ -213,12 +213,24 @@ namespace fheroes2
 
         void postRender()
         {
+            _perfCountersText.hide();
+            _memoryText.hide();
+            _profilerText.hide();
             _text.hide();
         }
 
     private:
         std::chrono::time_point<std::chrono::steady_clock> _startTime;
         fheroes2::MovableText _text;
+        // Frame time statistics shown when the profiler is enabled.
+        fheroes2::MovableText _profilerText;
+        // Memory usage shown along with the profiler statistics. Counting it takes time, so it is updated once per second.
+        fheroes2::MovableText _memoryText;
+        std::string _memoryInfo;
+        // Performance counters collected since the start of the session, updated along with the memory usage.
+        fheroes2::MovableText _perfCountersText;
+        std::string _perfCountersInfo;
+        std::chrono::time_point<std::chrono::steady_clock> _memoryUpdateTime;
         std::deque<double> _delays;
     };
 
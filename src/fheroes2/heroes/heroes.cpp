@@ -1791,42 +1791,7 @@ int Heroes::getNumOfTravelDays( const int32_t dstIdx ) const
 {
     assert( Maps::isValidAbsIndex( dstIdx ) );
 
-    const uint32_t maxMovePoints = GetMaxMovePoints();
-    const std::list<Route::Step> routePath = world.getPath( *this, dstIdx );
-
-    if ( routePath.empty() ) {
-        return 0;
-    }
-
-    uint32_t movePoints = GetMovePoints();
-    int days = 1;
-
-    for ( const Route::Step & step : routePath ) {
-        const uint32_t stepPenalty = step.GetPenalty();
-
-        if ( movePoints >= stepPenalty ) {
-            // This movement takes place on the same day
-            movePoints -= stepPenalty;
-        }
-        else {
-            // This movement takes place at the beginning of a new day: start with max
-            // movement points, don't carry leftovers from the previous day
-            assert( maxMovePoints >= stepPenalty );
-
-            movePoints = maxMovePoints - stepPenalty;
-            ++days;
-
-            // Stop at 8 days
-            if ( days >= 8 ) {
-                break;
-            }
-        }
-    }
-
-    // Return no more than 8 days
-    assert( days <= 8 );
-
-    return days;
+    return world.getNumOfTravelDays( *this, dstIdx );
 }
 
 void Heroes::_levelUp( const bool skipSecondary, const bool autoselect /* = false */ )
@@ -2035,6 +2000,9 @@ void Heroes::Move2Dest( const int32_t destinationIndex )
     world.getTile( currentIndex ).setHero( nullptr );
     SetIndex( destinationIndex );
     world.getTile( destinationIndex ).setHero( this );
+
+    world.markRadarUpdateArea( { Maps::GetPoint( currentIndex ), { 1, 1 } } );
+    world.markRadarUpdateArea( { Maps::GetPoint( destinationIndex ), { 1, 1 } } );
 }
 
 const fheroes2::Sprite & Heroes::GetPortrait( const int heroId, const int portraitType )
@@ -2162,6 +2162,7 @@ namespace
 
                     Troop & troop = world.GetCapturedObject( dstIndex ).GetTroop();
                     troop.SetCount( monstersLeft );
+                    world.markMonsterDataChanged();
 
                     // If all the guards are defeated, but the hero has lost the battle,
                     // just remove the protection from the object
@@ -3736,7 +3737,8 @@ void Heroes::ScoutRadar() const
         if ( !player->isAIAutoControlMode() ) {
 #endif
 
-            I.getRadar().SetRenderArea( GetScoutRoi() );
+            // Tiles with revealed fog are reported by the world and added to the radar render area on redraw.
+            I.getRadar().SetRenderArea( { GetCenter(), { 1, 1 } } );
 
 #if defined( WITH_DEBUG )
         }
@@ -3786,6 +3788,13 @@ void Heroes::Action( const int tileIndex )
     }
 
     if ( GetKingdom().isControlAI() ) {
+        // Most of the tiles that AI heroes pass through are empty and AI::HeroesAction() would do nothing for them. This is called for every
+        // step of the hero's movement, so skip the action dispatching (and the music restoration request for the audio thread) for such tiles.
+        if ( const Maps::Tile & tile = world.getTile( tileIndex );
+             tile.getMainObjectType( tileIndex != GetIndex() ) == MP2::OBJ_NONE && !( isShipMaster() && tile.isSuitableForDisembarkation() ) ) {
+            return;
+        }
+
         // Restore the original music after the action is completed.
         const AudioManager::MusicRestorer musicRestorer;
 
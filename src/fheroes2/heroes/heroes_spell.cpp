@@ -346,6 +346,7 @@ namespace
         }
 
         world.GetCapturedObject( tile.GetIndex() ).GetTroop().Set( Monster( spell ), count );
+        world.markMonsterDataChanged();
 
         return true;
     }
@@ -24,8 +24,8 @@
 #pragma once
 
 #include <cstdint>
-#include <list>
 #include <string>
+#include <vector>
 
 #include "direction.h"
 
@@ -77,7 +77,9 @@ namespace Route
         uint32_t penalty = 0;
     };
 
-    class Path : public std::list<Step>
+    // Steps are stored contiguously, so assigning a new path of the same or smaller size to the hero reuses the already
+    // allocated buffer. Paths are short, so removing the current step from the front is cheap enough.
+    class Path : public std::vector<Step>
     {
     public:
         explicit Path( const Heroes & hero );
@@ -129,7 +131,7 @@ namespace Route
             return ( ++iter )->GetDirection();
         }
 
-        void setPath( const std::list<Step> & path )
+        void setPath( const std::vector<Step> & path )
         {
             assign( path.begin(), path.end() );
         }
@@ -167,7 +169,7 @@ namespace Route
                 return;
             }
 
-            pop_front();
+            erase( begin() );
         }
 
         // Returns true if this path is valid for normal movement on the map (the current step is performed to the tile
@@ -204,5 +206,5 @@ namespace Route
     OStreamBase & operator<<( OStreamBase & stream, const Path & path );
     IStreamBase & operator>>( IStreamBase & stream, Path & path );
 
-    uint32_t calculatePathPenalty( const std::list<Step> & path );
+    uint32_t calculatePathPenalty( const std::vector<Step> & path );
 }
@@ -135,6 +135,10 @@ void Kingdom::clear()
     castles.clear();
     visit_object.clear();
 
+    _visitedObjectCounts.clear();
+    _castleCount = 0;
+    _townCount = 0;
+
     recruits.Reset();
 
     puzzle_maps.reset();
@@ -179,6 +183,7 @@ void Kingdom::LossPostActions()
     }
 
     castles.clear();
+    updateCastleCounters();
 
     world.ResetCapturedObjects( GetColor() );
 }
@@ -200,6 +205,7 @@ void Kingdom::ActionNewDay()
 {
     // Clear the visited objects with a lifetime of one day, even if this kingdom has already been vanquished
     visit_object.remove_if( Visit::isDayLife );
+    _updateVisitedObjectCounters();
 
     if ( !isPlay() ) {
         return;
@@ -231,16 +237,21 @@ void Kingdom::ActionNewDayResourceUpdate( const std::function<void( const EventD
     const bool isAIPlayer = ( GetControl() == CONTROL_AI );
 
     // Resources from events
-    const EventsDate events = world.GetEventsDate( GetColor() );
-    for ( const EventDate & event : events ) {
-        if ( isAIPlayer && !event.isApplicableForAIPlayers ) {
+    for ( const EventDate * event : world.getTodayEvents() ) {
+        assert( event != nullptr );
+
+        if ( !event->isAllow( GetColor(), world.CountDay() ) ) {
             continue;
         }
 
-        const Funds fundsUpdate = Resource::CalculateEventResourceUpdate( GetFunds(), event.resource );
+        if ( isAIPlayer && !event->isApplicableForAIPlayers ) {
+            continue;
+        }
+
+        const Funds fundsUpdate = Resource::CalculateEventResourceUpdate( GetFunds(), event->resource );
         AddFundsResource( fundsUpdate );
         if ( displayEventDialog )
-            displayEventDialog( event, fundsUpdate );
+            displayEventDialog( *event, fundsUpdate );
     }
 }
 
@@ -248,6 +259,7 @@ void Kingdom::ActionNewWeek()
 {
     // Clear the visited objects with a lifetime of one week, even if this kingdom has already been vanquished
     visit_object.remove_if( Visit::isWeekLife );
+    _updateVisitedObjectCounters();
 
     if ( !isPlay() ) {
         return;
@@ -307,11 +319,28 @@ void Kingdom::RemoveHero( const Heroes * hero )
     }
 }
 
+void Kingdom::updateCastleCounters()
+{
+    _castleCount = static_cast<uint32_t>( std::count_if( castles.begin(), castles.end(), Castle::PredicateIsCastle ) );
+    _townCount = static_cast<uint32_t>( std::count_if( castles.begin(), castles.end(), Castle::PredicateIsTown ) );
+}
+
+void Kingdom::_updateVisitedObjectCounters()
+{
+    _visitedObjectCounts.clear();
+
+    for ( const IndexObject & object : visit_object ) {
+        ++_visitedObjectCounts[object.second];
+    }
+}
+
 void Kingdom::AddCastle( Castle * castle )
 {
     if ( castle ) {
         if ( castles.end() == std::find( castles.begin(), castles.end(), castle ) ) {
             castles.push_back( castle );
+
+            updateCastleCounters();
         }
 
         const Player * player = Settings::Get().GetPlayers().GetCurrent();
@@ -331,6 +360,8 @@ void Kingdom::RemoveCastle( const Castle * castle )
             assert( it != castles.end() );
             if ( it != castles.end() ) {
                 castles.erase( it );
+
+                updateCastleCounters();
             }
         }
 
@@ -345,16 +376,6 @@ void Kingdom::RemoveCastle( const Castle * castle )
         LossPostActions();
 }
 
-uint32_t Kingdom::GetCountCastle() const
-{
-    return static_cast<uint32_t>( std::count_if( castles.begin(), castles.end(), Castle::PredicateIsCastle ) );
-}
-
-uint32_t Kingdom::GetCountTown() const
-{
-    return static_cast<uint32_t>( std::count_if( castles.begin(), castles.end(), Castle::PredicateIsTown ) );
-}
-
 uint32_t Kingdom::GetCountMarketplace() const
 {
     return static_cast<uint32_t>(
@@ -406,19 +427,23 @@ bool Kingdom::isVisited( int32_t index, const MP2::MapObjectType objectType ) co
 
 bool Kingdom::isVisited( const MP2::MapObjectType objectType ) const
 {
-    return std::any_of( visit_object.begin(), visit_object.end(), [objectType]( const IndexObject & v ) { return v.isObject( objectType ); } );
+    return CountVisitedObjects( objectType ) > 0;
 }
 
 uint32_t Kingdom::CountVisitedObjects( const MP2::MapObjectType objectType ) const
 {
-    // Safe to downcast as we don't deal with gigantic amount of data.
-    return static_cast<uint32_t>( std::count_if( visit_object.begin(), visit_object.end(), [objectType]( const IndexObject & v ) { return v.isObject( objectType ); } ) );
+    const auto iter = _visitedObjectCounts.find( objectType );
+
+    return iter != _visitedObjectCounts.end() ? iter->second : 0;
 }
 
 void Kingdom::SetVisited( int32_t index, const MP2::MapObjectType objectType )
 {
-    if ( !isVisited( index, objectType ) && objectType != MP2::OBJ_NONE )
+    if ( !isVisited( index, objectType ) && objectType != MP2::OBJ_NONE ) {
         visit_object.emplace_front( index, objectType );
+
+        ++_visitedObjectCounts[objectType];
+    }
 }
 
 bool Kingdom::isValidKingdomObject( const Maps::Tile & tile, const MP2::MapObjectType objectType ) const
@@ -984,7 +1009,13 @@ IStreamBase & operator>>( IStreamBase & stream, Kingdom & kingdom )
         stream >> dummy;
     }
 
-    return stream >> kingdom._topCastleInKingdomView >> kingdom._topHeroInKingdomView;
+    stream >> kingdom._topCastleInKingdomView >> kingdom._topHeroInKingdomView;
+
+    // Castles are loaded before kingdoms, so their state is already known.
+    kingdom.updateCastleCounters();
+    kingdom._updateVisitedObjectCounters();
+
+    return stream;
 }
 
 OStreamBase & operator<<( OStreamBase & stream, const Kingdoms & obj )
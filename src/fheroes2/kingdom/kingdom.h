@@ -28,6 +28,7 @@
 #include <cstdint>
 #include <functional>
 #include <list>
+#include <map>
 #include <set>
 
 #include "bitmodes.h"
@@ -148,8 +149,16 @@ public:
         return castles.empty();
     }
 
-    uint32_t GetCountCastle() const;
-    uint32_t GetCountTown() const;
+    uint32_t GetCountCastle() const
+    {
+        return _castleCount;
+    }
+
+    uint32_t GetCountTown() const
+    {
+        return _townCount;
+    }
+
     uint32_t GetCountMarketplace() const;
 
     uint32_t GetLostTownDays() const
@@ -199,6 +208,9 @@ public:
     void AddCastle( Castle * castle );
     void RemoveCastle( const Castle * );
 
+    // Must be called when a town of this kingdom is upgraded to a castle.
+    void updateCastleCounters();
+
     void ActionBeforeTurn();
     void ActionNewDay();
     void ActionNewWeek();
@@ -236,6 +248,8 @@ public:
 private:
     Cost _getKingdomStartingResources( const int difficulty ) const;
 
+    void _updateVisitedObjectCounters();
+
     friend OStreamBase & operator<<( OStreamBase & stream, const Kingdom & kingdom );
     friend IStreamBase & operator>>( IStreamBase & stream, Kingdom & kingdom );
 
@@ -251,6 +265,12 @@ private:
 
     std::list<IndexObject> visit_object;
 
+    // Statistics of the kingdom shown by the Thieves' Guild and the status window. They are updated along with the state of
+    // the kingdom instead of being calculated on every request.
+    std::map<MP2::MapObjectType, uint32_t> _visitedObjectCounts;
+    uint32_t _castleCount{ 0 };
+    uint32_t _townCount{ 0 };
+
     Puzzle puzzle_maps;
     int32_t _visitedTentsColors{ 0 };
 
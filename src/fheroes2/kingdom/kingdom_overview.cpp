@@ -27,10 +27,14 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "agg_image.h"
+#include "army.h"
 #include "army_bar.h"
+#include "army_troop.h"
 #include "artifact.h"
 #include "buildinginfo.h"
 #include "captain.h"
@@ -118,6 +122,79 @@ namespace
         fheroes2::Copy( overback, 29, 12, output, overbackOffsetX, dst.y + 12, 1, 357 );
     }
 
+    // Image of a rendered list row together with the state of the data it was rendered from.
+    struct RowImageCache
+    {
+        std::vector<int32_t> state;
+        fheroes2::Point position{ -1, -1 };
+        fheroes2::Image image;
+    };
+
+    // The area covered by a list row including a few pixels drawn above and to the left of the row background by the bars.
+    fheroes2::Rect getRowArea( const int32_t dstx, const int32_t dsty )
+    {
+        return { dstx - 1, dsty - 3, 596, 86 };
+    }
+
+    // Copies the cached row image to the output if the row was rendered at the same place from the same data.
+    bool restoreRowFromCache( const RowImageCache & cache, const std::vector<int32_t> & state, const fheroes2::Rect & area, fheroes2::Image & output )
+    {
+        if ( cache.image.empty() || cache.position != area.getPosition() || cache.state != state ) {
+            return false;
+        }
+
+        fheroes2::Copy( cache.image, 0, 0, output, area.x, area.y, area.width, area.height );
+        return true;
+    }
+
+    void storeRowInCache( RowImageCache & cache, std::vector<int32_t> state, const fheroes2::Rect & area, const fheroes2::Image & input )
+    {
+        cache.state = std::move( state );
+        cache.position = area.getPosition();
+
+        if ( input.singleLayer() ) {
+            cache.image._disableTransformLayer();
+        }
+
+        cache.image.resize( area.width, area.height );
+        fheroes2::Copy( input, area.x, area.y, cache.image, 0, 0, area.width, area.height );
+    }
+
+    void appendArmyState( const Troops & army, std::vector<int32_t> & state )
+    {
+        for ( size_t i = 0; i < army.Size(); ++i ) {
+            const Troop * troop = army.GetTroop( i );
+            assert( troop != nullptr );
+
+            state.push_back( troop->isValid() ? troop->GetID() : 0 );
+            state.push_back( static_cast<int32_t>( troop->GetCount() ) );
+        }
+    }
+
+    template <typename Bar>
+    void appendSelectionState( Bar & bar, std::vector<int32_t> & state )
+    {
+        state.push_back( bar.isSelected() ? bar.GetSelectedIndex() : -1 );
+    }
+
+    void appendCommanderState( const HeroBase & commander, std::vector<int32_t> & state )
+    {
+        state.push_back( commander.GetAttack() );
+        state.push_back( commander.GetDefense() );
+        state.push_back( commander.GetPower() );
+        state.push_back( commander.GetKnowledge() );
+        state.push_back( static_cast<int32_t>( commander.getManaIndexSprite() ) );
+    }
+
+    void appendHeroState( const Heroes & hero, std::vector<int32_t> & state )
+    {
+        state.push_back( hero.GetID() );
+        state.push_back( static_cast<int32_t>( hero.GetMobilityIndexSprite() ) );
+        state.push_back( hero.Modes( Heroes::SLEEPER ) ? 1 : 0 );
+        appendCommanderState( hero, state );
+        appendArmyState( hero.GetArmy(), state );
+    }
+
     struct HeroRow
     {
         Heroes * hero{ nullptr };
@@ -209,6 +286,7 @@ namespace
         void SetContent( const VecHeroes & heroes );
 
         std::vector<HeroRow> content;
+        std::unordered_map<const Heroes *, RowImageCache> _rowImageCache;
         const fheroes2::Rect _windowArea;
     };
 
@@ -238,6 +316,7 @@ namespace
     void StatsHeroesList::SetContent( const VecHeroes & heroes )
     {
         content.clear();
+        _rowImageCache.clear();
         content.reserve( heroes.size() );
         for ( Heroes * hero : heroes ) {
             content.emplace_back( hero );
@@ -330,7 +409,37 @@ namespace
             return;
         }
 
+        // Bars must always know their position on screen to process events even if the row is not rendered again.
+        row.primSkillsBar->setRenderingOffset( { dstx + 56, dsty - 3 } );
+        row.secSkillsBar->setRenderingOffset( { dstx + 206, dsty + 3 } );
+        row.artifactsBar->setRenderingOffset( { dstx + 348, dsty + 3 } );
+        row.armyBar->setRenderingOffset( { dstx - 1, dsty + 30 } );
+
+        std::vector<int32_t> rowState;
+        appendHeroState( *row.hero, rowState );
+
+        for ( const Skill::Secondary & skill : row.hero->GetSecondarySkills().ToVector() ) {
+            rowState.push_back( skill.Skill() );
+            rowState.push_back( skill.Level() );
+        }
+
+        for ( const Artifact & artifact : row.hero->GetBagArtifacts() ) {
+            rowState.push_back( artifact.GetID() );
+            rowState.push_back( artifact.getSpellId() );
+        }
+
+        appendSelectionState( *row.armyBar, rowState );
+        appendSelectionState( *row.artifactsBar, rowState );
+
         fheroes2::Display & display = fheroes2::Display::instance();
+
+        const fheroes2::Rect rowArea = getRowArea( dstx, dsty );
+        RowImageCache & rowCache = _rowImageCache[row.hero];
+
+        if ( restoreRowFromCache( rowCache, rowState, rowArea, display ) ) {
+            return;
+        }
+
         fheroes2::Blit( fheroes2::AGG::GetICN( ICN::OVERVIEW, 10 ), display, dstx, dsty );
 
         // base info
@@ -355,20 +464,18 @@ namespace
         text.draw( offsetX - text.width(), offsetY, display );
 
         // primary skills info
-        row.primSkillsBar->setRenderingOffset( { dstx + 56, dsty - 3 } );
         row.primSkillsBar->Redraw( display );
 
         // secondary skills info
-        row.secSkillsBar->setRenderingOffset( { dstx + 206, dsty + 3 } );
         row.secSkillsBar->Redraw( display );
 
         // artifacts info
-        row.artifactsBar->setRenderingOffset( { dstx + 348, dsty + 3 } );
         row.artifactsBar->Redraw( display );
 
         // army info
-        row.armyBar->setRenderingOffset( { dstx - 1, dsty + 30 } );
         row.armyBar->Redraw( display );
+
+        storeRowInCache( rowCache, std::move( rowState ), rowArea, display );
     }
 
     void StatsHeroesList::RedrawBackground( const fheroes2::Point & dst )
@@ -491,6 +598,7 @@ namespace
 
     private:
         std::vector<CstlRow> content;
+        std::unordered_map<const Castle *, RowImageCache> _rowImageCache;
         const fheroes2::Rect _windowArea;
     };
 
@@ -615,15 +723,60 @@ namespace
             return;
         }
 
+        // Bars must always know their position on screen to process events even if the row is not rendered again.
+        if ( row.garrisonArmyBar ) {
+            row.garrisonArmyBar->setRenderingOffset( { dstx + 146, row.heroArmyBar ? dsty : dsty + 20 } );
+        }
+
+        if ( row.heroArmyBar ) {
+            row.heroArmyBar->setRenderingOffset( { dstx + 146, row.garrisonArmyBar ? dsty + 41 : dsty + 20 } );
+        }
+
+        row.dwellingsBar->setRenderingOffset( { dstx + 349, dsty + 15 } );
+
+        const Heroes * hero = row.castle->GetHero();
+        const Captain & captain = row.castle->GetCaptain();
+
+        std::vector<int32_t> rowState{ static_cast<int32_t>( row.castle->getConstructedBuildings() ),
+                                       static_cast<int32_t>( Castle::GetAllBuildingStatus( *row.castle ) ) };
+
+        for ( const uint32_t dwelling : { DWELLING_MONSTER1, DWELLING_MONSTER2, DWELLING_MONSTER3, DWELLING_MONSTER4, DWELLING_MONSTER5, DWELLING_MONSTER6 } ) {
+            rowState.push_back( static_cast<int32_t>( row.castle->getMonstersInDwelling( dwelling ) ) );
+        }
+
+        appendArmyState( row.castle->GetArmy(), rowState );
+
+        if ( hero ) {
+            appendHeroState( *hero, rowState );
+        }
+        else if ( captain.isValid() ) {
+            appendCommanderState( captain, rowState );
+        }
+
+        rowState.push_back( row.heroArmyBar ? 1 : 0 );
+
+        if ( row.garrisonArmyBar ) {
+            appendSelectionState( *row.garrisonArmyBar, rowState );
+        }
+
+        if ( row.heroArmyBar ) {
+            appendSelectionState( *row.heroArmyBar, rowState );
+        }
+
         fheroes2::Display & display = fheroes2::Display::instance();
 
+        const fheroes2::Rect rowArea = getRowArea( dstx, dsty );
+        RowImageCache & rowCache = _rowImageCache[row.castle];
+
+        if ( restoreRowFromCache( rowCache, rowState, rowArea, display ) ) {
+            return;
+        }
+
         fheroes2::Blit( fheroes2::AGG::GetICN( ICN::OVERVIEW, 11 ), display, dstx, dsty );
 
         // base info
         Interface::redrawCastleIcon( *row.castle, dstx + 17, dsty + 19 );
 
-        const Heroes * hero = row.castle->GetHero();
-
         if ( hero ) {
             Interface::redrawHeroesIcon( *hero, dstx + 82, dsty + 19 );
             const std::string sep = "-";
@@ -633,8 +786,7 @@ namespace
                                        fheroes2::FontType::smallWhite() );
             text.draw( dstx + 104 - text.width() / 2, dsty + 45, display );
         }
-        else if ( row.castle->GetCaptain().isValid() ) {
-            const Captain & captain = row.castle->GetCaptain();
+        else if ( captain.isValid() ) {
             captain.PortraitRedraw( dstx + 82, dsty + 19, PORT_SMALL, display );
             const std::string sep = "-";
 
@@ -649,17 +801,16 @@ namespace
 
         // army info
         if ( row.garrisonArmyBar ) {
-            row.garrisonArmyBar->setRenderingOffset( { dstx + 146, row.heroArmyBar ? dsty : dsty + 20 } );
             row.garrisonArmyBar->Redraw( display );
         }
 
         if ( row.heroArmyBar ) {
-            row.heroArmyBar->setRenderingOffset( { dstx + 146, row.garrisonArmyBar ? dsty + 41 : dsty + 20 } );
             row.heroArmyBar->Redraw( display );
         }
 
-        row.dwellingsBar->setRenderingOffset( { dstx + 349, dsty + 15 } );
         row.dwellingsBar->Redraw( display );
+
+        storeRowInCache( rowCache, std::move( rowState ), rowArea, display );
     }
 
     void StatsCastlesList::RedrawBackground( const fheroes2::Point & dst )
@@ -26,7 +26,9 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <optional>
 #include <utility>
+#include <vector>
 
 #include "agg_image.h"
 #include "castle.h"
@@ -44,7 +46,9 @@
 #include "localevent.h"
 #include "maps_tiles.h"
 #include "maps_tiles_helper.h"
+#include "logging.h"
 #include "mp2.h"
+#include "rand.h"
 #include "render_processor.h"
 #include "resource.h"
 #include "screen.h"
@@ -186,75 +190,199 @@ namespace
         }
     }
 
-    struct CacheForMapWithResources
+    // Returns a hash of everything what affects the rendering of the given block of tiles on the world map.
+    uint64_t getBlockRenderingHash( const int32_t blockX, const int32_t blockY, const int32_t blockSize )
     {
-        std::vector<fheroes2::Image> cachedImages; // One image per zoom Level
+        // Objects bigger than a tile (like monsters or boats) and fog borders of the neighbouring tiles are rendered on the block as well.
+        const int32_t margin = 2;
 
-        CacheForMapWithResources() = delete;
+        const int32_t minX = std::max( blockX - margin, 0 );
+        const int32_t minY = std::max( blockY - margin, 0 );
+        const int32_t maxX = std::min( blockX + blockSize + margin, world.w() );
+        const int32_t maxY = std::min( blockY + blockSize + margin, world.h() );
 
-        // Compute complete world map, and save it for all zoom levels
-        explicit CacheForMapWithResources( const ViewWorldMode viewMode, Interface::GameArea & gameArea, const size_t zoomLevels )
-        {
-            cachedImages.resize( zoomLevels );
+        uint64_t hash = 0;
 
-            for ( size_t i = 0; i < zoomLevels; ++i ) {
-                cachedImages[i]._disableTransformLayer();
-                cachedImages[i].resize( world.w() * tileSizePerZoomLevel[i], world.h() * tileSizePerZoomLevel[i] );
+        const auto combineObjectPart = [&hash]( const Maps::ObjectPart & part ) {
+            Rand::combineSeedWithValueHash( hash, part._uid );
+            Rand::combineSeedWithValueHash( hash, part.layerType );
+            Rand::combineSeedWithValueHash( hash, part.icnType );
+            Rand::combineSeedWithValueHash( hash, part.icnIndex );
+        };
+
+        for ( int32_t posY = minY; posY < maxY; ++posY ) {
+            for ( int32_t posX = minX; posX < maxX; ++posX ) {
+                const Maps::Tile & tile = world.getTile( posX, posY );
+                const Maps::TileScanData scanData = tile.getScanData();
+
+                Rand::combineSeedWithValueHash( hash, tile.getTerrainImageIndex() );
+                Rand::combineSeedWithValueHash( hash, tile.getTerrainFlags() );
+                Rand::combineSeedWithValueHash( hash, tile.isRoad() );
+                Rand::combineSeedWithValueHash( hash, tile.getMainObjectType( false ) );
+                Rand::combineSeedWithValueHash( hash, scanData.mainObjectType );
+                Rand::combineSeedWithValueHash( hash, scanData.fogColors );
+                Rand::combineSeedWithValueHash( hash, scanData.occupantHeroId );
+                Rand::combineSeedWithValueHash( hash, tile.getFogDirection() );
+                Rand::combineSeedWithValueHash( hash, tile.getBoatOwnerColor() );
+
+                for ( const uint32_t value : tile.metadata() ) {
+                    Rand::combineSeedWithValueHash( hash, value );
+                }
+
+                combineObjectPart( tile.getMainObjectPart() );
+
+                for ( const Maps::ObjectPart & part : tile.getGroundObjectParts() ) {
+                    combineObjectPart( part );
+                }
+
+                for ( const Maps::ObjectPart & part : tile.getTopObjectParts() ) {
+                    combineObjectPart( part );
+                }
             }
+        }
 
-            const int32_t blockSizeX = 18;
-            const int32_t blockSizeY = 18;
+        return hash;
+    }
 
-            const int32_t worldWidth = world.w();
-            const int32_t worldHeight = world.h();
+    // World map images for all zoom levels without object icons. The images are kept between the openings of the View World window
+    // and only the blocks of tiles whose rendering state has changed since the previous opening are rendered again.
+    class WorldMapImages
+    {
+    public:
+        const std::vector<fheroes2::Image> & update( const ViewWorldMode viewMode, Interface::GameArea & gameArea, const size_t zoomLevels, const bool isEditor );
 
-            // Assert will fail in case we add non-standard map sizes, otherwise standard map sizes are multiples of 18 tiles
-            assert( worldWidth % blockSizeX == 0 );
-            assert( worldHeight % blockSizeY == 0 );
+    private:
+        std::vector<fheroes2::Image> _images;
 
-            const int32_t redrawAreaWidth = blockSizeX * fheroes2::tileWidthPx;
-            const int32_t redrawAreaHeight = blockSizeY * fheroes2::tileWidthPx;
-            const int32_t redrawAreaCenterX = blockSizeX * fheroes2::tileWidthPx / 2;
-            const int32_t redrawAreaCenterY = blockSizeY * fheroes2::tileWidthPx / 2;
+        // Rendering hash for every block of tiles, blocks are stored row by row.
+        std::vector<uint64_t> _blockHashes;
 
-            // Create temporary image where we will draw blocks of the main map on
-            fheroes2::Image temporaryImg;
-            temporaryImg._disableTransformLayer();
-            temporaryImg.resize( redrawAreaWidth, redrawAreaHeight );
+        // Parameters of the rendering. The images are rendered from scratch if any of them is changed.
+        int32_t _worldWidth{ 0 };
+        int32_t _worldHeight{ 0 };
+        int32_t _drawingFlags{ 0 };
+        bool _isEditor{ false };
+        bool _isDeveloperMode{ false };
+    };
 
-            // Remember the original game area ROI and center of the view.
-            const fheroes2::Rect gameAreaRoi( gameArea.GetROI() );
-            const fheroes2::Point gameAreaCenter( gameArea.getCurrentCenterInPixels() );
+    const std::vector<fheroes2::Image> & WorldMapImages::update( const ViewWorldMode viewMode, Interface::GameArea & gameArea, const size_t zoomLevels,
+                                                                 const bool isEditor )
+    {
+        const int32_t blockSizeX = 18;
+        const int32_t blockSizeY = 18;
 
-            gameArea.SetAreaPosition( 0, 0, redrawAreaWidth, redrawAreaHeight );
-            int32_t drawingFlags = Interface::RedrawLevelType::LEVEL_ALL & ~Interface::RedrawLevelType::LEVEL_ROUTES;
-            if ( viewMode == ViewWorldMode::ViewAll ) {
-                drawingFlags &= ~Interface::RedrawLevelType::LEVEL_FOG;
-            }
-            else if ( viewMode == ViewWorldMode::ViewTowns ) {
-                drawingFlags |= Interface::RedrawLevelType::LEVEL_TOWNS;
-            }
+        const int32_t worldWidth = world.w();
+        const int32_t worldHeight = world.h();
+
+        // Assert will fail in case we add non-standard map sizes, otherwise standard map sizes are multiples of 18 tiles
+        assert( worldWidth % blockSizeX == 0 );
+        assert( worldHeight % blockSizeY == 0 );
+
+        int32_t drawingFlags = Interface::RedrawLevelType::LEVEL_ALL & ~Interface::RedrawLevelType::LEVEL_ROUTES;
+        if ( viewMode == ViewWorldMode::ViewAll ) {
+            drawingFlags &= ~Interface::RedrawLevelType::LEVEL_FOG;
+        }
+        else if ( viewMode == ViewWorldMode::ViewTowns ) {
+            drawingFlags |= Interface::RedrawLevelType::LEVEL_TOWNS;
+        }
 
 #if !defined( SAVE_WORLD_MAP )
-            drawingFlags ^= Interface::RedrawLevelType::LEVEL_HEROES;
+        drawingFlags ^= Interface::RedrawLevelType::LEVEL_HEROES;
 #endif
 
-            // Draw sub-blocks of the main map, and resize them to draw them on lower-res cached versions:
-            for ( int32_t x = 0; x < worldWidth; x += blockSizeX ) {
-                for ( int32_t y = 0; y < worldHeight; y += blockSizeY ) {
-                    gameArea.SetCenterInPixels( { x * fheroes2::tileWidthPx + redrawAreaCenterX, y * fheroes2::tileWidthPx + redrawAreaCenterY } );
-                    gameArea.Redraw( temporaryImg, drawingFlags );
+        const bool isDeveloperMode = IS_DEVEL();
 
-                    for ( size_t i = 0; i < zoomLevels; ++i ) {
-                        fheroes2::Resize( temporaryImg, 0, 0, temporaryImg.width(), temporaryImg.height(), cachedImages[i], x * tileSizePerZoomLevel[i],
-                                          y * tileSizePerZoomLevel[i], blockSizeX * tileSizePerZoomLevel[i], blockSizeY * tileSizePerZoomLevel[i] );
-                    }
+        const size_t blockCount = static_cast<size_t>( worldWidth / blockSizeX ) * static_cast<size_t>( worldHeight / blockSizeY );
+
+        if ( _images.size() != zoomLevels || _worldWidth != worldWidth || _worldHeight != worldHeight || _drawingFlags != drawingFlags || _isEditor != isEditor
+             || _isDeveloperMode != isDeveloperMode ) {
+            _images.clear();
+            _images.resize( zoomLevels );
+
+            for ( size_t i = 0; i < zoomLevels; ++i ) {
+                _images[i]._disableTransformLayer();
+                _images[i].resize( worldWidth * tileSizePerZoomLevel[i], worldHeight * tileSizePerZoomLevel[i] );
+            }
+
+            _blockHashes.clear();
+
+            _worldWidth = worldWidth;
+            _worldHeight = worldHeight;
+            _drawingFlags = drawingFlags;
+            _isEditor = isEditor;
+            _isDeveloperMode = isDeveloperMode;
+        }
+
+        // The hashes of the blocks which are not rendered yet are never going to match.
+        std::vector<std::optional<uint64_t>> previousBlockHashes( blockCount );
+        for ( size_t i = 0; i < _blockHashes.size(); ++i ) {
+            previousBlockHashes[i] = _blockHashes[i];
+        }
+
+        _blockHashes.resize( blockCount );
+
+        const int32_t redrawAreaWidth = blockSizeX * fheroes2::tileWidthPx;
+        const int32_t redrawAreaHeight = blockSizeY * fheroes2::tileWidthPx;
+        const int32_t redrawAreaCenterX = blockSizeX * fheroes2::tileWidthPx / 2;
+        const int32_t redrawAreaCenterY = blockSizeY * fheroes2::tileWidthPx / 2;
+
+        // Create temporary image where we will draw blocks of the main map on
+        fheroes2::Image temporaryImg;
+        temporaryImg._disableTransformLayer();
+        temporaryImg.resize( redrawAreaWidth, redrawAreaHeight );
+
+        // Remember the original game area ROI and center of the view.
+        const fheroes2::Rect gameAreaRoi( gameArea.GetROI() );
+        const fheroes2::Point gameAreaCenter( gameArea.getCurrentCenterInPixels() );
+
+        gameArea.SetAreaPosition( 0, 0, redrawAreaWidth, redrawAreaHeight );
+
+        size_t renderedBlocks = 0;
+
+        // Draw sub-blocks of the main map, and resize them to draw them on lower-res cached versions:
+        for ( int32_t x = 0; x < worldWidth; x += blockSizeX ) {
+            for ( int32_t y = 0; y < worldHeight; y += blockSizeY ) {
+                const size_t blockId = static_cast<size_t>( y / blockSizeY ) * static_cast<size_t>( worldWidth / blockSizeX ) + static_cast<size_t>( x / blockSizeX );
+
+                _blockHashes[blockId] = getBlockRenderingHash( x, y, blockSizeX );
+                if ( previousBlockHashes[blockId] == _blockHashes[blockId] ) {
+                    continue;
+                }
+
+                gameArea.SetCenterInPixels( { x * fheroes2::tileWidthPx + redrawAreaCenterX, y * fheroes2::tileWidthPx + redrawAreaCenterY } );
+                gameArea.Redraw( temporaryImg, drawingFlags );
+
+                for ( size_t i = 0; i < zoomLevels; ++i ) {
+                    fheroes2::Resize( temporaryImg, 0, 0, temporaryImg.width(), temporaryImg.height(), _images[i], x * tileSizePerZoomLevel[i],
+                                      y * tileSizePerZoomLevel[i], blockSizeX * tileSizePerZoomLevel[i], blockSizeY * tileSizePerZoomLevel[i] );
                 }
+
+                ++renderedBlocks;
             }
+        }
+
+        // Restore the original game area ROI and center of the view.
+        gameArea.SetAreaPosition( gameAreaRoi.x, gameAreaRoi.y, gameAreaRoi.width, gameAreaRoi.height );
+        gameArea.SetCenterInPixels( gameAreaCenter );
+
+        DEBUG_LOG( DBG_GAME, DBG_TRACE, "Rendered " << renderedBlocks << " of " << blockCount << " world map blocks." )
 
-            // Restore the original game area ROI and center of the view.
-            gameArea.SetAreaPosition( gameAreaRoi.x, gameAreaRoi.y, gameAreaRoi.width, gameAreaRoi.height );
-            gameArea.SetCenterInPixels( gameAreaCenter );
+        return _images;
+    }
+
+    struct CacheForMapWithResources
+    {
+        std::vector<fheroes2::Image> cachedImages; // One image per zoom Level
+
+        CacheForMapWithResources() = delete;
+
+        // Get complete world map for all zoom levels
+        explicit CacheForMapWithResources( const ViewWorldMode viewMode, Interface::GameArea & gameArea, const size_t zoomLevels, const bool isEditor )
+        {
+            static WorldMapImages worldMapImages;
+
+            // Object icons are drawn over the copies of the world map images.
+            cachedImages = worldMapImages.update( viewMode, gameArea, zoomLevels, isEditor );
 
 #if defined( SAVE_WORLD_MAP )
             fheroes2::Save( cachedImages[3], Settings::Get().getCurrentMapInfo().name + saveFilePrefix + ".bmp" );
@@ -479,6 +607,20 @@ namespace
         }
     }
 
+    // Returns the list of ICNs used to render the World View in the given mode at any zoom level.
+    std::vector<int> getIcnManifest( const ViewWorldMode mode, const bool evil )
+    {
+        std::vector<int> icnIds{ GetSpriteResource( mode, evil ), evil ? ICN::LGNDXTRE : ICN::LGNDXTRA, evil ? ICN::STONBAKE : ICN::STONBACK };
+
+        for ( size_t zoomLevelId = 0; zoomLevelId < totalZoomLevels; ++zoomLevelId ) {
+            icnIds.emplace_back( icnPerZoomLevel[zoomLevelId] );
+            icnIds.emplace_back( icnLetterPerZoomLevel[zoomLevelId] );
+            icnIds.emplace_back( icnPerZoomLevelFlags[zoomLevelId] );
+        }
+
+        return icnIds;
+    }
+
     void drawViewWorldSprite( const fheroes2::Sprite & viewWorldSprite, fheroes2::Display & display, const bool isEvilInterface )
     {
         const int32_t dstX = display.width() - viewWorldSprite.width() - fheroes2::borderWidthPx;
@@ -607,6 +749,9 @@ void ViewWorld::ViewWorldWindow( const PlayerColor color, const ViewWorldMode mo
         fadeRoi.height -= 2 * fheroes2::borderWidthPx;
     }
 
+    // Decode the World View images while the Adventure map screen fades out.
+    fheroes2::AGG::prefetchICNs( getIcnManifest( mode, isEvilInterface ) );
+
     // Fade-out Adventure map screen.
     fheroes2::fadeOutDisplay( fadeRoi, false );
 
@@ -649,7 +794,7 @@ void ViewWorld::ViewWorldWindow( const PlayerColor color, const ViewWorldMode mo
 
     ZoomROIs currentROI( zoomLevel, viewCenterInPixels, visibleScreenInPixels, zoomLevels );
 
-    CacheForMapWithResources cache( mode, gameArea, zoomLevels );
+    CacheForMapWithResources cache( mode, gameArea, zoomLevels, interface.isEditor() );
 
     if ( !interface.isEditor() ) {
         DrawObjectsIcons( color, mode, cache );
@@ -167,6 +167,11 @@ const char * Maps::Ground::String( const int32_t groundId )
 }
 
 uint32_t Maps::Ground::GetPenalty( const Maps::Tile & tile, const uint32_t pathfindingLevel )
+{
+    return GetPenalty( tile.GetGround(), pathfindingLevel );
+}
+
+uint32_t Maps::Ground::GetPenalty( const int32_t groundId, const uint32_t pathfindingLevel )
 {
     //              none   basc   advd   expr
     //    Desert    2.00   1.75   1.50   1.00
@@ -182,7 +187,7 @@ uint32_t Maps::Ground::GetPenalty( const Maps::Tile & tile, const uint32_t pathf
 
     uint32_t result = defaultGroundPenalty;
 
-    switch ( tile.GetGround() ) {
+    switch ( groundId ) {
     case DESERT:
         switch ( pathfindingLevel ) {
         case Skill::Level::EXPERT:
@@ -77,6 +77,7 @@ namespace Maps
 
         const char * String( const int32_t groundId );
         uint32_t GetPenalty( const Maps::Tile & tile, const uint32_t pathfindingLevel );
+        uint32_t GetPenalty( const int32_t groundId, const uint32_t pathfindingLevel );
 
         // Returns the random ground image index (used in GROUND32.TIL) for main (without transition) terrain layout.
         uint16_t getRandomTerrainImageIndex( const int32_t groundId, const bool allowEmbeddedObjectsAppearOnTerrain );
@@ -1294,6 +1294,121 @@ namespace Maps
         updateTerrainTransitionOnAreaBoundaries( map, groundId, startX, endX, startY, endY );
     }
 
+    void fillTerrainWithTransition( Map_Format::MapFormat & map, const int32_t tileId, const int groundId )
+    {
+        assert( map.width == world.w() && map.width == world.h() );
+
+        if ( tileId < 0 || tileId >= static_cast<int32_t>( map.tiles.size() ) ) {
+            return;
+        }
+
+        const int areaGroundId = Ground::getGroundByImageIndex( map.tiles[tileId].terrainIndex );
+        if ( areaGroundId == groundId ) {
+            // Nothing to fill.
+            return;
+        }
+
+        const int32_t mapWidth = map.width;
+        const int32_t mapHeight = map.width;
+
+        enum TileState : uint8_t
+        {
+            UNCHECKED,
+            FILLED,
+            BOUNDARY
+        };
+
+        std::vector<uint8_t> tileStates( map.tiles.size(), TileState::UNCHECKED );
+        std::vector<int32_t> filledTiles;
+        std::vector<int32_t> tilesToCheck{ tileId };
+
+        tileStates[tileId] = TileState::FILLED;
+
+        const auto checkTile = [&map, &tileStates, &tilesToCheck, areaGroundId]( const int32_t index ) {
+            if ( tileStates[index] == TileState::UNCHECKED && Ground::getGroundByImageIndex( map.tiles[index].terrainIndex ) == areaGroundId ) {
+                tileStates[index] = TileState::FILLED;
+                tilesToCheck.push_back( index );
+            }
+        };
+
+        // Find all tiles of the area before changing any of them.
+        while ( !tilesToCheck.empty() ) {
+            const int32_t index = tilesToCheck.back();
+            tilesToCheck.pop_back();
+
+            filledTiles.push_back( index );
+
+            const int32_t x = index % mapWidth;
+            const int32_t y = index / mapWidth;
+
+            if ( x > 0 ) {
+                checkTile( index - 1 );
+            }
+            if ( x < mapWidth - 1 ) {
+                checkTile( index + 1 );
+            }
+            if ( y > 0 ) {
+                checkTile( index - mapWidth );
+            }
+            if ( y < mapHeight - 1 ) {
+                checkTile( index + mapWidth );
+            }
+        }
+
+        // Process the tiles in the same order as a rectangular fill does.
+        std::sort( filledTiles.begin(), filledTiles.end() );
+
+        std::vector<int32_t> innerBoundaryTiles;
+        std::vector<int32_t> outerBoundaryTiles;
+
+        for ( const int32_t index : filledTiles ) {
+            // In original editor these tiles are never flipped.
+            setTerrain( map, index, Ground::getRandomTerrainImageIndex( groundId, true ), false, false );
+
+            const int32_t x = index % mapWidth;
+            const int32_t y = index / mapWidth;
+
+            bool isBoundary = false;
+
+            for ( int32_t offsetY = -1; offsetY <= 1; ++offsetY ) {
+                for ( int32_t offsetX = -1; offsetX <= 1; ++offsetX ) {
+                    const int32_t aroundX = x + offsetX;
+                    const int32_t aroundY = y + offsetY;
+                    if ( aroundX < 0 || aroundY < 0 || aroundX >= mapWidth || aroundY >= mapHeight ) {
+                        continue;
+                    }
+
+                    const int32_t aroundIndex = aroundY * mapWidth + aroundX;
+                    if ( tileStates[aroundIndex] == TileState::FILLED ) {
+                        continue;
+                    }
+
+                    isBoundary = true;
+
+                    if ( tileStates[aroundIndex] == TileState::UNCHECKED ) {
+                        tileStates[aroundIndex] = TileState::BOUNDARY;
+                        outerBoundaryTiles.push_back( aroundIndex );
+                    }
+                }
+            }
+
+            if ( isBoundary ) {
+                innerBoundaryTiles.push_back( index );
+            }
+        }
+
+        std::sort( outerBoundaryTiles.begin(), outerBoundaryTiles.end() );
+
+        // Set ground transitions only on the boundaries of filled terrain area: first inside of it and then outside.
+        for ( const int32_t index : innerBoundaryTiles ) {
+            updateTerrainTransitionOnArea( map, groundId, index, index, 1 );
+        }
+
+        for ( const int32_t index : outerBoundaryTiles ) {
+            updateTerrainTransitionOnArea( map, groundId, index, index, 1 );
+        }
+    }
+
     void addObjectToMap( Map_Format::MapFormat & map, const int32_t tileId, const ObjectGroup group, const uint32_t index )
     {
         assert( tileId >= 0 && map.tiles.size() > static_cast<size_t>( tileId ) );
@@ -1540,7 +1655,7 @@ namespace Maps
         }
     }
 
-    bool updateMapPlayers( Map_Format::MapFormat & map )
+    bool getMapPlayerRaces( const Map_Format::MapFormat & map, MapPlayerRaces & races )
     {
         static_assert( PlayerColor::BLUE == static_cast<PlayerColor>( 1 << 0 ), "The kingdom color values have changed. You are going to break map format!" );
         static_assert( PlayerColor::GREEN == static_cast<PlayerColor>( 1 << 1 ), "The kingdom color values have changed. You are going to break map format!" );
@@ -1559,20 +1674,12 @@ namespace Maps
         static_assert( Race::MULT == 1 << 6, "The race values have changed. You are going to break map format!" );
         static_assert( Race::RAND == 1 << 7, "The race values have changed. You are going to break map format!" );
 
-        constexpr size_t mainColors{ maxNumOfPlayers };
-
-        if ( map.playerRace.size() != mainColors ) {
-            // Possibly corrupted map.
-            assert( 0 );
-            return false;
-        }
+        static_assert( MapPlayerRaces::colorCount == maxNumOfPlayers, "The number of players has changed. Update the MapPlayerRaces structure!" );
 
         // Gather all information about all kingdom colors and races.
-        std::array<bool, mainColors> heroColorsPresent{ false };
+        std::array<uint8_t, MapPlayerRaces::colorCount> heroRacesPresent{ 0 };
         // Towns can be neutral so 1 more color for them.
-        std::array<bool, mainColors + 1> townColorsPresent{ false };
-        std::array<uint8_t, mainColors> heroRacesPresent{ 0 };
-        std::array<uint8_t, mainColors + 1> townRacesPresent{ 0 };
+        std::array<uint8_t, MapPlayerRaces::colorCount + 1> townRacesPresent{ 0 };
 
         const auto & heroObjects = getObjectsByGroup( ObjectGroup::KINGDOM_HEROES );
         const auto & townObjects = getObjectsByGroup( ObjectGroup::KINGDOM_TOWNS );
@@ -1590,13 +1697,11 @@ namespace Maps
                     const auto & metadata = heroObjects[object.index].metadata;
 
                     const uint32_t color = metadata[0];
-                    if ( color >= heroColorsPresent.size() ) {
+                    if ( color >= heroRacesPresent.size() ) {
                         assert( 0 );
                         return false;
                     }
 
-                    heroColorsPresent[color] = true;
-
                     const uint32_t race = metadata[1];
                     heroRacesPresent[color] |= ( 1 << race );
                 }
@@ -1611,23 +1716,50 @@ namespace Maps
 
                     const uint8_t color = getTownColorIndex( map, tileIndex, object.id );
 
-                    if ( color >= townColorsPresent.size() ) {
+                    if ( color >= townRacesPresent.size() ) {
                         assert( 0 );
                         return false;
                     }
 
-                    townColorsPresent[color] = true;
-
                     const uint32_t race = townObjects[object.index].metadata[0];
                     townRacesPresent[color] |= ( 1 << race );
                 }
             }
         }
 
+        races.heroRaces = heroRacesPresent;
+        races.townRaces = townRacesPresent;
+
+        return true;
+    }
+
+    bool updateMapPlayers( Map_Format::MapFormat & map )
+    {
+        MapPlayerRaces races;
+        if ( !getMapPlayerRaces( map, races ) ) {
+            return false;
+        }
+
+        return updateMapPlayers( map, races );
+    }
+
+    bool updateMapPlayers( Map_Format::MapFormat & map, const MapPlayerRaces & races )
+    {
+        constexpr size_t mainColors{ maxNumOfPlayers };
+
+        if ( map.playerRace.size() != mainColors ) {
+            // Possibly corrupted map.
+            assert( 0 );
+            return false;
+        }
+
+        const auto & heroObjects = getObjectsByGroup( ObjectGroup::KINGDOM_HEROES );
+        const auto & townObjects = getObjectsByGroup( ObjectGroup::KINGDOM_TOWNS );
+
         // Update map format settings based on the gathered information.
         map.availablePlayerColors = 0;
         for ( size_t i = 0; i < mainColors; ++i ) {
-            map.playerRace[i] = ( heroRacesPresent[i] | townRacesPresent[i] );
+            map.playerRace[i] = ( races.heroRaces[i] | races.townRaces[i] );
 
             if ( map.playerRace[i] != 0 ) {
                 map.availablePlayerColors |= static_cast<PlayerColor>( 1 << i );
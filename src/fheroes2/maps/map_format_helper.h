@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <vector>
@@ -53,6 +54,9 @@ namespace Maps
 
     void setTerrainWithTransition( Map_Format::MapFormat & map, const int32_t startTileId, const int32_t endTileId, const int groundId );
 
+    // Fills the area of the same ground connected to the given tile with the new ground. Terrain transitions are updated only along the area boundaries.
+    void fillTerrainWithTransition( Map_Format::MapFormat & map, const int32_t tileId, const int groundId );
+
     // Does not set or correct terrain transitions
     void setTerrainOnTile( Map_Format::MapFormat & map, const int32_t tileId, const int groundId );
 
@@ -74,8 +78,24 @@ namespace Maps
     // This function updates Castles, Towns, Heroes and Capturable objects using their metadata stored in map.
     void updatePlayerRelatedObjects( const Maps::Map_Format::MapFormat & map );
 
+    // Races of player heroes and towns present on the map, stored as bit masks of races for every player color.
+    struct MapPlayerRaces
+    {
+        static constexpr size_t colorCount{ 6 };
+
+        std::array<uint8_t, colorCount> heroRaces{ 0 };
+        // Towns can be neutral so 1 more color for them.
+        std::array<uint8_t, colorCount + 1> townRaces{ 0 };
+    };
+
+    // Gathers races of all heroes and towns on the map. The map is not modified so this function can be called for a copy of the map from any thread.
+    bool getMapPlayerRaces( const Map_Format::MapFormat & map, MapPlayerRaces & races );
+
     bool updateMapPlayers( Map_Format::MapFormat & map );
 
+    // The same as above but using the races previously gathered by getMapPlayerRaces() for the current state of the map.
+    bool updateMapPlayers( Map_Format::MapFormat & map, const MapPlayerRaces & races );
+
     uint8_t getTownColorIndex( const Map_Format::MapFormat & map, const size_t tileIndex, const uint32_t id );
 
     bool isJailObject( const ObjectGroup group, const uint32_t index );
@@ -20,6 +20,7 @@
 
 #include "map_format_info.h"
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <cstddef>
@@ -94,7 +95,23 @@ namespace
     constexpr uint16_t minimumSupportedVersion{ 2 };
 
     // Change the version when there is a need to expand map format functionality.
-    constexpr uint16_t currentSupportedVersion{ 10 };
+    constexpr uint16_t currentSupportedVersion{ 11 };
+
+    // Starting from version 11 the data following the base map information is split into sections which are compressed separately.
+    // The section directory placed in front of the sections allows to skip the data which is not needed without decompressing it.
+    enum class MapSection : uint8_t
+    {
+        ADDITIONAL_INFO,
+        TILES,
+        DAILY_EVENTS,
+        RUMORS,
+        OBJECT_METADATA,
+
+        // Put all new entries above this line.
+        SECTION_COUNT
+    };
+
+    constexpr size_t mapSectionCount{ static_cast<size_t>( MapSection::SECTION_COUNT ) };
 
     void convertFromV2ToV3( Maps::Map_Format::MapFormat & map )
     {
@@ -334,28 +351,130 @@ namespace
             return false;
         }
 
-        RWStreamBuf compressed;
-        compressed.setBigendian( true );
+        std::array<RWStreamBuf, mapSectionCount> sections;
+        for ( RWStreamBuf & section : sections ) {
+            section.setBigendian( true );
+        }
+
+        sections[static_cast<size_t>( MapSection::ADDITIONAL_INFO )] << map.additionalInfo;
+        sections[static_cast<size_t>( MapSection::TILES )] << map.tiles;
+        sections[static_cast<size_t>( MapSection::DAILY_EVENTS )] << map.dailyEvents;
+        sections[static_cast<size_t>( MapSection::RUMORS )] << map.rumors;
+        sections[static_cast<size_t>( MapSection::OBJECT_METADATA )]
+            << map.castleMetadata << map.heroMetadata << map.sphinxMetadata << map.signMetadata << map.adventureMapEventMetadata << map.selectionObjectMetadata
+            << map.capturableObjectsMetadata << map.monsterMetadata << map.artifactMetadata << map.resourceMetadata;
+
+        std::array<RWStreamBuf, mapSectionCount> compressedSections;
+
+        for ( size_t i = 0; i < mapSectionCount; ++i ) {
+            compressedSections[i].setBigendian( true );
 
-        compressed << map.additionalInfo << map.tiles << map.dailyEvents << map.rumors << map.castleMetadata << map.heroMetadata << map.sphinxMetadata << map.signMetadata
-                   << map.adventureMapEventMetadata << map.selectionObjectMetadata << map.capturableObjectsMetadata << map.monsterMetadata << map.artifactMetadata
-                   << map.resourceMetadata;
+            if ( sections[i].fail() || !Compression::zipStreamBuf( sections[i], compressedSections[i] ) ) {
+                return false;
+            }
+        }
 
-        const std::vector<uint8_t> temp = Compression::zipData( compressed.data(), compressed.size() );
+        stream << static_cast<uint8_t>( mapSectionCount );
 
-        stream.putRaw( temp.data(), temp.size() );
+        for ( size_t i = 0; i < mapSectionCount; ++i ) {
+            stream << static_cast<uint8_t>( i ) << static_cast<uint32_t>( compressedSections[i].size() );
+        }
+
+        for ( const RWStreamBuf & section : compressedSections ) {
+            stream.putRaw( section.data(), section.size() );
+        }
 
         return !stream.fail();
     }
 
-    bool loadFromStream( IStreamBase & stream, Maps::Map_Format::MapFormat & map )
+    // If only tiles are requested the rest of the sections are skipped without being decompressed.
+    bool loadSections( IStreamBase & stream, Maps::Map_Format::MapFormat & map, const bool loadTilesOnly )
     {
-        // TODO: verify the correctness of metadata.
-        if ( !loadFromStream( stream, static_cast<Maps::Map_Format::BaseMapFormat &>( map ) ) ) {
-            map = {};
+        uint8_t sectionCount{ 0 };
+        stream >> sectionCount;
+
+        std::vector<std::pair<uint8_t, uint32_t>> sectionDirectory( sectionCount );
+        for ( auto & [type, size] : sectionDirectory ) {
+            stream >> type >> size;
+        }
+
+        if ( stream.fail() ) {
             return false;
         }
 
+        std::array<bool, mapSectionCount> isSectionLoaded{ false };
+
+        // Sections are decompressed one by one so only one of them is kept in memory in its uncompressed form.
+        for ( const auto & [type, size] : sectionDirectory ) {
+            if ( type >= mapSectionCount || isSectionLoaded[type] ) {
+                // This is a corrupted file.
+                return false;
+            }
+
+            if ( loadTilesOnly && static_cast<MapSection>( type ) != MapSection::TILES ) {
+                stream.skip( size );
+                continue;
+            }
+
+            ROStreamBuf compressed( stream.getRaw( size ) );
+            if ( compressed.size() != size ) {
+                return false;
+            }
+
+            compressed.setBigendian( true );
+
+            RWStreamBuf section;
+            section.setBigendian( true );
+
+            if ( !Compression::unzipStream( compressed, section ) ) {
+                return false;
+            }
+
+            switch ( static_cast<MapSection>( type ) ) {
+            case MapSection::ADDITIONAL_INFO:
+                section >> map.additionalInfo;
+                break;
+            case MapSection::TILES:
+                section >> map.tiles;
+
+                if ( map.tiles.size() != static_cast<size_t>( map.width ) * map.width ) {
+                    return false;
+                }
+                break;
+            case MapSection::DAILY_EVENTS:
+                section >> map.dailyEvents;
+                break;
+            case MapSection::RUMORS:
+                section >> map.rumors;
+                break;
+            case MapSection::OBJECT_METADATA:
+                section >> map.castleMetadata >> map.heroMetadata >> map.sphinxMetadata >> map.signMetadata >> map.adventureMapEventMetadata
+                    >> map.selectionObjectMetadata >> map.capturableObjectsMetadata >> map.monsterMetadata >> map.artifactMetadata >> map.resourceMetadata;
+                break;
+            default:
+                assert( 0 );
+                return false;
+            }
+
+            if ( section.fail() ) {
+                return false;
+            }
+
+            isSectionLoaded[type] = true;
+        }
+
+        if ( loadTilesOnly ) {
+            return isSectionLoaded[static_cast<size_t>( MapSection::TILES )];
+        }
+
+        // All sections are mandatory.
+        return std::all_of( isSectionLoaded.begin(), isSectionLoaded.end(), []( const bool isLoaded ) { return isLoaded; } );
+    }
+
+    bool loadNonSectionedData( IStreamBase & stream, Maps::Map_Format::MapFormat & map )
+    {
+        static_assert( minimumSupportedVersion <= 10, "Remove this function." );
+
         RWStreamBuf decompressed;
         decompressed.setBigendian( true );
 
@@ -363,14 +482,12 @@ namespace
             std::vector<uint8_t> temp = stream.getRaw( 0 );
             if ( temp.empty() ) {
                 // This is a corrupted file.
-                map = {};
                 return false;
             }
 
             const std::vector<uint8_t> decompressedData = Compression::unzipData( temp.data(), temp.size() );
             if ( decompressedData.empty() ) {
                 // This is a corrupted file.
-                map = {};
                 return false;
             }
 
@@ -383,7 +500,6 @@ namespace
         decompressed >> map.additionalInfo >> map.tiles;
 
         if ( map.tiles.size() != static_cast<size_t>( map.width ) * map.width ) {
-            map = {};
             return false;
         }
 
@@ -417,6 +533,50 @@ namespace
 
         return !stream.fail();
     }
+
+    bool loadFromStream( IStreamBase & stream, Maps::Map_Format::MapFormat & map, const bool loadTilesOnly )
+    {
+        // TODO: verify the correctness of metadata.
+        if ( !loadFromStream( stream, static_cast<Maps::Map_Format::BaseMapFormat &>( map ) ) ) {
+            map = {};
+            return false;
+        }
+
+        // Maps of older versions have no sections so they are always loaded fully.
+        const bool isLoaded = ( map.version > 10 ) ? loadSections( stream, map, loadTilesOnly ) : loadNonSectionedData( stream, map );
+        if ( !isLoaded ) {
+            map = {};
+            return false;
+        }
+
+        return true;
+    }
+
+    bool openMapFile( const std::string & path, StreamFile & fileStream )
+    {
+        if ( path.empty() ) {
+            return false;
+        }
+
+        fileStream.setBigendian( true );
+
+        if ( !fileStream.open( path, "rb" ) ) {
+            return false;
+        }
+
+        const size_t fileSize = fileStream.size();
+        if ( fileSize < minFileSize ) {
+            return false;
+        }
+
+        for ( const uint8_t value : magicWord ) {
+            if ( fileStream.get() != value ) {
+                return false;
+            }
+        }
+
+        return true;
+    }
 }
 
 namespace Maps::Map_Format
@@ -572,56 +732,32 @@ namespace Maps::Map_Format
 
     bool loadBaseMap( const std::string & path, BaseMapFormat & map )
     {
-        if ( path.empty() ) {
-            return false;
-        }
-
         StreamFile fileStream;
-        fileStream.setBigendian( true );
-
-        if ( !fileStream.open( path, "rb" ) ) {
-            return false;
-        }
-
-        const size_t fileSize = fileStream.size();
-        if ( fileSize < minFileSize ) {
+        if ( !openMapFile( path, fileStream ) ) {
             return false;
         }
 
-        for ( const uint8_t value : magicWord ) {
-            if ( fileStream.get() != value ) {
-                return false;
-            }
-        }
-
         return loadFromStream( fileStream, map );
     }
 
     bool loadMap( const std::string & path, MapFormat & map )
     {
-        if ( path.empty() ) {
-            return false;
-        }
-
         StreamFile fileStream;
-        fileStream.setBigendian( true );
-
-        if ( !fileStream.open( path, "rb" ) ) {
+        if ( !openMapFile( path, fileStream ) ) {
             return false;
         }
 
-        const size_t fileSize = fileStream.size();
-        if ( fileSize < minFileSize ) {
-            return false;
-        }
+        return loadFromStream( fileStream, map, false );
+    }
 
-        for ( const uint8_t value : magicWord ) {
-            if ( fileStream.get() != value ) {
-                return false;
-            }
+    bool loadMapTiles( const std::string & path, MapFormat & map )
+    {
+        StreamFile fileStream;
+        if ( !openMapFile( path, fileStream ) ) {
+            return false;
         }
 
-        return loadFromStream( fileStream, map );
+        return loadFromStream( fileStream, map, true );
     }
 
     bool saveMap( const std::string & path, const MapFormat & map )
@@ -651,6 +787,33 @@ namespace Maps::Map_Format
 
     bool loadMap( IStreamBase & stream, MapFormat & map )
     {
-        return loadFromStream( stream, map );
+        return loadFromStream( stream, map, false );
+    }
+
+    bool saveMapWithoutTiles( OStreamBase & stream, const MapFormat & map )
+    {
+        if ( !saveToStream( stream, static_cast<const BaseMapFormat &>( map ) ) ) {
+            return false;
+        }
+
+        stream << map.additionalInfo << map.dailyEvents << map.rumors << map.castleMetadata << map.heroMetadata << map.sphinxMetadata << map.signMetadata
+               << map.adventureMapEventMetadata << map.selectionObjectMetadata << map.capturableObjectsMetadata << map.monsterMetadata << map.artifactMetadata
+               << map.resourceMetadata;
+
+        return !stream.fail();
+    }
+
+    bool loadMapWithoutTiles( IStreamBase & stream, MapFormat & map )
+    {
+        // The data is always saved in the current format, so no conversion is needed.
+        if ( !loadFromStream( stream, static_cast<BaseMapFormat &>( map ) ) || map.version != currentSupportedVersion ) {
+            return false;
+        }
+
+        stream >> map.additionalInfo >> map.dailyEvents >> map.rumors >> map.castleMetadata >> map.heroMetadata >> map.sphinxMetadata >> map.signMetadata
+            >> map.adventureMapEventMetadata >> map.selectionObjectMetadata >> map.capturableObjectsMetadata >> map.monsterMetadata >> map.artifactMetadata
+            >> map.resourceMetadata;
+
+        return !stream.fail();
     }
 }
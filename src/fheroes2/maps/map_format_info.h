@@ -46,6 +46,11 @@ namespace Maps::Map_Format
         ObjectGroup group{ ObjectGroup::NONE };
 
         uint32_t index{ 0 };
+
+        bool operator==( const TileObjectInfo & other ) const
+        {
+            return id == other.id && group == other.group && index == other.index;
+        }
     };
 
     struct TileInfo
@@ -54,6 +59,16 @@ namespace Maps::Map_Format
         uint8_t terrainFlags{ 0 };
 
         std::vector<TileObjectInfo> objects;
+
+        bool operator==( const TileInfo & other ) const
+        {
+            return terrainIndex == other.terrainIndex && terrainFlags == other.terrainFlags && objects == other.objects;
+        }
+
+        bool operator!=( const TileInfo & other ) const
+        {
+            return !( *this == other );
+        }
     };
 
     constexpr size_t messageCharLimit{ 999 };
@@ -388,8 +403,15 @@ namespace Maps::Map_Format
     bool loadBaseMap( const std::string & path, BaseMapFormat & map );
     bool loadMap( const std::string & path, MapFormat & map );
 
+    // Loads the base map information and tiles only. The rest of map data is skipped if the map format allows it.
+    bool loadMapTiles( const std::string & path, MapFormat & map );
+
     bool saveMap( const std::string & path, const MapFormat & map );
 
     bool saveMap( OStreamBase & stream, const MapFormat & map );
     bool loadMap( IStreamBase & stream, MapFormat & map );
+
+    // Save and load all the map data except tiles without compression. These functions are meant to track changes of the map within the Editor.
+    bool saveMapWithoutTiles( OStreamBase & stream, const MapFormat & map );
+    bool loadMapWithoutTiles( IStreamBase & stream, MapFormat & map );
 }
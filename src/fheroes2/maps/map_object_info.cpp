@@ -26,6 +26,7 @@
 #include <cstddef>
 #include <initializer_list>
 #include <map>
+#include <mutex>
 #include <set>
 #include <utility>
 
@@ -41,9 +42,12 @@ namespace
     // the fheroes2 Editor requires to have resources from the expansion.
     std::array<std::vector<Maps::ObjectInfo>, static_cast<size_t>( Maps::ObjectGroup::GROUP_COUNT )> objectData;
 
-    // This map is used for searching object parts based on their ICN information.
+    using IcnKey = std::pair<MP2::ObjectIcnType, uint32_t>;
+
+    // This container is used for searching object parts based on their ICN information.
     // Since we have a lot of objects it is important to speed up the search even if we take several more KB of memory.
-    std::map<std::pair<MP2::ObjectIcnType, uint32_t>, const Maps::ObjectPartInfo *> objectInfoByIcn;
+    // The container is sorted by ICN information once all objects are populated, so a binary search over a contiguous memory block is used instead of a tree.
+    std::vector<std::pair<IcnKey, const Maps::ObjectPartInfo *>> objectInfoByIcn;
 
     void populateRoads( std::vector<Maps::ObjectInfo> & objects )
     {
@@ -4909,14 +4913,8 @@ namespace
         }
     }
 
-    void populateObjectData()
+    void fillObjectData()
     {
-        static bool isPopulated = false;
-        if ( isPopulated ) {
-            // The object container has been populated. No need to do anything else.
-            return;
-        }
-
         // IMPORTANT!!!
         // The order of objects must be preserved. If you want to add a new object, add it to the end of the corresponding container.
         populateRoads( objectData[static_cast<size_t>( Maps::ObjectGroup::ROADS )] );
@@ -4947,20 +4945,40 @@ namespace
 
         populateExtraBoatDirections( objectData[static_cast<size_t>( Maps::ObjectGroup::MAP_EXTRAS )] );
 
+        // All containers are filled by appending elements so they usually have some unused capacity. Release it before taking pointers to the object parts.
+        size_t partCount = 0;
+
+        for ( auto & objects : objectData ) {
+            objects.shrink_to_fit();
+
+            for ( auto & objectInfo : objects ) {
+                objectInfo.groundLevelParts.shrink_to_fit();
+                objectInfo.topLevelParts.shrink_to_fit();
+
+                partCount += objectInfo.groundLevelParts.size() + objectInfo.topLevelParts.size();
+            }
+        }
+
+        objectInfoByIcn.reserve( partCount );
+
         for ( const auto & objects : objectData ) {
             for ( const auto & objectInfo : objects ) {
-                // We accept that there could be duplicates so we don't check if the insertion is successful for the map.
-
                 for ( const auto & info : objectInfo.groundLevelParts ) {
-                    objectInfoByIcn.try_emplace( std::make_pair( info.icnType, info.icnIndex ), &info );
+                    objectInfoByIcn.emplace_back( std::make_pair( info.icnType, info.icnIndex ), &info );
                 }
 
                 for ( const auto & info : objectInfo.topLevelParts ) {
-                    objectInfoByIcn.try_emplace( std::make_pair( info.icnType, info.icnIndex ), &info );
+                    objectInfoByIcn.emplace_back( std::make_pair( info.icnType, info.icnIndex ), &info );
                 }
             }
         }
 
+        // We accept that there could be duplicates. In this case the first added object part is used, so the sorting must be stable.
+        std::stable_sort( objectInfoByIcn.begin(), objectInfoByIcn.end(), []( const auto & first, const auto & second ) { return first.first < second.first; } );
+        objectInfoByIcn.erase( std::unique( objectInfoByIcn.begin(), objectInfoByIcn.end(),
+                                            []( const auto & first, const auto & second ) { return first.first == second.first; } ),
+                               objectInfoByIcn.end() );
+
 #if defined( WITH_DEBUG )
         // It is important to check that all data is accurately generated.
         for ( const auto & objects : objectData ) {
@@ -5075,8 +5093,13 @@ namespace
         // size has been added, consider updating the maximum action object dimensions.
         assert( maxObjDim == Maps::maxActionObjectDimensions );
 #endif
+    }
 
-        isPopulated = true;
+    void populateObjectData()
+    {
+        // Object data is read by worker threads as well, so it must be filled exactly once and be visible to all threads afterwards.
+        static std::once_flag populateFlag;
+        std::call_once( populateFlag, fillObjectData );
     }
 }
 
@@ -5107,8 +5130,11 @@ namespace Maps
     {
         populateObjectData();
 
-        auto iter = objectInfoByIcn.find( std::make_pair( icnType, icnIndex ) );
-        if ( iter != objectInfoByIcn.end() ) {
+        const IcnKey key{ icnType, icnIndex };
+
+        const auto iter
+            = std::lower_bound( objectInfoByIcn.begin(), objectInfoByIcn.end(), key, []( const auto & item, const IcnKey & value ) { return item.first < value; } );
+        if ( iter != objectInfoByIcn.end() && iter->first == key ) {
             return iter->second;
         }
 
@@ -616,7 +616,8 @@ namespace Maps::Random_Generator
         return std::max<int32_t>( 0, waterTiles * 100 / tileCount );
     }
 
-    bool generateMap( Map_Format::MapFormat & mapFormat, const Configuration & config, const int32_t width, const int32_t height )
+    bool generateMap( Map_Format::MapFormat & mapFormat, const Configuration & config, const int32_t width, const int32_t height,
+                      const ProgressCallback & progressCallback /* = {} */ )
     {
         // Make sure that we are generating a valid map.
         assert( width > 0 && height > 0 );
@@ -646,6 +647,16 @@ namespace Maps::Random_Generator
 
         MapStateManager mapState( width, height );
 
+        // Returns false if the generation has been cancelled.
+        const auto reportProgress = [&mapFormat, &progressCallback]( const GenerationStep step ) {
+            if ( !progressCallback || progressCallback( step, mapFormat ) ) {
+                return true;
+            }
+
+            DEBUG_LOG( DBG_DEVEL, DBG_INFO, "Map generation has been cancelled after step " << static_cast<int>( step ) )
+            return false;
+        };
+
         auto mapBoundsCheck = [width, height]( int32_t x, int32_t y ) {
             x = std::clamp<int32_t>( x, 0, width - 1 );
             y = std::clamp<int32_t>( y, 0, height - 1 );
@@ -727,6 +738,10 @@ namespace Maps::Random_Generator
             }
         }
 
+        if ( !reportProgress( GenerationStep::REGIONS ) ) {
+            return false;
+        }
+
         // Step 4. Apply terrain changes into the map format.
         for ( const Region & region : mapRegions ) {
             if ( region.id == 0 ) {
@@ -746,6 +761,10 @@ namespace Maps::Random_Generator
             }
         }
 
+        if ( !reportProgress( GenerationStep::TERRAIN ) ) {
+            return false;
+        }
+
         // Step 5. Fix terrain transitions and place Castles
         MapEconomy mapEconomy;
 
@@ -820,6 +839,10 @@ namespace Maps::Random_Generator
 
         Maps::updatePlayerRelatedObjects( mapFormat );
 
+        if ( !reportProgress( GenerationStep::CASTLES ) ) {
+            return false;
+        }
+
         // Step 6. Set up region connectors based on frequency settings and border length.
         for ( Region & region : mapRegions ) {
             if ( region.groundType == Ground::WATER ) {
@@ -838,6 +861,10 @@ namespace Maps::Random_Generator
             }
         }
 
+        if ( !reportProgress( GenerationStep::CONNECTIONS ) ) {
+            return false;
+        }
+
         // Step 7. Place mines.
         for ( const Region & region : mapRegions ) {
             if ( region.groundType == Ground::WATER ) {
@@ -878,6 +905,10 @@ namespace Maps::Random_Generator
             }
         }
 
+        if ( !reportProgress( GenerationStep::MINES ) ) {
+            return false;
+        }
+
         // Step 8: Place power-ups and treasure clusters while avoiding the paths.
         for ( Region & region : mapRegions ) {
             if ( region.groundType == Ground::WATER ) {
@@ -905,6 +936,10 @@ namespace Maps::Random_Generator
             }
         }
 
+        if ( !reportProgress( GenerationStep::TREASURES ) ) {
+            return false;
+        }
+
         // Step 9: Detect and fill empty areas with decorative/flavour objects.
         for ( Region & region : mapRegions ) {
             const auto it = decorationsPerGround.find( region.groundType );
@@ -916,6 +951,10 @@ namespace Maps::Random_Generator
             }
         }
 
+        if ( !reportProgress( GenerationStep::DECORATIONS ) ) {
+            return false;
+        }
+
         // Step 10: Place missing monsters.
         const bool isSmallMap = ( mapFormat.width == Maps::SMALL );
         const auto & weakGuard = getMonstersByValue( config.monsterStrength, isSmallMap ? 3500 : 4500 );
@@ -931,6 +970,10 @@ namespace Maps::Random_Generator
             }
         }
 
+        if ( !reportProgress( GenerationStep::MONSTERS ) ) {
+            return false;
+        }
+
         Maps::updateAllRoads( mapFormat );
         Maps::updatePlayerRelatedObjects( mapFormat );
 
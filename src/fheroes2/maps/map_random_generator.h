@@ -21,6 +21,7 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include <string>
 
 namespace Maps::Map_Format
@@ -68,9 +69,31 @@ namespace Maps::Random_Generator
         MonsterStrength monsterStrength{ MonsterStrength::NORMAL };
     };
 
+    // Steps of map generation in the order of their completion.
+    enum class GenerationStep : uint8_t
+    {
+        REGIONS,
+        TERRAIN,
+        CASTLES,
+        CONNECTIONS,
+        MINES,
+        TREASURES,
+        DECORATIONS,
+        MONSTERS,
+
+        // Put all new entries above this line.
+        STEP_COUNT
+    };
+
+    // Called by the generator after every completed step. At this moment the map format and the world contain the partially generated map,
+    // so the callback can be used to show the progress and the preview of the map. The callback should return false to cancel the generation.
+    using ProgressCallback = std::function<bool( const GenerationStep step, const Map_Format::MapFormat & mapFormat )>;
+
     std::string layoutToString( const Layout layout );
     std::string resourceDensityToString( const ResourceDensity resources );
     std::string monsterStrengthToString( const MonsterStrength monsters );
     int32_t calculateMaximumWaterPercentage( const int32_t playerCount, const int32_t mapWidth );
-    bool generateMap( Map_Format::MapFormat & mapFormat, const Configuration & config, const int32_t width, const int32_t height );
+    // Returns false if the map cannot be generated with the given configuration or if the generation has been cancelled by the progress callback.
+    bool generateMap( Map_Format::MapFormat & mapFormat, const Configuration & config, const int32_t width, const int32_t height,
+                      const ProgressCallback & progressCallback = {} );
 }
@@ -25,7 +25,6 @@
 #include <cassert>
 #include <cmath>
 #include <cstddef>
-#include <functional>
 #include <initializer_list>
 #include <limits>
 #include <map>
@@ -232,18 +231,38 @@ namespace
         return {};
     }
 
-    void iterateOverObjectParts( const Maps::ObjectInfo & info, const std::function<void( const Maps::ObjectPartInfo & )> & lambda )
+    bool isObjectPartIgnored( const Maps::LayeredObjectPartInfo & objectPart )
+    {
+        // Shadow and terrain layer parts are ignored.
+        return objectPart.layerType == Maps::SHADOW_LAYER || objectPart.layerType == Maps::TERRAIN_LAYER;
+    }
+
+    template <typename Lambda>
+    void iterateOverObjectParts( const Maps::ObjectInfo & info, const Lambda & lambda )
     {
         for ( const auto & objectPart : info.groundLevelParts ) {
-            if ( objectPart.layerType == Maps::SHADOW_LAYER || objectPart.layerType == Maps::TERRAIN_LAYER ) {
-                // Shadow and terrain layer parts are ignored.
-                continue;
+            if ( !isObjectPartIgnored( objectPart ) ) {
+                lambda( objectPart );
             }
-
-            lambda( objectPart );
         }
     }
 
+    // Unlike iterateOverObjectParts() this function stops at the first object part not satisfying the predicate.
+    template <typename Predicate>
+    bool areAllObjectPartsValid( const Maps::ObjectInfo & info, const Predicate & predicate )
+    {
+        return std::all_of( info.groundLevelParts.begin(), info.groundLevelParts.end(),
+                            [&predicate]( const Maps::LayeredObjectPartInfo & objectPart ) { return isObjectPartIgnored( objectPart ) || predicate( objectPart ); } );
+    }
+
+    bool areTopLevelPartsOnMap( const Maps::Random_Generator::MapStateManager & data, const Maps::ObjectInfo & info, const fheroes2::Point position )
+    {
+        return std::all_of( info.topLevelParts.begin(), info.topLevelParts.end(), [&data, &position]( const Maps::ObjectPartInfo & objectPart ) {
+            const Maps::Random_Generator::Node & node = data.getNode( position + objectPart.tileOffset );
+            return node.index != -1 && node.region != 0;
+        } );
+    }
+
     void markNodeIndexAsType( Maps::Random_Generator::MapStateManager & data, const int32_t index, const Maps::Random_Generator::NodeType type )
     {
         auto & node = data.getNodeToUpdate( index );
@@ -263,45 +282,32 @@ namespace
     bool canPlaceObject( const Maps::Random_Generator::MapStateManager & data, const Maps::ObjectInfo & info, const fheroes2::Point position )
     {
         const bool isAction = MP2::isInGameActionObject( info.objectType );
-        bool validPlacement = true;
-
-        auto isValidObjectPart = [&data, &position, isAction, &validPlacement]( const auto & partInfo ) {
-            const Maps::Random_Generator::Node & node = data.getNode( position + partInfo.tileOffset );
 
+        if ( isAction ) {
+            // This is a single tile check so it goes first to reject most of the occupied positions as early as possible.
+            const Maps::Random_Generator::Node & node = data.getNode( position + fheroes2::Point( 0, 1 ) );
             if ( node.index == -1 || node.region == 0 ) {
-                validPlacement = false;
-                return;
-            }
-            if ( node.type == Maps::Random_Generator::NodeType::ACTION || node.type == Maps::Random_Generator::NodeType::PATH ) {
-                validPlacement = false;
-                return;
-            }
-            if ( node.type != Maps::Random_Generator::NodeType::OPEN && ( isAction || node.type != Maps::Random_Generator::NodeType::BORDER ) ) {
-                validPlacement = false;
-                return;
+                return false;
             }
-        };
-
-        iterateOverObjectParts( info, isValidObjectPart );
-
-        for ( const auto & objectPart : info.topLevelParts ) {
-            const Maps::Random_Generator::Node & node = data.getNode( position + objectPart.tileOffset );
-            if ( node.index == -1 || node.region == 0 ) {
+            if ( node.type != Maps::Random_Generator::NodeType::OPEN && node.type != Maps::Random_Generator::NodeType::PATH ) {
                 return false;
             }
         }
 
-        if ( isAction ) {
-            const Maps::Random_Generator::Node & node = data.getNode( position + fheroes2::Point( 0, 1 ) );
+        const bool validPlacement = areAllObjectPartsValid( info, [&data, &position, isAction]( const Maps::ObjectPartInfo & partInfo ) {
+            const Maps::Random_Generator::Node & node = data.getNode( position + partInfo.tileOffset );
+
             if ( node.index == -1 || node.region == 0 ) {
                 return false;
             }
-            if ( node.type != Maps::Random_Generator::NodeType::OPEN && node.type != Maps::Random_Generator::NodeType::PATH ) {
+            if ( node.type == Maps::Random_Generator::NodeType::ACTION || node.type == Maps::Random_Generator::NodeType::PATH ) {
                 return false;
             }
-        }
 
-        return validPlacement;
+            return node.type == Maps::Random_Generator::NodeType::OPEN || ( !isAction && node.type == Maps::Random_Generator::NodeType::BORDER );
+        } );
+
+        return validPlacement && areTopLevelPartsOnMap( data, info, position );
     }
 }
 
@@ -596,49 +602,66 @@ namespace Maps::Random_Generator
         std::vector<int32_t> result;
         result.reserve( targetCount );
 
+        // This function is called for every region many times, so tile positions are calculated only once
+        // and the distance is calculated in the same way as Maps::GetApproximateDistance() does.
+        std::vector<fheroes2::Point> candidatePoints;
+        candidatePoints.reserve( candidatesCount );
+
+        for ( const int32_t candidate : candidates ) {
+            candidatePoints.emplace_back( Maps::GetPoint( candidate ) );
+        }
+
+        const auto getDistance = []( const fheroes2::Point & first, const fheroes2::Point & second ) {
+            const uint32_t diffX = std::abs( first.x - second.x );
+            const uint32_t diffY = std::abs( first.y - second.y );
+
+            return std::max( diffX, diffY ) + std::min( diffX, diffY ) / 2;
+        };
+
+        std::vector<fheroes2::Point> avoidancePoints;
+        avoidancePoints.reserve( avoidance.size() );
+
+        for ( const int32_t avoid : avoidance ) {
+            avoidancePoints.emplace_back( Maps::GetPoint( avoid ) );
+        }
+
         std::vector<std::pair<uint32_t, bool>> cache;
         cache.reserve( candidatesCount );
 
-        for ( const int32_t candidate : candidates ) {
+        // We're searching for the largest distance that hasn't been used yet. The search for the next point is done
+        // in the same pass as the distance update.
+        int32_t bestCandidateIndex = -1;
+        uint32_t bestDistance = 0;
+
+        for ( size_t idx = 0; idx < candidatesCount; ++idx ) {
             uint32_t minDistance = std::numeric_limits<uint32_t>::max();
-            for ( const int32_t avoid : avoidance ) {
-                const uint32_t distance = Maps::GetApproximateDistance( candidate, avoid );
+            for ( const fheroes2::Point & avoid : avoidancePoints ) {
+                const uint32_t distance = getDistance( candidatePoints[idx], avoid );
                 if ( distance < minDistance ) {
                     minDistance = distance;
                 }
             }
             cache.emplace_back( minDistance, false );
-        }
-
-        auto selectNextIndex = [&]() {
-            int32_t bestCandidateIndex = -1;
-            uint32_t bestDistance = 0;
 
-            // We're searching for the largest distance that hasn't been used yet.
-            for ( size_t idx = 0; idx < cache.size(); ++idx ) {
-                if ( cache[idx].second ) {
-                    continue;
-                }
-
-                if ( cache[idx].first > bestDistance ) {
-                    bestDistance = cache[idx].first;
-                    bestCandidateIndex = static_cast<int32_t>( idx );
-                }
+            if ( minDistance > bestDistance ) {
+                bestDistance = minDistance;
+                bestCandidateIndex = static_cast<int32_t>( idx );
             }
-
-            return bestCandidateIndex;
-        };
+        }
 
         for ( size_t placed = 0; placed < targetCount; ++placed ) {
-            const int32_t pointIndex = selectNextIndex();
+            const int32_t pointIndex = bestCandidateIndex;
             if ( pointIndex < 0 ) {
                 break;
             }
 
-            const int32_t chosenPoint = candidates[pointIndex];
+            const fheroes2::Point chosenPoint = candidatePoints[pointIndex];
 
             cache[pointIndex].second = true;
-            result.push_back( chosenPoint );
+            result.push_back( candidates[pointIndex] );
+
+            bestCandidateIndex = -1;
+            bestDistance = 0;
 
             // Update distance for remaining candidates using the newly chosen point.
             for ( size_t idx = 0; idx < cache.size(); ++idx ) {
@@ -646,10 +669,15 @@ namespace Maps::Random_Generator
                     continue;
                 }
 
-                const uint32_t distance = Maps::GetApproximateDistance( candidates[idx], chosenPoint );
+                const uint32_t distance = getDistance( candidatePoints[idx], chosenPoint );
                 if ( distance < cache[idx].first ) {
                     cache[idx].first = distance;
                 }
+
+                if ( cache[idx].first > bestDistance ) {
+                    bestDistance = cache[idx].first;
+                    bestCandidateIndex = static_cast<int32_t>( idx );
+                }
             }
         }
 
@@ -658,31 +686,17 @@ namespace Maps::Random_Generator
 
     bool canPlaceBorderObstacle( const MapStateManager & data, const ObjectInfo & info, const fheroes2::Point & position )
     {
-        bool validPlacement = true;
-
-        auto updateObjectArea = [&data, &position, &validPlacement]( const auto & partInfo ) {
+        const bool validPlacement = areAllObjectPartsValid( info, [&data, &position]( const ObjectPartInfo & partInfo ) {
             const Node & node = data.getNode( position + partInfo.tileOffset );
 
-            if ( node.index == -1 || node.region == 0 ) {
-                validPlacement = false;
-                return;
-            }
-            if ( node.type != NodeType::OPEN && node.type != NodeType::BORDER && node.type != NodeType::OBSTACLE ) {
-                validPlacement = false;
-                return;
-            }
-        };
-
-        iterateOverObjectParts( info, updateObjectArea );
-
-        for ( const auto & objectPart : info.topLevelParts ) {
-            const Node & node = data.getNode( position + objectPart.tileOffset );
             if ( node.index == -1 || node.region == 0 ) {
                 return false;
             }
-        }
 
-        return validPlacement;
+            return node.type == NodeType::OPEN || node.type == NodeType::BORDER || node.type == NodeType::OBSTACLE;
+        } );
+
+        return validPlacement && areTopLevelPartsOnMap( data, info, position );
     }
 
     bool canPlaceAllObjects( const MapStateManager & data, const std::vector<ObjectPlacement> & objects, const fheroes2::Point & position, const int32_t ground )
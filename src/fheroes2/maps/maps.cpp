@@ -26,9 +26,13 @@
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <functional>
 #include <ostream>
+#include <set>
+#include <vector>
 
 #include "ai_planner.h"
 #include "army.h"
@@ -48,11 +52,35 @@
 
 namespace
 {
+    // Works like Maps::Tile::getMainObjectType() but reads the compact scan data of the tile unless a hero stands on it.
+    MP2::MapObjectType getScannedObjectType( const int32_t tileIndex, const bool ignoreObjectUnderHero )
+    {
+        const MP2::MapObjectType objectType = world.getTileScanData( tileIndex ).mainObjectType;
+        if ( ignoreObjectUnderHero || objectType != MP2::OBJ_HERO ) {
+            return objectType;
+        }
+
+        return world.getTile( tileIndex ).getMainObjectType( false );
+    }
+
+    Maps::Indexes getAroundObjectIndexes( const int32_t center, const MP2::MapObjectType objectType, const bool ignoreHeroes )
+    {
+        Maps::Indexes result;
+
+        Maps::forEachAroundIndex( center, world.w(), world.h(), 1, [&result, objectType, ignoreHeroes]( const int32_t index ) {
+            if ( getScannedObjectType( index, !ignoreHeroes ) == objectType ) {
+                result.push_back( index );
+            }
+        } );
+
+        return result;
+    }
+
     Maps::Indexes MapsIndexesFilteredObject( const Maps::Indexes & indexes, const MP2::MapObjectType objectType, const bool ignoreHeroes = true )
     {
         Maps::Indexes result;
         for ( size_t idx = 0; idx < indexes.size(); ++idx ) {
-            if ( world.getTile( indexes[idx] ).getMainObjectType( !ignoreHeroes ) == objectType ) {
+            if ( getScannedObjectType( indexes[idx], !ignoreHeroes ) == objectType ) {
                 result.push_back( indexes[idx] );
             }
         }
@@ -62,12 +90,38 @@ namespace
     Maps::Indexes MapsIndexesObject( const MP2::MapObjectType objectType, const bool ignoreHeroes )
     {
         Maps::Indexes result;
-        const int32_t size = static_cast<int32_t>( world.getSize() );
-        for ( int32_t idx = 0; idx < size; ++idx ) {
-            if ( world.getTile( idx ).getMainObjectType( !ignoreHeroes ) == objectType ) {
-                result.push_back( idx );
+
+        if ( objectType == MP2::OBJ_NONE ) {
+            // Empty tiles are not indexed.
+            const int32_t size = static_cast<int32_t>( world.getSize() );
+            for ( int32_t idx = 0; idx < size; ++idx ) {
+                if ( getScannedObjectType( idx, !ignoreHeroes ) == objectType ) {
+                    result.push_back( idx );
+                }
             }
+            return result;
+        }
+
+        // When heroes are ignored the tiles with heroes are checked for objects under them so the heroes themselves are not counted.
+        if ( !ignoreHeroes || objectType != MP2::OBJ_HERO ) {
+            const std::set<int32_t> & objectTiles = world.getObjectTileIndexes( objectType );
+            result.assign( objectTiles.begin(), objectTiles.end() );
         }
+
+        if ( ignoreHeroes ) {
+            const size_t objectTileCount = result.size();
+
+            for ( const int32_t idx : world.getObjectTileIndexes( MP2::OBJ_HERO ) ) {
+                if ( world.getTile( idx ).getMainObjectType( false ) == objectType ) {
+                    result.push_back( idx );
+                }
+            }
+
+            if ( result.size() != objectTileCount ) {
+                std::inplace_merge( result.begin(), result.begin() + static_cast<std::ptrdiff_t>( objectTileCount ), result.end() );
+            }
+        }
+
         return result;
     }
 
@@ -94,40 +148,85 @@ namespace
         return squaredDistanceLimit;
     }
 
+    // Calls the function for every row of the scouting area from top to bottom. A scouting area is a circle so each its row is a continuous span
+    // of tiles [minX, maxX]. Such spans are computed once per area instead of checking the distance to every tile of the bounding square.
+    template <typename RowFunction>
+    void forEachScoutingAreaRow( const fheroes2::Point & center, const int32_t scoutingDistance, const RowFunction & rowFunction )
+    {
+        assert( scoutingDistance > 0 );
+
+        const int32_t squaredScoutingRadiusLimit = getSquaredScoutingRadiusLimit( scoutingDistance );
+
+        // Half width of the area row for every distance from the center row.
+        thread_local std::vector<int32_t> rowHalfWidths;
+        rowHalfWidths.resize( static_cast<size_t>( scoutingDistance ) + 1 );
+
+        int32_t halfWidth = scoutingDistance;
+        for ( int32_t dy = 0; dy <= scoutingDistance; ++dy ) {
+            // The circle is narrowing from its center row to the top and bottom rows.
+            while ( halfWidth >= 0 && halfWidth * halfWidth + dy * dy >= squaredScoutingRadiusLimit ) {
+                --halfWidth;
+            }
+
+            rowHalfWidths[dy] = halfWidth;
+        }
+
+        const int32_t worldWidth = world.w();
+
+        const int32_t minY = std::max<int32_t>( center.y - scoutingDistance, 0 );
+        const int32_t maxY = std::min<int32_t>( center.y + scoutingDistance, world.h() - 1 );
+        assert( minY < maxY );
+
+        for ( int32_t y = minY; y <= maxY; ++y ) {
+            const int32_t rowHalfWidth = rowHalfWidths[std::abs( y - center.y )];
+            if ( rowHalfWidth < 0 ) {
+                continue;
+            }
+
+            const int32_t minX = std::max<int32_t>( center.x - rowHalfWidth, 0 );
+            const int32_t maxX = std::min<int32_t>( center.x + rowHalfWidth, worldWidth - 1 );
+
+            rowFunction( y, minX, maxX );
+        }
+    }
+
     void forEachMonsterProtectingTile( const int32_t tileIndex, const std::function<void( const int32_t )> & lambda )
     {
         const int width = world.w();
         const int x = tileIndex % width;
         const int y = tileIndex / width;
         const Maps::Tile & tile = world.getTile( tileIndex );
+        const int tilePassability = world.getTileScanData( tileIndex ).passability;
 
-        const auto isProtectedBy = [tileIndex, &tile]( const int32_t monsterTileIndex ) {
-            const Maps::Tile & monsterTile = world.getTile( monsterTileIndex );
-
-            if ( monsterTile.getMainObjectType() != MP2::OBJ_MONSTER || tile.isWater() != monsterTile.isWater() ) {
+        const auto isProtectedBy = [tileIndex, &tile, tilePassability]( const int32_t monsterTileIndex ) {
+            // Most of the neighbouring tiles have no monsters so check the scan data first before reading the whole tile.
+            const Maps::TileScanData & monsterTileData = world.getTileScanData( monsterTileIndex );
+            if ( monsterTileData.mainObjectType != MP2::OBJ_MONSTER || tile.isWater() != world.getTile( monsterTileIndex ).isWater() ) {
                 return false;
             }
 
+            const int monsterTilePassability = monsterTileData.passability;
+
             const int directionToMonster = Maps::GetDirection( tileIndex, monsterTileIndex );
             const int directionFromMonster = Direction::Reflect( directionToMonster );
 
             // The tile is directly accessible to the monster
-            if ( ( tile.GetPassable() & directionToMonster ) && ( monsterTile.GetPassable() & directionFromMonster ) ) {
+            if ( ( tilePassability & directionToMonster ) && ( monsterTilePassability & directionFromMonster ) ) {
                 return true;
             }
 
             // The tile is not directly accessible to the monster, but he can still attack in the diagonal direction if, when the hero moves away from the tile
             // in question in the vertical direction and the monster moves away from his tile in the horizontal direction, they would have to meet
-            if ( directionFromMonster == Direction::TOP_LEFT && ( tile.GetPassable() & Direction::BOTTOM ) && ( monsterTile.GetPassable() & Direction::LEFT ) ) {
+            if ( directionFromMonster == Direction::TOP_LEFT && ( tilePassability & Direction::BOTTOM ) && ( monsterTilePassability & Direction::LEFT ) ) {
                 return true;
             }
-            if ( directionFromMonster == Direction::TOP_RIGHT && ( tile.GetPassable() & Direction::BOTTOM ) && ( monsterTile.GetPassable() & Direction::RIGHT ) ) {
+            if ( directionFromMonster == Direction::TOP_RIGHT && ( tilePassability & Direction::BOTTOM ) && ( monsterTilePassability & Direction::RIGHT ) ) {
                 return true;
             }
-            if ( directionFromMonster == Direction::BOTTOM_RIGHT && ( tile.GetPassable() & Direction::TOP ) && ( monsterTile.GetPassable() & Direction::RIGHT ) ) {
+            if ( directionFromMonster == Direction::BOTTOM_RIGHT && ( tilePassability & Direction::TOP ) && ( monsterTilePassability & Direction::RIGHT ) ) {
                 return true;
             }
-            if ( directionFromMonster == Direction::BOTTOM_LEFT && ( tile.GetPassable() & Direction::TOP ) && ( monsterTile.GetPassable() & Direction::LEFT ) ) {
+            if ( directionFromMonster == Direction::BOTTOM_LEFT && ( tilePassability & Direction::TOP ) && ( monsterTilePassability & Direction::LEFT ) ) {
                 return true;
             }
 
@@ -421,28 +520,7 @@ Maps::Indexes Maps::getAroundIndexes( const int32_t tileIndex, const int32_t wid
     const size_t areaSideSize = maxDistanceFromTile * 2 + 1;
     results.reserve( areaSideSize * areaSideSize - 1 );
 
-    const int32_t centerX = tileIndex % width;
-    const int32_t centerY = tileIndex / width;
-
-    // We avoid getting out of map boundaries.
-    const int32_t minTileX = std::max<int32_t>( centerX - maxDistanceFromTile, 0 );
-    const int32_t minTileY = std::max<int32_t>( centerY - maxDistanceFromTile, 0 );
-    const int32_t maxTileX = std::min<int32_t>( centerX + maxDistanceFromTile + 1, width );
-    const int32_t maxTileY = std::min<int32_t>( centerY + maxDistanceFromTile + 1, height );
-
-    for ( int32_t tileY = minTileY; tileY < maxTileY; ++tileY ) {
-        const int32_t indexOffsetY = tileY * width;
-        const bool isCenterY = ( tileY == centerY );
-
-        for ( int32_t tileX = minTileX; tileX < maxTileX; ++tileX ) {
-            // Skip the center tile.
-            if ( isCenterY && tileX == centerX ) {
-                continue;
-            }
-
-            results.push_back( indexOffsetY + tileX );
-        }
-    }
+    forEachAroundIndex( tileIndex, width, height, maxDistanceFromTile, [&results]( const int32_t index ) { results.push_back( index ); } );
 
     return results;
 }
@@ -471,52 +549,41 @@ void Maps::ClearFog( const int32_t tileIndex, const int32_t scoutingDistance, co
     const bool isHumanOrHumanFriend = !isAIPlayer || Players::isFriends( playerColor, Players::HumanColors() );
 
     const fheroes2::Point center = Maps::GetPoint( tileIndex );
-    const int32_t squaredScoutingRadiusLimit = getSquaredScoutingRadiusLimit( scoutingDistance );
     const PlayerColorsSet alliedColors = Players::GetPlayerFriends( playerColor );
 
-    const int32_t minY = std::max<int32_t>( center.y - scoutingDistance, 0 );
-    const int32_t maxY = std::min<int32_t>( center.y + scoutingDistance, world.h() - 1 );
-    assert( minY < maxY );
-
     const int32_t worldWidth = world.w();
-    const int32_t minX = std::max<int32_t>( center.x - scoutingDistance, 0 );
-    const int32_t maxX = std::min<int32_t>( center.x + scoutingDistance, worldWidth - 1 );
-    assert( minX < maxX );
 
     fheroes2::Point fogRevealMinPos( world.h(), worldWidth );
     fheroes2::Point fogRevealMaxPos( 0, 0 );
 
-    for ( int32_t y = minY; y <= maxY; ++y ) {
-        const int32_t dy = y - center.y;
-        const int32_t dySquared = dy * dy;
+    forEachScoutingAreaRow( center, scoutingDistance, [&]( const int32_t y, const int32_t minX, const int32_t maxX ) {
         const int32_t offset = y * worldWidth;
 
         for ( int32_t x = minX; x <= maxX; ++x ) {
-            const int32_t dx = x - center.x;
-            if ( dx * dx + dySquared < squaredScoutingRadiusLimit ) {
-                Maps::Tile & tile = world.getTile( x + offset );
-                if ( isAIPlayer && tile.isFog( playerColor ) ) {
-                    AI::Planner::Get().revealFog( tile, kingdom );
-                }
+            Maps::Tile & tile = world.getTile( x + offset );
+            if ( isAIPlayer && tile.isFog( playerColor ) ) {
+                AI::Planner::Get().revealFog( tile, kingdom );
+            }
 
-                if ( tile.isFog( alliedColors ) ) {
-                    // Clear fog only if it is not already cleared.
-                    tile.ClearFog( alliedColors );
-
-                    if ( isHumanOrHumanFriend ) {
-                        // Update fog reveal area points only for human player and his allies.
-                        fogRevealMinPos.x = std::min( fogRevealMinPos.x, x );
-                        fogRevealMinPos.y = std::min( fogRevealMinPos.y, y );
-                        fogRevealMaxPos.x = std::max( fogRevealMaxPos.x, x );
-                        fogRevealMaxPos.y = std::max( fogRevealMaxPos.y, y );
-                    }
+            if ( tile.isFog( alliedColors ) ) {
+                // Clear fog only if it is not already cleared.
+                tile.ClearFog( alliedColors );
+
+                if ( isHumanOrHumanFriend ) {
+                    // Update fog reveal area points only for human player and his allies.
+                    fogRevealMinPos.x = std::min( fogRevealMinPos.x, x );
+                    fogRevealMinPos.y = std::min( fogRevealMinPos.y, y );
+                    fogRevealMaxPos.x = std::max( fogRevealMaxPos.x, x );
+                    fogRevealMaxPos.y = std::max( fogRevealMaxPos.y, y );
                 }
             }
         }
-    }
+    } );
 
     // Update fog directions only for human player and his allies and only if fog has to be cleared.
     if ( isHumanOrHumanFriend && ( fogRevealMaxPos.x >= fogRevealMinPos.x ) && ( fogRevealMaxPos.y >= fogRevealMinPos.y ) ) {
+        world.markRadarUpdateArea( { fogRevealMinPos.x, fogRevealMinPos.y, fogRevealMaxPos.x - fogRevealMinPos.x + 1, fogRevealMaxPos.y - fogRevealMinPos.y + 1 } );
+
         // Fog directions should be updated 1 tile outside of the cleared fog.
         fogRevealMinPos -= { 1, 1 };
         fogRevealMaxPos += { 1, 1 };
@@ -531,42 +598,26 @@ int32_t Maps::getFogTileCountToBeRevealed( const int32_t tileIndex, const int32_
     }
 
     const fheroes2::Point center = Maps::GetPoint( tileIndex );
-    const int32_t squaredScoutingRadiusLimit = getSquaredScoutingRadiusLimit( scoutingDistance );
-
-    const int32_t minY = std::max<int32_t>( center.y - scoutingDistance, 0 );
-    const int32_t maxY = std::min<int32_t>( center.y + scoutingDistance, world.h() - 1 );
-    assert( minY < maxY );
-
     const int32_t worldWidth = world.w();
-    const int32_t minX = std::max<int32_t>( center.x - scoutingDistance, 0 );
-    const int32_t maxX = std::min<int32_t>( center.x + scoutingDistance, worldWidth - 1 );
-    assert( minX < maxX );
 
     int32_t tileCount = 0;
 
-    for ( int32_t y = minY; y <= maxY; ++y ) {
-        const int32_t dy = y - center.y;
-        const int32_t dySquared = dy * dy;
+    forEachScoutingAreaRow( center, scoutingDistance, [&]( const int32_t y, const int32_t minX, const int32_t maxX ) {
         const int32_t offset = y * worldWidth;
 
         for ( int32_t x = minX; x <= maxX; ++x ) {
-            const int32_t dx = x - center.x;
-            if ( dx * dx + dySquared < squaredScoutingRadiusLimit ) {
-                const Maps::Tile & tile = world.getTile( x + offset );
-                if ( tile.isFog( playerColor ) ) {
-                    ++tileCount;
-                }
+            if ( world.getTileScanData( x + offset ).fogColors & playerColor ) {
+                ++tileCount;
             }
         }
-    }
+    } );
 
     return tileCount;
 }
 
 Maps::Indexes Maps::ScanAroundObject( const int32_t center, const MP2::MapObjectType objectType, const bool ignoreHeroes )
 {
-    Indexes results = getAroundIndexes( center );
-    return MapsIndexesFilteredObject( results, objectType, ignoreHeroes );
+    return getAroundObjectIndexes( center, objectType, ignoreHeroes );
 }
 
 bool Maps::isValidForDimensionDoor( int32_t targetIndex, bool isWater )
@@ -577,8 +628,7 @@ bool Maps::isValidForDimensionDoor( int32_t targetIndex, bool isWater )
 
 Maps::Indexes Maps::ScanAroundObject( const int32_t center, const MP2::MapObjectType objectType )
 {
-    Indexes results = getAroundIndexes( center );
-    return MapsIndexesFilteredObject( results, objectType );
+    return getAroundObjectIndexes( center, objectType, true );
 }
 
 Maps::Indexes Maps::ScanAroundObjectWithDistance( const int32_t center, const uint32_t dist, const MP2::MapObjectType objectType )
@@ -590,14 +640,11 @@ Maps::Indexes Maps::ScanAroundObjectWithDistance( const int32_t center, const ui
 
 bool Maps::doesObjectExistOnMap( const MP2::MapObjectType objectType )
 {
-    const int32_t size = static_cast<int32_t>( world.getSize() );
-    for ( int32_t idx = 0; idx < size; ++idx ) {
-        if ( world.getTile( idx ).getMainObjectType( false ) == objectType ) {
-            return true;
-        }
+    if ( objectType != MP2::OBJ_NONE && objectType != MP2::OBJ_HERO && !world.getObjectTileIndexes( objectType ).empty() ) {
+        return true;
     }
 
-    return false;
+    return !MapsIndexesObject( objectType, true ).empty();
 }
 
 Maps::Indexes Maps::GetObjectPositions( const MP2::MapObjectType objectType )
@@ -74,6 +74,46 @@ namespace Maps
     int32_t GetIndexFromAbsPoint( const fheroes2::Point & mp );
     int32_t GetIndexFromAbsPoint( const int32_t x, const int32_t y );
 
+    // Calls the given function for every tile index within the given distance from the tile, excluding the tile itself.
+    // Tiles are visited in the same order as they are returned by getAroundIndexes() but no memory is allocated.
+    template <typename Function>
+    void forEachAroundIndex( const int32_t tileIndex, const int32_t width, const int32_t height, const int32_t maxDistanceFromTile, Function && function )
+    {
+        if ( width <= 0 || height <= 0 || tileIndex < 0 || tileIndex > width * height || maxDistanceFromTile < 1 ) {
+            return;
+        }
+
+        const int32_t centerX = tileIndex % width;
+        const int32_t centerY = tileIndex / width;
+
+        // We avoid getting out of map boundaries.
+        const int32_t minTileX = std::max<int32_t>( centerX - maxDistanceFromTile, 0 );
+        const int32_t minTileY = std::max<int32_t>( centerY - maxDistanceFromTile, 0 );
+        const int32_t maxTileX = std::min<int32_t>( centerX + maxDistanceFromTile + 1, width );
+        const int32_t maxTileY = std::min<int32_t>( centerY + maxDistanceFromTile + 1, height );
+
+        for ( int32_t tileY = minTileY; tileY < maxTileY; ++tileY ) {
+            const int32_t indexOffsetY = tileY * width;
+
+            if ( tileY != centerY ) {
+                for ( int32_t tileX = minTileX; tileX < maxTileX; ++tileX ) {
+                    function( indexOffsetY + tileX );
+                }
+
+                continue;
+            }
+
+            // Skip the center tile.
+            for ( int32_t tileX = minTileX; tileX < centerX; ++tileX ) {
+                function( indexOffsetY + tileX );
+            }
+
+            for ( int32_t tileX = centerX + 1; tileX < maxTileX; ++tileX ) {
+                function( indexOffsetY + tileX );
+            }
+        }
+    }
+
     Indexes getAroundIndexes( const int32_t tileIndex, const int32_t maxDistanceFromTile = 1 );
     Indexes getAroundIndexes( const int32_t tileIndex, const int32_t width, const int32_t height, const int32_t maxDistanceFromTile );
 
@@ -29,7 +29,10 @@
 #include <functional>
 #include <list>
 #include <map>
+#include <mutex>
+#include <optional>
 #include <sstream>
+#include <string>
 #include <type_traits>
 #include <utility>
 
@@ -49,6 +52,7 @@
 #include "serialize.h"
 #include "settings.h"
 #include "system.h"
+#include "thread.h"
 #include "tools.h"
 #include "ui_font.h"
 #include "ui_language.h"
@@ -58,6 +62,226 @@ namespace
     const size_t mapNameLength = 16;
     const size_t mapDescriptionLength = 200;
 
+    const uint32_t mapInfoCacheMagicNumber{ 0x4D494331 };
+
+    // Headers of the map files which were already read. The cache is stored on disk between game sessions, so the map list does not need
+    // to parse every map file on each launch. An entry is valid only as long as the size and the modification time of its file are the same.
+    class MapInfoCache
+    {
+    public:
+        MapInfoCache( const MapInfoCache & ) = delete;
+        MapInfoCache & operator=( const MapInfoCache & ) = delete;
+
+        static MapInfoCache & instance()
+        {
+            static MapInfoCache cache;
+            return cache;
+        }
+
+        // Returns the information about each of the given map files in the same order, or an empty value if the file is not a valid map.
+        // Map files missing from the cache are read in parallel. The information is read as for the Editor, so maps without human players
+        // are not filtered out.
+        std::vector<std::optional<Maps::FileInfo>> getMapInfos( const ListFiles & mapFiles, const bool isOriginalMapFormat )
+        {
+            const std::scoped_lock<std::mutex> lock( _mutex );
+
+            return _getMapInfos( mapFiles, isOriginalMapFormat );
+        }
+
+        // Reads the information about the given map files into the cache. Does nothing if the cache is being used by another thread at
+        // the moment: the map files are going to be read by it anyway. This also avoids a deadlock if this method is called by a job which
+        // is executed by a thread waiting inside getMapInfos().
+        void prefetchMapInfos( const ListFiles & mapFiles, const bool isOriginalMapFormat )
+        {
+            const std::unique_lock<std::mutex> lock( _mutex, std::try_to_lock );
+            if ( !lock.owns_lock() ) {
+                return;
+            }
+
+            _getMapInfos( mapFiles, isOriginalMapFormat );
+        }
+
+    private:
+        struct Entry
+        {
+            uint64_t fileSize{ 0 };
+            int64_t modificationTime{ 0 };
+            std::optional<Maps::FileInfo> info;
+        };
+
+        MapInfoCache()
+        {
+            _load();
+        }
+
+        std::vector<std::optional<Maps::FileInfo>> _getMapInfos( const ListFiles & mapFiles, const bool isOriginalMapFormat )
+        {
+            const std::vector<std::string> filePaths( mapFiles.begin(), mapFiles.end() );
+
+            std::vector<std::optional<Maps::FileInfo>> result( filePaths.size() );
+
+            struct FileStamp
+            {
+                size_t id{ 0 };
+                uint64_t fileSize{ 0 };
+                int64_t modificationTime{ 0 };
+                bool isValid{ false };
+            };
+
+            std::vector<FileStamp> filesToRead;
+
+            for ( size_t i = 0; i < filePaths.size(); ++i ) {
+                FileStamp stamp;
+                stamp.id = i;
+                stamp.isValid = System::GetFileStamp( filePaths[i], stamp.fileSize, stamp.modificationTime );
+
+                if ( stamp.isValid ) {
+                    const auto iter = _entries.find( filePaths[i] );
+                    if ( iter != _entries.end() && iter->second.fileSize == stamp.fileSize && iter->second.modificationTime == stamp.modificationTime ) {
+                        result[i] = iter->second.info;
+                        continue;
+                    }
+                }
+
+                filesToRead.push_back( stamp );
+            }
+
+            if ( filesToRead.empty() ) {
+                return result;
+            }
+
+            DEBUG_LOG( DBG_GAME, DBG_INFO, "Reading " << filesToRead.size() << " map files out of " << filePaths.size() )
+
+            MultiThreading::JobSystem::Get().parallelFor( 0, filesToRead.size(), [&filesToRead, &filePaths, &result, isOriginalMapFormat]( const size_t i ) {
+                const size_t id = filesToRead[i].id;
+
+                Maps::FileInfo fi;
+
+                const bool isRead = isOriginalMapFormat ? fi.readMP2Map( filePaths[id], true ) : fi.readResurrectionMap( filePaths[id], true );
+                if ( isRead ) {
+                    result[id] = std::move( fi );
+                }
+            } );
+
+            bool isChanged = false;
+
+            for ( const FileStamp & stamp : filesToRead ) {
+                if ( !stamp.isValid ) {
+                    continue;
+                }
+
+                _entries[filePaths[stamp.id]] = { stamp.fileSize, stamp.modificationTime, result[stamp.id] };
+                isChanged = true;
+            }
+
+            if ( isChanged ) {
+                _save();
+            }
+
+            return result;
+        }
+
+        static std::string _getFilePath()
+        {
+            return System::concatPath( System::GetDataDirectory( "fheroes2" ), "maps.cache" );
+        }
+
+        void _load()
+        {
+            StreamFile fileStream;
+            fileStream.setBigendian( true );
+
+            const std::string filePath = _getFilePath();
+            if ( !System::IsFile( filePath ) || !fileStream.open( filePath, "rb" ) ) {
+                return;
+            }
+
+            ROStreamBuf stream = fileStream.getStreamBuf();
+            stream.setBigendian( true );
+
+            uint32_t magicNumber = 0;
+            uint16_t version = 0;
+            uint32_t count = 0;
+
+            stream >> magicNumber >> version >> count;
+
+            if ( stream.fail() || magicNumber != mapInfoCacheMagicNumber || version != CURRENT_FORMAT_VERSION ) {
+                DEBUG_LOG( DBG_GAME, DBG_INFO, "Map info cache " << filePath << " is outdated and will be rebuilt." )
+                return;
+            }
+
+            // Map information is stored in the format of the current save file version.
+            const uint16_t saveVersion = Game::GetVersionOfCurrentSaveFile();
+            Game::SetVersionOfCurrentSaveFile( CURRENT_FORMAT_VERSION );
+
+            for ( uint32_t i = 0; i < count && !stream.fail(); ++i ) {
+                std::string mapFilePath;
+                Entry entry;
+                uint64_t modificationTime = 0;
+
+                stream >> mapFilePath >> entry.fileSize >> modificationTime >> entry.info;
+
+                if ( entry.info ) {
+                    // Only the file name is stored as part of the map information.
+                    entry.info->filename = mapFilePath;
+                }
+
+                entry.modificationTime = static_cast<int64_t>( modificationTime );
+
+                _entries.try_emplace( std::move( mapFilePath ), std::move( entry ) );
+            }
+
+            Game::SetVersionOfCurrentSaveFile( saveVersion );
+
+            if ( stream.fail() ) {
+                DEBUG_LOG( DBG_GAME, DBG_WARN, "Map info cache " << filePath << " is corrupted and will be rebuilt." )
+                _entries.clear();
+            }
+        }
+
+        void _save()
+        {
+            // Files which no longer exist are dropped from the cache.
+            for ( auto iter = _entries.begin(); iter != _entries.end(); ) {
+                if ( System::IsFile( iter->first ) ) {
+                    ++iter;
+                }
+                else {
+                    iter = _entries.erase( iter );
+                }
+            }
+
+            RWStreamBuf stream;
+            stream.setBigendian( true );
+
+            const uint16_t version = CURRENT_FORMAT_VERSION;
+
+            stream << mapInfoCacheMagicNumber << version << static_cast<uint32_t>( _entries.size() );
+
+            for ( const auto & [mapFilePath, entry] : _entries ) {
+                stream << mapFilePath << entry.fileSize << static_cast<uint64_t>( entry.modificationTime ) << entry.info;
+            }
+
+            StreamFile fileStream;
+            fileStream.setBigendian( true );
+
+            const std::string filePath = _getFilePath();
+            if ( !fileStream.open( filePath, "wb" ) ) {
+                return;
+            }
+
+            fileStream.putRaw( stream.data(), stream.size() );
+
+            if ( fileStream.fail() ) {
+                DEBUG_LOG( DBG_GAME, DBG_WARN, "Failed to write the map info cache to " << filePath )
+            }
+        }
+
+        std::map<std::string, Entry> _entries;
+
+        std::mutex _mutex;
+    };
+
     // This function returns an unsorted array. It is a caller responsibility to take care of sorting if needed.
     MapsFileInfoList getValidMaps( const ListFiles & mapFiles, const uint8_t humanPlayerCount, const bool isForEditor, const bool isOriginalMapFormat )
     {
@@ -72,21 +296,20 @@ namespace
             = isOriginalMapFormat
               && ( fheroes2::getCurrentLanguage() == fheroes2::SupportedLanguage::French && fheroes2::getResourceLanguage() == fheroes2::SupportedLanguage::French );
 
-        for ( const std::string & mapFile : mapFiles ) {
-            Maps::FileInfo fi;
-
-            if ( isOriginalMapFormat ) {
-                if ( !fi.readMP2Map( mapFile, isForEditor ) ) {
-                    continue;
-                }
+        for ( std::optional<Maps::FileInfo> & mapInfo : MapInfoCache::instance().getMapInfos( mapFiles, isOriginalMapFormat ) ) {
+            if ( !mapInfo ) {
+                continue;
             }
-            else {
-                if ( !fi.readResurrectionMap( mapFile, isForEditor ) ) {
+
+            Maps::FileInfo & fi = *mapInfo;
+
+            if ( !isForEditor ) {
+                if ( fi.colorsAvailableForHumans == 0 ) {
+                    // This is not a valid map since no human players exist so it cannot be played.
+                    DEBUG_LOG( DBG_GAME, DBG_WARN, "Map " << fi.filename << " does not contain any human players." )
                     continue;
                 }
-            }
 
-            if ( !isForEditor ) {
                 assert( humanPlayerCount >= 1 );
 
                 const int humanOnlyColorsCount = Color::Count( fi.HumanOnlyColors() );
@@ -113,7 +336,8 @@ namespace
                 }
             }
 
-            uniqueMaps.try_emplace( System::GetFileName( mapFile ), std::move( fi ) );
+            std::string mapFileName = System::GetFileName( fi.filename );
+            uniqueMaps.try_emplace( std::move( mapFileName ), std::move( fi ) );
         }
 
         MapsFileInfoList result;
@@ -754,6 +978,27 @@ MapsFileInfoList Maps::getResurrectionMapFileInfos( const bool isForEditor, cons
     return validMaps;
 }
 
+void Maps::prefetchMapFileInfos()
+{
+    if ( MultiThreading::JobSystem::Get().getWorkerCount() == 0 ) {
+        // There is no point to read the maps in advance if there are no background threads: it would only delay the startup.
+        return;
+    }
+
+    const bool isPOLSupported = Settings::Get().isPriceOfLoyaltySupported();
+
+    MultiThreading::JobSystem::Get().submit( [isPOLSupported]() {
+        MapInfoCache & cache = MapInfoCache::instance();
+
+        cache.prefetchMapInfos( Settings::FindFiles( "maps", ".mp2", false ), true );
+
+        if ( isPOLSupported ) {
+            cache.prefetchMapInfos( Settings::FindFiles( "maps", ".mx2", false ), true );
+            cache.prefetchMapInfos( Settings::FindFiles( "maps", ".fh2m", false ), false );
+        }
+    } );
+}
+
 bool Maps::tryGetMatchingFile( const std::string & fileName, std::string & matchingFilePath )
 {
     static const auto fileNameToPath = []() {
@@ -270,5 +270,9 @@ namespace Maps
     // Only for RESURRECTION map files.
     MapsFileInfoList getResurrectionMapFileInfos( const bool isForEditor, const uint8_t humanPlayerCount );
 
+    // Reads the information about all map files into the cache in the background, so that the first opening of the map list doesn't
+    // have to wait for it. It is meant to be called once at startup.
+    void prefetchMapFileInfos();
+
     bool tryGetMatchingFile( const std::string & fileName, std::string & matchingFilePath );
 }
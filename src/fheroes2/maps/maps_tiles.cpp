@@ -27,6 +27,7 @@
 #include <array>
 #include <bitset>
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <limits>
@@ -479,6 +480,8 @@ void Maps::Tile::setHero( Heroes * hero )
 
         _occupantHeroId = Heroes::UNKNOWN;
     }
+
+    world.updateTileScanData( *this );
 }
 
 fheroes2::Point Maps::Tile::GetCenter() const
@@ -500,14 +503,15 @@ void Maps::Tile::setMainObjectType( const MP2::MapObjectType objectType )
 {
     _mainObjectType = objectType;
 
-    world.resetPathfinder();
+    world.updateTileScanData( *this );
+    world.resetPathfinderForTile( _index );
 }
 
 void Maps::Tile::setBoat( const int direction, const PlayerColor color )
 {
     if ( _mainObjectPart.icnType != MP2::OBJ_ICN_TYPE_UNKNOWN ) {
         // It is important to preserve the order of objects for rendering purposes. Therefore, the main object should go to the front of objects.
-        _groundObjectPart.emplace_front( _mainObjectPart );
+        _groundObjectPart.insert( _groundObjectPart.begin(), _mainObjectPart );
     }
 
     // If this assertion blows up then you are trying to put a boat on land!
@@ -674,9 +678,25 @@ void Maps::Tile::setInitialPassability()
     assert( passability >= std::numeric_limits<TilePassabilityDirectionsType>::min() && passability <= std::numeric_limits<TilePassabilityDirectionsType>::max() );
 
     _tilePassabilityDirections = static_cast<TilePassabilityDirectionsType>( passability );
+
+    world.updateTileScanData( *this );
 }
 
 void Maps::Tile::updatePassability()
+{
+    _updatePassability();
+
+    world.updateTileScanData( *this );
+}
+
+void Maps::Tile::computePassability()
+{
+    _tilePassabilityDirections = static_cast<uint16_t>( getTileIndependentPassability() );
+
+    _updatePassability();
+}
+
+void Maps::Tile::_updatePassability()
 {
     // If the passability is already 0 nothing we need to do.
     if ( _tilePassabilityDirections == 0 ) {
@@ -838,11 +858,11 @@ void Maps::Tile::sortObjectParts()
 
     // Push everything to the container and sort it by level.
     if ( _mainObjectPart.icnType != MP2::OBJ_ICN_TYPE_UNKNOWN ) {
-        _groundObjectPart.emplace_front( _mainObjectPart );
+        _groundObjectPart.insert( _groundObjectPart.begin(), _mainObjectPart );
     }
 
     // Sort by internal layers.
-    _groundObjectPart.sort( []( const auto & left, const auto & right ) { return ( left.layerType > right.layerType ); } );
+    std::stable_sort( _groundObjectPart.begin(), _groundObjectPart.end(), []( const auto & left, const auto & right ) { return ( left.layerType > right.layerType ); } );
 
     if ( !_groundObjectPart.empty() ) {
         auto highestPriorityPartIter = _groundObjectPart.end();
@@ -1283,8 +1303,8 @@ void Maps::Tile::updateFlag( const PlayerColor color, const uint8_t objectSprite
     // Flag deletion or installation must be done in relation to object UID as flag is attached to the object.
     if ( color == PlayerColor::NONE ) {
         const auto isFlag = [uid]( const auto & part ) { return part._uid == uid && part.icnType == MP2::OBJ_ICN_TYPE_FLAG32; };
-        _groundObjectPart.remove_if( isFlag );
-        _topObjectPart.remove_if( isFlag );
+        _groundObjectPart.erase( std::remove_if( _groundObjectPart.begin(), _groundObjectPart.end(), isFlag ), _groundObjectPart.end() );
+        _topObjectPart.erase( std::remove_if( _topObjectPart.begin(), _topObjectPart.end(), isFlag ), _topObjectPart.end() );
         return;
     }
 
@@ -1456,13 +1476,15 @@ bool Maps::Tile::removeObjectPartsByUID( const uint32_t objectUID )
     }
 
     size_t partCountBefore = _groundObjectPart.size();
-    _groundObjectPart.remove_if( [objectUID]( const auto & v ) { return v._uid == objectUID; } );
+    _groundObjectPart.erase( std::remove_if( _groundObjectPart.begin(), _groundObjectPart.end(), [objectUID]( const auto & v ) { return v._uid == objectUID; } ),
+                             _groundObjectPart.end() );
     if ( partCountBefore != _groundObjectPart.size() ) {
         isObjectPartRemoved = true;
     }
 
     partCountBefore = _topObjectPart.size();
-    _topObjectPart.remove_if( [objectUID]( const auto & v ) { return v._uid == objectUID; } );
+    _topObjectPart.erase( std::remove_if( _topObjectPart.begin(), _topObjectPart.end(), [objectUID]( const auto & v ) { return v._uid == objectUID; } ),
+                          _topObjectPart.end() );
     if ( partCountBefore != _topObjectPart.size() ) {
         isObjectPartRemoved = true;
     }
@@ -1486,6 +1508,9 @@ bool Maps::Tile::removeObjectPartsByUID( const uint32_t objectUID )
             world.getTile( tileIndex ).updatePassability();
         }
 
+        const fheroes2::Point position = Maps::GetPoint( _index );
+        world.updateRegions( { position.x - 1, position.y - 1, 3, 3 } );
+
         if ( Heroes::isValidId( _occupantHeroId ) ) {
             Heroes * hero = world.GetHeroes( _occupantHeroId );
             if ( hero != nullptr ) {
@@ -1504,8 +1529,11 @@ bool Maps::Tile::removeObjectPartsByUID( const uint32_t objectUID )
 
 void Maps::Tile::removeObjects( const MP2::ObjectIcnType objectIcnType )
 {
-    _groundObjectPart.remove_if( [objectIcnType]( const auto & part ) { return part.icnType == objectIcnType; } );
-    _topObjectPart.remove_if( [objectIcnType]( const auto & part ) { return part.icnType == objectIcnType; } );
+    _groundObjectPart.erase( std::remove_if( _groundObjectPart.begin(), _groundObjectPart.end(),
+                                             [objectIcnType]( const auto & part ) { return part.icnType == objectIcnType; } ),
+                             _groundObjectPart.end() );
+    _topObjectPart.erase( std::remove_if( _topObjectPart.begin(), _topObjectPart.end(), [objectIcnType]( const auto & part ) { return part.icnType == objectIcnType; } ),
+                          _topObjectPart.end() );
 
     if ( _mainObjectPart.icnType == objectIcnType ) {
         _mainObjectPart = {};
@@ -1571,10 +1599,12 @@ void Maps::Tile::ClearFog( const PlayerColorsSet colors )
 {
     _fogColors &= ~colors;
 
+    world.updateTileScanData( *this );
+
     // The fog might be cleared even without the hero's movement - for example, the hero can gain a new level of Scouting
     // skill by picking up a Treasure Chest from a nearby tile or buying a map in a Magellan's Maps object using the space
     // bar button. Reset the pathfinder(s) to make the newly discovered tiles immediately available for this hero.
-    world.resetPathfinder();
+    world.resetPathfinderForTile( _index );
 }
 
 void Maps::Tile::updateTileObjectIcnIndex( Maps::Tile & tile, const uint32_t uid, const uint8_t newIndex )
@@ -1956,3 +1986,164 @@ IStreamBase & Maps::operator>>( IStreamBase & stream, Tile & tile )
 
     return stream >> tile._boatOwnerColor;
 }
+
+void Maps::saveTiles( OStreamBase & stream, const std::vector<Tile> & tiles )
+{
+    const size_t tileCount = tiles.size();
+
+    std::vector<uint16_t> terrainImageIndexes( tileCount );
+    std::vector<uint8_t> terrainFlags( tileCount );
+    std::vector<uint16_t> passabilities( tileCount );
+    std::vector<uint16_t> objectTypes( tileCount );
+    std::vector<uint8_t> fogColors( tileCount );
+    std::vector<uint32_t> metadata( tileCount * 3 );
+    std::vector<uint8_t> occupantHeroIds( tileCount );
+    std::vector<uint8_t> roads( tileCount );
+    std::vector<uint8_t> boatOwnerColors( tileCount );
+    std::vector<uint16_t> groundPartCounts( tileCount );
+    std::vector<uint16_t> topPartCounts( tileCount );
+
+    // Main object parts go first in the object part table, followed by ground and top parts of each tile.
+    size_t partCount = tileCount;
+    for ( const Tile & tile : tiles ) {
+        partCount += tile._groundObjectPart.size() + tile._topObjectPart.size();
+    }
+
+    std::vector<uint8_t> partLayerTypes;
+    std::vector<uint32_t> partUIDs;
+    std::vector<uint8_t> partIcnTypes;
+    std::vector<uint8_t> partIcnIndexes;
+
+    partLayerTypes.reserve( partCount );
+    partUIDs.reserve( partCount );
+    partIcnTypes.reserve( partCount );
+    partIcnIndexes.reserve( partCount );
+
+    const auto addPart = [&partLayerTypes, &partUIDs, &partIcnTypes, &partIcnIndexes]( const ObjectPart & part ) {
+        partLayerTypes.push_back( static_cast<uint8_t>( part.layerType ) );
+        partUIDs.push_back( part._uid );
+        partIcnTypes.push_back( static_cast<uint8_t>( part.icnType ) );
+        partIcnIndexes.push_back( part.icnIndex );
+    };
+
+    for ( size_t i = 0; i < tileCount; ++i ) {
+        const Tile & tile = tiles[i];
+
+        assert( tile._index == static_cast<int32_t>( i ) );
+        assert( tile._groundObjectPart.size() <= std::numeric_limits<uint16_t>::max() && tile._topObjectPart.size() <= std::numeric_limits<uint16_t>::max() );
+
+        terrainImageIndexes[i] = tile._terrainImageIndex;
+        terrainFlags[i] = tile._terrainFlags;
+        passabilities[i] = tile._tilePassabilityDirections;
+        objectTypes[i] = static_cast<uint16_t>( tile._mainObjectType );
+        fogColors[i] = tile._fogColors;
+        std::copy( tile._metadata.begin(), tile._metadata.end(), metadata.begin() + static_cast<std::ptrdiff_t>( i * 3 ) );
+        occupantHeroIds[i] = tile._occupantHeroId;
+        roads[i] = tile._isTileMarkedAsRoad ? 1 : 0;
+        boatOwnerColors[i] = static_cast<uint8_t>( tile._boatOwnerColor );
+        groundPartCounts[i] = static_cast<uint16_t>( tile._groundObjectPart.size() );
+        topPartCounts[i] = static_cast<uint16_t>( tile._topObjectPart.size() );
+
+        addPart( tile._mainObjectPart );
+    }
+
+    for ( const Tile & tile : tiles ) {
+        for ( const ObjectPart & part : tile._groundObjectPart ) {
+            addPart( part );
+        }
+        for ( const ObjectPart & part : tile._topObjectPart ) {
+            addPart( part );
+        }
+    }
+
+    stream << terrainImageIndexes << terrainFlags << passabilities << objectTypes << fogColors << metadata << occupantHeroIds << roads << boatOwnerColors
+           << groundPartCounts << topPartCounts << partLayerTypes << partUIDs << partIcnTypes << partIcnIndexes;
+}
+
+void Maps::loadTiles( IStreamBase & stream, std::vector<Tile> & tiles )
+{
+    std::vector<uint16_t> terrainImageIndexes;
+    std::vector<uint8_t> terrainFlags;
+    std::vector<uint16_t> passabilities;
+    std::vector<uint16_t> objectTypes;
+    std::vector<uint8_t> fogColors;
+    std::vector<uint32_t> metadata;
+    std::vector<uint8_t> occupantHeroIds;
+    std::vector<uint8_t> roads;
+    std::vector<uint8_t> boatOwnerColors;
+    std::vector<uint16_t> groundPartCounts;
+    std::vector<uint16_t> topPartCounts;
+    std::vector<uint8_t> partLayerTypes;
+    std::vector<uint32_t> partUIDs;
+    std::vector<uint8_t> partIcnTypes;
+    std::vector<uint8_t> partIcnIndexes;
+
+    stream >> terrainImageIndexes >> terrainFlags >> passabilities >> objectTypes >> fogColors >> metadata >> occupantHeroIds >> roads >> boatOwnerColors
+        >> groundPartCounts >> topPartCounts >> partLayerTypes >> partUIDs >> partIcnTypes >> partIcnIndexes;
+
+    tiles.clear();
+
+    const size_t tileCount = terrainImageIndexes.size();
+
+    size_t partCount = tileCount;
+    if ( groundPartCounts.size() == tileCount && topPartCounts.size() == tileCount ) {
+        for ( size_t i = 0; i < tileCount; ++i ) {
+            partCount += static_cast<size_t>( groundPartCounts[i] ) + topPartCounts[i];
+        }
+    }
+
+    if ( terrainFlags.size() != tileCount || passabilities.size() != tileCount || objectTypes.size() != tileCount || fogColors.size() != tileCount
+         || metadata.size() != tileCount * 3 || occupantHeroIds.size() != tileCount || roads.size() != tileCount || boatOwnerColors.size() != tileCount
+         || groundPartCounts.size() != tileCount || topPartCounts.size() != tileCount || partLayerTypes.size() != partCount || partUIDs.size() != partCount
+         || partIcnTypes.size() != partCount || partIcnIndexes.size() != partCount ) {
+        ERROR_LOG( "Inconsistent packed map tile data, number of tiles: " << tileCount )
+        stream.setFail();
+        return;
+    }
+
+    size_t partId = 0;
+
+    const auto getPart = [&partLayerTypes, &partUIDs, &partIcnTypes, &partIcnIndexes, &partId]( ObjectPart & part ) {
+        part.layerType = static_cast<ObjectLayerType>( partLayerTypes[partId] );
+        part._uid = partUIDs[partId];
+        part.icnType = static_cast<MP2::ObjectIcnType>( partIcnTypes[partId] );
+        part.icnIndex = partIcnIndexes[partId];
+
+        ++partId;
+    };
+
+    tiles.resize( tileCount );
+
+    for ( size_t i = 0; i < tileCount; ++i ) {
+        Tile & tile = tiles[i];
+
+        tile._index = static_cast<int32_t>( i );
+        tile._terrainImageIndex = terrainImageIndexes[i];
+        tile._terrainFlags = terrainFlags[i];
+        tile._tilePassabilityDirections = passabilities[i];
+        tile._mainObjectType = static_cast<MP2::MapObjectType>( objectTypes[i] );
+        tile._fogColors = fogColors[i];
+        std::copy_n( metadata.begin() + static_cast<std::ptrdiff_t>( i * 3 ), 3, tile._metadata.begin() );
+        tile._occupantHeroId = occupantHeroIds[i];
+        tile._isTileMarkedAsRoad = ( roads[i] != 0 );
+        tile._boatOwnerColor = static_cast<PlayerColor>( boatOwnerColors[i] );
+
+        getPart( tile._mainObjectPart );
+    }
+
+    for ( size_t i = 0; i < tileCount; ++i ) {
+        Tile & tile = tiles[i];
+
+        tile._groundObjectPart.resize( groundPartCounts[i] );
+        for ( ObjectPart & part : tile._groundObjectPart ) {
+            getPart( part );
+        }
+
+        tile._topObjectPart.resize( topPartCounts[i] );
+        for ( ObjectPart & part : tile._topObjectPart ) {
+            getPart( part );
+        }
+    }
+
+    assert( partId == partCount );
+}
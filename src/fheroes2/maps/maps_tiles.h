@@ -25,7 +25,6 @@
 
 #include <array>
 #include <cstdint>
-#include <list>
 #include <string>
 #include <vector>
 
@@ -96,6 +95,19 @@ namespace Maps
         uint8_t icnIndex{ 255 };
     };
 
+    // A compact copy of the tile fields which are read by whole map scans. World keeps these copies for all tiles
+    // in a separate array so such scans do not need to go through full tile objects.
+    struct TileScanData
+    {
+        MP2::MapObjectType mainObjectType{ MP2::OBJ_NONE };
+
+        uint16_t passability{ DIRECTION_ALL };
+
+        PlayerColorsSet fogColors{ Color::allPlayerColors() };
+
+        uint8_t occupantHeroId{ Heroes::UNKNOWN };
+    };
+
     class Tile
     {
     public:
@@ -126,6 +138,11 @@ namespace Maps
             return _index;
         }
 
+        TileScanData getScanData() const
+        {
+            return { _mainObjectType, _tilePassabilityDirections, _fogColors, _occupantHeroId };
+        }
+
         fheroes2::Point GetCenter() const;
 
         MP2::MapObjectType getMainObjectType() const
@@ -242,6 +259,10 @@ namespace Maps
         // Update passability based on neighbours around.
         void updatePassability();
 
+        // Sets the initial passability and updates it based on neighbours around, without updating the world tile scan data.
+        // Object parts of this tile and its neighbours must not be modified meanwhile, so that all tiles can be processed in parallel.
+        void computePassability();
+
         void setOwnershipFlag( const MP2::MapObjectType objectType, PlayerColor color );
 
         // Return fog direction of tile. A tile without fog returns "Direction::UNKNOWN".
@@ -257,17 +278,17 @@ namespace Maps
             _topObjectPart.emplace_back( part );
         }
 
-        const std::list<ObjectPart> & getGroundObjectParts() const
+        const std::vector<ObjectPart> & getGroundObjectParts() const
         {
             return _groundObjectPart;
         }
 
-        std::list<ObjectPart> & getGroundObjectParts()
+        std::vector<ObjectPart> & getGroundObjectParts()
         {
             return _groundObjectPart;
         }
 
-        const std::list<ObjectPart> & getTopObjectParts() const
+        const std::vector<ObjectPart> & getTopObjectParts() const
         {
             return _topObjectPart;
         }
@@ -384,16 +405,20 @@ namespace Maps
 
         MP2::MapObjectType _getMainObjectTypeUnderHero() const;
 
+        void _updatePassability();
+
         friend OStreamBase & operator<<( OStreamBase & stream, const Tile & tile );
         friend IStreamBase & operator>>( IStreamBase & stream, Tile & tile );
+        friend void saveTiles( OStreamBase & stream, const std::vector<Tile> & tiles );
+        friend void loadTiles( IStreamBase & stream, std::vector<Tile> & tiles );
 
         // The following members are used in the Editor and in the game.
 
         ObjectPart _mainObjectPart;
 
-        std::list<ObjectPart> _groundObjectPart;
+        std::vector<ObjectPart> _groundObjectPart;
 
-        std::list<ObjectPart> _topObjectPart;
+        std::vector<ObjectPart> _topObjectPart;
 
         int32_t _index{ 0 };
 
@@ -432,4 +457,9 @@ namespace Maps
     OStreamBase & operator<<( OStreamBase & stream, const Tile & tile );
     IStreamBase & operator>>( IStreamBase & stream, ObjectPart & ta );
     IStreamBase & operator>>( IStreamBase & stream, Tile & tile );
+
+    // Writes all map tiles as a set of per-field arrays followed by a single table of object parts,
+    // so most of the data goes to the stream as bulk copies instead of many small per-tile writes.
+    void saveTiles( OStreamBase & stream, const std::vector<Tile> & tiles );
+    void loadTiles( IStreamBase & stream, std::vector<Tile> & tiles );
 }
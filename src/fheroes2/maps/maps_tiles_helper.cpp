@@ -58,17 +58,17 @@
 
 namespace
 {
-    void updateMonsterPopulationOnTile( Maps::Tile & tile )
+    void updateMonsterPopulationOnTile( Maps::Tile & tile, const bool markMonsterDataChanged )
     {
         const Troop & troop = getTroopFromTile( tile );
         const uint32_t troopCount = troop.GetCount();
 
         if ( troopCount == 0 ) {
-            Maps::setMonsterCountOnTile( tile, troop.GetRNDSize() );
+            Maps::setMonsterCountOnTile( tile, troop.GetRNDSize(), markMonsterDataChanged );
         }
         else {
             const uint32_t bonusUnit = ( Rand::Get( 1, 7 ) <= ( troopCount % 7 ) ) ? 1 : 0;
-            Maps::setMonsterCountOnTile( tile, troopCount * 8 / 7 + bonusUnit );
+            Maps::setMonsterCountOnTile( tile, troopCount * 8 / 7 + bonusUnit, markMonsterDataChanged );
         }
     }
 
@@ -334,6 +334,32 @@ namespace
 
         return true;
     }
+
+    // Only the tiles covered by the object and its neighbours need to have their passability updated after the object is placed.
+    void updateObjectAreaPassabilities( const Maps::Tile & tile, const Maps::ObjectInfo & info )
+    {
+        const fheroes2::Point position = Maps::GetPoint( tile.GetIndex() );
+
+        fheroes2::Point minOffset;
+        fheroes2::Point maxOffset;
+
+        const auto updateBounds = [&minOffset, &maxOffset]( const fheroes2::Point & offset ) {
+            minOffset.x = std::min( minOffset.x, offset.x );
+            minOffset.y = std::min( minOffset.y, offset.y );
+            maxOffset.x = std::max( maxOffset.x, offset.x );
+            maxOffset.y = std::max( maxOffset.y, offset.y );
+        };
+
+        for ( const auto & objectPart : info.groundLevelParts ) {
+            updateBounds( objectPart.tileOffset );
+        }
+
+        for ( const auto & objectPart : info.topLevelParts ) {
+            updateBounds( objectPart.tileOffset );
+        }
+
+        world.updatePassabilities( { position.x + minOffset.x, position.y + minOffset.y, maxOffset.x - minOffset.x + 1, maxOffset.y - minOffset.y + 1 } );
+    }
 }
 
 namespace Maps
@@ -892,7 +918,7 @@ namespace Maps
         return 0;
     }
 
-    void setMonsterCountOnTile( Tile & tile, uint32_t count )
+    void setMonsterCountOnTile( Tile & tile, uint32_t count, const bool markMonsterDataChanged /* = true */ )
     {
         switch ( tile.getMainObjectType( false ) ) {
         case MP2::OBJ_ABANDONED_MINE:
@@ -920,6 +946,10 @@ namespace Maps
         case MP2::OBJ_WATCH_TOWER:
         case MP2::OBJ_WATER_ALTAR:
             tile.metadata()[0] = count;
+
+            if ( markMonsterDataChanged ) {
+                world.markMonsterDataChanged();
+            }
             return;
         default:
             // Why are you calling this function for an unsupported object type?
@@ -928,7 +958,7 @@ namespace Maps
         }
     }
 
-    void updateDwellingPopulationOnTile( Tile & tile, const bool isFirstLoad )
+    void updateDwellingPopulationOnTile( Tile & tile, const bool isFirstLoad, const bool markMonsterDataChanged /* = true */ )
     {
         uint32_t count = isFirstLoad ? 0 : getMonsterCountFromTile( tile );
         const MP2::MapObjectType objectType = tile.getMainObjectType( false );
@@ -1012,10 +1042,10 @@ namespace Maps
         }
 
         assert( count > 0 );
-        setMonsterCountOnTile( tile, count );
+        setMonsterCountOnTile( tile, count, markMonsterDataChanged );
     }
 
-    void updateObjectInfoTile( Tile & tile, const bool isFirstLoad )
+    void updateObjectInfoTile( Tile & tile, const bool isFirstLoad, const bool markMonsterDataChanged /* = true */ )
     {
         switch ( tile.getMainObjectType( false ) ) {
         case MP2::OBJ_WITCHS_HUT:
@@ -1374,7 +1404,7 @@ namespace Maps
                     tile.setMainObjectType( MP2::OBJ_SEA_CHEST );
                 }
 
-                updateObjectInfoTile( tile, isFirstLoad );
+                updateObjectInfoTile( tile, isFirstLoad, markMonsterDataChanged );
                 return;
             }
 
@@ -1633,7 +1663,7 @@ namespace Maps
         case MP2::OBJ_ABANDONED_MINE:
             // The number of Ghosts is set only when loading the map and does not change anymore.
             if ( isFirstLoad ) {
-                setMonsterCountOnTile( tile, Rand::Get( 30, 60 ) );
+                setMonsterCountOnTile( tile, Rand::Get( 30, 60 ), markMonsterDataChanged );
             }
             break;
 
@@ -1652,19 +1682,19 @@ namespace Maps
             assert( isFirstLoad );
 
             updateRandomArtifact( tile );
-            updateObjectInfoTile( tile, isFirstLoad );
+            updateObjectInfoTile( tile, isFirstLoad, markMonsterDataChanged );
             return;
 
         case MP2::OBJ_RANDOM_RESOURCE:
             assert( isFirstLoad );
 
             updateRandomResource( tile );
-            updateObjectInfoTile( tile, isFirstLoad );
+            updateObjectInfoTile( tile, isFirstLoad, markMonsterDataChanged );
             return;
 
         case MP2::OBJ_MONSTER:
             if ( world.CountWeek() > 1 )
-                updateMonsterPopulationOnTile( tile );
+                updateMonsterPopulationOnTile( tile, markMonsterDataChanged );
             else
                 updateMonsterInfoOnTile( tile );
             break;
@@ -1677,13 +1707,13 @@ namespace Maps
             assert( isFirstLoad );
 
             updateRandomMonster( tile );
-            updateObjectInfoTile( tile, isFirstLoad );
+            updateObjectInfoTile( tile, isFirstLoad, markMonsterDataChanged );
             return;
 
         case MP2::OBJ_GENIE_LAMP:
             // The number of Genies is set when loading the map and does not change anymore
             if ( isFirstLoad ) {
-                setMonsterCountOnTile( tile, Rand::Get( 2, 4 ) );
+                setMonsterCountOnTile( tile, Rand::Get( 2, 4 ), markMonsterDataChanged );
             }
             break;
 
@@ -1708,7 +1738,7 @@ namespace Maps
         case MP2::OBJ_WAGON_CAMP:
         case MP2::OBJ_WATCH_TOWER:
         case MP2::OBJ_WATER_ALTAR:
-            updateDwellingPopulationOnTile( tile, isFirstLoad );
+            updateDwellingPopulationOnTile( tile, isFirstLoad, markMonsterDataChanged );
             break;
 
         case MP2::OBJ_EVENT:
@@ -2247,7 +2277,7 @@ namespace Maps
             tile.metadata()[1] = info.metadata[1];
 
             if ( updateMapPassabilities ) {
-                world.updatePassabilities();
+                updateObjectAreaPassabilities( tile, info );
             }
             return true;
         case MP2::OBJ_CASTLE:
@@ -2258,7 +2288,7 @@ namespace Maps
             }
 
             if ( updateMapPassabilities ) {
-                world.updatePassabilities();
+                updateObjectAreaPassabilities( tile, info );
             }
             return true;
         case MP2::OBJ_MAGIC_GARDEN:
@@ -2273,7 +2303,7 @@ namespace Maps
             tile.metadata()[1] = 1;
 
             if ( updateMapPassabilities ) {
-                world.updatePassabilities();
+                updateObjectAreaPassabilities( tile, info );
             }
             return true;
         default:
@@ -2285,7 +2315,7 @@ namespace Maps
         }
 
         if ( updateMapPassabilities ) {
-            world.updatePassabilities();
+            updateObjectAreaPassabilities( tile, info );
         }
 
         return true;
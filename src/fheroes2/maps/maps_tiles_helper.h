@@ -146,11 +146,14 @@ namespace Maps
     void resetObjectMetadata( Tile & tile );
 
     uint32_t getMonsterCountFromTile( const Tile & tile );
-    void setMonsterCountOnTile( Tile & tile, uint32_t count );
 
-    void updateDwellingPopulationOnTile( Tile & tile, const bool isFirstLoad );
+    // Functions below mark monster data of the world as changed unless 'markMonsterDataChanged' is false. Only the latter can be called
+    // for different tiles concurrently, the caller is responsible to call World::markMonsterDataChanged() once all tiles are updated.
+    void setMonsterCountOnTile( Tile & tile, uint32_t count, const bool markMonsterDataChanged = true );
 
-    void updateObjectInfoTile( Tile & tile, const bool isFirstLoad );
+    void updateDwellingPopulationOnTile( Tile & tile, const bool isFirstLoad, const bool markMonsterDataChanged = true );
+
+    void updateObjectInfoTile( Tile & tile, const bool isFirstLoad, const bool markMonsterDataChanged = true );
 
     void updateMonsterInfoOnTile( Tile & tile );
 
@@ -29,10 +29,12 @@
 #include <ostream>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "agg_image.h"
 #include "color.h"
 #include "direction.h"
+#include "frame_arena.h"
 #include "game.h"
 #include "heroes.h"
 #include "icn.h"
@@ -102,7 +104,8 @@ namespace
         assert( part.icnType != MP2::OBJ_ICN_TYPE_UNKNOWN && part.icnIndex != 255 );
 
         const int icn = MP2::getIcnIdFromObjectIcnType( part.icnType );
-        if ( isObjectPartDirectRenderingRestricted( icn ) ) {
+        if ( isObjectPartDirectRenderingRestricted( icn ) || !area.isObjectIcnReady( icn ) ) {
+            // Only the terrain is rendered under the object until its sprites are decoded.
             return;
         }
 
@@ -146,7 +149,7 @@ namespace
         assert( part.icnType != MP2::OBJ_ICN_TYPE_UNKNOWN && part.icnIndex != 255 );
 
         const int mainObjectIcn = MP2::getIcnIdFromObjectIcnType( part.icnType );
-        if ( isTileDirectRenderingRestricted( mainObjectIcn, tile.getMainObjectType() ) ) {
+        if ( isTileDirectRenderingRestricted( mainObjectIcn, tile.getMainObjectType() ) || !area.isObjectIcnReady( mainObjectIcn ) ) {
             return;
         }
 
@@ -628,27 +631,33 @@ namespace
         icnId = ICN::FROTH;
         icnIndex = icnIndex + ( heroMovementIndex % Heroes::heroFrameCountPerTile );
     }
+
+    // Splits the sprite into parts fitting tiles and appends them to the output.
+    void appendSpriteSquares( const fheroes2::Point & spriteOffset, const fheroes2::Sprite & sprite, const int icnId, const uint32_t icnIndex, const bool isFlipped,
+                              fheroes2::FrameVector<fheroes2::ObjectRenderingInfo> & objectInfo )
+    {
+        // These buffers are reused to avoid memory allocations while collecting sprites for every frame.
+        thread_local std::vector<fheroes2::Point> outputSquareInfo;
+        thread_local std::vector<std::pair<fheroes2::Point, fheroes2::Rect>> outputImageInfo;
+
+        outputSquareInfo.clear();
+        outputImageInfo.clear();
+
+        fheroes2::DivideImageBySquares( spriteOffset, sprite, fheroes2::tileWidthPx, outputSquareInfo, outputImageInfo );
+
+        assert( outputSquareInfo.size() == outputImageInfo.size() );
+
+        for ( size_t i = 0; i < outputSquareInfo.size(); ++i ) {
+            objectInfo.emplace_back( outputSquareInfo[i], outputImageInfo[i].first, outputImageInfo[i].second, icnId, icnIndex, isFlipped, static_cast<uint8_t>( 255 ) );
+        }
+    }
 }
 
 namespace Maps
 {
     void redrawEmptyTile( fheroes2::Image & dst, const fheroes2::Point & mp, const Interface::GameArea & area )
     {
-        if ( mp.y == -1 && mp.x >= 0 && mp.x < world.w() ) { // top first row
-            area.DrawTile( dst, fheroes2::AGG::GetTIL( TIL::STON, 20 + ( mp.x % 4 ), 0 ), mp );
-        }
-        else if ( mp.x == world.w() && mp.y >= 0 && mp.y < world.h() ) { // right first row
-            area.DrawTile( dst, fheroes2::AGG::GetTIL( TIL::STON, 24 + ( mp.y % 4 ), 0 ), mp );
-        }
-        else if ( mp.y == world.h() && mp.x >= 0 && mp.x < world.w() ) { // bottom first row
-            area.DrawTile( dst, fheroes2::AGG::GetTIL( TIL::STON, 28 + ( mp.x % 4 ), 0 ), mp );
-        }
-        else if ( mp.x == -1 && mp.y >= 0 && mp.y < world.h() ) { // left first row
-            area.DrawTile( dst, fheroes2::AGG::GetTIL( TIL::STON, 32 + ( mp.y % 4 ), 0 ), mp );
-        }
-        else {
-            area.DrawTile( dst, fheroes2::AGG::GetTIL( TIL::STON, ( std::abs( mp.y ) % 4 ) * 4 + std::abs( mp.x ) % 4, 0 ), mp );
-        }
+        area.DrawTile( dst, getEmptyTileSurface( mp ), mp );
     }
 
     void redrawFlyingGhostsOnMap( fheroes2::Image & dst, const fheroes2::Point & pos, const Interface::GameArea & area, const bool isEditor )
@@ -919,20 +928,39 @@ namespace Maps
         }
     }
 
-    void redrawPassable( const Tile & tile, fheroes2::Image & dst, const PlayerColorsSet friendColors, const Interface::GameArea & area, const bool isEditor )
+    uint32_t getPassableImageKey( const Tile & tile, const bool isEditor )
+    {
+        const bool isActionObject = isEditor ? MP2::isOffGameActionObject( tile.getMainObjectType() ) : MP2::isInGameActionObject( tile.getMainObjectType() );
+        if ( !isActionObject && tile.GetPassable() == DIRECTION_ALL ) {
+            return 0;
+        }
+
+        // Passability directions fit into the lower 16 bits.
+        return 0x20000 | ( isActionObject ? 0x10000 : 0 ) | ( static_cast<uint32_t>( tile.GetPassable() ) & 0xFFFF );
+    }
+
+    void drawPassable( const uint32_t imageKey, fheroes2::Image & dst, const fheroes2::Point & pos )
+    {
+        if ( imageKey == 0 ) {
+            return;
+        }
+
+        const fheroes2::Image & image = PassableViewSurface( static_cast<int>( imageKey & 0xFFFF ), ( imageKey & 0x10000 ) != 0 );
+        fheroes2::Blit( image, dst, pos.x, pos.y );
+    }
+
+    void redrawDebugFog( const Tile & tile, fheroes2::Image & dst, const PlayerColorsSet friendColors, const Interface::GameArea & area )
     {
 #ifdef WITH_DEBUG
         if ( friendColors != 0 && tile.isFog( friendColors ) ) {
             area.BlitOnTile( dst, getDebugFogImage(), 0, 0, Maps::GetPoint( tile.GetIndex() ), false, 255 );
         }
 #else
+        (void)tile;
+        (void)dst;
         (void)friendColors;
+        (void)area;
 #endif
-
-        const bool isActionObject = isEditor ? MP2::isOffGameActionObject( tile.getMainObjectType() ) : MP2::isInGameActionObject( tile.getMainObjectType() );
-        if ( isActionObject || tile.GetPassable() != DIRECTION_ALL ) {
-            area.BlitOnTile( dst, PassableViewSurface( tile.GetPassable(), isActionObject ), 0, 0, Maps::GetPoint( tile.GetIndex() ), false, 255 );
-        }
     }
 
     void redrawBottomLayerObjects( const Tile & tile, fheroes2::Image & dst, bool isPuzzleDraw, const Interface::GameArea & area, const uint8_t level )
@@ -1005,7 +1033,7 @@ namespace Maps
         }
     }
 
-    std::vector<fheroes2::ObjectRenderingInfo> getMonsterSpritesPerTile( const Tile & tile, const bool isEditorMode )
+    void getMonsterSpritesPerTile( const Tile & tile, const bool isEditorMode, fheroes2::FrameVector<fheroes2::ObjectRenderingInfo> & objectInfo )
     {
         assert( tile.getMainObjectType() == MP2::OBJ_MONSTER );
 
@@ -1016,39 +1044,17 @@ namespace Maps
         const fheroes2::Sprite & monsterSprite = fheroes2::AGG::GetICN( icnId, spriteIndices.first );
         const fheroes2::Point monsterSpriteOffset( monsterSprite.x() + monsterImageOffset.x, monsterSprite.y() + monsterImageOffset.y );
 
-        std::vector<fheroes2::Point> outputSquareInfo;
-        std::vector<std::pair<fheroes2::Point, fheroes2::Rect>> outputImageInfo;
-        fheroes2::DivideImageBySquares( monsterSpriteOffset, monsterSprite, fheroes2::tileWidthPx, outputSquareInfo, outputImageInfo );
-
-        assert( outputSquareInfo.size() == outputImageInfo.size() );
-
-        std::vector<fheroes2::ObjectRenderingInfo> objectInfo;
-        for ( size_t i = 0; i < outputSquareInfo.size(); ++i ) {
-            objectInfo.emplace_back( outputSquareInfo[i], outputImageInfo[i].first, outputImageInfo[i].second, icnId, spriteIndices.first, false,
-                                     static_cast<uint8_t>( 255 ) );
-        }
-
-        outputSquareInfo.clear();
-        outputImageInfo.clear();
+        appendSpriteSquares( monsterSpriteOffset, monsterSprite, icnId, spriteIndices.first, false, objectInfo );
 
         if ( spriteIndices.second > 0 ) {
             const fheroes2::Sprite & secondaryMonsterSprite = fheroes2::AGG::GetICN( icnId, spriteIndices.second );
             const fheroes2::Point secondaryMonsterSpriteOffset( secondaryMonsterSprite.x() + monsterImageOffset.x, secondaryMonsterSprite.y() + monsterImageOffset.y );
 
-            fheroes2::DivideImageBySquares( secondaryMonsterSpriteOffset, secondaryMonsterSprite, fheroes2::tileWidthPx, outputSquareInfo, outputImageInfo );
-
-            assert( outputSquareInfo.size() == outputImageInfo.size() );
-
-            for ( size_t i = 0; i < outputSquareInfo.size(); ++i ) {
-                objectInfo.emplace_back( outputSquareInfo[i], outputImageInfo[i].first, outputImageInfo[i].second, icnId, spriteIndices.second, false,
-                                         static_cast<uint8_t>( 255 ) );
-            }
+            appendSpriteSquares( secondaryMonsterSpriteOffset, secondaryMonsterSprite, icnId, spriteIndices.second, false, objectInfo );
         }
-
-        return objectInfo;
     }
 
-    std::vector<fheroes2::ObjectRenderingInfo> getMonsterShadowSpritesPerTile( const Tile & tile, const bool isEditorMode )
+    void getMonsterShadowSpritesPerTile( const Tile & tile, const bool isEditorMode, fheroes2::FrameVector<fheroes2::ObjectRenderingInfo> & objectInfo )
     {
         assert( tile.getMainObjectType() == MP2::OBJ_MONSTER );
 
@@ -1059,39 +1065,17 @@ namespace Maps
         const fheroes2::Sprite & monsterSprite = fheroes2::AGG::GetICN( icnId, spriteIndices.first );
         const fheroes2::Point monsterSpriteOffset( monsterSprite.x() + monsterImageOffset.x, monsterSprite.y() + monsterImageOffset.y );
 
-        std::vector<fheroes2::Point> outputSquareInfo;
-        std::vector<std::pair<fheroes2::Point, fheroes2::Rect>> outputImageInfo;
-        fheroes2::DivideImageBySquares( monsterSpriteOffset, monsterSprite, fheroes2::tileWidthPx, outputSquareInfo, outputImageInfo );
-
-        assert( outputSquareInfo.size() == outputImageInfo.size() );
-
-        std::vector<fheroes2::ObjectRenderingInfo> objectInfo;
-        for ( size_t i = 0; i < outputSquareInfo.size(); ++i ) {
-            objectInfo.emplace_back( outputSquareInfo[i], outputImageInfo[i].first, outputImageInfo[i].second, icnId, spriteIndices.first, false,
-                                     static_cast<uint8_t>( 255 ) );
-        }
-
-        outputSquareInfo.clear();
-        outputImageInfo.clear();
+        appendSpriteSquares( monsterSpriteOffset, monsterSprite, icnId, spriteIndices.first, false, objectInfo );
 
         if ( spriteIndices.second > 0 ) {
             const fheroes2::Sprite & secondaryMonsterSprite = fheroes2::AGG::GetICN( icnId, spriteIndices.second );
             const fheroes2::Point secondaryMonsterSpriteOffset( secondaryMonsterSprite.x() + monsterImageOffset.x, secondaryMonsterSprite.y() + monsterImageOffset.y );
 
-            fheroes2::DivideImageBySquares( secondaryMonsterSpriteOffset, secondaryMonsterSprite, fheroes2::tileWidthPx, outputSquareInfo, outputImageInfo );
-
-            assert( outputSquareInfo.size() == outputImageInfo.size() );
-
-            for ( size_t i = 0; i < outputSquareInfo.size(); ++i ) {
-                objectInfo.emplace_back( outputSquareInfo[i], outputImageInfo[i].first, outputImageInfo[i].second, icnId, spriteIndices.second, false,
-                                         static_cast<uint8_t>( 255 ) );
-            }
+            appendSpriteSquares( secondaryMonsterSpriteOffset, secondaryMonsterSprite, icnId, spriteIndices.second, false, objectInfo );
         }
-
-        return objectInfo;
     }
 
-    std::vector<fheroes2::ObjectRenderingInfo> getBoatSpritesPerTile( const Tile & tile )
+    void getBoatSpritesPerTile( const Tile & tile, fheroes2::FrameVector<fheroes2::ObjectRenderingInfo> & objectInfo )
     {
         // TODO: combine both boat image generation for heroes and empty boats.
         assert( tile.getMainObjectType() == MP2::OBJ_BOAT );
@@ -1107,22 +1091,10 @@ namespace Maps
         const fheroes2::Point boatSpriteOffset( ( isReflected ? ( fheroes2::tileWidthPx + 1 - boatSprite.x() - boatSprite.width() ) : boatSprite.x() ),
                                                 boatSprite.y() + fheroes2::tileWidthPx - 11 );
 
-        std::vector<fheroes2::Point> outputSquareInfo;
-        std::vector<std::pair<fheroes2::Point, fheroes2::Rect>> outputImageInfo;
-        fheroes2::DivideImageBySquares( boatSpriteOffset, boatSprite, fheroes2::tileWidthPx, outputSquareInfo, outputImageInfo );
-
-        assert( outputSquareInfo.size() == outputImageInfo.size() );
-
-        std::vector<fheroes2::ObjectRenderingInfo> objectInfo;
-        for ( size_t i = 0; i < outputSquareInfo.size(); ++i ) {
-            objectInfo.emplace_back( outputSquareInfo[i], outputImageInfo[i].first, outputImageInfo[i].second, icnId, icnIndex, isReflected,
-                                     static_cast<uint8_t>( 255 ) );
-        }
-
-        return objectInfo;
+        appendSpriteSquares( boatSpriteOffset, boatSprite, icnId, icnIndex, isReflected, objectInfo );
     }
 
-    std::vector<fheroes2::ObjectRenderingInfo> getBoatShadowSpritesPerTile( const Tile & tile )
+    void getBoatShadowSpritesPerTile( const Tile & tile, fheroes2::FrameVector<fheroes2::ObjectRenderingInfo> & objectInfo )
     {
         assert( tile.getMainObjectType() == MP2::OBJ_BOAT );
 
@@ -1135,26 +1107,13 @@ namespace Maps
         const fheroes2::Point boatShadowSpriteOffset( boatShadowSprite.x(), fheroes2::tileWidthPx + boatShadowSprite.y() - 11 );
 
         // Shadows cannot be flipped so flip flag is always false.
-        std::vector<fheroes2::Point> outputSquareInfo;
-        std::vector<std::pair<fheroes2::Point, fheroes2::Rect>> outputImageInfo;
-        fheroes2::DivideImageBySquares( boatShadowSpriteOffset, boatShadowSprite, fheroes2::tileWidthPx, outputSquareInfo, outputImageInfo );
-
-        assert( outputSquareInfo.size() == outputImageInfo.size() );
-
-        std::vector<fheroes2::ObjectRenderingInfo> objectInfo;
-        for ( size_t i = 0; i < outputSquareInfo.size(); ++i ) {
-            objectInfo.emplace_back( outputSquareInfo[i], outputImageInfo[i].first, outputImageInfo[i].second, icnId, icnIndex, false, static_cast<uint8_t>( 255 ) );
-        }
-
-        return objectInfo;
+        appendSpriteSquares( boatShadowSpriteOffset, boatShadowSprite, icnId, icnIndex, false, objectInfo );
     }
 
-    std::vector<fheroes2::ObjectRenderingInfo> getMineGuardianSpritesPerTile( const Tile & tile )
+    void getMineGuardianSpritesPerTile( const Tile & tile, fheroes2::FrameVector<fheroes2::ObjectRenderingInfo> & objectInfo )
     {
         assert( tile.getMainObjectType( false ) == MP2::OBJ_MINE );
 
-        std::vector<fheroes2::ObjectRenderingInfo> objectInfo;
-
         const int32_t spellID = Maps::getMineSpellIdFromTile( tile );
         switch ( spellID ) {
         case Spell::SETEGUARDIAN:
@@ -1169,25 +1128,15 @@ namespace Maps
             const uint32_t icnIndex = spellID - Spell::SETEGUARDIAN;
             const fheroes2::Sprite & image = fheroes2::AGG::GetICN( icnId, icnIndex );
 
-            std::vector<fheroes2::Point> outputSquareInfo;
-            std::vector<std::pair<fheroes2::Point, fheroes2::Rect>> outputImageInfo;
-            fheroes2::DivideImageBySquares( { image.x(), image.y() }, image, fheroes2::tileWidthPx, outputSquareInfo, outputImageInfo );
-
-            assert( outputSquareInfo.size() == outputImageInfo.size() );
-
-            for ( size_t i = 0; i < outputSquareInfo.size(); ++i ) {
-                objectInfo.emplace_back( outputSquareInfo[i], outputImageInfo[i].first, outputImageInfo[i].second, icnId, icnIndex, false, static_cast<uint8_t>( 255 ) );
-            }
+            appendSpriteSquares( { image.x(), image.y() }, image, icnId, icnIndex, false, objectInfo );
             break;
         }
         default:
             break;
         }
-
-        return objectInfo;
     }
 
-    std::vector<fheroes2::ObjectRenderingInfo> getHeroSpritesPerTile( const Heroes & hero )
+    void getHeroSpritesPerTile( const Heroes & hero, fheroes2::FrameVector<fheroes2::ObjectRenderingInfo> & objectInfo )
     {
         // Reflected hero sprite should be shifted by 1 pixel to right.
         const bool reflect = doesHeroImageNeedToBeReflected( hero.GetDirection() );
@@ -1217,19 +1166,7 @@ namespace Maps
         const fheroes2::Point heroSpriteOffset( offset.x + ( reflect ? ( fheroes2::tileWidthPx + 1 - spriteHero.x() - spriteHero.width() ) : spriteHero.x() ),
                                                 offset.y + spriteHero.y() + fheroes2::tileWidthPx );
 
-        std::vector<fheroes2::Point> outputSquareInfo;
-        std::vector<std::pair<fheroes2::Point, fheroes2::Rect>> outputImageInfo;
-        fheroes2::DivideImageBySquares( heroSpriteOffset, spriteHero, fheroes2::tileWidthPx, outputSquareInfo, outputImageInfo );
-
-        assert( outputSquareInfo.size() == outputImageInfo.size() );
-
-        std::vector<fheroes2::ObjectRenderingInfo> objectInfo;
-        for ( size_t i = 0; i < outputSquareInfo.size(); ++i ) {
-            objectInfo.emplace_back( outputSquareInfo[i], outputImageInfo[i].first, outputImageInfo[i].second, icnId, icnIndex, reflect, static_cast<uint8_t>( 255 ) );
-        }
-
-        outputSquareInfo.clear();
-        outputImageInfo.clear();
+        appendSpriteSquares( heroSpriteOffset, spriteHero, icnId, icnIndex, reflect, objectInfo );
 
         fheroes2::Point flagOffset;
         getFlagSpriteInfo( hero, flagFrameID, false, flagOffset, icnId, icnIndex );
@@ -1240,16 +1177,7 @@ namespace Maps
                                                                 : spriteFlag.x() + flagOffset.x ),
                                                 offset.y + spriteFlag.y() + flagOffset.y + fheroes2::tileWidthPx );
 
-        fheroes2::DivideImageBySquares( flagSpriteOffset, spriteFlag, fheroes2::tileWidthPx, outputSquareInfo, outputImageInfo );
-
-        assert( outputSquareInfo.size() == outputImageInfo.size() );
-
-        for ( size_t i = 0; i < outputSquareInfo.size(); ++i ) {
-            objectInfo.emplace_back( outputSquareInfo[i], outputImageInfo[i].first, outputImageInfo[i].second, icnId, icnIndex, reflect, static_cast<uint8_t>( 255 ) );
-        }
-
-        outputSquareInfo.clear();
-        outputImageInfo.clear();
+        appendSpriteSquares( flagSpriteOffset, spriteFlag, icnId, icnIndex, reflect, objectInfo );
 
         if ( hero.isShipMaster() && hero.isMoveEnabled() && hero.isInDeepOcean() ) {
             // TODO: draw froth for all boats in deep water, not only for a moving boat.
@@ -1258,18 +1186,11 @@ namespace Maps
             const fheroes2::Point frothSpriteOffset( offset.x + ( reflect ? fheroes2::tileWidthPx - spriteFroth.x() - spriteFroth.width() : spriteFroth.x() ),
                                                      offset.y + spriteFroth.y() + fheroes2::tileWidthPx );
 
-            fheroes2::DivideImageBySquares( frothSpriteOffset, spriteFroth, fheroes2::tileWidthPx, outputSquareInfo, outputImageInfo );
-
-            for ( size_t i = 0; i < outputSquareInfo.size(); ++i ) {
-                objectInfo.emplace_back( outputSquareInfo[i], outputImageInfo[i].first, outputImageInfo[i].second, icnId, icnIndex, reflect,
-                                         static_cast<uint8_t>( 255 ) );
-            }
+            appendSpriteSquares( frothSpriteOffset, spriteFroth, icnId, icnIndex, reflect, objectInfo );
         }
-
-        return objectInfo;
     }
 
-    std::vector<fheroes2::ObjectRenderingInfo> getHeroShadowSpritesPerTile( const Heroes & hero )
+    void getHeroShadowSpritesPerTile( const Heroes & hero, fheroes2::FrameVector<fheroes2::ObjectRenderingInfo> & objectInfo )
     {
         fheroes2::Point offset;
         // Boat sprite has to be shifted so it matches other boats.
@@ -1287,47 +1208,44 @@ namespace Maps
         const fheroes2::Sprite & spriteShadow = fheroes2::AGG::GetICN( icnId, icnIndex );
         const fheroes2::Point shadowSpriteOffset( offset.x + spriteShadow.x(), offset.y + spriteShadow.y() + fheroes2::tileWidthPx );
 
-        std::vector<fheroes2::Point> outputSquareInfo;
-        std::vector<std::pair<fheroes2::Point, fheroes2::Rect>> outputImageInfo;
-        fheroes2::DivideImageBySquares( shadowSpriteOffset, spriteShadow, fheroes2::tileWidthPx, outputSquareInfo, outputImageInfo );
-
-        assert( outputSquareInfo.size() == outputImageInfo.size() );
-
-        std::vector<fheroes2::ObjectRenderingInfo> objectInfo;
-        for ( size_t i = 0; i < outputSquareInfo.size(); ++i ) {
-            objectInfo.emplace_back( outputSquareInfo[i], outputImageInfo[i].first, outputImageInfo[i].second, icnId, icnIndex, false, static_cast<uint8_t>( 255 ) );
-        }
-
-        return objectInfo;
+        appendSpriteSquares( shadowSpriteOffset, spriteShadow, icnId, icnIndex, false, objectInfo );
     }
 
-    std::vector<fheroes2::ObjectRenderingInfo> getEditorHeroSpritesPerTile( const Tile & tile )
+    void getEditorHeroSpritesPerTile( const Tile & tile, fheroes2::FrameVector<fheroes2::ObjectRenderingInfo> & objectInfo )
     {
         assert( tile.getMainObjectType() == MP2::OBJ_HERO );
 
         const uint32_t icnIndex = tile.getMainObjectPart().icnIndex;
         const int icnId{ ICN::MINIHERO };
 
-        const fheroes2::Sprite & boatSprite = fheroes2::AGG::GetICN( icnId, icnIndex );
+        const fheroes2::Sprite & heroSprite = fheroes2::AGG::GetICN( icnId, icnIndex );
 
-        const fheroes2::Point boatSpriteOffset{ 0, 32 - 50 };
+        appendSpriteSquares( { 0, 32 - 50 }, heroSprite, icnId, icnIndex, false, objectInfo );
+    }
 
-        std::vector<fheroes2::Point> outputSquareInfo;
-        std::vector<std::pair<fheroes2::Point, fheroes2::Rect>> outputImageInfo;
-        fheroes2::DivideImageBySquares( boatSpriteOffset, boatSprite, fheroes2::tileWidthPx, outputSquareInfo, outputImageInfo );
+    const fheroes2::Image & getTileSurface( const Tile & tile )
+    {
+        return fheroes2::AGG::GetTIL( TIL::GROUND32, tile.getTerrainImageIndex(), ( tile.getTerrainFlags() & 0x3 ) );
+    }
 
-        assert( outputSquareInfo.size() == outputImageInfo.size() );
+    const fheroes2::Image & getEmptyTileSurface( const fheroes2::Point & mp )
+    {
+        if ( mp.y == -1 && mp.x >= 0 && mp.x < world.w() ) { // top first row
+            return fheroes2::AGG::GetTIL( TIL::STON, 20 + ( mp.x % 4 ), 0 );
+        }
 
-        std::vector<fheroes2::ObjectRenderingInfo> objectInfo;
-        for ( size_t i = 0; i < outputSquareInfo.size(); ++i ) {
-            objectInfo.emplace_back( outputSquareInfo[i], outputImageInfo[i].first, outputImageInfo[i].second, icnId, icnIndex, false, static_cast<uint8_t>( 255 ) );
+        if ( mp.x == world.w() && mp.y >= 0 && mp.y < world.h() ) { // right first row
+            return fheroes2::AGG::GetTIL( TIL::STON, 24 + ( mp.y % 4 ), 0 );
         }
 
-        return objectInfo;
-    }
+        if ( mp.y == world.h() && mp.x >= 0 && mp.x < world.w() ) { // bottom first row
+            return fheroes2::AGG::GetTIL( TIL::STON, 28 + ( mp.x % 4 ), 0 );
+        }
 
-    const fheroes2::Image & getTileSurface( const Tile & tile )
-    {
-        return fheroes2::AGG::GetTIL( TIL::GROUND32, tile.getTerrainImageIndex(), ( tile.getTerrainFlags() & 0x3 ) );
+        if ( mp.x == -1 && mp.y >= 0 && mp.y < world.h() ) { // left first row
+            return fheroes2::AGG::GetTIL( TIL::STON, 32 + ( mp.y % 4 ), 0 );
+        }
+
+        return fheroes2::AGG::GetTIL( TIL::STON, ( std::abs( mp.y ) % 4 ) * 4 + std::abs( mp.x ) % 4, 0 );
     }
 }
@@ -21,9 +21,9 @@
 #pragma once
 
 #include <cstdint>
-#include <vector>
 
 #include "color.h"
+#include "frame_arena.h"
 #include "math_base.h"
 
 class Heroes;
@@ -57,20 +57,31 @@ namespace Maps
 
     void drawFog( const Tile & tile, fheroes2::Image & dst, const Interface::GameArea & area );
 
-    void redrawPassable( const Tile & tile, fheroes2::Image & dst, const PlayerColorsSet friendColors, const Interface::GameArea & area, const bool isEditor );
+    // Returns a key of the passability image of the tile or 0 if nothing has to be drawn for the tile.
+    uint32_t getPassableImageKey( const Tile & tile, const bool isEditor );
+
+    // Draws the passability image with the given key at the given position.
+    void drawPassable( const uint32_t imageKey, fheroes2::Image & dst, const fheroes2::Point & pos );
+
+    // Marks tiles hidden for the given players. It works only in debug builds.
+    void redrawDebugFog( const Tile & tile, fheroes2::Image & dst, const PlayerColorsSet friendColors, const Interface::GameArea & area );
 
     void redrawBottomLayerObjects( const Tile & tile, fheroes2::Image & dst, bool isPuzzleDraw, const Interface::GameArea & area, const uint8_t level );
 
     void drawByObjectIcnType( const Tile & tile, fheroes2::Image & output, const Interface::GameArea & area, const MP2::ObjectIcnType objectIcnType );
 
-    std::vector<fheroes2::ObjectRenderingInfo> getMonsterSpritesPerTile( const Tile & tile, const bool isEditorMode );
-    std::vector<fheroes2::ObjectRenderingInfo> getMonsterShadowSpritesPerTile( const Tile & tile, const bool isEditorMode );
-    std::vector<fheroes2::ObjectRenderingInfo> getBoatSpritesPerTile( const Tile & tile );
-    std::vector<fheroes2::ObjectRenderingInfo> getBoatShadowSpritesPerTile( const Tile & tile );
-    std::vector<fheroes2::ObjectRenderingInfo> getMineGuardianSpritesPerTile( const Tile & tile );
-    std::vector<fheroes2::ObjectRenderingInfo> getHeroSpritesPerTile( const Heroes & hero );
-    std::vector<fheroes2::ObjectRenderingInfo> getHeroShadowSpritesPerTile( const Heroes & hero );
-    std::vector<fheroes2::ObjectRenderingInfo> getEditorHeroSpritesPerTile( const Tile & tile );
+    // The following functions append sprite parts to the output so the same buffer can be reused for all tiles.
+    void getMonsterSpritesPerTile( const Tile & tile, const bool isEditorMode, fheroes2::FrameVector<fheroes2::ObjectRenderingInfo> & objectInfo );
+    void getMonsterShadowSpritesPerTile( const Tile & tile, const bool isEditorMode, fheroes2::FrameVector<fheroes2::ObjectRenderingInfo> & objectInfo );
+    void getBoatSpritesPerTile( const Tile & tile, fheroes2::FrameVector<fheroes2::ObjectRenderingInfo> & objectInfo );
+    void getBoatShadowSpritesPerTile( const Tile & tile, fheroes2::FrameVector<fheroes2::ObjectRenderingInfo> & objectInfo );
+    void getMineGuardianSpritesPerTile( const Tile & tile, fheroes2::FrameVector<fheroes2::ObjectRenderingInfo> & objectInfo );
+    void getHeroSpritesPerTile( const Heroes & hero, fheroes2::FrameVector<fheroes2::ObjectRenderingInfo> & objectInfo );
+    void getHeroShadowSpritesPerTile( const Heroes & hero, fheroes2::FrameVector<fheroes2::ObjectRenderingInfo> & objectInfo );
+    void getEditorHeroSpritesPerTile( const Tile & tile, fheroes2::FrameVector<fheroes2::ObjectRenderingInfo> & objectInfo );
 
     const fheroes2::Image & getTileSurface( const Tile & tile );
+
+    // Returns the image of a tile outside the world borders.
+    const fheroes2::Image & getEmptyTileSurface( const fheroes2::Point & mp );
 }
@@ -221,12 +221,12 @@ uint32_t Monster::GetRNDSize() const
 
 bool Monster::isAbilityPresent( const fheroes2::MonsterAbilityType abilityType ) const
 {
-    return fheroes2::isAbilityPresent( fheroes2::getMonsterData( id ).battleStats.abilities, abilityType );
+    return ( fheroes2::getMonsterData( id ).battleStats.abilityMask & fheroes2::getMonsterAbilityMask( abilityType ) ) != 0;
 }
 
 bool Monster::isWeaknessPresent( const fheroes2::MonsterWeaknessType weaknessType ) const
 {
-    return fheroes2::isWeaknessPresent( fheroes2::getMonsterData( id ).battleStats.weaknesses, weaknessType );
+    return ( fheroes2::getMonsterData( id ).battleStats.weaknessMask & fheroes2::getMonsterWeaknessMask( weaknessType ) ) != 0;
 }
 
 Monster Monster::GetDowngrade() const
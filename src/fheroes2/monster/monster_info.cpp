@@ -40,8 +40,6 @@
 
 namespace
 {
-    std::vector<fheroes2::MonsterData> monsterData;
-
     double getMonsterBaseStrength( const fheroes2::MonsterData & data )
     {
         const fheroes2::MonsterBattleStats & battleStats = data.battleStats;
@@ -131,7 +129,7 @@ namespace
         return sqrt( damagePotential * effectiveHP ) * monsterSpecial;
     }
 
-    void populateMonsterData()
+    std::vector<fheroes2::MonsterData> createMonsterData()
     {
         const int monsterIcnIds[Monster::MONSTER_COUNT]
             = { ICN::UNKNOWN,  ICN::PEASANT,  ICN::ARCHER,   ICN::ARCHER2,  ICN::PIKEMAN,  ICN::PIKEMAN2, ICN::SWORDSMN, ICN::SWORDSM2, ICN::CAVALRYR,
@@ -381,6 +379,7 @@ namespace
                 { gettext_noop( "Random Monster 3" ), gettext_noop( "Random Monsters 3" ), 0, Race::NONE, 3, { 0, 0, 0, 0, 0, 0, 0 } },
                 { gettext_noop( "Random Monster 4" ), gettext_noop( "Random Monsters 4" ), 0, Race::NONE, 4, { 0, 0, 0, 0, 0, 0, 0 } } };
 
+        std::vector<fheroes2::MonsterData> monsterData;
         monsterData.reserve( Monster::MONSTER_COUNT );
 
         for ( int i = 0; i < Monster::MONSTER_COUNT; ++i ) {
@@ -560,12 +559,31 @@ namespace
         monsterData[Monster::WATER_ELEMENT].battleStats.weaknesses.emplace_back( fheroes2::MonsterWeaknessType::DOUBLE_DAMAGE_FROM_FIRE_SPELLS );
         monsterData[Monster::WATER_ELEMENT].battleStats.weaknesses.emplace_back( fheroes2::MonsterWeaknessType::DOUBLE_DAMAGE_FROM_FIRE_CREATURES );
 
-        // Calculate base value of monster strength.
         for ( fheroes2::MonsterData & data : monsterData ) {
-            data.battleStats.monsterBaseStrength = getMonsterBaseStrength( data );
+            fheroes2::MonsterBattleStats & battleStats = data.battleStats;
+
+            // Build the ability and weakness masks for quick lookups.
+            for ( const fheroes2::MonsterAbility & ability : battleStats.abilities ) {
+                battleStats.abilityMask |= fheroes2::getMonsterAbilityMask( ability.type );
+            }
+            for ( const fheroes2::MonsterWeakness & weakness : battleStats.weaknesses ) {
+                battleStats.weaknessMask |= fheroes2::getMonsterWeaknessMask( weakness.type );
+            }
+
+            // Calculate base value of monster strength.
+            battleStats.monsterBaseStrength = getMonsterBaseStrength( data );
         }
 
         // TODO: verify that no duplicates of abilities and weaknesses exist.
+
+        return monsterData;
+    }
+
+    const std::vector<fheroes2::MonsterData> & getAllMonsterData()
+    {
+        // The initialization of a function-local static is thread-safe, while this data is accessed from multiple AI threads.
+        static const std::vector<fheroes2::MonsterData> monsterData = createMonsterData();
+        return monsterData;
     }
 
     void removeDuplicateSpell( std::set<int> & sortedSpellIds, const int massSpellId, const int spellId )
@@ -596,9 +614,7 @@ namespace fheroes2
 {
     const MonsterData & getMonsterData( const int monsterId )
     {
-        if ( monsterData.empty() ) {
-            populateMonsterData();
-        }
+        const std::vector<MonsterData> & monsterData = getAllMonsterData();
 
         assert( monsterId >= 0 && static_cast<size_t>( monsterId ) < monsterData.size() );
         if ( monsterId < 0 || static_cast<size_t>( monsterId ) >= monsterData.size() ) {
@@ -746,9 +762,7 @@ namespace fheroes2
 
     std::string getMonsterDescription( const int monsterId )
     {
-        if ( monsterData.empty() ) {
-            populateMonsterData();
-        }
+        const std::vector<MonsterData> & monsterData = getAllMonsterData();
 
         assert( monsterId >= 0 && static_cast<size_t>( monsterId ) < monsterData.size() );
         if ( monsterId < 0 || static_cast<size_t>( monsterId ) >= monsterData.size() ) {
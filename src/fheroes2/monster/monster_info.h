@@ -85,6 +85,20 @@ namespace fheroes2
         EXTRA_DAMAGE_FROM_CERTAIN_SPELL
     };
 
+    constexpr uint64_t getMonsterAbilityMask( const MonsterAbilityType type )
+    {
+        static_assert( static_cast<int>( MonsterAbilityType::SOUL_EATER ) < 64, "Monster ability types do not fit into the mask" );
+
+        return uint64_t{ 1 } << static_cast<int>( type );
+    }
+
+    constexpr uint32_t getMonsterWeaknessMask( const MonsterWeaknessType type )
+    {
+        static_assert( static_cast<int>( MonsterWeaknessType::EXTRA_DAMAGE_FROM_CERTAIN_SPELL ) < 32, "Monster weakness types do not fit into the mask" );
+
+        return uint32_t{ 1 } << static_cast<int>( type );
+    }
+
     struct MonsterAbility
     {
         explicit MonsterAbility( const MonsterAbilityType type_ )
@@ -174,6 +188,10 @@ namespace fheroes2
 
         std::vector<MonsterAbility> abilities;
         std::vector<MonsterWeakness> weaknesses;
+
+        // Bit masks of all ability and weakness types listed above.
+        uint64_t abilityMask{ 0 };
+        uint32_t weaknessMask{ 0 };
     };
 
     struct MonsterGeneralStats
@@ -88,6 +88,15 @@ namespace
             ++iter;
         }
     }
+
+    // Returns true if an artifact with the same ID is present in the bag before the given position.
+    // It is used instead of a set of met IDs to avoid memory allocations in frequently called methods.
+    bool isRepeatedArtifact( const BagArtifacts & bag, const BagArtifacts::const_iterator iter )
+    {
+        const int artifactId = iter->GetID();
+
+        return std::any_of( bag.begin(), iter, [artifactId]( const Artifact & artifact ) { return artifact.GetID() == artifactId; } );
+    }
 }
 
 const char * Artifact::GetName() const
@@ -569,6 +578,10 @@ int32_t BagArtifacts::getTotalArtifactEffectValue( const fheroes2::ArtifactBonus
 
     if ( fheroes2::isBonusCumulative( bonus ) ) {
         for ( const Artifact & artifact : *this ) {
+            if ( !artifact.isValid() ) {
+                continue;
+            }
+
             const std::vector<fheroes2::ArtifactBonus> & bonuses = fheroes2::getArtifactData( artifact.GetID() ).bonuses;
             auto bonusIter = std::find( bonuses.begin(), bonuses.end(), fheroes2::ArtifactBonus( bonus ) );
             if ( bonusIter != bonuses.end() ) {
@@ -577,14 +590,14 @@ int32_t BagArtifacts::getTotalArtifactEffectValue( const fheroes2::ArtifactBonus
         }
     }
     else {
-        std::set<int> usedArtifactIds;
-        for ( const Artifact & artifact : *this ) {
-            const int artifactId = artifact.GetID();
-            if ( !usedArtifactIds.insert( artifactId ).second ) {
-                // The artifact is present in multiple copies.
+        for ( auto iter = begin(); iter != end(); ++iter ) {
+            if ( !iter->isValid() || isRepeatedArtifact( *this, iter ) ) {
+                // The slot is empty or the artifact is present in multiple copies.
                 continue;
             }
 
+            const int artifactId = iter->GetID();
+
             const std::vector<fheroes2::ArtifactBonus> & bonuses = fheroes2::getArtifactData( artifactId ).bonuses;
             auto bonusIter = std::find( bonuses.begin(), bonuses.end(), fheroes2::ArtifactBonus( bonus ) );
             if ( bonusIter != bonuses.end() ) {
@@ -625,14 +638,15 @@ int32_t BagArtifacts::getTotalArtifactEffectValue( const fheroes2::ArtifactBonus
         }
     }
     else {
-        std::set<int> usedArtifactIds;
-        for ( const Artifact & artifact : *this ) {
-            const int artifactId = artifact.GetID();
-            if ( !usedArtifactIds.insert( artifactId ).second ) {
-                // The artifact is present in multiple copies.
+        for ( auto iter = begin(); iter != end(); ++iter ) {
+            if ( !iter->isValid() || isRepeatedArtifact( *this, iter ) ) {
+                // The slot is empty or the artifact is present in multiple copies.
                 continue;
             }
 
+            const Artifact & artifact = *iter;
+            const int artifactId = artifact.GetID();
+
             const std::vector<fheroes2::ArtifactBonus> & bonuses = fheroes2::getArtifactData( artifactId ).bonuses;
             auto bonusIter = std::find( bonuses.begin(), bonuses.end(), fheroes2::ArtifactBonus( bonus ) );
             if ( bonusIter != bonuses.end() ) {
@@ -659,6 +673,10 @@ int32_t BagArtifacts::getTotalArtifactEffectValue( const fheroes2::ArtifactCurse
 
     if ( fheroes2::isCurseCumulative( curse ) ) {
         for ( const Artifact & artifact : *this ) {
+            if ( !artifact.isValid() ) {
+                continue;
+            }
+
             const std::vector<fheroes2::ArtifactCurse> & curses = fheroes2::getArtifactData( artifact.GetID() ).curses;
             auto curseIter = std::find( curses.begin(), curses.end(), fheroes2::ArtifactCurse( curse ) );
             if ( curseIter != curses.end() ) {
@@ -667,14 +685,14 @@ int32_t BagArtifacts::getTotalArtifactEffectValue( const fheroes2::ArtifactCurse
         }
     }
     else {
-        std::set<int> usedArtifactIds;
-        for ( const Artifact & artifact : *this ) {
-            const int artifactId = artifact.GetID();
-            if ( !usedArtifactIds.insert( artifactId ).second ) {
-                // The artifact is present in multiple copies.
+        for ( auto iter = begin(); iter != end(); ++iter ) {
+            if ( !iter->isValid() || isRepeatedArtifact( *this, iter ) ) {
+                // The slot is empty or the artifact is present in multiple copies.
                 continue;
             }
 
+            const int artifactId = iter->GetID();
+
             const std::vector<fheroes2::ArtifactCurse> & curses = fheroes2::getArtifactData( artifactId ).curses;
             auto curseIter = std::find( curses.begin(), curses.end(), fheroes2::ArtifactCurse( curse ) );
             if ( curseIter != curses.end() ) {
@@ -715,14 +733,15 @@ int32_t BagArtifacts::getTotalArtifactEffectValue( const fheroes2::ArtifactCurse
         }
     }
     else {
-        std::set<int> usedArtifactIds;
-        for ( const Artifact & artifact : *this ) {
-            const int artifactId = artifact.GetID();
-            if ( !usedArtifactIds.insert( artifactId ).second ) {
-                // The artifact is present in multiple copies.
+        for ( auto iter = begin(); iter != end(); ++iter ) {
+            if ( !iter->isValid() || isRepeatedArtifact( *this, iter ) ) {
+                // The slot is empty or the artifact is present in multiple copies.
                 continue;
             }
 
+            const Artifact & artifact = *iter;
+            const int artifactId = artifact.GetID();
+
             const std::vector<fheroes2::ArtifactCurse> & curses = fheroes2::getArtifactData( artifactId ).curses;
             auto curseIter = std::find( curses.begin(), curses.end(), fheroes2::ArtifactCurse( curse ) );
             if ( curseIter != curses.end() ) {
@@ -750,14 +769,14 @@ std::vector<int32_t> BagArtifacts::getTotalArtifactMultipliedPercent( const fher
 
     std::vector<int32_t> values;
 
-    std::set<int> usedArtifactIds;
-    for ( const Artifact & artifact : *this ) {
-        const int artifactId = artifact.GetID();
-        if ( !usedArtifactIds.insert( artifactId ).second ) {
-            // The artifact is present in multiple copies.
+    for ( auto iter = begin(); iter != end(); ++iter ) {
+        if ( !iter->isValid() || isRepeatedArtifact( *this, iter ) ) {
+            // The slot is empty or the artifact is present in multiple copies.
             continue;
         }
 
+        const int artifactId = iter->GetID();
+
         const std::vector<fheroes2::ArtifactBonus> & bonuses = fheroes2::getArtifactData( artifactId ).bonuses;
         auto bonusIter = std::find( bonuses.begin(), bonuses.end(), fheroes2::ArtifactBonus( bonus ) );
         if ( bonusIter != bonuses.end() ) {
@@ -778,14 +797,14 @@ std::vector<int32_t> BagArtifacts::getTotalArtifactMultipliedPercent( const fher
 
     std::vector<int32_t> values;
 
-    std::set<int> usedArtifactIds;
-    for ( const Artifact & artifact : *this ) {
-        const int artifactId = artifact.GetID();
-        if ( !usedArtifactIds.insert( artifactId ).second ) {
-            // The artifact is present in multiple copies.
+    for ( auto iter = begin(); iter != end(); ++iter ) {
+        if ( !iter->isValid() || isRepeatedArtifact( *this, iter ) ) {
+            // The slot is empty or the artifact is present in multiple copies.
             continue;
         }
 
+        const int artifactId = iter->GetID();
+
         const std::vector<fheroes2::ArtifactCurse> & curses = fheroes2::getArtifactData( artifactId ).curses;
         auto curseIter = std::find( curses.begin(), curses.end(), fheroes2::ArtifactCurse( curse ) );
         if ( curseIter != curses.end() ) {
@@ -44,11 +44,17 @@ void UltimateArtifact::Set( const int32_t position, const Artifact & artifact )
     // harder to find, but it should be shown behind one of the last four central pieces of the puzzle.
     _offset.x = Rand::Get( 0, 4 ) - 2;
     _offset.y = Rand::Get( 0, 2 ) - 1;
+
+    _puzzleMapSurface.clear();
 }
 
-fheroes2::Image UltimateArtifact::GetPuzzleMapSurface() const
+const fheroes2::Image & UltimateArtifact::GetPuzzleMapSurface() const
 {
-    return Interface::GameArea::GenerateUltimateArtifactAreaSurface( _index, _offset );
+    if ( _puzzleMapSurface.empty() ) {
+        _puzzleMapSurface = Interface::GameArea::GenerateUltimateArtifactAreaSurface( _index, _offset );
+    }
+
+    return _puzzleMapSurface;
 }
 
 const Artifact & UltimateArtifact::GetArtifact() const
@@ -68,6 +74,8 @@ void UltimateArtifact::Reset()
     _offset = fheroes2::Point();
     _index = -1;
     _isFound = false;
+
+    _puzzleMapSurface.clear();
 }
 
 OStreamBase & operator<<( OStreamBase & stream, const UltimateArtifact & ultimate )
@@ -77,6 +85,8 @@ OStreamBase & operator<<( OStreamBase & stream, const UltimateArtifact & ultimat
 
 IStreamBase & operator>>( IStreamBase & stream, UltimateArtifact & ultimate )
 {
+    ultimate._puzzleMapSurface.clear();
+
     Artifact & artifact = ultimate;
     return stream >> artifact >> ultimate._index >> ultimate._isFound >> ultimate._offset;
 }
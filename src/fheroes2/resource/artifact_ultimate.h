@@ -57,7 +57,9 @@ public:
     void Set( const int32_t position, const Artifact & artifact );
     void Reset();
 
-    fheroes2::Image GetPuzzleMapSurface() const;
+    // Returns the image of the area around the Ultimate Artifact shown by the puzzle map. The image depends only on the map itself, so it
+    // is rendered once and cached until the position of the artifact changes. Revealed pieces of the puzzle are drawn over this image.
+    const fheroes2::Image & GetPuzzleMapSurface() const;
     const Artifact & GetArtifact() const;
 
 private:
@@ -67,4 +69,6 @@ private:
     fheroes2::Point _offset;
     int32_t _index;
     bool _isFound;
+
+    mutable fheroes2::Image _puzzleMapSurface;
 };
@@ -36,6 +36,7 @@
 #include "game.h"
 #include "game_io.h"
 #include "logging.h"
+#include "profiler.h"
 #include "race.h"
 #include "render_processor.h"
 #include "save_format_version.h"
@@ -47,6 +48,7 @@
 #include "translations.h"
 #include "ui_language.h"
 #include "version.h"
+#include "zzlib.h"
 
 #define STRINGIFY( DEF ) #DEF
 #define EXPANDDEF( DEF ) STRINGIFY( DEF )
@@ -82,6 +84,7 @@ namespace
         GAME_AUTO_SAVE_AT_BEGINNING_OF_TURN = 0x10000000,
         GAME_SCREEN_SCALING_TYPE_NEAREST = 0x20000000,
         GAME_NUMERIC_ARMY_ESTIMATION_VIEW = 0x40000000,
+        GAME_ICN_DISK_CACHE = 0x80000000,
     };
 
     enum EditorOptions : uint32_t
@@ -112,6 +115,7 @@ Settings::Settings()
     , ai_speed( defaultSpeedDelay )
     , scroll_speed( SCROLL_SPEED_NORMAL )
     , battle_speed( defaultBattleSpeed )
+    , _saveCompressionLevel( Compression::defaultLevel )
     , game_type( 0 )
 {
     _gameOptions.SetModes( GAME_FIRST_RUN );
@@ -200,6 +204,14 @@ bool Settings::Read( const std::string & filePath )
         SetAIMoveSpeed( config.IntParams( "ai speed" ) );
     }
 
+    if ( config.Exists( "ai turn time limit" ) ) {
+        setAITurnTimeLimit( config.IntParams( "ai turn time limit" ) );
+    }
+
+    if ( config.Exists( "save compression level" ) ) {
+        setSaveCompressionLevel( config.IntParams( "save compression level" ) );
+    }
+
     if ( config.Exists( "heroes speed" ) ) {
         SetHeroesMoveSpeed( config.IntParams( "heroes speed" ) );
     }
@@ -263,6 +275,14 @@ bool Settings::Read( const std::string & filePath )
         setNumericArmyEstimationView( config.StrParams( "army estimation view type" ) == "numeric" );
     }
 
+    if ( config.Exists( "icn disk cache" ) ) {
+        setICNDiskCache( config.StrParams( "icn disk cache" ) == "on" );
+    }
+
+    if ( config.Exists( "midi render cache" ) ) {
+        setMidiRenderCache( config.StrParams( "midi render cache" ) == "on" );
+    }
+
     if ( config.Exists( "hide interface" ) ) {
         setHideInterface( config.StrParams( "hide interface" ) == "on" );
     }
@@ -447,6 +467,12 @@ std::string Settings::String() const
     os << std::endl << "# AI movement speed: 0 - 10" << std::endl;
     os << "ai speed = " << ai_speed << std::endl;
 
+    os << std::endl << "# AI turn time limit in seconds: 0 - 3600. 0 means no limit" << std::endl;
+    os << "ai turn time limit = " << _aiTurnTimeLimit << std::endl;
+
+    os << std::endl << "# Compression level of saved games: 1 - 9. Lower values make saving faster, higher values make save files smaller" << std::endl;
+    os << "save compression level = " << _saveCompressionLevel << std::endl;
+
     os << std::endl << "# Battle animation speed: 1 - 10" << std::endl;
     os << "battle speed = " << battle_speed << std::endl;
 
@@ -553,6 +579,12 @@ std::string Settings::String() const
     os << std::endl << "# Show army size estimates: in 'canonical' (few, several, lots, ...) or 'numeric' (1-4, 5-9, 10-19, ...) way" << std::endl;
     os << "army estimation view type = " << ( _gameOptions.Modes( GAME_NUMERIC_ARMY_ESTIMATION_VIEW ) ? "numeric" : "canonical" ) << std::endl;
 
+    os << std::endl << "# Store processed images on disk to speed up the next game start: on/off" << std::endl;
+    os << "icn disk cache = " << ( _gameOptions.Modes( GAME_ICN_DISK_CACHE ) ? "on" : "off" ) << std::endl;
+
+    os << std::endl << "# Render MIDI music tracks to audio files in the background and play them instead of synthesizing MIDI in real time: on/off" << std::endl;
+    os << "midi render cache = " << ( _isMidiRenderCacheEnabled ? "on" : "off" ) << std::endl;
+
     return os.str();
 }
 
@@ -737,6 +769,16 @@ void Settings::SetAIMoveSpeed( int speed )
     ai_speed = std::clamp( speed, 0, 10 );
 }
 
+void Settings::setAITurnTimeLimit( const int seconds )
+{
+    _aiTurnTimeLimit = std::clamp( seconds, 0, 3600 );
+}
+
+void Settings::setSaveCompressionLevel( const int level )
+{
+    _saveCompressionLevel = std::clamp( level, Compression::minLevel, Compression::maxLevel );
+}
+
 void Settings::SetHeroesMoveSpeed( int speed )
 {
     heroes_speed = std::clamp( speed, 1, 10 );
@@ -848,7 +890,11 @@ void Settings::setSystemInfo( const bool enable )
     }
     else {
         _gameOptions.ResetModes( GAME_SYSTEM_INFO );
-        fheroes2::RenderProcessor::instance().disableRenderers();
+
+        // The profiler statistics are displayed by the same renderer.
+        if ( !fheroes2::Profiler::instance().isEnabled() ) {
+            fheroes2::RenderProcessor::instance().disableRenderers();
+        }
     }
 }
 
@@ -892,6 +938,21 @@ void Settings::setNumericArmyEstimationView( const bool enable )
     }
 }
 
+void Settings::setICNDiskCache( const bool enable )
+{
+    if ( enable ) {
+        _gameOptions.SetModes( GAME_ICN_DISK_CACHE );
+    }
+    else {
+        _gameOptions.ResetModes( GAME_ICN_DISK_CACHE );
+    }
+}
+
+void Settings::setMidiRenderCache( const bool enable )
+{
+    _isMidiRenderCacheEnabled = enable;
+}
+
 void Settings::setScreenScalingTypeNearest( const bool enable )
 {
     if ( enable ) {
@@ -956,6 +1017,16 @@ bool Settings::isArmyEstimationViewNumeric() const
     return _gameOptions.Modes( GAME_NUMERIC_ARMY_ESTIMATION_VIEW );
 }
 
+bool Settings::isICNDiskCacheEnabled() const
+{
+    return _gameOptions.Modes( GAME_ICN_DISK_CACHE );
+}
+
+bool Settings::isMidiRenderCacheEnabled() const
+{
+    return _isMidiRenderCacheEnabled;
+}
+
 bool Settings::isScreenScalingTypeNearest() const
 {
     return _gameOptions.Modes( GAME_SCREEN_SCALING_TYPE_NEAREST );
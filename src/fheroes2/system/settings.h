@@ -119,6 +119,18 @@ public:
         return ai_speed;
     }
 
+    // Returns the time limit in seconds for a single AI kingdom turn, 0 means no limit.
+    int AITurnTimeLimit() const
+    {
+        return _aiTurnTimeLimit;
+    }
+
+    // Returns the zlib compression level used for game saves.
+    int saveCompressionLevel() const
+    {
+        return _saveCompressionLevel;
+    }
+
     int BattleSpeed() const
     {
         return battle_speed;
@@ -206,6 +218,8 @@ public:
     bool isHideInterfaceEnabled() const;
     bool isArmyEstimationViewNumeric() const;
     bool isScreenScalingTypeNearest() const;
+    bool isICNDiskCacheEnabled() const;
+    bool isMidiRenderCacheEnabled() const;
     bool isEvilInterfaceEnabled() const;
 
     void setInterfaceType( InterfaceType type )
@@ -274,6 +288,11 @@ public:
     void SetShowStatus( bool );
     // Sets the speed of AI-controlled heroes in the range 0 - 10, 0 means "don't show"
     void SetAIMoveSpeed( int );
+    // Sets the time limit of a single AI kingdom turn in the range 0 - 3600 seconds, 0 means no limit. Once the time is over,
+    // AI heroes go to the first valid target found instead of trying to pick the best one among all heroes.
+    void setAITurnTimeLimit( const int seconds );
+    // Sets the compression level of game saves in the range 1 (the fastest saving) - 9 (the smallest files)
+    void setSaveCompressionLevel( const int level );
     void SetScrollSpeed( int );
     // Sets the speed of human-controlled heroes in the range 1 - 10
     void SetHeroesMoveSpeed( int );
@@ -293,6 +312,8 @@ public:
     void setHideInterface( const bool enable );
     void setNumericArmyEstimationView( const bool enable );
     void setScreenScalingTypeNearest( const bool enable );
+    void setICNDiskCache( const bool enable );
+    void setMidiRenderCache( const bool enable );
 
     void SetSoundVolume( int v );
     void SetMusicVolume( int v );
@@ -387,6 +408,11 @@ public:
 
     void SetProgramPath( const char * path );
 
+    const std::string & getProgramPath() const
+    {
+        return _programPath;
+    }
+
     static std::string GetVersion();
 
     static const std::vector<std::string> & GetRootDirs();
@@ -432,6 +458,11 @@ private:
     int ai_speed;
     int scroll_speed;
     int battle_speed;
+    int _aiTurnTimeLimit{ 0 };
+    int _saveCompressionLevel;
+
+    // All bits of the game options are occupied.
+    bool _isMidiRenderCacheEnabled{ false };
 
     int32_t game_type;
     ZoomLevel _viewWorldZoomLevel{ ZoomLevel::ZoomLevel1 };
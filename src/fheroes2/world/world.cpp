@@ -26,11 +26,17 @@
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <iterator>
 #include <limits>
 #include <optional>
 #include <ostream>
 #include <set>
 #include <tuple>
+#include <utility>
+#include <vector>
 
 #include "ai_planner.h"
 #include "artifact.h"
@@ -49,6 +55,7 @@
 #include "maps_objects.h"
 #include "maps_tiles.h"
 #include "maps_tiles_helper.h"
+#include "math_tools.h"
 #include "mp2.h"
 #include "pairs.h"
 #include "players.h"
@@ -59,6 +66,7 @@
 #include "save_format_version.h"
 #include "serialize.h"
 #include "settings.h"
+#include "thread.h"
 #include "tools.h"
 #include "translations.h"
 #include "ui_font.h"
@@ -67,11 +75,17 @@
 
 namespace
 {
-    bool isTileBlockedForSettingMonster( const int32_t tileId, const int32_t radius, const std::set<int32_t> & excludeTiles )
+    bool isTileBlockedForSettingMonster( const int32_t tileId, const int32_t radius, const std::vector<uint8_t> & excludeTiles )
     {
-        const MapsIndexes & indexes = Maps::getAroundIndexes( tileId, radius );
+        bool isBlocked = false;
 
-        return std::any_of( indexes.cbegin(), indexes.cend(), [&excludeTiles]( const int32_t indexId ) { return excludeTiles.count( indexId ) > 0; } );
+        Maps::forEachAroundIndex( tileId, world.w(), world.h(), radius, [&excludeTiles, &isBlocked]( const int32_t indexId ) {
+            if ( !isBlocked && excludeTiles[indexId] ) {
+                isBlocked = true;
+            }
+        } );
+
+        return isBlocked;
     }
 
     int32_t findSuitableNeighbouringTile( const std::vector<Maps::Tile> & mapTiles, const int32_t tileId, const bool allDirections, Rand::PCG32 & gen )
@@ -126,16 +140,12 @@ namespace
     {
         int32_t count = 0;
 
-        const MapsIndexes & indexes = Maps::getAroundIndexes( tileId );
-
-        for ( const int32_t indexId : indexes ) {
+        Maps::forEachAroundIndex( tileId, world.w(), world.h(), 1, [&mapTiles, &count]( const int32_t indexId ) {
             const Maps::Tile & indexedTile = mapTiles[indexId];
-            if ( indexedTile.isWater() || !isClearGround( indexedTile ) ) {
-                continue;
+            if ( !indexedTile.isWater() && isClearGround( indexedTile ) ) {
+                ++count;
             }
-
-            ++count;
-        }
+        } );
 
         return count;
     }
@@ -150,26 +160,88 @@ MapBaseObject * MapObjects::get( const uint32_t uid ) const
     return nullptr;
 }
 
-std::list<MapBaseObject *> MapObjects::get( const fheroes2::Point & pos ) const
+MapBaseObject * MapObjects::get( const fheroes2::Point & pos ) const
 {
-    std::list<MapBaseObject *> result;
+    MapBaseObject * result = nullptr;
 
-    for ( const auto & [dummy, obj] : _objects ) {
-        assert( obj );
+    const auto [begin, end] = _objectsByPosition.equal_range( _getPositionKey( pos ) );
+    for ( auto iter = begin; iter != end; ++iter ) {
+        MapBaseObject * obj = iter->second;
+        assert( obj != nullptr && obj->isPosition( pos ) );
 
-        if ( !obj->isPosition( pos ) ) {
-            continue;
+        if ( result == nullptr || obj->GetUID() < result->GetUID() ) {
+            result = obj;
         }
-
-        result.push_back( obj.get() );
     }
 
     return result;
 }
 
+void MapObjects::_addToPositionIndex( MapBaseObject & obj )
+{
+    _objectsByPosition.emplace( _getPositionKey( obj.GetCenter() ), &obj );
+}
+
+void MapObjects::_removeFromPositionIndex( const MapBaseObject & obj )
+{
+    const auto [begin, end] = _objectsByPosition.equal_range( _getPositionKey( obj.GetCenter() ) );
+    for ( auto iter = begin; iter != end; ++iter ) {
+        if ( iter->second == &obj ) {
+            _objectsByPosition.erase( iter );
+            return;
+        }
+    }
+
+    // The object has been moved after it was added.
+    assert( 0 );
+}
+
+CapturedObject & CapturedObjects::Get( const int32_t index )
+{
+    const auto [iter, inserted] = try_emplace( index );
+    if ( inserted ) {
+        const ObjectColor & objCol = iter->second.objCol;
+
+        ++_objectCount[objCol];
+        _objectsByColor[objCol.second].insert( index );
+    }
+
+    return iter->second;
+}
+
+void CapturedObjects::_setObjectColor( const int32_t index, CapturedObject & capturedObj, const ObjectColor & objCol )
+{
+    ObjectColor & currentObjCol = capturedObj.objCol;
+    if ( currentObjCol == objCol ) {
+        return;
+    }
+
+    if ( currentObjCol.first == MP2::OBJ_MINE || objCol.first == MP2::OBJ_MINE ) {
+        _isMineCountCacheValid = false;
+    }
+
+    const auto countIter = _objectCount.find( currentObjCol );
+    assert( countIter != _objectCount.end() && countIter->second > 0 );
+
+    if ( --countIter->second == 0 ) {
+        _objectCount.erase( countIter );
+    }
+
+    ++_objectCount[objCol];
+
+    if ( currentObjCol.second != objCol.second ) {
+        _objectsByColor[currentObjCol.second].erase( index );
+        _objectsByColor[objCol.second].insert( index );
+    }
+
+    currentObjCol = objCol;
+}
+
 void CapturedObjects::SetColor( const int32_t index, const PlayerColor color )
 {
-    Get( index ).SetColor( color );
+    CapturedObject & capturedObj = Get( index );
+
+    _setObjectColor( index, capturedObj, { capturedObj.objCol.first, color } );
 }
 
 void CapturedObjects::Set( const int32_t index, const MP2::MapObjectType obj, const PlayerColor color )
@@ -180,45 +252,56 @@ void CapturedObjects::Set( const int32_t index, const MP2::MapObjectType obj, co
         capturedObj.guardians.Reset();
     }
 
-    capturedObj.Set( obj, color );
+    _setObjectColor( index, capturedObj, { obj, color } );
 }
 
-uint32_t CapturedObjects::GetCount( const MP2::MapObjectType objectType, const PlayerColor ownerColor ) const
+void CapturedObjects::rebuildIndexes()
 {
-    uint32_t result = 0;
-
-    const ObjectColor objCol( objectType, ownerColor );
+    _objectCount.clear();
+    _objectsByColor.clear();
+    _isMineCountCacheValid = false;
 
     for ( const auto & [idx, capturedObj] : *this ) {
-        if ( capturedObj.objCol != objCol ) {
-            continue;
-        }
-
-        ++result;
+        ++_objectCount[capturedObj.objCol];
+        _objectsByColor[capturedObj.GetColor()].insert( idx );
     }
-
-    return result;
 }
 
-uint32_t CapturedObjects::GetCountMines( const int resourceType, const PlayerColor ownerColor ) const
+void CapturedObjects::_updateMineCountCache() const
 {
-    uint32_t count = 0;
+    if ( _isMineCountCacheValid ) {
+        return;
+    }
 
-    const ObjectColor objCol( MP2::OBJ_MINE, ownerColor );
+    _mineCount.clear();
 
-    for ( const auto & [idx, capturedObj] : *this ) {
-        if ( capturedObj.objCol != objCol ) {
-            continue;
-        }
+    for ( const auto & [color, indexes] : _objectsByColor ) {
+        for ( const int32_t idx : indexes ) {
+            const auto iter = find( idx );
+            assert( iter != end() );
 
-        if ( resourceType != Maps::getDailyIncomeObjectResources( world.getTile( idx ) ).getFirstValidResource().first ) {
-            continue;
+            if ( iter->second.objCol.first == MP2::OBJ_MINE ) {
+                const int resourceType = Maps::getDailyIncomeObjectResources( world.getTile( idx ) ).getFirstValidResource().first;
+                ++_mineCount[{ resourceType, color }];
+            }
         }
-
-        ++count;
     }
 
-    return count;
+    _isMineCountCacheValid = true;
+}
+
+uint32_t CapturedObjects::GetCount( const MP2::MapObjectType objectType, const PlayerColor ownerColor ) const
+{
+    const auto iter = _objectCount.find( { objectType, ownerColor } );
+    return iter == _objectCount.end() ? 0 : iter->second;
+}
+
+uint32_t CapturedObjects::GetCountMines( const int resourceType, const PlayerColor ownerColor ) const
+{
+    _updateMineCountCache();
+
+    const auto iter = _mineCount.find( { resourceType, ownerColor } );
+    return iter == _mineCount.end() ? 0 : iter->second;
 }
 
 PlayerColor CapturedObjects::GetColor( const int32_t index ) const
@@ -233,46 +316,53 @@ PlayerColor CapturedObjects::GetColor( const int32_t index ) const
 
 void CapturedObjects::ClearFog( const PlayerColorsSet colors ) const
 {
-    for ( const auto & [idx, capturedObj] : *this ) {
-        const auto [objectType, objectColor] = capturedObj.objCol;
-
+    for ( const auto & [objectColor, indexes] : _objectsByColor ) {
         if ( !( colors & objectColor ) ) {
             continue;
         }
 
-        int32_t scoutingDistance = 0;
+        for ( const int32_t idx : indexes ) {
+            const auto iter = find( idx );
+            assert( iter != end() );
 
-        switch ( objectType ) {
-        case MP2::OBJ_MINE:
-        case MP2::OBJ_ALCHEMIST_LAB:
-        case MP2::OBJ_SAWMILL:
-        case MP2::OBJ_LIGHTHOUSE:
-            scoutingDistance = 3;
-            break;
+            int32_t scoutingDistance = 0;
 
-        default:
-            break;
-        }
+            switch ( iter->second.objCol.first ) {
+            case MP2::OBJ_MINE:
+            case MP2::OBJ_ALCHEMIST_LAB:
+            case MP2::OBJ_SAWMILL:
+            case MP2::OBJ_LIGHTHOUSE:
+                scoutingDistance = 3;
+                break;
 
-        if ( scoutingDistance == 0 ) {
-            continue;
-        }
+            default:
+                break;
+            }
+
+            if ( scoutingDistance == 0 ) {
+                continue;
+            }
 
-        Maps::ClearFog( idx, scoutingDistance, objectColor );
+            Maps::ClearFog( idx, scoutingDistance, objectColor );
+        }
     }
 }
 
 void CapturedObjects::ResetColor( const PlayerColor color )
 {
-    for ( auto & [tileIndex, capturedObj] : *this ) {
-        auto & [objectType, objectColor] = capturedObj.objCol;
+    const auto colorIter = _objectsByColor.find( color );
+    if ( colorIter == _objectsByColor.end() ) {
+        return;
+    }
 
-        if ( objectColor != color ) {
-            continue;
-        }
+    // The set of the color is modified while the objects are recolored.
+    const std::set<int32_t> indexes = colorIter->second;
+
+    for ( const int32_t tileIndex : indexes ) {
+        CapturedObject & capturedObj = at( tileIndex );
 
-        objectColor = PlayerColor::NONE;
-        world.getTile( tileIndex ).setOwnershipFlag( objectType, objectColor );
+        _setObjectColor( tileIndex, capturedObj, { capturedObj.objCol.first, PlayerColor::NONE } );
+        world.getTile( tileIndex ).setOwnershipFlag( capturedObj.objCol.first, PlayerColor::NONE );
     }
 }
 
@@ -307,12 +397,18 @@ void World::Reset()
 
     // maps tiles
     vec_tiles.clear();
+    _tileScanData.clear();
+    _objectTileIndexes.clear();
+    _regions.clear();
 
     // kingdoms
     vec_kingdoms.clear();
 
     // event day
     vec_eventsday.clear();
+    _eventSchedule.clear();
+    _todayEvents.clear();
+    _nextEventOrder = 0;
 
     // rumors
     _customRumors.clear();
@@ -325,10 +421,13 @@ void World::Reset()
 
     // extra
     map_captureobj.clear();
+    map_captureobj.rebuildIndexes();
     map_objects.clear();
 
     ultimate_artifact.Reset();
 
+    _radarUpdateArea = {};
+
     day = 0;
     week = 0;
     month = 0;
@@ -386,6 +485,7 @@ void World::generateUninitializedMap( const int32_t size )
     // The tiles are cleared and resizing their vector also initializes tiles with the default values.
     assert( vec_tiles.empty() );
     vec_tiles.resize( static_cast<size_t>( width ) * height );
+    _rebuildTileScanData();
 }
 
 const Castle * World::getCastleEntrance( const fheroes2::Point & tilePosition ) const
@@ -502,12 +602,14 @@ void World::NewDay()
         vec_heroes.NewWeek();
     }
 
+    _advanceEventSchedule();
+
     // and finally the routine of the new day
     vec_kingdoms.NewDay();
     vec_castles.NewDay();
     vec_heroes.NewDay();
 
-    // remove deprecated events
+    // remove deprecated events, they are no longer present in the schedule
     assert( day > 0 );
 
     vec_eventsday.remove_if( [this]( const EventDate & v ) { return v.isDeprecated( day - 1 ); } );
@@ -517,11 +619,32 @@ void World::NewWeek()
 {
     // update objects
     if ( week > 1 ) {
+        std::vector<Maps::Tile *> tilesToUpdate;
+
         for ( Maps::Tile & tile : vec_tiles ) {
             if ( MP2::isWeekLife( tile.getMainObjectType( false ) ) || tile.getMainObjectType() == MP2::OBJ_MONSTER ) {
-                updateObjectInfoTile( tile, false );
+                tilesToUpdate.push_back( &tile );
             }
         }
+
+        // Every tile is updated independently of others, so this is done concurrently. To keep the result the same regardless of the order
+        // of updates (it must be the same for all participants of a network game) every tile uses its own generator forked from the current one.
+        // Tile updates do not touch any shared state of the world: monster data is marked as changed only once all tiles are updated.
+        const Rand::PCG32 tileGeneratorBase = Rand::CurrentThreadRandomDevice().split();
+
+        MultiThreading::JobSystem::Get().parallelFor(
+            0, tilesToUpdate.size(),
+            [&tilesToUpdate, &tileGeneratorBase]( const size_t i ) {
+                Rand::PCG32 & threadGenerator = Rand::CurrentThreadRandomDevice();
+                const Rand::PCG32 originalGenerator = threadGenerator;
+
+                threadGenerator = tileGeneratorBase.fork( i );
+                updateObjectInfoTile( *tilesToUpdate[i], false, false );
+                threadGenerator = originalGenerator;
+            },
+            64 );
+
+        markMonsterDataChanged();
     }
 
     // Reset RECRUIT mode for all heroes at once
@@ -542,6 +665,8 @@ void World::NewMonth()
 {
     if ( month > 1 && GetWeekType().GetType() == WeekName::MONSTERS ) {
         _monthOfMonstersAction( Monster( GetWeekType().GetMonster() ) );
+
+        markMonsterDataChanged();
     }
 }
 
@@ -560,18 +685,22 @@ void World::_monthOfMonstersAction( const Monster & mons )
     // Lastly monster occasionally appear on empty tiles.
     std::vector<int32_t> tetriaryTargetTiles;
 
-    std::set<int32_t> excludeTiles;
+    // Excluded tiles are checked many times in the area around every tile, so a plain per-tile flag is used instead of a set of indexes.
+    std::vector<uint8_t> excludeTiles( vec_tiles.size(), 0 );
 
     Rand::PCG32 seededGen( _seed + month );
 
     // First we scan for Heroes, Castles and Monsters to exclude these from tiles and nearby tiles.
     // We must do this prior to checking the possibility for a monster to spawn in order to properly perform the check on nearby tiles.
-    std::for_each( vec_tiles.cbegin(), vec_tiles.cend(), [&excludeTiles]( const Maps::Tile & tile ) {
-        const MP2::MapObjectType objectType = tile.getMainObjectType( true );
-        if ( objectType == MP2::OBJ_CASTLE || objectType == MP2::OBJ_HERO || objectType == MP2::OBJ_MONSTER ) {
-            excludeTiles.emplace( tile.GetIndex() );
-        }
-    } );
+    MultiThreading::JobSystem::Get().parallelFor(
+        0, vec_tiles.size(),
+        [this, &excludeTiles]( const size_t i ) {
+            const MP2::MapObjectType objectType = vec_tiles[i].getMainObjectType( true );
+            if ( objectType == MP2::OBJ_CASTLE || objectType == MP2::OBJ_HERO || objectType == MP2::OBJ_MONSTER ) {
+                excludeTiles[i] = 1;
+            }
+        },
+        256 );
 
     for ( const Maps::Tile & tile : vec_tiles ) {
         if ( tile.isWater() ) {
@@ -581,7 +710,7 @@ void World::_monthOfMonstersAction( const Monster & mons )
 
         const int32_t tileId = tile.GetIndex();
 
-        if ( excludeTiles.count( tileId ) > 0 ) {
+        if ( excludeTiles[tileId] ) {
             continue;
         }
 
@@ -595,7 +724,7 @@ void World::_monthOfMonstersAction( const Monster & mons )
             const int32_t tileToSet = findSuitableNeighbouringTile( vec_tiles, tileId, ( tile.GetPassable() == DIRECTION_ALL ), seededGen );
             if ( tileToSet >= 0 ) {
                 primaryTargetTiles.emplace_back( tileToSet );
-                excludeTiles.emplace( tileId );
+                excludeTiles[tileId] = 1;
             }
         }
         else if ( tile.isRoad() ) {
@@ -610,7 +739,7 @@ void World::_monthOfMonstersAction( const Monster & mons )
             const int32_t tileToSet = findSuitableNeighbouringTile( vec_tiles, tileId, true, seededGen );
             if ( tileToSet >= 0 ) {
                 secondaryTargetTiles.emplace_back( tileToSet );
-                excludeTiles.emplace( tileId );
+                excludeTiles[tileId] = 1;
             }
         }
         else if ( isClearGround( tile ) ) {
@@ -625,7 +754,7 @@ void World::_monthOfMonstersAction( const Monster & mons )
             const int32_t tileToSet = findSuitableNeighbouringTile( vec_tiles, tileId, true, seededGen );
             if ( tileToSet >= 0 ) {
                 tetriaryTargetTiles.emplace_back( tileToSet );
-                excludeTiles.emplace( tileId );
+                excludeTiles[tileId] = 1;
             }
         }
     }
@@ -885,6 +1014,20 @@ void World::CaptureObject( const int32_t index, const PlayerColor color )
     }
 
     getTile( index ).setOwnershipFlag( objectType, color );
+
+    if ( castle != nullptr ) {
+        // A castle is represented by several tiles on the radar map.
+        const fheroes2::Point & castlePosition = castle->GetCenter();
+        markRadarUpdateArea( { castlePosition.x - 2, castlePosition.y - 3, 5, 5 } );
+    }
+    else {
+        markRadarUpdateArea( { Maps::GetPoint( index ), { 1, 1 } } );
+    }
+}
+
+void World::markRadarUpdateArea( const fheroes2::Rect & area )
+{
+    _radarUpdateArea = fheroes2::getBoundaryRect( _radarUpdateArea, area );
 }
 
 PlayerColor World::ColorCapturedObject( const int32_t index ) const
@@ -920,6 +1063,22 @@ const UltimateArtifact & World::GetUltimateArtifact() const
     return ultimate_artifact;
 }
 
+size_t World::getMemoryUsage() const
+{
+    size_t size = vec_tiles.capacity() * sizeof( Maps::Tile ) + _tileScanData.capacity() * sizeof( Maps::TileScanData );
+
+    for ( const Maps::Tile & tile : vec_tiles ) {
+        size += ( tile.getGroundObjectParts().capacity() + tile.getTopObjectParts().capacity() ) * sizeof( Maps::ObjectPart );
+    }
+
+    // Map objects are of different types, the size of the base type is taken as their lower bound.
+    size += map_objects.size() * sizeof( MapBaseObject ) + map_captureobj.size() * sizeof( CapturedObject );
+    size += static_cast<size_t>( std::distance( vec_heroes.begin(), vec_heroes.end() ) ) * sizeof( Heroes );
+    size += vec_castles.Size() * sizeof( Castle );
+
+    return size;
+}
+
 bool World::DiggingForUltimateArtifact( const fheroes2::Point & center )
 {
     Maps::Tile & tile = getTile( center.x, center.y );
@@ -948,19 +1107,69 @@ bool World::DiggingForUltimateArtifact( const fheroes2::Point & center )
 void World::AddEventDate( const EventDate & event )
 {
     vec_eventsday.push_back( event );
+
+    _scheduleEvent( vec_eventsday.back(), _nextEventOrder++ );
+    _updateTodayEvents();
 }
 
-EventsDate World::GetEventsDate( const PlayerColor color ) const
+const std::vector<const EventDate *> & World::getTodayEvents() const
 {
-    EventsDate res;
+    return _todayEvents;
+}
+
+void World::_rebuildEventSchedule()
+{
+    _eventSchedule.clear();
+    _nextEventOrder = 0;
 
     for ( const EventDate & event : vec_eventsday ) {
-        if ( event.isAllow( color, day ) ) {
-            res.push_back( event );
+        _scheduleEvent( event, _nextEventOrder++ );
+    }
+
+    _updateTodayEvents();
+}
+
+void World::_scheduleEvent( const EventDate & event, const uint32_t order )
+{
+    uint32_t nextDay = event.firstOccurrenceDay;
+
+    if ( nextDay < day ) {
+        if ( event.repeatPeriodInDays == 0 ) {
+            // This event will never occur again.
+            return;
         }
+
+        const uint32_t periods = ( day - nextDay + event.repeatPeriodInDays - 1 ) / event.repeatPeriodInDays;
+        nextDay += periods * event.repeatPeriodInDays;
     }
 
-    return res;
+    assert( nextDay >= day );
+
+    _eventSchedule.emplace( std::make_pair( nextDay, order ), &event );
+}
+
+void World::_advanceEventSchedule()
+{
+    // Events of the past days are either moved to their next occurrence or removed from the schedule.
+    while ( !_eventSchedule.empty() && _eventSchedule.begin()->first.first < day ) {
+        const auto [key, event] = *_eventSchedule.begin();
+        _eventSchedule.erase( _eventSchedule.begin() );
+
+        assert( event != nullptr );
+
+        _scheduleEvent( *event, key.second );
+    }
+
+    _updateTodayEvents();
+}
+
+void World::_updateTodayEvents()
+{
+    _todayEvents.clear();
+
+    for ( auto iter = _eventSchedule.begin(); iter != _eventSchedule.end() && iter->first.first == day; ++iter ) {
+        _todayEvents.push_back( iter->second );
+    }
 }
 
 std::string World::DateString() const
@@ -986,27 +1195,46 @@ void World::ActionForMagellanMaps( const PlayerColor color )
     const Kingdom & kingdom = world.GetKingdom( color );
     const bool isAIPlayer = kingdom.isControlAI();
 
+    const bool isHumanOrHumanFriend = !isAIPlayer || Players::isFriends( color, Players::HumanColors() );
+
     const PlayerColorsSet alliedColors = Players::GetPlayerFriends( color );
 
+    fheroes2::Point fogRevealMinPos( height, width );
+    fheroes2::Point fogRevealMaxPos( 0, 0 );
+
     for ( Maps::Tile & tile : vec_tiles ) {
-        if ( tile.isWater() ) {
-            if ( isAIPlayer && tile.isFog( color ) ) {
-                AI::Planner::Get().revealFog( tile, kingdom );
-            }
+        if ( !tile.isWater() ) {
+            continue;
+        }
+
+        if ( isAIPlayer && tile.isFog( color ) ) {
+            AI::Planner::Get().revealFog( tile, kingdom );
+        }
+
+        // Most of the water can be already explored. Clearing fog of such tiles would only invalidate pathfinders.
+        if ( !tile.isFog( alliedColors ) ) {
+            continue;
+        }
+
+        tile.ClearFog( alliedColors );
 
-            tile.ClearFog( alliedColors );
+        if ( isHumanOrHumanFriend ) {
+            const fheroes2::Point position = Maps::GetPoint( tile.GetIndex() );
+            fogRevealMinPos.x = std::min( fogRevealMinPos.x, position.x );
+            fogRevealMinPos.y = std::min( fogRevealMinPos.y, position.y );
+            fogRevealMaxPos.x = std::max( fogRevealMaxPos.x, position.x );
+            fogRevealMaxPos.y = std::max( fogRevealMaxPos.y, position.y );
         }
     }
+
+    if ( ( fogRevealMaxPos.x >= fogRevealMinPos.x ) && ( fogRevealMaxPos.y >= fogRevealMinPos.y ) ) {
+        markRadarUpdateArea( { fogRevealMinPos.x, fogRevealMinPos.y, fogRevealMaxPos.x - fogRevealMinPos.x + 1, fogRevealMaxPos.y - fogRevealMinPos.y + 1 } );
+    }
 }
 
 MapEvent * World::GetMapEvent( const fheroes2::Point & pos )
 {
-    std::list<MapBaseObject *> res = map_objects.get( pos );
-    if ( res.empty() ) {
-        return nullptr;
-    }
-
-    return dynamic_cast<MapEvent *>( res.front() );
+    return dynamic_cast<MapEvent *>( map_objects.get( pos ) );
 }
 
 MapBaseObject * World::GetMapObject( uint32_t uid )
@@ -1274,18 +1502,35 @@ uint32_t World::getDistance( const Heroes & hero, int targetIndex )
     return _pathfinder.getDistance( targetIndex );
 }
 
-std::list<Route::Step> World::getPath( const Heroes & hero, int targetIndex )
+std::vector<Route::Step> World::getPath( const Heroes & hero, int targetIndex )
 {
     _pathfinder.reEvaluateIfNeeded( hero );
     return _pathfinder.buildPath( targetIndex );
 }
 
+int World::getNumOfTravelDays( const Heroes & hero, const int32_t targetIndex )
+{
+    _pathfinder.reEvaluateIfNeeded( hero );
+    return _pathfinder.getNumOfTravelDays( targetIndex );
+}
+
+void World::preparePathfinder( const Heroes & hero )
+{
+    _pathfinder.reEvaluateIfNeeded( hero );
+}
+
 void World::resetPathfinder()
 {
     _pathfinder.reset();
     AI::Planner::Get().resetPathfinder();
 }
 
+void World::resetPathfinderForTile( const int32_t tileIndex )
+{
+    _pathfinder.invalidateTile( tileIndex );
+    AI::Planner::Get().resetPathfinder();
+}
+
 void World::updatePassabilities()
 {
     for ( Maps::Tile & tile : vec_tiles ) {
@@ -1293,71 +1538,190 @@ void World::updatePassabilities()
         if ( tile.getMainObjectType() == MP2::OBJ_NONE ) {
             tile.updateObjectType();
         }
+    }
+
+    // Passability of a tile depends only on object parts of this tile and its neighbours, which are not modified anymore, so all tiles
+    // can be processed in parallel. The scan data is rebuilt once afterwards.
+    MultiThreading::JobSystem::Get().parallelFor( 0, vec_tiles.size(), [this]( const size_t i ) { vec_tiles[i].computePassability(); }, 256 );
+
+    _rebuildTileScanData();
+}
+
+void World::updatePassabilities( const fheroes2::Rect & area )
+{
+    // Passability of a tile depends on object parts of its left, right and bottom neighbours.
+    const int32_t minX = std::max( area.x - 1, 0 );
+    const int32_t minY = std::max( area.y - 1, 0 );
+    const int32_t maxX = std::min( area.x + area.width, width - 1 );
+    const int32_t maxY = std::min( area.y + area.height, height - 1 );
 
-        tile.setInitialPassability();
+    for ( int32_t y = minY; y <= maxY; ++y ) {
+        for ( int32_t x = minX; x <= maxX; ++x ) {
+            Maps::Tile & tile = getTile( x, y );
+            if ( tile.getMainObjectType() == MP2::OBJ_NONE ) {
+                tile.updateObjectType();
+            }
+        }
     }
 
-    // Once the original passabilities are set we know all neighbours. Now we have to update passabilities based on neighbours.
-    for ( Maps::Tile & tile : vec_tiles ) {
-        tile.updatePassability();
+    for ( int32_t y = minY; y <= maxY; ++y ) {
+        for ( int32_t x = minX; x <= maxX; ++x ) {
+            Maps::Tile & tile = getTile( x, y );
+            tile.computePassability();
+
+            updateTileScanData( tile );
+        }
     }
+
+    updateRegions( { minX, minY, maxX - minX + 1, maxY - minY + 1 } );
 }
 
-void World::PostLoad( const bool setTilePassabilities, const bool updateUidCounterToMaximum )
+void World::updateTileScanData( const Maps::Tile & tile )
 {
-    if ( setTilePassabilities ) {
-        updatePassabilities();
+    const int32_t tileIndex = tile.GetIndex();
+    if ( tileIndex < 0 || static_cast<size_t>( tileIndex ) >= _tileScanData.size() || &vec_tiles[tileIndex] != &tile ) {
+        // This is a standalone copy of a tile or the world is being loaded.
+        return;
     }
 
-    // Cache all tiles that that contain stone liths of a certain type (depending on object sprite index).
-    _allTeleports.clear();
+    Maps::TileScanData & scanData = _tileScanData[tileIndex];
 
-    for ( const int32_t index : Maps::GetObjectPositions( MP2::OBJ_STONE_LITHS ) ) {
-        const auto * objectPart = Maps::getObjectPartByActionType( getTile( index ), MP2::OBJ_STONE_LITHS );
-        if ( objectPart == nullptr ) {
-            // It looks like it is a broken map. No way the tile doesn't have this object.
-            assert( 0 );
-            continue;
+    const MP2::MapObjectType objectType = tile.getMainObjectType();
+    if ( scanData.mainObjectType != objectType ) {
+        if ( scanData.mainObjectType != MP2::OBJ_NONE ) {
+            _objectTileIndexes[scanData.mainObjectType].erase( tileIndex );
         }
 
-        _allTeleports[objectPart->icnIndex].push_back( index );
+        if ( objectType != MP2::OBJ_NONE ) {
+            _objectTileIndexes[objectType].insert( tileIndex );
+        }
+    }
+
+    scanData = tile.getScanData();
+}
+
+const std::set<int32_t> & World::getObjectTileIndexes( const MP2::MapObjectType objectType ) const
+{
+    static const std::set<int32_t> noTiles;
+
+    const auto iter = _objectTileIndexes.find( objectType );
+    return iter != _objectTileIndexes.end() ? iter->second : noTiles;
+}
+
+std::vector<int32_t> World::getActionObjectTileIndexes() const
+{
+    std::vector<int32_t> result;
+
+    for ( const auto & [objectType, tileIndexes] : _objectTileIndexes ) {
+        if ( MP2::isInGameActionObject( objectType ) ) {
+            result.insert( result.end(), tileIndexes.begin(), tileIndexes.end() );
+        }
     }
 
-    // Cache all tiles that contain a certain part of the whirlpool (depending on object sprite index).
-    _allWhirlpools.clear();
+    std::sort( result.begin(), result.end() );
+
+    return result;
+}
+
+void World::_rebuildTileScanData()
+{
+    _tileScanData.resize( vec_tiles.size() );
+    _objectTileIndexes.clear();
 
-    // Whirlpools are unique objects because they can have boats on them which are leftovers from heroes
-    // which disembarked on land. Tiles with boats and whirlpools are marked as Boat objects.
-    // So, searching by type is not accurate as these tiles will be skipped.
-    for ( const auto & [index, objectPart] : Maps::getObjectParts( MP2::OBJ_WHIRLPOOL ) ) {
-        assert( objectPart != nullptr );
+    for ( size_t i = 0; i < vec_tiles.size(); ++i ) {
+        _tileScanData[i] = vec_tiles[i].getScanData();
 
-        _allWhirlpools[objectPart->icnIndex].push_back( index );
+        const MP2::MapObjectType objectType = _tileScanData[i].mainObjectType;
+        if ( objectType != MP2::OBJ_NONE ) {
+            // Tiles are visited in ascending order so every new index goes to the end of the set.
+            std::set<int32_t> & tiles = _objectTileIndexes[objectType];
+            tiles.emplace_hint( tiles.end(), static_cast<int32_t>( i ) );
+        }
     }
+}
+
+void World::PostLoad( const bool setTilePassabilities, const bool updateUidCounterToMaximum )
+{
+    // Tiles might be modified before their indices are set while loading a map so rebuild the scan data completely.
+    _rebuildTileScanData();
 
-    // Cache all positions of Eye of Magi objects.
-    _allEyeOfMagi.clear();
-    for ( const int32_t index : Maps::GetObjectPositions( MP2::OBJ_EYE_OF_MAGI ) ) {
-        _allEyeOfMagi.emplace_back( index );
+    _rebuildEventSchedule();
+
+    if ( setTilePassabilities ) {
+        updatePassabilities();
     }
 
-    resetPathfinder();
-    ComputeStaticAnalysis();
+    // Stone liths, whirlpool and Eye of Magi caches depend only on object parts, so they are built in parallel with the other steps below.
+    std::future<void> objectCachesResult = MultiThreading::JobSystem::Get().async( [this]() {
+        // Cache all tiles that that contain stone liths of a certain type (depending on object sprite index).
+        _allTeleports.clear();
 
-    // Find the maximum UID value.
-    uint32_t maxUid = 0;
+        for ( const int32_t index : Maps::GetObjectPositions( MP2::OBJ_STONE_LITHS ) ) {
+            const auto * objectPart = Maps::getObjectPartByActionType( getTile( index ), MP2::OBJ_STONE_LITHS );
+            if ( objectPart == nullptr ) {
+                // It looks like it is a broken map. No way the tile doesn't have this object.
+                assert( 0 );
+                continue;
+            }
 
-    for ( const Maps::Tile & tile : vec_tiles ) {
-        maxUid = std::max( tile.getMainObjectPart()._uid, maxUid );
+            _allTeleports[objectPart->icnIndex].push_back( index );
+        }
 
-        for ( const auto & part : tile.getGroundObjectParts() ) {
-            maxUid = std::max( part._uid, maxUid );
+        // Cache all tiles that contain a certain part of the whirlpool (depending on object sprite index).
+        _allWhirlpools.clear();
+
+        // Whirlpools are unique objects because they can have boats on them which are leftovers from heroes
+        // which disembarked on land. Tiles with boats and whirlpools are marked as Boat objects.
+        // So, searching by type is not accurate as these tiles will be skipped.
+        for ( const auto & [index, objectPart] : Maps::getObjectParts( MP2::OBJ_WHIRLPOOL ) ) {
+            assert( objectPart != nullptr );
+
+            _allWhirlpools[objectPart->icnIndex].push_back( index );
         }
 
-        for ( const auto & part : tile.getTopObjectParts() ) {
-            maxUid = std::max( part._uid, maxUid );
+        // Cache all positions of Eye of Magi objects.
+        _allEyeOfMagi.clear();
+        for ( const int32_t index : Maps::GetObjectPositions( MP2::OBJ_EYE_OF_MAGI ) ) {
+            _allEyeOfMagi.emplace_back( index );
         }
+    } );
+
+    // Find the maximum UID value. Object parts are not modified by the region computation, so it is done in the meantime.
+    std::future<uint32_t> maxUidResult = MultiThreading::JobSystem::Get().async( [this]() {
+        uint32_t maxUid = 0;
+
+        for ( const Maps::Tile & tile : vec_tiles ) {
+            maxUid = std::max( tile.getMainObjectPart()._uid, maxUid );
+
+            for ( const auto & part : tile.getGroundObjectParts() ) {
+                maxUid = std::max( part._uid, maxUid );
+            }
+
+            for ( const auto & part : tile.getTopObjectParts() ) {
+                maxUid = std::max( part._uid, maxUid );
+            }
+        }
+
+        return maxUid;
+    } );
+
+    resetPathfinder();
+
+    if ( _regions.empty() ) {
+        // Regions are connected through stone liths and whirlpools so their caches must be ready before the computation.
+        objectCachesResult.get();
+
+        ComputeStaticAnalysis();
     }
+    else {
+        // Regions have been loaded from a save file, only the data derived from them has to be restored.
+        _updateTerrainStatistics();
+        _assignRegionsToTiles();
+
+        objectCachesResult.get();
+    }
+
+    const uint32_t maxUid = maxUidResult.get();
 
     if ( updateUidCounterToMaximum ) {
         // And set the UID counter value with the found maximum.
@@ -1486,7 +1850,7 @@ IStreamBase & operator>>( IStreamBase & stream, MapObjects & objs )
 
     const uint32_t size = stream.get32();
 
-    objectsRef.clear();
+    objs.clear();
 
     for ( uint32_t i = 0; i < size; ++i ) {
         uint32_t uid{ 0 };
@@ -1548,7 +1912,10 @@ IStreamBase & operator>>( IStreamBase & stream, MapObjects & objs )
             continue;
         }
 
-        if ( const auto [dummy, inserted] = objectsRef.try_emplace( uid, std::move( obj ) ); !inserted ) {
+        if ( const auto [iter, inserted] = objectsRef.try_emplace( uid, std::move( obj ) ); inserted ) {
+            objs._addToPositionIndex( *iter->second );
+        }
+        else {
             // Most likely the save file is corrupted.
             stream.setFail();
         }
@@ -1559,8 +1926,12 @@ IStreamBase & operator>>( IStreamBase & stream, MapObjects & objs )
 
 OStreamBase & operator<<( OStreamBase & stream, const World & w )
 {
-    return stream << w.width << w.height << w.vec_tiles << w.vec_heroes << w.vec_castles << w.vec_kingdoms << w._customRumors << w.vec_eventsday << w.map_captureobj
-                  << w.ultimate_artifact << w.day << w.week << w.month << w.heroIdAsWinCondition << w.heroIdAsLossCondition << w.map_objects << w._seed;
+    stream << w.width << w.height;
+    Maps::saveTiles( stream, w.vec_tiles );
+
+    return stream << w.vec_heroes << w.vec_castles << w.vec_kingdoms << w._customRumors << w.vec_eventsday << w.map_captureobj
+                  << w.ultimate_artifact << w.day << w.week << w.month << w.heroIdAsWinCondition << w.heroIdAsLossCondition << w.map_objects << w._seed
+                  << w._regions;
 }
 
 IStreamBase & operator>>( IStreamBase & stream, World & w )
@@ -1578,9 +1949,21 @@ IStreamBase & operator>>( IStreamBase & stream, World & w )
         stream >> w.width >> w.height;
     }
 
-    stream >> w.vec_tiles >> w.vec_heroes >> w.vec_castles >> w.vec_kingdoms >> w._customRumors >> w.vec_eventsday >> w.map_captureobj >> w.ultimate_artifact >> w.day
+    static_assert( LAST_SUPPORTED_FORMAT_VERSION < FORMAT_VERSION_PRE1_1112_RELEASE, "Remove the logic below." );
+    if ( Game::GetVersionOfCurrentSaveFile() < FORMAT_VERSION_PRE1_1112_RELEASE ) {
+        stream >> w.vec_tiles;
+    }
+    else {
+        Maps::loadTiles( stream, w.vec_tiles );
+    }
+
+    w._rebuildTileScanData();
+
+    stream >> w.vec_heroes >> w.vec_castles >> w.vec_kingdoms >> w._customRumors >> w.vec_eventsday >> w.map_captureobj >> w.ultimate_artifact >> w.day
         >> w.week >> w.month >> w.heroIdAsWinCondition >> w.heroIdAsLossCondition;
 
+    w.map_captureobj.rebuildIndexes();
+
     static_assert( LAST_SUPPORTED_FORMAT_VERSION < FORMAT_VERSION_1010_RELEASE, "Remove the logic below." );
     if ( Game::GetVersionOfCurrentSaveFile() < FORMAT_VERSION_1010_RELEASE ) {
         ++w.heroIdAsWinCondition;
@@ -1621,6 +2004,20 @@ IStreamBase & operator>>( IStreamBase & stream, World & w )
 
     stream >> w.map_objects >> w._seed;
 
+    static_assert( LAST_SUPPORTED_FORMAT_VERSION < FORMAT_VERSION_PRE2_1112_RELEASE, "Remove the logic below." );
+    if ( Game::GetVersionOfCurrentSaveFile() < FORMAT_VERSION_PRE2_1112_RELEASE ) {
+        w._regions.clear();
+    }
+    else {
+        stream >> w._regions;
+
+        if ( !w._areRegionsValid() ) {
+            // Regions will be recomputed.
+            ERROR_LOG( "Invalid region data in the save file." )
+            w._regions.clear();
+        }
+    }
+
     w.PostLoad( false, true );
 
     return stream;
@@ -28,8 +28,10 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -85,6 +87,7 @@ public:
     void clear()
     {
         _objects.clear();
+        _objectsByPosition.clear();
     }
 
     template <typename T, std::enable_if_t<std::is_base_of_v<MapBaseObject, T>, bool> = true>
@@ -94,24 +97,49 @@ public:
             return;
         }
 
-        if ( const auto [iter, inserted] = _objects.try_emplace( obj->GetUID(), std::move( obj ) ); !inserted ) {
+        auto [iter, inserted] = _objects.try_emplace( obj->GetUID(), std::move( obj ) );
+        if ( !inserted ) {
+            _removeFromPositionIndex( *iter->second );
             iter->second = std::move( obj );
         }
+
+        _addToPositionIndex( *iter->second );
     }
 
     void remove( const uint32_t uid )
     {
-        _objects.erase( uid );
+        if ( const auto iter = _objects.find( uid ); iter != _objects.end() ) {
+            _removeFromPositionIndex( *iter->second );
+            _objects.erase( iter );
+        }
+    }
+
+    size_t size() const
+    {
+        return _objects.size();
     }
 
     MapBaseObject * get( const uint32_t uid ) const;
-    std::list<MapBaseObject *> get( const fheroes2::Point & pos ) const;
+
+    // Returns the object with the lowest UID among the objects at the given position or nullptr if there are no such objects.
+    MapBaseObject * get( const fheroes2::Point & pos ) const;
 
 private:
     friend OStreamBase & operator<<( OStreamBase & stream, const MapObjects & objs );
     friend IStreamBase & operator>>( IStreamBase & stream, MapObjects & objs );
 
+    static uint64_t _getPositionKey( const fheroes2::Point & pos )
+    {
+        return ( static_cast<uint64_t>( static_cast<uint32_t>( pos.x ) ) << 32 ) | static_cast<uint32_t>( pos.y );
+    }
+
+    void _addToPositionIndex( MapBaseObject & obj );
+    void _removeFromPositionIndex( const MapBaseObject & obj );
+
     std::map<uint32_t, std::unique_ptr<MapBaseObject>> _objects;
+
+    // Objects by their position on the map. Map objects never move, so the index changes only when objects are added or removed.
+    std::unordered_multimap<uint64_t, MapBaseObject *> _objectsByPosition;
 };
 
 struct CapturedObject
@@ -152,15 +180,30 @@ struct CapturedObjects : std::map<int32_t, CapturedObject>
 
     void ClearFog( const PlayerColorsSet colors ) const;
 
-    CapturedObject & Get( const int32_t index )
-    {
-        return operator[]( index );
-    }
+    // The returned object must not be used to change its type or color: use Set() or SetColor() for this.
+    CapturedObject & Get( const int32_t index );
 
     PlayerColor GetColor( const int32_t index ) const;
 
     uint32_t GetCount( const MP2::MapObjectType objectType, const PlayerColor ownerColor ) const;
     uint32_t GetCountMines( const int resourceType, const PlayerColor ownerColor ) const;
+
+    // Must be called after the container is modified directly (cleared or loaded from a stream).
+    void rebuildIndexes();
+
+private:
+    void _setObjectColor( const int32_t index, CapturedObject & capturedObj, const ObjectColor & objCol );
+    void _updateMineCountCache() const;
+
+    // Object counts per type and color and tile indexes of objects per owner color. They are queried many times per turn
+    // (kingdom income, AI evaluation, UI) and are updated along with every change of an object type or color.
+    std::map<ObjectColor, uint32_t> _objectCount;
+    std::map<PlayerColor, std::set<int32_t>> _objectsByColor;
+
+    // Mine counts per resource type and color. The resource type of a mine is taken from its tile, so these counts are
+    // calculated on demand and invalidated only when the type or color of a mine changes.
+    mutable std::map<std::pair<int, PlayerColor>, uint32_t> _mineCount;
+    mutable bool _isMineCountCacheValid{ false };
 };
 
 struct EventDate
@@ -264,6 +307,25 @@ public:
 #endif
     }
 
+    const Maps::TileScanData & getTileScanData( const int32_t tileId ) const
+    {
+#ifdef WITH_DEBUG
+        return _tileScanData.at( tileId );
+#else
+        return _tileScanData[tileId];
+#endif
+    }
+
+    // Updates the scan data of the given tile. Tiles which are not a part of the world are ignored.
+    void updateTileScanData( const Maps::Tile & tile );
+
+    // Returns indexes of all tiles with the given main object type in ascending order. Objects under heroes are not taken into account.
+    // Tiles without any object (MP2::OBJ_NONE) are not indexed.
+    const std::set<int32_t> & getObjectTileIndexes( const MP2::MapObjectType objectType ) const;
+
+    // Returns indexes of all tiles with an in-game action object (see MP2::isInGameActionObject()) as their main object in ascending order.
+    std::vector<int32_t> getActionObjectTileIndexes() const;
+
     void InitKingdoms()
     {
         vec_kingdoms.Init();
@@ -349,6 +411,9 @@ public:
         return vec_tiles.size();
     }
 
+    // Returns an estimate of the memory held by the tiles and the objects of the world.
+    size_t getMemoryUsage() const;
+
     int GetDay() const;
     int GetWeek() const;
 
@@ -401,6 +466,27 @@ public:
     void ActionForMagellanMaps( const PlayerColor color );
     void ClearFog( PlayerColor color ) const;
 
+    // Marks an area in tiles which appearance on the radar map could have changed: fog is revealed, an object is captured or a hero moves.
+    void markRadarUpdateArea( const fheroes2::Rect & area );
+
+    // Returns the area of all changes marked since the previous call.
+    fheroes2::Rect takeRadarUpdateArea()
+    {
+        return std::exchange( _radarUpdateArea, {} );
+    }
+
+    // Returns a counter which changes every time the monsters guarding any tile are changed: after a battle, a recruitment or a monster growth.
+    // Values cached based on the monsters on tiles are valid only while this counter stays the same.
+    uint32_t getMonsterDataVersion() const
+    {
+        return _monsterDataVersion;
+    }
+
+    void markMonsterDataChanged()
+    {
+        ++_monsterDataVersion;
+    }
+
     bool KingdomIsWins( const Kingdom & kingdom, const uint32_t wins ) const;
     bool KingdomIsLoss( const Kingdom & kingdom, const uint32_t loss ) const;
 
@@ -408,7 +494,9 @@ public:
     uint32_t CheckKingdomLoss( const Kingdom & kingdom ) const;
 
     void AddEventDate( const EventDate & event );
-    EventsDate GetEventsDate( const PlayerColor color ) const;
+
+    // Returns the timed events which occur today for any player. Use EventDate::isAllow() to check whether an event applies to a particular player.
+    const std::vector<const EventDate *> & getTodayEvents() const;
 
     MapEvent * GetMapEvent( const fheroes2::Point & pos );
     MapBaseObject * GetMapObject( uint32_t uid );
@@ -416,6 +504,12 @@ public:
     const MapRegion & getRegion( size_t id ) const;
     size_t getRegionCount() const;
 
+    // Returns a counter which changes every time regions or links between them are changed.
+    uint32_t getRegionDataVersion() const
+    {
+        return _regionDataVersion;
+    }
+
     uint8_t getWaterPercentage() const
     {
         return _waterPercentage;
@@ -427,11 +521,21 @@ public:
     }
 
     uint32_t getDistance( const Heroes & hero, int targetIndex );
-    std::list<Route::Step> getPath( const Heroes & hero, int targetIndex );
+    std::vector<Route::Step> getPath( const Heroes & hero, int targetIndex );
+    int getNumOfTravelDays( const Heroes & hero, const int32_t targetIndex );
+    // Evaluates the player's pathfinder for the given hero in advance, so that the first path request for this hero is fast.
+    void preparePathfinder( const Heroes & hero );
     void resetPathfinder();
+    // Same as resetPathfinder() but only the state of a single tile has changed, so the player's pathfinder can repair its cache
+    // around this tile instead of processing the whole map again.
+    void resetPathfinderForTile( const int32_t tileIndex );
 
     void ComputeStaticAnalysis();
 
+    // Updates regions of tiles within the given area (in tiles) after their passability has been changed.
+    // New passable tiles join adjacent regions and regions connected through them become neighbours.
+    void updateRegions( const fheroes2::Rect & area );
+
     uint32_t GetMapSeed() const
     {
         return _seed;
@@ -443,6 +547,9 @@ public:
 
     void updatePassabilities();
 
+    // Updates passability of tiles only within the given area (in tiles) and around it, since passability of a tile depends on its neighbours.
+    void updatePassabilities( const fheroes2::Rect & area );
+
     const std::vector<int32_t> & getAllEyeOfMagiPositions() const
     {
         return _allEyeOfMagi;
@@ -465,6 +572,22 @@ private:
 
     void PostLoad( const bool setTilePassabilities, const bool updateUidCounterToMaximum );
 
+    void _rebuildTileScanData();
+
+    void _rebuildEventSchedule();
+
+    // Updates the water percentage and the land roughness of the map.
+    void _updateTerrainStatistics();
+
+    // Sets the region of every tile according to the region nodes.
+    void _assignRegionsToTiles();
+
+    // Checks whether the region data (e.g. loaded from a save file) is consistent with the map.
+    bool _areRegionsValid() const;
+    void _scheduleEvent( const EventDate & event, const uint32_t order );
+    void _advanceEventSchedule();
+    void _updateTodayEvents();
+
     bool updateTileMetadata( Maps::Tile & tile, const MP2::MapObjectType objectType, const bool checkPoLObjects );
 
     bool isValidCastleEntrance( const fheroes2::Point & tilePosition ) const;
@@ -508,10 +631,28 @@ private:
     std::map<uint8_t, Maps::Indexes> _allWhirlpools; // All indexes of tiles that contain a certain part (sprite index) of the whirlpool
     std::vector<int32_t> _allEyeOfMagi;
 
+    // Compact copies of the tile fields used by whole map scans. They are kept in sync with the tiles.
+    std::vector<Maps::TileScanData> _tileScanData;
+
+    // Indexes of tiles for each main object type. It is updated together with the scan data.
+    std::map<MP2::MapObjectType, std::set<int32_t>> _objectTileIndexes;
+
+    // Timed events (elements of vec_eventsday) indexed by the day of their next occurrence, starting from the current day, and by
+    // their order in vec_eventsday. Every day only the events scheduled for this day are processed and repeating events are moved
+    // to their next occurrence.
+    std::map<std::pair<uint32_t, uint32_t>, const EventDate *> _eventSchedule;
+    std::vector<const EventDate *> _todayEvents;
+    uint32_t _nextEventOrder{ 0 };
+
     uint8_t _waterPercentage{ 0 };
     double _landRoughness{ 1.0 };
     std::vector<MapRegion> _regions;
     PlayerWorldPathfinder _pathfinder;
+
+    fheroes2::Rect _radarUpdateArea;
+
+    uint32_t _monsterDataVersion{ 0 };
+    uint32_t _regionDataVersion{ 0 };
 };
 
 OStreamBase & operator<<( OStreamBase & stream, const CapturedObject & obj );
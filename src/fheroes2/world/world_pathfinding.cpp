@@ -25,6 +25,8 @@
 #include <cassert>
 #include <cmath>
 #include <cstdlib>
+#include <functional>
+#include <queue>
 #include <set>
 #include <tuple>
 #include <utility>
@@ -38,12 +40,14 @@
 #include "ground.h"
 #include "heroes.h"
 #include "kingdom.h"
+#include "logging.h"
 #include "maps.h"
 #include "maps_tiles.h"
 #include "maps_tiles_helper.h"
 #include "math_base.h"
 #include "mp2.h"
 #include "pairs.h"
+#include "perf_counters.h"
 #include "players.h"
 #include "rand.h"
 #include "route.h"
@@ -54,6 +58,22 @@
 
 namespace
 {
+    // Ground types in the order of their indexes used by the pathfinder terrain data.
+    constexpr std::array<int32_t, 10> groundTypes{ Maps::Ground::UNKNOWN, Maps::Ground::DESERT, Maps::Ground::SNOW, Maps::Ground::SWAMP, Maps::Ground::WASTELAND,
+                                                   Maps::Ground::BEACH,   Maps::Ground::LAVA,   Maps::Ground::DIRT, Maps::Ground::GRASS, Maps::Ground::WATER };
+
+    uint8_t getGroundTypeIndex( const int32_t groundId )
+    {
+        const auto iter = std::find( groundTypes.begin(), groundTypes.end(), groundId );
+        if ( iter == groundTypes.end() ) {
+            // Have you added a new ground? Add it to the list above!
+            assert( 0 );
+            return 0;
+        }
+
+        return static_cast<uint8_t>( iter - groundTypes.begin() );
+    }
+
     bool isTileAvailableForWalkThrough( const int tileIndex, const bool fromWater )
     {
         const Maps::Tile & tile = world.getTile( tileIndex );
@@ -79,8 +99,9 @@ namespace
         const MP2::MapObjectType objectType = tile.getMainObjectType();
 
         const auto isTileAccessible = [color, armyStrength, minimalAdvantage, &tile]() {
-            // Creating an Army instance is a relatively heavy operation, so cache it to speed up calculations
-            static Army tileArmy;
+            // Creating an Army instance is a relatively heavy operation, so cache it to speed up calculations. AI pathfinders
+            // can be evaluated concurrently, so every thread has its own instance.
+            thread_local Army tileArmy;
             tileArmy.setFromTile( tile );
 
             const PlayerColor tileArmyColor = tileArmy.GetColor();
@@ -330,10 +351,14 @@ uint32_t WorldPathfinder::getDistance( int targetIndex ) const
 
 uint32_t WorldPathfinder::getMovementPenalty( const int from, const int to, const int direction ) const
 {
-    const Maps::Tile & fromTile = world.getTile( from );
-    const Maps::Tile & toTile = world.getTile( to );
+    assert( from >= 0 && static_cast<size_t>( from ) < _tileTerrain.size() );
+    assert( to >= 0 && static_cast<size_t>( to ) < _tileTerrain.size() );
 
-    uint32_t penalty = fromTile.isRoad() && toTile.isRoad() ? Maps::Ground::roadPenalty : Maps::Ground::GetPenalty( fromTile, _pathfindingSkill );
+    const uint8_t fromTerrain = _tileTerrain[from];
+
+    // The road penalty is applied only if both tiles are on the road, otherwise the source tile's ground penalty is used
+    uint32_t penalty = ( fromTerrain & _tileTerrain[to] & tileTerrainRoadFlag ) != 0 ? Maps::Ground::roadPenalty
+                                                                                     : _terrainPenalties[fromTerrain & tileTerrainGroundMask];
 
     // Diagonal movement costs 50% more
     if ( Direction::isDiagonal( direction ) ) {
@@ -344,14 +369,14 @@ uint32_t WorldPathfinder::getMovementPenalty( const int from, const int to, cons
     // logic: if this move is the last one on the current turn, then we can move to any adjacent
     // tile (both in straight and diagonal direction) as long as we have enough movement points
     // to move over our current tile in the straight direction
-    if ( getMaxMovePoints( fromTile.isWater() ) > 0 ) {
+    if ( getMaxMovePoints( isWaterTile( from ) ) > 0 ) {
         const WorldNode & node = _cache[from];
 
         // No dead ends allowed
         assert( from == _pathStart || node._from != -1 );
 
         const uint32_t remainingMovePoints = node._remainingMovePoints;
-        const uint32_t fromTilePenalty = fromTile.isRoad() ? Maps::Ground::roadPenalty : Maps::Ground::GetPenalty( fromTile, _pathfindingSkill );
+        const uint32_t fromTilePenalty = getTerrainPenalty( from );
 
         // If we still have enough movement points to move over the source tile in the straight
         // direction, but not enough to move to the destination tile, then the "last move" logic
@@ -365,6 +390,61 @@ uint32_t WorldPathfinder::getMovementPenalty( const int from, const int to, cons
     return penalty;
 }
 
+void WorldPathfinder::updateTerrainPenalties()
+{
+    static_assert( groundTypes.size() <= tileTerrainGroundMask + 1 );
+
+    if ( const size_t worldSize = world.getSize(); _tileTerrain.size() != worldSize ) {
+        _tileTerrain.resize( worldSize );
+
+        for ( size_t idx = 0; idx < worldSize; ++idx ) {
+            const Maps::Tile & tile = world.getTile( static_cast<int32_t>( idx ) );
+
+            uint8_t terrain = getGroundTypeIndex( tile.GetGround() );
+            if ( tile.isRoad() ) {
+                terrain |= tileTerrainRoadFlag;
+            }
+            if ( tile.isWater() ) {
+                terrain |= tileTerrainWaterFlag;
+            }
+
+            _tileTerrain[idx] = terrain;
+        }
+    }
+
+    if ( _terrainPenaltiesSkill == _pathfindingSkill ) {
+        return;
+    }
+
+    for ( size_t i = 0; i < groundTypes.size(); ++i ) {
+        _terrainPenalties[i] = Maps::Ground::GetPenalty( groundTypes[i], _pathfindingSkill );
+        _terrainPenalties[i | tileTerrainRoadFlag] = Maps::Ground::roadPenalty;
+    }
+
+    _terrainPenaltiesSkill = _pathfindingSkill;
+}
+
+void WorldNodeCache::resize( const size_t size )
+{
+    _nodes.assign( size, {} );
+    _aiFlags.assign( size, 0 );
+    _generations.assign( size, 0 );
+
+    _generation = 1;
+}
+
+void WorldNodeCache::clear()
+{
+    ++_generation;
+
+    // On overflow the stale stamps would start to match again, so they have to be rewritten once.
+    if ( _generation == 0 ) {
+        std::fill( _generations.begin(), _generations.end(), 0 );
+
+        _generation = 1;
+    }
+}
+
 void WorldPathfinder::reset()
 {
     // The following optimization will only work correctly for square maps
@@ -385,31 +465,182 @@ void WorldPathfinder::reset()
     _color = PlayerColor::NONE;
     _remainingMovePoints = 0;
     _pathfindingSkill = Skill::Level::EXPERT;
+
+    // The map could be changed, so the terrain data must be collected again
+    _tileTerrain.clear();
+    _terrainPenaltiesSkill.reset();
+}
+
+void WorldNodeQueue::clear()
+{
+    for ( std::vector<Item> & bucket : _buckets ) {
+        bucket.clear();
+    }
+
+    _lastCost = 0;
+    _size = 0;
+}
+
+WorldNodeQueue::Item WorldNodeQueue::pop()
+{
+    assert( _size > 0 );
+
+    if ( _buckets[0].empty() ) {
+        size_t bucketIdx = 1;
+        while ( _buckets[bucketIdx].empty() ) {
+            ++bucketIdx;
+
+            assert( bucketIdx < _buckets.size() );
+        }
+
+        std::vector<Item> & bucket = _buckets[bucketIdx];
+
+        _lastCost = std::min_element( bucket.begin(), bucket.end() )->first;
+
+        // All the items of this bucket are closer to the new lowest cost, so they are moved to the lower buckets
+        for ( const Item & item : bucket ) {
+            _buckets[getBucketIndex( item.first )].push_back( item );
+        }
+
+        bucket.clear();
+    }
+
+    const Item item = _buckets[0].back();
+    _buckets[0].pop_back();
+    --_size;
+
+    return item;
 }
 
 void WorldPathfinder::processWorldMap()
 {
     assert( _cache.size() == world.getSize() && Maps::isValidAbsIndex( _pathStart ) );
 
-    for ( WorldNode & node : _cache ) {
-        node = {};
-    }
+    updateTerrainPenalties();
 
-    _cache[_pathStart].update( -1, 0, _remainingMovePoints );
+    _cache.clear();
+
+    _cache.modify( _pathStart ).update( -1, 0, _remainingMovePoints );
 
     std::vector<int> nodesToExplore;
     nodesToExplore.push_back( _pathStart );
 
-    for ( size_t lastProcessedNode = 0; lastProcessedNode < nodesToExplore.size(); ++lastProcessedNode ) {
-        processCurrentNode( nodesToExplore, nodesToExplore[lastProcessedNode] );
+    exploreNodes( nodesToExplore );
+}
+
+void WorldPathfinder::exploreNodes( std::vector<int> & nodesToExplore )
+{
+    _queue.clear();
+
+    for ( const int nodeIdx : nodesToExplore ) {
+        _queue.push( _cache[nodeIdx]._cost, nodeIdx );
     }
+
+    uint32_t expandedNodes = 0;
+
+    while ( !_queue.empty() ) {
+        const auto [cost, nodeIdx] = _queue.pop();
+
+        // This node has been reached with a lower cost since it was queued.
+        if ( cost != _cache[nodeIdx]._cost ) {
+            continue;
+        }
+
+        ++expandedNodes;
+
+        nodesToExplore.clear();
+        processCurrentNode( nodesToExplore, nodeIdx );
+
+        for ( const int updatedIdx : nodesToExplore ) {
+            _queue.push( _cache[updatedIdx]._cost, updatedIdx );
+        }
+    }
+
+    fheroes2::addPerfCounter( fheroes2::PerfCounter::PATHFINDER_RUNS );
+    fheroes2::addPerfCounter( fheroes2::PerfCounter::PATHFINDER_EXPANDED_NODES, expandedNodes );
+    fheroes2::addPerfSample( fheroes2::PerfHistogram::PATHFINDER_EXPANDED_NODES, expandedNodes );
+
+    DEBUG_LOG( DBG_GAME, DBG_TRACE, "start tile: " << _pathStart << ", expanded nodes: " << expandedNodes )
+}
+
+std::vector<uint32_t> WorldPathfinder::processWorldMapForTargets( const std::vector<int32_t> & targets, const uint32_t maxDistance )
+{
+    assert( _cache.size() == world.getSize() && Maps::isValidAbsIndex( _pathStart ) );
+
+    updateTerrainPenalties();
+
+    _cache.clear();
+
+    _cache.modify( _pathStart ).update( -1, 0, _remainingMovePoints );
+
+    std::vector<uint32_t> result( targets.size(), 0 );
+
+    // Several targets can share the same tile.
+    std::vector<size_t> targetsLeft;
+    targetsLeft.reserve( targets.size() );
+
+    for ( size_t i = 0; i < targets.size(); ++i ) {
+        assert( Maps::isValidAbsIndex( targets[i] ) );
+
+        // The start node is technically unreachable, which is consistent with getDistance().
+        if ( targets[i] != _pathStart ) {
+            targetsLeft.push_back( i );
+        }
+    }
+
+    _queue.clear();
+    _queue.push( 0, _pathStart );
+
+    std::vector<int> updatedNodes;
+    uint32_t expandedNodes = 0;
+
+    while ( !_queue.empty() && !targetsLeft.empty() ) {
+        const auto [cost, nodeIdx] = _queue.pop();
+
+        // This node has been reached with a lower cost since it was queued.
+        if ( cost != _cache[nodeIdx]._cost ) {
+            continue;
+        }
+
+        if ( maxDistance > 0 && cost > maxDistance ) {
+            break;
+        }
+
+        targetsLeft.erase( std::remove_if( targetsLeft.begin(), targetsLeft.end(),
+                                           [&targets, &result, nodeIdx = nodeIdx, cost = cost]( const size_t targetId ) {
+                                               if ( targets[targetId] != nodeIdx ) {
+                                                   return false;
+                                               }
+
+                                               result[targetId] = cost;
+                                               return true;
+                                           } ),
+                           targetsLeft.end() );
+
+        ++expandedNodes;
+
+        updatedNodes.clear();
+        processCurrentNode( updatedNodes, nodeIdx );
+
+        for ( const int updatedIdx : updatedNodes ) {
+            _queue.push( _cache[updatedIdx]._cost, updatedIdx );
+        }
+    }
+
+    fheroes2::addPerfCounter( fheroes2::PerfCounter::PATHFINDER_RUNS );
+    fheroes2::addPerfCounter( fheroes2::PerfCounter::PATHFINDER_EXPANDED_NODES, expandedNodes );
+    fheroes2::addPerfSample( fheroes2::PerfHistogram::PATHFINDER_EXPANDED_NODES, expandedNodes );
+
+    DEBUG_LOG( DBG_GAME, DBG_TRACE, "start tile: " << _pathStart << ", targets: " << targets.size() << ", expanded nodes: " << expandedNodes )
+
+    return result;
 }
 
 void WorldPathfinder::checkAdjacentNodes( std::vector<int> & nodesToExplore, const int currentNodeIdx )
 {
     const auto & directions = Direction::allNeighboringDirections;
     const WorldNode & currentNode = _cache[currentNodeIdx];
-    const uint32_t maxMovePoints = getMaxMovePoints( world.getTile( currentNodeIdx ).isWater() );
+    const uint32_t maxMovePoints = getMaxMovePoints( isWaterTile( currentNodeIdx ) );
 
     for ( size_t i = 0; i < directions.size(); ++i ) {
         if ( !Maps::isValidDirection( currentNodeIdx, directions[i] ) || !isMovementAllowed( currentNodeIdx, directions[i] ) ) {
@@ -424,10 +655,10 @@ void WorldPathfinder::checkAdjacentNodes( std::vector<int> & nodesToExplore, con
         const uint32_t movementPenalty = getMovementPenalty( currentNodeIdx, newIndex, directions[i] );
         const uint32_t movementCost = currentNode._cost + movementPenalty;
 
-        WorldNode & newNode = _cache[newIndex];
+        const WorldNode & newNode = _cache[newIndex];
 
         if ( newNode._from == -1 || newNode._cost > movementCost ) {
-            newNode.update( currentNodeIdx, movementCost, subtractMovePoints( currentNode._remainingMovePoints, movementPenalty, maxMovePoints ) );
+            _cache.modify( newIndex ).update( currentNodeIdx, movementCost, subtractMovePoints( currentNode._remainingMovePoints, movementPenalty, maxMovePoints ) );
 
             nodesToExplore.push_back( newIndex );
         }
@@ -444,6 +675,27 @@ void PlayerWorldPathfinder::reset()
     WorldPathfinder::reset();
 
     _maxMovePoints = 0;
+    _changedTiles.clear();
+}
+
+void PlayerWorldPathfinder::invalidateTile( const int32_t tileIndex )
+{
+    // There is nothing to repair yet.
+    if ( _pathStart == -1 ) {
+        return;
+    }
+
+    // Beyond this point it is cheaper to process the whole map again.
+    const size_t maxChangedTiles = 64;
+
+    if ( _changedTiles.size() >= maxChangedTiles ) {
+        reset();
+        return;
+    }
+
+    assert( Maps::isValidAbsIndex( tileIndex ) );
+
+    _changedTiles.push_back( tileIndex );
 }
 
 void PlayerWorldPathfinder::reEvaluateIfNeeded( const Heroes & hero )
@@ -455,15 +707,109 @@ void PlayerWorldPathfinder::reEvaluateIfNeeded( const Heroes & hero )
     if ( currentSettings != newSettings ) {
         currentSettings = newSettings;
 
+        _changedTiles.clear();
+
         processWorldMap();
     }
+    else if ( !_changedTiles.empty() ) {
+        processChangedTiles();
+    }
 }
 
-std::list<Route::Step> PlayerWorldPathfinder::buildPath( const int targetIndex ) const
+void PlayerWorldPathfinder::processChangedTiles()
+{
+    assert( _cache.size() == world.getSize() && Maps::isValidAbsIndex( _pathStart ) );
+
+    const size_t mapSize = _cache.size();
+
+    // The outgoing edges of a node depend on the tile itself, on its neighbours and on the monsters protecting it, so a change
+    // of a tile can affect the edges of all the tiles around it.
+    std::vector<uint8_t> isAffected( mapSize, 0 );
+
+    for ( const int32_t tileIndex : _changedTiles ) {
+        isAffected[tileIndex] = 1;
+
+        Maps::forEachAroundIndex( tileIndex, world.w(), world.h(), 1, [&isAffected]( const int32_t aroundIndex ) { isAffected[aroundIndex] = 1; } );
+    }
+
+    _changedTiles.clear();
+
+    // Every node that was reached via an edge of an affected node may no longer be reachable this way, so the cost of such
+    // nodes should be evaluated again. The state of each node is resolved by walking up its path towards the start node.
+    enum : uint8_t
+    {
+        UNKNOWN,
+        KEEP,
+        EVALUATE
+    };
+
+    std::vector<uint8_t> nodeState( mapSize, UNKNOWN );
+    std::vector<int> chain;
+
+    for ( size_t idx = 0; idx < mapSize; ++idx ) {
+        int currentNodeIdx = static_cast<int>( idx );
+
+        chain.clear();
+
+        while ( nodeState[currentNodeIdx] == UNKNOWN ) {
+            const int from = _cache[currentNodeIdx]._from;
+
+            // Either the start node or a node that has not been reached at all
+            if ( from == -1 ) {
+                nodeState[currentNodeIdx] = KEEP;
+                break;
+            }
+
+            if ( isAffected[from] ) {
+                nodeState[currentNodeIdx] = EVALUATE;
+                break;
+            }
+
+            chain.push_back( currentNodeIdx );
+            currentNodeIdx = from;
+        }
+
+        for ( const int nodeIdx : chain ) {
+            nodeState[nodeIdx] = nodeState[currentNodeIdx];
+        }
+    }
+
+    for ( size_t idx = 0; idx < mapSize; ++idx ) {
+        if ( nodeState[idx] == EVALUATE ) {
+            _cache.modify( idx ).reset();
+        }
+    }
+
+    // The search is resumed from the affected nodes and from the nodes bordering the evaluated area. Nodes that cannot be
+    // passed through, like the endpoints of the search, are processed as well, but they do not propagate anything.
+    std::vector<int> nodesToExplore;
+
+    for ( size_t idx = 0; idx < mapSize; ++idx ) {
+        const int nodeIdx = static_cast<int>( idx );
+
+        if ( nodeIdx != _pathStart && _cache[idx]._from == -1 ) {
+            continue;
+        }
+
+        bool isBorderNode = ( isAffected[idx] != 0 );
+
+        for ( size_t i = 0; !isBorderNode && i < _mapOffset.size(); ++i ) {
+            isBorderNode = Maps::isValidDirection( nodeIdx, Direction::allNeighboringDirections[i] ) && nodeState[nodeIdx + _mapOffset[i]] == EVALUATE;
+        }
+
+        if ( isBorderNode ) {
+            nodesToExplore.push_back( nodeIdx );
+        }
+    }
+
+    exploreNodes( nodesToExplore );
+}
+
+std::vector<Route::Step> PlayerWorldPathfinder::buildPath( const int targetIndex ) const
 {
     assert( _cache.size() == world.getSize() && Maps::isValidAbsIndex( _pathStart ) && Maps::isValidAbsIndex( targetIndex ) );
 
-    std::list<Route::Step> path;
+    std::vector<Route::Step> path;
 
     // Destination is not reachable
     if ( _cache[targetIndex]._cost == 0 ) {
@@ -485,7 +831,7 @@ std::list<Route::Step> PlayerWorldPathfinder::buildPath( const int targetIndex )
 
         const uint32_t cost = node._cost - _cache[node._from]._cost;
 
-        path.emplace_front( currentNode, node._from, Maps::GetDirection( node._from, currentNode ), cost );
+        path.emplace_back( currentNode, node._from, Maps::GetDirection( node._from, currentNode ), cost );
 
         // The path should not pass through the same tile more than once
         assert( uniqPathIndexes.insert( node._from ).second );
@@ -493,9 +839,63 @@ std::list<Route::Step> PlayerWorldPathfinder::buildPath( const int targetIndex )
         currentNode = node._from;
     }
 
+    // The path has been built from the end to the beginning
+    std::reverse( path.begin(), path.end() );
+
     return path;
 }
 
+int PlayerWorldPathfinder::getNumOfTravelDays( const int targetIndex ) const
+{
+    assert( _cache.size() == world.getSize() && Maps::isValidAbsIndex( _pathStart ) && Maps::isValidAbsIndex( targetIndex ) );
+
+    // Destination is not reachable
+    if ( _cache[targetIndex]._cost == 0 ) {
+        return 0;
+    }
+
+    _stepPenalties.clear();
+
+    for ( int currentNode = targetIndex; currentNode != _pathStart; ) {
+        const WorldNode & node = _cache[currentNode];
+        assert( node._from != -1 );
+
+        _stepPenalties.push_back( node._cost - _cache[node._from]._cost );
+
+        currentNode = node._from;
+    }
+
+    uint32_t movePoints = _remainingMovePoints;
+    int days = 1;
+
+    for ( auto iter = _stepPenalties.rbegin(); iter != _stepPenalties.rend(); ++iter ) {
+        const uint32_t stepPenalty = *iter;
+
+        if ( movePoints >= stepPenalty ) {
+            // This movement takes place on the same day
+            movePoints -= stepPenalty;
+        }
+        else {
+            // This movement takes place at the beginning of a new day: start with max
+            // movement points, don't carry leftovers from the previous day
+            assert( _maxMovePoints >= stepPenalty );
+
+            movePoints = _maxMovePoints - stepPenalty;
+            ++days;
+
+            // Stop at 8 days
+            if ( days >= 8 ) {
+                break;
+            }
+        }
+    }
+
+    // Return no more than 8 days
+    assert( days <= 8 );
+
+    return days;
+}
+
 void PlayerWorldPathfinder::processCurrentNode( std::vector<int> & nodesToExplore, const int currentNodeIdx )
 {
     const bool isFirstNode = ( currentNodeIdx == _pathStart );
@@ -522,10 +922,11 @@ void PlayerWorldPathfinder::processCurrentNode( std::vector<int> & nodesToExplor
             const uint32_t movementPenalty = getMovementPenalty( currentNodeIdx, monsterIndex, direction );
             const uint32_t movementCost = currentNode._cost + movementPenalty;
 
-            WorldNode & monsterNode = _cache[monsterIndex];
+            const WorldNode & monsterNode = _cache[monsterIndex];
 
             if ( monsterNode._from == -1 || monsterNode._cost > movementCost ) {
-                monsterNode.update( currentNodeIdx, movementCost, subtractMovePoints( currentNode._remainingMovePoints, movementPenalty, maxMovePoints ) );
+                _cache.modify( monsterIndex )
+                    .update( currentNodeIdx, movementCost, subtractMovePoints( currentNode._remainingMovePoints, movementPenalty, maxMovePoints ) );
             }
         }
     }
@@ -662,9 +1063,11 @@ void AIWorldPathfinder::reEvaluateIfNeeded( const int start, const PlayerColor c
 
 bool AIWorldPathfinder::isTileAccessibleForAI( const int tileIndex )
 {
-    std::optional<bool> & isAccessible = _cache[tileIndex]._isAccessibleForAI;
+    std::optional<bool> isAccessible = _cache.getAIFlag( tileIndex, WorldNodeCache::AIFlag::IS_ACCESSIBLE );
     if ( !isAccessible ) {
         isAccessible = isTileAccessibleForAIWithArmy( tileIndex, _armyStrength, _minimalArmyStrengthAdvantage );
+
+        _cache.setAIFlag( tileIndex, WorldNodeCache::AIFlag::IS_ACCESSIBLE, *isAccessible );
     }
 
     return *isAccessible;
@@ -672,11 +1075,15 @@ bool AIWorldPathfinder::isTileAccessibleForAI( const int tileIndex )
 
 bool AIWorldPathfinder::isTileAvailableForWalkThroughForAI( const int tileIndex, const bool fromWater )
 {
-    std::optional<bool> & isAvailableForWalkThrough
-        = fromWater ? _cache[tileIndex]._isAvailableForWalkThroughForAI.fromWater : _cache[tileIndex]._isAvailableForWalkThroughForAI.fromLand;
+    const WorldNodeCache::AIFlag flag
+        = fromWater ? WorldNodeCache::AIFlag::IS_AVAILABLE_FOR_WALK_THROUGH_FROM_WATER : WorldNodeCache::AIFlag::IS_AVAILABLE_FOR_WALK_THROUGH_FROM_LAND;
+
+    std::optional<bool> isAvailableForWalkThrough = _cache.getAIFlag( tileIndex, flag );
     if ( !isAvailableForWalkThrough ) {
         isAvailableForWalkThrough = isTileAvailableForWalkThroughForAIWithArmy( tileIndex, fromWater, _color, _isArtifactsBagFull, _isEquippedWithSpellBook,
                                                                                 _armyStrength, _minimalArmyStrengthAdvantage );
+
+        _cache.setAIFlag( tileIndex, flag, *isAvailableForWalkThrough );
     }
 
     return *isAvailableForWalkThrough;
@@ -686,11 +1093,13 @@ void AIWorldPathfinder::processWorldMap()
 {
     assert( _cache.size() == world.getSize() && Maps::isValidAbsIndex( _pathStart ) );
 
-    for ( WorldNode & node : _cache ) {
-        node = {};
-    }
+    updateTerrainPenalties();
+
+    ++_evaluationCount;
 
-    _cache[_pathStart].update( -1, 0, _remainingMovePoints );
+    _cache.clear();
+
+    _cache.modify( _pathStart ).update( -1, 0, _remainingMovePoints );
 
     std::vector<int> nodesToExplore;
     nodesToExplore.push_back( _pathStart );
@@ -702,7 +1111,7 @@ void AIWorldPathfinder::processWorldMap()
         const uint32_t cost = spell.movePoints();
         const uint32_t remaining = ( _remainingMovePoints < cost ) ? 0 : _remainingMovePoints - cost;
 
-        _cache[castleIndex].update( _pathStart, cost, remaining );
+        _cache.modify( castleIndex ).update( _pathStart, cost, remaining );
 
         nodesToExplore.push_back( castleIndex );
     };
@@ -719,9 +1128,7 @@ void AIWorldPathfinder::processWorldMap()
         processTownPortal( Spell::TOWNPORTAL, idx );
     }
 
-    for ( size_t lastProcessedNode = 0; lastProcessedNode < nodesToExplore.size(); ++lastProcessedNode ) {
-        processCurrentNode( nodesToExplore, nodesToExplore[lastProcessedNode] );
-    }
+    exploreNodes( nodesToExplore );
 }
 
 bool AIWorldPathfinder::isMovementAllowed( const int from, const int direction ) const
@@ -732,7 +1139,7 @@ bool AIWorldPathfinder::isMovementAllowed( const int from, const int direction )
 void AIWorldPathfinder::processCurrentNode( std::vector<int> & nodesToExplore, const int currentNodeIdx )
 {
     const bool isFirstNode = ( currentNodeIdx == _pathStart );
-    WorldNode & currentNode = _cache[currentNodeIdx];
+    WorldNode & currentNode = _cache.modify( currentNodeIdx );
 
     // Always allow movement from the starting point to cover the edge case where we got here before this tile became blocked
     if ( !isFirstNode ) {
@@ -785,11 +1192,11 @@ void AIWorldPathfinder::processCurrentNode( std::vector<int> & nodesToExplore, c
                 continue;
             }
 
-            WorldNode & teleportNode = _cache[teleportIdx];
+            const WorldNode & teleportNode = _cache[teleportIdx];
 
             // Check if the movement is really faster via teleport
             if ( teleportNode._from == -1 || teleportNode._cost > currentNode._cost ) {
-                teleportNode.update( currentNodeIdx, currentNode._cost, currentNode._remainingMovePoints );
+                _cache.modify( teleportIdx ).update( currentNodeIdx, currentNode._cost, currentNode._remainingMovePoints );
 
                 nodesToExplore.push_back( teleportIdx );
             }
@@ -850,7 +1257,8 @@ uint32_t AIWorldPathfinder::getMovementPenalty( const int from, const int to, co
         return regularPenalty + WorldPathfinder::getMovementPenalty( node._from, from, prevStepDirection );
     }();
 
-    const uint32_t maxMovePoints = getMaxMovePoints( fromTile.isWater() );
+    const bool fromWater = isWaterTile( from );
+    const uint32_t maxMovePoints = getMaxMovePoints( fromWater );
     assert( maxMovePoints == 0 || defaultPenalty <= maxMovePoints );
 
     // If we perform pathfinding for a real AI-controlled hero on the map, we should correctly calculate
@@ -864,8 +1272,8 @@ uint32_t AIWorldPathfinder::getMovementPenalty( const int from, const int to, co
         const Maps::Tile & toTile = world.getTile( to );
 
         // AI-controlled hero may get from the shore to a suitable water tile using the Summon Boat spell
-        const bool isComesOnBoard = ( !fromTile.isWater() && ( toTile.getMainObjectType() == MP2::OBJ_BOAT || toTile.isSuitableForSummoningBoat() ) );
-        const bool isDisembarks = ( fromTile.isWater() && toTile.isSuitableForDisembarkation() );
+        const bool isComesOnBoard = ( !fromWater && ( toTile.getMainObjectType() == MP2::OBJ_BOAT || toTile.isSuitableForSummoningBoat() ) );
+        const bool isDisembarks = ( fromWater && toTile.isSuitableForDisembarkation() );
 
         // When the hero gets into a boat or disembarks, he spends all remaining movement points.
         if ( isComesOnBoard || isDisembarks ) {
@@ -1208,31 +1616,31 @@ std::vector<IndexObject> AIWorldPathfinder::getObjectsOnTheWay( const int target
     return result;
 }
 
-std::list<Route::Step> AIWorldPathfinder::buildDimensionDoorPath( const int targetIndex )
+uint32_t AIWorldPathfinder::traceDimensionDoorPath( const int targetIndex, std::vector<Route::Step> * path )
 {
     assert( Maps::isValidAbsIndex( _pathStart ) && Maps::isValidAbsIndex( targetIndex ) );
 
     if ( !_isDimensionDoorSpellAvailable ) {
-        return {};
+        return 0;
     }
 
     assert( _dimensionDoorSPCost > 0 );
 
     if ( _pathStart == targetIndex ) {
-        return {};
+        return 0;
     }
 
     if ( _isOnPatrol ) {
         assert( Maps::isValidAbsIndex( _patrolCenter ) );
 
         if ( Maps::GetApproximateDistance( targetIndex, _patrolCenter ) > _patrolDistance ) {
-            return {};
+            return 0;
         }
     }
 
     uint32_t difficultyLimit = Difficulty::GetDimensionDoorLimitForAI( Game::getDifficulty() );
     if ( _dimensionDoorNumOfUses >= difficultyLimit ) {
-        return {};
+        return 0;
     }
 
     difficultyLimit -= _dimensionDoorNumOfUses;
@@ -1243,14 +1651,14 @@ std::list<Route::Step> AIWorldPathfinder::buildDimensionDoorPath( const int targ
     if ( const MP2::MapObjectType objectType = world.getTile( targetIndex ).getMainObjectType();
          objectType != MP2::OBJ_MAGIC_WELL && objectType != MP2::OBJ_ARTESIAN_SPRING ) {
         if ( remainingSpellPoints < _maxSpellPoints * _spellPointsReserveRatio ) {
-            return {};
+            return 0;
         }
 
         remainingSpellPoints -= static_cast<uint32_t>( _maxSpellPoints * _spellPointsReserveRatio );
     }
 
     if ( !isTileAccessibleForAI( targetIndex ) ) {
-        return {};
+        return 0;
     }
 
     const fheroes2::Point targetPoint = Maps::GetPoint( targetIndex );
@@ -1266,7 +1674,7 @@ std::list<Route::Step> AIWorldPathfinder::buildDimensionDoorPath( const int targ
     const uint32_t maxCasts = std::min( { remainingSpellPoints / _dimensionDoorSPCost, _remainingMovePoints / dimensionDoorMovementCost, difficultyLimit } );
     const auto & directions = Direction::allNeighboringDirections;
 
-    std::list<Route::Step> path;
+    uint32_t castsCount = 0;
 
     for ( uint32_t spellsUsed = 0; spellsUsed < maxCasts; ++spellsUsed ) {
         const int32_t currentNodeIdx = Maps::GetIndexFromAbsPoint( current );
@@ -1279,7 +1687,9 @@ std::list<Route::Step> AIWorldPathfinder::buildDimensionDoorPath( const int targ
         const int32_t anotherNodeIdx = Maps::GetIndexFromAbsPoint( another );
 
         if ( Maps::isValidForDimensionDoor( anotherNodeIdx, isHeroOnWater ) ) {
-            path.emplace_back( anotherNodeIdx, currentNodeIdx, Direction::CENTER, dimensionDoorMovementCost );
+            if ( path != nullptr ) {
+                path->emplace_back( anotherNodeIdx, currentNodeIdx, Direction::CENTER, dimensionDoorMovementCost );
+            }
 
             current = another;
         }
@@ -1317,31 +1727,51 @@ std::list<Route::Step> AIWorldPathfinder::buildDimensionDoorPath( const int targ
             }
 
             if ( bestNextIdx == -1 ) {
-                return {};
+                return 0;
             }
 
-            path.emplace_back( bestNextIdx, currentNodeIdx, Direction::CENTER, dimensionDoorMovementCost );
+            if ( path != nullptr ) {
+                path->emplace_back( bestNextIdx, currentNodeIdx, Direction::CENTER, dimensionDoorMovementCost );
+            }
 
             current = Maps::GetPoint( bestNextIdx );
         }
 
+        ++castsCount;
+
         difference = targetPoint - current;
         if ( std::abs( difference.x ) <= 1 && std::abs( difference.y ) <= 1 ) {
             // If this assertion blows up the logic above is wrong!
-            assert( !path.empty() );
+            assert( castsCount > 0 && ( path == nullptr || path->size() == castsCount ) );
 
-            return path;
+            return castsCount;
         }
     }
 
-    return {};
+    return 0;
 }
 
-std::list<Route::Step> AIWorldPathfinder::buildPath( const int targetIndex ) const
+std::vector<Route::Step> AIWorldPathfinder::buildDimensionDoorPath( const int targetIndex )
+{
+    std::vector<Route::Step> path;
+
+    if ( traceDimensionDoorPath( targetIndex, &path ) == 0 ) {
+        path.clear();
+    }
+
+    return path;
+}
+
+uint32_t AIWorldPathfinder::getDimensionDoorDistance( const int targetIndex )
+{
+    return traceDimensionDoorPath( targetIndex, nullptr ) * Spell( Spell::DIMENSIONDOOR ).movePoints();
+}
+
+std::vector<Route::Step> AIWorldPathfinder::buildPath( const int targetIndex ) const
 {
     assert( _cache.size() == world.getSize() && Maps::isValidAbsIndex( _pathStart ) && Maps::isValidAbsIndex( targetIndex ) );
 
-    std::list<Route::Step> path;
+    std::vector<Route::Step> path;
 
     // Destination is not reachable
     if ( _cache[targetIndex]._cost == 0 ) {
@@ -1370,7 +1800,7 @@ std::list<Route::Step> AIWorldPathfinder::buildPath( const int targetIndex ) con
 
         const uint32_t cost = node._cost - _cache[node._from]._cost;
 
-        path.emplace_front( currentNode, node._from, Maps::GetDirection( node._from, currentNode ), cost );
+        path.emplace_back( currentNode, node._from, Maps::GetDirection( node._from, currentNode ), cost );
 
         // The path should not pass through the same tile more than once
         assert( uniqPathIndexes.insert( node._from ).second );
@@ -1378,6 +1808,9 @@ std::list<Route::Step> AIWorldPathfinder::buildPath( const int targetIndex ) con
         currentNode = node._from;
     }
 
+    // The path has been built from the end to the beginning
+    std::reverse( path.begin(), path.end() );
+
     // Cut the path to the last valid tile/obstacle
     if ( lastValidNode != targetIndex ) {
         path.erase( std::find_if( path.begin(), path.end(), [lastValidNode]( const Route::Step & step ) { return step.GetFrom() == lastValidNode; } ), path.end() );
@@ -1396,6 +1829,41 @@ uint32_t AIWorldPathfinder::getDistance( const int start, const int targetIndex,
     return _cache[targetIndex]._cost;
 }
 
+std::vector<uint32_t> AIWorldPathfinder::getDistances( const int start, const std::vector<int32_t> & targets, const PlayerColor color, const double armyStrength,
+                                                      const uint32_t maxDistance, const uint8_t skill /* = Skill::Level::EXPERT */ )
+{
+    // Targets may already be known if the whole map has been processed for the same army.
+    auto currentSettings
+        = std::tie( _pathStart, _color, _remainingMovePoints, _pathfindingSkill, _patrolCenter, _patrolDistance, _maxMovePointsOnLand, _maxMovePointsOnWater,
+                    _remainingSpellPoints, _maxSpellPoints, _dimensionDoorSPCost, _dimensionDoorNumOfUses, _armyStrength, _isOnPatrol, _isArtifactsBagFull,
+                    _isEquippedWithSpellBook, _isSummonBoatSpellAvailable, _isDimensionDoorSpellAvailable, _townGateCastleIndex, _townPortalCastleIndexes );
+    const auto newSettings
+        = std::make_tuple( start, color, 0U, skill, -1, 0U, 0U, 0U, 0U, 0U, 0U, 0U, armyStrength, false, false, false, false, false, -1, std::vector<int32_t>{} );
+
+    if ( currentSettings == newSettings ) {
+        std::vector<uint32_t> result;
+        result.reserve( targets.size() );
+
+        for ( const int32_t targetIndex : targets ) {
+            assert( targetIndex >= 0 && static_cast<size_t>( targetIndex ) < _cache.size() );
+
+            const uint32_t dist = _cache[targetIndex]._cost;
+            result.push_back( ( maxDistance > 0 && dist > maxDistance ) ? 0 : dist );
+        }
+
+        return result;
+    }
+
+    currentSettings = newSettings;
+
+    std::vector<uint32_t> result = processWorldMapForTargets( targets, maxDistance );
+
+    // The cache is incomplete, make sure that it is rebuilt on the next request.
+    _pathStart = -1;
+
+    return result;
+}
+
 void AIWorldPathfinder::setMinimalArmyStrengthAdvantage( const double advantage )
 {
     if ( advantage < 0.0 ) {
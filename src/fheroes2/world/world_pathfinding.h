@@ -20,8 +20,10 @@
 
 #pragma once
 
+#include <array>
+#include <cassert>
+#include <cstddef>
 #include <cstdint>
-#include <list>
 #include <optional>
 #include <utility>
 #include <vector>
@@ -44,16 +46,6 @@ struct WorldNode final
     // The number of movement points remaining for the hero after moving to this node
     uint32_t _remainingMovePoints{ 0 };
 
-    // When calculating tile availability for an AI-controlled player, various relatively heavy computations are
-    // performed, the result of which does not depend on the direction in which the tile is entered. The results
-    // of these calculations can be cached.
-    std::optional<bool> _isAccessibleForAI;
-    struct
-    {
-        std::optional<bool> fromWater;
-        std::optional<bool> fromLand;
-    } _isAvailableForWalkThroughForAI;
-
     WorldNode() = default;
 
     void update( const int from, const uint32_t cost, const uint32_t remainingMovePoints )
@@ -71,6 +63,140 @@ struct WorldNode final
     }
 };
 
+// Storage of the pathfinder nodes. The path data used by every search and the rarely used AI caches are kept in separate
+// arrays, and each node is stamped with the generation in which it was last written. A node from an older generation reads
+// as a default one, so the whole cache is cleared in O(1) by starting a new generation instead of rewriting every node.
+class WorldNodeCache final
+{
+public:
+    // When calculating tile availability for an AI-controlled player, various relatively heavy computations are
+    // performed, the result of which does not depend on the direction in which the tile is entered. The results
+    // of these calculations can be cached.
+    enum class AIFlag : uint8_t
+    {
+        IS_ACCESSIBLE = 0,
+        IS_AVAILABLE_FOR_WALK_THROUGH_FROM_WATER = 2,
+        IS_AVAILABLE_FOR_WALK_THROUGH_FROM_LAND = 4
+    };
+
+    size_t size() const
+    {
+        return _nodes.size();
+    }
+
+    // Resizes the cache, all nodes become default.
+    void resize( const size_t size );
+
+    // Makes all nodes default.
+    void clear();
+
+    // Returns the node for reading. Nodes that have not been written since the last clear() are returned as default ones.
+    const WorldNode & operator[]( const size_t index ) const
+    {
+        return _generations[index] == _generation ? _nodes[index] : _defaultNode;
+    }
+
+    // Returns the node for writing.
+    WorldNode & modify( const size_t index )
+    {
+        touch( index );
+
+        return _nodes[index];
+    }
+
+    std::optional<bool> getAIFlag( const size_t index, const AIFlag flag ) const
+    {
+        if ( _generations[index] != _generation ) {
+            return {};
+        }
+
+        const uint8_t value = static_cast<uint8_t>( _aiFlags[index] >> static_cast<uint8_t>( flag ) );
+        if ( ( value & knownBit ) == 0 ) {
+            return {};
+        }
+
+        return ( value & valueBit ) != 0;
+    }
+
+    void setAIFlag( const size_t index, const AIFlag flag, const bool value )
+    {
+        touch( index );
+
+        const uint8_t bits = static_cast<uint8_t>( ( value ? knownBit | valueBit : knownBit ) << static_cast<uint8_t>( flag ) );
+        const uint8_t mask = static_cast<uint8_t>( ( knownBit | valueBit ) << static_cast<uint8_t>( flag ) );
+
+        _aiFlags[index] = static_cast<uint8_t>( ( _aiFlags[index] & ~mask ) | bits );
+    }
+
+private:
+    static constexpr uint8_t knownBit{ 0x1 };
+    static constexpr uint8_t valueBit{ 0x2 };
+
+    void touch( const size_t index )
+    {
+        if ( _generations[index] == _generation ) {
+            return;
+        }
+
+        _generations[index] = _generation;
+        _nodes[index] = {};
+        _aiFlags[index] = 0;
+    }
+
+    std::vector<WorldNode> _nodes;
+    std::vector<uint8_t> _aiFlags;
+    std::vector<uint32_t> _generations;
+
+    // Nodes are stamped with generations starting from 1, so after resize() every node is stale.
+    uint32_t _generation{ 1 };
+
+    const WorldNode _defaultNode;
+};
+
+// Monotone priority queue of the pathfinder nodes ordered by their cost (radix heap). Dijkstra's algorithm never adds a node with
+// a cost lower than the cost of the last removed node, so the nodes are kept in buckets by the highest bit in which their cost
+// differs from the last removed one. Every node is moved to a lower bucket at most 32 times, which is much cheaper than the
+// binary heap operations for the small integer costs used by the pathfinder. Buckets keep their memory between the searches.
+class WorldNodeQueue final
+{
+public:
+    using Item = std::pair<uint32_t, int>;
+
+    bool empty() const
+    {
+        return _size == 0;
+    }
+
+    void clear();
+
+    void push( const uint32_t cost, const int nodeIdx )
+    {
+        assert( cost >= _lastCost );
+
+        _buckets[getBucketIndex( cost )].emplace_back( cost, nodeIdx );
+        ++_size;
+    }
+
+    // Removes and returns the item with the lowest cost. The queue must not be empty.
+    Item pop();
+
+private:
+    size_t getBucketIndex( const uint32_t cost ) const
+    {
+        size_t index = 0;
+
+        for ( uint32_t diff = cost ^ _lastCost; diff != 0; diff >>= 1 ) {
+            ++index;
+        }
+
+        return index;
+    }
+
+    std::array<std::vector<Item>, 33> _buckets;
+    uint32_t _lastCost{ 0 };
+    size_t _size{ 0 };
+};
+
 // Abstract class that provides basic functionality for navigating the World Map
 class WorldPathfinder
 {
@@ -91,6 +217,16 @@ protected:
 
     virtual void processWorldMap();
 
+    // Processes the nodes in the order of increasing cost (Dijkstra) starting from the given nodes, which should already be
+    // updated in the cache, until all the reachable nodes are processed. The vector is used as a buffer afterwards.
+    void exploreNodes( std::vector<int> & nodesToExplore );
+
+    // Runs the search in the order of increasing cost (Dijkstra) from the current start node and stops as soon as all the
+    // nodes from 'targets' are reached or the cost exceeds 'maxDistance' (0 means no limit). Unlike processWorldMap() only
+    // the part of the map closer than the farthest target is explored, so the cache is incomplete after this call. Returns
+    // the cost of every target with 0 meaning unreachable, as for getDistance().
+    std::vector<uint32_t> processWorldMapForTargets( const std::vector<int32_t> & targets, const uint32_t maxDistance );
+
     // Checks whether moving from the source tile in the specified direction is allowed. The default implementation
     // can be overridden by a derived class.
     virtual bool isMovementAllowed( const int from, const int direction ) const;
@@ -109,7 +245,33 @@ protected:
     // overridden by a derived class.
     virtual uint32_t getMovementPenalty( const int from, const int to, const int direction ) const;
 
-    std::vector<WorldNode> _cache;
+    // Updates the terrain data used to calculate movement penalties without accessing the map tiles. The per-tile data
+    // is collected once per map, while the penalty table depends on the Pathfinding skill level and is rebuilt if needed.
+    // Should be called before the pathfinder cache is processed.
+    void updateTerrainPenalties();
+
+    bool isWaterTile( const int tileIndex ) const
+    {
+        assert( tileIndex >= 0 && static_cast<size_t>( tileIndex ) < _tileTerrain.size() );
+
+        return ( _tileTerrain[tileIndex] & tileTerrainWaterFlag ) != 0;
+    }
+
+    // Returns the penalty for moving over the given tile in the straight direction, taking into account the road on it.
+    uint32_t getTerrainPenalty( const int tileIndex ) const
+    {
+        assert( tileIndex >= 0 && static_cast<size_t>( tileIndex ) < _tileTerrain.size() );
+
+        return _terrainPenalties[_tileTerrain[tileIndex] & tileTerrainPenaltyMask];
+    }
+
+    static constexpr uint8_t tileTerrainRoadFlag{ 0x10 };
+    static constexpr uint8_t tileTerrainWaterFlag{ 0x20 };
+    static constexpr uint8_t tileTerrainGroundMask{ 0x0F };
+    static constexpr uint8_t tileTerrainPenaltyMask{ tileTerrainGroundMask | tileTerrainRoadFlag };
+
+    WorldNodeCache _cache;
+    WorldNodeQueue _queue;
     std::vector<int> _mapOffset;
 
     // The hero properties used by the pathfinder are cached here not just for optimization, but also because some
@@ -119,6 +281,12 @@ protected:
     PlayerColor _color{ PlayerColor::NONE };
     uint32_t _remainingMovePoints{ 0 };
     uint8_t _pathfindingSkill{ Skill::Level::EXPERT };
+
+    // Ground type index (in the lower bits), road and water flags of every map tile.
+    std::vector<uint8_t> _tileTerrain;
+    // Straight movement penalties indexed by the ground type index and road flag for the '_terrainPenaltiesSkill' level.
+    std::array<uint32_t, tileTerrainPenaltyMask + 1> _terrainPenalties{};
+    std::optional<uint8_t> _terrainPenaltiesSkill;
 };
 
 class PlayerWorldPathfinder final : public WorldPathfinder
@@ -135,11 +303,22 @@ public:
 
     void reEvaluateIfNeeded( const Heroes & hero );
 
+    // Marks the tile as changed. If the pathfinder is then re-evaluated for the same hero, only the part of the cache that
+    // depends on the changed tiles is processed again. Too many changed tiles reset the pathfinder.
+    void invalidateTile( const int32_t tileIndex );
+
     // Builds and returns a path to the tile with the index 'targetIndex'. If the destination tile is not reachable,
     // then an empty path is returned.
-    std::list<Route::Step> buildPath( const int targetIndex ) const;
+    std::vector<Route::Step> buildPath( const int targetIndex ) const;
+
+    // Returns the number of days (no more than 8) required to reach the tile with the index 'targetIndex' or 0 if the tile is not reachable.
+    // It is called for every tile under the mouse cursor, so the path is only traced back in the cache without building it.
+    int getNumOfTravelDays( const int targetIndex ) const;
 
 private:
+    // Repairs the cache after some tiles were changed, see invalidateTile().
+    void processChangedTiles();
+
     // Follows regular passability rules (for the human player)
     void processCurrentNode( std::vector<int> & nodesToExplore, const int currentNodeIdx ) override;
 
@@ -152,6 +331,12 @@ private:
     // of them may change even if the position of the hero does not change, so it should be possible to compare the
     // old values with the new ones to determine whether the pathfinder cache needs to be recalculated.
     uint32_t _maxMovePoints{ 0 };
+
+    // Tiles changed since the cache was last updated.
+    std::vector<int32_t> _changedTiles;
+
+    // Penalties of path steps in the reverse order, used by getNumOfTravelDays() to avoid memory allocations.
+    mutable std::vector<uint32_t> _stepPenalties;
 };
 
 class AIWorldPathfinder final : public WorldPathfinder
@@ -186,18 +371,28 @@ public:
     // Dimension Door spell to move between them. If the target tile is unsuitable for moving to it using the Dimension Door
     // spell, but there is a tile suitable for this next to it, from which it is possible to move to the target tile, then the
     // resulting path will end with this neighboring tile. If such a path could not be built, then an empty path is returned.
-    std::list<Route::Step> buildDimensionDoorPath( const int targetIndex );
+    std::vector<Route::Step> buildDimensionDoorPath( const int targetIndex );
+
+    // Returns the total movement penalty of the path that would be built by buildDimensionDoorPath() for the same target, or 0
+    // if such a path could not be built. The path itself is not built.
+    uint32_t getDimensionDoorDistance( const int targetIndex );
 
     // Builds and returns a path to the tile with the index 'targetIndex'. If there is a need to pass through any objects
     // on the way to this tile, then a path to the nearest such object is returned. If the destination tile is not reachable
     // in principle, then an empty path is returned.
-    std::list<Route::Step> buildPath( const int targetIndex ) const;
+    std::vector<Route::Step> buildPath( const int targetIndex ) const;
 
     // Used for non-hero armies, like castles or monsters
     uint32_t getDistance( const int start, const int targetIndex, const PlayerColor color, const double armyStrength, const uint8_t skill = Skill::Level::EXPERT );
     // Faster, but does not re-evaluate the map (exposed method of the base class)
     using WorldPathfinder::getDistance;
 
+    // Batched version of getDistance() above for several targets. The map is explored only until all the targets are reached
+    // or until the distance exceeds 'maxDistance' (0 means no limit), targets farther than that are reported as unreachable (0).
+    // The cache is not reusable after this call, the next call of any other method re-evaluates the map.
+    std::vector<uint32_t> getDistances( const int start, const std::vector<int32_t> & targets, const PlayerColor color, const double armyStrength,
+                                        const uint32_t maxDistance, const uint8_t skill = Skill::Level::EXPERT );
+
     // Returns the coefficient of the minimum required advantage in army strength in order to be able to "pass through"
     // protected tiles from the AI pathfinder's point of view
     double getMinimalArmyStrengthAdvantage() const
@@ -220,7 +415,17 @@ public:
     // (such as Dimension Door, Town Gate or Town Portal)
     void setSpellPointsReserveRatio( const double ratio );
 
+    // Returns the number of full map evaluations performed by this pathfinder so far. Used for profiling purposes.
+    uint32_t getEvaluationCount() const
+    {
+        return _evaluationCount;
+    }
+
 private:
+    // Common implementation of buildDimensionDoorPath() and getDimensionDoorDistance(). Returns the number of Dimension Door casts
+    // needed to reach the target (0 if it cannot be reached this way) and appends the steps to 'path' if it is not nullptr.
+    uint32_t traceDimensionDoorPath( const int targetIndex, std::vector<Route::Step> * path );
+
     bool isTileAccessibleForAI( const int tileIndex );
     bool isTileAvailableForWalkThroughForAI( const int tileIndex, const bool fromWater );
 
@@ -274,4 +479,6 @@ private:
     // Spell points reservation factor for spells associated with the movement of the hero on the adventure map
     // (such as Dimension Door, Town Gate or Town Portal)
     double _spellPointsReserveRatio{ 0.5 };
+
+    uint32_t _evaluationCount{ 0 };
 };
@@ -29,11 +29,14 @@
 #include <vector>
 
 #include "castle.h"
+#include "direction.h"
 #include "ground.h"
 #include "maps.h"
 #include "maps_tiles.h"
 #include "math_base.h"
 #include "mp2.h"
+#include "serialize.h"
+#include "thread.h"
 #include "world.h" // IWYU pragma: associated
 
 namespace
@@ -175,8 +178,91 @@ const MapRegion & World::getRegion( size_t id ) const
     return region;
 }
 
+void World::_updateTerrainStatistics()
+{
+    int passableTileCount = 0;
+    int waterCount = 0;
+    uint32_t terrainPenalty = 0;
+
+    for ( const Maps::Tile & tile : vec_tiles ) {
+        if ( tile.GetPassable() == 0 ) {
+            continue;
+        }
+
+        ++passableTileCount;
+
+        if ( tile.isWater() ) {
+            ++waterCount;
+        }
+        else {
+            terrainPenalty += Maps::Ground::GetPenalty( tile, 0 );
+        }
+    }
+
+    assert( passableTileCount > 0 );
+
+    _waterPercentage = static_cast<uint8_t>( waterCount * 100 / passableTileCount );
+
+    const int landTiles = passableTileCount - waterCount;
+    assert( landTiles > 0 );
+
+    _landRoughness = static_cast<double>( terrainPenalty ) / ( landTiles * Maps::Ground::defaultGroundPenalty );
+}
+
+void World::_assignRegionsToTiles()
+{
+    ++_regionDataVersion;
+
+    MultiThreading::JobSystem::Get().parallelFor( 0, vec_tiles.size(), [this]( const size_t i ) { vec_tiles[i].UpdateRegion( REGION_NODE_BLOCKED ); }, 1024 );
+
+    // Every tile belongs to at most one region so regions are processed in parallel.
+    MultiThreading::JobSystem::Get().parallelFor( REGION_NODE_FOUND, _regions.size(), [this]( const size_t regionId ) {
+        for ( const MapRegionNode & node : _regions[regionId]._nodes ) {
+            vec_tiles[node.index].UpdateRegion( node.type );
+        }
+    } );
+}
+
+bool World::_areRegionsValid() const
+{
+    if ( _regions.size() <= REGION_NODE_FOUND ) {
+        return false;
+    }
+
+    std::vector<uint8_t> isTileUsed( vec_tiles.size(), 0 );
+
+    for ( size_t regionId = 0; regionId < _regions.size(); ++regionId ) {
+        const MapRegion & region = _regions[regionId];
+        if ( region._id != regionId ) {
+            return false;
+        }
+
+        for ( const uint32_t neighbour : region._neighbours ) {
+            if ( neighbour >= _regions.size() ) {
+                return false;
+            }
+        }
+
+        if ( regionId < REGION_NODE_FOUND ) {
+            continue;
+        }
+
+        for ( const MapRegionNode & node : region._nodes ) {
+            if ( node.index < 0 || static_cast<size_t>( node.index ) >= vec_tiles.size() || isTileUsed[node.index] != 0 ) {
+                return false;
+            }
+
+            isTileUsed[node.index] = 1;
+        }
+    }
+
+    return true;
+}
+
 void World::ComputeStaticAnalysis()
 {
+    ++_regionDataVersion;
+
     // Parameters that control region generation: size and spacing between initial points
     const uint32_t castleRegionSize = 17;
     const uint32_t extraRegionSize = 18;
@@ -202,10 +288,6 @@ void World::ComputeStaticAnalysis()
         obstacles[3].emplace_back( y, 0 ); // ground, rows
     }
 
-    int obstacleCount = 0;
-    int waterCount = 0;
-    uint32_t terrainPenalty = 0;
-
     // Find the terrain
     for ( int y = 0; y < height; ++y ) {
         const int rowIndex = y * width;
@@ -214,20 +296,17 @@ void World::ComputeStaticAnalysis()
             const Maps::Tile & tile = vec_tiles[index];
             // If tile is blocked (mountain, trees, etc) then it's applied to both
             if ( tile.GetPassable() == 0 ) {
-                ++obstacleCount;
                 ++obstacles[0][x].second;
                 ++obstacles[1][y].second;
                 ++obstacles[2][x].second;
                 ++obstacles[3][y].second;
             }
             else if ( tile.isWater() ) {
-                ++waterCount;
                 // if it's water then ground tiles consider it an obstacle
                 ++obstacles[2][x].second;
                 ++obstacles[3][y].second;
             }
             else {
-                terrainPenalty += Maps::Ground::GetPenalty( tile, 0 );
                 // else then ground is an obstacle for water navigation
                 ++obstacles[0][x].second;
                 ++obstacles[1][y].second;
@@ -235,15 +314,7 @@ void World::ComputeStaticAnalysis()
         }
     }
 
-    const int passableTileCount = ( width * height ) - obstacleCount;
-    assert( passableTileCount > 0 );
-
-    _waterPercentage = static_cast<uint8_t>( waterCount * 100 / passableTileCount );
-
-    const int landTiles = passableTileCount - waterCount;
-    assert( landTiles > 0 );
-
-    _landRoughness = static_cast<double>( terrainPenalty ) / ( landTiles * Maps::Ground::defaultGroundPenalty );
+    _updateTerrainStatistics();
 
     // sort the map rows and columns based on amount of obstacles
     for ( int i = 0; i < 4; ++i )
@@ -317,9 +388,10 @@ void World::ComputeStaticAnalysis()
 
     // Step 5. Initialize extended (by 2 tiles) map data used for region growing based on actual Maps::Tiles
     const uint32_t extendedWidth = width + 2;
+    // Every row writes only to its own nodes so rows are processed in parallel.
     std::vector<MapRegionNode> data( extendedWidth * ( height + 2 ) );
-    for ( int y = 0; y < height; ++y ) {
-        const int rowIndex = y * width;
+    MultiThreading::JobSystem::Get().parallelFor( 0, static_cast<size_t>( height ), [this, &data, extendedWidth]( const size_t y ) {
+        const int rowIndex = static_cast<int>( y ) * width;
         for ( int x = 0; x < width; ++x ) {
             const int index = rowIndex + x;
             const Maps::Tile & tile = vec_tiles[index];
@@ -335,7 +407,7 @@ void World::ComputeStaticAnalysis()
                 node.type = REGION_NODE_OPEN;
             }
         }
-    }
+    } );
 
     // Step 6. Initialize regions
     size_t averageRegionSize = ( static_cast<size_t>( width ) * height * 2 ) / regionCenters.size();
@@ -396,3 +468,154 @@ void World::ComputeStaticAnalysis()
         }
     }
 }
+
+void World::updateRegions( const fheroes2::Rect & area )
+{
+    if ( _regions.size() <= REGION_NODE_FOUND ) {
+        // Regions have not been computed yet.
+        return;
+    }
+
+    const int32_t minX = std::max( area.x, 0 );
+    const int32_t minY = std::max( area.y, 0 );
+    const int32_t maxX = std::min( area.x + area.width - 1, width - 1 );
+    const int32_t maxY = std::min( area.y + area.height - 1, height - 1 );
+
+    bool isChanged = false;
+
+    for ( int32_t y = minY; y <= maxY; ++y ) {
+        for ( int32_t x = minX; x <= maxX; ++x ) {
+            const int32_t tileIndex = y * width + x;
+            Maps::Tile & tile = vec_tiles[tileIndex];
+            const uint32_t currentRegionId = tile.GetRegion();
+
+            if ( tile.GetPassable() == 0 ) {
+                if ( currentRegionId >= REGION_NODE_FOUND && currentRegionId < _regions.size() ) {
+                    // The region might be split by this tile now. Links between regions are used only as hints so they are kept as is.
+                    std::vector<MapRegionNode> & nodes = _regions[currentRegionId]._nodes;
+                    if ( nodes.size() > 1 ) {
+                        nodes.erase( std::remove_if( nodes.begin(), nodes.end(), [tileIndex]( const MapRegionNode & node ) { return node.index == tileIndex; } ),
+                                     nodes.end() );
+                    }
+                }
+
+                if ( currentRegionId != REGION_NODE_BLOCKED ) {
+                    tile.UpdateRegion( REGION_NODE_BLOCKED );
+                    isChanged = true;
+                }
+                continue;
+            }
+
+            // Region IDs are never added here as the AI keeps per-region data sized by the region count for the whole turn.
+            std::set<uint32_t> adjacentRegionIds;
+            for ( const int32_t direction : Direction::allNeighboringDirections ) {
+                if ( !Maps::isValidDirection( tileIndex, direction ) ) {
+                    continue;
+                }
+
+                const Maps::Tile & adjacentTile = vec_tiles[Maps::GetDirectionIndex( tileIndex, direction )];
+                const uint32_t adjacentRegionId = adjacentTile.GetRegion();
+                if ( adjacentRegionId >= REGION_NODE_FOUND && ( adjacentTile.GetPassable() & Direction::Reflect( direction ) )
+                     && adjacentTile.isWater() == tile.isWater() ) {
+                    adjacentRegionIds.insert( adjacentRegionId );
+                }
+            }
+
+            if ( currentRegionId < REGION_NODE_FOUND ) {
+                if ( adjacentRegionIds.empty() ) {
+                    // The tile is not reachable from any region.
+                    continue;
+                }
+
+                // Join the region with the lowest ID to get the same result regardless of the processing order of tiles.
+                const uint32_t newRegionId = *adjacentRegionIds.begin();
+                MapRegion & region = _regions[newRegionId];
+
+                MapRegionNode & node = region._nodes.emplace_back( tileIndex );
+                node.type = newRegionId;
+                node.passable = tile.GetPassable();
+                node.isWater = tile.isWater();
+
+                tile.UpdateRegion( newRegionId );
+                isChanged = true;
+            }
+
+            const uint32_t regionId = tile.GetRegion();
+            for ( const uint32_t adjacentRegionId : adjacentRegionIds ) {
+                if ( adjacentRegionId != regionId && _regions[regionId]._neighbours.insert( adjacentRegionId ).second ) {
+                    _regions[adjacentRegionId]._neighbours.insert( regionId );
+                    isChanged = true;
+                }
+            }
+        }
+    }
+
+    if ( isChanged ) {
+        ++_regionDataVersion;
+    }
+}
+
+OStreamBase & operator<<( OStreamBase & stream, const MapRegion & region )
+{
+    // Nodes are written as per-field arrays so that they are serialized as bulk copies.
+    const size_t nodeCount = region._nodes.size();
+
+    std::vector<int32_t> indexes( nodeCount );
+    std::vector<uint32_t> types( nodeCount );
+    std::vector<uint16_t> mapObjects( nodeCount );
+    std::vector<uint16_t> passabilities( nodeCount );
+    std::vector<uint8_t> waterFlags( nodeCount );
+
+    for ( size_t i = 0; i < nodeCount; ++i ) {
+        const MapRegionNode & node = region._nodes[i];
+
+        indexes[i] = node.index;
+        types[i] = node.type;
+        mapObjects[i] = node.mapObject;
+        passabilities[i] = node.passable;
+        waterFlags[i] = node.isWater ? 1 : 0;
+    }
+
+    const std::vector<uint32_t> neighbours( region._neighbours.begin(), region._neighbours.end() );
+
+    return stream << region._id << region._isWater << neighbours << indexes << types << mapObjects << passabilities << waterFlags;
+}
+
+IStreamBase & operator>>( IStreamBase & stream, MapRegion & region )
+{
+    std::vector<uint32_t> neighbours;
+    std::vector<int32_t> indexes;
+    std::vector<uint32_t> types;
+    std::vector<uint16_t> mapObjects;
+    std::vector<uint16_t> passabilities;
+    std::vector<uint8_t> waterFlags;
+
+    stream >> region._id >> region._isWater >> neighbours >> indexes >> types >> mapObjects >> passabilities >> waterFlags;
+
+    region._neighbours = { neighbours.begin(), neighbours.end() };
+    region._nodes.clear();
+    region._lastProcessedNode = 0;
+
+    const size_t nodeCount = indexes.size();
+    if ( types.size() != nodeCount || mapObjects.size() != nodeCount || passabilities.size() != nodeCount || waterFlags.size() != nodeCount ) {
+        stream.setFail();
+        return stream;
+    }
+
+    region._nodes.resize( nodeCount );
+
+    for ( size_t i = 0; i < nodeCount; ++i ) {
+        MapRegionNode & node = region._nodes[i];
+
+        node.index = indexes[i];
+        node.type = types[i];
+        node.mapObject = mapObjects[i];
+        node.passable = passabilities[i];
+        node.isWater = ( waterFlags[i] != 0 );
+    }
+
+    // All nodes of a stored region have been processed by the region growing.
+    region._lastProcessedNode = nodeCount;
+
+    return stream;
+}
@@ -25,6 +25,9 @@
 #include <set>
 #include <vector>
 
+class IStreamBase;
+class OStreamBase;
+
 enum
 {
     REGION_NODE_BLOCKED = 0,
@@ -63,3 +66,6 @@ public:
 
     size_t getNeighboursCount() const;
 };
+
+OStreamBase & operator<<( OStreamBase & stream, const MapRegion & region );
+IStreamBase & operator>>( IStreamBase & stream, MapRegion & region );
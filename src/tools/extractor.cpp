@@ -22,6 +22,7 @@
  ***************************************************************************/
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <cstdlib>
 #include <filesystem>
@@ -29,9 +30,12 @@
 #include <functional>
 #include <iostream>
 #include <map>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <system_error>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -45,6 +49,9 @@ namespace
 {
     constexpr size_t AGGItemNameLen = 15;
 
+    // The manifest contains content hashes of the extracted items to skip writing the unchanged items on subsequent runs.
+    const char * manifestFileName = "manifest.txt";
+
     struct AGGItemInfo
     {
         // Hash of this item's name, see fheroes2::calculateAggFilenameHash() for details
@@ -52,22 +59,99 @@ namespace
         uint32_t offset;
         uint32_t size;
     };
+
+    std::mutex outputMutex;
+
+    std::map<std::string, uint32_t, std::less<>> loadManifest( const std::filesystem::path & path )
+    {
+        std::map<std::string, uint32_t, std::less<>> manifest;
+
+        std::ifstream manifestStream( path );
+
+        std::string name;
+        uint32_t hash = 0;
+
+        while ( manifestStream >> name >> std::hex >> hash ) {
+            manifest[name] = hash;
+        }
+
+        return manifest;
+    }
+
+    bool saveManifest( const std::filesystem::path & path, const std::map<std::string, uint32_t, std::less<>> & manifest )
+    {
+        std::ofstream manifestStream( path, std::ios_base::trunc );
+
+        for ( const auto & [name, hash] : manifest ) {
+            manifestStream << name << ' ' << GetHexString( hash ) << std::endl;
+        }
+
+        return static_cast<bool>( manifestStream );
+    }
+
+    // Calls 'processItem( i )' for every i in [0, count) using the given number of threads. Stops and returns false as soon as any call returns false.
+    bool processItems( const size_t count, const uint32_t threadCount, const std::function<bool( size_t )> & processItem )
+    {
+        std::atomic<size_t> nextItem{ 0 };
+        std::atomic<bool> isFailed{ false };
+
+        const auto worker = [&nextItem, &isFailed, count, &processItem]() {
+            while ( !isFailed ) {
+                const size_t idx = nextItem++;
+                if ( idx >= count ) {
+                    return;
+                }
+
+                if ( !processItem( idx ) ) {
+                    isFailed = true;
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for ( uint32_t i = 1; i < threadCount; ++i ) {
+            threads.emplace_back( worker );
+        }
+
+        worker();
+
+        for ( std::thread & thread : threads ) {
+            thread.join();
+        }
+
+        return !isFailed;
+    }
 }
 
 int main( int argc, char ** argv )
 {
-    if ( argc < 3 ) {
+    uint32_t threadCount = 1;
+    int firstArg = 1;
+
+    if ( argc > 2 && std::string_view( argv[1] ) == "-j" ) {
+        const unsigned long value = std::strtoul( argv[2], nullptr, 10 );
+        if ( value == 0 || value > 256 ) {
+            std::cerr << "Invalid number of threads: " << argv[2] << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        threadCount = static_cast<uint32_t>( value );
+        firstArg = 3;
+    }
+
+    if ( argc < firstArg + 2 ) {
         const std::string toolName = System::GetFileName( argv[0] );
 
         std::cerr << toolName << " extracts the contents of the specified AGG file(s)." << std::endl
-                  << "Syntax: " << toolName << " dst_dir input_file.agg ..." << std::endl;
+                  << "Items which have not changed since the previous extraction into the same directory are not written again." << std::endl
+                  << "Syntax: " << toolName << " [-j threads] dst_dir input_file.agg ..." << std::endl;
         return EXIT_FAILURE;
     }
 
-    const char * dstDir = argv[1];
+    const char * dstDir = argv[firstArg];
 
     std::vector<std::string> inputFileNames;
-    for ( int i = 2; i < argc; ++i ) {
+    for ( int i = firstArg + 1; i < argc; ++i ) {
         if ( System::isShellLevelGlobbingSupported() ) {
             inputFileNames.emplace_back( argv[i] );
         }
@@ -76,8 +160,9 @@ int main( int argc, char ** argv )
         }
     }
 
-    uint32_t itemsExtracted = 0;
-    uint32_t itemsFailed = 0;
+    std::atomic<uint32_t> itemsExtracted{ 0 };
+    std::atomic<uint32_t> itemsSkipped{ 0 };
+    std::atomic<uint32_t> itemsFailed{ 0 };
 
     for ( const std::string & inputFileName : inputFileNames ) {
         std::cout << "Processing " << inputFileName << "..." << std::endl;
@@ -99,6 +184,9 @@ int main( int argc, char ** argv )
             return EXIT_FAILURE;
         }
 
+        const std::filesystem::path manifestFilePath = prefixPath / manifestFileName;
+        const std::map<std::string, uint32_t, std::less<>> oldManifest = loadManifest( manifestFilePath );
+
         const size_t inputStreamSize = inputStream.size();
         const uint16_t itemsCount = inputStream.getLE16();
 
@@ -116,65 +204,122 @@ int main( int argc, char ** argv )
             info.size = itemsStream.getLE32();
         }
 
-        for ( const auto & item : aggItemsMap ) {
-            const auto & [name, info] = item;
+        const std::vector<std::pair<const std::string, AGGItemInfo> *> aggItems = [&aggItemsMap]() {
+            std::vector<std::pair<const std::string, AGGItemInfo> *> result;
+            result.reserve( aggItemsMap.size() );
+
+            for ( auto & item : aggItemsMap ) {
+                result.push_back( &item );
+            }
+
+            return result;
+        }();
+
+        // Content hashes of the successfully extracted items, each one is written only by the thread processing the corresponding item.
+        std::vector<std::optional<uint32_t>> contentHashes( aggItems.size() );
+
+        std::mutex inputStreamMutex;
+
+        const bool isCompleted = processItems( aggItems.size(), threadCount, [&]( const size_t itemIdx ) {
+            const auto & [name, info] = *aggItems[itemIdx];
 
             if ( info.size == 0 ) {
                 ++itemsFailed;
 
+                const std::scoped_lock<std::mutex> lock( outputMutex );
                 std::cerr << inputFileName << ": item " << name << " is empty" << std::endl;
-                continue;
+                return true;
             }
 
             const uint32_t hash = fheroes2::calculateAggFilenameHash( name );
             if ( hash != info.hash ) {
                 ++itemsFailed;
 
+                const std::scoped_lock<std::mutex> lock( outputMutex );
                 std::cerr << inputFileName << ": invalid hash for item " << name << ": expected " << GetHexString( info.hash ) << ", got " << GetHexString( hash )
                           << std::endl;
-                continue;
+                return true;
             }
 
-            inputStream.seek( info.offset );
-
             static_assert( std::is_same_v<uint8_t, unsigned char> );
 
-            const std::vector<uint8_t> buf = inputStream.getRaw( info.size );
+            const std::vector<uint8_t> buf = [&inputStreamMutex, &inputStream, &info = info]() {
+                const std::scoped_lock<std::mutex> lock( inputStreamMutex );
+
+                inputStream.seek( info.offset );
+                return inputStream.getRaw( info.size );
+            }();
+
             if ( buf.size() != info.size ) {
                 ++itemsFailed;
 
+                const std::scoped_lock<std::mutex> lock( outputMutex );
                 std::cerr << inputFileName << ": item " << name << " has an invalid size of " << info.size << std::endl;
-                continue;
+                return true;
             }
 
             const std::filesystem::path outputFilePath = prefixPath / std::filesystem::path( name );
+            const uint32_t contentHash = fheroes2::calculateCRC32( buf.data(), buf.size() );
+
+            {
+                const auto oldManifestIter = oldManifest.find( name );
+                std::error_code fileSizeEc;
+
+                if ( oldManifestIter != oldManifest.end() && oldManifestIter->second == contentHash
+                     && std::filesystem::file_size( outputFilePath, fileSizeEc ) == buf.size() && !fileSizeEc ) {
+                    contentHashes[itemIdx] = contentHash;
+                    ++itemsSkipped;
+                    return true;
+                }
+            }
 
             std::ofstream outputStream( outputFilePath, std::ios_base::binary | std::ios_base::trunc );
             if ( !outputStream ) {
+                const std::scoped_lock<std::mutex> lock( outputMutex );
                 std::cerr << "Cannot open file " << outputFilePath << std::endl;
-                return EXIT_FAILURE;
+                return false;
             }
 
             {
                 const auto streamSize = fheroes2::checkedCast<std::streamsize>( buf.size() );
                 if ( !streamSize ) {
+                    const std::scoped_lock<std::mutex> lock( outputMutex );
                     std::cerr << inputFileName << ": item " << name << " is too large" << std::endl;
-                    return EXIT_FAILURE;
+                    return false;
                 }
 
                 outputStream.write( reinterpret_cast<const char *>( buf.data() ), streamSize.value() );
             }
 
             if ( !outputStream ) {
+                const std::scoped_lock<std::mutex> lock( outputMutex );
                 std::cerr << "Error writing to file " << outputFilePath << std::endl;
-                return EXIT_FAILURE;
+                return false;
             }
 
+            contentHashes[itemIdx] = contentHash;
             ++itemsExtracted;
+            return true;
+        } );
+
+        if ( !isCompleted ) {
+            return EXIT_FAILURE;
+        }
+
+        std::map<std::string, uint32_t, std::less<>> manifest;
+        for ( size_t i = 0; i < aggItems.size(); ++i ) {
+            if ( contentHashes[i] ) {
+                manifest.emplace( aggItems[i]->first, *contentHashes[i] );
+            }
+        }
+
+        if ( !saveManifest( manifestFilePath, manifest ) ) {
+            std::cerr << "Error writing to file " << manifestFilePath << std::endl;
+            return EXIT_FAILURE;
         }
     }
 
-    std::cout << "Total extracted items: " << itemsExtracted << ", failed items: " << itemsFailed << std::endl;
+    std::cout << "Total extracted items: " << itemsExtracted << ", unchanged items: " << itemsSkipped << ", failed items: " << itemsFailed << std::endl;
 
     return ( itemsFailed == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
 }
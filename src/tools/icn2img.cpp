@@ -22,15 +22,23 @@
  ***************************************************************************/
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <iomanip>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <optional>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <system_error>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #include "agg_file.h"
@@ -39,26 +47,128 @@
 #include "image_tool.h"
 #include "serialize.h"
 #include "system.h"
+#include "tools.h"
 
 namespace
 {
     constexpr size_t validPaletteSize = 768;
     constexpr uint8_t spriteBackground = 23;
+
+    // The manifest contains content hashes of the extracted sprites to skip decoding and saving the unchanged sprites on subsequent runs.
+    const char * manifestFileName = "manifest.txt";
+    // The manifest entry holding the hash of the palette used for the extraction.
+    const char * manifestPaletteEntry = "palette";
+
+    std::mutex outputMutex;
+
+    struct SpriteInfo
+    {
+        uint16_t spriteIdx{ 0 };
+        std::string outputFileName;
+        std::vector<uint8_t> data;
+    };
+
+    std::map<std::string, uint32_t, std::less<>> loadManifest( const std::filesystem::path & path )
+    {
+        std::map<std::string, uint32_t, std::less<>> manifest;
+
+        std::ifstream manifestStream( path );
+
+        std::string name;
+        uint32_t hash = 0;
+
+        while ( manifestStream >> name >> std::hex >> hash ) {
+            manifest[name] = hash;
+        }
+
+        return manifest;
+    }
+
+    bool saveManifest( const std::filesystem::path & path, const std::map<std::string, uint32_t, std::less<>> & manifest )
+    {
+        std::ofstream manifestStream( path, std::ios_base::trunc );
+
+        for ( const auto & [name, hash] : manifest ) {
+            manifestStream << name << ' ' << GetHexString( hash ) << std::endl;
+        }
+
+        return static_cast<bool>( manifestStream );
+    }
+
+    uint32_t calculateSpriteHash( const std::vector<uint8_t> & data, const fheroes2::ICNHeader & header )
+    {
+        // Sprite offsets are not a part of the image, so they are not taken into account.
+        std::vector<uint8_t> hashData{ static_cast<uint8_t>( header.width ), static_cast<uint8_t>( header.width >> 8 ), static_cast<uint8_t>( header.height ),
+                                       static_cast<uint8_t>( header.height >> 8 ), header.animationFrames };
+        hashData.insert( hashData.end(), data.begin(), data.end() );
+
+        return fheroes2::calculateCRC32( hashData.data(), hashData.size() );
+    }
+
+    // Calls 'processItem( i )' for every i in [0, count) using the given number of threads. Stops and returns false as soon as any call returns false.
+    bool processItems( const size_t count, const uint32_t threadCount, const std::function<bool( size_t )> & processItem )
+    {
+        std::atomic<size_t> nextItem{ 0 };
+        std::atomic<bool> isFailed{ false };
+
+        const auto worker = [&nextItem, &isFailed, count, &processItem]() {
+            while ( !isFailed ) {
+                const size_t idx = nextItem++;
+                if ( idx >= count ) {
+                    return;
+                }
+
+                if ( !processItem( idx ) ) {
+                    isFailed = true;
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for ( uint32_t i = 1; i < threadCount; ++i ) {
+            threads.emplace_back( worker );
+        }
+
+        worker();
+
+        for ( std::thread & thread : threads ) {
+            thread.join();
+        }
+
+        return !isFailed;
+    }
 }
 
 int main( int argc, char ** argv )
 {
-    if ( argc < 4 ) {
+    uint32_t threadCount = 1;
+    int firstArg = 1;
+
+    if ( argc > 2 && std::string_view( argv[1] ) == "-j" ) {
+        const unsigned long value = std::strtoul( argv[2], nullptr, 10 );
+        if ( value == 0 || value > 256 ) {
+            std::cerr << "Invalid number of threads: " << argv[2] << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        threadCount = static_cast<uint32_t>( value );
+        firstArg = 3;
+    }
+
+    if ( argc < firstArg + 3 ) {
         const std::string toolName = System::GetFileName( argv[0] );
 
         std::cerr << toolName << " extracts sprites in BMP or PNG format (if supported) and their offsets from the specified ICN file(s) using the specified palette."
                   << std::endl
-                  << "Syntax: " << toolName << " dst_dir palette_file.pal input_file.icn ..." << std::endl;
+                  << "Sprites which have not changed since the previous extraction into the same directory are not saved again." << std::endl
+                  << "Syntax: " << toolName << " [-j threads] dst_dir palette_file.pal input_file.icn ..." << std::endl;
         return EXIT_FAILURE;
     }
 
-    const char * dstDir = argv[1];
-    const char * paletteFileName = argv[2];
+    const char * dstDir = argv[firstArg];
+    const char * paletteFileName = argv[firstArg + 1];
+
+    uint32_t paletteHash = 0;
 
     {
         StreamFile paletteStream;
@@ -74,10 +184,12 @@ int main( int argc, char ** argv )
         }
 
         fheroes2::setGamePalette( palette );
+
+        paletteHash = fheroes2::calculateCRC32( palette.data(), palette.size() );
     }
 
     std::vector<std::string> inputFileNames;
-    for ( int i = 3; i < argc; ++i ) {
+    for ( int i = firstArg + 2; i < argc; ++i ) {
         if ( System::isShellLevelGlobbingSupported() ) {
             inputFileNames.emplace_back( argv[i] );
         }
@@ -86,8 +198,9 @@ int main( int argc, char ** argv )
         }
     }
 
-    uint32_t spritesExtracted = 0;
-    uint32_t spritesFailed = 0;
+    std::atomic<uint32_t> spritesExtracted{ 0 };
+    std::atomic<uint32_t> spritesSkipped{ 0 };
+    std::atomic<uint32_t> spritesFailed{ 0 };
 
     for ( const std::string & inputFileName : inputFileNames ) {
         std::cout << "Processing " << inputFileName << "..." << std::endl;
@@ -109,6 +222,17 @@ int main( int argc, char ** argv )
             return EXIT_FAILURE;
         }
 
+        const std::filesystem::path manifestFilePath = prefixPath / manifestFileName;
+
+        std::map<std::string, uint32_t, std::less<>> oldManifest = loadManifest( manifestFilePath );
+        {
+            const auto paletteIter = oldManifest.find( manifestPaletteEntry );
+            if ( paletteIter == oldManifest.end() || paletteIter->second != paletteHash ) {
+                // All the sprites have to be saved again using the new palette.
+                oldManifest.clear();
+            }
+        }
+
         const std::filesystem::path offsetFilePath = prefixPath / "offsets.txt";
 
         std::ofstream offsetStream( offsetFilePath, std::ios_base::trunc );
@@ -127,6 +251,10 @@ int main( int argc, char ** argv )
             inputStream >> header;
         }
 
+        // Sprite data is read and offsets are written sequentially, while sprites are decoded and saved in parallel afterwards.
+        std::vector<SpriteInfo> sprites;
+        sprites.reserve( spritesCount );
+
         for ( uint16_t spriteIdx = 0; spriteIdx < spritesCount; ++spriteIdx ) {
             const fheroes2::ICNHeader & header = headers[spriteIdx];
 
@@ -140,7 +268,7 @@ int main( int argc, char ** argv )
                 continue;
             }
 
-            const std::vector<uint8_t> buf = inputStream.getRaw( dataSize );
+            std::vector<uint8_t> buf = inputStream.getRaw( dataSize );
             if ( buf.size() != dataSize ) {
                 ++spritesFailed;
 
@@ -148,13 +276,11 @@ int main( int argc, char ** argv )
                 continue;
             }
 
-            const fheroes2::Sprite sprite = fheroes2::decodeICNSprite( buf.data(), buf.data() + dataSize, header );
-
             std::ostringstream spriteIdxStream;
             spriteIdxStream << std::setw( 3 ) << std::setfill( '0' ) << spriteIdx;
 
             const std::string spriteIdxStr = spriteIdxStream.str();
-            std::string outputFileName = ( prefixPath / spriteIdxStr ).string();
+            std::string outputFileName = spriteIdxStr;
 
             if ( fheroes2::isPNGFormatSupported() ) {
                 outputFileName += ".png";
@@ -179,18 +305,61 @@ int main( int argc, char ** argv )
                 return EXIT_FAILURE;
             }
 
-            if ( !fheroes2::Save( sprite, outputFileName, spriteBackground ) ) {
+            sprites.push_back( { spriteIdx, std::move( outputFileName ), std::move( buf ) } );
+        }
+
+        // Content hashes of the successfully saved sprites, each one is written only by the thread processing the corresponding sprite.
+        std::vector<std::optional<uint32_t>> contentHashes( sprites.size() );
+
+        processItems( sprites.size(), threadCount, [&]( const size_t itemIdx ) {
+            const SpriteInfo & info = sprites[itemIdx];
+            const fheroes2::ICNHeader & header = headers[info.spriteIdx];
+
+            const std::filesystem::path outputFilePath = prefixPath / info.outputFileName;
+            const uint32_t contentHash = calculateSpriteHash( info.data, header );
+
+            {
+                const auto oldManifestIter = oldManifest.find( info.outputFileName );
+                std::error_code fileEc;
+
+                if ( oldManifestIter != oldManifest.end() && oldManifestIter->second == contentHash && std::filesystem::exists( outputFilePath, fileEc ) ) {
+                    contentHashes[itemIdx] = contentHash;
+                    ++spritesSkipped;
+                    return true;
+                }
+            }
+
+            const fheroes2::Sprite sprite = fheroes2::decodeICNSprite( info.data.data(), info.data.data() + info.data.size(), header );
+
+            if ( !fheroes2::Save( sprite, outputFilePath.string(), spriteBackground ) ) {
                 ++spritesFailed;
 
-                std::cerr << inputFileName << ": error saving sprite " << spriteIdx << std::endl;
-                continue;
+                const std::scoped_lock<std::mutex> lock( outputMutex );
+                std::cerr << inputFileName << ": error saving sprite " << info.spriteIdx << std::endl;
+                return true;
             }
 
+            contentHashes[itemIdx] = contentHash;
             ++spritesExtracted;
+            return true;
+        } );
+
+        std::map<std::string, uint32_t, std::less<>> manifest;
+        manifest.emplace( manifestPaletteEntry, paletteHash );
+
+        for ( size_t i = 0; i < sprites.size(); ++i ) {
+            if ( contentHashes[i] ) {
+                manifest.emplace( sprites[i].outputFileName, *contentHashes[i] );
+            }
+        }
+
+        if ( !saveManifest( manifestFilePath, manifest ) ) {
+            std::cerr << "Error writing to file " << manifestFilePath << std::endl;
+            return EXIT_FAILURE;
         }
     }
 
-    std::cout << "Total extracted sprites: " << spritesExtracted << ", failed sprites: " << spritesFailed << std::endl;
+    std::cout << "Total extracted sprites: " << spritesExtracted << ", unchanged sprites: " << spritesSkipped << ", failed sprites: " << spritesFailed << std::endl;
 
     return ( spritesFailed == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
 }
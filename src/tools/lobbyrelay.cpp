@@ -0,0 +1,98 @@
+/***************************************************************************
+ *   fheroes2: https://github.com/ihhub/fheroes2                           *
+ *   Copyright (C) 2026                                                    *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, write to the                         *
+ *   Free Software Foundation, Inc.,                                       *
+ *   59 Temple Place - Suite 330, Boston, MA  02111-1307, USA.             *
+ ***************************************************************************/
+
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "network/lobby_relay.h"
+#include "system.h"
+
+namespace
+{
+    constexpr uint16_t defaultPort = Network::lobbyRelayDefaultPort;
+    constexpr size_t defaultMaxClients = 1024;
+
+    constexpr uint32_t pumpTimeoutMs = 1000;
+
+    volatile std::sig_atomic_t isStopRequested{ 0 };
+
+    void requestStop( int /* signal */ )
+    {
+        isStopRequested = 1;
+    }
+
+    bool parseNumber( const char * str, const unsigned long maxValue, unsigned long & result )
+    {
+        char * end = nullptr;
+        result = std::strtoul( str, &end, 10 );
+
+        return end != str && *end == '\0' && result > 0 && result <= maxValue;
+    }
+}
+
+int main( int argc, char ** argv )
+{
+    unsigned long port = defaultPort;
+    unsigned long maxClients = defaultMaxClients;
+
+    if ( argc > 3 || ( argc > 1 && !parseNumber( argv[1], UINT16_MAX, port ) ) || ( argc > 2 && !parseNumber( argv[2], 1000000, maxClients ) ) ) {
+        const std::string toolName = System::GetFileName( argv[0] );
+
+        std::cerr << toolName << " runs a relay server for internet games without a display." << std::endl
+                  << "Syntax: " << toolName << " [port] [max_clients]" << std::endl
+                  << "Default port is " << defaultPort << ", default number of clients is " << defaultMaxClients << "." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    Network::LobbyRelayServer server;
+    if ( !server.start( static_cast<uint16_t>( port ), static_cast<size_t>( maxClients ) ) ) {
+        std::cerr << "Cannot start the server on port " << port << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::signal( SIGINT, requestStop );
+    std::signal( SIGTERM, requestStop );
+
+    std::cout << "Relay server is listening on port " << server.tcpPort() << std::endl;
+
+    size_t lastClientCount = 0;
+    size_t lastLobbyCount = 0;
+
+    while ( !isStopRequested ) {
+        server.pump( pumpTimeoutMs );
+
+        if ( server.clientCount() != lastClientCount || server.lobbyCount() != lastLobbyCount ) {
+            lastClientCount = server.clientCount();
+            lastLobbyCount = server.lobbyCount();
+
+            std::cout << "Clients: " << lastClientCount << ", lobbies: " << lastLobbyCount << std::endl;
+        }
+    }
+
+    server.stop();
+
+    std::cout << "Relay server is stopped" << std::endl;
+
+    return EXIT_SUCCESS;
+}